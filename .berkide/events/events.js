@@ -85,6 +85,12 @@ editor.events.on("fileSaved", (info) => {
   console.log(`[Events] File saved: ${info?.path || "unknown"}`);
 });
 
+// File save failed (the original file is unchanged)
+// Dosya kaydedilemedi (orijinal dosya degismedi)
+editor.events.on("fileSaveFailed", (info) => {
+  console.log(`[Events] Save failed: ${info?.path || "unknown"} (${info?.error || ""})`);
+});
+
 // Command executed
 // Komut yurutuldu
 editor.events.on("commandExecuted", (info) => {
@@ -97,4 +103,10 @@ editor.events.on("bufferChanged", (path) => {
   console.log(`[Events] Buffer changed: ${path || "unknown"}`);
 });
 
+// Batched edits applied (ranges of one applyEdits or replaceAll)
+// Toplu duzenlemeler uygulandi (tek bir applyEdits veya replaceAll'in araliklari)
+editor.events.on("bufferEditsApplied", (info) => {
+  console.log(`[Events] Edits applied: ${info?.path || "unknown"} (${info?.changes?.length || 0} changes)`);
+});
+
 console.log("[Events] Runtime loaded.");
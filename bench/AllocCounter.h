@@ -0,0 +1,48 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations by replacing the global operator new/delete.
+// Global operator new/delete'i degistirerek heap ayirmalarini sayar.
+// Include from exactly one translation unit per benchmark executable.
+// Her olcum calistirilabilirinde tam olarak bir ceviri biriminden dahil edin.
+
+namespace bench {
+
+inline std::atomic<size_t> gAllocCount{0};   // Allocations so far / Simdiye kadarki ayirmalar
+inline std::atomic<size_t> gAllocBytes{0};   // Bytes requested so far / Simdiye kadar istenen baytlar
+
+// Allocation count and bytes between construction and read
+// Olusturma ile okuma arasindaki ayirma sayisi ve baytlar
+struct AllocScope {
+    size_t count0 = gAllocCount.load();
+    size_t bytes0 = gAllocBytes.load();
+
+    size_t count() const { return gAllocCount.load() - count0; }
+    size_t bytes() const { return gAllocBytes.load() - bytes0; }
+};
+
+// Counted allocation behind every operator new overload
+// Her operator new asiri yuklemesinin arkasindaki sayilan ayirma
+inline void* countedAlloc(size_t size) {
+    gAllocCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace bench
+
+void* operator new(size_t size) { return bench::countedAlloc(size); }
+void* operator new[](size_t size) { return bench::countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
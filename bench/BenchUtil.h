@@ -0,0 +1,125 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include "Logger.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Shared helpers for the engine benchmarks: timing, scratch files and generated text.
+// Motor olcumleri icin ortak yardimcilar: zamanlama, karalama dosyalari ve uretilmis metin.
+// Every benchmark prints one row per case so runs can be diffed; inputs are generated from
+// fixed seeds, so two runs on one machine measure the same bytes.
+// Her olcum, calismalar karsilastirilabilsin diye durum basina bir satir yazar; girdiler sabit
+// tohumlardan uretilir, boylece bir makinedeki iki calisma ayni baytlari olcer.
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Seconds elapsed since start
+// start'tan beri gecen saniye
+inline double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Best (shortest) time of runs calls of fn, in seconds
+// fn'in runs cagrisinin en iyi (en kisa) suresi, saniye cinsinden
+template <typename Fn>
+inline double bestOf(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int i = 0; i < runs; ++i) {
+        auto start = Clock::now();
+        fn();
+        best = std::min(best, secondsSince(start));
+    }
+    return best;
+}
+
+// Keep engine info logs out of the result rows
+// Motorun bilgi loglarini sonuc satirlarinin disinda tut
+inline void quietLogs() {
+    Logger::instance().setLevel(LogLevel::Warn);
+}
+
+// Scratch path under the system temp directory
+// Sistem gecici dizini altinda karalama yolu
+inline std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("berkide-bench-" + name)).string();
+}
+
+// Kinds of generated text / Uretilen metin turleri
+enum class Text {
+    Ascii,      // Code-like ASCII lines / Kod benzeri ASCII satirlar
+    Mixed,      // Latin, Turkish, Greek, Cyrillic, CJK and emoji words / Latin, Turkce, Yunanca, Kiril, CJK ve emoji sozcukler
+    Invalid     // Mixed text with a stray byte every 4 KB / Her 4 KB'de basibos bir bayt iceren karisik metin
+};
+
+// About bytes of newline-terminated text of the given kind (whole lines, at least bytes long)
+// Verilen turde yaklasik bytes boyutunda yeni satirla biten metin (tam satirlar, en az bytes uzunlugunda)
+inline std::string makeText(size_t bytes, Text kind, uint32_t seed = 1) {
+    static const char* ascii[] = {"int", "value", "return", "buffer", "search", "line", "index", "=",
+                                  "+", "(x)", "{", "}", "for", "const", "auto", "42", "needle"};
+    static const char* mixed[] = {"text", "çalışma", "ığdır", "Straße", "λόγος", "данные", "文字列",
+                                  "検索", "😀", "naïve", "needle", "øre", "ŞEHİR", "終わり"};
+    std::mt19937 rng(seed);
+    std::string out;
+    out.reserve(bytes + 256);
+    size_t sinceBad = 0;
+    while (out.size() < bytes) {
+        const int words = 4 + static_cast<int>(rng() % 12);
+        for (int w = 0; w < words; ++w) {
+            if (w) out += ' ';
+            out += kind == Text::Ascii ? ascii[rng() % (sizeof(ascii) / sizeof(*ascii))]
+                                       : mixed[rng() % (sizeof(mixed) / sizeof(*mixed))];
+        }
+        out += '\n';
+        if (kind == Text::Invalid && out.size() - sinceBad >= 4096) {
+            out.insert(out.size() - 1, 1, '\xFF');
+            sinceBad = out.size();
+        }
+    }
+    return out;
+}
+
+// Write text to path; false on failure
+// Metni path'e yaz; basarisizlikta false
+inline bool writeFile(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(out.flush());
+}
+
+// Peak resident set size of the process so far, in bytes (0 where unavailable)
+// Islemin simdiye kadarki en yuksek yerlesik bellek boyutu, bayt cinsinden (yoksa 0)
+inline size_t peakRssBytes() {
+#if defined(_WIN32)
+    return 0;
+#else
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// Throughput helpers for result rows / Sonuc satirlari icin is hacmi yardimcilari
+inline double mbPerSecond(size_t bytes, double seconds) { return bytes / 1e6 / seconds; }
+inline double gbPerSecond(size_t bytes, double seconds) { return bytes / 1e9 / seconds; }
+
+} // namespace bench
@@ -0,0 +1,103 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "AllocCounter.h"
+#include "BenchUtil.h"
+#include "BufferSnapshot.h"
+#include "CharClassifier.h"
+#include "SearchEngine.h"
+#include "buffer.h"
+#include "file.h"
+
+#include <cstdlib>
+#include <vector>
+
+// Line access cost: time and heap allocations for one pass over every line through the
+// copying getLine against the view APIs, and for the call sites ported to views.
+// Satir erisim maliyeti: her satir uzerinden bir gecis icin kopyalayan getLine'a karsi
+// gorunum API'leriyle ve gorunumlere tasinan cagri noktalari icin sure ve heap ayirmalari.
+// Usage: bench-lines [lines]   (default 1000000)
+// Kullanim: bench-lines [satirlar]   (varsayilan 1000000)
+
+// Print one result row / Bir sonuc satiri yaz
+static void row(const char* name, double seconds, const bench::AllocScope& allocs) {
+    std::printf("%-28s %10.2f %12zu %14zu\n", name, seconds * 1e3, allocs.count(), allocs.bytes());
+}
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    const int lines = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    std::vector<std::string> text;
+    for (int i = 0; i < lines; ++i) text.push_back("    value_" + std::to_string(i) + " = compute(value);");
+    text.push_back("needle");
+    Buffer buffer;
+    buffer.loadLines(std::move(text));
+    const BufferSnapshot snapshot = buffer.snapshot();
+    size_t sink = 0;
+
+    std::printf("%d lines\n%-28s %10s %12s %14s\n", lines, "pass", "ms", "allocs", "bytes");
+    {
+        bench::AllocScope allocs;
+        double s = bench::bestOf(1, [&] {
+            for (int i = 0; i < snapshot.lineCount(); ++i) sink += snapshot.getLine(i).size();
+        });
+        row("getLine (copy)", s, allocs);
+    }
+    {
+        bench::AllocScope allocs;
+        double s = bench::bestOf(1, [&] {
+            for (int i = 0; i < snapshot.lineCount(); ++i) sink += snapshot.lineView(i).size();
+        });
+        row("lineView", s, allocs);
+    }
+    {
+        bench::AllocScope allocs;
+        double s = bench::bestOf(1, [&] {
+            for (std::string_view line : snapshot) sink += line.size();
+        });
+        row("LineIterator", s, allocs);
+    }
+    {
+        bench::AllocScope allocs;
+        double s = bench::bestOf(1, [&] {
+            snapshot.forEachChunk(0, snapshot.lineCount(), [&](int, const std::string_view* views, int count) {
+                for (int i = 0; i < count; ++i) sink += views[i].size();
+                return true;
+            });
+        });
+        row("forEachChunk", s, allocs);
+    }
+    {
+        SearchEngine engine;
+        SearchMatch match{};
+        bench::AllocScope allocs;
+        double s = bench::bestOf(1, [&] { engine.findForward(snapshot, "needle", 0, 0, match); });
+        row("findForward (full scan)", s, allocs);
+    }
+    {
+        // A block just inside the 10000-line scan window, matched from its last line back to the first
+        // 10000 satirlik tarama penceresinin hemen icinde bir blok, son satirindan ilk satirina dogru eslenir
+        std::vector<std::string> bracedText{"{"};
+        for (int i = 0; i < 9998; ++i) bracedText.push_back("    value_" + std::to_string(i) + " = 1;");
+        bracedText.push_back("}");
+        Buffer braced;
+        braced.loadLines(std::move(bracedText));
+        CharClassifier classifier;
+        bench::AllocScope allocs;
+        BracketMatch match;
+        double s = bench::bestOf(1, [&] { match = classifier.findMatchingBracket(braced, braced.lineCount() - 1, 0); });
+        sink += match.found;
+        row("findMatchingBracket (10k)", s, allocs);
+    }
+    {
+        std::string path = bench::tempPath("lines.txt");
+        bench::AllocScope allocs;
+        double s = bench::bestOf(1, [&] { FileSystem::saveSnapshot(snapshot, path); });
+        row("saveSnapshot", s, allocs);
+        FileSystem::deleteFile(path);
+    }
+    return sink == 0;
+}
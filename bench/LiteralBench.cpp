@@ -0,0 +1,102 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "LiteralMatcher.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+// Literal search throughput: every match of a needle over generated lines with LiteralMatcher
+// against the search path it replaced (lowercase copies of line and pattern, then
+// std::string_view::find with a word-boundary recheck), on ASCII, mixed-script and invalid text.
+// Literal arama is hacmi: uretilmis satirlarda bir ignenin tum eslemeleri, LiteralMatcher ile
+// yerini aldigi arama yolunun (satir ve kalibin kucuk harfli kopyalari, ardindan sozcuk siniri
+// yeniden denetimli std::string_view::find) karsilastirmasi; ASCII, karisik yazili ve gecersiz metinde.
+// Usage: bench-literal [MB]   (default 64)
+// Kullanim: bench-literal [MB]   (varsayilan 64)
+
+// The replaced path, kept here as the baseline / Yerini alan yol, burada taban olarak tutulur
+static std::string toLower(std::string_view s) {
+    std::string result(s);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return std::tolower(c); });
+    return result;
+}
+
+static bool isWordBoundary(std::string_view line, int pos) {
+    if (pos <= 0 || pos >= static_cast<int>(line.size())) return true;
+    bool prevAlnum = std::isalnum(static_cast<unsigned char>(line[pos - 1])) || line[pos - 1] == '_';
+    bool currAlnum = std::isalnum(static_cast<unsigned char>(line[pos])) || line[pos] == '_';
+    return prevAlnum != currAlnum;
+}
+
+static bool oldFindInLine(std::string_view line, const std::string& pattern, int startCol, bool caseSensitive,
+                          bool wholeWord, int& matchCol) {
+    std::string lowerLine, lowerPattern;
+    std::string_view haystack = line, needle = pattern;
+    if (!caseSensitive) {
+        lowerLine = toLower(line);
+        lowerPattern = toLower(pattern);
+        haystack = lowerLine;
+        needle = lowerPattern;
+    }
+    for (size_t pos = haystack.find(needle, startCol); pos != std::string_view::npos; pos = haystack.find(needle, pos + 1)) {
+        const int end = static_cast<int>(pos + needle.size());
+        if (!wholeWord || (isWordBoundary(line, static_cast<int>(pos)) && isWordBoundary(line, end))) {
+            matchCol = static_cast<int>(pos);
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    const size_t bytes = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64) << 20;
+
+    struct Case {
+        const char* needle;
+        bool caseSensitive, wholeWord;
+    };
+    const Case cases[] = {{"needle", true, false}, {"NEEDLE", false, false}, {"line", true, true},
+                          {"x", true, false}, {"zzzq", true, false}};
+    const std::pair<const char*, bench::Text> kinds[] = {
+        {"ascii", bench::Text::Ascii}, {"mixed", bench::Text::Mixed}, {"invalid", bench::Text::Invalid}};
+
+    std::printf("kernel: %s\n%-8s %-8s %4s %4s %10s %10s %10s %8s\n", LiteralMatcher::kernelName(), "text", "needle",
+                "case", "word", "matches", "new GB/s", "old GB/s", "speedup");
+    for (const auto& [kindName, kind] : kinds) {
+        const std::string text = bench::makeText(bytes, kind);
+        std::vector<std::string_view> lines;
+        for (size_t start = 0, end; (end = text.find('\n', start)) != std::string::npos; start = end + 1)
+            lines.emplace_back(text.data() + start, end - start);
+
+        for (const Case& c : cases) {
+            const LiteralMatcher matcher(c.needle, c.caseSensitive, c.wholeWord);
+            const std::string pattern = c.needle;
+            size_t newCount = 0, oldCount = 0;
+            const double newSeconds = bench::bestOf(3, [&] {
+                newCount = 0;
+                for (std::string_view line : lines)
+                    for (size_t pos = matcher.find(line); pos != LiteralMatcher::npos; pos = matcher.find(line, pos + 1))
+                        ++newCount;
+            });
+            const double oldSeconds = bench::bestOf(1, [&] {
+                oldCount = 0;
+                for (std::string_view line : lines)
+                    for (int col = 0, match; oldFindInLine(line, pattern, col, c.caseSensitive, c.wholeWord, match); col = match + 1)
+                        ++oldCount;
+            });
+            std::printf("%-8s %-8s %4s %4s %10zu %10.2f %10.2f %7.1fx%s\n", kindName, c.needle,
+                        c.caseSensitive ? "yes" : "no", c.wholeWord ? "yes" : "no", newCount,
+                        bench::gbPerSecond(text.size(), newSeconds), bench::gbPerSecond(text.size(), oldSeconds),
+                        oldSeconds / newSeconds, newCount == oldCount ? "" : "  (match counts differ)");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "LineScanner.h"
+#include "buffer.h"
+#include "file.h"
+
+#include <cstdlib>
+#include <vector>
+
+// File loader throughput: MB/s for FileSystem::loadToBuffer on the read and mapped paths,
+// plus the raw LineScanner split over the same bytes.
+// Dosya yukleyici is hacmi: okuma ve eslenmis yollarda FileSystem::loadToBuffer icin MB/s,
+// ayrica ayni baytlar uzerinde ham LineScanner bolmesi.
+// Usage: bench-loader [MB ...]   (default 10 100 1000)
+// Kullanim: bench-loader [MB ...]   (varsayilan 10 100 1000)
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    std::vector<size_t> sizesMb;
+    for (int i = 1; i < argc; ++i) sizesMb.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (sizesMb.empty()) sizesMb = {10, 100, 1000};
+
+    std::printf("kernel: %s\n", LineScanner::kernelName());
+    std::printf("%8s %12s %12s %12s %10s\n", "MB", "split MB/s", "read MB/s", "mmap MB/s", "lines");
+
+    const uintmax_t savedThreshold = FileSystem::mmapThreshold();
+    for (size_t mb : sizesMb) {
+        std::string text = bench::makeText(mb << 20, bench::Text::Ascii);
+        std::string path = bench::tempPath("loader.txt");
+        if (!bench::writeFile(path, text)) {
+            std::fprintf(stderr, "cannot write %s\n", path.c_str());
+            return 1;
+        }
+
+        std::vector<std::string> lines;
+        double split = bench::bestOf(3, [&] {
+            lines.clear();
+            LineScanner::splitLines(text.data(), text.size(), lines);
+        });
+        const size_t bytes = text.size();
+        const size_t lineCount = lines.size();
+        lines = {};
+        text = {};
+
+        // 0 never maps, 1 maps every file / 0 asla eslemez, 1 her dosyayi esler
+        double seconds[2] = {0, 0};
+        for (int mapped = 0; mapped < 2; ++mapped) {
+            FileSystem::setMmapThreshold(mapped ? 1 : 0);
+            seconds[mapped] = bench::bestOf(3, [&] {
+                Buffer buffer;
+                FileSystem::loadToBuffer(buffer, path);
+            });
+        }
+
+        std::printf("%8zu %12.0f %12.0f %12.0f %10zu\n", mb, bench::mbPerSecond(bytes, split),
+                    bench::mbPerSecond(bytes, seconds[0]), bench::mbPerSecond(bytes, seconds[1]), lineCount);
+        FileSystem::deleteFile(path);
+    }
+    FileSystem::setMmapThreshold(savedThreshold);
+    return 0;
+}
@@ -0,0 +1,73 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "BufferSnapshot.h"
+#include "buffer.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Offset index cost: ns per offsetOf/positionOf query against walking the lines to sum their
+// lengths (how byte offsets were computed before the index), and ns per edit with the index kept.
+// Ofset indeksi maliyeti: satir uzunluklarini toplamak icin satirlari yurumeye karsi (indeksten
+// once bayt ofsetlerinin hesaplanma yolu) offsetOf/positionOf sorgu basina ns ve indeks
+// korunurken duzenleme basina ns.
+// Usage: bench-offsets [lines ...]   (default 10000 100000 1000000)
+// Kullanim: bench-offsets [satirlar ...]   (varsayilan 10000 100000 1000000)
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = {10000, 100000, 1000000};
+
+    std::printf("%9s %12s %14s %12s %12s\n", "lines", "offsetOf ns", "positionOf ns", "walk ns", "edit ns");
+    for (int lines : sizes) {
+        std::vector<std::string> text;
+        for (int i = 0; i < lines; ++i) text.push_back("line " + std::to_string(i) + std::string(i % 60, 'x'));
+        Buffer buffer;
+        buffer.loadLines(std::move(text));
+
+        // Fragment the table first so lookups cross many pieces
+        // Aramalar bircok parcayi assin diye once tabloyu parcala
+        std::mt19937 rng(3);
+        for (int k = 0; k < 20000; ++k) buffer.insertChar(static_cast<int>(rng() % lines), 0, 'e');
+        const BufferSnapshot snapshot = buffer.snapshot();
+        const uint64_t bytes = snapshot.byteCount();
+
+        const int queries = 200000;
+        uint64_t sink = 0;
+        double offsetSeconds = bench::bestOf(3, [&] {
+            for (int q = 0; q < queries; ++q) sink += snapshot.offsetOf(static_cast<int>(rng() % lines), 1);
+        });
+        double positionSeconds = bench::bestOf(3, [&] {
+            for (int q = 0; q < queries; ++q) sink += snapshot.positionOf(rng() % bytes).line;
+        });
+
+        // Linear walk to a random line, averaged over fewer queries
+        // Rastgele bir satira dogrusal yuruyus, daha az sorgu uzerinden ortalama
+        const int walks = 200;
+        double walkSeconds = bench::bestOf(1, [&] {
+            for (int q = 0; q < walks; ++q) {
+                int target = static_cast<int>(rng() % lines);
+                uint64_t offset = 0;
+                for (int i = 0; i < target; ++i) offset += snapshot.lineView(i).size() + 1;
+                sink += offset;
+            }
+        });
+
+        const int edits = 100000;
+        double editSeconds = bench::bestOf(1, [&] {
+            for (int k = 0; k < edits; ++k) buffer.insertChar(static_cast<int>(rng() % lines), 0, 'x');
+        });
+
+        std::printf("%9d %12.0f %14.0f %12.0f %12.0f\n", lines, offsetSeconds / queries * 1e9,
+                    positionSeconds / queries * 1e9, walkSeconds / walks * 1e9, editSeconds / edits * 1e9);
+        if (sink == 0) std::printf("(unexpected zero sum)\n");
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "BufferSnapshot.h"
+#include "SearchEngine.h"
+#include "ThreadPool.h"
+#include "buffer.h"
+
+#include <cstdlib>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Parallel search scaling: findAll and countMatches over a large log-like buffer on pools of
+// growing worker counts, with the speedup over a pool with no workers (the caller alone).
+// Paralel arama olceklenmesi: buyuk, log benzeri bir buffer uzerinde findAll ve countMatches,
+// artan calisan sayili havuzlarda; calisansiz bir havuza (yalnizca cagiran) gore hizlanma ile.
+// Usage: bench-parallel [lines]   (default 5000000)
+// Kullanim: bench-parallel [satirlar]   (varsayilan 5000000)
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    const int lineCount = argc > 1 ? std::atoi(argv[1]) : 5000000;
+
+    Buffer buffer;
+    {
+        std::string text;
+        text.reserve(static_cast<size_t>(lineCount) * 56);
+        for (int i = 0; i < lineCount; ++i)
+            text += "2024-01-01 12:00:" + std::to_string(i % 60) + " INFO request id=" + std::to_string(i) +
+                    (i % 97 == 0 ? " ERROR timeout foo\n" : " ok\n");
+        buffer.insertText(0, 0, text);
+    }
+    const BufferSnapshot snapshot = buffer.snapshot();
+
+    // Worker counts to try; the caller always scans too, so n workers means n + 1 threads
+    // Denenecek calisan sayilari; cagiran da her zaman tarar, yani n calisan n + 1 thread demektir
+    const int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::set<int> workerCounts = {0, 1, 3, 7, hardware - 1};
+
+    SearchOptions literal, regex, caseless;
+    regex.regex = true;
+    caseless.caseSensitive = false;
+    const std::pair<const char*, SearchOptions> searches[] = {
+        {"ERROR", literal}, {"id=\\d+7\\b", regex}, {"error", caseless}};
+
+    SearchEngine engine;
+    std::printf("%d lines, %d hardware threads\n%-14s %8s %10s %10s %8s %10s %8s\n", lineCount, hardware,
+                "pattern", "workers", "matches", "findAll ms", "speedup", "count ms", "speedup");
+    for (const auto& [pattern, opts] : searches) {
+        double baseFind = 0, baseCount = 0;
+        for (int workers : workerCounts) {
+            ThreadPool pool(workers);
+            SearchScan scan;
+            scan.pool = &pool;
+            size_t matches = 0;
+            const double find = bench::bestOf(3, [&] { matches = engine.findAll(snapshot, pattern, opts, scan).size(); });
+            const double count = bench::bestOf(3, [&] { engine.countMatches(snapshot, pattern, opts, scan); });
+            if (workers == 0) baseFind = find, baseCount = count;
+            std::printf("%-14s %8d %10zu %10.1f %7.2fx %10.1f %7.2fx\n", pattern, workers, matches, find * 1e3,
+                        baseFind / find, count * 1e3, baseCount / count);
+        }
+    }
+    return 0;
+}
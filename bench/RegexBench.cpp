@@ -0,0 +1,89 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "LinearRegexEngine.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Regex throughput: every match of common search patterns over generated code lines with
+// LinearRegexEngine against StdRegexEngine (std::regex), then a pathological pattern over
+// growing lines, where std::regex backtracks exponentially and is only run on short ones.
+// Regex is hacmi: uretilmis kod satirlarinda yaygin arama kaliplarinin tum eslemeleri,
+// LinearRegexEngine ile StdRegexEngine (std::regex) karsilastirmasi; sonra buyuyen satirlarda
+// std::regex'in ustel geri izledigi ve yalnizca kisa olanlarda calistirilan patolojik bir kalip.
+// Usage: bench-regex [lines]   (default 200000)
+// Kullanim: bench-regex [satirlar]   (varsayilan 200000)
+
+// Count every match in lines, stepping past empty ones / Satirlardaki her eslemeyi say, bos olanlari atla
+static size_t countAll(const RegexEngine& re, const std::vector<std::string>& lines) {
+    size_t count = 0;
+    for (const std::string& line : lines) {
+        int offset = 0, position = 0, length = 0;
+        while (offset <= static_cast<int>(line.size()) && re.find(line, offset, position, length)) {
+            ++count;
+            offset = position + std::max(1, length);
+        }
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    const int lineCount = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    std::vector<std::string> lines;
+    size_t bytes = 0;
+    {
+        const std::string text = bench::makeText(static_cast<size_t>(lineCount) * 60, bench::Text::Ascii);
+        for (size_t start = 0, end; (end = text.find('\n', start)) != std::string::npos && lines.size() < static_cast<size_t>(lineCount); start = end + 1) {
+            lines.push_back(text.substr(start, end - start) + " TODO: fix(value) 0x1F");
+            bytes += lines.back().size();
+        }
+    }
+
+    std::printf("%zu lines, %.1f MB\n%-26s %10s %10s %10s %10s %8s\n", lines.size(), bytes / 1e6, "pattern",
+                "linear ms", "std ms", "linear MB/s", "std MB/s", "speedup");
+    const char* patterns[] = {"needle", "\\bsearch\\w*", "[A-Z]{3,}:", "\\d+", "(\\w+)\\s*\\(", "TODO:.*$",
+                              "(?:int|auto)\\s+\\w+", "value|index|buffer"};
+    for (const char* pattern : patterns) {
+        LinearRegexEngine linear;
+        StdRegexEngine reference;
+        linear.compile(pattern);
+        reference.compile(pattern);
+        size_t linearCount = 0, referenceCount = 0;
+        double linearSeconds = bench::bestOf(3, [&] { linearCount = countAll(linear, lines); });
+        double referenceSeconds = bench::bestOf(1, [&] { referenceCount = countAll(reference, lines); });
+        std::printf("%-26s %10.1f %10.1f %10.0f %10.0f %7.1fx%s\n", pattern, linearSeconds * 1e3,
+                    referenceSeconds * 1e3, bench::mbPerSecond(bytes, linearSeconds),
+                    bench::mbPerSecond(bytes, referenceSeconds), referenceSeconds / linearSeconds,
+                    linearCount == referenceCount ? "" : "  (match counts differ)");
+    }
+
+    // (a|a)*b over n 'a's then "!b": the 'b' gets past the literal prefilter, so the linear
+    // engine scans every 'a'; std::regex doubles its work per 'a' at each start
+    // n tane 'a' ve ardindan "!b" uzerinde (a|a)*b: 'b' literal on suzgecini gecirir, boylece
+    // dogrusal motor her 'a'yi tarar; std::regex her baslangicta 'a' basina isini ikiye katlar
+    std::printf("\n%-26s %10s %12s %12s\n", "(a|a)*b over n a's + !b", "n", "linear ms", "std ms");
+    LinearRegexEngine linear;
+    StdRegexEngine reference;
+    linear.compile("(a|a)*b");
+    reference.compile("(a|a)*b");
+    for (int n : {10, 16, 20, 22, 1000, 100000, 10000000}) {
+        const std::string text = std::string(n, 'a') + "!b";
+        RegexMatch match;
+        double linearMs = bench::bestOf(1, [&] { linear.search(text, 0, match); }) * 1e3;
+        char referenceCell[32] = "skipped";
+        if (n <= 22) {
+            double ms = bench::bestOf(1, [&] { reference.search(text, 0, match); }) * 1e3;
+            std::snprintf(referenceCell, sizeof(referenceCell), "%.3f", ms);
+        }
+        std::printf("%-26s %10d %12.3f %12s\n", "", n, linearMs, referenceCell);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "BufferSnapshot.h"
+#include "FileSaver.h"
+#include "LineScanner.h"
+#include "buffer.h"
+#include "file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
+// Save latency: synchronous saveSnapshot time and MB/s per fsync policy, then a background
+// FileSaver save of the same text with how long the caller blocked and the slowest edit made
+// while the write was in flight.
+// Kaydetme gecikmesi: fsync politikasi basina eszamanli saveSnapshot suresi ve MB/s, sonra
+// ayni metnin arka plan FileSaver kaydi; cagiranin ne kadar bekledigi ve yazma surerken
+// yapilan en yavas duzenleme.
+// Usage: bench-save [MB ...]   (default 10 100 500)
+// Kullanim: bench-save [MB ...]   (varsayilan 10 100 500)
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    std::vector<size_t> sizesMb;
+    for (int i = 1; i < argc; ++i) sizesMb.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (sizesMb.empty()) sizesMb = {10, 100, 500};
+
+    const std::string path = bench::tempPath("save.txt");
+    std::printf("%6s %10s %10s %10s %10s %12s %12s %10s\n", "MB", "none ms", "file ms", "full ms", "MB/s",
+                "bg call us", "bg total ms", "edit max us");
+    for (size_t mb : sizesMb) {
+        Buffer buffer;
+        {
+            std::string text = bench::makeText(mb << 20, bench::Text::Ascii);
+            std::vector<std::string> lines;
+            LineScanner::splitLines(text.data(), text.size(), lines);
+            buffer.loadLines(std::move(lines));
+        }
+        const BufferSnapshot snapshot = buffer.snapshot();
+        const size_t bytes = snapshot.byteCount();
+
+        double policyMs[3];
+        const FsyncPolicy policies[3] = {FsyncPolicy::None, FsyncPolicy::File, FsyncPolicy::Full};
+        for (int p = 0; p < 3; ++p) {
+            FileSystem::setFsyncPolicy(policies[p]);
+            policyMs[p] = bench::bestOf(3, [&] { FileSystem::saveSnapshot(snapshot, path); }) * 1e3;
+        }
+        FileSystem::setFsyncPolicy(FsyncPolicy::File);
+
+        // Background save while the caller keeps editing the buffer
+        // Cagiran buffer'i duzenlemeye devam ederken arka plan kaydi
+        FileSaver saver;
+        std::atomic<bool> done{false};
+        auto start = bench::Clock::now();
+        saver.save(buffer.snapshot(), path, {}, [&](const FileResult&, const BufferSnapshot&) { done = true; });
+        const double callUs = bench::secondsSince(start) * 1e6;
+        double editMaxUs = 0;
+        for (int k = 0; !done; ++k) {
+            auto editStart = bench::Clock::now();
+            buffer.insertChar(k % buffer.lineCount(), 0, 'x');
+            editMaxUs = std::max(editMaxUs, bench::secondsSince(editStart) * 1e6);
+        }
+        saver.flush();
+        const double totalMs = bench::secondsSince(start) * 1e3;
+
+        std::printf("%6zu %10.1f %10.1f %10.1f %10.0f %12.1f %12.1f %10.1f\n", mb, policyMs[0], policyMs[1],
+                    policyMs[2], bench::mbPerSecond(bytes, policyMs[1] / 1e3), callUs, totalMs, editMaxUs);
+        FileSystem::deleteFile(path);
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "AllocCounter.h"
+#include "BenchUtil.h"
+#include "BufferSnapshot.h"
+#include "buffer.h"
+
+#include <cstdlib>
+#include <vector>
+
+// Snapshot cost: time and heap allocations per Buffer::snapshot(), against copying every
+// line out (what readers did before snapshots), and per edit+snapshot pair while editing.
+// Snapshot maliyeti: Buffer::snapshot() basina sure ve heap ayirmalari, her satiri disari
+// kopyalamaya karsi (snapshot'lardan once okuyucularin yaptigi) ve duzenleme sirasinda
+// duzenleme+snapshot cifti basina.
+// Usage: bench-snapshot [lines ...]   (default 10000 100000 1000000)
+// Kullanim: bench-snapshot [satirlar ...]   (varsayilan 10000 100000 1000000)
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = {10000, 100000, 1000000};
+
+    std::printf("%9s %12s %12s %12s %12s %14s %14s\n", "lines", "snap ns", "snap allocs", "snap bytes",
+                "copy ms", "copy allocs", "edit+snap al");
+    for (int lines : sizes) {
+        Buffer buffer;
+        for (int i = 0; i < lines; ++i) buffer.insertLine("line " + std::to_string(i) + " of the benchmark buffer");
+
+        const int snapRuns = 1000;
+        bench::AllocScope snapAllocs;
+        double snapSeconds = bench::bestOf(1, [&] {
+            for (int i = 0; i < snapRuns; ++i) {
+                BufferSnapshot snapshot = buffer.snapshot();
+                (void)snapshot.lineCount();
+            }
+        });
+        const size_t snapCount = snapAllocs.count();
+        const size_t snapBytes = snapAllocs.bytes();
+
+        bench::AllocScope copyAllocs;
+        double copySeconds = bench::bestOf(1, [&] {
+            std::vector<std::string> copy;
+            copy.reserve(buffer.lineCount());
+            for (int i = 0; i < buffer.lineCount(); ++i) copy.push_back(buffer.getLine(i));
+        });
+        const size_t copyCount = copyAllocs.count();
+
+        // One edit then one snapshot, like a reader polling an actively edited buffer
+        // Bir duzenleme sonra bir snapshot, etkin duzenlenen bir buffer'i yoklayan bir okuyucu gibi
+        const int edits = 10000;
+        bench::AllocScope editAllocs;
+        for (int i = 0; i < edits; ++i) {
+            buffer.insertText((i * 7919) % buffer.lineCount(), 0, "x");
+            BufferSnapshot snapshot = buffer.snapshot();
+            (void)snapshot.version();
+        }
+
+        std::printf("%9d %12.0f %12.1f %12.0f %12.2f %14zu %14.1f\n", lines, snapSeconds / snapRuns * 1e9,
+                    static_cast<double>(snapCount) / snapRuns, static_cast<double>(snapBytes) / snapRuns,
+                    copySeconds * 1e3, copyCount, static_cast<double>(editAllocs.count()) / edits);
+    }
+    return 0;
+}
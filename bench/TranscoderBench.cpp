@@ -0,0 +1,91 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "BufferSnapshot.h"
+#include "Transcoder.h"
+#include "buffer.h"
+#include "file.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+// Transcoding cost: decode/encode MB/s per encoding over mixed-script text in 64 KB chunks,
+// then loading a UTF-16LE file end to end with the peak memory it took against the buffer size.
+// Kod donusturme maliyeti: karisik yazili metin uzerinde 64 KB parcalarla kodlama basina
+// cozme/kodlama MB/s, sonra bir UTF-16LE dosyasini bastan sona yukleme ve buffer boyutuna
+// karsi aldigi en yuksek bellek.
+// Usage: bench-transcode [file MB]   (default 300)
+// Kullanim: bench-transcode [dosya MB]   (varsayilan 300)
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    const size_t fileMb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300;
+    const size_t chunk = 64 * 1024;
+
+    // The load row runs first, so the peak it reports is not hidden by the other rows
+    // Yukleme satiri once calisir, boylece bildirdigi tepe diger satirlarca gizlenmez
+    {
+        const std::string path = bench::tempPath("utf16.txt");
+        size_t written = 0;
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << "\xFF\xFE";
+            Transcoder encoder(TextEncoding::UTF16_LE);
+            std::string block;
+            for (uint32_t seed = 1; written < (fileMb << 20); ++seed) {
+                block.clear();
+                encoder.encode(bench::makeText(1 << 20, bench::Text::Mixed, seed), block);
+                out.write(block.data(), static_cast<std::streamsize>(block.size()));
+                written += block.size();
+            }
+        }
+        const size_t rssBefore = bench::peakRssBytes();
+        Buffer buffer;
+        auto start = bench::Clock::now();
+        FileSystem::loadToBuffer(buffer, path);
+        const double seconds = bench::secondsSince(start);
+        const size_t peakGrowth = bench::peakRssBytes() - rssBefore;
+        const uint64_t bufferBytes = buffer.snapshot().byteCount();
+        std::printf("load %zu MB UTF-16LE: %.0f MB/s, buffer %.0f MB, peak growth %.0f MB (%.2fx buffer)\n\n",
+                    written >> 20, bench::mbPerSecond(written, seconds), bufferBytes / 1e6, peakGrowth / 1e6,
+                    static_cast<double>(peakGrowth) / bufferBytes);
+        FileSystem::deleteFile(path);
+    }
+
+    const std::string text = bench::makeText(64 << 20, bench::Text::Mixed);
+    std::printf("%-10s %14s %14s\n", "encoding", "decode MB/s", "encode MB/s");
+    const std::pair<const char*, TextEncoding> encodings[] = {
+        {"UTF-16LE", TextEncoding::UTF16_LE}, {"UTF-16BE", TextEncoding::UTF16_BE},
+        {"UTF-32LE", TextEncoding::UTF32_LE}, {"Latin-1", TextEncoding::Latin1}};
+    for (const auto& [name, encoding] : encodings) {
+        std::string bytes;
+        bytes.reserve(text.size() * 4);
+        double encodeSeconds = bench::bestOf(3, [&] {
+            bytes.clear();
+            Transcoder encoder(encoding);
+            for (size_t i = 0; i < text.size(); i += chunk)
+                encoder.encode(std::string_view(text).substr(i, chunk), bytes);
+            encoder.finishEncode(bytes);
+        });
+
+        std::string back;
+        back.reserve(text.size() * 2);
+        double decodeSeconds = bench::bestOf(3, [&] {
+            back.clear();
+            Transcoder decoder(encoding);
+            const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+            for (size_t i = 0; i < bytes.size(); i += chunk)
+                decoder.decode(data + i, std::min(chunk, bytes.size() - i), back);
+            decoder.finishDecode(back);
+        });
+
+        // Throughput in UTF-8 bytes on both sides / Her iki tarafta UTF-8 bayt cinsinden is hacmi
+        std::printf("%-10s %14.0f %14.0f\n", name, bench::mbPerSecond(back.size(), decodeSeconds),
+                    bench::mbPerSecond(text.size(), encodeSeconds));
+    }
+    return 0;
+}
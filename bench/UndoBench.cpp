@@ -0,0 +1,117 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "AllocCounter.h"
+#include "BenchUtil.h"
+#include "buffer.h"
+#include "undo.h"
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+
+// Undo history memory per 100k edits for typical editing patterns: nodes kept, bytes the
+// manager reports, heap allocations made while editing and recording (buffer edits included),
+// and record/teardown time.
+// Tipik duzenleme kaliplari icin 100 bin duzenleme basina geri alma gecmisi bellegi: tutulan
+// dugumler, yoneticinin bildirdigi baytlar, duzenleme ve kayit sirasinda yapilan heap ayirmalari
+// (buffer duzenlemeleri dahil) ve kayit/yikim suresi.
+// Usage: bench-undo [edits]   (default 100000)
+// Kullanim: bench-undo [duzenlemeler]   (varsayilan 100000)
+
+// Single-character action / Tek karakterlik eylem
+static Action charAction(ActionType type, int line, int col, char c) {
+    Action action;
+    action.type = type;
+    action.line = line;
+    action.col = col;
+    action.character = c;
+    return action;
+}
+
+// Whole-line insert action / Tum satir ekleme eylemi
+static Action lineAction(int line, const std::string& text) {
+    Action action;
+    action.type = ActionType::InsertLine;
+    action.line = line;
+    action.col = 0;
+    action.lineContent = text;
+    return action;
+}
+
+// One pattern: perform edit i on the buffer and record it
+// Bir kalip: i. duzenlemeyi buffer uzerinde yap ve kaydet
+struct Pattern {
+    const char* name;
+    std::function<void(int i, Buffer& buffer, UndoManager& undo)> edit;
+};
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    const int edits = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+    const Pattern patterns[] = {
+        {"typing (one run)", [](int i, Buffer& b, UndoManager& u) {
+             b.insertChar(0, i, 'a');
+             u.addAction(charAction(ActionType::Insert, 0, i, 'a'));
+         }},
+        {"typing, break per word", [](int i, Buffer& b, UndoManager& u) {
+             int line = b.lineCount() - 1;
+             int col = b.columnCount(line);
+             b.insertChar(line, col, i % 6 ? 'a' : ' ');
+             u.addAction(charAction(ActionType::Insert, line, col, i % 6 ? 'a' : ' '));
+             if (i % 6 == 0) u.breakRun();
+             if (i % 60 == 59) {
+                 b.insertLineAt(b.lineCount(), "");
+                 u.addAction(lineAction(b.lineCount() - 1, ""));
+             }
+         }},
+        {"insert/backspace pairs", [](int i, Buffer& b, UndoManager& u) {
+             if (i % 2 == 0 || b.columnCount(0) == 0) {
+                 b.insertChar(0, b.columnCount(0), 'a');
+                 u.addAction(charAction(ActionType::Insert, 0, b.columnCount(0) - 1, 'a'));
+             } else {
+                 int col = b.columnCount(0) - 1;
+                 b.deleteChar(0, col);
+                 u.addAction(charAction(ActionType::Delete, 0, col, 'a'));
+             }
+         }},
+        {"uncoalesced chars", [](int i, Buffer& b, UndoManager& u) {
+             b.insertChar(0, i, 'x');
+             u.addAction(charAction(ActionType::Insert, 0, i, 'x'));
+             u.breakRun();
+         }},
+        {"line inserts", [](int i, Buffer& b, UndoManager& u) {
+             std::string text = "inserted line " + std::to_string(i);
+             b.insertLineAt(b.lineCount(), text);
+             u.addAction(lineAction(b.lineCount() - 1, text));
+         }},
+    };
+
+    std::printf("%d edits\n%-24s %10s %12s %12s %12s %10s %12s\n", edits, "pattern", "nodes", "bytes",
+                "bytes/edit", "heap allocs", "record ms", "teardown ms");
+    for (const Pattern& pattern : patterns) {
+        Buffer buffer;
+        buffer.loadLines({""});
+        auto undo = std::make_unique<UndoManager>();
+
+        bench::AllocScope allocs;
+        auto start = bench::Clock::now();
+        for (int i = 0; i < edits; ++i) pattern.edit(i, buffer, *undo);
+        const double recordMs = bench::secondsSince(start) * 1e3;
+        const size_t heapAllocs = allocs.count();
+        const size_t nodes = undo->nodeCount();
+        const size_t bytes = undo->memoryUsage();
+
+        start = bench::Clock::now();
+        undo.reset();
+        const double teardownMs = bench::secondsSince(start) * 1e3;
+
+        std::printf("%-24s %10zu %12zu %12.1f %12zu %10.1f %12.2f\n", pattern.name, nodes, bytes,
+                    static_cast<double>(bytes) / edits, heapAllocs, recordMs, teardownMs);
+    }
+    return 0;
+}
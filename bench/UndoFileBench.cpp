@@ -0,0 +1,100 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BenchUtil.h"
+#include "BufferSnapshot.h"
+#include "UndoFile.h"
+#include "buffer.h"
+#include "undo.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+// Undofile cost: recording time with and without a journal, journal bytes per node, and on
+// reopen how long binding the journal takes against the first undo that replays it.
+// Geri alma dosyasi maliyeti: gunluklu ve gunluksuz kayit suresi, dugum basina gunluk baytlari
+// ve yeniden acista gunlugu baglamanin, onu tekrar oynatan ilk geri almaya karsi suresi.
+// Usage: bench-undofile [nodes ...]   (default 100000 1000000)
+// Kullanim: bench-undofile [dugumler ...]   (varsayilan 100000 1000000)
+
+// Record n single-character edits as n separate nodes
+// n tek karakterlik duzenlemeyi n ayri dugum olarak kaydet
+static void record(int n, Buffer& buffer, UndoManager& undo) {
+    for (int i = 0; i < n; ++i) {
+        Action action;
+        action.type = ActionType::Insert;
+        action.line = i / 100;
+        action.col = i % 100;
+        action.character = 'x';
+        buffer.insertChar(action.line, action.col, action.character);
+        undo.addAction(action);
+        undo.breakRun();
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = {100000, 1000000};
+
+    const std::string dir = bench::tempPath("undofile");
+    std::filesystem::remove_all(dir);
+    UndoFile::setDirectory(dir);
+    UndoManager::setMemoryLimit(0);
+    const std::string path = bench::tempPath("undofile.txt");
+
+    std::printf("%9s %10s %12s %12s %10s %12s %12s\n", "nodes", "plain ms", "journal ms", "bytes/node",
+                "bind ms", "replay ms", "restored");
+    for (int nodes : sizes) {
+        const std::vector<std::string> empty(nodes / 100 + 1);
+
+        double plainMs;
+        {
+            Buffer buffer;
+            buffer.loadLines(std::vector<std::string>(empty));
+            UndoManager undo;
+            auto start = bench::Clock::now();
+            record(nodes, buffer, undo);
+            plainMs = bench::secondsSince(start) * 1e3;
+        }
+
+        double journalMs;
+        uintmax_t journalBytes = 0;
+        std::vector<std::string> saved;
+        {
+            Buffer buffer;
+            buffer.loadLines(std::vector<std::string>(empty));
+            UndoManager undo;
+            undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+            auto start = bench::Clock::now();
+            record(nodes, buffer, undo);
+            undo.journal()->save(undo.savePoint(), UndoFile::hashContent(buffer.snapshot()));
+            undo.journal()->flush();
+            journalMs = bench::secondsSince(start) * 1e3;
+            journalBytes = std::filesystem::file_size(undo.journal()->journalPath());
+            saved = buffer.snapshot().allLines();
+        }
+
+        // Reopen the saved text: binding is lazy, the first undo replays the journal
+        // Kaydedilen metni yeniden ac: baglama tembeldir, ilk geri alma gunlugu tekrar oynatir
+        Buffer buffer;
+        buffer.loadLines(std::move(saved));
+        UndoManager undo;
+        auto start = bench::Clock::now();
+        undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+        const double bindMs = bench::secondsSince(start) * 1e3;
+        start = bench::Clock::now();
+        undo.undo(buffer);
+        const double replayMs = bench::secondsSince(start) * 1e3;
+
+        std::printf("%9d %10.1f %12.1f %12.1f %10.3f %12.1f %12zu\n", nodes, plainMs, journalMs,
+                    static_cast<double>(journalBytes) / nodes, bindMs, replayMs, undo.nodeCount());
+        undo.journal()->remove();
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
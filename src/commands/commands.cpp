@@ -6,10 +6,16 @@
 #include "commands.h"
 #include "EditorContext.h"
 #include "buffers.h"
+#include "BufferSnapshot.h"
+#include "UndoFile.h"
+#include "file.h"
 #include "EventBus.h"
 #include "RegisterManager.h"
 #include "Selection.h"
 #include "SearchEngine.h"
+#include "SearchSession.h"
+#include "WorkspaceSearch.h"
+#include "TrigramIndex.h"
 #include "MarkManager.h"
 #include "MacroRecorder.h"
 #include "KeymapManager.h"
@@ -23,16 +29,157 @@
 #include "CompletionEngine.h"
 #include "CharClassifier.h"
 #include "EncodingDetector.h"
+#include "Transcoder.h"
 #include "ProcessManager.h"
 #include "TreeSitterEngine.h"
 #include "PluginManager.h"
 #include "Extmark.h"
+#include "PositionMap.h"
 #include "BufferOptions.h"
 #include "AutoSave.h"
 #include "HelpSystem.h"
 #include "Logger.h"
+#include <chrono>
+#include <filesystem>
+#include <memory>
 #include <sstream>
 
+// Limit and progress for search.findAll / search.countMatches: "maxResults" caps the matches,
+// progress goes out as "searchProgress" events in 5% steps (worker threads report it, the bus
+// delivers it asynchronously)
+// search.findAll / search.countMatches icin sinir ve ilerleme: "maxResults" eslemeleri sinirlar,
+// ilerleme %5'lik adimlarla "searchProgress" olaylari olarak gider (calisan thread'ler bildirir,
+// veriyolu asenkron iletir)
+static SearchScan searchScanFor(EditorContext* ctx, const json& args, const std::string& pattern) {
+    SearchScan scan;
+    scan.maxResults = std::max(0, args.value("maxResults", 0));
+    EventBus* eb = ctx->eventBus;
+    if (!eb) return scan;
+    auto lastPercent = std::make_shared<int>(-1);
+    scan.onProgress = [eb, pattern, lastPercent](int done, int total) {
+        int percent = total > 0 ? static_cast<int>(static_cast<int64_t>(done) * 100 / total) : 100;
+        if (percent < 100 && percent < *lastPercent + 5) return;
+        *lastPercent = percent;
+        json payload = {{"pattern", pattern}, {"lines", done}, {"total", total},
+                        {"percent", percent}, {"done", done >= total}};
+        eb->emit("searchProgress", payload.dump());
+    };
+    return scan;
+}
+
+// A match as search commands report it
+// Arama komutlarinin bildirdigi haliyle bir esleme
+static json searchMatchJson(const SearchMatch& m) {
+    return {{"line", m.line}, {"col", m.col}, {"length", m.length},
+            {"endLine", m.endLine}, {"endCol", m.endCol}};
+}
+
+// A workspace search from command args: {pattern, root, caseSensitive, regex, wholeWord,
+// maxResults (default 1000), maxFileSizeMb, ignoreDirs}; unsaved buffers override their files
+// Komut argumanlarindan bir calisma alani aramasi: {pattern, root, caseSensitive, regex, wholeWord,
+// maxResults (varsayilan 1000), maxFileSizeMb, ignoreDirs}; kaydedilmemis buffer'lar dosyalarinin yerine gecer
+static WorkspaceQuery workspaceQueryFor(EditorContext* ctx, const json& args) {
+    WorkspaceQuery query;
+    query.root = args.value("root", "");
+    query.pattern = args.value("pattern", "");
+    query.opts.caseSensitive = args.value("caseSensitive", true);
+    query.opts.regex = args.value("regex", false);
+    query.opts.wholeWord = args.value("wholeWord", false);
+    query.maxResults = std::max(0, args.value("maxResults", 1000));
+    query.maxFileSize = static_cast<uint64_t>(std::max(0, args.value("maxFileSizeMb", 0))) * 1024 * 1024;
+    if (args.contains("ignoreDirs") && args["ignoreDirs"].is_array()) {
+        for (const auto& d : args["ignoreDirs"]) {
+            if (d.is_string()) query.ignoreDirs.push_back(d.get<std::string>());
+        }
+    }
+    if (ctx->buffers) query.overrides = ctx->buffers->modifiedSnapshots();
+    return query;
+}
+
+// Workspace matches and stats as search.grep / search.workspace report them
+// search.grep / search.workspace'in bildirdigi haliyle calisma alani eslemeleri ve istatistikleri
+static json workspaceResultJson(const std::vector<WorkspaceMatch>& found, const WorkspaceStats& stats) {
+    json matches = json::array();
+    for (const auto& m : found) {
+        matches.push_back({{"path", m.path}, {"line", m.line}, {"col", m.col}, {"length", m.length},
+                           {"endLine", m.endLine}, {"endCol", m.endCol}, {"text", m.text}});
+    }
+    return {{"matches", std::move(matches)},
+            {"stats", {{"files", stats.files}, {"filesMatched", stats.filesMatched},
+                       {"skipped", stats.skipped}, {"matches", stats.matches},
+                       {"truncated", stats.truncated}, {"cancelled", stats.cancelled}}}};
+}
+
+// Bring a document's search session up to date and push what changed as one
+// "searchResultsChanged" event: {path, pattern, version, count, reset, removed} and, unless
+// reset, "lines" (the replaced line runs, in order) and "added" (matches found in them)
+// Bir belgenin arama oturumunu guncelle ve degisenleri tek bir "searchResultsChanged" olayi
+// olarak gonder: {path, pattern, version, count, reset, removed} ve reset degilse "lines"
+// (degistirilen satir dizileri, sirayla) ve "added" (icinde bulunan eslemeler)
+static void refreshSearchSession(EditorContext* ctx, const EditorState& st) {
+    auto session = st.getSearchSession();
+    if (!session || !ctx->searchEngine) return;
+    SearchDelta delta;
+    if (!session->refresh(st.getBuffer(), *ctx->searchEngine, &delta) || !ctx->eventBus) return;
+
+    json payload = {{"path", st.getFilePath()}, {"pattern", session->pattern()},
+                    {"version", delta.version}, {"count", delta.count},
+                    {"reset", delta.reset}, {"removed", delta.removed}};
+    if (!delta.reset) {
+        json lines = json::array();
+        for (const auto& c : delta.lines) {
+            lines.push_back({{"line", c.line}, {"removed", c.removed}, {"added", c.added}});
+        }
+        json added = json::array();
+        for (const auto& m : delta.added) added.push_back(searchMatchJson(m));
+        payload["lines"] = std::move(lines);
+        payload["added"] = std::move(added);
+    }
+    ctx->eventBus->emit("searchResultsChanged", payload.dump());
+}
+
+// Finish a batch applied with Buffer::applyEdits: one undo group, cursor, marks, extmarks and
+// folds moved once, one "bufferChanged" event with the path like any other edit, then one
+// "bufferEditsApplied" event {path, changes} listing the changed ranges. Returns that list.
+// Buffer::applyEdits ile uygulanan bir grubu bitir: tek geri alma grubu, imlec, isaretler,
+// extmark'lar ve katlamalar bir kez tasinir, diger her duzenleme gibi yolla tek bir
+// "bufferChanged" olayi, ardindan degisen araliklari listeleyen tek bir "bufferEditsApplied"
+// olayi {path, changes}. O listeyi dondurur.
+static json settleEdits(EditorContext* ctx, EditorState& st, const std::vector<AppliedEdit>& applied) {
+    json changes = json::array();
+    if (applied.empty()) return changes;
+
+    st.getUndo().addEdits(applied);
+    for (const auto& a : applied) {
+        const TextEdit& e = a.edit;
+        changes.push_back({
+            {"startLine", e.startLine}, {"startCol", e.startCol},
+            {"oldEndLine", e.endLine}, {"oldEndCol", e.endCol},
+            {"newEndLine", a.newEndLine}, {"newEndCol", a.newEndCol},
+            {"linesAdded", (a.newEndLine - e.startLine) - (e.endLine - e.startLine)},
+            {"text", e.text}
+        });
+    }
+
+    PositionMap map(applied);
+    auto& cur = st.getCursor();
+    int line = cur.getLine(), col = cur.getCol();
+    map.map(line, col);
+    cur.setPosition(line, col);
+    if (ctx->markManager) ctx->markManager->adjustForEdits(map);
+    if (ctx->extmarkManager) ctx->extmarkManager->adjustForEdits(map);
+    if (ctx->foldManager) ctx->foldManager->adjustForEdits(map);
+
+    st.markModified(true);
+    st.syncCursor();
+    if (ctx->eventBus) {
+        ctx->eventBus->emit("bufferChanged", st.getFilePath());
+        ctx->eventBus->emit("bufferEditsApplied",
+            json{{"path", st.getFilePath()}, {"changes", changes}}.dump());
+    }
+    return changes;
+}
+
 // Register all core built-in commands (~20 native commands) with the router
 // Tum temel yerlesik komutlari (~20 native komut) yonlendiriciyle kaydet
 void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
@@ -93,8 +240,9 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         } else if (key == "PageDown") {
             for (int i = 0; i < 20; ++i) cur.moveDown(buf);
         } else if (key == "Ctrl+S" || key == "C-s") {
+            // Written in the background; the saver emits fileSaved / fileSaveFailed
+            // Arka planda yazilir; kaydedici fileSaved / fileSaveFailed yayinlar
             ctx->buffers->saveActive();
-            if (ctx->eventBus) ctx->eventBus->emit("fileSaved", st.getFilePath());
         } else {
             LOG_DEBUG("[Command] input.key unhandled: ", key);
             return;
@@ -252,8 +400,6 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
     router.registerNative("file.save", [ctx](const json&) {
         if (!ctx || !ctx->buffers) return;
         ctx->buffers->saveActive();
-        auto& st = ctx->buffers->active();
-        if (ctx->eventBus) ctx->eventBus->emit("fileSaved", st.getFilePath());
     });
     router.registerNative("file.saveAs", [ctx](const json& args) {
         if (!ctx || !ctx->buffers) return;
@@ -262,7 +408,22 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         auto& st = ctx->buffers->active();
         st.setFilePath(path);
         ctx->buffers->saveActive();
-        if (ctx->eventBus) ctx->eventBus->emit("fileSaved", path);
+    });
+
+    // --- file.setEncoding: Save the active buffer in another encoding from now on ---
+    // --- file.setEncoding: Aktif buffer'i bundan sonra baska bir kodlamayla kaydet ---
+    // args: {encoding: "utf-16le", bom?: bool} (bom defaults to on for UTF-16/32 and utf-8-bom)
+    router.registerNative("file.setEncoding", [ctx](const json& args) {
+        if (!ctx || !ctx->buffers) return;
+        TextEncoding enc = EncodingDetector::parseEncoding(args.value("encoding", ""));
+        if (enc == TextEncoding::Unknown) return;
+        if (enc == TextEncoding::ASCII) enc = TextEncoding::UTF8;
+        bool bom = args.value("bom", !Transcoder::byteOrderMark(enc).empty());
+        if (enc == TextEncoding::UTF8 && bom) enc = TextEncoding::UTF8_BOM;
+        if (enc == TextEncoding::UTF8_BOM && !bom) enc = TextEncoding::UTF8;
+        auto& st = ctx->buffers->active();
+        st.getBuffer().setFileEncoding({enc, bom});
+        st.markModified(true);
     });
 
     // --- tab.next / tab.prev / tab.close / tab.switchTo ---
@@ -546,6 +707,7 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         opts.regex         = args.value("regex", false);
         opts.wholeWord     = args.value("wholeWord", false);
         opts.wrapAround    = args.value("wrapAround", true);
+        opts.multiline     = args.value("multiline", false);
 
         auto& st  = ctx->buffers->active();
         auto& cur = st.getCursor();
@@ -573,6 +735,7 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         opts.regex         = args.value("regex", false);
         opts.wholeWord     = args.value("wholeWord", false);
         opts.wrapAround    = args.value("wrapAround", true);
+        opts.multiline     = args.value("multiline", false);
 
         auto& st  = ctx->buffers->active();
         auto& cur = st.getCursor();
@@ -635,6 +798,7 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         SearchOptions opts;
         opts.caseSensitive = args.value("caseSensitive", true);
         opts.regex         = args.value("regex", false);
+        opts.multiline     = args.value("multiline", false);
 
         auto& st  = ctx->buffers->active();
         auto& cur = st.getCursor();
@@ -652,23 +816,42 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
 
     // --- search.replaceAll: Replace all occurrences ---
     // --- search.tumunuDegistir: Tum oluslari degistir ---
-    router.registerNative("search.replaceAll", [ctx](const json& args) {
-        if (!ctx || !ctx->buffers || !ctx->searchEngine) return;
+    // Every affected line is rewritten once and the whole replace is one undo step and one
+    // "bufferChanged" event. With "dryRun" nothing changes and the rewrites come back as
+    // {line, col, endLine, endCol, matches, before, after}.
+    // Etkilenen her satir bir kez yeniden yazilir ve tum degistirme tek geri alma adimi ve tek
+    // "bufferChanged" olayidir. "dryRun" ile hicbir sey degismez ve yeniden yazimlar
+    // {line, col, endLine, endCol, matches, before, after} olarak doner.
+    router.registerQuery("search.replaceAll", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->buffers || !ctx->searchEngine) return json::object();
         std::string pattern     = args.value("pattern", "");
         std::string replacement = args.value("replacement", "");
-        if (pattern.empty()) return;
+        if (pattern.empty()) return {{"count", 0}};
 
         SearchOptions opts;
         opts.caseSensitive = args.value("caseSensitive", true);
         opts.regex         = args.value("regex", false);
+        opts.wholeWord     = args.value("wholeWord", false);
+        opts.multiline     = args.value("multiline", false);
 
         auto& st = ctx->buffers->active();
-        int count = ctx->searchEngine->replaceAll(st.getBuffer(), pattern, replacement, opts);
-        if (count > 0) {
-            st.markModified(true);
-            if (ctx->eventBus) ctx->eventBus->emit("bufferChanged", st.getFilePath());
-            LOG_INFO("[Search] Replaced ", count, " occurrences");
+        if (args.value("dryRun", false)) {
+            auto plan = ctx->searchEngine->previewReplaceAll(st.getBuffer().snapshot(), pattern, replacement, opts);
+            json lines = json::array();
+            int count = 0;
+            for (const auto& r : plan) {
+                count += r.matches;
+                lines.push_back({{"line", r.line}, {"col", r.col}, {"endLine", r.endLine}, {"endCol", r.endCol},
+                                 {"matches", r.matches}, {"before", r.before}, {"after", r.after}});
+            }
+            return {{"count", count}, {"dryRun", true}, {"lines", lines}};
         }
+
+        std::vector<AppliedEdit> applied;
+        int count = ctx->searchEngine->replaceAll(st.getBuffer(), pattern, replacement, opts, &applied);
+        json changes = settleEdits(ctx, st, applied);
+        if (count > 0) LOG_INFO("[Search] Replaced ", count, " occurrences");
+        return {{"count", count}, {"changes", changes}};
     });
 
     // --- mark.set: Set a named mark at cursor position ---
@@ -982,7 +1165,7 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         int line = args.value("line", -1);
         if (line < 0) line = st.getCursor().getLine();
         if (line < 0 || line >= buf.lineCount()) return;
-        buf.getLineRef(line) = ctx->indentEngine->increaseIndent(buf.getLine(line));
+        buf.setLine(line, ctx->indentEngine->increaseIndent(buf.getLine(line)));
         st.markModified(true);
         if (ctx->eventBus) ctx->eventBus->emit("bufferChanged", st.getFilePath());
     });
@@ -996,7 +1179,7 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         int line = args.value("line", -1);
         if (line < 0) line = st.getCursor().getLine();
         if (line < 0 || line >= buf.lineCount()) return;
-        buf.getLineRef(line) = ctx->indentEngine->decreaseIndent(buf.getLine(line));
+        buf.setLine(line, ctx->indentEngine->decreaseIndent(buf.getLine(line)));
         st.markModified(true);
         if (ctx->eventBus) ctx->eventBus->emit("bufferChanged", st.getFilePath());
     });
@@ -1122,6 +1305,12 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
     // --- treesitter.parse: Mevcut dille kaynak kodu ayristir ---
     router.registerNative("treesitter.parse", [ctx](const json& args) {
         if (!ctx || !ctx->treeSitter) return;
+        // Without a source, parse the active buffer straight from a snapshot
+        // Kaynak yoksa aktif buffer'i dogrudan bir anlik goruntuden ayristir
+        if (!args.contains("source") && ctx->buffers) {
+            ctx->treeSitter->parse(ctx->buffers->active().getBuffer().snapshot());
+            return;
+        }
         std::string source = args.value("source", "");
         ctx->treeSitter->parse(source);
     });
@@ -1395,6 +1584,33 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         return ctx->diffEngine->unifiedDiff(hunks, oldName, newName);
     });
 
+    // --- diff.buffer: Diff the file on disk against a snapshot of the active buffer ---
+    // --- diff.buffer: Diskteki dosyayi aktif buffer'in anlik goruntusuyle karsilastir ---
+    router.registerQuery("diff.buffer", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->diffEngine || !ctx->buffers) return json::array();
+        auto& st = ctx->buffers->active();
+        std::string path = args.value("path", st.getFilePath());
+        BufferSnapshot snap = st.getBuffer().snapshot();
+
+        std::vector<std::string> oldLines;
+        if (auto text = FileSystem::loadTextFile(path)) {
+            std::istringstream ss(*text);
+            std::string line;
+            while (std::getline(ss, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                oldLines.push_back(std::move(line));
+            }
+        }
+        auto hunks = ctx->diffEngine->diff(oldLines, snap.allLines());
+        json result = json::array();
+        for (auto& h : hunks) {
+            result.push_back({{"oldStart", h.oldStart}, {"oldCount", h.oldCount},
+                              {"newStart", h.newStart}, {"newCount", h.newCount},
+                              {"oldLines", h.oldLines}, {"newLines", h.newLines}});
+        }
+        return result;
+    });
+
     // --- diff.merge3: Three-way merge ---
     // --- diff.merge3: Uc yonlu birlestirme ---
     router.registerQuery("diff.merge3", [ctx](const json& args) -> json {
@@ -1562,6 +1778,14 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         return ctx->encodingDetector->encodingName(parsed);
     });
 
+    // --- encoding.current: Encoding the active buffer is saved in ---
+    // --- encoding.current: Aktif buffer'in kaydedildigi kodlama ---
+    router.registerQuery("encoding.current", [ctx](const json&) -> json {
+        if (!ctx || !ctx->buffers) return nullptr;
+        FileEncoding enc = ctx->buffers->active().getBuffer().fileEncoding();
+        return json({{"encoding", EncodingDetector::encodingName(enc.encoding)}, {"bom", enc.bom}});
+    });
+
     // --- process.isRunning: Check if a subprocess is running ---
     // --- process.isRunning: Bir alt surecin calisip calismadigini kontrol et ---
     router.registerQuery("process.isRunning", [ctx](const json& args) -> json {
@@ -1754,11 +1978,11 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         opts.caseSensitive = args.value("caseSensitive", true);
         opts.regex = args.value("regex", false);
         opts.wholeWord = args.value("wholeWord", false);
-        auto matches = ctx->searchEngine->findAll(ctx->buffers->active().getBuffer(), pattern, opts);
+        opts.multiline = args.value("multiline", false);
+        auto matches = ctx->searchEngine->findAll(ctx->buffers->active().getBuffer().snapshot(), pattern, opts,
+                                                  searchScanFor(ctx, args, pattern));
         json arr = json::array();
-        for (auto& m : matches) {
-            arr.push_back({{"line", m.line}, {"col", m.col}, {"length", m.length}});
-        }
+        for (auto& m : matches) arr.push_back(searchMatchJson(m));
         return arr;
     });
 
@@ -1981,11 +2205,69 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         int el = args.value("endLine", -1), ec = args.value("endCol", -1);
         if (sl < 0 || sc < 0 || el < 0 || ec < 0) return;
         auto& st = ctx->buffers->active();
-        st.getBuffer().deleteRange(sl, sc, el, ec);
+
+        // The undo record keeps the removed lines by reference, not as a copy
+        // Geri alma kaydi silinen satirlari kopya olarak degil referansla tutar
+        auto before = st.getBuffer().cutRange(sl, sc, el, ec);
+        if (!before) return;
+        Action del{ActionType::DeleteRange, sl, sc, '\0', {}, el, ec, std::move(before)};
+        st.getUndo().addAction(del);
         st.markModified(true);
         if (ctx->eventBus) ctx->eventBus->emit("bufferChanged", st.getFilePath());
     });
 
+    // --- buffer.applyEdits: Apply a batch of edits as one undo step and one change event ---
+    // --- buffer.applyEdits: Bir duzenleme grubunu tek geri alma adimi ve tek degisiklik olayi olarak uygula ---
+    // Each edit is {startLine, startCol, endLine, endCol, text} in bytes or an LSP TextEdit
+    // {range, newText} in UTF-16 code units (a batch uses one form); all ranges refer to the
+    // text before the batch. Returns the changes, in bytes, in application order.
+    // Her duzenleme bayt cinsinden {startLine, startCol, endLine, endCol, text} veya UTF-16 kod
+    // birimi cinsinden bir LSP TextEdit {range, newText} (bir grup tek bicim kullanir); tum
+    // araliklar gruptan onceki metne gore. Degisiklikleri bayt cinsinden uygulama sirasiyla dondurur.
+    router.registerQuery("buffer.applyEdits", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->buffers) return json::object();
+        json list = args.value("edits", json::array());
+        if (!list.is_array()) throw std::invalid_argument("edits must be an array");
+
+        std::vector<TextEdit> edits;
+        edits.reserve(list.size());
+        ColumnUnit unit = ColumnUnit::Byte;
+        for (const auto& j : list) {
+            TextEdit e;
+            bool lsp = j.contains("range");
+            if (!edits.empty() && lsp != (unit == ColumnUnit::UTF16)) {
+                throw std::invalid_argument("edits mix LSP and byte ranges");
+            }
+            if (lsp) {
+                unit = ColumnUnit::UTF16;
+                const json& r = j["range"];
+                e.startLine = r["start"].value("line", 0);
+                e.startCol  = r["start"].value("character", 0);
+                e.endLine   = r["end"].value("line", 0);
+                e.endCol    = r["end"].value("character", 0);
+                e.text      = j.value("newText", "");
+            } else {
+                e.startLine = j.value("startLine", 0);
+                e.startCol  = j.value("startCol", 0);
+                e.endLine   = j.value("endLine", e.startLine);
+                e.endCol    = j.value("endCol", e.startCol);
+                e.text      = j.value("text", "");
+            }
+            edits.push_back(std::move(e));
+        }
+
+        auto& st = ctx->buffers->active();
+        std::vector<AppliedEdit> applied;
+        if (!st.getBuffer().applyEdits(edits, &applied, unit)) {
+            throw std::invalid_argument("edit range out of bounds or overlapping");
+        }
+
+        // One undo step, one position update and one change event for the whole batch
+        // Tum grup icin tek geri alma adimi, tek konum guncellemesi ve tek degisiklik olayi
+        json changes = settleEdits(ctx, st, applied);
+        return {{"applied", (int)applied.size()}, {"changes", changes}};
+    });
+
     // --- buffer.joinLines: Join two consecutive lines ---
     // --- buffer.joinLines: Ardisik iki satiri birlestir ---
     router.registerNative("buffer.joinLines", [ctx](const json& args) {
@@ -2020,7 +2302,18 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
     router.registerNative("buffer.clear", [ctx](const json&) {
         if (!ctx || !ctx->buffers) return;
         auto& st = ctx->buffers->active();
-        st.getBuffer().clear();
+        auto& buf = st.getBuffer();
+
+        // Cut everything instead of dropping the storage, so undo can splice it back
+        // Depolamayi atmak yerine her seyi kes, boylece geri alma onu geri ekleyebilir
+        buf.cancelLoading();
+        int last = buf.lineCount() - 1;
+        int lastCol = buf.columnCount(last);
+        auto before = buf.cutRange(0, 0, last, lastCol);
+        if (before) {
+            Action del{ActionType::DeleteRange, 0, 0, '\0', {}, last, lastCol, std::move(before)};
+            st.getUndo().addAction(del);
+        }
         st.getCursor().setPosition(0, 0);
         st.markModified(true);
         if (ctx->eventBus) ctx->eventBus->emit("bufferChanged", st.getFilePath());
@@ -2030,9 +2323,8 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
     // --- file.saveAll: Tum acik bufferlari kaydet ---
     router.registerNative("file.saveAll", [ctx](const json&) {
         if (!ctx || !ctx->buffers) return;
-        int saved = ctx->buffers->saveAll();
-        LOG_INFO("[Command] file.saveAll: saved ", saved, " buffers");
-        if (ctx->eventBus) ctx->eventBus->emit("fileSaved", "all");
+        int queued = ctx->buffers->saveAll();
+        LOG_INFO("[Command] file.saveAll: queued ", queued, " buffers");
     });
 
     // --- tab.closeAt: Close buffer at index ---
@@ -2066,6 +2358,41 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         ctx->buffers->active().getUndo().branch(index);
     });
 
+    // --- undo.goto: Jump to a node ({id}) or a past time ({time} Unix ms, or {secondsAgo}) ---
+    // --- undo.goto: Bir dugume ({id}) veya gecmis bir zamana ({time} Unix ms ya da {secondsAgo}) atla ---
+    router.registerNative("undo.goto", [ctx](const json& args) {
+        if (!ctx || !ctx->buffers) return;
+        auto& st = ctx->buffers->active();
+        bool moved = false;
+        if (args.contains("id")) {
+            moved = st.getUndo().gotoNode(args.value("id", 0u), st.getBuffer());
+        } else if (args.contains("time") || args.contains("secondsAgo")) {
+            int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            int64_t when = args.contains("time")
+                ? args.value("time", int64_t{0})
+                : now - static_cast<int64_t>(args.value("secondsAgo", 0.0) * 1000);
+            moved = st.getUndo().gotoTime(when, st.getBuffer());
+        }
+        if (!moved) return;
+        st.syncCursor();
+        if (ctx->eventBus) ctx->eventBus->emit("bufferChanged", st.getFilePath());
+    });
+
+    // --- undo.clear: Forget the active buffer's history, including its undofile ---
+    // --- undo.clear: Aktif buffer'in gecmisini geri alma dosyasi dahil unut ---
+    router.registerNative("undo.clear", [ctx](const json&) {
+        if (!ctx || !ctx->buffers) return;
+        ctx->buffers->active().getUndo().clear();
+    });
+
+    // --- undo.breakRun: Start a new undo step at the next keystroke ---
+    // --- undo.breakRun: Sonraki tusta yeni bir geri alma adimi baslat ---
+    router.registerNative("undo.breakRun", [ctx](const json&) {
+        if (!ctx || !ctx->buffers) return;
+        ctx->buffers->active().getUndo().breakRun();
+    });
+
     // --- fold.remove: Remove a fold region ---
     // --- fold.remove: Bir katlama bolgesini kaldir ---
     router.registerNative("fold.remove", [ctx](const json& args) {
@@ -2336,6 +2663,11 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         int sl = args.value("startLine", 0), sc = args.value("startCol", 0);
         int oel = args.value("oldEndLine", 0), oec = args.value("oldEndCol", 0);
         int nel = args.value("newEndLine", 0), nec = args.value("newEndCol", 0);
+        if (!args.contains("source") && ctx->buffers) {
+            ctx->treeSitter->editAndReparse(sl, sc, oel, oec, nel, nec,
+                ctx->buffers->active().getBuffer().snapshot());
+            return;
+        }
         std::string src = args.value("source", "");
         ctx->treeSitter->editAndReparse(sl, sc, oel, oec, nel, nec, src);
     });
@@ -2363,6 +2695,13 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         return ctx->buffers->active().getBuffer().lineCount();
     });
 
+    // --- buffer.isLoading: Whether the file is still loading (lineCount is then a lower bound) ---
+    // --- buffer.isLoading: Dosya hala yukleniyor mu (o zaman lineCount alt sinirdir) ---
+    router.registerQuery("buffer.isLoading", [ctx](const json&) -> json {
+        if (!ctx || !ctx->buffers) return false;
+        return ctx->buffers->active().getBuffer().isLoading();
+    });
+
     // --- buffer.columnCount: Get column count of a line ---
     // --- buffer.columnCount: Bir satirin sutun sayisini al ---
     router.registerQuery("buffer.columnCount", [ctx](const json& args) -> json {
@@ -2382,6 +2721,50 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         return ctx->buffers->active().getBuffer().isValidPos(line, col);
     });
 
+    // --- buffer.offsetOf: Byte offset of a (line, col) position ---
+    // --- buffer.offsetOf: Bir (line, col) konumunun bayt ofseti ---
+    router.registerQuery("buffer.offsetOf", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->buffers) return 0;
+        int line = args.value("line", 0), col = args.value("col", 0);
+        return ctx->buffers->active().getBuffer().offsetOf(line, col);
+    });
+
+    // --- buffer.positionOf: (line, col) position of a byte offset ---
+    // --- buffer.positionOf: Bir bayt ofsetinin (line, col) konumu ---
+    router.registerQuery("buffer.positionOf", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->buffers) return json::object();
+        uint64_t offset = args.value("offset", uint64_t{0});
+        TextPosition pos = ctx->buffers->active().getBuffer().positionOf(offset);
+        return {{"line", pos.line}, {"col", pos.col}};
+    });
+
+    // --- buffer.convertColumns: Convert columns of many positions between byte/codepoint/utf16/display ---
+    // --- buffer.convertColumns: Bircok konumun sutunlarini byte/codepoint/utf16/display arasinda donustur ---
+    router.registerQuery("buffer.convertColumns", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->buffers) return json::array();
+        json list = args.value("positions", json::array());
+        if (!list.is_array()) throw std::invalid_argument("positions must be an array");
+        ColumnUnit from, to;
+        if (!ColumnIndex::parseUnit(args.value("from", "byte"), from) ||
+            !ColumnIndex::parseUnit(args.value("to", "byte"), to)) {
+            throw std::invalid_argument("units must be byte, codepoint, utf16 or display");
+        }
+        int tabWidth = args.value("tabWidth", ctx->indentEngine ? ctx->indentEngine->config().tabWidth : 4);
+
+        std::vector<TextPosition> positions;
+        positions.reserve(list.size());
+        for (const auto& j : list) {
+            positions.push_back({j.value("line", 0), j.value("col", 0)});
+        }
+        ctx->buffers->active().getBuffer().convertColumns(positions, from, to, tabWidth);
+
+        json result = json::array();
+        for (const auto& pos : positions) {
+            result.push_back({{"line", pos.line}, {"col", pos.col}});
+        }
+        return result;
+    });
+
     // --- buffers.count: Get open buffer count ---
     // --- buffers.count: Acik buffer sayisini al ---
     router.registerQuery("buffers.count", [ctx](const json&) -> json {
@@ -2470,6 +2853,31 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         return ctx->buffers->active().getUndo().inGroup();
     });
 
+    // --- undo.tree: Every node of the active buffer's undo tree, for visualizers ---
+    // --- undo.tree: Gorsellestiriciler icin aktif buffer'in geri alma agacinin tum dugumleri ---
+    router.registerQuery("undo.tree", [ctx](const json&) -> json {
+        if (!ctx || !ctx->buffers) return json::object();
+        auto& undo = ctx->buffers->active().getUndo();
+        json nodes = json::array();
+        for (const auto& n : undo.tree()) {
+            nodes.push_back({{"id", n.id}, {"parent", n.parent}, {"activeChild", n.activeChild},
+                             {"type", actionTypeName(n.type)}, {"line", n.line}, {"col", n.col},
+                             {"length", n.textLen}, {"groupSize", n.groupSize}, {"time", n.time}});
+        }
+        return {{"root", undo.rootId()}, {"current", undo.currentId()}, {"nodes", nodes}};
+    });
+
+    // --- undo.stats: History size of the active buffer ---
+    // --- undo.stats: Aktif buffer'in gecmis boyutu ---
+    router.registerQuery("undo.stats", [ctx](const json&) -> json {
+        if (!ctx || !ctx->buffers) return json::object();
+        auto& undo = ctx->buffers->active().getUndo();
+        auto journal = undo.journal();
+        return {{"nodes", undo.nodeCount()}, {"bytes", undo.memoryUsage()},
+                {"limit", UndoManager::memoryLimit()},
+                {"file", journal ? json(journal->journalPath()) : json(nullptr)}};
+    });
+
     // --- folds.isLineHidden: Check if line is hidden by fold ---
     // --- folds.isLineHidden: Satirin katlama ile gizlenip gizlenmedigini kontrol et ---
     router.registerQuery("folds.isLineHidden", [ctx](const json& args) -> json {
@@ -2539,7 +2947,158 @@ void RegisterCommands(CommandRouter& router, EditorContext* ctx) {
         SearchOptions opts;
         opts.caseSensitive = args.value("caseSensitive", true);
         opts.regex = args.value("regex", false);
-        return ctx->searchEngine->countMatches(ctx->buffers->active().getBuffer(), pattern, opts);
+        opts.wholeWord = args.value("wholeWord", false);
+        opts.multiline = args.value("multiline", false);
+        return ctx->searchEngine->countMatches(ctx->buffers->active().getBuffer().snapshot(), pattern, opts,
+                                               searchScanFor(ctx, args, pattern));
+    });
+
+    // --- search.cancel: Stop running findAll / countMatches scans ---
+    // --- search.cancel: Calisan findAll / countMatches taramalarini durdur ---
+    router.registerNative("search.cancel", [ctx](const json&) {
+        if (!ctx || !ctx->searchEngine) return;
+        ctx->searchEngine->cancel();
+    });
+
+    // --- search.session.start: Keep the results of a search current as the buffer is edited ---
+    // --- search.session.start: Bir aramanin sonuclarini buffer duzenlendikce guncel tut ---
+    // Replaces the active document's session; edits then rescan only the lines they touched and
+    // push "searchResultsChanged" deltas. Returns {count, version}.
+    // Etkin belgenin oturumunu degistirir; duzenlemeler sonra yalnizca dokunduklari satirlari
+    // yeniden tarar ve "searchResultsChanged" farklari gonderir. {count, version} dondurur.
+    router.registerQuery("search.session.start", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->buffers || !ctx->searchEngine) return nullptr;
+        std::string pattern = args.value("pattern", "");
+        if (pattern.empty()) return nullptr;
+        SearchOptions opts;
+        opts.caseSensitive = args.value("caseSensitive", true);
+        opts.regex = args.value("regex", false);
+        opts.wholeWord = args.value("wholeWord", false);
+        opts.multiline = args.value("multiline", false);
+        auto& st = ctx->buffers->active();
+        auto session = std::make_shared<SearchSession>(pattern, opts);
+        st.setSearchSession(session);
+        refreshSearchSession(ctx, st);
+        return {{"count", session->count()}, {"version", session->version()}};
+    });
+
+    // --- search.session.query: Session matches in a line range (viewport) ---
+    // --- search.session.query: Bir satir araligindaki (gorunum) oturum eslemeleri ---
+    // {firstLine, lastLine} -> {count, version, matches}; null without a session
+    // {firstLine, lastLine} -> {count, version, matches}; oturum yoksa null
+    router.registerQuery("search.session.query", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->buffers) return nullptr;
+        auto& st = ctx->buffers->active();
+        auto session = st.getSearchSession();
+        if (!session) return nullptr;
+        refreshSearchSession(ctx, st);
+        int firstLine = args.value("firstLine", 0);
+        int lastLine = args.value("lastLine", st.getBuffer().lineCount() - 1);
+        json matches = json::array();
+        for (const auto& m : session->query(firstLine, lastLine)) matches.push_back(searchMatchJson(m));
+        return {{"count", session->count()}, {"version", session->version()}, {"matches", std::move(matches)}};
+    });
+
+    // --- search.session.stop: Drop the active document's search session ---
+    // --- search.session.stop: Etkin belgenin arama oturumunu birak ---
+    router.registerNative("search.session.stop", [ctx](const json&) {
+        if (!ctx || !ctx->buffers) return;
+        ctx->buffers->active().setSearchSession(nullptr);
+    });
+
+    // Every edit path announces itself with bufferChanged, naming the edited document by its
+    // path. That document is refreshed under the document list lock, whichever one is active
+    // by the time the event is dispatched.
+    // Her duzenleme yolu kendini duzenlenen belgeyi yoluyla adlandiran bufferChanged ile duyurur.
+    // Olay iletildiginde hangisi aktif olursa olsun o belge, belge listesi kilidi altinda yenilenir.
+    if (ctx && ctx->eventBus) {
+        ctx->eventBus->on("bufferChanged", [ctx](const EventBus::Event& e) {
+            if (!ctx->buffers) return;
+            ctx->buffers->withDocument(e.payload, [ctx](EditorState& st) { refreshSearchSession(ctx, st); });
+        });
+    }
+
+    // --- search.grep: Search the files under a directory (project-wide search) ---
+    // --- search.grep: Bir dizin altindaki dosyalarda ara (proje geneli arama) ---
+    // {pattern, root, caseSensitive, regex, wholeWord, maxResults (default 1000), maxFileSizeMb,
+    // ignoreDirs} -> {matches: [{path, line, col, length, endLine, endCol, text}], stats}.
+    // Unsaved buffers are searched instead of their files. WebSocket clients stream the same
+    // search with the "grep" action.
+    // {pattern, root, caseSensitive, regex, wholeWord, maxResults (varsayilan 1000), maxFileSizeMb,
+    // ignoreDirs} -> {matches: [{path, line, col, length, endLine, endCol, text}], stats}.
+    // Kaydedilmemis buffer'lar dosyalarinin yerine aranir. WebSocket istemcileri ayni aramayi
+    // "grep" eylemiyle akitir.
+    router.registerQuery("search.grep", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->workspaceSearch) return nullptr;
+        WorkspaceQuery query = workspaceQueryFor(ctx, args);
+        if (query.pattern.empty()) return nullptr;
+        std::vector<WorkspaceMatch> found;
+        WorkspaceStats stats = ctx->workspaceSearch->run(query, &found);
+        return workspaceResultJson(found, stats);
+    });
+
+    // --- search.workspace: search.grep narrowed by the trigram index ---
+    // --- search.workspace: Trigram indeksiyle daraltilmis search.grep ---
+    // Same args and result as search.grep, root defaults to the indexed working directory;
+    // adds {indexed, candidates}. Only the files the index finds all the query's trigrams in are
+    // searched; without a ready index, for roots outside it, custom ignoreDirs, a larger
+    // maxFileSizeMb or a query with no three-character literal, every file is searched.
+    // search.grep ile ayni argumanlar ve sonuc, root varsayilan olarak indekslenen calisma
+    // dizinidir; {indexed, candidates} ekler. Yalnizca indeksin sorgunun tum trigramlarini
+    // buldugu dosyalar aranir; hazir indeks yoksa, disindaki kokler, ozel ignoreDirs, daha buyuk
+    // maxFileSizeMb veya uc karakterlik literali olmayan bir sorgu icin her dosya aranir.
+    router.registerQuery("search.workspace", [ctx](const json& args) -> json {
+        if (!ctx || !ctx->workspaceSearch) return nullptr;
+        WorkspaceQuery query = workspaceQueryFor(ctx, args);
+        if (query.pattern.empty()) return nullptr;
+        TrigramIndex* index = ctx->trigramIndex;
+        if (query.root.empty()) {
+            query.root = index && !index->root().empty() ? index->root() : std::filesystem::current_path().string();
+        }
+
+        std::vector<std::string> candidates;
+        bool indexed = false;
+        const uint64_t indexedSize = WorkspaceSearch::defaultMaxFileSize();
+        if (index && index->ready() && query.ignoreDirs.empty() &&
+            (indexedSize == 0 || query.maxFileSize == 0 || query.maxFileSize <= indexedSize)) {
+            std::error_code ec;
+            const std::string root = std::filesystem::weakly_canonical(query.root, ec).string();
+            const std::string& indexRoot = index->root();
+            const bool inside = !ec && (root == indexRoot || root.compare(0, indexRoot.size() + 1, indexRoot + "/") == 0);
+            if (inside && index->candidates(query.pattern, query.opts, candidates)) {
+                indexed = true;
+                if (root != indexRoot) {
+                    const std::string prefix = root + "/";
+                    std::erase_if(candidates, [&](const std::string& p) { return p.compare(0, prefix.size(), prefix) != 0; });
+                }
+                query.files = &candidates;
+            }
+        }
+
+        std::vector<WorkspaceMatch> found;
+        WorkspaceStats stats = ctx->workspaceSearch->run(query, &found);
+        json result = workspaceResultJson(found, stats);
+        result["indexed"] = indexed;
+        result["candidates"] = indexed ? static_cast<int>(candidates.size()) : stats.files;
+        return result;
+    });
+
+    // --- search.index.status: State of the workspace search index ---
+    // --- search.index.status: Calisma alani arama indeksinin durumu ---
+    // -> {ready, root, files, trigrams, pending, bytes}; null when indexing is off
+    // -> {ready, root, files, trigrams, pending, bytes}; indeksleme kapaliysa null
+    router.registerQuery("search.index.status", [ctx](const json&) -> json {
+        if (!ctx || !ctx->trigramIndex || ctx->trigramIndex->root().empty()) return nullptr;
+        TrigramIndex::Stats s = ctx->trigramIndex->stats();
+        return {{"ready", ctx->trigramIndex->ready()}, {"root", ctx->trigramIndex->root()},
+                {"files", s.files}, {"trigrams", s.trigrams}, {"pending", s.pending}, {"bytes", s.bytes}};
+    });
+
+    // --- search.grep.cancel: Stop running search.grep calls ---
+    // --- search.grep.cancel: Calisan search.grep cagrilarini durdur ---
+    router.registerNative("search.grep.cancel", [ctx](const json&) {
+        if (!ctx || !ctx->workspaceSearch) return;
+        ctx->workspaceSearch->cancel();
     });
 
     // --- search.lastPattern: Get last search pattern ---
@@ -5,6 +5,7 @@
 
 #include "AutoSave.h"
 #include "buffers.h"
+#include "BufferSnapshot.h"
 #include "EventBus.h"
 #include "Logger.h"
 #include <fstream>
@@ -60,6 +61,10 @@ void AutoSave::autoSaveLoop() {
 
         if (!running_ || !buffers_) continue;
 
+        // Notice mapped files truncated on disk before their text is read again
+        // Diskte kesilen eslenmis dosyalari metinleri yeniden okunmadan once fark et
+        buffers_->checkTruncated();
+
         // Save all modified buffers (read-only access, does NOT change active index)
         // Tum degistirilmis buffer'lari kaydet (salt okunur erisim, aktif indeksi DEGISTIRMEZ)
         size_t count = buffers_->count();
@@ -75,12 +80,31 @@ void AutoSave::autoSaveLoop() {
 
             // Build content string from buffer lines
             // Buffer satirlarindan icerik dizesi olustur
-            const auto& buf = st.getBuffer();
+            // (from a snapshot, so edits on other threads are not seen half-applied)
+            // (anlik goruntuden, boylece diger thread'lerdeki duzenlemeler yarim gorulmez)
+            BufferSnapshot snap = st.getBuffer().snapshot();
+            // A truncated file's text is partly NULs; keep the last good recovery file
+            // Kesilmis bir dosyanin metni kismen NUL'dur; son saglam kurtarma dosyasini koru
+            if (snap.originalLost()) continue;
+            int lineCount = snap.lineCount();
+            size_t size = 0;
+            snap.forEachChunk(0, lineCount, [&size](int, const std::string_view* lines, int count) {
+                for (int i = 0; i < count; ++i) size += lines[i].size() + 1;
+                return true;
+            });
             std::string content;
-            for (int line = 0; line < buf.lineCount(); ++line) {
-                if (line > 0) content += '\n';
-                content += buf.getLine(line);
-            }
+            content.reserve(size);
+            snap.forEachChunk(0, lineCount, [&content](int first, const std::string_view* lines, int count) {
+                for (int i = 0; i < count; ++i) {
+                    if (first + i > 0) content += '\n';
+                    content += lines[i];
+                }
+                return true;
+            });
+
+            // The text may have been cut while it was copied; check again before writing it
+            // Metin kopyalanirken kesilmis olabilir; yazmadan once tekrar denetle
+            if (snap.originalLost()) continue;
 
             if (saveBuffer(fp, content)) {
                 if (eventBus_) {
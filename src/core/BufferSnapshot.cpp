@@ -0,0 +1,120 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "BufferSnapshot.h"
+
+// Wrap a sealed piece table copy
+// Muhurlu bir piece table kopyasini sar
+BufferSnapshot::BufferSnapshot(std::shared_ptr<const PieceTable> table, uint64_t version)
+    : table_(std::move(table)), version_(version) {}
+
+// Line count of the sealed copy
+// Muhurlu kopyanin satir sayisi
+int BufferSnapshot::lineCount() const {
+    return table_->lineCount();
+}
+
+// Copy of a line
+// Bir satirin kopyasi
+std::string BufferSnapshot::getLine(int line) const {
+    return table_->getLine(line);
+}
+
+// View into shared storage
+// Paylasilan depolamaya gorunum
+std::string_view BufferSnapshot::lineView(int line) const {
+    return table_->lineView(line);
+}
+
+// Characters in a line
+// Bir satirdaki karakterler
+int BufferSnapshot::columnCount(int line) const {
+    return table_->columnCount(line);
+}
+
+// Piece-by-piece traversal
+// Parca parca gezinme
+void BufferSnapshot::forEachLine(const std::function<void(int line, std::string_view text)>& fn) const {
+    table_->forEachLine(fn);
+}
+
+// Offset index of the sealed copy
+// Muhurlu kopyanin ofset indeksi
+uint64_t BufferSnapshot::offsetOf(int line, int col) const {
+    return table_->offsetOf(line, col);
+}
+
+// Line and column of a byte offset in the sealed copy
+// Muhurlu kopyadaki bir bayt ofsetinin satiri ve sutunu
+TextPosition BufferSnapshot::positionOf(uint64_t offset) const {
+    return table_->positionOf(offset);
+}
+
+// Length of the sealed copy in bytes, lines joined by '\n'
+// Muhurlu kopyanin satirlar '\n' ile birlestirilmis bayt uzunlugu
+uint64_t BufferSnapshot::byteCount() const {
+    return table_->byteCount();
+}
+
+// Chunked visit of a line range
+// Bir satir araliginin parcali ziyareti
+void BufferSnapshot::forEachChunk(int firstLine, int count, const ChunkFn& fn) const {
+    table_->forEachChunk(firstLine, count, fn);
+}
+
+// Iterator positioned on one line of the sealed table
+// Muhurlu tablonun tek bir satirina konumlanmis yineleyici
+BufferSnapshot::LineIterator BufferSnapshot::lineAt(int line) const {
+    return table_->lineAt(line);
+}
+
+// Iterator on the first line of the sealed copy
+// Muhurlu kopyanin ilk satirindaki yineleyici
+BufferSnapshot::LineIterator BufferSnapshot::begin() const {
+    return table_->begin();
+}
+
+// Iterator one past the last line of the sealed copy
+// Muhurlu kopyanin son satirinin bir otesindeki yineleyici
+BufferSnapshot::LineIterator BufferSnapshot::end() const {
+    return table_->end();
+}
+
+// Materialize every line
+// Her satiri somutlastir
+std::vector<std::string> BufferSnapshot::allLines() const {
+    return table_->allLines();
+}
+
+// Loading state at capture time
+// Yakalama anindaki yukleme durumu
+bool BufferSnapshot::isLoading() const {
+    return table_->isLoading();
+}
+
+// A snapshot that was not loading has every line already
+// Yuklenmeyen bir anlik goruntu zaten her satira sahiptir
+bool BufferSnapshot::awaitLoaded(const std::atomic<bool>& cancel) const {
+    return !isLoading() || table_->awaitLoaded(cancel);
+}
+
+// Checked against the file on disk now
+// Simdi diskteki dosyaya karsi denetlenir
+bool BufferSnapshot::originalLost() const {
+    return table_->originalLost();
+}
+
+// Forwarded to the table, which owns the mapping
+// Eslemenin sahibi olan tabloya iletilir
+bool BufferSnapshot::detachFromFile(const std::string& path) const {
+    return table_->detachFromFile(path);
+}
+
+// Same version: the extra lines were part of the buffer all along, just not indexed yet
+// Ayni surum: ek satirlar bastan beri buffer'in parcasiydi, yalnizca henuz indekslenmemisti
+BufferSnapshot BufferSnapshot::completed() const {
+    if (!isLoading()) return *this;
+    return BufferSnapshot(table_->completed(), version_);
+}
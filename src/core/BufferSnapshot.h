@@ -0,0 +1,104 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "PieceTable.h"
+
+// Immutable, versioned view of a buffer's content at one point in time.
+// Bir buffer'in icerigine belirli bir andaki degismez, surumlu gorunum.
+// Obtained from Buffer::snapshot(); shares its storage with the live buffer (no text is
+// copied) and can be read from any thread while the buffer keeps being edited.
+// Buffer::snapshot() ile alinir; depolamasini canli buffer ile paylasir (metin kopyalanmaz)
+// ve buffer duzenlenmeye devam ederken herhangi bir thread'den okunabilir.
+class BufferSnapshot {
+public:
+    using LineIterator = PieceTable::LineIterator;
+    using ChunkFn = PieceTable::ChunkFn;
+
+    BufferSnapshot(std::shared_ptr<const PieceTable> table, uint64_t version);
+
+    // Edit counter of the buffer when the snapshot was taken
+    // Anlik goruntu alindiginda buffer'in duzenleme sayaci
+    uint64_t version() const { return version_; }
+
+    // Number of lines
+    // Satir sayisi
+    int lineCount() const;
+
+    // Copy of a line (empty if out of range)
+    // Bir satirin kopyasi (aralik disindaysa bos)
+    std::string getLine(int line) const;
+
+    // View of a line, valid as long as this snapshot (or a copy of it) lives
+    // Bir satirin gorunumu, bu anlik goruntu (veya kopyasi) yasadigi surece gecerli
+    std::string_view lineView(int line) const;
+
+    // Number of characters in a line
+    // Bir satirdaki karakter sayisi
+    int columnCount(int line) const;
+
+    // Byte offset of (line, col) and its inverse, lines joined by '\n'
+    // (line, col)'un bayt ofseti ve tersi, satirlar '\n' ile birlestirilmis
+    uint64_t offsetOf(int line, int col) const;
+    TextPosition positionOf(uint64_t offset) const;
+
+    // Length of the text in bytes
+    // Metnin bayt cinsinden uzunlugu
+    uint64_t byteCount() const;
+
+    // Visit every line in order without copying
+    // Her satiri kopyalamadan sirayla ziyaret et
+    void forEachLine(const std::function<void(int line, std::string_view text)>& fn) const;
+
+    // Visit lines [firstLine, firstLine + count) as runs of views straight from piece storage
+    // [firstLine, firstLine + count) satirlarini dogrudan parca deposundan gorunum dizileri olarak ziyaret et
+    void forEachChunk(int firstLine, int count, const ChunkFn& fn) const;
+
+    // Bidirectional line iterators (views valid as long as this snapshot lives)
+    // Cift yonlu satir yineleyicileri (gorunumler bu anlik goruntu yasadigi surece gecerli)
+    LineIterator lineAt(int line) const;
+    LineIterator begin() const;
+    LineIterator end() const;
+
+    // All lines as a vector (copies the text)
+    // Tum satirlar vektor olarak (metni kopyalar)
+    std::vector<std::string> allLines() const;
+
+    // True if the file was still loading when the snapshot was taken (lineCount is a lower bound)
+    // Anlik goruntu alindiginda dosya hala yukleniyorduysa true (lineCount alt sinirdir)
+    bool isLoading() const;
+
+    // True if the mapped file under this content was truncated on disk (it must not be saved)
+    // Bu icerigin altindaki eslenmis dosya diskte kesildiyse true (kaydedilmemelidir)
+    bool originalLost() const;
+
+    // If this content maps the file at path, copy it into memory before that file is rewritten
+    // in place (false if that failed, in which case the file must not be truncated)
+    // Bu icerik path'teki dosyayi esliyorsa, o dosya yerinde yeniden yazilmadan once onu bellege
+    // kopyala (basarisizsa false; bu durumda dosya kesilmemelidir)
+    bool detachFromFile(const std::string& path) const;
+
+    // Wait until a file that was still loading has finished indexing in the background, without
+    // indexing the rest on this thread; false if loading was cancelled or cancel was set first
+    // Hala yuklenen bir dosyanin arka planda indekslenmesi bitene kadar, geri kalani bu thread'de
+    // indekslemeden bekle; yukleme iptal edildiyse veya once cancel ayarlandiysa false
+    bool awaitLoaded(const std::atomic<bool>& cancel) const;
+
+    // Snapshot with every line of a file that was still loading (waits for the indexer).
+    // Hala yuklenen bir dosyanin tum satirlarini iceren anlik goruntu (indeksleyiciyi bekler).
+    // Returns a copy of this one if loading had already finished.
+    // Yukleme zaten bittiyse bunun bir kopyasini dondurur.
+    BufferSnapshot completed() const;
+
+private:
+    std::shared_ptr<const PieceTable> table_;  // Sealed piece table copy / Muhurlu piece table kopyasi
+    uint64_t version_ = 0;                     // Buffer version / Buffer surumu
+};
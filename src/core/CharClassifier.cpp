@@ -5,6 +5,7 @@
 
 #include "CharClassifier.h"
 #include "buffer.h"
+#include "BufferSnapshot.h"
 #include <cctype>
 #include <algorithm>
 
@@ -153,7 +154,7 @@ int CharClassifier::wordEnd(const std::string& line, int col) const {
 
 // Scan buffer for a matching bracket in the given direction
 // Verilen yonde buffer'da eslesen parantezi tara
-BracketMatch CharClassifier::scanForBracket(const Buffer& buf, int line, int col,
+BracketMatch CharClassifier::scanForBracket(const BufferSnapshot& buf, int line, int col,
                                              char target, char self, ScanDir dir) const {
     int depth = 1;
     int maxLines = buf.lineCount();
@@ -162,27 +163,30 @@ BracketMatch CharClassifier::scanForBracket(const Buffer& buf, int line, int col
     int scanned = 0;
     const int MAX_SCAN = 10000;
 
+    // Walk the lines as views with one iterator instead of copying each of them
+    // Her birini kopyalamak yerine satirlari tek bir yineleyiciyle gorunum olarak gez
+    auto it = buf.lineAt(line);
     if (dir == ScanDir::Forward) {
-        std::string curLine = buf.getLine(line);
+        std::string_view curLine = *it;
         for (int c = col + 1; c < static_cast<int>(curLine.size()); ++c) {
             if (curLine[c] == self) ++depth;
             else if (curLine[c] == target) { --depth; if (depth == 0) return {true, line, c, target}; }
         }
         for (int l = line + 1; l < maxLines && scanned < MAX_SCAN; ++l, ++scanned) {
-            std::string ln = buf.getLine(l);
+            std::string_view ln = *++it;
             for (int c = 0; c < static_cast<int>(ln.size()); ++c) {
                 if (ln[c] == self) ++depth;
                 else if (ln[c] == target) { --depth; if (depth == 0) return {true, l, c, target}; }
             }
         }
     } else {
-        std::string curLine = buf.getLine(line);
+        std::string_view curLine = *it;
         for (int c = col - 1; c >= 0; --c) {
             if (curLine[c] == self) ++depth;
             else if (curLine[c] == target) { --depth; if (depth == 0) return {true, line, c, target}; }
         }
         for (int l = line - 1; l >= 0 && scanned < MAX_SCAN; --l, ++scanned) {
-            std::string ln = buf.getLine(l);
+            std::string_view ln = *--it;
             for (int c = static_cast<int>(ln.size()) - 1; c >= 0; --c) {
                 if (ln[c] == self) ++depth;
                 else if (ln[c] == target) { --depth; if (depth == 0) return {true, l, c, target}; }
@@ -196,17 +200,18 @@ BracketMatch CharClassifier::scanForBracket(const Buffer& buf, int line, int col
 // Find matching bracket at given position in buffer
 // Buffer'daki verilen konumda eslesen parantezi bul
 BracketMatch CharClassifier::findMatchingBracket(const Buffer& buf, int line, int col) const {
-    if (line < 0 || line >= buf.lineCount()) return {};
-    std::string ln = buf.getLine(line);
+    BufferSnapshot snap = buf.snapshot();
+    if (line < 0 || line >= snap.lineCount()) return {};
+    std::string_view ln = snap.lineView(line);
     if (col < 0 || col >= static_cast<int>(ln.size())) return {};
 
     char ch = ln[col];
 
     if (isOpenBracket(ch)) {
-        return scanForBracket(buf, line, col, openToClose_.at(ch), ch, ScanDir::Forward);
+        return scanForBracket(snap, line, col, openToClose_.at(ch), ch, ScanDir::Forward);
     }
     if (isCloseBracket(ch)) {
-        return scanForBracket(buf, line, col, closeToOpen_.at(ch), ch, ScanDir::Backward);
+        return scanForBracket(snap, line, col, closeToOpen_.at(ch), ch, ScanDir::Backward);
     }
 
     return {};
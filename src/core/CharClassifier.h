@@ -11,6 +11,7 @@
 #include <cstdint>
 
 class Buffer;
+class BufferSnapshot;
 
 // Character type classification
 // Karakter tipi siniflandirmasi
@@ -84,6 +85,6 @@ private:
     std::unordered_map<char, char> closeToOpen_;
 
     enum class ScanDir { Forward, Backward };
-    BracketMatch scanForBracket(const Buffer& buf, int line, int col,
+    BracketMatch scanForBracket(const BufferSnapshot& buf, int line, int col,
                                  char target, char self, ScanDir dir) const;
 };
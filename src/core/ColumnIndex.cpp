@@ -0,0 +1,219 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "ColumnIndex.h"
+#include <algorithm>
+
+namespace {
+
+struct Range {
+    uint32_t first;
+    uint32_t last;
+};
+
+// Combining marks and zero-width characters
+// Birlesen isaretler ve sifir genislikli karakterler
+constexpr Range kZeroWidth[] = {
+    {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x0610, 0x061A},
+    {0x064B, 0x065F}, {0x0E31, 0x0E31}, {0x0E34, 0x0E3A}, {0x0E47, 0x0E4E},
+    {0x1AB0, 0x1AFF}, {0x1DC0, 0x1DFF}, {0x200B, 0x200F}, {0x20D0, 0x20FF},
+    {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F}, {0xFEFF, 0xFEFF}, {0xE0100, 0xE01EF},
+};
+
+// East Asian wide and fullwidth blocks and emoji
+// Dogu Asya genis ve tam genislik bloklari ve emoji
+constexpr Range kWide[] = {
+    {0x1100, 0x115F},   {0x231A, 0x231B},   {0x2329, 0x232A},   {0x23E9, 0x23EC},
+    {0x25FD, 0x25FE},   {0x2614, 0x2615},   {0x2648, 0x2653},   {0x26AA, 0x26AB},
+    {0x26BD, 0x26BE},   {0x26C4, 0x26C5},   {0x2705, 0x2705},   {0x270A, 0x270B},
+    {0x274C, 0x274C},   {0x2753, 0x2755},   {0x2795, 0x2797},   {0x2B1B, 0x2B1C},
+    {0x2E80, 0x303E},   {0x3041, 0x33FF},   {0x3400, 0x4DBF},   {0x4E00, 0x9FFF},
+    {0xA000, 0xA4CF},   {0xA960, 0xA97F},   {0xAC00, 0xD7A3},   {0xF900, 0xFAFF},
+    {0xFE10, 0xFE19},   {0xFE30, 0xFE6F},   {0xFF00, 0xFF60},   {0xFFE0, 0xFFE6},
+    {0x1F004, 0x1F004}, {0x1F0CF, 0x1F0CF}, {0x1F18E, 0x1F18E}, {0x1F191, 0x1F19A},
+    {0x1F200, 0x1F251}, {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF}, {0x1F900, 0x1F9FF},
+    {0x1FA70, 0x1FAFF}, {0x20000, 0x2FFFD}, {0x30000, 0x3FFFD},
+};
+
+// Binary search a sorted table of inclusive ranges
+// Kapsayici araliklardan olusan sirali bir tabloda ikili arama yap
+template <size_t N>
+bool inRanges(const Range (&ranges)[N], uint32_t cp) {
+    auto it = std::upper_bound(std::begin(ranges), std::end(ranges), cp,
+                               [](uint32_t v, const Range& r) { return v < r.first; });
+    return it != std::begin(ranges) && cp <= (it - 1)->last;
+}
+
+// Decode one UTF-8 sequence leniently: a malformed or truncated sequence yields its first
+// byte as a codepoint of its own, so every byte belongs to exactly one column
+// Bir UTF-8 dizisini hosgorulu coz: bozuk veya kesik bir dizi ilk baytini kendi basina bir
+// kod noktasi olarak verir, boylece her bayt tam olarak bir sutuna aittir
+size_t decodeLenient(const uint8_t* p, size_t avail, uint32_t& cp) {
+    uint8_t b = p[0];
+    size_t len;
+    uint32_t min;
+    if (b >= 0xC2 && b <= 0xDF) { len = 2; cp = b & 0x1F; min = 0x80; }
+    else if ((b & 0xF0) == 0xE0) { len = 3; cp = b & 0x0F; min = 0x800; }
+    else if (b >= 0xF0 && b <= 0xF4) { len = 4; cp = b & 0x07; min = 0x10000; }
+    else {
+        cp = b < 0x80 ? b : 0xFFFD;
+        return 1;
+    }
+    if (len > avail) {
+        cp = 0xFFFD;
+        return 1;
+    }
+    for (size_t k = 1; k < len; ++k) {
+        if ((p[k] & 0xC0) != 0x80) {
+            cp = 0xFFFD;
+            return 1;
+        }
+        cp = (cp << 6) | (p[k] & 0x3F);
+    }
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        cp = 0xFFFD;
+        return 1;
+    }
+    return len;
+}
+
+} // namespace
+
+// Zero-width marks take no cell and wide characters two; everything below U+0300 skips the lookup
+// Sifir genislikli isaretler hucre kaplamaz, genis karakterler iki; U+0300 alti aramayi atlar
+int ColumnIndex::displayWidth(uint32_t cp) {
+    if (cp < 0x300) return 1;
+    if (inRanges(kZeroWidth, cp)) return 0;
+    if (inRanges(kWide, cp)) return 2;
+    return 1;
+}
+
+// Unknown names leave unit untouched and return false
+// Bilinmeyen adlar unit'e dokunmaz ve false dondurur
+bool ColumnIndex::parseUnit(const std::string& name, ColumnUnit& unit) {
+    if (name == "byte") unit = ColumnUnit::Byte;
+    else if (name == "codepoint") unit = ColumnUnit::Codepoint;
+    else if (name == "utf16") unit = ColumnUnit::UTF16;
+    else if (name == "display") unit = ColumnUnit::Display;
+    else return false;
+    return true;
+}
+
+// The last entry of each table is the column just past the line
+// Her tablonun son girdisi satirin hemen sonrasindaki sutundur
+int ColumnIndex::Line::length(ColumnUnit unit) const {
+    if (simple) return bytes;
+    switch (unit) {
+        case ColumnUnit::Byte:      return bytes;
+        case ColumnUnit::Codepoint: return static_cast<int>(byte.size()) - 1;
+        case ColumnUnit::UTF16:     return utf16.back();
+        case ColumnUnit::Display:   return display.back();
+    }
+    return bytes;
+}
+
+// Find the codepoint boundary at or before col, then read the target table at it
+// col'da veya oncesindeki kod noktasi sinirini bul, sonra hedef tabloyu orada oku
+int ColumnIndex::Line::convert(int col, ColumnUnit from, ColumnUnit to) const {
+    if (col < 0) col = 0;
+    if (simple) return std::min(col, bytes);
+
+    const int last = static_cast<int>(byte.size()) - 1;
+    int index;
+    if (from == ColumnUnit::Codepoint) {
+        index = std::min(col, last);
+    } else {
+        const std::vector<int>& table =
+            from == ColumnUnit::Byte ? byte : from == ColumnUnit::UTF16 ? utf16 : display;
+        index = static_cast<int>(std::upper_bound(table.begin(), table.end(), col) - table.begin()) - 1;
+    }
+
+    switch (to) {
+        case ColumnUnit::Byte:      return byte[index];
+        case ColumnUnit::Codepoint: return index;
+        case ColumnUnit::UTF16:     return utf16[index];
+        case ColumnUnit::Display:   return display[index];
+    }
+    return byte[index];
+}
+
+// A cached entry only counts if it was built with the same tab width
+// Onbellekteki bir girdi yalnizca ayni sekme genisligiyle kurulduysa sayilir
+const ColumnIndex::Line* ColumnIndex::find(int line, int tabWidth) const {
+    if (tabWidth != tabWidth_) return nullptr;
+    auto it = lines_.find(line);
+    return it == lines_.end() ? nullptr : &it->second;
+}
+
+// A new tab width or a full cache drops every entry before the line is decoded once
+// Yeni bir sekme genisligi veya dolu bir onbellek, satir bir kez cozulmeden once tum girdileri atar
+const ColumnIndex::Line& ColumnIndex::build(int line, std::string_view text, int tabWidth) {
+    if (tabWidth != tabWidth_) {
+        lines_.clear();
+        tabWidth_ = tabWidth;
+    }
+    if (lines_.size() >= kMaxLines) lines_.clear();
+
+    Line& entry = lines_[line];
+    entry = Line{};
+    entry.bytes = static_cast<int>(text.size());
+
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(text.data());
+    const size_t size = text.size();
+
+    // ASCII fast path: without tabs or multi-byte sequences nothing needs a table
+    // ASCII hizli yolu: sekme veya cok baytli dizi olmadan hicbir seyin tabloya ihtiyaci yok
+    size_t i = 0;
+    while (i < size && p[i] < 0x80 && p[i] != '\t') ++i;
+    if (i == size) return entry;
+
+    entry.simple = false;
+    entry.byte.reserve(size + 1);
+    entry.utf16.reserve(size + 1);
+    entry.display.reserve(size + 1);
+
+    // Everything before the first special byte is one column per byte in every unit
+    // Ilk ozel bayttan onceki her sey her birimde bayt basina bir sutundur
+    for (size_t k = 0; k <= i; ++k) {
+        int v = static_cast<int>(k);
+        entry.byte.push_back(v);
+        entry.utf16.push_back(v);
+        entry.display.push_back(v);
+    }
+
+    int u16 = static_cast<int>(i);
+    int cells = static_cast<int>(i);
+    const int tab = tabWidth > 0 ? tabWidth : 1;
+    while (i < size) {
+        uint32_t cp;
+        size_t n = p[i] < 0x80 ? (cp = p[i], 1) : decodeLenient(p + i, size - i, cp);
+        i += n;
+        u16 += cp >= 0x10000 ? 2 : 1;
+        if (cp == '\t') cells += tab - cells % tab;
+        else cells += displayWidth(cp);
+        entry.byte.push_back(static_cast<int>(i));
+        entry.utf16.push_back(u16);
+        entry.display.push_back(cells);
+    }
+    return entry;
+}
+
+// Forget one edited line
+// Duzenlenen tek bir satiri unut
+void ColumnIndex::invalidateLine(int line) {
+    lines_.erase(line);
+}
+
+// Forget the line and every one after it, whose numbers may have shifted
+// Satiri ve numaralari kaymis olabilecek sonrakilerin hepsini unut
+void ColumnIndex::invalidateFrom(int line) {
+    lines_.erase(lines_.lower_bound(line), lines_.end());
+}
+
+// Forget every line
+// Tum satirlari unut
+void ColumnIndex::clear() {
+    lines_.clear();
+}
@@ -0,0 +1,94 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// How a column is counted
+// Bir sutunun nasil sayildigi
+enum class ColumnUnit {
+    Byte,       // UTF-8 bytes (what the buffer stores) / UTF-8 baytlari (buffer'in sakladigi)
+    Codepoint,  // Unicode scalar values / Unicode skaler degerleri
+    UTF16,      // UTF-16 code units (LSP positions) / UTF-16 kod birimleri (LSP konumlari)
+    Display     // Terminal cells: tabs expand, wide CJK takes 2, combining marks 0 / Terminal hucreleri: sekmeler genisler, genis CJK 2, birlesen isaretler 0 tutar
+};
+
+// Cached per-line column maps between byte, codepoint, UTF-16 and display columns.
+// Bayt, kod noktasi, UTF-16 ve gorunum sutunlari arasinda satir basina onbellekli sutun eslemeleri.
+// A line is decoded once into offset tables at every codepoint boundary, after which any
+// conversion is a binary search; pure ASCII lines without tabs store nothing since all four
+// units agree there. Entries are dropped by the buffer when an edit touches their line (or
+// shifts the lines below it), and the whole cache is bounded.
+// Bir satir bir kez her kod noktasi sinirinda ofset tablolarina cozulur, sonrasinda her
+// donusum bir ikili aramadir; sekmesiz saf ASCII satirlar hicbir sey saklamaz cunku orada dort
+// birim de aynidir. Bir duzenleme satirlarina dokundugunda (veya alttaki satirlari
+// kaydirdiginda) girdiler buffer tarafindan atilir ve tum onbellek sinirlidir.
+// Not synchronized: the owning Buffer calls it under its own lock.
+// Eszamanli degil: sahibi olan Buffer onu kendi kilidi altinda cagirir.
+class ColumnIndex {
+public:
+    // Cached lines beyond this are dropped wholesale (viewports and LSP ranges stay far below)
+    // Bunun otesindeki onbellekli satirlar toptan atilir (gorunumler ve LSP araliklari cok altinda kalir)
+    static constexpr size_t kMaxLines = 4096;
+
+    // Column tables of one line
+    // Bir satirin sutun tablolari
+    struct Line {
+        bool simple = true;         // ASCII without tabs: every unit equals the byte column / Sekmesiz ASCII: her birim bayt sutununa esit
+        int bytes = 0;              // Line length in bytes / Bayt cinsinden satir uzunlugu
+        std::vector<int> byte;      // Per codepoint boundary (size n + 1) / Kod noktasi siniri basina (boyut n + 1)
+        std::vector<int> utf16;
+        std::vector<int> display;
+
+        // Convert col from one unit to another; a column inside a character (the second byte
+        // of a multi-byte sequence, the right half of a wide glyph) snaps to its start and
+        // columns past the end clamp to it
+        // col'u bir birimden digerine donustur; bir karakterin icindeki sutun (cok baytli
+        // dizinin ikinci bayti, genis bir glifin sag yarisi) basina oturur ve sondan sonraki
+        // sutunlar sona sinirlanir
+        int convert(int col, ColumnUnit from, ColumnUnit to) const;
+
+        // Length of the line in a unit
+        // Satirin bir birimdeki uzunlugu
+        int length(ColumnUnit unit) const;
+    };
+
+    // Tables for a line, built from text on a miss
+    // Bir satirin tablolari, iskalamada metinden kurulur
+    const Line* find(int line, int tabWidth) const;
+    const Line& build(int line, std::string_view text, int tabWidth);
+
+    // Drop one line, or one line and everything below it (lines were inserted or removed)
+    // Bir satiri veya bir satiri ve altindaki her seyi at (satirlar eklendi veya silindi)
+    void invalidateLine(int line);
+    void invalidateFrom(int line);
+    void clear();
+
+    // Number of cached lines
+    // Onbellekteki satir sayisi
+    size_t size() const { return lines_.size(); }
+
+    // Tab width of the cached entries, for lookups that do not depend on it
+    // Onbellekteki girdilerin sekme genisligi, ona bagli olmayan aramalar icin
+    int tabWidth() const { return tabWidth_; }
+
+    // Terminal cells taken by a codepoint (0 for combining marks and zero-width characters,
+    // 2 for East Asian wide and fullwidth characters and emoji, 1 otherwise)
+    // Bir kod noktasinin kapladigi terminal hucreleri (birlesen isaretler ve sifir genislikli
+    // karakterler icin 0, Dogu Asya genis ve tam genislik karakterleri ve emoji icin 2, yoksa 1)
+    static int displayWidth(uint32_t cp);
+
+    // "byte", "codepoint", "utf16" or "display"; false for anything else
+    // "byte", "codepoint", "utf16" veya "display"; baska her sey icin false
+    static bool parseUnit(const std::string& name, ColumnUnit& unit);
+
+private:
+    std::map<int, Line> lines_;  // By line number / Satir numarasina gore
+    int tabWidth_ = 4;           // Tab width the display tables were built with / Gorunum tablolarinin kuruldugu sekme genisligi
+};
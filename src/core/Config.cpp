@@ -197,6 +197,20 @@ bool Config::getBool(const std::string& key, bool defaultVal) const {
     return node->get<bool>();
 }
 
+// Get a string array by dot-notation key
+// Nokta notasyonu anahtariyla string dizisi al
+std::vector<std::string> Config::getStringList(const std::string& key,
+                                               const std::vector<std::string>& defaultVal) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const json* node = resolve(key);
+    if (!node || !node->is_array()) return defaultVal;
+    std::vector<std::string> out;
+    for (const auto& item : *node) {
+        if (item.is_string()) out.push_back(item.get<std::string>());
+    }
+    return out;
+}
+
 // Return the full merged config JSON
 // Tam birlestirilmis config JSON'unu dondur
 json Config::raw() const {
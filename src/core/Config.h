@@ -6,6 +6,7 @@
 #pragma once
 #include <string>
 #include <mutex>
+#include <vector>
 #include "nlohmann/json.hpp"
 
 using json = nlohmann::json;
@@ -36,6 +37,11 @@ public:
     int         getInt(const std::string& key, int defaultVal = 0) const;
     bool        getBool(const std::string& key, bool defaultVal = false) const;
 
+    // Array of strings; non-string items are skipped, a missing key or non-array gives defaultVal
+    // String dizisi; string olmayan ogeler atlanir, eksik anahtar veya dizi olmayan deger defaultVal verir
+    std::vector<std::string> getStringList(const std::string& key,
+                                           const std::vector<std::string>& defaultVal = {}) const;
+
     // Return the entire merged config as JSON (for ConfigBinding)
     // Tum birlestirilmis config'i JSON olarak dondur (ConfigBinding icin)
     json raw() const;
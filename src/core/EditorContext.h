@@ -18,6 +18,8 @@ class HelpSystem;
 class ProcessManager;
 class RegisterManager;
 class SearchEngine;
+class WorkspaceSearch;
+class TrigramIndex;
 class MarkManager;
 class AutoSave;
 class ExtmarkManager;
@@ -54,6 +56,8 @@ struct EditorContext {
     ProcessManager*   processManager = nullptr; // Subprocess lifecycle manager / Alt surec yasam dongusu yoneticisi
     RegisterManager*  registers      = nullptr; // Named register/clipboard system / Adlandirilmis register/pano sistemi
     SearchEngine*     searchEngine   = nullptr; // Find/replace engine / Bul/degistir motoru
+    WorkspaceSearch*  workspaceSearch = nullptr; // Project-wide search (grep) / Proje geneli arama (grep)
+    TrigramIndex*     trigramIndex   = nullptr; // Workspace search index / Calisma alani arama indeksi
     MarkManager*      markManager    = nullptr; // Named marks and jump list / Adlandirilmis isaretler ve atlama listesi
     AutoSave*         autoSave       = nullptr; // Auto-save and backup system / Otomatik kaydetme ve yedekleme sistemi
     ExtmarkManager*   extmarkManager = nullptr; // Text decorations/properties / Metin dekorasyonlari/ozellikleri
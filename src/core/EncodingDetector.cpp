@@ -4,11 +4,29 @@
 // See LICENSE file in the project root for full license text.
 
 #include "EncodingDetector.h"
+#include "Transcoder.h"
+#include "Utf8Scanner.h"
 #include "Logger.h"
 #include <fstream>
 #include <algorithm>
 #include <cstring>
 
+namespace {
+
+// Length of data without a UTF-8 sequence cut off at its end
+// Sonunda kesilmis bir UTF-8 dizisi olmadan verinin uzunlugu
+size_t withoutPartialUTF8(const uint8_t* data, size_t size) {
+    for (size_t k = 1; k <= 3 && k <= size; ++k) {
+        uint8_t b = data[size - k];
+        if ((b & 0xC0) == 0x80) continue;
+        size_t len = b >= 0xF0 ? 4 : b >= 0xE0 ? 3 : b >= 0xC0 ? 2 : 1;
+        return len > k ? size - k : size;
+    }
+    return size;
+}
+
+} // namespace
+
 // Detect encoding from a vector of bytes
 // Bayt vektorunden kodlamayi algila
 EncodingResult EncodingDetector::detect(const std::vector<uint8_t>& data) {
@@ -52,6 +70,12 @@ EncodingResult EncodingDetector::detectFile(const std::string& filePath) {
         size_t bytesRead = static_cast<size_t>(file.gcount());
         buffer.resize(bytesRead);
 
+        // A full sample usually ends mid-file; a character it cuts in half would make valid
+        // UTF-8 look invalid and the file would be taken for Latin-1
+        // Dolu bir ornek genellikle dosyanin ortasinda biter; ikiye boldugu bir karakter gecerli
+        // UTF-8'i gecersiz gosterir ve dosya Latin-1 sanilirdi
+        if (bytesRead == SAMPLE_SIZE) bytesRead = withoutPartialUTF8(buffer.data(), bytesRead);
+
         return detect(buffer.data(), bytesRead);
     } catch (const std::exception& e) {
         LOG_ERROR("[Encoding] Detection failed: ", e.what());
@@ -122,23 +146,18 @@ EncodingResult EncodingDetector::detectHeuristic(const uint8_t* data, size_t siz
         return {TextEncoding::ASCII, false, 0, 1.0};
     }
 
-    // Check if valid UTF-8
-    // Gecerli UTF-8 mi kontrol et
-    if (isValidUTF8(data, size)) {
+    // Check if valid UTF-8 (known not to be ASCII here)
+    // Gecerli UTF-8 mi kontrol et (burada ASCII olmadigi biliniyor)
+    if (Utf8Scanner::isValidUTF8(data, size)) {
         return {TextEncoding::UTF8, false, 0, 0.95};
     }
 
     // Check for UTF-16 patterns (every other byte is 0 for ASCII-heavy text)
     // UTF-16 kaliplari kontrol et (ASCII agirlikli metin icin her ikinci bayt 0)
     if (size >= 4) {
-        int nullOdd = 0, nullEven = 0;
+        size_t nullEven = 0, nullOdd = 0;
         size_t checkSize = std::min(size, static_cast<size_t>(1024));
-        for (size_t i = 0; i < checkSize; ++i) {
-            if (data[i] == 0) {
-                if (i % 2 == 0) nullEven++;
-                else nullOdd++;
-            }
-        }
+        Utf8Scanner::countNuls(data, checkSize, nullEven, nullOdd);
 
         double ratio = static_cast<double>(checkSize) / 2.0;
         if (nullOdd > ratio * 0.3 && nullEven < ratio * 0.1) {
@@ -154,176 +173,16 @@ EncodingResult EncodingDetector::detectHeuristic(const uint8_t* data, size_t siz
     return {TextEncoding::Latin1, false, 0, 0.5};
 }
 
-// Validate UTF-8 encoding
-// UTF-8 kodlamasini dogrula
+// Valid UTF-8 that is not plain ASCII (ASCII is reported as its own encoding)
+// Duz ASCII olmayan gecerli UTF-8 (ASCII kendi kodlamasi olarak bildirilir)
 bool EncodingDetector::isValidUTF8(const uint8_t* data, size_t size) {
-    size_t i = 0;
-    bool hasMultibyte = false;
-
-    while (i < size) {
-        if (data[i] < 0x80) {
-            // ASCII byte
-            i++;
-        } else if ((data[i] & 0xE0) == 0xC0) {
-            // 2-byte sequence: 110xxxxx 10xxxxxx
-            if (i + 1 >= size) return false;
-            if ((data[i + 1] & 0xC0) != 0x80) return false;
-            // Overlong check: must be >= 0x80
-            uint32_t cp = ((data[i] & 0x1F) << 6) | (data[i + 1] & 0x3F);
-            if (cp < 0x80) return false;
-            hasMultibyte = true;
-            i += 2;
-        } else if ((data[i] & 0xF0) == 0xE0) {
-            // 3-byte sequence: 1110xxxx 10xxxxxx 10xxxxxx
-            if (i + 2 >= size) return false;
-            if ((data[i + 1] & 0xC0) != 0x80) return false;
-            if ((data[i + 2] & 0xC0) != 0x80) return false;
-            uint32_t cp = ((data[i] & 0x0F) << 12) | ((data[i + 1] & 0x3F) << 6) | (data[i + 2] & 0x3F);
-            if (cp < 0x800) return false;
-            // Reject surrogates
-            if (cp >= 0xD800 && cp <= 0xDFFF) return false;
-            hasMultibyte = true;
-            i += 3;
-        } else if ((data[i] & 0xF8) == 0xF0) {
-            // 4-byte sequence: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-            if (i + 3 >= size) return false;
-            if ((data[i + 1] & 0xC0) != 0x80) return false;
-            if ((data[i + 2] & 0xC0) != 0x80) return false;
-            if ((data[i + 3] & 0xC0) != 0x80) return false;
-            uint32_t cp = ((data[i] & 0x07) << 18) | ((data[i + 1] & 0x3F) << 12) |
-                          ((data[i + 2] & 0x3F) << 6) | (data[i + 3] & 0x3F);
-            if (cp < 0x10000 || cp > 0x10FFFF) return false;
-            hasMultibyte = true;
-            i += 4;
-        } else {
-            // Invalid UTF-8 start byte
-            // Gecersiz UTF-8 baslangic bayti
-            return false;
-        }
-    }
-
-    // Only return true if we found multibyte sequences (otherwise it's ASCII, not UTF-8)
-    // Sadece coklu bayt dizileri bulduysak true dondur (aksi halde ASCII, UTF-8 degil)
-    return hasMultibyte;
+    return !Utf8Scanner::isASCII(data, size) && Utf8Scanner::isValidUTF8(data, size);
 }
 
 // Check if data is pure 7-bit ASCII
 // Verinin saf 7-bit ASCII olup olmadigini kontrol et
 bool EncodingDetector::isASCII(const uint8_t* data, size_t size) {
-    for (size_t i = 0; i < size; ++i) {
-        if (data[i] >= 0x80) return false;
-    }
-    return true;
-}
-
-// Encode a single Unicode code point to UTF-8
-// Tek bir Unicode kod noktasini UTF-8'e kodla
-void EncodingDetector::encodeUTF8(uint32_t cp, std::string& out) {
-    if (cp < 0x80) {
-        out += static_cast<char>(cp);
-    } else if (cp < 0x800) {
-        out += static_cast<char>(0xC0 | (cp >> 6));
-        out += static_cast<char>(0x80 | (cp & 0x3F));
-    } else if (cp < 0x10000) {
-        out += static_cast<char>(0xE0 | (cp >> 12));
-        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-        out += static_cast<char>(0x80 | (cp & 0x3F));
-    } else if (cp <= 0x10FFFF) {
-        out += static_cast<char>(0xF0 | (cp >> 18));
-        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
-        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-        out += static_cast<char>(0x80 | (cp & 0x3F));
-    } else {
-        // Invalid code point: emit replacement character U+FFFD
-        // Gecersiz kod noktasi: degistirme karakteri U+FFFD yay
-        out += "\xEF\xBF\xBD";
-    }
-}
-
-// Convert UTF-16 bytes to UTF-8 string
-// UTF-16 baytlarini UTF-8 dizesine donustur
-std::string EncodingDetector::utf16ToUTF8(const uint8_t* data, size_t size, bool littleEndian) {
-    std::string result;
-    result.reserve(size);
-
-    for (size_t i = 0; i + 1 < size; i += 2) {
-        uint16_t unit;
-        if (littleEndian) {
-            unit = static_cast<uint16_t>(data[i]) | (static_cast<uint16_t>(data[i + 1]) << 8);
-        } else {
-            unit = (static_cast<uint16_t>(data[i]) << 8) | static_cast<uint16_t>(data[i + 1]);
-        }
-
-        if (unit >= 0xD800 && unit <= 0xDBFF) {
-            // High surrogate: read low surrogate
-            // Yuksek vekil: dusuk vekili oku
-            if (i + 3 < size) {
-                uint16_t low;
-                if (littleEndian) {
-                    low = static_cast<uint16_t>(data[i + 2]) | (static_cast<uint16_t>(data[i + 3]) << 8);
-                } else {
-                    low = (static_cast<uint16_t>(data[i + 2]) << 8) | static_cast<uint16_t>(data[i + 3]);
-                }
-
-                if (low >= 0xDC00 && low <= 0xDFFF) {
-                    uint32_t cp = 0x10000 + ((static_cast<uint32_t>(unit - 0xD800) << 10) | (low - 0xDC00));
-                    encodeUTF8(cp, result);
-                    i += 2;
-                    continue;
-                }
-            }
-            // Unpaired surrogate: emit replacement
-            // Eslenmemis vekil: degistirme karakteri yay
-            result += "\xEF\xBF\xBD";
-        } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
-            // Orphan low surrogate
-            // Yetim dusuk vekil
-            result += "\xEF\xBF\xBD";
-        } else {
-            encodeUTF8(static_cast<uint32_t>(unit), result);
-        }
-    }
-
-    return result;
-}
-
-// Convert UTF-32 bytes to UTF-8 string
-// UTF-32 baytlarini UTF-8 dizesine donustur
-std::string EncodingDetector::utf32ToUTF8(const uint8_t* data, size_t size, bool littleEndian) {
-    std::string result;
-    result.reserve(size);
-
-    for (size_t i = 0; i + 3 < size; i += 4) {
-        uint32_t cp;
-        if (littleEndian) {
-            cp = static_cast<uint32_t>(data[i]) |
-                 (static_cast<uint32_t>(data[i + 1]) << 8) |
-                 (static_cast<uint32_t>(data[i + 2]) << 16) |
-                 (static_cast<uint32_t>(data[i + 3]) << 24);
-        } else {
-            cp = (static_cast<uint32_t>(data[i]) << 24) |
-                 (static_cast<uint32_t>(data[i + 1]) << 16) |
-                 (static_cast<uint32_t>(data[i + 2]) << 8) |
-                 static_cast<uint32_t>(data[i + 3]);
-        }
-
-        encodeUTF8(cp, result);
-    }
-
-    return result;
-}
-
-// Convert Latin-1 (ISO-8859-1) bytes to UTF-8
-// Latin-1 (ISO-8859-1) baytlarini UTF-8'e donustur
-std::string EncodingDetector::latin1ToUTF8(const uint8_t* data, size_t size) {
-    std::string result;
-    result.reserve(size * 2);
-
-    for (size_t i = 0; i < size; ++i) {
-        encodeUTF8(static_cast<uint32_t>(data[i]), result);
-    }
-
-    return result;
+    return Utf8Scanner::isASCII(data, size);
 }
 
 // Convert raw bytes to UTF-8 string using the specified encoding
@@ -342,174 +201,24 @@ std::string EncodingDetector::toUTF8(const std::vector<uint8_t>& data, TextEncod
         size -= bom.bomSize;
     }
 
-    switch (encoding) {
-        case TextEncoding::UTF8:
-        case TextEncoding::UTF8_BOM:
-        case TextEncoding::ASCII:
-            return std::string(reinterpret_cast<const char*>(ptr), size);
-
-        case TextEncoding::UTF16_LE:
-            return utf16ToUTF8(ptr, size, true);
-
-        case TextEncoding::UTF16_BE:
-            return utf16ToUTF8(ptr, size, false);
-
-        case TextEncoding::UTF32_LE:
-            return utf32ToUTF8(ptr, size, true);
-
-        case TextEncoding::UTF32_BE:
-            return utf32ToUTF8(ptr, size, false);
-
-        case TextEncoding::Latin1:
-            return latin1ToUTF8(ptr, size);
-
-        default:
-            // Unknown: try as raw bytes
-            // Bilinmeyen: ham bayt olarak dene
-            return std::string(reinterpret_cast<const char*>(ptr), size);
-    }
+    // One chunk through the streaming transcoder (unknown encodings pass through as raw bytes)
+    // Akisli donusturucudan tek parca (bilinmeyen kodlamalar ham bayt olarak gecer)
+    Transcoder tc(encoding);
+    std::string result;
+    result.reserve(size);
+    tc.decode(ptr, size, result);
+    tc.finishDecode(result);
+    return result;
 }
 
-// Convert UTF-8 string to target encoding bytes
-// UTF-8 dizesini hedef kodlama baytlarina donustur
+// Convert UTF-8 string to target encoding bytes; UTF-16, UTF-32 and UTF-8 with BOM start with their BOM
+// UTF-8 dizesini hedef kodlama baytlarina donustur; UTF-16, UTF-32 ve BOM'lu UTF-8 BOM'lariyla baslar
 std::vector<uint8_t> EncodingDetector::fromUTF8(const std::string& utf8, TextEncoding encoding) {
-    std::vector<uint8_t> result;
-
-    switch (encoding) {
-        case TextEncoding::UTF8:
-        case TextEncoding::ASCII:
-            result.assign(utf8.begin(), utf8.end());
-            break;
-
-        case TextEncoding::UTF8_BOM:
-            result.push_back(0xEF);
-            result.push_back(0xBB);
-            result.push_back(0xBF);
-            result.insert(result.end(), utf8.begin(), utf8.end());
-            break;
-
-        case TextEncoding::Latin1: {
-            // UTF-8 to Latin-1: decode code points, clamp to 0-255
-            // UTF-8'den Latin-1'e: kod noktalarini coz, 0-255'e sinirla
-            size_t i = 0;
-            while (i < utf8.size()) {
-                uint32_t cp = 0;
-                uint8_t b = static_cast<uint8_t>(utf8[i]);
-                if (b < 0x80) {
-                    cp = b;
-                    i++;
-                } else if ((b & 0xE0) == 0xC0) {
-                    cp = (b & 0x1F) << 6;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F);
-                    i += 2;
-                } else if ((b & 0xF0) == 0xE0) {
-                    cp = (b & 0x0F) << 12;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F) << 6;
-                    if (i + 2 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 2]) & 0x3F);
-                    i += 3;
-                } else {
-                    i += 4;
-                    cp = '?';
-                }
-                result.push_back(cp <= 0xFF ? static_cast<uint8_t>(cp) : '?');
-            }
-            break;
-        }
-
-        case TextEncoding::UTF16_LE: {
-            // Add BOM
-            // BOM ekle
-            result.push_back(0xFF);
-            result.push_back(0xFE);
-            // Encode UTF-8 to UTF-16 LE
-            // UTF-8'den UTF-16 LE'ye kodla
-            size_t i = 0;
-            while (i < utf8.size()) {
-                uint32_t cp = 0;
-                uint8_t b = static_cast<uint8_t>(utf8[i]);
-                if (b < 0x80) { cp = b; i++; }
-                else if ((b & 0xE0) == 0xC0) {
-                    cp = (b & 0x1F) << 6;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F);
-                    i += 2;
-                } else if ((b & 0xF0) == 0xE0) {
-                    cp = (b & 0x0F) << 12;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F) << 6;
-                    if (i + 2 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 2]) & 0x3F);
-                    i += 3;
-                } else if ((b & 0xF8) == 0xF0) {
-                    cp = (b & 0x07) << 18;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F) << 12;
-                    if (i + 2 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 2]) & 0x3F) << 6;
-                    if (i + 3 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 3]) & 0x3F);
-                    i += 4;
-                } else { i++; continue; }
-
-                if (cp < 0x10000) {
-                    result.push_back(static_cast<uint8_t>(cp & 0xFF));
-                    result.push_back(static_cast<uint8_t>((cp >> 8) & 0xFF));
-                } else {
-                    // Surrogate pair
-                    // Vekil cifti
-                    cp -= 0x10000;
-                    uint16_t high = 0xD800 + static_cast<uint16_t>(cp >> 10);
-                    uint16_t low  = 0xDC00 + static_cast<uint16_t>(cp & 0x3FF);
-                    result.push_back(static_cast<uint8_t>(high & 0xFF));
-                    result.push_back(static_cast<uint8_t>((high >> 8) & 0xFF));
-                    result.push_back(static_cast<uint8_t>(low & 0xFF));
-                    result.push_back(static_cast<uint8_t>((low >> 8) & 0xFF));
-                }
-            }
-            break;
-        }
-
-        case TextEncoding::UTF16_BE: {
-            result.push_back(0xFE);
-            result.push_back(0xFF);
-            size_t i = 0;
-            while (i < utf8.size()) {
-                uint32_t cp = 0;
-                uint8_t b = static_cast<uint8_t>(utf8[i]);
-                if (b < 0x80) { cp = b; i++; }
-                else if ((b & 0xE0) == 0xC0) {
-                    cp = (b & 0x1F) << 6;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F);
-                    i += 2;
-                } else if ((b & 0xF0) == 0xE0) {
-                    cp = (b & 0x0F) << 12;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F) << 6;
-                    if (i + 2 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 2]) & 0x3F);
-                    i += 3;
-                } else if ((b & 0xF8) == 0xF0) {
-                    cp = (b & 0x07) << 18;
-                    if (i + 1 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 1]) & 0x3F) << 12;
-                    if (i + 2 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 2]) & 0x3F) << 6;
-                    if (i + 3 < utf8.size()) cp |= (static_cast<uint8_t>(utf8[i + 3]) & 0x3F);
-                    i += 4;
-                } else { i++; continue; }
-
-                if (cp < 0x10000) {
-                    result.push_back(static_cast<uint8_t>((cp >> 8) & 0xFF));
-                    result.push_back(static_cast<uint8_t>(cp & 0xFF));
-                } else {
-                    cp -= 0x10000;
-                    uint16_t high = 0xD800 + static_cast<uint16_t>(cp >> 10);
-                    uint16_t low  = 0xDC00 + static_cast<uint16_t>(cp & 0x3FF);
-                    result.push_back(static_cast<uint8_t>((high >> 8) & 0xFF));
-                    result.push_back(static_cast<uint8_t>(high & 0xFF));
-                    result.push_back(static_cast<uint8_t>((low >> 8) & 0xFF));
-                    result.push_back(static_cast<uint8_t>(low & 0xFF));
-                }
-            }
-            break;
-        }
-
-        default:
-            result.assign(utf8.begin(), utf8.end());
-            break;
-    }
-
-    return result;
+    Transcoder tc(encoding);
+    std::string out(Transcoder::byteOrderMark(encoding));
+    tc.encode(utf8, out);
+    tc.finishEncode(out);
+    return std::vector<uint8_t>(out.begin(), out.end());
 }
 
 // Get human-readable encoding name
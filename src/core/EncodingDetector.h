@@ -31,12 +31,23 @@ struct EncodingResult {
     double confidence = 0.0;                        // Detection confidence 0.0-1.0 / Algilama guveni 0.0-1.0
 };
 
+// How a file is stored on disk: the encoding it was read in and whether it starts with a BOM,
+// so a buffer is written back the way it was opened
+// Bir dosyanin diskte nasil saklandigi: okundugu kodlama ve bir BOM ile baslayip baslamadigi,
+// boylece bir buffer acildigi sekilde geri yazilir
+struct FileEncoding {
+    TextEncoding encoding = TextEncoding::UTF8;
+    bool bom = false;
+};
+
 // Detects file encoding and converts text to/from UTF-8.
 // Dosya kodlamasini algilar ve metni UTF-8'e/UTF-8'den donusturur.
 // Supports BOM detection, UTF-8 validation, and conversion from common encodings.
 // BOM algilama, UTF-8 dogrulama ve yaygin kodlamalardan donusturme destekler.
 // No external dependencies (no ICU) - handles UTF-8, UTF-16, UTF-32, Latin-1, ASCII.
 // Dis bagimliliklari yok (ICU yok) - UTF-8, UTF-16, UTF-32, Latin-1, ASCII isler.
+// Whole-buffer conversions run through Transcoder, which file load and save use in chunks.
+// Tum-tampon donusumleri, dosya yukleme ve kaydetmenin parcalar halinde kullandigi Transcoder'dan gecer.
 class EncodingDetector {
 public:
     // Detect encoding from raw file bytes
@@ -83,20 +94,4 @@ private:
     // Heuristic detection when no BOM is present
     // BOM olmadigi zaman bulussel algilama
     static EncodingResult detectHeuristic(const uint8_t* data, size_t size);
-
-    // UTF-16 to UTF-8 conversion helpers
-    // UTF-16'dan UTF-8'e donusturme yardimcilari
-    static std::string utf16ToUTF8(const uint8_t* data, size_t size, bool littleEndian);
-
-    // UTF-32 to UTF-8 conversion helpers
-    // UTF-32'den UTF-8'e donusturme yardimcilari
-    static std::string utf32ToUTF8(const uint8_t* data, size_t size, bool littleEndian);
-
-    // Latin-1 to UTF-8 conversion
-    // Latin-1'den UTF-8'e donusturme
-    static std::string latin1ToUTF8(const uint8_t* data, size_t size);
-
-    // Encode a single Unicode code point to UTF-8 bytes
-    // Tek bir Unicode kod noktasini UTF-8 baytlarina kodla
-    static void encodeUTF8(uint32_t codepoint, std::string& out);
 };
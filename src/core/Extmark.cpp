@@ -4,6 +4,7 @@
 // See LICENSE file in the project root for full license text.
 
 #include "Extmark.h"
+#include "PositionMap.h"
 #include <algorithm>
 
 // Default constructor
@@ -181,6 +182,24 @@ void ExtmarkManager::adjustForDelete(int startLine, int startCol, int endLine, i
     }
 }
 
+// Move every extmark through the batch's position map
+// Her extmark'i grubun konum haritasindan gecirerek tasi
+void ExtmarkManager::adjustForEdits(const PositionMap& map) {
+    if (map.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = marks_.begin();
+    while (it != marks_.end()) {
+        auto& m = it->second;
+        if (map.swallows(m.startLine, m.startCol, m.endLine, m.endCol)) {
+            it = marks_.erase(it);
+            continue;
+        }
+        map.map(m.startLine, m.startCol);
+        map.map(m.endLine, m.endCol);
+        ++it;
+    }
+}
+
 // List all extmarks, optionally filtered by namespace
 // Tum extmark'lari listele, istege bagli olarak ad alanina gore filtrele
 std::vector<const Extmark*> ExtmarkManager::list(const std::string& ns) const {
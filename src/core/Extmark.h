@@ -10,6 +10,8 @@
 #include <mutex>
 #include <atomic>
 
+class PositionMap;
+
 // Virtual text position relative to the extmark range
 // Extmark araligina gore sanal metin konumu
 enum class VirtTextPos {
@@ -93,6 +95,10 @@ public:
     void adjustForInsert(int line, int col, int linesAdded, int colsAdded);
     void adjustForDelete(int startLine, int startCol, int endLine, int endCol);
 
+    // Adjust for a whole batch of edits in one pass (marks swallowed by a replacement are removed)
+    // Tum bir duzenleme grubu icin tek geciste ayarla (bir degistirmenin yuttugu isaretler kaldirilir)
+    void adjustForEdits(const PositionMap& map);
+
     // List all extmarks (optionally filtered by namespace)
     // Tum extmark'lari listele (istege bagli olarak ad alanina gore filtrele)
     std::vector<const Extmark*> list(const std::string& ns = "") const;
@@ -0,0 +1,82 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "FileSaver.h"
+#include "Logger.h"
+
+// Start the writer thread
+// Yazici thread'i baslat
+FileSaver::FileSaver() {
+    worker_ = std::thread(&FileSaver::run, this);
+}
+
+// Drain the queue so no accepted save is lost, then join
+// Kabul edilen hicbir kaydetme kaybolmasin diye kuyrugu bosalt, sonra bekle
+FileSaver::~FileSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+// Fold into a waiting job for the same path, otherwise append
+// Ayni yol icin bekleyen bir ise katla, yoksa sona ekle
+void FileSaver::save(BufferSnapshot snap, const std::string& path, FileEncoding encoding, DoneFn done) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& job : queue_) {
+            if (job.path != path) continue;
+            if (snap.version() >= job.snap.version()) {
+                job.snap = std::move(snap);
+                job.encoding = encoding;
+            }
+            if (done) job.done.push_back(std::move(done));
+            return;
+        }
+        Job job{std::move(snap), path, encoding, {}};
+        if (done) job.done.push_back(std::move(done));
+        queue_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+// Wait until the queue is empty and the worker is idle
+// Kuyruk bosalip calisan bosta kalana kadar bekle
+void FileSaver::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCv_.wait(lock, [this] { return queue_.empty() && !busy_; });
+}
+
+// Count the queue plus the job being written, under the lock
+// Kuyrugu ve yazilmakta olan isi kilit altinda say
+size_t FileSaver::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size() + (busy_ ? 1 : 0);
+}
+
+// Write jobs one at a time; callbacks run without the lock held
+// Isleri tek tek yaz; callback'ler kilit tutulmadan calisir
+void FileSaver::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) break;
+
+        Job job = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        FileResult res = FileSystem::saveSnapshot(job.snap, job.path, job.encoding);
+        if (!res.success) LOG_ERROR("[FileSaver] ", job.path, ": ", res.message);
+        for (auto& fn : job.done) fn(res, job.snap);
+
+        lock.lock();
+        busy_ = false;
+        if (queue_.empty()) idleCv_.notify_all();
+    }
+}
@@ -0,0 +1,73 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BufferSnapshot.h"
+#include "file.h"
+
+// Background writer for buffer snapshots.
+// Buffer anlik goruntuleri icin arka plan yazicisi.
+// Each save hands a snapshot over and returns at once; one worker thread writes them through
+// FileSystem::saveSnapshot (temp file, fsync, atomic rename) while editing continues.
+// Her kaydetme bir anlik goruntu teslim eder ve hemen doner; tek bir calisan thread onlari
+// FileSystem::saveSnapshot ile yazar (gecici dosya, fsync, atomik yeniden adlandirma), duzenleme surer.
+// A save queued for a path that already waits is folded into it: only the newer snapshot is
+// written and every caller is notified. Callbacks run on the worker thread.
+// Zaten bekleyen bir yol icin siraya alinan kaydetme ona katlanir: yalnizca yeni anlik goruntu
+// yazilir ve her cagiran bilgilendirilir. Callback'ler calisan thread'de calisir.
+class FileSaver {
+public:
+    using DoneFn = std::function<void(const FileResult& result, const BufferSnapshot& snap)>;
+
+    FileSaver();
+
+    // Write everything still queued, then stop the worker
+    // Hala sirada olan her seyi yaz, sonra calisani durdur
+    ~FileSaver();
+
+    FileSaver(const FileSaver&) = delete;
+    FileSaver& operator=(const FileSaver&) = delete;
+
+    // Queue a snapshot to be written to path in the given encoding
+    // Bir anlik goruntuyu verilen kodlamayla path'e yazilmak uzere siraya al
+    void save(BufferSnapshot snap, const std::string& path, FileEncoding encoding, DoneFn done = nullptr);
+
+    // Block until every queued save has finished
+    // Siradaki tum kaydetmeler bitene kadar bekle
+    void flush();
+
+    // Number of saves queued or in progress
+    // Sirada veya devam eden kaydetme sayisi
+    size_t pending() const;
+
+private:
+    // One file to write and everyone waiting on it
+    // Yazilacak bir dosya ve onu bekleyen herkes
+    struct Job {
+        BufferSnapshot snap;
+        std::string path;
+        FileEncoding encoding;
+        std::vector<DoneFn> done;
+    };
+
+    // Worker loop: pop, write, notify
+    // Calisan dongusu: al, yaz, bildir
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;        // Wakes the worker / Calisani uyandirir
+    std::condition_variable idleCv_;    // Wakes flush() / flush()'i uyandirir
+    std::deque<Job> queue_;             // Saves not started yet / Henuz baslamamis kaydetmeler
+    bool busy_ = false;                 // Worker is writing a job / Calisan bir isi yaziyor
+    bool stop_ = false;                 // Drain and exit / Bosalt ve cik
+    std::thread worker_;
+};
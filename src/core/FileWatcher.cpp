@@ -20,7 +20,6 @@ void FileWatcher::watch(const std::string& dirPath) {
     if (watching_.load()) return;
 
     watchDir_ = dirPath;
-    watching_ = true;
 
     // Default ignored directories (prevents self-triggering from log writes, etc.)
     // Varsayilan yok sayilan dizinler (log yazimlarindan kaynaklanan kendi kendini tetiklemeyi onler)
@@ -30,7 +29,17 @@ void FileWatcher::watch(const std::string& dirPath) {
 
     // Take initial snapshot so we know the baseline (no events emitted)
     // Ilk snapshot'i al ki temel durumu bilelim (olay yayinlanmaz)
-    lastSnapshot_ = takeSnapshot();
+    watch(dirPath, takeSnapshot());
+}
+
+// Start watching from a given baseline — no initial walk
+// Verilen bir temelden izlemeye basla — ilk gezinti yok
+void FileWatcher::watch(const std::string& dirPath, Snapshot baseline) {
+    if (watching_.load()) return;
+
+    watchDir_ = dirPath;
+    watching_ = true;
+    lastSnapshot_ = std::move(baseline);
 
     LOG_INFO("[FileWatcher] Watching: ", dirPath,
              " (", lastSnapshot_.size(), " entries, interval=",
@@ -97,15 +106,18 @@ FileWatcher::Snapshot FileWatcher::takeSnapshot() {
     if (!fs::exists(watchDir_)) return snap;
 
     try {
-        for (const auto& entry : fs::recursive_directory_iterator(
-                 watchDir_, fs::directory_options::skip_permission_denied)) {
-
-            // Skip ignored directories (e.g. logs/)
-            // Yok sayilan dizinleri atla (orn. logs/)
-            if (isIgnoredPath(entry.path())) continue;
-
+        fs::recursive_directory_iterator it(watchDir_, fs::directory_options::skip_permission_denied);
+        for (; it != fs::recursive_directory_iterator(); ++it) {
+            const fs::directory_entry& entry = *it;
             bool isDir = entry.is_directory();
 
+            // Skip ignored directories (e.g. logs/) without walking into them
+            // Yok sayilan dizinleri (orn. logs/) icine girmeden atla
+            if (isIgnoredName(entry.path().filename().string(), ignoreDirs_)) {
+                if (isDir) it.disable_recursion_pending();
+                continue;
+            }
+
             // For files: apply extension filter
             // Dosyalar icin: uzanti filtresini uygula
             if (!isDir && !matchesFilter(entry.path())) continue;
@@ -190,15 +202,11 @@ bool FileWatcher::matchesFilter(const fs::path& p) const {
     return false;
 }
 
-// Check if any path segment matches an ignored directory name
-// Yol segmentlerinden herhangi birinin yok sayilan dizin ismiyle eslesip eslesmedigini kontrol et
-bool FileWatcher::isIgnoredPath(const fs::path& p) const {
-    if (ignoreDirs_.empty()) return false;
-    for (const auto& segment : p) {
-        const std::string name = segment.filename().string();
-        for (const auto& dir : ignoreDirs_) {
-            if (name == dir) return true;
-        }
+// Exact match of one path component against the ignored directory names
+// Tek bir yol bileseninin yok sayilan dizin adlarina tam eslesmesi
+bool FileWatcher::isIgnoredName(const std::string& name, const std::vector<std::string>& dirs) {
+    for (const auto& dir : dirs) {
+        if (name == dir) return true;
     }
     return false;
 }
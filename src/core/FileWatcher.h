@@ -42,6 +42,18 @@ using FileEventCallback = std::function<void(const FileEventData&)>;
 // Thread-guvenli: callback'ler izleyici thread'inden cagrilir.
 class FileWatcher {
 public:
+    // Snapshot entry: file metadata for comparison
+    // Snapshot girdisi: karsilastirma icin dosya metaverisi
+    struct Entry {
+        std::filesystem::file_time_type mtime;
+        std::uintmax_t                  size;
+        bool                            isDirectory;
+    };
+
+    // Entries by path as iterating the watched directory spells them
+    // Izlenen dizini gezerken yazildiklari haliyle yola gore girdiler
+    using Snapshot = std::unordered_map<std::string, Entry>;
+
     FileWatcher();
     ~FileWatcher();
 
@@ -49,6 +61,12 @@ public:
     // Bir dizini tekrarlamali olarak izlemeye basla (engellemez, arka plan thread'i baslatir)
     void watch(const std::string& dirPath);
 
+    // Same, from a baseline the caller already walked (directories carry size 0 and no
+    // mtime), so the tree is not walked twice; differences from it come on the first poll
+    // Ayni, cagiranin zaten gezdigi bir temelden (dizinler 0 boyut ve mtime'siz), boylece agac
+    // iki kez gezilmez; ondan farklar ilk yoklamada gelir
+    void watch(const std::string& dirPath, Snapshot baseline);
+
     // Stop watching and join the background thread
     // Izlemeyi durdur ve arka plan thread'ini bekle
     void stop();
@@ -69,6 +87,13 @@ public:
     // Izleme sirasinda yok sayilacak dizin isimlerini ayarla. Ornek: {"logs", "cache"}
     void setIgnoreDirs(const std::vector<std::string>& dirs);
 
+    // Check if a single path segment is one of the ignored names (the rule setIgnoreDirs applies
+    // to every entry name, pruning ignored directories; shared with WorkspaceSearch)
+    // Tek bir yol segmentinin yok sayilan isimlerden biri olup olmadigini kontrol et
+    // (setIgnoreDirs'in her girdi adina uyguladigi, yok sayilan dizinleri budayan kural;
+    // WorkspaceSearch ile paylasilir)
+    static bool isIgnoredName(const std::string& name, const std::vector<std::string>& dirs);
+
     // Check if currently watching
     // Su an izleme yapilip yapilmadigini kontrol et
     bool isWatching() const { return watching_.load(); }
@@ -78,18 +103,8 @@ public:
     const std::string& watchPath() const { return watchDir_; }
 
 private:
-    // Snapshot entry: file metadata for comparison
-    // Snapshot girdisi: karsilastirma icin dosya metaverisi
-    struct Entry {
-        std::filesystem::file_time_type mtime;
-        std::uintmax_t                  size;
-        bool                            isDirectory;
-    };
-
-    using Snapshot = std::unordered_map<std::string, Entry>;
-
-    // Take a full snapshot of the watched directory tree
-    // Izlenen dizin agacinin tam snapshot'ini al
+    // Take a full snapshot of the watched directory tree; ignored directories are not entered
+    // Izlenen dizin agacinin tam snapshot'ini al; yok sayilan dizinlere girilmez
     Snapshot takeSnapshot();
 
     // Compare two snapshots and emit events for differences
@@ -104,10 +119,6 @@ private:
     // Bir yolun uzanti filtresinden gecip gecmedigini kontrol et
     bool matchesFilter(const std::filesystem::path& p) const;
 
-    // Check if a path falls under an ignored directory
-    // Bir yolun yok sayilan bir dizin altinda olup olmadigini kontrol et
-    bool isIgnoredPath(const std::filesystem::path& p) const;
-
     // Background thread main loop
     // Arka plan thread'i ana dongusu
     void loop();
@@ -4,7 +4,9 @@
 // See LICENSE file in the project root for full license text.
 
 #include "FoldManager.h"
+#include "PositionMap.h"
 #include <algorithm>
+#include <limits>
 
 // Default constructor
 // Varsayilan kurucu
@@ -181,6 +183,23 @@ void FoldManager::adjustForDelete(int startLine, int linesDeleted) {
     folds_ = std::move(adjusted);
 }
 
+// Map the first line from its start and the last line from its end
+// Ilk satiri basindan, son satiri sonundan esle
+void FoldManager::adjustForEdits(const PositionMap& map) {
+    if (map.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<int, Fold> adjusted;
+    for (auto& [start, fold] : folds_) {
+        int startCol = 0;
+        int endCol = std::numeric_limits<int>::max() / 2;
+        map.map(fold.startLine, startCol);
+        map.map(fold.endLine, endCol);
+        if (fold.endLine <= fold.startLine) continue;
+        adjusted[fold.startLine] = fold;
+    }
+    folds_ = std::move(adjusted);
+}
+
 // Clear all folds
 // Tum katlamalari temizle
 void FoldManager::clearAll() {
@@ -9,6 +9,8 @@
 #include <map>
 #include <mutex>
 
+class PositionMap;
+
 // A single fold region in a buffer
 // Buffer'daki tek bir katlama bolgesi
 struct Fold {
@@ -77,6 +79,10 @@ public:
     void adjustForInsert(int atLine, int linesAdded);
     void adjustForDelete(int startLine, int linesDeleted);
 
+    // Adjust folds for a whole batch of edits in one pass (folds that collapse to one line are removed)
+    // Katlamalari tum bir duzenleme grubu icin tek geciste ayarla (tek satira inen katlamalar kaldirilir)
+    void adjustForEdits(const PositionMap& map);
+
     // Clear all folds
     // Tum katlamalari temizle
     void clearAll();
@@ -167,7 +167,7 @@ void IndentEngine::reindentRange(Buffer& buf, int startLine, int endLine) const
     for (int i = startLine; i <= endLine; ++i) {
         IndentResult indent = indentForLine(buf, i);
         std::string content = stripLeadingWhitespace(buf.getLine(i));
-        buf.getLineRef(i) = indent.indentString + content;
+        buf.setLine(i, indent.indentString + content);
     }
 }
 
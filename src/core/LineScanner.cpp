@@ -0,0 +1,144 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "LineScanner.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define BERKIDE_SCAN_SSE2 1
+    #endif
+    // AVX2 is compiled per function and picked at runtime on GCC/Clang; MSVC needs /arch:AVX2
+    // AVX2 GCC/Clang'da fonksiyon bazinda derlenir ve calisma zamaninda secilir; MSVC /arch:AVX2 ister
+    #if defined(__GNUC__) || defined(__clang__)
+        #define BERKIDE_SCAN_AVX2 1
+        #define BERKIDE_TARGET_AVX2 __attribute__((target("avx2")))
+    #elif defined(__AVX2__)
+        #define BERKIDE_SCAN_AVX2 1
+        #define BERKIDE_TARGET_AVX2
+    #endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace {
+
+// Index of the lowest set bit (mask is never zero here)
+// En dusuk set bitin indeksi (mask burada asla sifir degil)
+[[maybe_unused]] inline unsigned lowestBit(unsigned mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Finish a scan with the C library (also the whole scan on other architectures)
+// Taramayi C kutuphanesiyle bitir (diger mimarilerde taramanin tamami)
+inline size_t scanTail(const char* data, size_t i, size_t len) {
+    if (i >= len) return len;
+    const void* hit = std::memchr(data + i, '\n', len - i);
+    return hit ? static_cast<size_t>(static_cast<const char*>(hit) - data) : len;
+}
+
+#if defined(BERKIDE_SCAN_SSE2)
+// 16 bytes per step
+// Adim basina 16 bayt
+size_t findNewlineSse2(const char* data, size_t len) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, nl)));
+        if (mask) return i + lowestBit(mask);
+    }
+    return scanTail(data, i, len);
+}
+#endif
+
+#if defined(BERKIDE_SCAN_AVX2)
+// 32 bytes per step
+// Adim basina 32 bayt
+BERKIDE_TARGET_AVX2 size_t findNewlineAvx2(const char* data, size_t len) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, nl)));
+        if (mask) return i + lowestBit(mask);
+    }
+    return scanTail(data, i, len);
+}
+#endif
+
+// Portable fallback
+// Tasinabilir yedek
+[[maybe_unused]] size_t findNewlineScalar(const char* data, size_t len) {
+    return scanTail(data, 0, len);
+}
+
+using ScanFn = size_t (*)(const char*, size_t);
+
+// Pick the widest kernel the CPU supports
+// CPU'nun destekledigi en genis cekirdegi sec
+struct Kernel {
+    ScanFn fn;
+    const char* name;
+};
+
+Kernel selectKernel() {
+#if defined(BERKIDE_SCAN_AVX2)
+    #if defined(__GNUC__) || defined(__clang__)
+    if (__builtin_cpu_supports("avx2")) return {findNewlineAvx2, "avx2"};
+    #else
+    return {findNewlineAvx2, "avx2"};
+    #endif
+#endif
+#if defined(BERKIDE_SCAN_SSE2)
+    return {findNewlineSse2, "sse2"};
+#else
+    return {findNewlineScalar, "scalar"};
+#endif
+}
+
+const Kernel& kernel() {
+    static const Kernel k = selectKernel();
+    return k;
+}
+
+} // namespace
+
+// Dispatch to the selected kernel
+// Secilen cekirdege yonlendir
+size_t LineScanner::findNewline(const char* data, size_t len) {
+    return kernel().fn(data, len);
+}
+
+// Emit every complete line in the block, dropping the '\n' and a preceding '\r'
+// Bloktaki her tam satiri '\n' ve oncesindeki '\r' atilarak cikar
+size_t LineScanner::splitLines(const char* data, size_t len, std::vector<std::string>& out) {
+    ScanFn scan = kernel().fn;
+    size_t pos = 0;
+    while (pos < len) {
+        size_t nl = pos + scan(data + pos, len - pos);
+        if (nl >= len) break;
+        size_t end = nl;
+        if (end > pos && data[end - 1] == '\r') --end;
+        out.emplace_back(data + pos, end - pos);
+        pos = nl + 1;
+    }
+    return pos;
+}
+
+// Report which kernel this process uses
+// Bu surecin kullandigi cekirdegi bildir
+const char* LineScanner::kernelName() {
+    return kernel().name;
+}
@@ -0,0 +1,30 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Vectorized newline scanning and line splitting for file loading.
+// Dosya yukleme icin vektorlestirilmis yeni satir tarama ve satir bolme.
+// Uses AVX2 when the CPU supports it, else SSE2, with a scalar fallback elsewhere.
+// CPU destekliyorsa AVX2, yoksa SSE2, diger durumlarda skaler yedek kullanir.
+class LineScanner {
+public:
+    // Offset of the first '\n' in [data, data + len), or len if there is none
+    // [data, data + len) icindeki ilk '\n'in ofseti, yoksa len
+    static size_t findNewline(const char* data, size_t len);
+
+    // Split text into lines ('\n' or "\r\n"), appending them to out.
+    // Metni satirlara bol ('\n' veya "\r\n") ve out'a ekle.
+    // Returns the offset of the unterminated tail, which the caller carries to the next block.
+    // Sonlandirilmamis kuyrugun ofsetini dondurur; cagiran onu sonraki bloga tasir.
+    static size_t splitLines(const char* data, size_t len, std::vector<std::string>& out);
+
+    // Name of the active scan kernel ("avx2", "sse2" or "scalar")
+    // Aktif tarama cekirdeginin adi ("avx2", "sse2" veya "scalar")
+    static const char* kernelName();
+};
@@ -0,0 +1,63 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "LineStore.h"
+#include <atomic>
+
+// Constructor: empty chunk table
+// Kurucu: bos parca tablosu
+LineStore::LineStore() : table_(std::make_shared<Table>()) {}
+
+// Chunk lookup by the high bits, slot by the low bits
+// Ust bitlerle parca, alt bitlerle yuva bulunur
+const std::string& LineStore::operator[](int index) const {
+    return (*table_)[index >> kChunkBits]->lines[index & (kChunkSize - 1)];
+}
+
+// Mutable access to a line
+// Bir satira degistirilebilir erisim
+std::string& LineStore::at(int index) {
+    return (*table_)[index >> kChunkBits]->lines[index & (kChunkSize - 1)];
+}
+
+// Append into the last chunk, starting a new one when it is full
+// Son parcaya ekle, doluysa yeni bir parca baslat
+int LineStore::push(std::string line) {
+    int index = size_;
+    size_t chunk = static_cast<size_t>(index >> kChunkBits);
+    if (chunk >= table_->size()) {
+        // A copy may still hold this table: grow a private copy of it instead
+        // Bir kopya bu tabloyu hala tutuyor olabilir: onun yerine ozel bir kopyasini buyut
+        if (table_.use_count() > 1) {
+            table_ = std::make_shared<Table>(*table_);
+        } else {
+            // Pair with the release of a reader that just dropped its reference
+            // Referansini yeni birakan bir okuyucunun release'i ile eslestir
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        table_->push_back(std::make_shared<Chunk>());
+    }
+    auto& slot = *(*table_)[chunk];
+    slot.starts[index & (kChunkSize - 1)] = offsetOf(index);
+    slot.lines[index & (kChunkSize - 1)] = std::move(line);
+    ++size_;
+    return index;
+}
+
+// Stored start of a line; the end of the store follows from the last line's current length
+// Bir satirin saklanan baslangici; deponun sonu son satirin guncel uzunlugundan gelir
+uint64_t LineStore::offsetOf(int index) const {
+    if (index <= 0 || size_ == 0) return 0;
+    if (index < size_) return (*table_)[index >> kChunkBits]->starts[index & (kChunkSize - 1)];
+    int last = size_ - 1;
+    return (*table_)[last >> kChunkBits]->starts[last & (kChunkSize - 1)] + (*this)[last].size() + 1;
+}
+
+// Start over with a fresh table
+// Yeni bir tabloyla bastan basla
+void LineStore::clear() {
+    table_ = std::make_shared<Table>();
+    size_ = 0;
+}
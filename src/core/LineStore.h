@@ -0,0 +1,61 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Append-only line storage in fixed-size chunks (the piece table's add buffer).
+// Sabit boyutlu parcalar halinde yalnizca eklemeli satir deposu (piece table'in ekleme arabellegi).
+// Appending never moves existing lines, and copies share chunks: a copy taken at size N
+// can keep reading lines [0, N) while the original appends past N.
+// Ekleme mevcut satirlari asla tasimaz ve kopyalar parcalari paylasir: N boyutunda alinan
+// bir kopya, orijinal N'in otesine eklerken [0, N) satirlarini okumaya devam edebilir.
+class LineStore {
+public:
+    LineStore();
+
+    // Number of stored lines
+    // Saklanan satir sayisi
+    int size() const { return size_; }
+
+    // Read a line
+    // Bir satiri oku
+    const std::string& operator[](int index) const;
+
+    // Mutable access (only for lines no copy can see). Changing the length of any line but
+    // the last one leaves offsetOf stale for the lines after it.
+    // Degistirilebilir erisim (yalnizca hicbir kopyanin goremeyecegi satirlar icin). Son satir
+    // disinda bir satirin uzunlugunu degistirmek, ondan sonraki satirlar icin offsetOf'u bayatlatir.
+    std::string& at(int index);
+
+    // Bytes of lines [0, index), each counted with one '\n' (index may equal size())
+    // [0, index) satirlarinin baytlari, her biri bir '\n' ile sayilir (index size()'a esit olabilir)
+    uint64_t offsetOf(int index) const;
+
+    // Append a line and return its index
+    // Bir satir ekle ve indeksini dondur
+    int push(std::string line);
+
+    // Drop every line (copies keep the chunks they share)
+    // Tum satirlari birak (kopyalar paylastiklari parcalari korur)
+    void clear();
+
+private:
+    static constexpr int kChunkBits = 10;
+    static constexpr int kChunkSize = 1 << kChunkBits;
+
+    struct Chunk {
+        std::array<std::string, kChunkSize> lines;
+        std::array<uint64_t, kChunkSize> starts;  // offsetOf each line, fixed at push / Her satirin offsetOf'u, eklemede sabitlenir
+    };
+    using Table = std::vector<std::shared_ptr<Chunk>>;
+
+    std::shared_ptr<Table> table_;  // Chunk table, copied on growth when shared / Parca tablosu, paylasiliyorsa buyumede kopyalanir
+    int size_ = 0;                  // Lines stored / Saklanan satirlar
+};
@@ -0,0 +1,1411 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "LinearRegexEngine.h"
+#include "ReplaceTemplate.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// ========================================================================
+// Syntax tree
+// Sozdizimi agaci
+// ========================================================================
+
+struct CpRange {
+    uint32_t lo, hi;
+};
+using CpSet = std::vector<CpRange>;  // Sorted, disjoint codepoint ranges / Sirali, ayrik kod noktasi araliklari
+
+constexpr uint32_t kMaxCodepoint = 0x10FFFF;
+constexpr int kMaxDepth = 250;        // Group nesting / Grup ic ice gecmesi
+constexpr int kMaxRepeat = 1000;      // {n,m} bound / {n,m} siniri
+constexpr int kMaxGroups = 1000;
+
+enum class AssertKind : uint8_t { LineStart, LineEnd, WordBoundary, NotWordBoundary };
+
+struct Node {
+    enum Kind { Class, Concat, Alternate, Repeat, Group, Assert } kind;
+    CpSet set;                  // Class
+    bool strayBytes = false;    // Class also takes bytes that start no valid sequence / Sinif gecerli dizi baslatmayan baytlari da alir
+    std::vector<std::unique_ptr<Node>> children;
+    int min = 0, max = -1;      // Repeat; max -1 is unbounded / Repeat; max -1 sinirsiz
+    bool greedy = true;
+    int capture = -1;           // Group index, -1 for (?:...) / Grup indeksi, (?:...) icin -1
+    AssertKind assertion = AssertKind::LineStart;
+
+    explicit Node(Kind k) : kind(k) {}
+};
+using NodePtr = std::unique_ptr<Node>;
+
+struct PatternError {
+    std::string message;
+};
+
+void normalize(CpSet& set) {
+    std::sort(set.begin(), set.end(), [](const CpRange& a, const CpRange& b) { return a.lo < b.lo; });
+    CpSet out;
+    for (const auto& r : set) {
+        if (!out.empty() && r.lo <= out.back().hi + 1) out.back().hi = std::max(out.back().hi, r.hi);
+        else out.push_back(r);
+    }
+    set.swap(out);
+}
+
+CpSet negate(const CpSet& set) {
+    CpSet out;
+    uint32_t next = 0;
+    for (const auto& r : set) {
+        if (r.lo > next) out.push_back({next, r.lo - 1});
+        next = r.hi + 1;
+    }
+    if (next <= kMaxCodepoint) out.push_back({next, kMaxCodepoint});
+    return out;
+}
+
+// Simple case folding: a rule maps [lo, hi] by delta, or to the neighbour in upper/lower pairs
+// Basit harf katlama: bir kural [lo, hi]'yi delta ile veya buyuk/kucuk ciftlerde komsusuna esler
+struct FoldRule {
+    uint32_t lo, hi;
+    int32_t delta;  // 0 means alternating pairs starting with the upper case / 0 buyuk harfle baslayan degisen ciftler demek
+};
+
+constexpr FoldRule kFoldRules[] = {
+    {0x41, 0x5A, 32},     {0x61, 0x7A, -32},                          // ASCII
+    {0xC0, 0xD6, 32},     {0xD8, 0xDE, 32},    {0xE0, 0xF6, -32},  {0xF8, 0xFE, -32},  // Latin-1
+    {0xFF, 0xFF, 0x79},   {0x178, 0x178, -0x79},
+    {0x100, 0x12F, 0},    {0x132, 0x137, 0},   {0x139, 0x148, 0},  {0x14A, 0x177, 0},   // Latin Extended-A
+    {0x179, 0x17E, 0},
+    {0x391, 0x3A1, 32},   {0x3A3, 0x3A9, 32},  {0x3B1, 0x3C1, -32}, {0x3C3, 0x3C9, -32}, // Greek
+    {0x3A3, 0x3A3, 31},   {0x3C3, 0x3C3, -1},  {0x3C2, 0x3C2, 1},   {0x3C2, 0x3C2, -31}, // Final sigma / Son sigma
+    {0x400, 0x40F, 80},   {0x410, 0x42F, 32},  {0x430, 0x44F, -32}, {0x450, 0x45F, -80}, // Cyrillic
+};
+
+void foldCase(CpSet& set) {
+    CpSet added;
+    for (const auto& r : set) {
+        for (const auto& rule : kFoldRules) {
+            uint32_t lo = std::max(r.lo, rule.lo), hi = std::min(r.hi, rule.hi);
+            if (lo > hi) continue;
+            if (rule.delta != 0) {
+                added.push_back({lo + rule.delta, hi + rule.delta});
+                continue;
+            }
+            for (uint32_t cp = lo; cp <= hi; ++cp) {
+                uint32_t other = (cp - rule.lo) % 2 == 0 ? cp + 1 : cp - 1;
+                added.push_back({other, other});
+            }
+        }
+    }
+    set.insert(set.end(), added.begin(), added.end());
+    normalize(set);
+}
+
+CpSet perlClass(char c) {
+    CpSet set;
+    switch (c) {
+        case 'd': case 'D':
+            set = {{'0', '9'}};
+            break;
+        case 'w': case 'W':
+            set = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+            break;
+        default:  // s, S: ECMAScript white space and line terminators / ECMAScript bosluk ve satir sonlari
+            set = {{0x09, 0x0D}, {0x20, 0x20}, {0xA0, 0xA0}, {0x1680, 0x1680}, {0x2000, 0x200A},
+                   {0x2028, 0x2029}, {0x202F, 0x202F}, {0x205F, 0x205F}, {0x3000, 0x3000}, {0xFEFF, 0xFEFF}};
+            break;
+    }
+    return (c >= 'A' && c <= 'Z') ? negate(set) : set;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Recursive descent over the pattern; each group level costs a bounded amount of stack
+// Kalip uzerinde ozyinelemeli inis; her grup seviyesi sinirli miktarda yigin harcar
+class Parser {
+public:
+    Parser(std::string_view pattern, bool caseInsensitive) : p_(pattern), icase_(caseInsensitive) {}
+
+    NodePtr parse() {
+        NodePtr root = parseAlternation(0);
+        if (more()) fail("unmatched ')'");
+        return root;
+    }
+
+    int groups() const { return groups_; }
+
+private:
+    bool more() const { return pos_ < p_.size(); }
+    char peek() const { return p_[pos_]; }
+
+    bool eat(char c) {
+        if (more() && p_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw PatternError{message + " at offset " + std::to_string(pos_)};
+    }
+
+    NodePtr parseAlternation(int depth) {
+        if (depth > kMaxDepth) fail("pattern nests too deeply");
+        std::vector<NodePtr> branches;
+        branches.push_back(parseConcat(depth));
+        while (eat('|')) branches.push_back(parseConcat(depth));
+        if (branches.size() == 1) return std::move(branches[0]);
+        auto node = std::make_unique<Node>(Node::Alternate);
+        node->children = std::move(branches);
+        return node;
+    }
+
+    NodePtr parseConcat(int depth) {
+        auto node = std::make_unique<Node>(Node::Concat);
+        while (more() && peek() != '|' && peek() != ')') node->children.push_back(parseRepeat(depth));
+        return node;
+    }
+
+    NodePtr parseRepeat(int depth) {
+        NodePtr atom = parseAtom(depth);
+        int min, max;
+        if (!more() || !parseQuantifier(min, max)) return atom;
+        if (atom->kind == Node::Assert) fail("nothing to repeat");
+        bool greedy = !eat('?');
+        size_t next = pos_;
+        int ignoredMin, ignoredMax;
+        if (more() && parseQuantifier(ignoredMin, ignoredMax)) {
+            pos_ = next;
+            fail("nothing to repeat");
+        }
+        auto node = std::make_unique<Node>(Node::Repeat);
+        node->min = min;
+        node->max = max;
+        node->greedy = greedy;
+        node->children.push_back(std::move(atom));
+        return node;
+    }
+
+    // '{' that does not form a valid {n}, {n,} or {n,m} is a literal brace
+    // Gecerli bir {n}, {n,} veya {n,m} olusturmayan '{' literal bir ayractir
+    bool parseQuantifier(int& min, int& max) {
+        switch (peek()) {
+            case '*': ++pos_; min = 0; max = -1; return true;
+            case '+': ++pos_; min = 1; max = -1; return true;
+            case '?': ++pos_; min = 0; max = 1;  return true;
+            case '{': break;
+            default:  return false;
+        }
+        size_t save = pos_++;
+        if (!readInt(min)) {
+            pos_ = save;
+            return false;
+        }
+        max = min;
+        if (eat(',')) {
+            if (more() && peek() == '}') max = -1;
+            else if (!readInt(max)) {
+                pos_ = save;
+                return false;
+            }
+        }
+        if (!eat('}')) {
+            pos_ = save;
+            return false;
+        }
+        if (min > kMaxRepeat || max > kMaxRepeat) fail("repetition count too large");
+        if (max != -1 && max < min) fail("numbers out of order in {} quantifier");
+        return true;
+    }
+
+    bool readInt(int& value) {
+        size_t start = pos_;
+        value = 0;
+        while (more() && peek() >= '0' && peek() <= '9') {
+            value = std::min(value * 10 + (peek() - '0'), 1000000);
+            ++pos_;
+        }
+        return pos_ > start;
+    }
+
+    NodePtr parseAtom(int depth) {
+        switch (peek()) {
+            case '(':
+                return parseGroup(depth);
+            case '[':
+                return parseClass();
+            case '.': {
+                ++pos_;
+                // Anything but line terminators / Satir sonlari disinda her sey
+                return classNode(negate({{'\n', '\n'}, {'\r', '\r'}, {0x2028, 0x2029}}), true);
+            }
+            case '^':
+                ++pos_;
+                return assertNode(AssertKind::LineStart);
+            case '$':
+                ++pos_;
+                return assertNode(AssertKind::LineEnd);
+            case '\\':
+                return parseEscape();
+            case '*': case '+': case '?':
+                fail("nothing to repeat");
+            case '{': {
+                size_t save = pos_;
+                int ignoredMin, ignoredMax;
+                if (parseQuantifier(ignoredMin, ignoredMax)) {
+                    pos_ = save;
+                    fail("nothing to repeat");
+                }
+                return literalNode(readCodepoint());
+            }
+            default:
+                return literalNode(readCodepoint());
+        }
+    }
+
+    NodePtr parseGroup(int depth) {
+        ++pos_;
+        int capture = -1;
+        if (eat('?')) {
+            if (eat(':')) {
+            } else if (more() && (peek() == '=' || peek() == '!')) {
+                fail("lookahead is not supported");
+            } else if (eat('<')) {
+                if (more() && (peek() == '=' || peek() == '!')) fail("lookbehind is not supported");
+                size_t end = p_.find('>', pos_);
+                if (end == std::string_view::npos || end == pos_) fail("invalid group name");
+                pos_ = end + 1;
+                capture = ++groups_;
+            } else {
+                fail("invalid group");
+            }
+        } else {
+            capture = ++groups_;
+        }
+        if (groups_ > kMaxGroups) fail("too many groups");
+        NodePtr body = parseAlternation(depth + 1);
+        if (!eat(')')) fail("missing ')'");
+        auto node = std::make_unique<Node>(Node::Group);
+        node->capture = capture;
+        node->children.push_back(std::move(body));
+        return node;
+    }
+
+    NodePtr parseEscape() {
+        ++pos_;
+        if (!more()) fail("trailing backslash");
+        char c = peek();
+        switch (c) {
+            case 'b': ++pos_; return assertNode(AssertKind::WordBoundary);
+            case 'B': ++pos_; return assertNode(AssertKind::NotWordBoundary);
+            case 'd': case 'D': case 'w': case 'W': case 's': case 'S':
+                ++pos_;
+                return classNode(perlClass(c), c >= 'A' && c <= 'Z');
+            default:
+                if (c >= '1' && c <= '9') fail("backreferences are not supported");
+                return literalNode(readEscaped(false));
+        }
+    }
+
+    // Bracket expression; '-' next to a class escape is literal, as in ECMAScript Annex B
+    // Koseli ifade; bir sinif kacisinin yanindaki '-' ECMAScript Ek B'deki gibi literaldir
+    NodePtr parseClass() {
+        ++pos_;
+        bool negated = eat('^');
+        CpSet set;
+        while (true) {
+            if (!more()) fail("missing ']'");
+            if (eat(']')) break;
+            uint32_t lo;
+            CpSet atom;
+            if (classAtom(lo, atom)) {
+                set.insert(set.end(), atom.begin(), atom.end());
+                continue;
+            }
+            if (pos_ + 1 < p_.size() && peek() == '-' && p_[pos_ + 1] != ']') {
+                ++pos_;
+                uint32_t hi;
+                CpSet atom2;
+                if (classAtom(hi, atom2)) {
+                    set.push_back({lo, lo});
+                    set.push_back({'-', '-'});
+                    set.insert(set.end(), atom2.begin(), atom2.end());
+                    continue;
+                }
+                if (hi < lo) fail("invalid class range");
+                set.push_back({lo, hi});
+                continue;
+            }
+            set.push_back({lo, lo});
+        }
+        normalize(set);
+        if (icase_) foldCase(set);
+        if (negated) set = negate(set);
+        return classNode(std::move(set), negated);
+    }
+
+    // A single codepoint (returns false) or a class escape such as \d or [:alpha:] (returns true)
+    // Tek bir kod noktasi (false dondurur) veya \d ya da [:alpha:] gibi bir sinif kacisi (true dondurur)
+    bool classAtom(uint32_t& cp, CpSet& set) {
+        if (p_.substr(pos_, 2) == "[:") {
+            set = posixClass();
+            return true;
+        }
+        if (peek() != '\\') {
+            cp = readCodepoint();
+            return false;
+        }
+        ++pos_;
+        if (!more()) fail("trailing backslash");
+        char c = peek();
+        if (c != '\0' && std::strchr("dDwWsS", c)) {
+            ++pos_;
+            set = perlClass(c);
+            return true;
+        }
+        if (c >= '1' && c <= '9') fail("backreferences are not supported");
+        cp = readEscaped(true);
+        return false;
+    }
+
+    // POSIX bracket class as std::regex reads it, over ASCII; an unknown name is an error
+    // rather than the literal characters ECMAScript would take
+    // std::regex'in okudugu gibi POSIX koseli sinifi, ASCII uzerinde; bilinmeyen bir ad,
+    // ECMAScript'in alacagi literal karakterler yerine bir hatadir
+    CpSet posixClass() {
+        size_t end = p_.find(":]", pos_ + 2);
+        if (end == std::string_view::npos) fail("missing ':]'");
+        std::string_view name = p_.substr(pos_ + 2, end - pos_ - 2);
+        CpSet set;
+        if (name == "alpha") set = {{'A', 'Z'}, {'a', 'z'}};
+        else if (name == "digit" || name == "d") set = {{'0', '9'}};
+        else if (name == "alnum") set = {{'0', '9'}, {'A', 'Z'}, {'a', 'z'}};
+        else if (name == "upper") set = {{'A', 'Z'}};
+        else if (name == "lower") set = {{'a', 'z'}};
+        else if (name == "space" || name == "s") set = {{0x09, 0x0D}, {' ', ' '}};
+        else if (name == "blank") set = {{'\t', '\t'}, {' ', ' '}};
+        else if (name == "punct") set = {{'!', '/'}, {':', '@'}, {'[', '`'}, {'{', '~'}};
+        else if (name == "xdigit") set = {{'0', '9'}, {'A', 'F'}, {'a', 'f'}};
+        else if (name == "word" || name == "w") set = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+        else if (name == "cntrl") set = {{0x00, 0x1F}, {0x7F, 0x7F}};
+        else if (name == "print") set = {{0x20, 0x7E}};
+        else if (name == "graph") set = {{0x21, 0x7E}};
+        else fail("invalid character class '" + std::string(name) + "'");
+        pos_ = end + 2;
+        return set;
+    }
+
+    // The escape after a backslash: control letters, \xHH, \uHHHH, \u{H...}, \cX or the character
+    // itself. Any other letter is an error, so \p{L}, \A or \z from other dialects do not
+    // silently match their letters.
+    // Ters egik cizgiden sonraki kacis: kontrol harfleri, \xHH, \uHHHH, \u{H...}, \cX veya
+    // karakterin kendisi. Baska her harf bir hatadir, boylece diger lehcelerden \p{L}, \A veya
+    // \z sessizce harflerini eslemez.
+    uint32_t readEscaped(bool inClass) {
+        char c = p_[pos_++];
+        switch (c) {
+            case 't': return '\t';
+            case 'n': return '\n';
+            case 'v': return '\v';
+            case 'f': return '\f';
+            case 'r': return '\r';
+            case '0': return 0;
+            case 'b':
+                if (inClass) return '\b';
+                break;
+            case 'x':
+                return readHex(2);
+            case 'u': {
+                if (eat('{')) {
+                    uint32_t v = 0;
+                    size_t start = pos_;
+                    while (more() && hexValue(peek()) >= 0 && v <= kMaxCodepoint) v = v * 16 + hexValue(p_[pos_++]);
+                    if (pos_ == start || !eat('}') || v > kMaxCodepoint) fail("invalid \\u{} escape");
+                    return v;
+                }
+                uint32_t v = readHex(4);
+                // A surrogate pair written as two escapes is one codepoint
+                // Iki kacis olarak yazilmis bir vekil cifti tek bir kod noktasidir
+                if (v >= 0xD800 && v <= 0xDBFF && p_.substr(pos_, 2) == "\\u") {
+                    size_t save = pos_;
+                    pos_ += 2;
+                    uint32_t low = readHex(4);
+                    if (low >= 0xDC00 && low <= 0xDFFF) return 0x10000 + ((v - 0xD800) << 10) + (low - 0xDC00);
+                    pos_ = save;
+                }
+                return v;
+            }
+            case 'c':
+                if (more() && std::isalpha(static_cast<unsigned char>(peek()))) return p_[pos_++] % 32;
+                fail("invalid \\c escape");
+            default:
+                if (std::isalpha(static_cast<unsigned char>(c))) fail(std::string("unsupported escape \\") + c);
+                break;
+        }
+        --pos_;
+        return readCodepoint();
+    }
+
+    uint32_t readHex(int digits) {
+        uint32_t v = 0;
+        for (int i = 0; i < digits; ++i) {
+            if (!more() || hexValue(peek()) < 0) fail("invalid hex escape");
+            v = v * 16 + hexValue(p_[pos_++]);
+        }
+        return v;
+    }
+
+    uint32_t readCodepoint() {
+        auto b = static_cast<uint8_t>(p_[pos_]);
+        size_t len = b < 0x80 ? 1 : (b >> 5) == 0x6 ? 2 : (b >> 4) == 0xE ? 3 : (b >> 3) == 0x1E ? 4 : 0;
+        if (len == 0 || pos_ + len > p_.size()) fail("invalid UTF-8 in pattern");
+        uint32_t cp = len == 1 ? b : b & (0x7F >> len);
+        for (size_t k = 1; k < len; ++k) {
+            auto c = static_cast<uint8_t>(p_[pos_ + k]);
+            if ((c & 0xC0) != 0x80) fail("invalid UTF-8 in pattern");
+            cp = (cp << 6) | (c & 0x3F);
+        }
+        pos_ += len;
+        return cp;
+    }
+
+    NodePtr classNode(CpSet set, bool strayBytes) {
+        auto node = std::make_unique<Node>(Node::Class);
+        node->set = std::move(set);
+        node->strayBytes = strayBytes;
+        return node;
+    }
+
+    NodePtr literalNode(uint32_t cp) {
+        CpSet set{{cp, cp}};
+        if (icase_) foldCase(set);
+        return classNode(std::move(set), false);
+    }
+
+    NodePtr assertNode(AssertKind kind) {
+        auto node = std::make_unique<Node>(Node::Assert);
+        node->assertion = kind;
+        return node;
+    }
+
+    std::string_view p_;
+    size_t pos_ = 0;
+    bool icase_;
+    int groups_ = 0;
+};
+
+void appendUTF8(uint32_t cp, std::string& out) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// A byte sequence [lo0-hi0][lo1-hi1]... matching a run of codepoints of one encoded length
+// Tek kodlanmis uzunluktaki bir kod noktasi dizisine uyan bayt dizisi [lo0-hi0][lo1-hi1]...
+struct Utf8Sequence {
+    int length = 0;
+    uint8_t lo[4], hi[4];
+};
+
+// Split [lo, hi] until each piece is a cross product of byte ranges (the RE2 construction)
+// [lo, hi]'yi her parca bayt araliklarinin kartezyen carpimi olana dek bol (RE2 yapisi)
+void utf8Sequences(uint32_t lo, uint32_t hi, std::vector<Utf8Sequence>& out) {
+    if (lo > hi) return;
+    if (lo <= 0xDFFF && hi >= 0xD800) {
+        if (lo < 0xD800) utf8Sequences(lo, 0xD7FF, out);
+        if (hi > 0xDFFF) utf8Sequences(0xE000, hi, out);
+        return;
+    }
+    for (uint32_t edge : {0x7Fu, 0x7FFu, 0xFFFFu}) {
+        if (lo <= edge && hi > edge) {
+            utf8Sequences(lo, edge, out);
+            utf8Sequences(edge + 1, hi, out);
+            return;
+        }
+    }
+    for (int i = 1; i < 4; ++i) {
+        uint32_t mask = (1u << (6 * i)) - 1;
+        if ((lo & ~mask) == (hi & ~mask)) continue;
+        if ((lo & mask) != 0) {
+            utf8Sequences(lo, lo | mask, out);
+            utf8Sequences((lo | mask) + 1, hi, out);
+            return;
+        }
+        if ((hi & mask) != mask) {
+            utf8Sequences(lo, (hi & ~mask) - 1, out);
+            utf8Sequences(hi & ~mask, hi, out);
+            return;
+        }
+    }
+    std::string a, b;
+    appendUTF8(lo, a);
+    appendUTF8(hi, b);
+    Utf8Sequence seq;
+    seq.length = static_cast<int>(a.size());
+    for (int k = 0; k < seq.length; ++k) {
+        seq.lo[k] = static_cast<uint8_t>(a[k]);
+        seq.hi[k] = static_cast<uint8_t>(b[k]);
+    }
+    out.push_back(seq);
+}
+
+bool isWordByte(int b) {
+    return (b >= '0' && b <= '9') || (b >= 'A' && b <= 'Z') || (b >= 'a' && b <= 'z') || b == '_';
+}
+
+// ========================================================================
+// Automata: compiled NFA with its lazy DFA
+// Otomatlar: tembel DFA'si ile derlenmis NFA
+// ========================================================================
+
+enum class Op : uint8_t { ByteRange, ByteSet, Split, Jump, Save, Assert, Match };
+
+struct Inst {
+    Op op;
+    uint8_t lo = 0, hi = 0;  // ByteRange
+    int out = -1;            // Next instruction (preferred branch of Split) / Sonraki talimat (Split'in tercih edilen dali)
+    int out1 = -1;           // Other branch of Split / Split'in diger dali
+    int arg = 0;             // ByteSet index, Save slot or AssertKind / ByteSet indeksi, Save yuvasi veya AssertKind
+};
+
+struct SparseSet {
+    std::vector<int> dense, sparse;
+    int size = 0;
+    std::vector<int> slots;  // Capture slots per instruction (Pike VM) / Talimat basina yakalama yuvalari (Pike VM)
+
+    void init(size_t n, int nslots) {
+        dense.assign(n, 0);
+        sparse.assign(n, 0);
+        slots.assign(n * nslots, -1);
+        size = 0;
+    }
+    bool contains(int pc) const {
+        int i = sparse[pc];
+        return i < size && dense[i] == pc;
+    }
+    void insert(int pc) {
+        sparse[pc] = size;
+        dense[size++] = pc;
+    }
+};
+
+// prev and next are the bytes around a position, or -1 at the ends of the text
+// prev ve next bir konumun etrafindaki baytlardir veya metnin uclarinda -1
+bool holds(AssertKind kind, int prev, int next) {
+    switch (kind) {
+        case AssertKind::LineStart:       return prev < 0 || prev == '\n';
+        case AssertKind::LineEnd:         return next < 0 || next == '\n';
+        case AssertKind::WordBoundary:    return isWordByte(prev) != isWordByte(next);
+        case AssertKind::NotWordBoundary: return isWordByte(prev) == isWordByte(next);
+    }
+    return false;
+}
+
+// One pattern compiled forward (leftmost-first, with captures, run by the Pike VM and the
+// forward DFA) or reversed (no captures, run backwards from a match end by a longest-match
+// DFA to find where the match starts). A reversed automaton reads the text right to left,
+// so "prev" is the byte to the right of a position and ^ and $ trade places.
+// Ileri (en soldaki-ilk, yakalamali, Pike VM ve ileri DFA tarafindan calistirilir) veya ters
+// (yakalamasiz, eslemenin nerede basladigini bulmak icin en uzun esleme DFA'si tarafindan bir
+// esleme sonundan geriye calistirilir) derlenmis tek bir kalip. Ters otomat metni sagdan sola
+// okur, bu yuzden "prev" bir konumun sagindaki bayttir ve ^ ile $ yer degistirir.
+struct Automaton {
+    // Context of the byte already read, kept in every DFA state
+    // Her DFA durumunda tutulan, zaten okunmus baytin baglami
+    enum : uint8_t { kCtxLineStart = 0, kCtxWord = 1, kCtxOther = 2, kMatchFlag = 4 };
+    static constexpr int kDead = 0;
+    static constexpr size_t kDfaBudget = 2 << 20;  // Bytes of cached states and transitions / Onbellekteki durum ve gecislerin baytlari
+    static constexpr int kMaxCacheResets = 8;      // Per scan, before the caller falls back to the Pike VM / Tarama basina, cagiran Pike VM'e donmeden once
+
+    bool reversed = false;
+    std::vector<Inst> insts;
+    std::vector<std::array<uint64_t, 4>> byteSets;
+    int entry = 0;             // Where the DFA starts / DFA'nin basladigi yer
+
+    bool lineAsserts = false;
+    bool wordAsserts = false;
+    uint8_t byteClass[256] = {};
+    std::vector<int> classFirst;  // A representative byte per class / Sinif basina temsilci bayt
+    int stride = 1;               // Classes plus end of text / Siniflar arti metin sonu
+
+    // DFA state i is keys[i] = context byte + ordered NFA pcs
+    // DFA durumu i, keys[i] = baglam bayti + sirali NFA pc'leri
+    std::vector<std::string> keys;
+    std::vector<int32_t> trans;   // states * stride, -1 unknown / -1 bilinmiyor
+    std::unordered_map<std::string, int> ids;
+    int startIds[3] = {-1, -1, -1};
+    size_t memory = 0;
+    int resets = 0;
+    SparseSet seen, nextSeen;
+    std::vector<int> stack, next;
+
+    // ---- Compilation ----
+
+    struct Frag {
+        int start;
+        std::vector<int> holes;  // pc * 2 + (0: out, 1: out1) / pc * 2 + (0: out, 1: out1)
+    };
+
+    int emit(Inst inst) {
+        if (insts.size() >= LinearRegexEngine::kMaxInstructions) throw PatternError{"pattern too large"};
+        insts.push_back(inst);
+        return static_cast<int>(insts.size()) - 1;
+    }
+
+    void patch(const std::vector<int>& holes, int target) {
+        for (int h : holes) (h & 1 ? insts[h >> 1].out1 : insts[h >> 1].out) = target;
+    }
+
+    Frag emitBytes(const std::array<uint64_t, 4>& bits) {
+        int first = -1, last = -1, count = 0;
+        for (int b = 0; b < 256; ++b) {
+            if (!(bits[b >> 6] >> (b & 63) & 1)) continue;
+            if (first < 0) first = b;
+            last = b;
+            ++count;
+        }
+        int pc;
+        if (count > 0 && last - first + 1 == count) {
+            pc = emit({Op::ByteRange, static_cast<uint8_t>(first), static_cast<uint8_t>(last)});
+        } else {
+            byteSets.push_back(bits);
+            pc = emit({Op::ByteSet});
+            insts[pc].arg = static_cast<int>(byteSets.size()) - 1;
+        }
+        return {pc, {pc * 2}};
+    }
+
+    // Alternatives in priority order joined by a chain of splits
+    // Oncelik sirasindaki alternatifler bir split zinciriyle birlestirilir
+    Frag alternate(std::vector<Frag>& alts) {
+        if (alts.size() == 1) return std::move(alts[0]);
+        Frag result{-1, {}};
+        int prev = -1;
+        for (size_t i = 0; i < alts.size(); ++i) {
+            int target = alts[i].start;
+            if (i + 1 < alts.size()) {
+                int split = emit({Op::Split});
+                insts[split].out = target;
+                target = split;
+            }
+            if (prev < 0) result.start = target;
+            else insts[prev].out1 = target;
+            prev = target;
+            result.holes.insert(result.holes.end(), alts[i].holes.begin(), alts[i].holes.end());
+        }
+        return result;
+    }
+
+    // ASCII bytes first (cheapest and most common), then multi-byte sequences, then stray
+    // bytes last so that a valid character is always preferred over one of its bytes
+    // Once ASCII baytlar (en ucuz ve en yaygin), sonra cok baytli diziler, en son basibos
+    // baytlar; boylece gecerli bir karakter her zaman baytlarindan birine tercih edilir
+    Frag emitClass(const CpSet& set, bool strayBytes) {
+        std::array<uint64_t, 4> ascii{};
+        std::vector<Utf8Sequence> seqs;
+        for (const auto& r : set) {
+            for (uint32_t b = r.lo; b <= std::min<uint32_t>(r.hi, 0x7F); ++b) ascii[b >> 6] |= 1ull << (b & 63);
+            if (r.hi >= 0x80) utf8Sequences(std::max<uint32_t>(r.lo, 0x80), r.hi, seqs);
+        }
+
+        std::vector<Frag> alts;
+        if (ascii[0] | ascii[1]) alts.push_back(emitBytes(ascii));
+        for (const auto& seq : seqs) {
+            int first = -1, prev = -1;
+            for (int i = 0; i < seq.length; ++i) {
+                int k = reversed ? seq.length - 1 - i : i;
+                int pc = emit({Op::ByteRange, seq.lo[k], seq.hi[k]});
+                if (prev < 0) first = pc;
+                else insts[prev].out = pc;
+                prev = pc;
+            }
+            alts.push_back({first, {prev * 2}});
+        }
+        if (strayBytes) alts.push_back(emitBytes({0, 0, ~0ull, ~0ull}));
+        if (alts.empty()) alts.push_back(emitBytes({}));  // Matches nothing / Hicbir seye uymaz
+        return alternate(alts);
+    }
+
+    Frag emitEmpty() {
+        int pc = emit({Op::Jump});
+        return {pc, {pc * 2}};
+    }
+
+    Frag emitNode(const Node& n) {
+        switch (n.kind) {
+            case Node::Class:
+                return emitClass(n.set, n.strayBytes);
+            case Node::Concat: {
+                if (n.children.empty()) return emitEmpty();
+                const size_t count = n.children.size();
+                Frag f = emitNode(*n.children[reversed ? count - 1 : 0]);
+                for (size_t i = 1; i < count; ++i) {
+                    Frag g = emitNode(*n.children[reversed ? count - 1 - i : i]);
+                    patch(f.holes, g.start);
+                    f.holes = std::move(g.holes);
+                }
+                return f;
+            }
+            case Node::Alternate: {
+                std::vector<Frag> alts;
+                for (const auto& c : n.children) alts.push_back(emitNode(*c));
+                return alternate(alts);
+            }
+            case Node::Group: {
+                if (n.capture < 0 || reversed) return emitNode(*n.children[0]);
+                int open = emit({Op::Save});
+                insts[open].arg = 2 * n.capture;
+                Frag body = emitNode(*n.children[0]);
+                insts[open].out = body.start;
+                int close = emit({Op::Save});
+                insts[close].arg = 2 * n.capture + 1;
+                patch(body.holes, close);
+                return {open, {close * 2}};
+            }
+            case Node::Assert: {
+                AssertKind kind = n.assertion;
+                if (reversed && kind == AssertKind::LineStart) kind = AssertKind::LineEnd;
+                else if (reversed && kind == AssertKind::LineEnd) kind = AssertKind::LineStart;
+                int pc = emit({Op::Assert});
+                insts[pc].arg = static_cast<int>(kind);
+                return {pc, {pc * 2}};
+            }
+            case Node::Repeat:
+                return emitRepeat(n);
+        }
+        return emitEmpty();
+    }
+
+    // x{n,m} is n copies followed by nested optional ones, x{n,} loops on its last copy
+    // x{n,m} n kopya ve ardindan ic ice istege bagli kopyalardir, x{n,} son kopyasinda doner
+    Frag emitRepeat(const Node& n) {
+        const Node& x = *n.children[0];
+        Frag f{-1, {}};
+        auto append = [&](Frag g) {
+            if (f.start < 0) {
+                f = std::move(g);
+            } else {
+                patch(f.holes, g.start);
+                f.holes = std::move(g.holes);
+            }
+        };
+        auto loopOrSkip = [&](int split, int body) -> int {
+            if (n.greedy) {
+                insts[split].out = body;
+                return split * 2 + 1;
+            }
+            insts[split].out1 = body;
+            return split * 2;
+        };
+
+        if (n.max == -1) {
+            for (int i = 0; i + 1 < n.min; ++i) append(emitNode(x));
+            if (n.min > 0) {
+                Frag g = emitNode(x);
+                int split = emit({Op::Split});
+                patch(g.holes, split);
+                append({g.start, {loopOrSkip(split, g.start)}});
+            } else {
+                int split = emit({Op::Split});
+                Frag g = emitNode(x);
+                patch(g.holes, split);
+                append({split, {loopOrSkip(split, g.start)}});
+            }
+            return f;
+        }
+
+        for (int i = 0; i < n.min; ++i) append(emitNode(x));
+        std::vector<int> exits;
+        for (int i = n.min; i < n.max; ++i) {
+            int split = emit({Op::Split});
+            Frag g = emitNode(x);
+            exits.push_back(loopOrSkip(split, g.start));
+            append({split, {}});
+            f.holes = std::move(g.holes);
+        }
+        if (f.start < 0) return emitEmpty();
+        f.holes.insert(f.holes.end(), exits.begin(), exits.end());
+        return f;
+    }
+
+    // Bytes no instruction tells apart share a class; '\n' and word bytes stay apart when an
+    // assertion looks at them
+    // Hicbir talimatin ayirt etmedigi baytlar bir sinifi paylasir; bir onay onlara baktiginda
+    // '\n' ve sozcuk baytlari ayri kalir
+    void buildByteClasses() {
+        std::array<bool, 257> edge{};
+        auto mark = [&](int lo, int hi) {
+            edge[lo] = true;
+            edge[hi + 1] = true;
+        };
+        for (const auto& in : insts) {
+            if (in.op == Op::ByteRange) mark(in.lo, in.hi);
+            if (in.op == Op::Assert) {
+                auto kind = static_cast<AssertKind>(in.arg);
+                if (kind == AssertKind::LineStart || kind == AssertKind::LineEnd) lineAsserts = true;
+                else wordAsserts = true;
+            }
+        }
+        for (const auto& bits : byteSets) {
+            for (int b = 1; b < 256; ++b) {
+                bool prev = bits[(b - 1) >> 6] >> ((b - 1) & 63) & 1;
+                bool cur = bits[b >> 6] >> (b & 63) & 1;
+                if (prev != cur) edge[b] = true;
+            }
+        }
+        if (lineAsserts) mark('\n', '\n');
+        if (wordAsserts) {
+            mark('0', '9');
+            mark('A', 'Z');
+            mark('_', '_');
+            mark('a', 'z');
+        }
+        int cls = 0;
+        classFirst.push_back(0);
+        for (int b = 0; b < 256; ++b) {
+            if (b > 0 && edge[b]) {
+                ++cls;
+                classFirst.push_back(b);
+            }
+            byteClass[b] = static_cast<uint8_t>(cls);
+        }
+        stride = cls + 2;
+        seen.init(insts.size(), 0);
+        nextSeen.init(insts.size(), 0);
+    }
+
+    // ---- Lazy DFA ----
+
+    bool accepts(const Inst& in, uint8_t b) const {
+        if (in.op == Op::ByteRange) return b >= in.lo && b <= in.hi;
+        if (in.op == Op::ByteSet) return byteSets[in.arg][b >> 6] >> (b & 63) & 1;
+        return false;
+    }
+
+    uint8_t contextOf(int prev) const {
+        if (lineAsserts && (prev < 0 || prev == '\n')) return kCtxLineStart;
+        if (wordAsserts && isWordByte(prev)) return kCtxWord;
+        return (lineAsserts || wordAsserts) ? kCtxOther : kCtxLineStart;
+    }
+
+    // A byte standing for a context when assertions are checked inside the DFA
+    // DFA icinde onaylar denetlenirken bir baglami temsil eden bayt
+    static int contextByte(uint8_t ctx) {
+        return ctx == kCtxLineStart ? -1 : ctx == kCtxWord ? 'a' : ' ';
+    }
+
+    void resetDfa() {
+        keys.assign(1, std::string());
+        trans.assign(stride, kDead);
+        ids.clear();
+        std::fill(std::begin(startIds), std::end(startIds), -1);
+        memory = stride * sizeof(int32_t);
+    }
+
+    int intern(uint8_t flags, const std::vector<int>& pcs) {
+        if (pcs.empty() && !(flags & kMatchFlag)) return kDead;
+        std::string key(1 + pcs.size() * sizeof(int), '\0');
+        key[0] = static_cast<char>(flags);
+        if (!pcs.empty()) std::memcpy(key.data() + 1, pcs.data(), pcs.size() * sizeof(int));
+        auto it = ids.find(key);
+        if (it != ids.end()) return it->second;
+        int id = static_cast<int>(keys.size());
+        memory += 2 * key.size() + stride * sizeof(int32_t) + 64;
+        ids.emplace(key, id);
+        keys.push_back(std::move(key));
+        trans.resize(trans.size() + stride, -1);
+        return id;
+    }
+
+    // Step state s over one byte class: follow empty transitions in priority order with the
+    // bytes on both sides known, then move the threads that accept the byte. Leftmost-first
+    // stops at the first Match, since lower-priority threads can no longer win; the reversed
+    // automaton looks for the longest match and keeps every thread.
+    // s durumunu bir bayt sinifi uzerinden ilerlet: her iki yandaki baytlar bilinerek bos
+    // gecisleri oncelik sirasiyla izle, sonra bayti kabul eden thread'leri ilerlet. En soldaki-
+    // ilk, ilk Match'te durur cunku daha dusuk oncelikli thread'ler artik kazanamaz; ters otomat
+    // en uzun eslemeyi arar ve her thread'i tutar.
+    // Returns -1 when the cache keeps overflowing and the scan should be abandoned.
+    // Onbellek tasmaya devam ederse ve tarama birakilmaliysa -1 dondurur.
+    int transition(int s, int cls) {
+        if (memory > kDfaBudget) {
+            if (++resets > kMaxCacheResets) return -1;
+            std::string key = keys[s];
+            resetDfa();
+            std::vector<int> pcs((key.size() - 1) / sizeof(int));
+            if (!pcs.empty()) std::memcpy(pcs.data(), key.data() + 1, key.size() - 1);
+            s = intern(static_cast<uint8_t>(key[0]), pcs);
+        }
+
+        const std::string& key = keys[s];
+        const int count = static_cast<int>((key.size() - 1) / sizeof(int));
+        const int prev = contextByte(static_cast<uint8_t>(key[0]) & 3);
+        const bool eot = cls == stride - 1;
+        const int nextByte = eot ? -1 : classFirst[cls];
+
+        seen.size = 0;
+        nextSeen.size = 0;
+        next.clear();
+        bool matched = false;
+        for (int i = 0; i < count && !(matched && !reversed); ++i) {
+            int pc0;
+            std::memcpy(&pc0, key.data() + 1 + i * sizeof(int), sizeof(int));
+            stack.clear();
+            stack.push_back(pc0);
+            while (!stack.empty()) {
+                int pc = stack.back();
+                stack.pop_back();
+                if (seen.contains(pc)) continue;
+                seen.insert(pc);
+                const Inst& in = insts[pc];
+                switch (in.op) {
+                    case Op::Jump:
+                    case Op::Save:
+                        stack.push_back(in.out);
+                        break;
+                    case Op::Split:
+                        stack.push_back(in.out1);
+                        stack.push_back(in.out);
+                        break;
+                    case Op::Assert:
+                        if (holds(static_cast<AssertKind>(in.arg), prev, nextByte)) stack.push_back(in.out);
+                        break;
+                    case Op::Match:
+                        matched = true;
+                        if (!reversed) stack.clear();
+                        break;
+                    default:
+                        if (!eot && accepts(in, static_cast<uint8_t>(nextByte)) && !nextSeen.contains(in.out)) {
+                            nextSeen.insert(in.out);
+                            next.push_back(in.out);
+                        }
+                        break;
+                }
+            }
+        }
+
+        uint8_t flags = (eot ? 0 : contextOf(nextByte)) | (matched ? kMatchFlag : 0);
+        int t = intern(flags, next);
+        trans[s * stride + cls] = t;
+        return t;
+    }
+
+    int startState(int prev) {
+        if (keys.empty()) resetDfa();
+        uint8_t ctx = contextOf(prev);
+        if (startIds[ctx] < 0) startIds[ctx] = intern(ctx, {entry});
+        return startIds[ctx];
+    }
+
+    // Forward: end of the leftmost-first match starting at or after `at`, -1 if none, -2 if
+    // the DFA gave up
+    // Ileri: `at`'ta veya sonrasinda baslayan en soldaki-ilk eslemenin sonu, yoksa -1, DFA
+    // vazgectiyse -2
+    int scanForward(std::string_view text, size_t at) {
+        resets = 0;
+        const auto* p = reinterpret_cast<const uint8_t*>(text.data());
+        const size_t n = text.size();
+        int s = startState(at == 0 ? -1 : p[at - 1]);
+        int lastEnd = -1;
+        for (size_t i = at; i < n; ++i) {
+            int t = trans[s * stride + byteClass[p[i]]];
+            if (t < 0 && (t = transition(s, byteClass[p[i]])) < 0) return -2;
+            s = t;
+            if (s == kDead) return lastEnd;
+            if (keys[s][0] & kMatchFlag) lastEnd = static_cast<int>(i);
+        }
+        int t = trans[s * stride + stride - 1];
+        if (t < 0 && (t = transition(s, stride - 1)) < 0) return -2;
+        if (t != kDead && (keys[t][0] & kMatchFlag)) lastEnd = static_cast<int>(n);
+        return lastEnd;
+    }
+
+    // Reversed: smallest start >= from of a match that ends at `end`, -1 if none, -2 if the
+    // DFA gave up
+    // Ters: `end`'de biten bir eslemenin from'dan buyuk veya esit en kucuk baslangici, yoksa
+    // -1, DFA vazgectiyse -2
+    int scanReverse(std::string_view text, size_t end, size_t from) {
+        resets = 0;
+        const auto* p = reinterpret_cast<const uint8_t*>(text.data());
+        int s = startState(end == text.size() ? -1 : p[end]);
+        int lastStart = -1;
+        for (size_t i = end; i > from; --i) {
+            int t = trans[s * stride + byteClass[p[i - 1]]];
+            if (t < 0 && (t = transition(s, byteClass[p[i - 1]])) < 0) return -2;
+            s = t;
+            if (s == kDead) return lastStart;
+            if (keys[s][0] & kMatchFlag) lastStart = static_cast<int>(i);
+        }
+        // A match starting at `from` shows up one step further, on the byte before it
+        // `from`'da baslayan bir esleme bir adim otede, ondan onceki baytta gorunur
+        int cls = from == 0 ? stride - 1 : byteClass[p[from - 1]];
+        int t = trans[s * stride + cls];
+        if (t < 0 && (t = transition(s, cls)) < 0) return -2;
+        if (t != kDead && (keys[t][0] & kMatchFlag)) lastStart = static_cast<int>(from);
+        return lastStart;
+    }
+};
+
+} // namespace
+
+// ========================================================================
+// Program: both automata, the prefilter and the Pike VM
+// Program: iki otomat, on filtre ve Pike VM
+// ========================================================================
+
+struct LinearRegexEngine::Program {
+    Automaton forward;         // Save 0, body, Save 1, Match; DFA entry is a lazy any-byte loop in front / DFA girisi onunde tembel bir her-bayt dongusu
+    Automaton reverse;         // Body reversed, Match / Ters govde, Match
+    int start = 0;             // Pike VM entry in forward / forward'daki Pike VM girisi
+    int captures = 1;          // Groups including the whole match / Tum esleme dahil gruplar
+
+    std::string literal;       // The whole pattern when it is a plain string / Duz bir dize oldugunda tum kalip
+    bool pureLiteral = false;
+    std::string prefix;        // Every match starts with this / Her esleme bununla baslar
+    std::string required;      // Every match contains this / Her esleme bunu icerir
+
+    // Search state shared by all searches on this program
+    // Bu programdaki tum aramalarin paylastigi arama durumu
+    struct Frame {
+        int pc;
+        int slot;   // >= 0: restore slots[slot] = value / >= 0: slots[slot] = value geri yukle
+        int value;
+    };
+    std::mutex mutex;
+    SparseSet clist, nlist;
+    int nslots = -1;
+    std::vector<Frame> frames;
+    std::vector<int> scratch;
+
+    void compile(const Node& root, int groups) {
+        captures = groups + 1;
+
+        Automaton::Frag body = forward.emitNode(root);
+        start = forward.emit({Op::Save});
+        forward.insts[start].out = body.start;
+        int close = forward.emit({Op::Save});
+        forward.insts[close].arg = 1;
+        forward.patch(body.holes, close);
+        forward.insts[close].out = forward.emit({Op::Match});
+        forward.entry = forward.emit({Op::Split});
+        int any = forward.emit({Op::ByteRange, 0x00, 0xFF});
+        forward.insts[forward.entry].out = start;
+        forward.insts[forward.entry].out1 = any;
+        forward.insts[any].out = forward.entry;
+        forward.buildByteClasses();
+
+        reverse.reversed = true;
+        Automaton::Frag rbody = reverse.emitNode(root);
+        reverse.patch(rbody.holes, reverse.emit({Op::Match}));
+        reverse.entry = rbody.start;
+        reverse.buildByteClasses();
+
+        analyzeLiterals(root);
+    }
+
+    static bool singleCodepoint(const Node& n, uint32_t& cp) {
+        if (n.kind != Node::Class || n.strayBytes || n.set.size() != 1 || n.set[0].lo != n.set[0].hi) return false;
+        cp = n.set[0].lo;
+        return true;
+    }
+
+    // Literal runs in the top-level concatenation: the first one (if the pattern starts with
+    // it) is the prefix, the longest one is required
+    // Ust seviye birlestirmedeki literal diziler: ilki (kalip onunla basliyorsa) onek, en
+    // uzunu gereklidir
+    void analyzeLiterals(const Node& root) {
+        const Node* top = &root;
+        while (top->kind == Node::Group && top->capture < 0) top = top->children[0].get();
+
+        std::vector<const Node*> items;
+        if (top->kind == Node::Concat) {
+            for (const auto& c : top->children) items.push_back(c.get());
+        } else {
+            items.push_back(top);
+        }
+
+        std::string run;
+        bool leading = true;
+        bool all = true;
+        auto flush = [&]() {
+            if (leading) prefix = run;
+            if (run.size() > required.size()) required = run;
+            run.clear();
+            leading = false;
+        };
+        for (const Node* item : items) {
+            uint32_t cp;
+            if (singleCodepoint(*item, cp)) {
+                appendUTF8(cp, run);
+            } else {
+                all = false;
+                flush();
+            }
+        }
+        flush();
+        if (all && captures == 1) {
+            pureLiteral = true;
+            literal = prefix;
+        }
+    }
+
+    // ---- Pike VM ----
+
+    // Add pc and everything reachable from it without consuming a byte; Save writes the slot
+    // for the subtree below it and restores it afterwards
+    // pc'yi ve ondan bayt tuketmeden ulasilabilen her seyi ekle; Save yuvayi altindaki alt
+    // agac icin yazar ve sonra geri yukler
+    void addThread(SparseSet& list, int pc0, size_t at, std::string_view text) {
+        const auto& insts = forward.insts;
+        int* slots = scratch.data();
+        const int prev = at == 0 ? -1 : static_cast<uint8_t>(text[at - 1]);
+        const int next = at >= text.size() ? -1 : static_cast<uint8_t>(text[at]);
+        frames.push_back({pc0, -1, 0});
+        while (!frames.empty()) {
+            Frame f = frames.back();
+            frames.pop_back();
+            if (f.slot >= 0) {
+                slots[f.slot] = f.value;
+                continue;
+            }
+            int pc = f.pc;
+            while (!list.contains(pc)) {
+                list.insert(pc);
+                const Inst& in = insts[pc];
+                if (in.op == Op::Jump) {
+                    pc = in.out;
+                } else if (in.op == Op::Split) {
+                    frames.push_back({in.out1, -1, 0});
+                    pc = in.out;
+                } else if (in.op == Op::Save) {
+                    if (in.arg < nslots) {
+                        frames.push_back({0, in.arg, slots[in.arg]});
+                        slots[in.arg] = static_cast<int>(at);
+                    }
+                    pc = in.out;
+                } else if (in.op == Op::Assert) {
+                    if (!holds(static_cast<AssertKind>(in.arg), prev, next)) break;
+                    pc = in.out;
+                } else {
+                    std::copy(slots, slots + nslots, list.slots.begin() + static_cast<size_t>(pc) * nslots);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Threads run in priority order and the first to reach Match cuts off the ones behind
+    // it (leftmost-first). The match is known to start at `from`, so only one thread is
+    // started.
+    // Thread'ler oncelik sirasiyla calisir ve Match'e ilk ulasan arkasindakileri keser (en
+    // soldaki-ilk). Eslemenin `from`'da basladigi bilinir, bu yuzden tek bir thread baslatilir.
+    bool pikeSearch(std::string_view text, size_t from, bool anchored, int* out) {
+        SparseSet* cur = &clist;
+        SparseSet* nxt = &nlist;
+        cur->size = 0;
+
+        const auto* p = reinterpret_cast<const uint8_t*>(text.data());
+        const size_t n = text.size();
+        bool matched = false;
+        for (size_t at = from;; ++at) {
+            if (!matched && (at == from || !anchored)) {
+                std::fill(scratch.begin(), scratch.end(), -1);
+                addThread(*cur, start, at, text);
+            }
+            if (cur->size == 0) break;
+
+            nxt->size = 0;
+            for (int k = 0; k < cur->size; ++k) {
+                int pc = cur->dense[k];
+                const Inst& in = forward.insts[pc];
+                const int* slots = cur->slots.data() + static_cast<size_t>(pc) * nslots;
+                if (in.op == Op::Match) {
+                    std::copy(slots, slots + nslots, out);
+                    matched = true;
+                    break;
+                }
+                if (at < n && forward.accepts(in, p[at])) {
+                    std::copy(slots, slots + nslots, scratch.begin());
+                    addThread(*nxt, in.out, at + 1, text);
+                }
+            }
+            std::swap(cur, nxt);
+            if (at >= n) break;
+        }
+        return matched;
+    }
+
+    // Leftmost-first match at or after offset into slots[0, count): the forward DFA finds
+    // where it ends, the reversed DFA where it starts, and the Pike VM runs over just the
+    // match when groups are asked for (or over the rest of the text if a DFA gave up)
+    // Ofsette veya sonrasinda en soldaki-ilk esleme slots[0, count) icine: ileri DFA nerede
+    // bittigini, ters DFA nerede basladigini bulur ve gruplar istendiginde Pike VM yalnizca
+    // esleme uzerinde calisir (bir DFA vazgectiyse metnin geri kalaninda)
+    bool search(std::string_view text, size_t offset, int count, int* slots) {
+        if (offset > text.size()) return false;
+        if (pureLiteral) {
+            size_t pos = text.find(literal, offset);
+            if (pos == std::string_view::npos) return false;
+            slots[0] = static_cast<int>(pos);
+            slots[1] = static_cast<int>(pos + literal.size());
+            return true;
+        }
+        if (!required.empty() && text.find(required, offset) == std::string_view::npos) return false;
+        size_t from = offset;
+        if (!prefix.empty()) {
+            from = text.find(prefix, offset);
+            if (from == std::string_view::npos) return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        int end = forward.scanForward(text, from);
+        if (end == -1) return false;
+        int begin = end >= 0 ? reverse.scanReverse(text, end, from) : -2;
+        if (begin >= 0 && count == 2) {
+            slots[0] = begin;
+            slots[1] = end;
+            return true;
+        }
+
+        if (nslots != count || clist.dense.size() != forward.insts.size()) {
+            clist.init(forward.insts.size(), count);
+            nlist.init(forward.insts.size(), count);
+            scratch.assign(count, -1);
+            nslots = count;
+        }
+        std::fill(slots, slots + count, -1);
+        return begin >= 0 ? pikeSearch(text, begin, true, slots) : pikeSearch(text, from, false, slots);
+    }
+};
+
+// ========================================================================
+// LinearRegexEngine
+// ========================================================================
+
+// Parse, then build both NFAs; on any error the engine is left invalid with the message kept
+// Ayristir, sonra iki NFA'yi kur; herhangi bir hatada motor mesaj saklanarak gecersiz birakilir
+bool LinearRegexEngine::compile(const std::string& pattern, bool caseSensitive) {
+    prog_.reset();
+    error_.clear();
+    try {
+        Parser parser(pattern, !caseSensitive);
+        NodePtr root = parser.parse();
+        auto prog = std::make_shared<Program>();
+        prog->compile(*root, parser.groups());
+        prog_ = std::move(prog);
+        return true;
+    } catch (const PatternError& e) {
+        error_ = e.message;
+        return false;
+    }
+}
+
+// True once a pattern compiled
+// Bir kalip derlendiginde true
+bool LinearRegexEngine::isValid() const {
+    return prog_ != nullptr;
+}
+
+// Leftmost-first match at or after offset, with every capture group copied out
+// offset'te veya sonrasinda en soldaki-ilk esleme, tum yakalama gruplari kopyalanarak
+bool LinearRegexEngine::search(std::string_view text, int offset, RegexMatch& match) const {
+    if (!prog_ || offset < 0) return false;
+    std::vector<int> slots(2 * prog_->captures, -1);
+    if (!prog_->search(text, static_cast<size_t>(offset), static_cast<int>(slots.size()), slots.data())) return false;
+
+    match.position = slots[0];
+    match.length = slots[1] - slots[0];
+    match.groups.assign(prog_->captures, std::string());
+    for (int g = 0; g < prog_->captures; ++g) {
+        if (slots[2 * g] >= 0 && slots[2 * g + 1] >= slots[2 * g]) {
+            match.groups[g].assign(text.substr(slots[2 * g], slots[2 * g + 1] - slots[2 * g]));
+        }
+    }
+    return true;
+}
+
+// Bounds only: two slots, so the Pike VM never runs and nothing is allocated
+// Yalnizca sinirlar: iki yuva, boylece Pike VM hic calismaz ve hicbir sey ayrilmaz
+bool LinearRegexEngine::find(std::string_view text, int offset, int& position, int& length) const {
+    if (!prog_ || offset < 0) return false;
+    int slots[2] = {-1, -1};
+    if (!prog_->search(text, static_cast<size_t>(offset), 2, slots)) return false;
+    position = slots[0];
+    length = slots[1] - slots[0];
+    return true;
+}
+
+// After an empty match the next search starts one character (not one byte) further
+// Bos bir eslemeden sonra sonraki arama bir bayt degil bir karakter ileride baslar
+std::vector<RegexMatch> LinearRegexEngine::searchAll(std::string_view text) const {
+    std::vector<RegexMatch> results;
+    int offset = 0;
+    RegexMatch m;
+    while (offset <= static_cast<int>(text.size()) && search(text, offset, m)) {
+        results.push_back(m);
+        offset = m.position + m.length;
+        if (m.length == 0) {
+            ++offset;
+            while (offset < static_cast<int>(text.size()) && (static_cast<uint8_t>(text[offset]) & 0xC0) == 0x80) ++offset;
+        }
+    }
+    return results;
+}
+
+// Expand the template for the first match only
+// Sablonu yalnizca ilk esleme icin genislet
+std::string LinearRegexEngine::replaceFirst(std::string_view text, const std::string& replacement) const {
+    RegexMatch m;
+    if (!search(text, 0, m)) return std::string(text);
+    std::string out(text.substr(0, m.position));
+    ReplaceTemplate(replacement).expand(text, m, out);
+    out.append(text.substr(m.position + m.length));
+    return out;
+}
+
+// The template is parsed once and expanded per match, copying the text between matches
+// Sablon bir kez ayristirilir ve her esleme icin genisletilir; eslemeler arasi metin kopyalanir
+std::string LinearRegexEngine::replaceAll(std::string_view text, const std::string& replacement) const {
+    const ReplaceTemplate tmpl(replacement);
+    std::string out;
+    size_t copied = 0;
+    for (const auto& m : searchAll(text)) {
+        out.append(text.substr(copied, m.position - copied));
+        tmpl.expand(text, m, out);
+        copied = m.position + m.length;
+    }
+    out.append(text.substr(copied));
+    return out;
+}
+
+// Message of the last failed compile, with the offset it stopped at
+// Son basarisiz derlemenin mesaji, durdugu ofsetle birlikte
+std::string LinearRegexEngine::lastError() const {
+    return error_;
+}
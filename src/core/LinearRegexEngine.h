@@ -0,0 +1,59 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include "RegexEngine.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Regex engine whose running time is linear in the text for every pattern (no backtracking).
+// Her kalip icin calisma suresi metinde dogrusal olan regex motoru (geri izleme yok).
+// Patterns compile to byte-level NFAs, one forward and one reversed. A search first rules
+// lines out with a required literal, then a lazy DFA (states built on demand, cache bounded)
+// finds where the leftmost-first match ends and a second one running backwards from there
+// finds where it starts. The Pike VM only runs over the match itself when capture groups are
+// asked for. Every scan is O(text) for a given pattern.
+// Kaliplar biri ileri biri ters iki bayt seviyesi NFA'ya derlenir. Arama once satirlari gerekli
+// bir literal ile eler, sonra tembel bir DFA (durumlar istege gore kurulur, onbellek sinirli)
+// en soldaki-ilk eslemenin nerede bittigini, oradan geriye calisan ikinci bir DFA da nerede
+// basladigini bulur. Pike VM yalnizca yakalama gruplari istendiginde ve yalnizca eslemenin
+// kendisi uzerinde calisir. Her tarama verilen bir kalip icin O(metin)'dir.
+// Syntax is ECMAScript without backreferences and lookaround: classes (with POSIX [:alpha:]
+// and friends inside brackets, as std::regex takes them), \d \w \s, ^ and $ (at line
+// boundaries), \b, groups (also (?:...) and (?<name>...)), greedy and lazy quantifiers. Text
+// is UTF-8: '.' and negated classes consume whole characters, and case folding covers Latin,
+// Greek (final sigma included) and Cyrillic letters.
+// Sozdizimi geri referans ve cevreye bakma olmadan ECMAScript'tir: siniflar (koseli
+// parantez icinde std::regex'in aldigi gibi POSIX [:alpha:] ve benzerleriyle), \d \w \s, ^
+// ve $ (satir sinirlarinda), \b, gruplar ((?:...) ve (?<ad>...) dahil), acgozlu ve tembel
+// niceleyiciler. Metin UTF-8'dir: '.' ve olumsuz siniflar tum karakterleri tuketir, harf
+// katlama Latin, Yunan (son sigma dahil) ve Kiril harflerini kapsar.
+// Searches are safe from several threads; they share the DFA cache under a lock.
+// Aramalar birden cok thread'den guvenlidir; DFA onbellegini bir kilit altinda paylasirlar.
+class LinearRegexEngine : public RegexEngine {
+public:
+    // Compiled programs larger than this are rejected ("(a{1000}){1000}"); a quantifier
+    // directly on another ("a{1000}{1000}", "a**") is a syntax error
+    // Bundan buyuk derlenmis programlar reddedilir ("(a{1000}){1000}"); dogrudan baska
+    // birine uygulanan bir niceleyici ("a{1000}{1000}", "a**") sozdizimi hatasidir
+    static constexpr size_t kMaxInstructions = 50000;
+
+    LinearRegexEngine() = default;
+
+    bool compile(const std::string& pattern, bool caseSensitive = true) override;
+    bool isValid() const override;
+    bool search(std::string_view text, int offset, RegexMatch& match) const override;
+    bool find(std::string_view text, int offset, int& position, int& length) const override;
+    std::vector<RegexMatch> searchAll(std::string_view text) const override;
+    std::string replaceFirst(std::string_view text, const std::string& replacement) const override;
+    std::string replaceAll(std::string_view text, const std::string& replacement) const override;
+    std::string lastError() const override;
+
+private:
+    struct Program;
+    std::shared_ptr<Program> prog_;
+    std::string error_;
+};
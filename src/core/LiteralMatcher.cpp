@@ -0,0 +1,243 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "LiteralMatcher.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define BERKIDE_LITERAL_SSE2 1
+    #endif
+    // AVX2 is compiled per function and picked at runtime on GCC/Clang; MSVC needs /arch:AVX2
+    // AVX2 GCC/Clang'da fonksiyon bazinda derlenir ve calisma zamaninda secilir; MSVC /arch:AVX2 ister
+    #if defined(__GNUC__) || defined(__clang__)
+        #define BERKIDE_LITERAL_AVX2 1
+        #define BERKIDE_TARGET_AVX2 __attribute__((target("avx2")))
+    #elif defined(__AVX2__)
+        #define BERKIDE_LITERAL_AVX2 1
+        #define BERKIDE_TARGET_AVX2
+    #endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace {
+
+// ASCII letter, either case
+// Herhangi bir durumda ASCII harf
+inline bool isAsciiLetter(uint8_t c) {
+    return (c | 0x20) >= 'a' && (c | 0x20) <= 'z';
+}
+
+// Lowercase an ASCII letter, leave every other byte alone
+// Bir ASCII harfini kucult, diger her bayti oldugu gibi birak
+inline uint8_t foldAscii(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c | 0x20) : c;
+}
+
+// Word bytes as the search engine's whole-word option sees them: [0-9A-Za-z_]
+// Arama motorunun tam sozcuk seceneginin gordugu sozcuk baytlari: [0-9A-Za-z_]
+inline bool isWordByte(uint8_t c) {
+    return (c >= '0' && c <= '9') || isAsciiLetter(c) || c == '_';
+}
+
+// Whole-word rule of the search engine: pos falls between a word and a non-word byte (or at
+// an end of the text)
+// Arama motorunun tam sozcuk kurali: pos bir sozcuk ve sozcuk olmayan bayt arasinda (veya
+// metnin bir ucunda)
+inline bool isBoundary(std::string_view text, size_t pos) {
+    if (pos == 0 || pos >= text.size()) return true;
+    return isWordByte(static_cast<uint8_t>(text[pos - 1])) != isWordByte(static_cast<uint8_t>(text[pos]));
+}
+
+// Needle bytes at 'at', comparing ASCII letters case-blind when asked (the needle is already folded)
+// 'at'taki baytlar igneye uyuyor mu, istenirse ASCII harfleri harf duyarsiz (igne zaten katlanmis)
+inline bool verify(const char* at, std::string_view needle, bool caseSensitive) {
+    if (caseSensitive) return std::memcmp(at, needle.data(), needle.size()) == 0;
+    for (size_t i = 0; i < needle.size(); ++i) {
+        if (foldAscii(static_cast<uint8_t>(at[i])) != static_cast<uint8_t>(needle[i])) return false;
+    }
+    return true;
+}
+
+// Index of the lowest set bit (mask is never zero here)
+// En dusuk set bitin indeksi (mask burada asla sifir degil)
+[[maybe_unused]] inline unsigned lowestBit(unsigned mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Candidate filter: calls check(pos) for every pos in [from, end) where the byte at pos
+// (ORed with firstOr) equals first and the byte at pos + span (ORed with lastOr) equals
+// last, in increasing order, until check returns true; returns that pos or end
+// Aday filtresi: pos'taki bayt (firstOr ile OR'lanmis) first'e ve pos + span'deki bayt
+// (lastOr ile OR'lanmis) last'a esit oldugu [from, end) icindeki her pos icin artan sirayla,
+// check true dondurene kadar check(pos) cagirir; o pos'u veya end'i dondurur
+struct Filter {
+    const char* data;
+    size_t span;                 // Needle length - 1 / Igne uzunlugu - 1
+    uint8_t first, last, firstOr, lastOr;
+};
+
+// Byte loop for short ranges and CPUs without SSE2
+// Kisa araliklar ve SSE2'siz CPU'lar icin bayt dongusu
+template <typename Check>
+size_t filterScalar(const Filter& f, size_t from, size_t end, Check&& check) {
+    for (size_t i = from; i < end; ++i) {
+        if ((static_cast<uint8_t>(f.data[i]) | f.firstOr) != f.first) continue;
+        if ((static_cast<uint8_t>(f.data[i + f.span]) | f.lastOr) != f.last) continue;
+        if (check(i)) return i;
+    }
+    return end;
+}
+
+#if defined(BERKIDE_LITERAL_SSE2)
+// 16 candidate positions per step; the last partial step reloads the final 16 positions and
+// masks off the ones already seen, so short lines never fall back to the byte loop
+// Adim basina 16 aday konum; son yarim adim son 16 konumu yeniden yukler ve gorulmus olanlari
+// maskeler, boylece kisa satirlar bayt dongusune dusmez
+template <typename Check>
+size_t filterSse2(const Filter& f, size_t from, size_t end, Check&& check) {
+    if (end - from < 16) return filterScalar(f, from, end, check);
+    const __m128i first = _mm_set1_epi8(static_cast<char>(f.first));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(f.last));
+    const __m128i firstOr = _mm_set1_epi8(static_cast<char>(f.firstOr));
+    const __m128i lastOr = _mm_set1_epi8(static_cast<char>(f.lastOr));
+    for (size_t i = from; i < end; i += 16) {
+        size_t base = i + 16 <= end ? i : end - 16;
+        __m128i a = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(f.data + base)), firstOr);
+        __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(f.data + base + f.span)), lastOr);
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+        mask &= ~0u << (i - base);
+        while (mask) {
+            size_t pos = base + lowestBit(mask);
+            if (check(pos)) return pos;
+            mask &= mask - 1;
+        }
+    }
+    return end;
+}
+#endif
+
+#if defined(BERKIDE_LITERAL_AVX2)
+// 32 candidate positions per step with the same overlapping last step; shorter ranges go
+// through the 16-wide kernel
+// Adim basina 32 aday konum, ayni ortusen son adimla; daha kisa araliklar 16'lik cekirdekten gecer
+template <typename Check>
+BERKIDE_TARGET_AVX2 size_t filterAvx2(const Filter& f, size_t from, size_t end, Check&& check) {
+    if (end - from < 32) {
+#if defined(BERKIDE_LITERAL_SSE2)
+        return filterSse2(f, from, end, check);
+#else
+        return filterScalar(f, from, end, check);
+#endif
+    }
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(f.first));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(f.last));
+    const __m256i firstOr = _mm256_set1_epi8(static_cast<char>(f.firstOr));
+    const __m256i lastOr = _mm256_set1_epi8(static_cast<char>(f.lastOr));
+    for (size_t i = from; i < end; i += 32) {
+        size_t base = i + 32 <= end ? i : end - 32;
+        __m256i a = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(f.data + base)), firstOr);
+        __m256i b = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(f.data + base + f.span)), lastOr);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+        mask &= ~0u << (i - base);
+        while (mask) {
+            size_t pos = base + lowestBit(mask);
+            if (check(pos)) return pos;
+            mask &= mask - 1;
+        }
+    }
+    return end;
+}
+#endif
+
+enum class Kernel { Avx2, Sse2, Scalar };
+
+// Pick the widest filter the CPU supports
+// CPU'nun destekledigi en genis filtreyi sec
+Kernel selectKernel() {
+#if defined(BERKIDE_LITERAL_AVX2)
+    #if defined(__GNUC__) || defined(__clang__)
+    if (__builtin_cpu_supports("avx2")) return Kernel::Avx2;
+    #else
+    return Kernel::Avx2;
+    #endif
+#endif
+#if defined(BERKIDE_LITERAL_SSE2)
+    return Kernel::Sse2;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+// Filter chosen once per process, on first use
+// Surec basina bir kez, ilk kullanimda secilen filtre
+Kernel kernel() {
+    static const Kernel k = selectKernel();
+    return k;
+}
+
+} // namespace
+
+// Fold the needle once; the filter's OR masks make 'A' and 'a' compare equal only where the
+// needle has a letter
+// Igneyi bir kez katla; filtrenin OR maskeleri 'A' ile 'a'yi yalnizca ignede harf olan yerde
+// esit kilar
+LiteralMatcher::LiteralMatcher(std::string_view needle, bool caseSensitive, bool wholeWord)
+    : needle_(needle), caseSensitive_(caseSensitive), wholeWord_(wholeWord) {
+    if (needle_.empty() || caseSensitive_) return;
+    for (char& c : needle_) c = static_cast<char>(foldAscii(static_cast<uint8_t>(c)));
+    firstOr_ = isAsciiLetter(static_cast<uint8_t>(needle_.front())) ? 0x20 : 0;
+    lastOr_ = isAsciiLetter(static_cast<uint8_t>(needle_.back())) ? 0x20 : 0;
+}
+
+// Candidates are positions whose last needle byte still lies inside the text
+// Adaylar, son igne baytinin hala metin icinde kaldigi konumlardir
+size_t LiteralMatcher::find(std::string_view text, size_t from) const {
+    const size_t n = needle_.size();
+    if (n == 0 || from > text.size() || text.size() - from < n) return npos;
+
+    const size_t end = text.size() - n + 1;
+    Filter f{text.data(), n - 1,
+             static_cast<uint8_t>(needle_.front()), static_cast<uint8_t>(needle_.back()),
+             firstOr_, lastOr_};
+    auto check = [&](size_t pos) {
+        if (n > 2 && !verify(text.data() + pos, needle_, caseSensitive_)) return false;
+        return !wholeWord_ || (isBoundary(text, pos) && isBoundary(text, pos + n));
+    };
+
+    size_t pos;
+    switch (kernel()) {
+#if defined(BERKIDE_LITERAL_AVX2)
+        case Kernel::Avx2: pos = filterAvx2(f, from, end, check); break;
+#endif
+#if defined(BERKIDE_LITERAL_SSE2)
+        case Kernel::Sse2: pos = filterSse2(f, from, end, check); break;
+#endif
+        default: pos = filterScalar(f, from, end, check); break;
+    }
+    return pos < end ? pos : npos;
+}
+
+// Report which kernel this process uses
+// Bu surecin kullandigi cekirdegi bildir
+const char* LiteralMatcher::kernelName() {
+    switch (kernel()) {
+        case Kernel::Avx2: return "avx2";
+        case Kernel::Sse2: return "sse2";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,50 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Literal substring search compiled once per pattern, for find/find-all over many lines.
+// Bircok satirda bul/tumunu bul icin kalip basina bir kez derlenen literal alt dize aramasi.
+// Candidates come from a vector filter that compares 16 or 32 positions at once against the
+// needle's first and last byte (AVX2 when the CPU supports it, else SSE2, scalar elsewhere);
+// only positions where both agree are verified byte by byte. Case-insensitive matching folds
+// ASCII letters inside the comparison, and whole-word checks look at the bytes around a
+// candidate, so the text is never copied.
+// Adaylar, 16 veya 32 konumu ayni anda ignenin ilk ve son baytiyla karsilastiran bir vektor
+// filtreden gelir (CPU destekliyorsa AVX2, yoksa SSE2, diger yerlerde skaler); yalnizca ikisinin
+// de uydugu konumlar bayt bayt dogrulanir. Buyuk/kucuk harf duyarsiz esleme ASCII harfleri
+// karsilastirma icinde katlar ve tam sozcuk denetimleri adayin etrafindaki baytlara bakar;
+// boylece metin hic kopyalanmaz.
+class LiteralMatcher {
+public:
+    static constexpr size_t npos = std::string_view::npos;
+
+    LiteralMatcher() = default;
+    LiteralMatcher(std::string_view needle, bool caseSensitive, bool wholeWord);
+
+    // Offset of the first match at or after from, or npos
+    // from'da veya sonrasinda ilk eslemenin ofseti, yoksa npos
+    size_t find(std::string_view text, size_t from = 0) const;
+
+    // Needle length in bytes (every match has it)
+    // Bayt cinsinden igne uzunlugu (her eslemede aynidir)
+    size_t size() const { return needle_.size(); }
+    bool empty() const { return needle_.empty(); }
+
+    // Name of the active filter kernel ("avx2", "sse2" or "scalar")
+    // Aktif filtre cekirdeginin adi ("avx2", "sse2" veya "scalar")
+    static const char* kernelName();
+
+private:
+    std::string needle_;         // Needle, ASCII-lowercased when folding / Igne, katlamada ASCII kucuk harfli
+    bool caseSensitive_ = true;
+    bool wholeWord_ = false;
+    uint8_t firstOr_ = 0;        // 0x20 if the first byte is a letter and case folds / Ilk bayt harfse ve katlama varsa 0x20
+    uint8_t lastOr_ = 0;         // Same for the last byte / Son bayt icin ayni
+};
@@ -0,0 +1,554 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "MappedFile.h"
+#include "LineScanner.h"
+#include "Logger.h"
+#include <bit>
+#include <chrono>
+#include <limits>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <csignal>
+    #include <cstdint>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <mutex>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifndef _WIN32
+// A live mapping the SIGBUS handler may repair. Nodes form a list that only grows; a node is
+// claimed with a CAS on start and published with size, and is reused once released. The
+// handler only reads atomics and walks next pointers that never change after the push.
+// SIGBUS isleyicisinin onarabilecegi canli bir esleme. Dugumler yalnizca buyuyen bir liste
+// olusturur; bir dugum start uzerinde CAS ile alinir, size ile yayinlanir ve birakildiginda
+// yeniden kullanilir. Isleyici yalnizca atomikleri okur ve eklendikten sonra hic degismeyen
+// next isaretcilerini gezer.
+struct MappedGuard {
+    std::atomic<uintptr_t> start{0};
+    std::atomic<size_t> size{0};
+    std::atomic<bool> lost{false};     // Pages were zero-filled / Sayfalar sifirla dolduruldu
+    MappedGuard* next = nullptr;
+};
+
+namespace {
+
+std::atomic<MappedGuard*> g_guards{nullptr};
+uintptr_t g_pageSize = 4096;
+std::once_flag g_pageSizeOnce;
+struct sigaction g_previousSigbus;
+std::once_flag g_sigbusOnce;
+
+// Replace the pages from the one holding offset to the end of the mapping with zero pages
+// offset'i tutan sayfadan eslemenin sonuna kadarki sayfalari sifir sayfalarla degistir
+bool zeroFillFrom(uintptr_t start, size_t size, size_t offset) {
+    const uintptr_t page = (start + offset) & ~(g_pageSize - 1);
+    const uintptr_t end = (start + size + g_pageSize - 1) & ~(g_pageSize - 1);
+    if (page >= end) return true;
+    void* zeros = mmap(reinterpret_cast<void*>(page), end - page, PROT_READ,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    return zeros != MAP_FAILED;
+}
+
+// Last resort for a read that races a truncation before checkTruncation() sees it: if the
+// address lies in a guarded mapping, the lost pages are zero-filled, the mapping is marked
+// lost (so its text can no longer be saved) and the read is retried. Other faults go to the
+// previous handler (or the default action). mmap is not async-signal-safe by POSIX, which
+// is why only a host that opts in through installSigbusGuard() gets this.
+// checkTruncation() gormeden once bir kesilmeyle yarisan okuma icin son care: adres korunan bir
+// eslemenin icindeyse kaybolan sayfalar sifirla doldurulur, esleme kayip olarak isaretlenir
+// (boylece metni artik kaydedilemez) ve okuma yeniden denenir. Diger hatalar onceki isleyiciye
+// (veya varsayilan eyleme) gider. mmap POSIX'e gore asenkron sinyal guvenli degildir, bu yuzden
+// bunu yalnizca installSigbusGuard() ile katilan bir ana uygulama alir.
+void onSigbus(int sig, siginfo_t* info, void* context) {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(info->si_addr);
+    for (MappedGuard* guard = g_guards.load(std::memory_order_acquire); guard; guard = guard->next) {
+        const uintptr_t start = guard->start.load(std::memory_order_acquire);
+        const size_t size = guard->size.load(std::memory_order_acquire);
+        if (start == 0 || addr < start || addr - start >= size) continue;
+        guard->lost.store(true, std::memory_order_release);
+        if (zeroFillFrom(start, size, addr - start)) return;
+        break;
+    }
+    if ((g_previousSigbus.sa_flags & SA_SIGINFO) && g_previousSigbus.sa_sigaction) {
+        g_previousSigbus.sa_sigaction(sig, info, context);
+    } else if (g_previousSigbus.sa_handler != SIG_DFL && g_previousSigbus.sa_handler != SIG_IGN) {
+        g_previousSigbus.sa_handler(sig);
+    } else {
+        signal(SIGBUS, SIG_DFL);
+        raise(SIGBUS);
+    }
+}
+
+// Claim a free node for [addr, addr + size), pushing a new one when every node is in use
+// [addr, addr + size) icin bos bir dugum al; hepsi kullanimdaysa yeni bir tane ekle
+MappedGuard* guardMapping(const void* addr, size_t size) {
+    std::call_once(g_pageSizeOnce, []() { g_pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)); });
+    const uintptr_t start = reinterpret_cast<uintptr_t>(addr);
+    MappedGuard* guard = nullptr;
+    for (MappedGuard* node = g_guards.load(std::memory_order_acquire); node && !guard; node = node->next) {
+        uintptr_t expected = 0;
+        if (node->start.compare_exchange_strong(expected, start, std::memory_order_acq_rel)) guard = node;
+    }
+    if (!guard) {
+        guard = new MappedGuard();
+        guard->start.store(start, std::memory_order_relaxed);
+        guard->next = g_guards.load(std::memory_order_relaxed);
+        while (!g_guards.compare_exchange_weak(guard->next, guard, std::memory_order_acq_rel)) {}
+    }
+    guard->lost.store(false, std::memory_order_relaxed);
+    guard->size.store(size, std::memory_order_release);
+    return guard;
+}
+
+// Release a node before its mapping goes away
+// Eslemesi kalkmadan once bir dugumu birak
+void unguardMapping(MappedGuard* guard) {
+    if (!guard) return;
+    guard->size.store(0, std::memory_order_release);
+    guard->start.store(0, std::memory_order_release);
+}
+
+} // namespace
+#endif
+
+// Install the SIGBUS handler once; a no-op on Windows, which cannot truncate a mapped file
+// SIGBUS isleyicisini bir kez kur; eslenmis bir dosyayi kesemeyen Windows'ta islem yapmaz
+void MappedFile::installSigbusGuard() {
+#ifndef _WIN32
+    std::call_once(g_sigbusOnce, []() {
+        std::call_once(g_pageSizeOnce, []() { g_pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)); });
+        struct sigaction action {};
+        action.sa_sigaction = onSigbus;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGBUS, &action, &g_previousSigbus);
+    });
+#endif
+}
+
+// Default constructor: nothing mapped
+// Varsayilan kurucu: eslenmis bir sey yok
+MappedFile::MappedFile() = default;
+
+// Destructor: release the mapping
+// Yikici: eslemeyi serbest birak
+MappedFile::~MappedFile() {
+    close();
+}
+
+// Map the file read-only and prepare (or build) its line index
+// Dosyayi salt okunur esle ve satir indeksini hazirla (veya olustur)
+bool MappedFile::open(const std::string& path, bool indexAll) {
+    close();
+    path_ = path;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("[MappedFile] Cannot open: ", path);
+        return false;
+    }
+    LARGE_INTEGER fsize;
+    if (!GetFileSizeEx(file, &fsize)) {
+        CloseHandle(file);
+        LOG_ERROR("[MappedFile] Cannot stat: ", path);
+        return false;
+    }
+    size_ = static_cast<size_t>(fsize.QuadPart);
+    if (size_ > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            LOG_ERROR("[MappedFile] CreateFileMapping failed: ", path);
+            return false;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            LOG_ERROR("[MappedFile] MapViewOfFile failed: ", path);
+            return false;
+        }
+        data_ = static_cast<const char*>(view);
+        mapHandle_ = mapping;
+    }
+    fileHandle_ = file;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("[MappedFile] Cannot open: ", path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        LOG_ERROR("[MappedFile] Cannot stat: ", path);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            LOG_ERROR("[MappedFile] mmap failed: ", path);
+            return false;
+        }
+        data_ = static_cast<const char*>(addr);
+        guard_ = guardMapping(addr, size_);
+    }
+    // Kept open so checkTruncation() can fstat the mapped file even after a rename
+    // checkTruncation() eslenen dosyayi yeniden adlandirmadan sonra bile fstat edebilsin diye acik tutulur
+    fd_ = fd;
+#endif
+
+    open_ = true;
+
+    // Skip a UTF-8 BOM; a final newline terminates the last line, it does not start a new one
+    // UTF-8 BOM'u atla; son yeni satir son satiri bitirir, yeni bir satir baslatmaz
+    contentStart_ = 0;
+    if (size_ >= 3 &&
+        static_cast<unsigned char>(data_[0]) == 0xEF &&
+        static_cast<unsigned char>(data_[1]) == 0xBB &&
+        static_cast<unsigned char>(data_[2]) == 0xBF) {
+        contentStart_ = 3;
+    }
+    contentEnd_ = size_;
+    if (contentEnd_ > contentStart_ && data_[contentEnd_ - 1] == '\n') contentEnd_--;
+
+    // Reserve chunk slots for the worst case (every byte a newline) so they never move
+    // Parca yuvalarini en kotu duruma gore (her bayt yeni satir) ayir, boylece asla tasinmazlar
+    wide_ = size_ > std::numeric_limits<uint32_t>::max();
+    chunkCapacity_ = (contentEnd_ - contentStart_ + 1) / kChunkSize + 1;
+    if (wide_) chunks64_ = std::make_unique<std::unique_ptr<uint64_t[]>[]>(chunkCapacity_);
+    else chunks32_ = std::make_unique<std::unique_ptr<uint32_t[]>[]>(chunkCapacity_);
+    crChunks_ = std::make_unique<std::unique_ptr<std::atomic<uint64_t>[]>[]>(chunkCapacity_);
+    crTotal_ = 0;
+
+    scanPos_.store(contentStart_, std::memory_order_relaxed);
+    pushLineStart(contentStart_);
+    if (contentStart_ >= contentEnd_) {
+        recordCarriageReturn(0, false);
+        complete_.store(true, std::memory_order_release);
+    }
+
+    if (indexAll) scan(std::numeric_limits<size_t>::max(), -1);
+    return true;
+}
+
+// Release the mapping and reset state
+// Eslemeyi serbest birak ve durumu sifirla
+void MappedFile::close() {
+    stopIndexing();
+#ifdef _WIN32
+    if (data_) UnmapViewOfFile(data_);
+    if (mapHandle_) CloseHandle(static_cast<HANDLE>(mapHandle_));
+    if (fileHandle_) CloseHandle(static_cast<HANDLE>(fileHandle_));
+    mapHandle_ = nullptr;
+    fileHandle_ = nullptr;
+#else
+    unguardMapping(guard_);
+    guard_ = nullptr;
+    if (data_) munmap(const_cast<char*>(data_), size_);
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    detached_.store(false);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    contentStart_ = 0;
+    contentEnd_ = 0;
+    open_ = false;
+    wide_ = false;
+    chunks32_.reset();
+    chunks64_.reset();
+    crChunks_.reset();
+    crTotal_ = 0;
+    chunkCapacity_ = 0;
+    chunksUsed_ = 0;
+    stored_.store(0);
+    scanPos_.store(0);
+    complete_.store(false);
+    cancel_.store(false);
+}
+
+// Write a line start into its chunk, then publish the new count (release)
+// Satir baslangicini parcasina yaz, sonra yeni sayiyi yayinla (release)
+void MappedFile::pushLineStart(size_t offset) {
+    int idx = stored_.load(std::memory_order_relaxed);
+    size_t chunk = static_cast<size_t>(idx) >> kChunkBits;
+    size_t slot = static_cast<size_t>(idx) & (kChunkSize - 1);
+    if (chunk >= chunksUsed_) {
+        if (wide_) chunks64_[chunk] = std::make_unique<uint64_t[]>(kChunkSize);
+        else chunks32_[chunk] = std::make_unique<uint32_t[]>(kChunkSize);
+        crChunks_[chunk] = std::make_unique<std::atomic<uint64_t>[]>(2 * kCrWords);
+        chunksUsed_ = chunk + 1;
+    }
+    // This start finishes the previous line: note its '\r' before publishing
+    // Bu baslangic onceki satiri bitirir: yayinlamadan once '\r'sini not et
+    if (idx > 0) {
+        size_t prevStart = lineStart(idx - 1);
+        recordCarriageReturn(idx - 1, offset - 1 > prevStart && data_[offset - 2] == '\r');
+    }
+    if (wide_) chunks64_[chunk][slot] = static_cast<uint64_t>(offset);
+    else chunks32_[chunk][slot] = static_cast<uint32_t>(offset);
+    stored_.store(idx + 1, std::memory_order_release);
+}
+
+// Scan for '\n' with the vectorized LineScanner and record each line start
+// Vektorlestirilmis LineScanner ile '\n' tara ve her satir baslangicini kaydet
+void MappedFile::scan(size_t maxBytes, int lineTarget) {
+    if (!data_ || isComplete()) return;
+
+    size_t pos = scanPos_.load(std::memory_order_relaxed);
+    size_t limit = (maxBytes >= contentEnd_ - pos) ? contentEnd_ : pos + maxBytes;
+
+    while (pos < limit) {
+        if (lineTarget >= 0 && lineCount() >= lineTarget) break;
+        size_t nl = pos + LineScanner::findNewline(data_ + pos, limit - pos);
+        if (nl >= limit) {
+            pos = limit;
+            break;
+        }
+        pos = nl + 1;
+        pushLineStart(pos);
+    }
+
+    scanPos_.store(pos, std::memory_order_relaxed);
+    if (pos >= contentEnd_) {
+        int last = stored_.load(std::memory_order_relaxed) - 1;
+        recordCarriageReturn(last, contentEnd_ > lineStart(last) && data_[contentEnd_ - 1] == '\r');
+        complete_.store(true, std::memory_order_release);
+    }
+}
+
+// Index synchronously until the requested prefix is readable
+// Istenen onek okunabilir olana kadar senkron indeksle
+int MappedFile::indexLines(int minLines) {
+    scan(std::numeric_limits<size_t>::max(), minLines);
+    return lineCount();
+}
+
+// Launch the background indexer
+// Arka plan indeksleyiciyi baslat
+void MappedFile::startIndexing(ProgressFn onProgress) {
+    std::lock_guard<std::mutex> lock(doneMutex_);
+    if (indexerRunning_ || !open_) return;
+    if (isComplete()) {
+        if (onProgress) onProgress(lineCount(), size_, size_, true);
+        return;
+    }
+    if (indexer_.joinable()) indexer_.join();
+    cancel_.store(false);
+    indexerRunning_ = true;
+    indexer_ = std::thread(&MappedFile::indexLoop, this, std::move(onProgress));
+}
+
+// Index in 32 MB slices, reporting progress after each one
+// 32 MB'lik dilimler halinde indeksle, her birinden sonra ilerlemeyi bildir
+void MappedFile::indexLoop(ProgressFn onProgress) {
+    constexpr size_t kSlice = 32u * 1024 * 1024;
+    while (!cancel_.load(std::memory_order_relaxed) && !isComplete()) {
+        scan(kSlice, -1);
+        bool done = isComplete();
+        if (onProgress) onProgress(lineCount(), done ? size_ : scannedBytes(), size_, done);
+    }
+    if (isComplete()) {
+        LOG_DEBUG("[MappedFile] Indexed ", path_, ": ", lineCount(), " lines");
+    }
+    {
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        indexerRunning_ = false;
+    }
+    doneCv_.notify_all();
+}
+
+// Ask the indexer to stop and wait for it
+// Indeksleyiciden durmasini iste ve bekle
+void MappedFile::stopIndexing() {
+    cancel_.store(true);
+    if (indexer_.joinable() && indexer_.get_id() != std::this_thread::get_id()) {
+        indexer_.join();
+    }
+}
+
+// Wait for the background indexer, then finish any remainder inline
+// Arka plan indeksleyiciyi bekle, sonra kalani satir ici bitir
+void MappedFile::waitIndexed() {
+    std::unique_lock<std::mutex> lock(doneMutex_);
+    doneCv_.wait(lock, [this] { return !indexerRunning_; });
+    if (!isComplete()) scan(std::numeric_limits<size_t>::max(), -1);
+}
+
+// Compare the mapped file's size with the mapping; if it shrank, zero-fill the lost pages now
+// (so readers never fault on them) and mark the mapping lost. Windows cannot truncate it.
+// Eslenen dosyanin boyutunu eslemeyle karsilastir; kuculduyse kaybolan sayfalari simdi sifirla
+// doldur (boylece okuyucular onlarda hata almaz) ve eslemeyi kayip isaretle. Windows onu kesemez.
+bool MappedFile::checkTruncation() {
+#ifndef _WIN32
+    if (!guard_ || fd_ < 0 || detached_.load(std::memory_order_acquire)) return isLost();
+    struct stat st;
+    if (fstat(fd_, &st) == 0 && static_cast<size_t>(st.st_size) < size_ && !isLost()) {
+        zeroFillFrom(reinterpret_cast<uintptr_t>(data_), size_, static_cast<size_t>(st.st_size) + g_pageSize - 1);
+        guard_->lost.store(true, std::memory_order_release);
+        LOG_ERROR("[MappedFile] ", path_, " was truncated on disk (", size_, " -> ", st.st_size,
+                  " bytes); its text past that point is lost");
+    }
+#endif
+    return isLost();
+}
+
+// Compares device and inode, so a hard link or a symlink to the mapped file matches too.
+// Windows refuses to truncate a mapped file, so an in-place save there fails instead.
+// Aygit ve inode karsilastirilir, boylece eslenen dosyaya bir sert veya sembolik baglanti da
+// eslesir. Windows eslenmis bir dosyayi kesmeyi reddeder, orada yerinde kaydetme bunun yerine basarisiz olur.
+bool MappedFile::mapsFile(const std::string& path) const {
+#ifndef _WIN32
+    struct stat mine, other;
+    if (fd_ < 0 || fstat(fd_, &mine) != 0 || ::stat(path.c_str(), &other) != 0) return false;
+    return mine.st_dev == other.st_dev && mine.st_ino == other.st_ino;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+// The pages are copied into anonymous memory that then takes the mapping's place at the same
+// address. Touching each page of the private mapping is not enough: truncation drops its
+// copied pages too. Linux moves the copy over the mapping in one step; elsewhere it is mapped
+// over it and refilled, so a read racing that moment sees zeros. Marked detached before
+// returning, so a truncation check after that ignores the file.
+// Sayfalar anonim bellege kopyalanir ve bu kopya ayni adreste eslemenin yerini alir. Ozel
+// eslemenin her sayfasina dokunmak yetmez: kesilme onun kopyalanmis sayfalarini da atar. Linux
+// kopyayi eslemenin ustune tek adimda tasir; baska yerlerde onun ustune eslenir ve yeniden
+// doldurulur, bu yuzden o anla yarisan bir okuma sifir gorur. Donmeden once ayrilmis
+// isaretlenir, boylece ondan sonraki bir kesilme denetimi dosyayi yok sayar.
+bool MappedFile::detachFromFile() {
+#ifndef _WIN32
+    std::lock_guard<std::mutex> lock(detachMutex_);
+    if (!data_ || detached_.load(std::memory_order_acquire)) return true;
+    if (checkTruncation()) return false;
+    void* target = const_cast<char*>(data_);
+    void* copy = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (copy == MAP_FAILED) {
+        LOG_ERROR("[MappedFile] Cannot copy ", path_, " into memory: ", std::strerror(errno));
+        return false;
+    }
+    std::memcpy(copy, data_, size_);
+    mprotect(copy, size_, PROT_READ);
+#ifdef __linux__
+    bool moved = mremap(copy, size_, size_, MREMAP_MAYMOVE | MREMAP_FIXED, target) != MAP_FAILED;
+    if (!moved) munmap(copy, size_);
+#else
+    bool moved = mmap(target, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != MAP_FAILED;
+    if (moved) {
+        std::memcpy(target, copy, size_);
+        mprotect(target, size_, PROT_READ);
+    }
+    munmap(copy, size_);
+#endif
+    if (!moved) {
+        LOG_ERROR("[MappedFile] Cannot copy ", path_, " into memory: ", std::strerror(errno));
+        return false;
+    }
+    detached_.store(true, std::memory_order_release);
+    LOG_DEBUG("[MappedFile] Copied ", path_, " into memory (", size_, " bytes)");
+#endif
+    return true;
+}
+
+// Lost once the guard or a truncation check zero-filled part of the mapping
+// Koruma veya bir kesilme denetimi eslemenin bir kismini sifirla doldurdugunda kayip
+bool MappedFile::isLost() const {
+#ifndef _WIN32
+    return guard_ && guard_->lost.load(std::memory_order_acquire);
+#else
+    return false;
+#endif
+}
+
+// Waits in short slices so cancel is noticed while the indexer runs
+// Indeksleyici calisirken cancel fark edilsin diye kisa dilimlerle bekler
+bool MappedFile::awaitIndexer(const std::atomic<bool>& cancel) {
+    std::unique_lock<std::mutex> lock(doneMutex_);
+    while (indexerRunning_ && !cancel.load(std::memory_order_relaxed)) {
+        doneCv_.wait_for(lock, std::chrono::milliseconds(50));
+    }
+    return isComplete() && !cancel.load(std::memory_order_relaxed);
+}
+
+// Offset of a line start
+// Satir baslangicinin ofseti
+size_t MappedFile::lineStart(int index) const {
+    size_t chunk = static_cast<size_t>(index) >> kChunkBits;
+    size_t slot = static_cast<size_t>(index) & (kChunkSize - 1);
+    return wide_ ? static_cast<size_t>(chunks64_[chunk][slot]) : static_cast<size_t>(chunks32_[chunk][slot]);
+}
+
+// Readable lines: while scanning, the last recorded start has no known end yet
+// Okunabilir satirlar: tarama surerken son kaydedilen baslangicin sonu henuz bilinmiyor
+int MappedFile::lineCount() const {
+    bool done = isComplete();
+    int stored = stored_.load(std::memory_order_acquire);
+    return done ? stored : stored - 1;
+}
+
+// View of a line, excluding '\n' and a trailing '\r'
+// '\n' ve sondaki '\r' haric bir satirin gorunumu
+std::string_view MappedFile::line(int index) const {
+    int stored = stored_.load(std::memory_order_acquire);
+    if (!data_ || index < 0 || index >= stored) return {};
+    size_t start = lineStart(index);
+    size_t end = (index + 1 < stored) ? lineStart(index + 1) - 1 : contentEnd_;
+    if (end > start && data_[end - 1] == '\r') --end;
+    return std::string_view(data_ + start, end - start);
+}
+
+// Set a line's '\r' bit; the first line of each word also stores the running count. Both
+// are published with release, so a reader that sees the bit (or the line) sees the count too.
+// Bir satirin '\r' bitini ayarla; her kelimenin ilk satiri ayrica birikmis sayiyi saklar. Ikisi
+// de release ile yayinlanir, boylece biti (veya satiri) goren okuyucu sayiyi da gorur.
+void MappedFile::recordCarriageReturn(int index, bool cr) {
+    std::atomic<uint64_t>* words = crChunks_[static_cast<size_t>(index) >> kChunkBits].get();
+    size_t slot = static_cast<size_t>(index) & (kChunkSize - 1);
+    if ((slot & 63) == 0) words[kCrWords + (slot >> 6)].store(crTotal_, std::memory_order_release);
+    if (cr) {
+        words[slot >> 6].fetch_or(uint64_t(1) << (slot & 63), std::memory_order_release);
+        ++crTotal_;
+    }
+}
+
+// Rank query: running count of the word holding index - 1 plus the bits up to it
+// Sira sorgusu: index - 1'i tutan kelimenin birikmis sayisi arti ona kadarki bitler
+uint64_t MappedFile::carriageReturnsBefore(int index) const {
+    if (index <= 0) return 0;
+    size_t last = static_cast<size_t>(index - 1);
+    const std::atomic<uint64_t>* words = crChunks_[last >> kChunkBits].get();
+    size_t slot = last & (kChunkSize - 1);
+    uint64_t mask = (slot & 63) == 63 ? ~uint64_t(0) : (uint64_t(2) << (slot & 63)) - 1;
+    const uint64_t bits = words[slot >> 6].load(std::memory_order_acquire);
+    return words[kCrWords + (slot >> 6)].load(std::memory_order_acquire) + static_cast<uint64_t>(std::popcount(bits & mask));
+}
+
+// Raw start offset minus the BOM and the '\r' bytes dropped before the line
+// Ham baslangic ofseti eksi BOM ve satirdan once atilan '\r' baytlari
+uint64_t MappedFile::textOffset(int index) const {
+    int stored = stored_.load(std::memory_order_acquire);
+    if (!data_ || index <= 0) return 0;
+    size_t raw = (index < stored) ? lineStart(index) : contentEnd_ + 1;
+    return static_cast<uint64_t>(raw - contentStart_) - carriageReturnsBefore(index);
+}
+
+// Memory used by the line index
+// Satir indeksinin kullandigi bellek
+size_t MappedFile::indexBytes() const {
+    return chunksUsed_ * (kChunkSize * (wide_ ? sizeof(uint64_t) : sizeof(uint32_t)) + 2 * kCrWords * sizeof(uint64_t));
+}
@@ -0,0 +1,221 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+struct MappedGuard;
+
+// Read-only memory-mapped text file with a compact line-start index.
+// Kompakt satir baslangic indeksine sahip salt okunur bellek eslemeli metin dosyasi.
+// Used as the Original source of a PieceTable for large files: lines are served as
+// views into the mapping and only materialized into std::string on write (COW).
+// Buyuk dosyalar icin PieceTable'in Original kaynagi olarak kullanilir: satirlar esleme
+// uzerinde gorunum olarak sunulur ve yalnizca yazmada (COW) std::string'e donusturulur.
+// If the file is truncated while mapped, its text past the new end is gone: checkTruncation()
+// notices that with fstat and zero-fills the lost pages, and the mapping is marked lost so
+// callers refuse to write its text anywhere. A read that races the truncation raises SIGBUS;
+// only a host that called installSigbusGuard() turns that into zero-filled, lost pages.
+// Dosya eslenmisken kesilirse yeni sonun otesindeki metni gider: checkTruncation() bunu fstat
+// ile fark eder ve kaybolan sayfalari sifirla doldurur, esleme kayip isaretlenir ve cagiranlar
+// metnini hicbir yere yazmayi reddeder. Kesilmeyle yarisan bir okuma SIGBUS dogurur; bunu
+// yalnizca installSigbusGuard() cagirmis bir ana uygulama sifirla dolu, kayip sayfalara cevirir.
+// The index can be built progressively on a background thread; readers only ever see
+// lines whose end is known, so a growing prefix is always safe to read.
+// Indeks arka plan thread'inde asamali olarak olusturulabilir; okuyucular yalnizca sonu
+// bilinen satirlari gorur, boylece buyuyen onek her zaman guvenle okunabilir.
+class MappedFile {
+public:
+    // Progress callback: (lines indexed, bytes scanned, total bytes, finished)
+    // Ilerleme geri cagirimi: (indekslenen satirlar, taranan baytlar, toplam bayt, bitti)
+    using ProgressFn = std::function<void(int lines, size_t bytes, size_t total, bool done)>;
+
+    MappedFile();
+    ~MappedFile();
+
+    // Opt in to the process-wide SIGBUS handler for reads that race a truncation. It remaps
+    // pages from signal context, which POSIX does not promise is safe, so the engine never
+    // installs it by itself; the editor host calls this once at startup.
+    // Bir kesilmeyle yarisan okumalar icin surec capinda SIGBUS isleyicisine katil. Sayfalari
+    // sinyal baglaminda yeniden esler, POSIX bunun guvenli oldugunu vaat etmez, bu yuzden motor
+    // onu kendiliginden kurmaz; editor ana uygulamasi bunu acilista bir kez cagirir.
+    static void installSigbusGuard();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map a file; index every line now, or leave indexing to indexLines/startIndexing
+    // Bir dosyayi esle; tum satirlari simdi indeksle veya indekslemeyi indexLines/startIndexing'e birak
+    bool open(const std::string& path, bool indexAll = true);
+
+    // Unmap the file and drop the index (stops background indexing first)
+    // Dosya eslemesini kaldir ve indeksi birak (once arka plan indekslemeyi durdurur)
+    void close();
+
+    // Check if a file is currently mapped
+    // Su an eslenmis bir dosya olup olmadigini kontrol et
+    bool isOpen() const { return open_; }
+
+    // Path of the mapped file
+    // Eslenmis dosyanin yolu
+    const std::string& path() const { return path_; }
+
+    // Size of the mapping in bytes
+    // Eslemenin bayt cinsinden boyutu
+    size_t size() const { return size_; }
+
+    // The whole mapping as raw bytes (empty when nothing is mapped)
+    // Tum esleme ham bayt olarak (hicbir sey eslenmemisse bos)
+    std::string_view contents() const { return {data_, size_}; }
+
+    // Index synchronously until at least minLines lines are readable (or the file ends)
+    // En az minLines satir okunabilir olana kadar (veya dosya bitene kadar) senkron indeksle
+    int indexLines(int minLines);
+
+    // Index the rest of the file on a background thread, reporting progress
+    // Dosyanin geri kalanini arka plan thread'inde indeksle, ilerlemeyi bildir
+    void startIndexing(ProgressFn onProgress);
+
+    // Stop background indexing (the readable prefix stays valid)
+    // Arka plan indekslemeyi durdur (okunabilir onek gecerli kalir)
+    void stopIndexing();
+
+    // Block until the whole file is indexed (indexes inline if no thread is running)
+    // Tum dosya indekslenene kadar bekle (calisan thread yoksa satir ici indeksler)
+    void waitIndexed();
+
+    // Wait for the background indexer to exit without indexing the rest here; true if the
+    // whole file is indexed, false if indexing was stopped or cancel was set first
+    // Arka plan indeksleyicinin cikmasini geri kalani burada indekslemeden bekle; tum dosya
+    // indekslendiyse true, indeksleme durdurulduysa veya once cancel ayarlandiysa false
+    bool awaitIndexer(const std::atomic<bool>& cancel);
+
+    // True once every line of the file is indexed
+    // Dosyanin her satiri indekslendiginde true
+    bool isComplete() const { return complete_.load(std::memory_order_acquire); }
+
+    // Check the file on disk for truncation; true if the mapping has lost text (now or before)
+    // Diskteki dosyayi kesilmeye karsi denetle; esleme metin kaybettiyse (simdi veya once) true
+    bool checkTruncation();
+
+    // True if the mapping was taken from the file at path (same device and inode)
+    // Esleme path'teki dosyadan alindiysa true (ayni aygit ve inode)
+    bool mapsFile(const std::string& path) const;
+
+    // Copy every mapped page into private memory so the file can be rewritten in place without
+    // the text changing under readers; views stay valid. Costs the file size in RAM. False if
+    // the mapping had already lost text or the pages could not be copied.
+    // Eslenmis her sayfayi ozel bellege kopyala, boylece dosya okuyucularin altinda metin
+    // degismeden yerinde yeniden yazilabilir; gorunumler gecerli kalir. RAM'de dosya boyutu
+    // kadar yer tutar. Esleme zaten metin kaybettiyse veya sayfalar kopyalanamadiysa false.
+    bool detachFromFile();
+
+    // True once part of the mapping was zero-filled after the file was truncated
+    // Dosya kesildikten sonra eslemenin bir kismi sifirla dolduruldugunda true
+    bool isLost() const;
+
+    // Bytes scanned so far by the indexer
+    // Indeksleyicinin simdiye kadar taradigi baytlar
+    size_t scannedBytes() const { return scanPos_.load(std::memory_order_relaxed); }
+
+    // Number of readable lines (grows while indexing; getline semantics once complete)
+    // Okunabilir satir sayisi (indeksleme surerken buyur; tamamlaninca getline anlambilimi)
+    int lineCount() const;
+
+    // View of a line without its terminator ('\n' or "\r\n")
+    // Sonlandiricisi ('\n' veya "\r\n") olmadan bir satirin gorunumu
+    std::string_view line(int index) const;
+
+    // Offset of a line start in the text as lines are served: BOM and '\r' dropped, one '\n'
+    // per line. Valid for index <= lineCount(); lineCount() gives the end of the last line + 1.
+    // Satirlarin sunuldugu haliyle metinde bir satir basinin ofseti: BOM ve '\r' atilir, satir
+    // basina bir '\n'. index <= lineCount() icin gecerli; lineCount() son satirin sonu + 1'i verir.
+    uint64_t textOffset(int index) const;
+
+    // Size of the line index in bytes (for diagnostics)
+    // Satir indeksinin bayt cinsinden boyutu (tanilar icin)
+    size_t indexBytes() const;
+
+private:
+    // Scan up to maxBytes (or until lineTarget lines are readable) and record line starts
+    // maxBytes'a kadar (veya lineTarget satir okunabilir olana kadar) tara ve satir baslangiclarini kaydet
+    void scan(size_t maxBytes, int lineTarget);
+
+    // Byte offset where a line starts
+    // Bir satirin basladigi bayt ofseti
+    size_t lineStart(int index) const;
+
+    // Record a line start and publish it to readers
+    // Satir baslangicini kaydet ve okuyuculara yayinla
+    void pushLineStart(size_t offset);
+
+    // Record whether a finished line ends in '\r' (lines are finished in order)
+    // Biten bir satirin '\r' ile bitip bitmedigini kaydet (satirlar sirayla biter)
+    void recordCarriageReturn(int index, bool cr);
+
+    // Lines before index that end in '\r'
+    // index'ten onceki '\r' ile biten satirlar
+    uint64_t carriageReturnsBefore(int index) const;
+
+    // Background indexing loop
+    // Arka plan indeksleme dongusu
+    void indexLoop(ProgressFn onProgress);
+
+    // Index chunks hold a fixed number of offsets and never move once allocated
+    // Indeks parcalari sabit sayida ofset tutar ve ayrildiktan sonra asla tasinmaz
+    static constexpr int kChunkBits = 16;
+    static constexpr size_t kChunkSize = size_t(1) << kChunkBits;
+
+    std::string path_;
+    const char* data_ = nullptr;     // Mapped bytes / Eslenmis baytlar
+    size_t size_ = 0;                // Mapping length / Esleme uzunlugu
+    size_t contentStart_ = 0;        // First byte after the BOM / BOM'dan sonraki ilk bayt
+    size_t contentEnd_ = 0;          // End of the last line (final newline excluded) / Son satirin sonu (son yeni satir haric)
+    bool open_ = false;
+    bool wide_ = false;              // Using 64-bit offsets (file > 4 GB) / 64-bit ofset kullaniliyor (dosya > 4 GB)
+
+    std::unique_ptr<std::unique_ptr<uint32_t[]>[]> chunks32_;  // Line starts for files < 4 GB / 4 GB alti dosyalar icin satir baslangiclari
+    std::unique_ptr<std::unique_ptr<uint64_t[]>[]> chunks64_;  // Line starts for larger files / Daha buyuk dosyalar icin satir baslangiclari
+    // Per chunk: one '\r' bit per line, then the running '\r' count before each 64-line word
+    // Parca basina: satir basina bir '\r' biti, ardindan her 64 satirlik kelimeden onceki '\r' sayisi
+    static constexpr size_t kCrWords = kChunkSize / 64;
+    // Atomic because readers rank lines while the indexer sets bits in the same words
+    // Atomik, cunku indeksleyici ayni kelimelerde bit ayarlarken okuyucular satirlari siralar
+    std::unique_ptr<std::unique_ptr<std::atomic<uint64_t>[]>[]> crChunks_;
+    uint64_t crTotal_ = 0;           // Lines ending in '\r' so far (indexer only) / Simdiye kadar '\r' ile biten satirlar (yalnizca indeksleyici)
+    size_t chunkCapacity_ = 0;       // Chunk slots (sized for the worst case at open) / Parca yuvalari (acilista en kotu duruma gore)
+    size_t chunksUsed_ = 0;          // Allocated chunks / Ayrilmis parcalar
+
+    std::atomic<int> stored_{0};         // Line starts written / Yazilan satir baslangiclari
+    std::atomic<size_t> scanPos_{0};     // Next byte to scan / Taranacak sonraki bayt
+    std::atomic<bool> complete_{false};  // Whole file indexed / Tum dosya indekslendi
+    std::atomic<bool> cancel_{false};    // Stop request for the indexer / Indeksleyici icin durdurma istegi
+
+    std::thread indexer_;                // Background indexer / Arka plan indeksleyici
+    std::mutex doneMutex_;               // Guards completion wait / Tamamlanma beklemesini korur
+    std::condition_variable doneCv_;     // Signals indexer exit / Indeksleyici cikisini bildirir
+    bool indexerRunning_ = false;        // Indexer thread active (guarded by doneMutex_) / Indeksleyici thread aktif
+
+#ifdef _WIN32
+    // Windows refuses to truncate a file while it is mapped, so no guard is needed there
+    // Windows eslenmisken bir dosyanin kesilmesini reddeder, bu yuzden orada koruma gerekmez
+    void* fileHandle_ = nullptr;     // HANDLE of the opened file / Acilan dosyanin HANDLE'i
+    void* mapHandle_ = nullptr;      // HANDLE of the file mapping / Dosya eslemesinin HANDLE'i
+#else
+    int fd_ = -1;                    // Descriptor of the mapped file / Eslenen dosyanin tanimlayicisi
+    std::mutex detachMutex_;         // Serializes detachFromFile / detachFromFile'i siralar
+    std::atomic<bool> detached_{false};  // Pages copied off the file / Sayfalar dosyadan kopyalandi
+    MappedGuard* guard_ = nullptr;   // SIGBUS guard node of the mapping / Eslemenin SIGBUS koruma dugumu
+#endif
+};
@@ -4,6 +4,7 @@
 // See LICENSE file in the project root for full license text.
 
 #include "MarkManager.h"
+#include "PositionMap.h"
 #include "Logger.h"
 #include <algorithm>
 #include <cctype>
@@ -173,6 +174,16 @@ void MarkManager::adjustMarks(int editLine, int editCol, int linesDelta, int col
     }
 }
 
+// Move every mark through the batch's position map
+// Her isareti grubun konum haritasindan gecirerek tasi
+void MarkManager::adjustForEdits(const PositionMap& map) {
+    if (map.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [name, mark] : marks_) {
+        map.map(mark.line, mark.col);
+    }
+}
+
 // Clear buffer-local marks (a-z and auto-marks)
 // Buffer-yerel isaretleri temizle (a-z ve otomatik isaretler)
 void MarkManager::clearLocal() {
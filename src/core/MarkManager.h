@@ -9,6 +9,8 @@
 #include <unordered_map>
 #include <mutex>
 
+class PositionMap;
+
 // A single mark (named position in a buffer)
 // Tek bir isaret (buffer'daki adlandirilmis konum)
 struct Mark {
@@ -87,6 +89,10 @@ public:
     // Bir metin duzenlemesinden sonra tum isaretleri ayarla (ekleme/silme konumlari kaydirir)
     void adjustMarks(int editLine, int editCol, int linesDelta, int colDelta);
 
+    // Adjust all marks for a whole batch of edits in one pass
+    // Tum isaretleri tum bir duzenleme grubu icin tek geciste ayarla
+    void adjustForEdits(const PositionMap& map);
+
     // Clear all marks (buffer-local only, or all including global)
     // Tum isaretleri temizle (yalnizca buffer-yerel veya global dahil tumu)
     void clearLocal();
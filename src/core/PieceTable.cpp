@@ -4,222 +4,365 @@
 // See LICENSE file in the project root for full license text.
 
 #include "PieceTable.h"
+#include "MappedFile.h"
 #include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 
+// Default GC policy: half of the add buffer dead (at least 1024 lines), or 30 s idle.
+// These thresholds also bound the cost of getLineRef's copy-to-end: typing that alternates
+// between lines, or follows a snapshot, leaves one dead line per edit, so the add buffer holds
+// at most its live lines plus max(live lines, 1024) before a collection compacts it.
+// Varsayilan GC politikasi: ekleme arabelleginin yarisi olu (en az 1024 satir) veya 30 sn bosta.
+// Bu esikler getLineRef'in sona kopyalamasinin maliyetini de sinirlar: satirlar arasinda gidip
+// gelen veya bir anlik goruntuyu izleyen yazim duzenleme basina bir olu satir birakir, boylece
+// ekleme arabellegi bir toplama onu sikistirana kadar en fazla canli satirlari arti
+// max(canli satirlar, 1024) tutar.
+std::atomic<int> PieceTable::gcDeadPercent_{50};
+std::atomic<int> PieceTable::gcMinDead_{1024};
+std::atomic<int> PieceTable::gcIdleSeconds_{30};
+std::atomic<uint64_t> PieceTable::nextStorageId_{1};
+
 // Constructor: initialize with a single empty line in the add buffer
 // Kurucu: ekleme arabelleginde tek bir bos satirla baslatir
-PieceTable::PieceTable() {
-    add_.push_back("");
-    pieces_.push_back({Source::Add, 0, 1});
-    lineCount_ = 1;
-}
-
-// Locate the piece and offset within it for a logical line index
-// Mantiksal satir indeksi icin parcayi ve icindeki ofset'i bul
-PieceTable::PiecePos PieceTable::findLine(int line) const {
-    int cumulative = 0;
-    for (int i = 0; i < static_cast<int>(pieces_.size()); ++i) {
-        if (cumulative + pieces_[i].count > line) {
-            return {i, line - cumulative};
-        }
-        cumulative += pieces_[i].count;
-    }
-    // Out of range: return last position
-    // Aralik disi: son konumu dondur
-    if (!pieces_.empty()) {
-        int last = static_cast<int>(pieces_.size()) - 1;
-        return {last, pieces_[last].count - 1};
-    }
-    return {0, 0};
+PieceTable::PieceTable() : storageId_(nextStorageId_++) {
+    add_.push(std::string());
+    pieces_.insert(0, {Source::Add, 0, 1}, measure());
 }
 
-// Get a const reference to the actual string at a piece position
-// Parca konumundaki gercek string'e const referans al
-const std::string& PieceTable::lineAtConst(const Piece& piece, int offset) const {
+// Get a view of the actual line at a piece position
+// Parca konumundaki gercek satirin gorunumunu al
+std::string_view PieceTable::lineAtConst(const Piece& piece, int offset) const {
     int idx = piece.start + offset;
-    return (piece.source == Source::Original) ? original_[idx] : add_[idx];
+    return (piece.source == Source::Original) ? originalLine(idx) : std::string_view(add_[idx]);
 }
 
-// Split a piece at the given offset within it
-// Parcayi icindeki verilen ofset'te bol
-void PieceTable::splitPiece(int pieceIdx, int offset) {
-    if (offset <= 0 || offset >= pieces_[pieceIdx].count) return;
+// Original lines come from the mapping when one is loaded, else from the vector
+// Original satirlari yuklu bir esleme varsa oradan, yoksa vektorden gelir
+std::string_view PieceTable::originalLine(int index) const {
+    if (mapped_) return mapped_->line(index);
+    return (*original_)[index];
+}
 
-    Piece& p = pieces_[pieceIdx];
-    Piece second{p.source, p.start + offset, p.count - offset};
-    p.count = offset;
-    pieces_.insert(pieces_.begin() + pieceIdx + 1, second);
+// Lines past the tree come straight from the mapping (still being indexed)
+// Agacin otesindeki satirlar dogrudan eslemeden gelir (hala indeksleniyor)
+std::string_view PieceTable::lineView(int line) const {
+    if (line < 0 || line >= lineCount()) return {};
+    int treeLines = pieces_.lineCount();
+    if (line >= treeLines) return mapped_->line(adopted_ + (line - treeLines));
+    auto loc = pieces_.find(line);
+    return lineAtConst(*loc.piece, loc.offset);
 }
 
-// Recalculate the cached line count from all pieces
-// Tum parcalardan onbelleklenmis satir sayisini yeniden hesapla
-void PieceTable::recalcLineCount() {
-    int total = 0;
-    for (const auto& p : pieces_) {
-        total += p.count;
-    }
-    lineCount_ = total;
+// Mapped lines indexed since the last adoption
+// Son alimdan beri indekslenen eslenmis satirlar
+int PieceTable::pendingLines() const {
+    if (sealed_ || !mapped_) return 0;
+    return mapped_->lineCount() - adopted_;
+}
+
+// Append pending mapped lines as an Original piece (extends the trailing piece when contiguous)
+// Bekleyen eslenmis satirlari Original parcasi olarak ekle (bitisikse sondaki parcayi genisletir)
+void PieceTable::adoptPending() {
+    int pending = pendingLines();
+    if (pending <= 0) return;
+    pieces_.insert(pieces_.lineCount(), {Source::Original, adopted_, pending}, measure());
+    adopted_ += pending;
 }
 
 // Return a copy of the line at the given index
 // Verilen indeksteki satirin kopyasini dondur
 std::string PieceTable::getLine(int line) const {
-    if (line < 0 || line >= lineCount_) return "";
-    auto pos = findLine(line);
-    return lineAtConst(pieces_[pos.pieceIdx], pos.offset);
+    if (line < 0 || line >= lineCount()) return "";
+    return std::string(lineView(line));
 }
 
 // Return a mutable reference with copy-on-write for original lines
 // Orijinal satirlar icin yazimda kopyalama ile degistirilebilir referans dondur
 std::string& PieceTable::getLineRef(int line) {
-    auto pos = findLine(line);
-    auto& piece = pieces_[pos.pieceIdx];
+    settle();
+    adoptPending();
+    maybeCollect();
+    auto loc = pieces_.find(line);
+    const Piece piece = *loc.piece;
 
     if (piece.source == Source::Original) {
-        // Copy-on-write: copy line to add buffer, isolate in pieces
-        // Yazimda kopyala: satiri ekleme arabellegine kopyala, parcalarda izole et
-        int addIdx = static_cast<int>(add_.size());
-        add_.push_back(original_[piece.start + pos.offset]);
-
-        // Split before this line if needed
-        // Gerekirse bu satirdan once bol
-        if (pos.offset > 0) {
-            splitPiece(pos.pieceIdx, pos.offset);
-            pos.pieceIdx++;
-            pos.offset = 0;
-        }
+        // Copy-on-write: copy line to add buffer, swap a single-line Add piece in its place
+        // Yazimda kopyala: satiri ekleme arabellegine kopyala, yerine tek satirlik Add parcasi koy
+        int addIdx = add_.push(std::string(originalLine(piece.start + loc.offset)));
+
+        int index = std::clamp(line, 0, pieces_.lineCount() - 1);
+        pieces_.erase(index, 1, measure());
+        pieces_.insert(index, {Source::Add, addIdx, 1}, measure());
+        return handOut(index, addIdx);
+    }
+
+    int idx = piece.start + loc.offset;
+    if (idx < frozenAdd_ || idx != add_.size() - 1) {
+        // A snapshot can see this add line, or lines after it have fixed offsets: copy it to
+        // the end instead of writing in place. The old copy is dead; a per-line "last written"
+        // slot would not help, since only the last store line can change length, so the GC
+        // thresholds bound this instead (see gcDeadPercent_)
+        // Bir anlik goruntu bu ekleme satirini gorebilir veya ondan sonraki satirlarin ofsetleri
+        // sabit: yerinde yazmak yerine sona kopyala. Eski kopya olur; satir basina bir "son yazilan"
+        // yuvasi ise yaramaz cunku yalnizca deponun son satirinin uzunlugu degisebilir, bu yuzden
+        // bunu GC esikleri sinirlar (bkz. gcDeadPercent_)
+        int addIdx = add_.push(add_[idx]);
+        int index = std::clamp(line, 0, pieces_.lineCount() - 1);
+        pieces_.erase(index, 1, measure());
+        pieces_.insert(index, {Source::Add, addIdx, 1}, measure());
+        ++deadAdd_;
+        return handOut(index, addIdx);
+    }
+
+    // Already the last add line, return directly
+    // Zaten son ekleme satiri, dogrudan dondur
+    return handOut(line, idx);
+}
+
+// Remember the line behind a returned reference so its new length can be settled later
+// Dondurulen referansin arkasindaki satiri hatirla, boylece yeni uzunlugu sonra islenebilir
+std::string& PieceTable::handOut(int line, int addIdx) {
+    refLine_ = line;
+    refAdd_ = addIdx;
+    refLength_ = add_[addIdx].size();
+    return add_.at(addIdx);
+}
+
+// Fold the length change of the last handed-out line into the piece tree
+// Son verilen satirin uzunluk degisimini parca agacina yansit
+void PieceTable::settle() const {
+    if (refAdd_ < 0) return;
+    size_t length = add_[refAdd_].size();
+    pieces_.addBytes(refLine_, static_cast<int64_t>(length) - static_cast<int64_t>(refLength_));
+    refAdd_ = -1;
+}
+
+// Byte offset where a source line starts (lines counted with one '\n' each)
+// Bir kaynak satirinin basladigi bayt ofseti (satirlar birer '\n' ile sayilir)
+uint64_t PieceTable::sourceOffset(Source source, int index) const {
+    if (source == Source::Add) return add_.offsetOf(index);
+    if (mapped_) return mapped_->textOffset(index);
+    return (*originalOffsets_)[index];
+}
+
+// Bytes covered by a piece
+// Bir parcanin kapsadigi baytlar
+uint64_t PieceTable::measurePiece(const Piece& piece) const {
+    return sourceOffset(piece.source, piece.start + piece.count) - sourceOffset(piece.source, piece.start);
+}
+
+// Measure callback for the piece tree, bound to this table's sources
+// Bu tablonun kaynaklarina bagli, parca agaci icin olcum geri cagirimi
+PieceTree::MeasureFn PieceTable::measure() const {
+    return [this](const Piece& piece) { return measurePiece(piece); };
+}
+
+// Binary search for the last line in source[start, start + count) starting at or before target
+// source[start, start + count) icinde target'ta veya oncesinde baslayan son satiri ikili ara
+int PieceTable::lineAtSourceOffset(Source source, int start, int count, uint64_t target) const {
+    int lo = 0, hi = count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (sourceOffset(source, start + mid) <= target) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// Bytes before a line: tree aggregates down to the piece, source offsets inside it
+// Bir satirdan onceki baytlar: parcaya kadar agac toplamlari, icinde kaynak ofsetleri
+uint64_t PieceTable::bytesBefore(int line) const {
+    int treeLines = pieces_.lineCount();
+    if (line < treeLines) {
+        auto loc = pieces_.find(line);
+        const Piece& piece = *loc.piece;
+        return loc.firstByte + sourceOffset(piece.source, piece.start + loc.offset) -
+               sourceOffset(piece.source, piece.start);
+    }
+    uint64_t bytes = pieces_.byteCount();
+    if (mapped_ && line > treeLines) {
+        bytes += mapped_->textOffset(adopted_ + (line - treeLines)) - mapped_->textOffset(adopted_);
+    }
+    return bytes;
+}
+
+// Byte offset of a position
+// Bir konumun bayt ofseti
+uint64_t PieceTable::offsetOf(int line, int col) const {
+    settle();
+    line = std::clamp(line, 0, lineCount() - 1);
+    int length = static_cast<int>(lineView(line).size());
+    return bytesBefore(line) + static_cast<uint64_t>(std::clamp(col, 0, length));
+}
 
-        // Split after this line if needed
-        // Gerekirse bu satirdan sonra bol
-        auto& p = pieces_[pos.pieceIdx];
-        if (p.count > 1) {
-            splitPiece(pos.pieceIdx, 1);
+// Add buffer bytes under the pieces covering a line range
+// Bir satir araligini kapsayan parcalarin altindaki ekleme arabellegi baytlari
+uint64_t PieceTable::addBytes(int firstLine, int count) const {
+    settle();
+    uint64_t bytes = 0;
+    pieces_.forRange(firstLine, count, [&](const Piece& piece, int, int offset, int n) {
+        if (piece.source == Source::Add) {
+            bytes += add_.offsetOf(piece.start + offset + n) - add_.offsetOf(piece.start + offset);
         }
+        return true;
+    });
+    return bytes;
+}
 
-        // Replace the single-line piece with an Add piece
-        // Tek satirlik parcayi Add parcasiyla degistir
-        pieces_[pos.pieceIdx] = {Source::Add, addIdx, 1};
-        return add_[addIdx];
+// Position of a byte offset: descend by bytes to the piece, then search its lines
+// Bir bayt ofsetinin konumu: baytlarla parcaya in, sonra satirlarinda ara
+TextPosition PieceTable::positionOf(uint64_t offset) const {
+    settle();
+    offset = std::min(offset, byteCount());
+    int treeLines = pieces_.lineCount();
+    uint64_t treeBytes = pieces_.byteCount();
+
+    int line;
+    uint64_t lineStart;
+    if (offset < treeBytes || lineCount() == treeLines) {
+        auto loc = pieces_.findByte(offset);
+        const Piece& piece = *loc.piece;
+        uint64_t base = sourceOffset(piece.source, piece.start);
+        int k = lineAtSourceOffset(piece.source, piece.start, piece.count, base + (offset - loc.firstByte));
+        line = loc.firstLine + k;
+        lineStart = loc.firstByte + sourceOffset(piece.source, piece.start + k) - base;
+    } else {
+        // Offset falls in the lines still waiting to be adopted from the mapping
+        // Ofset eslemeden alinmayi bekleyen satirlara duser
+        uint64_t base = mapped_->textOffset(adopted_);
+        int k = lineAtSourceOffset(Source::Original, adopted_, lineCount() - treeLines, base + (offset - treeBytes));
+        line = treeLines + k;
+        lineStart = treeBytes + mapped_->textOffset(adopted_ + k) - base;
     }
+    return {line, static_cast<int>(offset - lineStart)};
+}
 
-    // Already in add buffer, return directly
-    // Zaten ekleme arabelleginde, dogrudan dondur
-    return add_[piece.start + pos.offset];
+// Length of the text: every line but the last ends in '\n'
+// Metnin uzunlugu: son satir haric her satir '\n' ile biter
+uint64_t PieceTable::byteCount() const {
+    settle();
+    return bytesBefore(lineCount()) - 1;
 }
 
 // Total number of logical lines
 // Toplam mantiksal satir sayisi
 int PieceTable::lineCount() const {
-    return lineCount_;
+    return pieces_.lineCount() + pendingLines();
 }
 
 // Number of characters in a given line
 // Verilen satirdaki karakter sayisi
 int PieceTable::columnCount(int line) const {
-    if (line < 0 || line >= lineCount_) return 0;
-    auto pos = findLine(line);
-    return static_cast<int>(lineAtConst(pieces_[pos.pieceIdx], pos.offset).size());
+    if (line < 0 || line >= lineCount()) return 0;
+    return static_cast<int>(lineView(line).size());
 }
 
 // Insert a new line at the given index
 // Verilen indekse yeni satir ekle
 void PieceTable::insertLineAt(int index, const std::string& line) {
+    settle();
+    adoptPending();
+    maybeCollect();
+    int total = lineCount();
     if (index < 0) index = 0;
-    if (index > lineCount_) index = lineCount_;
+    if (index > total) index = total;
 
-    int addIdx = static_cast<int>(add_.size());
-    add_.push_back(line);
+    int addIdx = add_.push(line);
 
-    if (pieces_.empty() || lineCount_ == 0) {
-        // Buffer is empty, just set this as the only piece
-        // Arabellek bos, bunu tek parca olarak ayarla
-        pieces_.clear();
-        pieces_.push_back({Source::Add, addIdx, 1});
-        lineCount_ = 1;
-        return;
-    }
-
-    if (index == lineCount_) {
-        // Append at end: check if we can extend the last piece
-        // Sona ekle: son parcayi genisletebilir miyiz kontrol et
-        auto& last = pieces_.back();
-        if (last.source == Source::Add && last.start + last.count == addIdx) {
-            last.count++;
-        } else {
-            pieces_.push_back({Source::Add, addIdx, 1});
-        }
-        lineCount_++;
-        return;
-    }
-
-    // Insert in the middle: find the piece and split
-    // Ortaya ekle: parcayi bul ve bol
-    auto pos = findLine(index);
-
-    if (pos.offset > 0) {
-        splitPiece(pos.pieceIdx, pos.offset);
-        pos.pieceIdx++;
-    }
-
-    pieces_.insert(pieces_.begin() + pos.pieceIdx, {Source::Add, addIdx, 1});
-    lineCount_++;
+    // The tree splits the piece at index if needed, or extends a contiguous Add predecessor
+    // Agac gerekirse index'teki parcayi boler veya bitisik Add onculunu genisletir
+    pieces_.insert(index, {Source::Add, addIdx, 1}, measure());
 }
 
 // Append a line at the end
 // Sona satir ekle
 void PieceTable::appendLine(const std::string& line) {
-    insertLineAt(lineCount_, line);
+    insertLineAt(lineCount(), line);
 }
 
 // Delete the line at the given index
 // Verilen indeksteki satiri sil
 void PieceTable::deleteLine(int index) {
-    if (index < 0 || index >= lineCount_) return;
-
-    auto pos = findLine(index);
-    auto& piece = pieces_[pos.pieceIdx];
-
-    if (piece.count == 1) {
-        // Remove entire piece
-        // Tum parcayi kaldir
-        pieces_.erase(pieces_.begin() + pos.pieceIdx);
-    } else if (pos.offset == 0) {
-        // First line of piece: adjust start and count
-        // Parcanin ilk satiri: baslangic ve sayiyi ayarla
-        piece.start++;
-        piece.count--;
-    } else if (pos.offset == piece.count - 1) {
-        // Last line of piece: adjust count
-        // Parcanin son satiri: sayiyi ayarla
-        piece.count--;
-    } else {
-        // Middle of piece: split and remove
-        // Parcanin ortasi: bol ve kaldir
-        splitPiece(pos.pieceIdx, pos.offset);
-        auto& second = pieces_[pos.pieceIdx + 1];
-        second.start++;
-        second.count--;
-        if (second.count == 0) {
-            pieces_.erase(pieces_.begin() + pos.pieceIdx + 1);
-        }
+    settle();
+    adoptPending();
+    if (index < 0 || index >= lineCount()) return;
+
+    if (pieces_.find(index).piece->source == Source::Add) ++deadAdd_;
+    pieces_.erase(index, 1, measure());
+    lastEdit_ = std::chrono::steady_clock::now();
+
+    // Keep at least one empty line
+    // En az bir bos satir tut
+    if (lineCount() == 0) {
+        int addIdx = add_.push(std::string());
+        pieces_.insert(0, {Source::Add, addIdx, 1}, measure());
     }
+}
 
-    lineCount_--;
+// Count the Add lines of the range as dead, then cut the range out of the tree
+// Araligin Add satirlarini olu say, sonra araligi agactan kes
+void PieceTable::eraseLines(int first, int count) {
+    settle();
+    adoptPending();
+    int total = lineCount();
+    if (first < 0) first = 0;
+    if (count > total - first) count = total - first;
+    if (count <= 0) return;
+
+    pieces_.forRange(first, count, [this](const Piece& piece, int, int, int n) {
+        if (piece.source == Source::Add) deadAdd_ += n;
+        return true;
+    });
+    pieces_.erase(first, count, measure());
+    lastEdit_ = std::chrono::steady_clock::now();
 
     // Keep at least one empty line
     // En az bir bos satir tut
-    if (lineCount_ == 0) {
-        add_.push_back("");
-        pieces_.push_back({Source::Add, static_cast<int>(add_.size()) - 1, 1});
-        lineCount_ = 1;
+    if (lineCount() == 0) {
+        int addIdx = add_.push(std::string());
+        pieces_.insert(0, {Source::Add, addIdx, 1}, measure());
+    }
+}
+
+// Same storage id means both tables number their sources identically, and the lines a
+// snapshot sees are frozen, so its descriptors still name the same text here
+// Ayni depolama kimligi iki tablonun kaynaklarini ayni numaralandirdigi anlamina gelir ve bir
+// anlik goruntunun gordugu satirlar donmustur; bu yuzden tanimlayicilari burada da ayni metni gosterir
+void PieceTable::insertLinesFrom(int index, const PieceTable& from, int first, int count) {
+    settle();
+    adoptPending();
+    maybeCollect();
+    if (first < 0) first = 0;
+    if (count > from.lineCount() - first) count = from.lineCount() - first;
+    if (count <= 0) return;
+    int total = lineCount();
+    if (index < 0) index = 0;
+    if (index > total) index = total;
+
+    if (&from != this && from.storageId_ == storageId_) {
+        int at = index;
+        from.pieces_.forRange(first, count, [&](const Piece& piece, int, int offset, int n) {
+            pieces_.insert(at, {piece.source, piece.start + offset, n}, measure());
+            if (piece.source == Source::Add) deadAdd_ = std::max(0, deadAdd_ - n);
+            at += n;
+            return true;
+        });
+    } else {
+        int start = add_.size();
+        from.forEachChunk(first, count, [this](int, const std::string_view* lines, int n) {
+            for (int i = 0; i < n; ++i) add_.push(std::string(lines[i]));
+            return true;
+        });
+        pieces_.insert(index, {Source::Add, start, add_.size() - start}, measure());
     }
+    lastEdit_ = std::chrono::steady_clock::now();
 }
 
 // Replace the content of a line (COW for original lines)
 // Bir satirin icerigini degistir (orijinal satirlar icin COW)
 void PieceTable::setLine(int index, const std::string& content) {
-    if (index < 0 || index >= lineCount_) return;
+    if (index < 0 || index >= lineCount()) return;
     std::string& ref = getLineRef(index);
     ref = content;
 }
@@ -227,93 +370,389 @@ void PieceTable::setLine(int index, const std::string& content) {
 // Check if (line, col) is a valid position
 // (satir, sutun) gecerli bir konum mu kontrol et
 bool PieceTable::isValidPos(int line, int col) const {
-    if (line < 0 || line >= lineCount_) return false;
-    auto pos = findLine(line);
-    int len = static_cast<int>(lineAtConst(pieces_[pos.pieceIdx], pos.offset).size());
+    if (line < 0 || line >= lineCount()) return false;
+    int len = static_cast<int>(lineView(line).size());
     return col >= 0 && col <= len;
 }
 
 // Load lines in bulk (move), replacing all content
 // Toplu satir yukleme (tasima), tum icerigi degistirir
 void PieceTable::loadLines(std::vector<std::string>&& lines) {
-    original_ = std::move(lines);
-    add_.clear();
-    pieces_.clear();
-
-    if (original_.empty()) {
-        original_.push_back("");
-    }
-
-    pieces_.push_back({Source::Original, 0, static_cast<int>(original_.size())});
-    lineCount_ = static_cast<int>(original_.size());
+    cancelLoading();
+    mapped_.reset();
+    adopted_ = 0;
+    if (lines.empty()) lines.emplace_back();
+    original_ = std::make_shared<const std::vector<std::string>>(std::move(lines));
+
+    // Prefix sums of the original lines, shared with snapshots like the lines themselves
+    // Orijinal satirlarin onek toplamlari, satirlarin kendisi gibi anlik goruntulerle paylasilir
+    auto offsets = std::make_shared<std::vector<uint64_t>>(original_->size() + 1);
+    for (size_t i = 0; i < original_->size(); ++i) (*offsets)[i + 1] = (*offsets)[i] + (*original_)[i].size() + 1;
+    originalOffsets_ = std::move(offsets);
+    resetAdd();
+    pieces_.assign({{Source::Original, 0, static_cast<int>(original_->size())}}, measure());
 }
 
 // Load lines in bulk (copy), replacing all content
 // Toplu satir yukleme (kopyalama), tum icerigi degistirir
 void PieceTable::loadLines(const std::vector<std::string>& lines) {
-    original_ = lines;
-    add_.clear();
-    pieces_.clear();
+    loadLines(std::vector<std::string>(lines));
+}
 
-    if (original_.empty()) {
-        original_.push_back("");
+// Install a memory-mapped file as the Original source
+// Bellek eslemeli bir dosyayi Original kaynagi olarak yerlestir
+void PieceTable::loadMapped(std::shared_ptr<MappedFile> file) {
+    cancelLoading();
+    original_.reset();
+    originalOffsets_.reset();
+    resetAdd();
+    mapped_ = std::move(file);
+    adopted_ = 0;
+
+    int lines = mapped_ ? mapped_->lineCount() : 0;
+    if (lines == 0 && (!mapped_ || mapped_->isComplete())) {
+        // Empty file: a single empty line of our own
+        // Bos dosya: kendimize ait tek bos satir
+        mapped_.reset();
+        pieces_.assign({{Source::Add, add_.push(std::string()), 1}}, measure());
+        return;
     }
 
-    pieces_.push_back({Source::Original, 0, static_cast<int>(original_.size())});
-    lineCount_ = static_cast<int>(original_.size());
+    pieces_.assign(lines > 0 ? std::vector<Piece>{{Source::Original, 0, lines}} : std::vector<Piece>{}, measure());
+    adopted_ = lines;
+}
+
+// Loading while the mapping has lines left to index
+// Eslemenin indekslenecek satirlari kaldikca yukleniyor
+bool PieceTable::isLoading() const {
+    if (sealed_) return sealedLoading_;
+    return mapped_ && !mapped_->isComplete();
+}
+
+// Wait for the background indexer to finish
+// Arka plan indeksleyicinin bitmesini bekle
+void PieceTable::waitLoaded() const {
+    if (mapped_) mapped_->waitIndexed();
+}
+
+// Nothing mapped means nothing left to load
+// Eslenmis bir sey yoksa yuklenecek bir sey de yoktur
+bool PieceTable::awaitLoaded(const std::atomic<bool>& cancel) const {
+    return !mapped_ || mapped_->awaitIndexer(cancel);
+}
+
+// Stop the background indexer, keeping what has been indexed
+// Arka plan indeksleyiciyi durdur, indekslenenleri koru
+void PieceTable::cancelLoading() {
+    if (mapped_) mapped_->stopIndexing();
+}
+
+// Check if the Original source is memory-mapped
+// Original kaynaginin bellek eslemeli olup olmadigini kontrol et
+bool PieceTable::isMapped() const {
+    return mapped_ != nullptr;
+}
+
+// Path of the mapped file, or empty
+// Eslenmis dosyanin yolu veya bos
+std::string PieceTable::mappedPath() const {
+    return mapped_ ? mapped_->path() : std::string();
+}
+
+// Snapshots share the mapping, so one lost mapping condemns them all
+// Anlik goruntuler eslemeyi paylasir, bu yuzden kayip bir esleme hepsini gecersiz kilar
+bool PieceTable::originalLost() const {
+    return mapped_ && mapped_->checkTruncation();
+}
+
+// The mapping is copied, not replaced, so line views handed out earlier stay valid
+// Esleme degistirilmez kopyalanir, boylece daha once verilen satir gorunumleri gecerli kalir
+bool PieceTable::detachFromFile(const std::string& path) const {
+    if (!mapped_ || !mapped_->mapsFile(path)) return true;
+    return mapped_->detachFromFile();
 }
 
 // Clear all content, reset to single empty line
 // Tum icerigi temizle, tek bos satira sifirla
 void PieceTable::clear() {
-    original_.clear();
-    add_.clear();
-    add_.push_back("");
-    pieces_.clear();
-    pieces_.push_back({Source::Add, 0, 1});
-    lineCount_ = 1;
+    cancelLoading();
+    mapped_.reset();
+    adopted_ = 0;
+    original_.reset();
+    originalOffsets_.reset();
+    resetAdd();
+    pieces_.assign({{Source::Add, add_.push(std::string()), 1}}, measure());
+}
+
+// Walk the pieces in order, then the lines indexed since the last adoption
+// Parcalari sirayla gez, sonra son alimdan beri indekslenen satirlari
+void PieceTable::forEachLine(const std::function<void(int line, std::string_view text)>& fn) const {
+    int line = 0;
+    pieces_.forEach([&](const Piece& piece) {
+        for (int i = 0; i < piece.count; ++i) fn(line++, lineAtConst(piece, i));
+    });
+    for (int i = 0, n = pendingLines(); i < n; ++i) {
+        fn(line++, mapped_->line(adopted_ + i));
+    }
+}
+
+// Hand out each piece slice in runs of views; lines past the tree come from the mapping
+// Her parca dilimini gorunum dizileri halinde ver; agacin otesindeki satirlar eslemeden gelir
+void PieceTable::forEachChunk(int firstLine, int count, const ChunkFn& fn) const {
+    if (firstLine < 0) {
+        count += firstLine;
+        firstLine = 0;
+    }
+    count = std::min(count, lineCount() - firstLine);
+    if (count <= 0) return;
+
+    constexpr int kMaxChunk = 1024;
+    std::vector<std::string_view> views;
+    views.reserve(std::min(count, kMaxChunk));
+    auto emit = [&](int first, int n, auto&& viewAt) {
+        for (int done = 0; done < n;) {
+            int run = std::min(kMaxChunk, n - done);
+            views.clear();
+            for (int i = 0; i < run; ++i) views.push_back(viewAt(done + i));
+            if (!fn(first + done, views.data(), run)) return false;
+            done += run;
+        }
+        return true;
+    };
+
+    bool more = pieces_.forRange(firstLine, count, [&](const Piece& piece, int first, int offset, int n) {
+        return emit(first, n, [&](int i) { return lineAtConst(piece, offset + i); });
+    });
+
+    int treeLines = pieces_.lineCount();
+    int end = firstLine + count;
+    if (more && end > treeLines) {
+        int from = std::max(firstLine, treeLines);
+        int base = adopted_ + (from - treeLines);
+        emit(from, end - from, [&](int i) { return mapped_->line(base + i); });
+    }
+}
+
+// Iterator positioned on one line
+// Tek bir satira konumlanmis yineleyici
+PieceTable::LineIterator PieceTable::lineAt(int line) const {
+    return LineIterator(this, line);
+}
+
+// Iterator on the first line
+// Ilk satirdaki yineleyici
+PieceTable::LineIterator PieceTable::begin() const {
+    return LineIterator(this, 0);
+}
+
+// Iterator one past the last line counted so far (a file still loading keeps growing)
+// Su ana kadar sayilan son satirin bir otesindeki yineleyici (hala yuklenen bir dosya buyumeye devam eder)
+PieceTable::LineIterator PieceTable::end() const {
+    return LineIterator(this, lineCount());
+}
+
+PieceTable::LineIterator::LineIterator(const PieceTable* table, int line)
+    : table_(table), line_(line) {
+    seek();
+}
+
+// Cache the piece for line_; lines outside the tree are served by lineView
+// line_ icin parcayi onbellege al; agac disindaki satirlar lineView ile sunulur
+void PieceTable::LineIterator::seek() {
+    piece_ = nullptr;
+    offset_ = 0;
+    if (!table_ || line_ < 0 || line_ >= table_->pieces_.lineCount()) return;
+    auto loc = table_->pieces_.find(line_);
+    piece_ = loc.piece;
+    offset_ = loc.offset;
+}
+
+std::string_view PieceTable::LineIterator::operator*() const {
+    if (piece_) return table_->lineAtConst(*piece_, offset_);
+    return table_ ? table_->lineView(line_) : std::string_view();
+}
+
+// Step within the cached piece, or look up the neighbouring one
+// Onbellekteki parca icinde ilerle veya komsu parcayi ara
+PieceTable::LineIterator& PieceTable::LineIterator::operator++() {
+    ++line_;
+    if (piece_ && offset_ + 1 < piece_->count) ++offset_;
+    else seek();
+    return *this;
+}
+
+PieceTable::LineIterator PieceTable::LineIterator::operator++(int) {
+    LineIterator prev = *this;
+    ++*this;
+    return prev;
+}
+
+PieceTable::LineIterator& PieceTable::LineIterator::operator--() {
+    --line_;
+    if (piece_ && offset_ > 0) --offset_;
+    else seek();
+    return *this;
+}
+
+PieceTable::LineIterator PieceTable::LineIterator::operator--(int) {
+    LineIterator prev = *this;
+    --*this;
+    return prev;
 }
 
 // Get all lines as a materialized vector
 // Tum satirlari somutlastirilmis vektor olarak al
 std::vector<std::string> PieceTable::allLines() const {
     std::vector<std::string> result;
-    result.reserve(lineCount_);
-    for (const auto& piece : pieces_) {
-        const auto& buf = (piece.source == Source::Original) ? original_ : add_;
-        for (int i = 0; i < piece.count; ++i) {
-            result.push_back(buf[piece.start + i]);
-        }
-    }
+    result.reserve(lineCount());
+    forEachLine([&result](int, std::string_view text) { result.emplace_back(text); });
     return result;
 }
 
 // Get the number of pieces (for diagnostics)
 // Parca sayisini al (tanilar icin)
 int PieceTable::pieceCount() const {
-    return static_cast<int>(pieces_.size());
+    return pieces_.pieceCount();
 }
 
 // Merge adjacent pieces from the same source when contiguous
 // Bitisik oldugunda ayni kaynaktan parcalari birlestir
 void PieceTable::compact() {
-    if (pieces_.size() <= 1) return;
+    settle();
+    adoptPending();
+    if (pieces_.pieceCount() <= 1) return;
 
     std::vector<Piece> merged;
-    merged.push_back(pieces_[0]);
-
-    for (size_t i = 1; i < pieces_.size(); ++i) {
-        auto& prev = merged.back();
-        const auto& cur = pieces_[i];
-
-        if (prev.source == cur.source && prev.start + prev.count == cur.start) {
-            // Contiguous pieces from same source: merge
-            // Ayni kaynaktan bitisik parcalar: birlestir
-            prev.count += cur.count;
-        } else {
-            merged.push_back(cur);
+    pieces_.forEach([&merged](const Piece& cur) {
+        if (!merged.empty()) {
+            auto& prev = merged.back();
+            if (prev.source == cur.source && prev.start + prev.count == cur.start) {
+                // Contiguous pieces from same source: merge
+                // Ayni kaynaktan bitisik parcalar: birlestir
+                prev.count += cur.count;
+                return;
+            }
         }
+        merged.push_back(cur);
+    });
+
+    pieces_.assign(merged, measure());
+}
+
+// Check the ratio and idle triggers, then note this edit
+// Oran ve bosta kalma tetikleyicilerini kontrol et, sonra bu duzenlemeyi kaydet
+void PieceTable::maybeCollect() {
+    auto now = std::chrono::steady_clock::now();
+    if (deadAdd_ > 0) {
+        int minDead = gcMinDead_.load(std::memory_order_relaxed);
+        int percent = gcDeadPercent_.load(std::memory_order_relaxed);
+        int idle = gcIdleSeconds_.load(std::memory_order_relaxed);
+
+        bool ratioHit = percent > 0 && deadAdd_ >= minDead &&
+                        static_cast<int64_t>(deadAdd_) * 100 >= static_cast<int64_t>(add_.size()) * percent;
+        bool idleHit = idle > 0 && now - lastEdit_ >= std::chrono::seconds(idle);
+        if (ratioHit || idleHit) collectGarbage();
     }
+    lastEdit_ = now;
+}
+
+// Move live add lines into a fresh store in document order and renumber the Add pieces.
+// Canli ekleme satirlarini belge sirasiyla yeni bir depoya tasi ve Add parcalarini yeniden numarala.
+// Lines a snapshot can still see are copied rather than moved, and the snapshot keeps the old
+// store; undo records that reference a snapshot fall back to copying once the id changes.
+// Bir anlik goruntunun hala gorebildigi satirlar tasinmak yerine kopyalanir ve anlik goruntu eski
+// depoyu korur; bir anlik goruntuye basvuran geri alma kayitlari kimlik degisince kopyalamaya doner.
+int PieceTable::collectGarbage() {
+    settle();
+    if (deadAdd_ == 0) return 0;
+
+    LineStore live;
+    std::vector<Piece> remapped;
+    remapped.reserve(pieces_.pieceCount());
+
+    pieces_.forEach([&](const Piece& piece) {
+        Piece next = piece;
+        if (piece.source == Source::Add) {
+            next.start = live.size();
+            for (int i = 0; i < piece.count; ++i) {
+                int idx = piece.start + i;
+                if (idx < frozenAdd_) live.push(add_[idx]);
+                else live.push(std::move(add_.at(idx)));
+            }
+        }
+        // Renumbered Add pieces are contiguous now: merge them
+        // Yeniden numaralanan Add parcalari artik bitisik: birlestir
+        if (!remapped.empty()) {
+            auto& prev = remapped.back();
+            if (prev.source == next.source && prev.start + prev.count == next.start) {
+                prev.count += next.count;
+                return;
+            }
+        }
+        remapped.push_back(next);
+    });
+
+    int freed = add_.size() - live.size();
+    add_ = std::move(live);
+    frozenAdd_ = 0;
+    storageId_ = nextStorageId_++;
+    pieces_.assign(remapped, measure());
+    deadAdd_ = 0;
+    return freed;
+}
+
+// Dead add lines tracked since the last collection
+// Son toplamadan beri izlenen olu ekleme satirlari
+int PieceTable::deadLines() const {
+    return deadAdd_;
+}
+
+// Current add buffer length
+// Mevcut ekleme arabellegi uzunlugu
+int PieceTable::addBufferSize() const {
+    return add_.size();
+}
+
+// Set the GC triggers for every piece table
+// Tum piece table'lar icin GC tetikleyicilerini ayarla
+void PieceTable::setGcPolicy(int deadPercent, int minDead, int idleSeconds) {
+    gcDeadPercent_ = deadPercent < 0 ? 0 : deadPercent;
+    gcMinDead_ = minDead < 1 ? 1 : minDead;
+    gcIdleSeconds_ = idleSeconds < 0 ? 0 : idleSeconds;
+}
+
+// Empty add buffer with nothing frozen or dead
+// Donmus veya olu satiri olmayan bos ekleme arabellegi
+void PieceTable::resetAdd() {
+    refAdd_ = -1;
+    storageId_ = nextStorageId_++;
+    add_.clear();
+    frozenAdd_ = 0;
+    deadAdd_ = 0;
+}
+
+// Copy the table for a reader: nodes, add chunks and sources are shared, not duplicated.
+// Tabloyu bir okuyucu icin kopyala: dugumler, ekleme parcalari ve kaynaklar paylasilir, cogaltilmaz.
+// From now on this table copies add lines below the current size before writing them.
+// Bundan sonra bu tablo mevcut boyutun altindaki ekleme satirlarini yazmadan once kopyalar.
+std::shared_ptr<const PieceTable> PieceTable::snapshot() const {
+    settle();
+    std::shared_ptr<PieceTable> copy(new PieceTable(*this));
+    copy->adoptPending();
+    copy->sealedLoading_ = copy->isLoading();
+    copy->sealed_ = true;
+    frozenAdd_ = add_.size();
+    return copy;
+}
 
-    pieces_ = std::move(merged);
+// Edits adopt every pending line first, so lines indexed after the seal can only follow it
+// Duzenlemeler once tum bekleyen satirlari alir; muhurden sonra indekslenen satirlar ancak onu izleyebilir
+std::shared_ptr<const PieceTable> PieceTable::completed() const {
+    waitLoaded();
+    std::shared_ptr<PieceTable> copy(new PieceTable(*this));
+    copy->sealed_ = false;
+    copy->adoptPending();
+    copy->sealedLoading_ = false;
+    copy->sealed_ = true;
+    return copy;
 }
@@ -4,37 +4,141 @@
 // See LICENSE file in the project root for full license text.
 
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "LineStore.h"
+#include "PieceTree.h"
+
+class MappedFile;
+
+// A (line, column) position, column in bytes
+// Bir (satir, sutun) konumu, sutun bayt cinsinden
+struct TextPosition {
+    int line = 0;
+    int col = 0;
+};
 
 // Line-based piece table for efficient text storage.
 // Verimli metin depolama icin satir tabanli piece table.
 // Stores original lines immutably; edits go to an append-only add buffer.
 // Orijinal satirlari degistirmez saklar; duzenlemeler yalnizca ekleme arabellegine gider.
+// Pieces live in a balanced tree, so line lookups and edits are O(log pieces).
+// Parcalar dengeli bir agacta tutulur; satir arama ve duzenlemeler O(log parca) olur.
+// snapshot() returns an immutable copy that shares the tree, the add chunks and the
+// original source with this table, so taking it costs O(1) regardless of buffer size.
+// snapshot() bu tabloyla agaci, ekleme parcalarini ve orijinal kaynagi paylasan degismez
+// bir kopya dondurur; bu yuzden almak buffer boyutundan bagimsiz olarak O(1)'dir.
 class PieceTable {
 public:
-    // Piece source: either the original loaded text or the add buffer
-    // Parca kaynagi: ya orijinal yuklenen metin ya da ekleme arabellegi
-    enum class Source { Original, Add };
-
-    // A piece descriptor: points to a contiguous range of lines in a source buffer
-    // Parca tanimlayicisi: bir kaynak arabellekteki bitisik satir araligina isaret eder
-    struct Piece {
-        Source source;
-        int start;   // Starting line index in source buffer / Kaynak arabellekteki baslangic satir indeksi
-        int count;   // Number of lines in this piece / Bu parcadaki satir sayisi
+    // Piece source and descriptor (see PieceTree.h)
+    // Parca kaynagi ve tanimlayicisi (bkz. PieceTree.h)
+    using Source = PieceSource;
+    using Piece = PieceDesc;
+
+    // Chunk visitor: views of `count` consecutive lines starting at `firstLine`; return false to stop
+    // Parca ziyaretcisi: `firstLine`'dan baslayan `count` ardisik satirin gorunumleri; durmak icin false dondur
+    using ChunkFn = std::function<bool(int firstLine, const std::string_view* lines, int count)>;
+
+    // Bidirectional iterator over line views. Stepping inside a piece is O(1); crossing into
+    // the next piece costs one O(log pieces) lookup. Views and the iterator itself stay valid
+    // until the next edit of the table (forever on a snapshot).
+    // Satir gorunumleri uzerinde cift yonlu yineleyici. Bir parca icinde ilerlemek O(1)'dir;
+    // sonraki parcaya gecmek bir O(log parca) arama ister. Gorunumler ve yineleyicinin kendisi
+    // tablonun sonraki duzenlemesine kadar gecerlidir (anlik goruntude surekli).
+    class LineIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        LineIterator() = default;
+
+        // View of the current line (empty past the end)
+        // Mevcut satirin gorunumu (sonun otesinde bos)
+        std::string_view operator*() const;
+
+        // Logical line the iterator points at
+        // Yineleyicinin gosterdigi mantiksal satir
+        int line() const { return line_; }
+
+        LineIterator& operator++();
+        LineIterator operator++(int);
+        LineIterator& operator--();
+        LineIterator operator--(int);
+        bool operator==(const LineIterator& other) const { return table_ == other.table_ && line_ == other.line_; }
+        bool operator!=(const LineIterator& other) const { return !(*this == other); }
+
+    private:
+        friend class PieceTable;
+        LineIterator(const PieceTable* table, int line);
+
+        // Locate the piece holding line_ after a jump or a piece boundary
+        // Bir sicramadan veya parca sinirindan sonra line_'i tutan parcayi bul
+        void seek();
+
+        const PieceTable* table_ = nullptr;
+        int line_ = 0;
+        const Piece* piece_ = nullptr;  // Piece holding line_ (null outside the tree) / line_'i tutan parca (agac disinda null)
+        int offset_ = 0;                // Offset of line_ inside piece_ / line_'in piece_ icindeki ofseti
     };
 
     PieceTable();
+    PieceTable& operator=(const PieceTable&) = delete;
 
     // Get a read-only copy of a line
     // Bir satirin salt okunur kopyasini al
     std::string getLine(int line) const;
 
+    // Get a view of a line (valid until the next edit of this table; forever on a snapshot)
+    // Bir satirin gorunumunu al (bu tablonun sonraki duzenlemesine kadar; anlik goruntude surekli gecerli)
+    std::string_view lineView(int line) const;
+
+    // Visit every line in document order without copying
+    // Her satiri kopyalamadan belge sirasinda ziyaret et
+    void forEachLine(const std::function<void(int line, std::string_view text)>& fn) const;
+
+    // Visit lines [firstLine, firstLine + count) as runs of views, one run per piece slice
+    // (at most 1024 lines each); stops early when fn returns false
+    // [firstLine, firstLine + count) satirlarini parca dilimi basina bir dizi olarak gorunumlerle
+    // ziyaret et (her biri en fazla 1024 satir); fn false dondururse erken durur
+    void forEachChunk(int firstLine, int count, const ChunkFn& fn) const;
+
+    // Iterator at a line (lines outside the document read as empty), and the document bounds
+    // Bir satirdaki yineleyici (belge disindaki satirlar bos okunur) ve belge sinirlari
+    LineIterator lineAt(int line) const;
+    LineIterator begin() const;
+    LineIterator end() const;
+
     // Get a mutable reference (copy-on-write: original lines are copied to add buffer)
     // Degistirilebilir referans al (yazimda kopyala: orijinal satirlar ekleme arabellegine kopyalanir)
     std::string& getLineRef(int line);
 
+    // Byte offset of (line, col) in the text with lines joined by '\n' (both clamped), O(log pieces)
+    // Satirlari '\n' ile birlestirilmis metinde (line, col)'un bayt ofseti (ikisi de sabitlenir), O(log parca)
+    uint64_t offsetOf(int line, int col) const;
+
+    // Bytes of lines [firstLine, firstLine + count) stored in the add buffer (heap), each with
+    // its '\n'; Original lines are shared with the document or mapped and are not counted
+    // [firstLine, firstLine + count) satirlarinin ekleme arabelleginde (yigin) saklanan baytlari,
+    // her biri '\n'siyle; Original satirlar belgeyle paylasilir veya eslenir ve sayilmaz
+    uint64_t addBytes(int firstLine, int count) const;
+
+    // Position of a byte offset (clamped to the end of the text), O(log pieces + log lines in piece)
+    // Bir bayt ofsetinin konumu (metin sonuna sabitlenir), O(log parca + log parcadaki satir)
+    TextPosition positionOf(uint64_t offset) const;
+
+    // Length of the text in bytes, lines joined by '\n'
+    // Satirlar '\n' ile birlestirilmis metnin bayt cinsinden uzunlugu
+    uint64_t byteCount() const;
+
     // Total number of logical lines
     // Toplam mantiksal satir sayisi
     int lineCount() const;
@@ -55,6 +159,18 @@ public:
     // Verilen indeksteki satiri silme
     void deleteLine(int index);
 
+    // Delete `count` lines starting at `first` in one O(log pieces + pieces in range) step
+    // `first`'ten baslayan `count` satiri tek bir O(log parca + araliktaki parca) adimda sil
+    void eraseLines(int first, int count);
+
+    // Insert lines [first, first + count) of `from` at `index`. When `from` is a snapshot of
+    // this table whose storage has not been rewritten since (no GC, clear or load), its piece
+    // descriptors are spliced in and no text is copied; otherwise the lines are copied.
+    // `from`'un [first, first + count) satirlarini `index`'e ekle. `from` bu tablonun, depolamasi
+    // o zamandan beri yeniden yazilmamis (GC, temizleme veya yukleme yok) bir anlik goruntusuyse
+    // parca tanimlayicilari eklenir ve metin kopyalanmaz; aksi halde satirlar kopyalanir.
+    void insertLinesFrom(int index, const PieceTable& from, int first, int count);
+
     // Replace the content of a line (COW for original lines)
     // Bir satirin icerigini degistirme (orijinal satirlar icin COW)
     void setLine(int index, const std::string& content);
@@ -71,6 +187,54 @@ public:
     // Const vektorunden satir yukleme (kopyalama)
     void loadLines(const std::vector<std::string>& lines);
 
+    // Use a memory-mapped file as the Original source, replacing all content.
+    // Bellek eslemeli bir dosyayi Original kaynagi olarak kullan, tum icerigi degistirir.
+    // Lines stay in the mapping until a write copies them into the add buffer.
+    // Satirlar, bir yazma islemi onlari ekleme arabellegine kopyalayana kadar eslemede kalir.
+    // While the file is still being indexed, newly indexed lines appear at the end of the
+    // document and are adopted into the piece tree on the next edit.
+    // Dosya hala indekslenirken yeni indekslenen satirlar belgenin sonunda gorunur ve
+    // bir sonraki duzenlemede parca agacina alinir.
+    void loadMapped(std::shared_ptr<MappedFile> file);
+
+    // Check if the mapped Original source is still being indexed in the background
+    // Eslenmis Original kaynaginin hala arka planda indekslenip indekslenmedigini kontrol et
+    bool isLoading() const;
+
+    // Block until the mapped Original source is fully indexed
+    // Eslenmis Original kaynagi tamamen indekslenene kadar bekle
+    void waitLoaded() const;
+
+    // Wait for the background indexer without indexing the rest inline; false if loading was
+    // cancelled or cancel was set first
+    // Arka plan indeksleyiciyi geri kalani satir ici indekslemeden bekle; yukleme iptal
+    // edildiyse veya once cancel ayarlandiysa false
+    bool awaitLoaded(const std::atomic<bool>& cancel) const;
+
+    // Stop background indexing; lines indexed so far remain the document
+    // Arka plan indekslemeyi durdur; simdiye kadar indekslenen satirlar belge olarak kalir
+    void cancelLoading();
+
+    // Check if the Original source is a memory-mapped file
+    // Original kaynaginin bellek eslemeli bir dosya olup olmadigini kontrol et
+    bool isMapped() const;
+
+    // Path of the mapped Original source (empty if not mapped)
+    // Eslenmis Original kaynaginin yolu (eslenmemisse bos)
+    std::string mappedPath() const;
+
+    // Check the mapped Original source for truncation on disk; true if it lost text, in
+    // which case this content must not be saved (Original lines past the cut read as NULs)
+    // Eslenmis Original kaynagini diskte kesilmeye karsi denetle; metin kaybettiyse true, bu
+    // durumda bu icerik kaydedilmemelidir (kesimin otesindeki Original satirlar NUL okunur)
+    bool originalLost() const;
+
+    // If the mapped Original source is the file at path, copy it into memory so that file can
+    // be rewritten in place; false if the copy failed. Shared with every snapshot of the mapping.
+    // Eslenmis Original kaynagi path'teki dosyaysa, o dosya yerinde yeniden yazilabilsin diye
+    // onu bellege kopyala; kopyalama basarisizsa false. Eslemenin tum anlik goruntuleriyle paylasilir.
+    bool detachFromFile(const std::string& path) const;
+
     // Clear all content, reset to single empty line
     // Tum icerigi temizle, tek bos satira sifirla
     void clear();
@@ -83,34 +247,123 @@ public:
     // Parca sayisini al (tanilar icin)
     int pieceCount() const;
 
+    // Immutable copy of the current content for readers on other threads.
+    // Diger thread'lerdeki okuyucular icin mevcut icerigin degismez kopyasi.
+    // Lines still being indexed are cut off at the count visible now.
+    // Hala indekslenen satirlar su an gorunen sayida kesilir.
+    std::shared_ptr<const PieceTable> snapshot() const;
+
+    // Wait for the mapped source to finish indexing and return this sealed table extended
+    // with the lines indexed since it was taken (they are the untouched tail of the file)
+    // Eslenmis kaynagin indekslemesinin bitmesini bekle ve bu muhurlu tabloyu alindigindan
+    // beri indekslenen satirlarla genisletilmis dondur (bunlar dosyanin dokunulmamis kuyrugu)
+    std::shared_ptr<const PieceTable> completed() const;
+
     // Compact pieces: merge adjacent pieces from the same source
     // Parcalari sikistir: ayni kaynaktan bitisik parcalari birlestir
     void compact();
 
+    // Rewrite the add buffer to hold only lines still referenced by a piece, remapping the
+    // pieces; returns the number of lines freed. Invalidates references from getLineRef.
+    // Ekleme arabellegini yalnizca bir parcanin hala basvurdugu satirlari tutacak sekilde yeniden
+    // yaz ve parcalari yeniden esle; serbest birakilan satir sayisini dondurur. getLineRef
+    // referanslarini gecersiz kilar.
+    int collectGarbage();
+
+    // Add buffer lines no piece references anymore (for diagnostics)
+    // Artik hicbir parcanin basvurmadigi ekleme arabellegi satirlari (tanilar icin)
+    int deadLines() const;
+
+    // Add buffer size in lines (for diagnostics)
+    // Satir cinsinden ekleme arabellegi boyutu (tanilar icin)
+    int addBufferSize() const;
+
+    // Garbage collection policy shared by all piece tables: collect when at least minDead lines
+    // are dead and they make up deadPercent of the add buffer, or on the first edit after
+    // idleSeconds without edits (0 disables that trigger)
+    // Tum piece table'larin paylastigi cop toplama politikasi: en az minDead satir olu ve ekleme
+    // arabelleginin deadPercent'ini olusturuyorsa, veya idleSeconds duzenlemesiz gecen sureden
+    // sonraki ilk duzenlemede topla (0 bu tetikleyiciyi kapatir)
+    static void setGcPolicy(int deadPercent, int minDead, int idleSeconds);
+
 private:
-    std::vector<std::string> original_;  // Immutable original lines / Degistirilemez orijinal satirlar
-    std::vector<std::string> add_;       // Append-only add buffer / Yalnizca ekleme arabellegi
+    // Copies are only made by snapshot(): two writable tables must never share add chunks
+    // Kopyalar yalnizca snapshot() ile yapilir: iki yazilabilir tablo asla ekleme parcalarini paylasmamali
+    PieceTable(const PieceTable&) = default;
 
-    std::vector<Piece> pieces_;          // Piece descriptors / Parca tanimlayicilari
-    int lineCount_ = 0;                  // Cached total line count / Onbelleklenmis toplam satir sayisi
+    std::shared_ptr<const std::vector<std::string>> original_;  // Immutable original lines / Degistirilemez orijinal satirlar
+    std::shared_ptr<const std::vector<uint64_t>> originalOffsets_;  // Byte offset of each original line / Her orijinal satirin bayt ofseti
+    std::shared_ptr<MappedFile> mapped_;  // Mapped original source (replaces original_) / Eslenmis orijinal kaynak (original_ yerine)
+    int adopted_ = 0;                    // Mapped lines already in the tree / Agaca alinmis eslenmis satirlar
+    LineStore add_;                      // Append-only add buffer / Yalnizca ekleme arabellegi
+    mutable int frozenAdd_ = 0;          // Add lines a snapshot may see (copied before writing) / Bir anlik goruntunun gorebilecegi ekleme satirlari (yazmadan once kopyalanir)
+    bool sealed_ = false;                // Snapshot copy: ignores lines indexed later / Anlik goruntu kopyasi: sonradan indekslenen satirlari yok sayar
+    bool sealedLoading_ = false;         // Source was still loading when sealed / Muhurlenirken kaynak hala yukleniyordu
+    uint64_t storageId_;                 // Changes whenever piece descriptors stop being portable / Parca tanimlayicilari tasinamaz hale geldiginde degisir
 
-    // Locate which piece and offset contains a logical line index
-    // Mantiksal satir indeksini iceren parca ve ofset'i bul
-    struct PiecePos {
-        int pieceIdx;
-        int offset;    // Offset within the piece / Parca icindeki ofset
-    };
-    PiecePos findLine(int line) const;
+    // Balanced piece tree; mutable because its byte totals catch up lazily with writes made
+    // through a getLineRef reference (see settle)
+    // Dengeli parca agaci; bayt toplamlari getLineRef referansi uzerinden yapilan yazmalari
+    // tembel olarak yakaladigi icin mutable (bkz. settle)
+    mutable PieceTree pieces_;
+    mutable int refLine_ = 0;            // Logical line of the last handed-out reference / Son verilen referansin mantiksal satiri
+    mutable int refAdd_ = -1;            // Its add index, -1 once settled / Ekleme indeksi, islendikten sonra -1
+    size_t refLength_ = 0;               // Its length when handed out / Verildigindeki uzunlugu
+    int deadAdd_ = 0;                    // Unreferenced add buffer lines / Basvurulmayan ekleme arabellegi satirlari
+    std::chrono::steady_clock::time_point lastEdit_ = std::chrono::steady_clock::now();  // Last mutation / Son degisiklik
+
+    static std::atomic<int> gcDeadPercent_;   // Dead share that triggers GC / GC'yi tetikleyen olu orani
+    static std::atomic<int> gcMinDead_;       // Minimum dead lines for the ratio trigger / Oran tetikleyicisi icin en az olu satir
+    static std::atomic<int> gcIdleSeconds_;   // Idle time that triggers GC / GC'yi tetikleyen bosta kalma suresi
+    static std::atomic<uint64_t> nextStorageId_;  // Storage ids, unique across tables / Tablolar arasi benzersiz depolama kimlikleri
+
+    // Get a view of the line at a piece position
+    // Parca konumundaki satirin gorunumunu al
+    std::string_view lineAtConst(const Piece& piece, int offset) const;
+
+    // Return a reference to an add line and remember it for settle()
+    // Bir ekleme satirina referans dondur ve settle() icin hatirla
+    std::string& handOut(int line, int addIdx);
+
+    // Apply the length change of the last handed-out line to the tree's byte totals.
+    // Only the last add line is ever handed out, so no other stored offset goes stale.
+    // Son verilen satirin uzunluk degisimini agacin bayt toplamlarina uygula.
+    // Yalnizca son ekleme satiri verilir, bu yuzden baska hicbir saklanan ofset bayatlamaz.
+    void settle() const;
+
+    // Byte offset of a line start within its source, and the bytes a piece covers
+    // Bir satir basinin kendi kaynagindaki bayt ofseti ve bir parcanin kapsadigi baytlar
+    uint64_t sourceOffset(Source source, int index) const;
+    uint64_t measurePiece(const Piece& piece) const;
+    PieceTree::MeasureFn measure() const;
+
+    // Last line of source[start, start + count) whose start offset is <= target
+    // Baslangic ofseti <= target olan source[start, start + count) icindeki son satir
+    int lineAtSourceOffset(Source source, int start, int count, uint64_t target) const;
+
+    // Bytes of all lines before a line (line may equal lineCount())
+    // Bir satirdan onceki tum satirlarin baytlari (line lineCount()'a esit olabilir)
+    uint64_t bytesBefore(int line) const;
+
+    // Get a view of a line in the Original source (vector or mapping)
+    // Original kaynagindaki bir satirin gorunumunu al (vektor veya esleme)
+    std::string_view originalLine(int index) const;
+
+    // Mapped lines indexed after the last adoption
+    // Son alimdan sonra indekslenen eslenmis satirlar
+    int pendingLines() const;
 
-    // Split a piece at the given offset (offset becomes start of new piece)
-    // Verilen ofset'te parcayi bol (ofset yeni parcanin baslangici olur)
-    void splitPiece(int pieceIdx, int offset);
+    // Append pending mapped lines to the tree (called before every edit)
+    // Bekleyen eslenmis satirlari agaca ekle (her duzenlemeden once cagrilir)
+    void adoptPending();
 
-    // Recalculate cached line count
-    // Onbelleklenmis satir sayisini yeniden hesapla
-    void recalcLineCount();
+    // Run collectGarbage if the policy says so; only called where add_ may grow anyway,
+    // so callers already expect getLineRef references to be invalidated there
+    // Politika gerektiriyorsa collectGarbage calistir; yalnizca add_'in zaten buyuyebilecegi
+    // yerlerde cagrilir, boylece cagiranlar orada getLineRef referanslarinin gecersizlesmesini bekler
+    void maybeCollect();
 
-    // Get line reference from a piece position
-    // Parca konumundan satir referansi al
-    const std::string& lineAtConst(const Piece& piece, int offset) const;
+    // Empty the add buffer and its bookkeeping
+    // Ekleme arabellegini ve kayitlarini bosalt
+    void resetAdd();
 };
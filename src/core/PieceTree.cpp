@@ -0,0 +1,410 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "PieceTree.h"
+#include <algorithm>
+#include <atomic>
+
+// Tree node: one piece plus subtree aggregates
+// Agac dugumu: bir parca arti alt agac toplamlari
+struct PieceTree::Node {
+    PieceDesc piece;
+    int height = 1;   // AVL height / AVL yuksekligi
+    int lines = 0;    // Lines in this subtree / Bu alt agactaki satirlar
+    int pieces = 0;   // Pieces in this subtree / Bu alt agactaki parcalar
+    uint64_t pieceBytes = 0;  // Bytes of this node's piece / Bu dugumun parcasinin baytlari
+    uint64_t bytes = 0;       // Bytes in this subtree / Bu alt agactaki baytlar
+    NodePtr left;
+    NodePtr right;
+};
+
+// Construction, copies and moves: copies share every node until one of them is edited
+// Kurulum, kopyalar ve tasimalar: kopyalar biri duzenlenene kadar tum dugumleri paylasir
+PieceTree::PieceTree() = default;
+PieceTree::~PieceTree() = default;
+PieceTree::PieceTree(const PieceTree&) = default;
+PieceTree& PieceTree::operator=(const PieceTree&) = default;
+PieceTree::PieceTree(PieceTree&&) noexcept = default;
+PieceTree& PieceTree::operator=(PieceTree&&) noexcept = default;
+
+// Copy a shared node; its children become shared by both copies
+// Paylasilan bir dugumu kopyala; cocuklari iki kopya tarafindan paylasilir
+void PieceTree::own(NodePtr& n) {
+    if (!n) return;
+    if (n.use_count() > 1) {
+        n = std::make_shared<Node>(*n);
+    } else {
+        // Pair with the release of a reader that just dropped its reference
+        // Referansini yeni birakan bir okuyucunun release'i ile eslestir
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+}
+
+// Null-safe aggregate accessors
+// Null-guvenli toplam erisimcileri
+int PieceTree::heightOf(const Node* n) { return n ? n->height : 0; }
+int PieceTree::linesOf(const Node* n) { return n ? n->lines : 0; }
+// Pieces in a subtree, so pieceCount is O(1)
+// Bir alt agactaki parca sayisi, boylece pieceCount O(1) olur
+int PieceTree::piecesOf(const Node* n) { return n ? n->pieces : 0; }
+// Bytes in a subtree, used to find the line holding an offset
+// Bir alt agactaki bayt sayisi, bir ofseti tutan satiri bulmak icin kullanilir
+uint64_t PieceTree::bytesOf(const Node* n) { return n ? n->bytes : 0; }
+
+// Recompute height and aggregates from children
+// Yukseklik ve toplamlari cocuklardan yeniden hesapla
+void PieceTree::update(Node* n) {
+    n->height = 1 + std::max(heightOf(n->left.get()), heightOf(n->right.get()));
+    n->lines  = linesOf(n->left.get()) + n->piece.count + linesOf(n->right.get());
+    n->pieces = piecesOf(n->left.get()) + 1 + piecesOf(n->right.get());
+    n->bytes  = bytesOf(n->left.get()) + n->pieceBytes + bytesOf(n->right.get());
+}
+
+// Allocate a leaf node for a piece
+// Bir parca icin yaprak dugum ayir
+PieceTree::NodePtr PieceTree::makeNode(const PieceDesc& piece, uint64_t bytes) {
+    auto n = std::make_shared<Node>();
+    n->piece = piece;
+    n->pieceBytes = bytes;
+    update(n.get());
+    return n;
+}
+
+// Single left rotation
+// Tek sola dondurme
+PieceTree::NodePtr PieceTree::rotateLeft(NodePtr n) {
+    NodePtr r = std::move(n->right);
+    own(r);
+    n->right = std::move(r->left);
+    update(n.get());
+    r->left = std::move(n);
+    update(r.get());
+    return r;
+}
+
+// Single right rotation
+// Tek saga dondurme
+PieceTree::NodePtr PieceTree::rotateRight(NodePtr n) {
+    NodePtr l = std::move(n->left);
+    own(l);
+    n->left = std::move(l->right);
+    update(n.get());
+    l->right = std::move(n);
+    update(l.get());
+    return l;
+}
+
+// Restore the AVL invariant at a node whose children differ in height by at most 2
+// Cocuklarinin yukseklik farki en fazla 2 olan dugumde AVL degismezini geri yukle
+PieceTree::NodePtr PieceTree::rebalance(NodePtr n) {
+    update(n.get());
+    int balance = heightOf(n->left.get()) - heightOf(n->right.get());
+    if (balance > 1) {
+        if (heightOf(n->left->left.get()) < heightOf(n->left->right.get())) {
+            own(n->left);
+            n->left = rotateLeft(std::move(n->left));
+        }
+        return rotateRight(std::move(n));
+    }
+    if (balance < -1) {
+        if (heightOf(n->right->right.get()) < heightOf(n->right->left.get())) {
+            own(n->right);
+            n->right = rotateRight(std::move(n->right));
+        }
+        return rotateLeft(std::move(n));
+    }
+    return n;
+}
+
+// Join two trees around a middle node (all of left < mid < all of right), O(|height diff|)
+// Iki agaci bir orta dugum etrafinda birlestir (sol < orta < sag), O(|yukseklik farki|)
+PieceTree::NodePtr PieceTree::join(NodePtr left, NodePtr mid, NodePtr right) {
+    int hl = heightOf(left.get());
+    int hr = heightOf(right.get());
+    if (hl > hr + 1) {
+        own(left);
+        left->right = join(std::move(left->right), std::move(mid), std::move(right));
+        return rebalance(std::move(left));
+    }
+    if (hr > hl + 1) {
+        own(right);
+        right->left = join(std::move(left), std::move(mid), std::move(right->left));
+        return rebalance(std::move(right));
+    }
+    own(mid);
+    mid->left = std::move(left);
+    mid->right = std::move(right);
+    update(mid.get());
+    return mid;
+}
+
+// Detach the leftmost node of a subtree
+// Bir alt agacin en soldaki dugumunu ayir
+PieceTree::NodePtr PieceTree::removeMin(NodePtr n, NodePtr& minOut) {
+    own(n);
+    if (!n->left) {
+        NodePtr rest = std::move(n->right);
+        minOut = std::move(n);
+        update(minOut.get());
+        return rest;
+    }
+    n->left = removeMin(std::move(n->left), minOut);
+    return rebalance(std::move(n));
+}
+
+// Concatenate two trees (all of left before all of right)
+// Iki agaci ard arda ekle (sol tamamen sagdan once)
+PieceTree::NodePtr PieceTree::concat(NodePtr left, NodePtr right) {
+    if (!left) return right;
+    if (!right) return left;
+    NodePtr mid;
+    right = removeMin(std::move(right), mid);
+    return join(std::move(left), std::move(mid), std::move(right));
+}
+
+// Split a tree so that outLeft holds exactly `line` lines; a straddling piece is cut in two
+// Agaci outLeft tam olarak `line` satir tutacak sekilde bol; aradaki parca ikiye kesilir
+void PieceTree::split(NodePtr n, int line, NodePtr& outLeft, NodePtr& outRight, const MeasureFn& measure) {
+    if (!n) {
+        outLeft.reset();
+        outRight.reset();
+        return;
+    }
+
+    own(n);
+    NodePtr left = std::move(n->left);
+    NodePtr right = std::move(n->right);
+    int leftLines = linesOf(left.get());
+
+    if (line <= leftLines) {
+        NodePtr ll, lr;
+        split(std::move(left), line, ll, lr, measure);
+        outLeft = std::move(ll);
+        outRight = join(std::move(lr), std::move(n), std::move(right));
+    } else if (line >= leftLines + n->piece.count) {
+        NodePtr rl, rr;
+        split(std::move(right), line - leftLines - n->piece.count, rl, rr, measure);
+        outLeft = join(std::move(left), std::move(n), std::move(rl));
+        outRight = std::move(rr);
+    } else {
+        // Cut point falls inside this piece: divide it
+        // Kesme noktasi bu parcanin icinde: parcayi bol
+        int offset = line - leftLines;
+        uint64_t firstBytes = measure({n->piece.source, n->piece.start, offset});
+        NodePtr second = makeNode({n->piece.source, n->piece.start + offset, n->piece.count - offset},
+                                  n->pieceBytes - firstBytes);
+        n->piece.count = offset;
+        n->pieceBytes = firstBytes;
+        outLeft = join(std::move(left), std::move(n), nullptr);
+        outRight = join(nullptr, std::move(second), std::move(right));
+    }
+}
+
+// Check whether the new piece continues the last piece of a subtree in the same source
+// Yeni parcanin bir alt agacin son parcasini ayni kaynakta surdurup surdurmedigini kontrol et
+bool PieceTree::canExtendLast(const Node* n, const PieceDesc& piece) {
+    while (n->right) n = n->right.get();
+    return n->piece.source == piece.source && n->piece.start + n->piece.count == piece.start;
+}
+
+// Grow the last piece of a subtree, copying shared nodes along the right spine
+// Bir alt agacin son parcasini buyut, sag omurgadaki paylasilan dugumleri kopyala
+void PieceTree::extendLast(NodePtr& n, int count, uint64_t bytes) {
+    own(n);
+    if (n->right) {
+        extendLast(n->right, count, bytes);
+    } else {
+        n->piece.count += count;
+        n->pieceBytes += bytes;
+    }
+    update(n.get());
+}
+
+// Adjust the piece holding a line, copying shared nodes on the way down
+// Bir satiri tutan parcayi ayarla, asagi inerken paylasilan dugumleri kopyala
+void PieceTree::addBytesAt(NodePtr& n, int line, int64_t delta) {
+    if (!n) return;
+    own(n);
+    int leftLines = linesOf(n->left.get());
+    if (line < leftLines) addBytesAt(n->left, line, delta);
+    else if (line < leftLines + n->piece.count) n->pieceBytes = static_cast<uint64_t>(static_cast<int64_t>(n->pieceBytes) + delta);
+    else addBytesAt(n->right, line - leftLines - n->piece.count, delta);
+    update(n.get());
+}
+
+// Build a perfectly balanced subtree from pieces[lo, hi)
+// pieces[lo, hi) araligindan tam dengeli bir alt agac kur
+PieceTree::NodePtr PieceTree::build(const std::vector<PieceDesc>& pieces, int lo, int hi, const MeasureFn& measure) {
+    if (lo >= hi) return nullptr;
+    int mid = lo + (hi - lo) / 2;
+    NodePtr n = makeNode(pieces[mid], measure(pieces[mid]));
+    n->left = build(pieces, lo, mid, measure);
+    n->right = build(pieces, mid + 1, hi, measure);
+    update(n.get());
+    return n;
+}
+
+// In-order traversal
+// Sirali gezinme
+void PieceTree::visit(const Node* n, const std::function<void(const PieceDesc&)>& fn) {
+    if (!n) return;
+    visit(n->left.get(), fn);
+    fn(n->piece);
+    visit(n->right.get(), fn);
+}
+
+// In-order traversal restricted to lines [from, to); base is the first line of the subtree
+// [from, to) satirlariyla sinirli sirali gezinme; base alt agacin ilk satiridir
+bool PieceTree::visitRange(const Node* n, int base, int from, int to, const RangeFn& fn) {
+    if (!n || to <= base || from >= base + n->lines) return true;
+    int pieceStart = base + linesOf(n->left.get());
+    int pieceEnd = pieceStart + n->piece.count;
+    if (!visitRange(n->left.get(), base, from, to, fn)) return false;
+    int first = std::max(from, pieceStart);
+    int last = std::min(to, pieceEnd);
+    if (first < last && !fn(n->piece, first, first - pieceStart, last - first)) return false;
+    return visitRange(n->right.get(), pieceEnd, from, to, fn);
+}
+
+// Total lines (root aggregate)
+// Toplam satir (kok toplami)
+int PieceTree::lineCount() const {
+    return linesOf(root_.get());
+}
+
+// Total bytes (root aggregate)
+// Toplam bayt (kok toplami)
+uint64_t PieceTree::byteCount() const {
+    return bytesOf(root_.get());
+}
+
+// Total pieces (root aggregate)
+// Toplam parca (kok toplami)
+int PieceTree::pieceCount() const {
+    return piecesOf(root_.get());
+}
+
+// Descend using subtree line counts
+// Alt agac satir sayilarini kullanarak asagi in
+PieceTree::Location PieceTree::find(int line) const {
+    const Node* n = root_.get();
+    if (!n) return {};
+    if (line < 0) line = 0;
+    if (line >= n->lines) line = n->lines - 1;
+
+    // Lines and bytes of everything left of the current subtree
+    // Mevcut alt agacin solundaki her seyin satirlari ve baytlari
+    int baseLine = 0;
+    uint64_t baseByte = 0;
+    while (n) {
+        int leftLines = linesOf(n->left.get());
+        if (line < leftLines) {
+            n = n->left.get();
+        } else if (line < leftLines + n->piece.count) {
+            return {&n->piece, line - leftLines, baseLine + leftLines, baseByte + bytesOf(n->left.get())};
+        } else {
+            line -= leftLines + n->piece.count;
+            baseLine += leftLines + n->piece.count;
+            baseByte += bytesOf(n->left.get()) + n->pieceBytes;
+            n = n->right.get();
+        }
+    }
+    return {};
+}
+
+// Descend using subtree byte counts
+// Alt agac bayt sayilarini kullanarak asagi in
+PieceTree::Location PieceTree::findByte(uint64_t offset) const {
+    const Node* n = root_.get();
+    if (!n) return {};
+
+    int baseLine = 0;
+    uint64_t baseByte = 0;
+    while (n) {
+        uint64_t leftBytes = bytesOf(n->left.get());
+        int leftLines = linesOf(n->left.get());
+        if (offset < leftBytes) {
+            n = n->left.get();
+        } else if (offset < leftBytes + n->pieceBytes || !n->right) {
+            return {&n->piece, 0, baseLine + leftLines, baseByte + leftBytes};
+        } else {
+            offset -= leftBytes + n->pieceBytes;
+            baseLine += leftLines + n->piece.count;
+            baseByte += leftBytes + n->pieceBytes;
+            n = n->right.get();
+        }
+    }
+    return {};
+}
+
+// Insert a piece at a logical line position
+// Bir parcayi mantiksal satir konumuna ekle
+void PieceTree::insert(int line, const PieceDesc& piece, const MeasureFn& measure) {
+    if (piece.count <= 0) return;
+    line = std::clamp(line, 0, lineCount());
+
+    NodePtr left, right;
+    split(std::move(root_), line, left, right, measure);
+
+    uint64_t bytes = measure(piece);
+    if (left && canExtendLast(left.get(), piece)) {
+        extendLast(left, piece.count, bytes);
+    } else {
+        left = join(std::move(left), makeNode(piece, bytes), nullptr);
+    }
+    root_ = concat(std::move(left), std::move(right));
+}
+
+// Remove a range of logical lines
+// Mantiksal satir araligini kaldir
+void PieceTree::erase(int line, int count, const MeasureFn& measure) {
+    if (count <= 0 || line < 0 || line >= lineCount()) return;
+
+    NodePtr left, rest, middle, right;
+    split(std::move(root_), line, left, rest, measure);
+    split(std::move(rest), count, middle, right, measure);
+    root_ = concat(std::move(left), std::move(right));
+}
+
+// Replace all pieces with a balanced tree built from the sequence
+// Tum parcalari diziden kurulan dengeli agacla degistir
+void PieceTree::assign(const std::vector<PieceDesc>& pieces, const MeasureFn& measure) {
+    root_ = build(pieces, 0, static_cast<int>(pieces.size()), measure);
+}
+
+// Resize the piece holding a line after one of its lines was edited in place
+// Satirlarindan biri yerinde duzenlendikten sonra bir satiri tutan parcayi yeniden boyutlandir
+void PieceTree::addBytes(int line, int64_t delta) {
+    if (delta == 0 || line < 0 || line >= lineCount()) return;
+    addBytesAt(root_, line, delta);
+}
+
+// Drop every piece
+// Tum parcalari birak
+void PieceTree::clear() {
+    root_.reset();
+}
+
+// Visit pieces in document order
+// Parcalari belge sirasinda ziyaret et
+void PieceTree::forEach(const std::function<void(const PieceDesc&)>& fn) const {
+    visit(root_.get(), fn);
+}
+
+// Visit the piece slices of a line range
+// Bir satir araliginin parca dilimlerini ziyaret et
+bool PieceTree::forRange(int line, int count, const RangeFn& fn) const {
+    if (count <= 0) return true;
+    return visitRange(root_.get(), 0, line, line + count, fn);
+}
+
+// Collect pieces in document order
+// Parcalari belge sirasinda topla
+std::vector<PieceDesc> PieceTree::pieces() const {
+    std::vector<PieceDesc> result;
+    result.reserve(pieceCount());
+    forEach([&result](const PieceDesc& p) { result.push_back(p); });
+    return result;
+}
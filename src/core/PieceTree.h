@@ -0,0 +1,151 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Piece source: either the original loaded text or the add buffer
+// Parca kaynagi: ya orijinal yuklenen metin ya da ekleme arabellegi
+enum class PieceSource { Original, Add };
+
+// A piece descriptor: points to a contiguous range of lines in a source buffer
+// Parca tanimlayicisi: bir kaynak arabellekteki bitisik satir araligina isaret eder
+struct PieceDesc {
+    PieceSource source;
+    int start;   // Starting line index in source buffer / Kaynak arabellekteki baslangic satir indeksi
+    int count;   // Number of lines in this piece / Bu parcadaki satir sayisi
+};
+
+// Balanced (AVL) tree of pieces, ordered by document position.
+// Belge konumuna gore siralanmis dengeli (AVL) parca agaci.
+// Each node is augmented with its subtree line and piece counts, so locating a
+// logical line, splitting a piece and removing a line range are all O(log pieces).
+// Her dugum alt agacinin satir ve parca sayilariyla zenginlestirilmistir; boylece mantiksal
+// satiri bulmak, parcayi bolmek ve satir araligini silmek O(log parca) olur.
+// Nodes also sum the byte length of their pieces (each line counted with its '\n'), which
+// maps a line to its byte offset and back in O(log pieces).
+// Dugumler ayrica parcalarinin bayt uzunlugunu toplar (her satir '\n'siyle sayilir); bu da bir
+// satiri bayt ofsetine ve geri O(log parca) icinde esler.
+// Nodes are shared between copies: copying a tree is O(1) and an edit copies only the
+// nodes on its path that another copy still references (persistent, structural sharing).
+// Dugumler kopyalar arasinda paylasilir: agaci kopyalamak O(1)'dir ve bir duzenleme yalnizca
+// yolundaki, baska bir kopyanin hala basvurdugu dugumleri kopyalar (kalici, yapisal paylasim).
+class PieceTree {
+public:
+    // Result of a line lookup: the piece holding the line and the offset inside it
+    // Satir arama sonucu: satiri tutan parca ve parca icindeki ofset
+    struct Location {
+        const PieceDesc* piece = nullptr;
+        int offset = 0;
+        int firstLine = 0;        // Logical line where the piece starts / Parcanin basladigi mantiksal satir
+        uint64_t firstByte = 0;   // Bytes before the piece / Parcadan onceki baytlar
+    };
+
+    // Byte length of a piece (or of a slice of one), supplied by the owner of the sources
+    // Bir parcanin (veya bir diliminin) bayt uzunlugu, kaynaklarin sahibi tarafindan saglanir
+    using MeasureFn = std::function<uint64_t(const PieceDesc& piece)>;
+
+    PieceTree();
+    ~PieceTree();
+    PieceTree(const PieceTree& other);
+    PieceTree& operator=(const PieceTree& other);
+    PieceTree(PieceTree&&) noexcept;
+    PieceTree& operator=(PieceTree&&) noexcept;
+
+    // Total number of lines covered by all pieces
+    // Tum parcalarin kapsadigi toplam satir sayisi
+    int lineCount() const;
+
+    // Total bytes of all pieces
+    // Tum parcalarin toplam bayti
+    uint64_t byteCount() const;
+
+    // Total number of pieces in the tree
+    // Agactaki toplam parca sayisi
+    int pieceCount() const;
+
+    // Find the piece and offset for a logical line (clamped to the last line)
+    // Mantiksal satir icin parca ve ofset'i bul (son satira sabitlenir)
+    Location find(int line) const;
+
+    // Find the piece holding a byte offset (clamped to the last piece); offset is left at 0
+    // Bir bayt ofsetini tutan parcayi bul (son parcaya sabitlenir); offset 0 birakilir
+    Location findByte(uint64_t offset) const;
+
+    // Insert a piece so that its first line becomes logical line `line`.
+    // Bir parcayi ilk satiri mantiksal `line` satiri olacak sekilde ekle.
+    // A piece straddling the position is split; a contiguous predecessor is extended instead.
+    // Konumu kapsayan parca bolunur; bitisik bir onceki parca varsa o genisletilir.
+    // `measure` sizes the new piece and the halves of a split one.
+    // `measure` yeni parcayi ve bolunen parcanin yarilarini olcer.
+    void insert(int line, const PieceDesc& piece, const MeasureFn& measure);
+
+    // Remove `count` lines starting at logical line `line`
+    // Mantiksal `line` satirindan baslayarak `count` satiri kaldir
+    void erase(int line, int count, const MeasureFn& measure);
+
+    // Replace the content of all pieces with the given sequence (built balanced in O(n))
+    // Tum parca icerigini verilen diziyle degistir (O(n) icinde dengeli kurulur)
+    void assign(const std::vector<PieceDesc>& pieces, const MeasureFn& measure);
+
+    // Account for a line of the piece holding `line` changing length in place
+    // `line`'i tutan parcanin bir satirinin yerinde uzunluk degistirmesini hesaba kat
+    void addBytes(int line, int64_t delta);
+
+    // Remove all pieces
+    // Tum parcalari kaldir
+    void clear();
+
+    // Visit every piece in document order
+    // Her parcayi belge sirasinda ziyaret et
+    void forEach(const std::function<void(const PieceDesc&)>& fn) const;
+
+    // Piece slice visitor: (piece, first logical line, offset in piece, lines); return false to stop
+    // Parca dilimi ziyaretcisi: (parca, ilk mantiksal satir, parcadaki ofset, satirlar); durmak icin false dondur
+    using RangeFn = std::function<bool(const PieceDesc& piece, int firstLine, int offset, int count)>;
+
+    // Visit the slices of the pieces covering lines [line, line + count) in order, skipping
+    // subtrees outside the range (O(log pieces + visited pieces)); false if stopped early
+    // [line, line + count) satirlarini kapsayan parca dilimlerini sirayla ziyaret et, aralik
+    // disindaki alt agaclari atla (O(log parca + ziyaret edilen parca)); erken durursa false
+    bool forRange(int line, int count, const RangeFn& fn) const;
+
+    // Materialize the pieces in document order
+    // Parcalari belge sirasinda somutlastir
+    std::vector<PieceDesc> pieces() const;
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<Node>;
+
+    // Make a node exclusively ours before mutating it (copy if another tree shares it)
+    // Degistirmeden once dugumu yalnizca bize ait yap (baska agac paylasiyorsa kopyala)
+    static void own(NodePtr& n);
+
+    static int heightOf(const Node* n);
+    static int linesOf(const Node* n);
+    static int piecesOf(const Node* n);
+    static uint64_t bytesOf(const Node* n);
+    static void update(Node* n);
+    static NodePtr makeNode(const PieceDesc& piece, uint64_t bytes);
+    static NodePtr rotateLeft(NodePtr n);
+    static NodePtr rotateRight(NodePtr n);
+    static NodePtr rebalance(NodePtr n);
+    static NodePtr join(NodePtr left, NodePtr mid, NodePtr right);
+    static NodePtr concat(NodePtr left, NodePtr right);
+    static NodePtr removeMin(NodePtr n, NodePtr& minOut);
+    static void split(NodePtr n, int line, NodePtr& outLeft, NodePtr& outRight, const MeasureFn& measure);
+    static bool canExtendLast(const Node* n, const PieceDesc& piece);
+    static void extendLast(NodePtr& n, int count, uint64_t bytes);
+    static void addBytesAt(NodePtr& n, int line, int64_t delta);
+    static NodePtr build(const std::vector<PieceDesc>& pieces, int lo, int hi, const MeasureFn& measure);
+    static void visit(const Node* n, const std::function<void(const PieceDesc&)>& fn);
+    static bool visitRange(const Node* n, int base, int from, int to, const RangeFn& fn);
+
+    NodePtr root_;  // Tree root / Agac koku
+};
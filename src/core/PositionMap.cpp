@@ -0,0 +1,89 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "PositionMap.h"
+#include "buffer.h"
+
+// (l1, c1) comes strictly before (l2, c2)
+// (l1, c1), (l2, c2)'den kesinlikle once gelir
+static bool before(int l1, int c1, int l2, int c2) {
+    return l1 < l2 || (l1 == l2 && c1 < c2);
+}
+
+// applyEdits reports bottom to top in old coordinates; walk it top to bottom and
+// place each replacement in the new document
+// applyEdits alttan uste eski koordinatlarda raporlar; ustten alta gez ve her
+// yerine geleni yeni belgeye yerlestir
+PositionMap::PositionMap(const std::vector<AppliedEdit>& applied) {
+    spans_.reserve(applied.size());
+    int lineDelta = 0;
+    for (auto it = applied.rbegin(); it != applied.rend(); ++it) {
+        const TextEdit& e = it->edit;
+        Span s{e.startLine, e.startCol, e.endLine, e.endCol, 0, 0, 0, 0, 0};
+
+        // Sharing a line with the previous span, the start moves with that span's end
+        // Onceki span ile ayni satirda ise baslangic o span'in sonuyla birlikte kayar
+        if (!spans_.empty() && spans_.back().endLine == e.startLine) {
+            const Span& prev = spans_.back();
+            s.newStartLine = prev.newEndLine;
+            s.newStartCol = prev.newEndCol + (e.startCol - prev.endCol);
+        } else {
+            s.newStartLine = e.startLine + lineDelta;
+            s.newStartCol = e.startCol;
+        }
+
+        int added = it->newEndLine - e.startLine;
+        s.newEndLine = s.newStartLine + added;
+        s.newEndCol = added == 0 ? s.newStartCol + (it->newEndCol - e.startCol) : it->newEndCol;
+
+        lineDelta += added - (e.endLine - e.startLine);
+        s.lineDelta = lineDelta;
+        spans_.push_back(s);
+    }
+}
+
+// Binary search for the last span whose old start is at or before (line, col)
+// Eski baslangici (line, col)'da veya oncesinde olan son span icin ikili arama
+int PositionMap::spanAt(int line, int col) const {
+    int lo = 0, hi = static_cast<int>(spans_.size());
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (before(line, col, spans_[mid].startLine, spans_[mid].startCol)) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo - 1;
+}
+
+// Only the nearest span at or before the position can move it
+// Konumu yalnizca konumdaki veya onceki en yakin span tasiyabilir
+bool PositionMap::map(int& line, int& col) const {
+    int i = spanAt(line, col);
+    if (i < 0) return true;
+    const Span& s = spans_[i];
+
+    if (before(line, col, s.endLine, s.endCol)) {
+        bool atStart = line == s.startLine && col == s.startCol;
+        line = s.newStartLine;
+        col = s.newStartCol;
+        return atStart;
+    }
+    if (line == s.endLine) {
+        col = s.newEndCol + (col - s.endCol);
+        line = s.newEndLine;
+    } else {
+        line += s.lineDelta;
+    }
+    return true;
+}
+
+// A range is swallowed when one replaced range covers it entirely
+// Bir araligi tek bir degistirilen aralik tamamen kapsiyorsa yutulmustur
+bool PositionMap::swallows(int startLine, int startCol, int endLine, int endCol) const {
+    int i = spanAt(startLine, startCol);
+    if (i < 0) return false;
+    const Span& s = spans_[i];
+    if (s.startLine == s.endLine && s.startCol == s.endCol) return false;
+    return !before(s.endLine, s.endCol, endLine, endCol);
+}
@@ -0,0 +1,50 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <vector>
+
+struct AppliedEdit;
+
+// Maps positions of the document before a batch of edits to the document after it.
+// Bir duzenleme grubundan onceki belgenin konumlarini sonraki belgeye esler.
+// Built once from Buffer::applyEdits output; each lookup is a binary search, so marks,
+// extmarks and folds are moved in one pass instead of one pass per edit.
+// Buffer::applyEdits ciktisindan bir kez kurulur; her arama bir ikili aramadir, boylece
+// isaretler, extmark'lar ve katlamalar duzenleme basina bir gecis yerine tek geciste tasinir.
+class PositionMap {
+public:
+    explicit PositionMap(const std::vector<AppliedEdit>& applied);
+
+    // Move (line, col) into the new document. A position inside a replaced range lands on
+    // the start of its replacement and false is returned.
+    // (line, col)'u yeni belgeye tasi. Degistirilen bir araligin icindeki konum yerine
+    // gelen metnin basina duser ve false dondurulur.
+    bool map(int& line, int& col) const;
+
+    // Check if [start, end] lies within a single non-empty replaced range
+    // [start, end]'in tek bir bos olmayan degistirilen aralik icinde olup olmadigini kontrol et
+    bool swallows(int startLine, int startCol, int endLine, int endCol) const;
+
+    // Check if the batch changed nothing
+    // Grubun hicbir seyi degistirmedigini kontrol et
+    bool empty() const { return spans_.empty(); }
+
+private:
+    // One edit in both coordinate systems
+    // Her iki koordinat sisteminde bir duzenleme
+    struct Span {
+        int startLine, startCol, endLine, endCol;  // Old range / Eski aralik
+        int newStartLine, newStartCol;             // Replacement start in the new document / Yeni belgede yerine gelenin basi
+        int newEndLine, newEndCol;                 // Replacement end in the new document / Yeni belgede yerine gelenin sonu
+        int lineDelta;                             // Lines gained up to and including this span / Bu span dahil kazanilan satirlar
+    };
+
+    // Last span starting at or before (line, col), or -1
+    // (line, col)'da veya oncesinde baslayan son span, yoksa -1
+    int spanAt(int line, int col) const;
+
+    std::vector<Span> spans_;  // Ascending by old start / Eski baslangica gore artan
+};
@@ -4,6 +4,8 @@
 // See LICENSE file in the project root for full license text.
 
 #include "RegexEngine.h"
+#include "LinearRegexEngine.h"
+#include "ReplaceTemplate.h"
 #include <regex>
 
 // Internal state for std::regex-based engine
@@ -15,12 +17,31 @@ struct StdRegexEngine::Impl {
 
 // Factory: create the best available regex engine
 // Fabrika: mevcut en iyi regex motorunu olustur
-// Currently returns StdRegexEngine. When RE2 is available (BERKIDE_USE_RE2),
-// this will return RE2Engine instead for better performance.
-// Su an StdRegexEngine dondurur. RE2 mevcut oldugunda (BERKIDE_USE_RE2),
-// daha iyi performans icin RE2Engine dondurecek.
+// Patterns come from users and plugins, so the default must not backtrack: std::regex can
+// take exponential time or overflow the stack on patterns like (a|a)*b.
+// Kaliplar kullanicilardan ve eklentilerden gelir, bu yuzden varsayilan geri izleme yapmamali:
+// std::regex (a|a)*b gibi kaliplarda ustel zaman alabilir veya yigini tasirabilir.
 std::unique_ptr<RegexEngine> RegexEngine::create() {
-    return std::make_unique<StdRegexEngine>();
+    return std::make_unique<LinearRegexEngine>();
+}
+
+// Engines without a cheaper path report the bounds of a full search
+// Daha ucuz yolu olmayan motorlar tam aramanin sinirlarini bildirir
+bool RegexEngine::find(std::string_view text, int offset, int& position, int& length) const {
+    RegexMatch m;
+    if (!search(text, offset, m)) return false;
+    position = m.position;
+    length = m.length;
+    return true;
+}
+
+// Parsed on every call; callers expanding many matches keep a ReplaceTemplate instead
+// Her cagrida ayristirilir; cok esleme genisleten cagiranlar bunun yerine bir ReplaceTemplate tutar
+std::string RegexEngine::format(std::string_view text, const RegexMatch& match, std::string_view replacement) {
+    std::string out;
+    out.reserve(replacement.size());
+    ReplaceTemplate(replacement).expand(text, match, out);
+    return out;
 }
 
 // Compile a regex pattern with the given case sensitivity option
@@ -49,13 +70,15 @@ bool StdRegexEngine::isValid() const {
 
 // Search for first match starting from offset
 // Ofset'ten baslayarak ilk eslemeyi ara
-bool StdRegexEngine::search(const std::string& text, int offset, RegexMatch& match) const {
+bool StdRegexEngine::search(std::string_view text, int offset, RegexMatch& match) const {
     if (!impl_ || !impl_->valid) return false;
-    if (offset < 0 || offset >= static_cast<int>(text.size())) return false;
+    if (offset < 0 || offset > static_cast<int>(text.size())) return false;
 
-    std::string sub = text.substr(static_cast<size_t>(offset));
-    std::smatch m;
-    if (std::regex_search(sub, m, impl_->re)) {
+    // match_prev_avail lets ^ and \b see the character before offset
+    // match_prev_avail, ^ ve \b'nin ofsetten onceki karakteri gormesini saglar
+    auto flags = offset > 0 ? std::regex_constants::match_prev_avail : std::regex_constants::match_default;
+    std::cmatch m;
+    if (std::regex_search(text.data() + offset, text.data() + text.size(), m, impl_->re, flags)) {
         match.position = offset + static_cast<int>(m.position(0));
         match.length = static_cast<int>(m.length(0));
         match.groups.clear();
@@ -69,13 +92,13 @@ bool StdRegexEngine::search(const std::string& text, int offset, RegexMatch& mat
 
 // Find all matches in the text
 // Metindeki tum eslemeleri bul
-std::vector<RegexMatch> StdRegexEngine::searchAll(const std::string& text) const {
+std::vector<RegexMatch> StdRegexEngine::searchAll(std::string_view text) const {
     std::vector<RegexMatch> results;
     if (!impl_ || !impl_->valid) return results;
 
     int offset = 0;
     RegexMatch m;
-    while (search(text, offset, m)) {
+    while (offset <= static_cast<int>(text.size()) && search(text, offset, m)) {
         results.push_back(m);
         offset = m.position + std::max(1, m.length);
     }
@@ -84,24 +107,24 @@ std::vector<RegexMatch> StdRegexEngine::searchAll(const std::string& text) const
 
 // Replace the first match in text
 // Metindeki ilk eslemeyi degistir
-std::string StdRegexEngine::replaceFirst(const std::string& text, const std::string& replacement) const {
-    if (!impl_ || !impl_->valid) return text;
+std::string StdRegexEngine::replaceFirst(std::string_view text, const std::string& replacement) const {
+    if (!impl_ || !impl_->valid) return std::string(text);
     try {
-        return std::regex_replace(text, impl_->re, replacement,
+        return std::regex_replace(std::string(text), impl_->re, replacement,
                                    std::regex_constants::format_first_only);
     } catch (...) {
-        return text;
+        return std::string(text);
     }
 }
 
 // Replace all matches in text
 // Metindeki tum eslemeleri degistir
-std::string StdRegexEngine::replaceAll(const std::string& text, const std::string& replacement) const {
-    if (!impl_ || !impl_->valid) return text;
+std::string StdRegexEngine::replaceAll(std::string_view text, const std::string& replacement) const {
+    if (!impl_ || !impl_->valid) return std::string(text);
     try {
-        return std::regex_replace(text, impl_->re, replacement);
+        return std::regex_replace(std::string(text), impl_->re, replacement);
     } catch (...) {
-        return text;
+        return std::string(text);
     }
 }
 
@@ -5,6 +5,7 @@
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 
@@ -18,8 +19,12 @@ struct RegexMatch {
 
 // Abstract regex engine interface for pluggable backends.
 // Taklinabilir arka uclar icin soyut regex motoru arayuzu.
-// Default: std::regex. Optional: RE2, PCRE2 (compile with BERKIDE_USE_RE2).
-// Varsayilan: std::regex. Opsiyonel: RE2, PCRE2 (BERKIDE_USE_RE2 ile derle).
+// Default: LinearRegexEngine (linear time, no backreferences). StdRegexEngine keeps the full
+// ECMAScript grammar for callers that trust their patterns.
+// Varsayilan: LinearRegexEngine (dogrusal zaman, geri referans yok). StdRegexEngine,
+// kaliplarina guvenen cagiranlar icin tam ECMAScript dilbilgisini korur.
+// Matches are searched at byte offsets; text before offset is still seen by ^, $ and \b.
+// Eslemeler bayt ofsetlerinde aranir; ofsetten onceki metni ^, $ ve \b yine gorur.
 class RegexEngine {
 public:
     virtual ~RegexEngine() = default;
@@ -34,19 +39,23 @@ public:
 
     // Find the first match in a string starting from offset
     // Bir dizede ofset'ten baslayarak ilk eslemeyi bul
-    virtual bool search(const std::string& text, int offset, RegexMatch& match) const = 0;
+    virtual bool search(std::string_view text, int offset, RegexMatch& match) const = 0;
+
+    // Bounds of the first match from offset, without capture groups (cheaper than search)
+    // Ofsetten itibaren ilk eslemenin sinirlari, yakalama gruplari olmadan (search'ten ucuz)
+    virtual bool find(std::string_view text, int offset, int& position, int& length) const;
 
     // Find all matches in a string
     // Bir dizedeki tum eslemeleri bul
-    virtual std::vector<RegexMatch> searchAll(const std::string& text) const = 0;
+    virtual std::vector<RegexMatch> searchAll(std::string_view text) const = 0;
 
     // Replace first match in text
     // Metindeki ilk eslemeyi degistir
-    virtual std::string replaceFirst(const std::string& text, const std::string& replacement) const = 0;
+    virtual std::string replaceFirst(std::string_view text, const std::string& replacement) const = 0;
 
     // Replace all matches in text
     // Metindeki tum eslemeleri degistir
-    virtual std::string replaceAll(const std::string& text, const std::string& replacement) const = 0;
+    virtual std::string replaceAll(std::string_view text, const std::string& replacement) const = 0;
 
     // Get last error message (empty if no error)
     // Son hata mesajini al (hata yoksa bos)
@@ -55,20 +64,28 @@ public:
     // Factory: create the best available regex engine
     // Fabrika: mevcut en iyi regex motorunu olustur
     static std::unique_ptr<RegexEngine> create();
+
+    // Expand a replacement template for a match in text: $& (match), $1-$99 (groups),
+    // $` (before), $' (after), $$ (dollar) and \U \L \u \l \E case changes (see ReplaceTemplate)
+    // Metindeki bir esleme icin degistirme sablonunu genislet: $& (esleme), $1-$99 (gruplar),
+    // $` (oncesi), $' (sonrasi), $$ (dolar) ve \U \L \u \l \E harf degisiklikleri (bkz. ReplaceTemplate)
+    static std::string format(std::string_view text, const RegexMatch& match, std::string_view replacement);
 };
 
-// Default implementation using std::regex (C++11 standard library)
-// std::regex kullanan varsayilan uygulama (C++11 standart kutuphanesi)
+// Full ECMAScript engine on std::regex: backreferences and lookahead, but backtracking can
+// take exponential time, so create() does not return it; construct it directly when needed
+// std::regex uzerinde tam ECMAScript motoru: geri referanslar ve ileri bakis var ama geri
+// izleme ustel zaman alabilir, bu yuzden create() onu dondurmez; gerektiginde dogrudan olustur
 class StdRegexEngine : public RegexEngine {
 public:
     StdRegexEngine() = default;
 
     bool compile(const std::string& pattern, bool caseSensitive = true) override;
     bool isValid() const override;
-    bool search(const std::string& text, int offset, RegexMatch& match) const override;
-    std::vector<RegexMatch> searchAll(const std::string& text) const override;
-    std::string replaceFirst(const std::string& text, const std::string& replacement) const override;
-    std::string replaceAll(const std::string& text, const std::string& replacement) const override;
+    bool search(std::string_view text, int offset, RegexMatch& match) const override;
+    std::vector<RegexMatch> searchAll(std::string_view text) const override;
+    std::string replaceFirst(std::string_view text, const std::string& replacement) const override;
+    std::string replaceAll(std::string_view text, const std::string& replacement) const override;
     std::string lastError() const override;
 
 private:
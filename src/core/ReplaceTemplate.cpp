@@ -0,0 +1,167 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "ReplaceTemplate.h"
+#include <algorithm>
+
+namespace {
+
+// ASCII digit (group numbers are ASCII only)
+// ASCII rakam (grup numaralari yalnizca ASCII'dir)
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Uppercase an ASCII letter for \U and \u, other bytes pass through
+// \U ve \u icin bir ASCII harfini buyut, diger baytlar oldugu gibi gecer
+inline char upperAscii(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 32) : c;
+}
+
+// Lowercase an ASCII letter for \L and \l, other bytes pass through
+// \L ve \l icin bir ASCII harfini kucult, diger baytlar oldugu gibi gecer
+inline char lowerAscii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+}
+
+} // namespace
+
+// Split the replacement into literal runs and references; literal runs are copied into
+// text_ so that a piece is just an offset
+// Degistirmeyi literal parcalara ve referanslara bol; literal parcalar text_'e kopyalanir,
+// boylece bir parca yalnizca bir ofsettir
+ReplaceTemplate::ReplaceTemplate(std::string_view replacement, bool regex) {
+    if (!regex) {
+        text_ = replacement;
+        if (!text_.empty()) pieces_.push_back({Op::Text, 0, static_cast<uint32_t>(text_.size())});
+        return;
+    }
+
+    auto addText = [&](std::string_view s) {
+        if (s.empty()) return;
+        if (!pieces_.empty() && pieces_.back().op == Op::Text &&
+            pieces_.back().off + pieces_.back().len == text_.size()) {
+            pieces_.back().len += static_cast<uint32_t>(s.size());
+        } else {
+            pieces_.push_back({Op::Text, static_cast<uint32_t>(text_.size()), static_cast<uint32_t>(s.size())});
+        }
+        text_.append(s);
+    };
+    auto addOp = [&](Op op) {
+        pieces_.push_back({op});
+        constant_ = false;
+    };
+
+    const size_t n = replacement.size();
+    size_t i = 0;
+    while (i < n) {
+        char c = replacement[i];
+        char next = i + 1 < n ? replacement[i + 1] : '\0';
+        if (c == '\\') {
+            Op op;
+            switch (next) {
+                case 'U': op = Op::Upper; break;
+                case 'L': op = Op::Lower; break;
+                case 'u': op = Op::UpperNext; break;
+                case 'l': op = Op::LowerNext; break;
+                case 'E': op = Op::EndCase; break;
+                default:
+                    addText(replacement.substr(i, 1));
+                    ++i;
+                    continue;
+            }
+            addOp(op);
+            i += 2;
+            continue;
+        }
+        if (c != '$' || i + 1 == n) {
+            addText(replacement.substr(i, 1));
+            ++i;
+            continue;
+        }
+        switch (next) {
+            case '$': addText("$"); i += 2; continue;
+            case '&': addOp(Op::Match); i += 2; continue;
+            case '`': addOp(Op::Before); i += 2; continue;
+            case '\'': addOp(Op::After); i += 2; continue;
+            default: break;
+        }
+        if (!isDigit(next)) {
+            addText("$");
+            ++i;
+            continue;
+        }
+
+        // Keep the digits as typed: which of them name a group depends on the pattern
+        // Basamaklari yazildigi gibi tut: hangilerinin bir grubu adlandirdigi kaliba baglidir
+        size_t digits = (i + 2 < n && isDigit(replacement[i + 2])) ? 2 : 1;
+        Piece p{Op::Group, static_cast<uint32_t>(text_.size()), static_cast<uint32_t>(digits + 1)};
+        p.group = next - '0';
+        if (digits == 2) p.group = p.group * 10 + (replacement[i + 2] - '0');
+        text_.append(replacement.substr(i, digits + 1));
+        pieces_.push_back(p);
+        constant_ = false;
+        needsGroups_ = true;
+        i += digits + 1;
+    }
+}
+
+// Case modifiers hold a mode (\U, \L until \E) and a one-shot change for the next byte
+// (\u, \l); with neither active, text is appended as is
+// Harf degistiricileri bir kip (\E'ye kadar \U, \L) ve sonraki bayt icin tek seferlik bir
+// degisiklik (\u, \l) tutar; ikisi de etkin degilse metin oldugu gibi eklenir
+void ReplaceTemplate::expand(std::string_view text, const RegexMatch& match, std::string& out) const {
+    enum class Case : uint8_t { None, Upper, Lower };
+    Case mode = Case::None, once = Case::None;
+
+    auto emit = [&](std::string_view s) {
+        if (s.empty()) return;
+        if (mode == Case::None && once == Case::None) {
+            out.append(s);
+            return;
+        }
+        size_t i = 0;
+        if (once != Case::None) {
+            out += once == Case::Upper ? upperAscii(s[0]) : lowerAscii(s[0]);
+            once = Case::None;
+            i = 1;
+        }
+        for (; i < s.size(); ++i) {
+            char c = s[i];
+            out += mode == Case::Upper ? upperAscii(c) : mode == Case::Lower ? lowerAscii(c) : c;
+        }
+    };
+
+    const int groups = static_cast<int>(match.groups.size()) - 1;
+    const size_t pos = std::min(text.size(), static_cast<size_t>(std::max(0, match.position)));
+    const size_t end = std::min(text.size(), pos + static_cast<size_t>(std::max(0, match.length)));
+    for (const Piece& p : pieces_) {
+        switch (p.op) {
+            case Op::Text: emit(std::string_view(text_).substr(p.off, p.len)); break;
+            case Op::Match: emit(text.substr(pos, end - pos)); break;
+            case Op::Before: emit(text.substr(0, pos)); break;
+            case Op::After: emit(text.substr(end)); break;
+            case Op::Upper: mode = Case::Upper; break;
+            case Op::Lower: mode = Case::Lower; break;
+            case Op::UpperNext: once = Case::Upper; break;
+            case Op::LowerNext: once = Case::Lower; break;
+            case Op::EndCase: mode = Case::None; break;
+            case Op::Group: {
+                // "$12" is group 12 if there is one, else group 1 followed by "2"
+                // "$12" varsa 12. grup, yoksa 1. grup ve ardindan "2"
+                std::string_view raw = std::string_view(text_).substr(p.off, p.len);
+                if (p.len == 3 && p.group >= 1 && p.group <= groups) {
+                    emit(match.groups[p.group]);
+                } else if (int first = raw[1] - '0'; first >= 1 && first <= groups) {
+                    emit(match.groups[first]);
+                    emit(raw.substr(2));
+                } else {
+                    emit(raw);
+                }
+                break;
+            }
+        }
+    }
+}
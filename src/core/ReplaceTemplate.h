@@ -0,0 +1,67 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include "RegexEngine.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Replacement text parsed once and expanded for every match of a replace.
+// Bir kez ayristirilan ve bir degistirmenin her eslemesi icin genisletilen degistirme metni.
+// Regex templates know $& (match), $1-$99 (groups), $` (before), $' (after), $$ (dollar) and
+// the case modifiers \U, \L (rest upper/lower case), \u, \l (next character) and \E (end
+// \U/\L). Case changes apply to ASCII letters; other bytes are copied as they are. A $n
+// naming a group the pattern does not have stays as typed, as in ECMAScript.
+// Regex sablonlari $& (esleme), $1-$99 (gruplar), $` (oncesi), $' (sonrasi), $$ (dolar) ve
+// harf degistiricileri \U, \L (gerisi buyuk/kucuk harf), \u, \l (sonraki karakter) ve \E
+// (\U/\L'yi bitir) bilir. Harf degisiklikleri ASCII harflere uygulanir; diger baytlar oldugu
+// gibi kopyalanir. Kalipta olmayan bir grubu adlandiran $n, ECMAScript'teki gibi yazildigi gibi kalir.
+class ReplaceTemplate {
+public:
+    ReplaceTemplate() = default;
+
+    // Parse replacement; a non-regex template is taken verbatim
+    // Degistirmeyi ayristir; regex olmayan bir sablon oldugu gibi alinir
+    explicit ReplaceTemplate(std::string_view replacement, bool regex = true);
+
+    // Append the expansion for match (position relative to text) to out
+    // match icin genislemeyi (konum text'e gore) out'a ekle
+    void expand(std::string_view text, const RegexMatch& match, std::string& out) const;
+
+    // True if expanding needs capture groups, not just the match bounds
+    // Genisletme yalnizca esleme sinirlarini degil yakalama gruplarini gerektiriyorsa true
+    bool needsGroups() const { return needsGroups_; }
+
+    // True if the expansion is the same text for every match
+    // Genisleme her esleme icin ayni metinse true
+    bool isConstant() const { return constant_; }
+
+private:
+    enum class Op : uint8_t {
+        Text,        // text_[off, off + len) / text_[off, off + len)
+        Group,       // Capture group `group` (one or two digits as typed) / Yakalama grubu `group` (yazildigi gibi bir veya iki basamak)
+        Match,       // $& / $&
+        Before,      // $` / $`
+        After,       // $' / $'
+        Upper,       // \U
+        Lower,       // \L
+        UpperNext,   // \u
+        LowerNext,   // \l
+        EndCase      // \E
+    };
+
+    struct Piece {
+        Op op;
+        uint32_t off = 0, len = 0;   // Text, or the "$n" source for a group kept as typed / Metin veya yazildigi gibi kalan bir grup icin "$n" kaynagi
+        int group = 0;
+    };
+
+    std::vector<Piece> pieces_;
+    std::string text_;               // Literal bytes the pieces point into / Parcalarin isaret ettigi literal baytlar
+    bool needsGroups_ = false;
+    bool constant_ = true;
+};
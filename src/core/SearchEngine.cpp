@@ -5,108 +5,261 @@
 
 #include "SearchEngine.h"
 #include "buffer.h"
+#include "BufferSnapshot.h"
 #include "Logger.h"
+#include "ThreadPool.h"
 #include <algorithm>
-#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+
+namespace {
+
+// Append the text of buf from (line, col) to (endLine, endCol), '\n' between lines
+// buf'in (line, col)'dan (endLine, endCol)'a kadarki metnini ekle, satirlar arasinda '\n'
+void appendSpan(const BufferSnapshot& buf, int line, int col, int endLine, int endCol, std::string& out) {
+    auto it = buf.lineAt(line);
+    for (int l = line;; ++l, ++it) {
+        std::string_view text = *it;
+        size_t from = l == line ? std::min(text.size(), static_cast<size_t>(col)) : 0;
+        size_t to = l == endLine ? std::min(text.size(), static_cast<size_t>(endCol)) : text.size();
+        out.append(text.substr(from, to - std::min(from, to)));
+        if (l == endLine) break;
+        out += '\n';
+    }
+}
+
+} // namespace
+
+std::atomic<int> SearchEngine::multilineMaxLines_{64};
 
 // Default constructor
 // Varsayilan kurucu
 SearchEngine::SearchEngine() = default;
 
-// Convert string to lowercase (for case-insensitive search)
-// Dizeyi kucuk harfe cevir (buyuk/kucuk harf duyarsiz arama icin)
-std::string SearchEngine::toLower(const std::string& s) {
-    std::string result = s;
-    std::transform(result.begin(), result.end(), result.begin(),
-                   [](unsigned char c) { return std::tolower(c); });
-    return result;
+// Clamped to at least one line; applies to searches started afterwards
+// En az bir satira sabitlenir; sonradan baslayan aramalara uygulanir
+void SearchEngine::setMultilineMaxLines(int lines) {
+    multilineMaxLines_ = std::max(1, lines);
 }
 
-// Check if position is at a word boundary (start or end of a word)
-// Konumun sozcuk sinirinda olup olmadigini kontrol et (sozcuk basi veya sonu)
-bool SearchEngine::isWordBoundary(const std::string& line, int pos) {
-    if (pos <= 0 || pos >= static_cast<int>(line.size())) return true;
-    bool prevAlnum = std::isalnum(static_cast<unsigned char>(line[pos - 1])) || line[pos - 1] == '_';
-    bool currAlnum = std::isalnum(static_cast<unsigned char>(line[pos])) || line[pos] == '_';
-    return prevAlnum != currAlnum;
+// Current longest multi-line span
+// Gecerli en uzun cok satirli yayilim
+int SearchEngine::multilineMaxLines() {
+    return multilineMaxLines_;
 }
 
-// Find a literal pattern in a single line
-// Bir satirda literal kalip bul
-bool SearchEngine::findInLine(const std::string& line, const std::string& pattern,
-                              int startCol, bool caseSensitive, bool wholeWord,
-                              int& matchCol, int& matchLen) const {
-    if (pattern.empty()) return false;
+// Find a literal pattern in a single line, reading the line in place
+// Bir satirda literal kalip bul, satiri yerinde okuyarak
+bool SearchEngine::findInLine(std::string_view line, const LiteralMatcher& lit,
+                              int startCol, int& matchCol, int& matchLen) const {
+    size_t pos = lit.find(line, static_cast<size_t>(startCol));
+    if (pos == LiteralMatcher::npos) return false;
+    matchCol = static_cast<int>(pos);
+    matchLen = static_cast<int>(lit.size());
+    return true;
+}
 
-    std::string haystack = caseSensitive ? line : toLower(line);
-    std::string needle   = caseSensitive ? pattern : toLower(pattern);
+// Find a regex pattern in a single line
+// Bir satirda regex kalip bul
+bool SearchEngine::findRegexInLine(std::string_view line, const RegexEngine& re,
+                                   int startCol, int& matchCol, int& matchLen) const {
+    if (startCol > static_cast<int>(line.size())) return false;
+    return re.find(line, startCol, matchCol, matchLen);
+}
 
-    size_t pos = haystack.find(needle, static_cast<size_t>(startCol));
-    while (pos != std::string::npos) {
-        int mCol = static_cast<int>(pos);
-        int mEnd = mCol + static_cast<int>(needle.size());
+// Compile a search regex with the default (linear-time) engine
+// Arama regex'ini varsayilan (dogrusal zamanli) motorla derle
+std::unique_ptr<RegexEngine> SearchEngine::compileRegex(const std::string& pattern, const SearchOptions& opts) {
+    auto re = RegexEngine::create();
+    if (!re->compile(pattern, opts.caseSensitive)) {
+        LOG_WARN("[Search] Invalid regex: ", re->lastError());
+        return nullptr;
+    }
+    return re;
+}
 
-        if (!wholeWord || (isWordBoundary(line, mCol) && isWordBoundary(line, mEnd))) {
-            matchCol = mCol;
-            matchLen = static_cast<int>(needle.size());
-            return true;
+// Literal text is escaped so that only "\n" (typed as a line break) spans lines
+// Literal metin kacislanir; boylece yalnizca "\n" (satir sonu olarak yazilmis) satirlara yayilir
+std::unique_ptr<RegexEngine> SearchEngine::compileMultiline(const std::string& pattern, const SearchOptions& opts) {
+    std::string source;
+    if (opts.regex) {
+        source = pattern;
+    } else {
+        for (char c : pattern) {
+            if (std::strchr("\\^$.|?*+()[]{}", c) && c != '\0') source += '\\';
+            source += c;
         }
+    }
+    if (opts.wholeWord) source = "\\b(?:" + source + ")\\b";
+    return compileRegex(source, opts);
+}
 
-        pos = haystack.find(needle, pos + 1);
+// Append the replacement for a match; without group references the bounds are enough
+// Bir esleme icin degistirmeyi ekle; grup referanslari yoksa sinirlar yeterlidir
+void SearchEngine::expandMatch(const RegexEngine* re, const ReplaceTemplate& tmpl, std::string_view text,
+                               int offset, int length, std::string& out) {
+    RegexMatch m;
+    if (!re || !tmpl.needsGroups() || !re->search(text, offset, m)) {
+        m.position = offset;
+        m.length = length;
     }
-    return false;
+    tmpl.expand(text, m, out);
 }
 
-// Find a regex pattern in a single line
-// Bir satirda regex kalip bul
-bool SearchEngine::findRegexInLine(const std::string& line, const std::regex& re,
-                                   int startCol, int& matchCol, int& matchLen) const {
-    std::string searchStr = line.substr(static_cast<size_t>(startCol));
-    std::smatch m;
-    if (std::regex_search(searchStr, m, re)) {
-        matchCol = startCol + static_cast<int>(m.position(0));
-        matchLen = static_cast<int>(m.length(0));
-        return true;
+// The window holds lines [first, first + 2 * maxLines) joined by "\n" (with the break after
+// its last line when more follow). A match counts if it starts in the first half and ends
+// before the window does; otherwise the window slides down, so a match can span up to
+// maxLines lines while only 2 * maxLines lines are ever copied.
+// Pencere [first, first + 2 * maxLines) satirlarini "\n" ile birlestirilmis tutar (arkasindan
+// satir geliyorsa son satirdan sonraki sonla birlikte). Bir esleme ilk yarida basliyor ve
+// pencereden once bitiyorsa sayilir; aksi halde pencere asagi kayar, boylece bir esleme
+// maxLines satira kadar yayilabilir ve hicbir zaman 2 * maxLines satirdan fazlasi kopyalanmaz.
+void SearchEngine::scanMultiline(const BufferSnapshot& buf, const RegexEngine& re,
+                                 int fromLine, int fromCol, const WindowVisitor& visit) const {
+    const int totalLines = buf.lineCount();
+    const int half = multilineMaxLines_;
+    std::string window;
+    std::vector<int> starts;  // Window offset of each line / Her satirin pencere ofseti
+
+    int first = std::max(0, fromLine);
+    int col = std::max(0, fromCol);
+    while (first < totalLines) {
+        const int last = std::min(totalLines, first + 2 * half);
+        window.clear();
+        starts.clear();
+        auto it = buf.lineAt(first);
+        for (int i = first; i < last; ++i, ++it) {
+            starts.push_back(static_cast<int>(window.size()));
+            window.append(*it);
+            if (i + 1 < totalLines) window.push_back('\n');
+        }
+        const int size = static_cast<int>(window.size());
+        const int owned = std::min(last, first + half);
+        const int ownedEnd = owned < last ? starts[owned - first] : size + 1;
+        const bool complete = last == totalLines;
+
+        auto locate = [&](int offset, int& line, int& c) {
+            int k = static_cast<int>(std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin()) - 1;
+            line = first + k;
+            c = offset - starts[k];
+        };
+
+        int firstEnd = starts.size() > 1 ? starts[1] - 1 : size;
+        int offset = std::min(col, firstEnd);
+        int nextLine = owned, nextCol = 0;
+        while (offset <= size) {
+            int pos, len;
+            if (!re.find(window, offset, pos, len) || pos >= ownedEnd) break;
+            if (!complete && pos + len >= size) {
+                // May run on past the window: restart with the window at its line, unless it
+                // already is (the match is as long as a window allows)
+                // Pencerenin otesine uzanabilir: pencere onun satirinda olacak sekilde yeniden
+                // basla, zaten oradaysa degil (esleme bir pencerenin izin verdigi kadar uzun)
+                locate(pos, nextLine, nextCol);
+                if (nextLine > first) break;
+            }
+            SearchMatch m;
+            m.length = len;
+            locate(pos, m.line, m.col);
+            locate(pos + len, m.endLine, m.endCol);
+            if (!visit(m, window, pos)) return;
+            offset = pos + std::max(1, len);
+            nextLine = owned;
+            nextCol = 0;
+        }
+        if (offset > ownedEnd && offset <= size) locate(offset, nextLine, nextCol);
+        first = nextLine;
+        col = nextCol;
     }
-    return false;
+}
+
+// First multi-line match at or after (fromLine, fromCol), then from the top if wrapping
+// (fromLine, fromCol)'da veya sonrasinda ilk cok satirli esleme, sarma varsa bastan
+bool SearchEngine::findForwardMultiline(const BufferSnapshot& buf, const RegexEngine& re,
+                                        int fromLine, int fromCol, bool wrap,
+                                        SearchMatch& match, const WindowVisitor& onFound) const {
+    bool found = false;
+    scanMultiline(buf, re, fromLine, fromCol, [&](const SearchMatch& m, std::string_view window, int offset) {
+        match = m;
+        found = true;
+        if (onFound) onFound(m, window, offset);
+        return false;
+    });
+    if (found || !wrap) return found;
+
+    scanMultiline(buf, re, 0, 0, [&](const SearchMatch& m, std::string_view window, int offset) {
+        if (m.line < fromLine || (m.line == fromLine && m.col < fromCol)) {
+            match = m;
+            found = true;
+            if (onFound) onFound(m, window, offset);
+        }
+        return false;
+    });
+    return found;
+}
+
+// Last multi-line match starting before (fromLine, fromCol), then from the bottom if wrapping
+// (fromLine, fromCol)'dan once baslayan son cok satirli esleme, sarma varsa sondan
+bool SearchEngine::findBackwardMultiline(const BufferSnapshot& buf, const RegexEngine& re,
+                                         int fromLine, int fromCol, bool wrap, SearchMatch& match) const {
+    bool found = false;
+    scanMultiline(buf, re, 0, 0, [&](const SearchMatch& m, std::string_view, int) {
+        if (m.line > fromLine || (m.line == fromLine && m.col >= fromCol)) return false;
+        match = m;
+        found = true;
+        return true;
+    });
+    if (found || !wrap) return found;
+
+    scanMultiline(buf, re, fromLine, fromCol, [&](const SearchMatch& m, std::string_view, int) {
+        match = m;
+        found = true;
+        return true;
+    });
+    return found;
 }
 
 // Find forward from (fromLine, fromCol), optionally wrapping around
 // (fromLine, fromCol) konumundan ileri ara, istege bagli olarak sar
-bool SearchEngine::findForward(const Buffer& buf, const std::string& pattern,
+bool SearchEngine::findForward(const BufferSnapshot& buf, const std::string& pattern,
                                int fromLine, int fromCol,
                                SearchMatch& match, const SearchOptions& opts) const {
     if (pattern.empty() || buf.lineCount() == 0) return false;
 
+    if (opts.multiline) {
+        auto re = compileMultiline(pattern, opts);
+        return re && findForwardMultiline(buf, *re, fromLine, fromCol, opts.wrapAround, match);
+    }
+
     int totalLines = buf.lineCount();
 
     // Compile regex once if needed
     // Gerekirse regex'i bir kere derle
-    std::regex re;
+    std::unique_ptr<RegexEngine> re;
+    LiteralMatcher lit;
     if (opts.regex) {
-        try {
-            auto flags = std::regex_constants::ECMAScript;
-            if (!opts.caseSensitive) flags |= std::regex_constants::icase;
-            re = std::regex(pattern, flags);
-        } catch (const std::regex_error& e) {
-            LOG_WARN("[Search] Invalid regex: ", e.what());
-            return false;
-        }
+        re = compileRegex(pattern, opts);
+        if (!re) return false;
+    } else {
+        lit = LiteralMatcher(pattern, opts.caseSensitive, opts.wholeWord);
     }
 
     // Search from current position to end of buffer
     // Mevcut konumdan buffer sonuna kadar ara
-    for (int i = fromLine; i < totalLines; ++i) {
-        std::string line = buf.getLine(i);
+    auto it = buf.lineAt(fromLine);
+    for (int i = fromLine; i < totalLines; ++i, ++it) {
+        std::string_view line = *it;
         int startCol = (i == fromLine) ? fromCol : 0;
         int mCol, mLen;
 
         bool found = opts.regex
-            ? findRegexInLine(line, re, startCol, mCol, mLen)
-            : findInLine(line, pattern, startCol, opts.caseSensitive, opts.wholeWord, mCol, mLen);
+            ? findRegexInLine(line, *re, startCol, mCol, mLen)
+            : findInLine(line, lit, startCol, mCol, mLen);
 
         if (found) {
-            match = {i, mCol, mCol + mLen, mLen};
+            match = {i, mCol, mCol + mLen, mLen, i};
             return true;
         }
     }
@@ -114,18 +267,19 @@ bool SearchEngine::findForward(const Buffer& buf, const std::string& pattern,
     // Wrap around: search from beginning to current position
     // Sarma: baslangictan mevcut konuma kadar ara
     if (opts.wrapAround) {
-        for (int i = 0; i <= fromLine && i < totalLines; ++i) {
-            std::string line = buf.getLine(i);
+        it = buf.begin();
+        for (int i = 0; i <= fromLine && i < totalLines; ++i, ++it) {
+            std::string_view line = *it;
             int startCol = 0;
             int endLimit = (i == fromLine) ? fromCol : static_cast<int>(line.size());
             int mCol, mLen;
 
             bool found = opts.regex
-                ? findRegexInLine(line, re, startCol, mCol, mLen)
-                : findInLine(line, pattern, startCol, opts.caseSensitive, opts.wholeWord, mCol, mLen);
+                ? findRegexInLine(line, *re, startCol, mCol, mLen)
+                : findInLine(line, lit, startCol, mCol, mLen);
 
             if (found && mCol < endLimit) {
-                match = {i, mCol, mCol + mLen, mLen};
+                match = {i, mCol, mCol + mLen, mLen, i};
                 return true;
             }
         }
@@ -136,29 +290,32 @@ bool SearchEngine::findForward(const Buffer& buf, const std::string& pattern,
 
 // Find backward from (fromLine, fromCol), optionally wrapping around
 // (fromLine, fromCol) konumundan geri ara, istege bagli olarak sar
-bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
+bool SearchEngine::findBackward(const BufferSnapshot& buf, const std::string& pattern,
                                 int fromLine, int fromCol,
                                 SearchMatch& match, const SearchOptions& opts) const {
     if (pattern.empty() || buf.lineCount() == 0) return false;
 
+    if (opts.multiline) {
+        auto re = compileMultiline(pattern, opts);
+        return re && findBackwardMultiline(buf, *re, fromLine, fromCol, opts.wrapAround, match);
+    }
+
     int totalLines = buf.lineCount();
 
-    std::regex re;
+    std::unique_ptr<RegexEngine> re;
+    LiteralMatcher lit;
     if (opts.regex) {
-        try {
-            auto flags = std::regex_constants::ECMAScript;
-            if (!opts.caseSensitive) flags |= std::regex_constants::icase;
-            re = std::regex(pattern, flags);
-        } catch (const std::regex_error& e) {
-            LOG_WARN("[Search] Invalid regex: ", e.what());
-            return false;
-        }
+        re = compileRegex(pattern, opts);
+        if (!re) return false;
+    } else {
+        lit = LiteralMatcher(pattern, opts.caseSensitive, opts.wholeWord);
     }
 
     // Search backward: scan each line for the last match before fromCol
     // Geri arama: her satirda fromCol'dan onceki son eslemeyi tara
-    for (int i = fromLine; i >= 0; --i) {
-        std::string line = buf.getLine(i);
+    auto it = buf.lineAt(fromLine);
+    for (int i = fromLine; i >= 0; --i, --it) {
+        std::string_view line = *it;
         int maxCol = (i == fromLine) ? fromCol : static_cast<int>(line.size());
 
         // Find all matches in line, take the last one before maxCol
@@ -169,8 +326,8 @@ bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
         while (true) {
             int mCol, mLen;
             bool found = opts.regex
-                ? findRegexInLine(line, re, searchFrom, mCol, mLen)
-                : findInLine(line, pattern, searchFrom, opts.caseSensitive, opts.wholeWord, mCol, mLen);
+                ? findRegexInLine(line, *re, searchFrom, mCol, mLen)
+                : findInLine(line, lit, searchFrom, mCol, mLen);
 
             if (!found || mCol >= maxCol) break;
             lastMCol = mCol;
@@ -179,7 +336,7 @@ bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
         }
 
         if (lastMCol >= 0) {
-            match = {i, lastMCol, lastMCol + lastMLen, lastMLen};
+            match = {i, lastMCol, lastMCol + lastMLen, lastMLen, i};
             return true;
         }
     }
@@ -187,8 +344,9 @@ bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
     // Wrap around: search from end to current position
     // Sarma: sondan mevcut konuma kadar ara
     if (opts.wrapAround) {
-        for (int i = totalLines - 1; i >= fromLine; --i) {
-            std::string line = buf.getLine(i);
+        it = buf.lineAt(totalLines - 1);
+        for (int i = totalLines - 1; i >= fromLine; --i, --it) {
+            std::string_view line = *it;
             int maxCol = (i == fromLine) ? static_cast<int>(line.size()) : static_cast<int>(line.size());
 
             int lastMCol = -1, lastMLen = 0;
@@ -197,8 +355,8 @@ bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
             while (true) {
                 int mCol, mLen;
                 bool found = opts.regex
-                    ? findRegexInLine(line, re, searchFrom, mCol, mLen)
-                    : findInLine(line, pattern, searchFrom, opts.caseSensitive, opts.wholeWord, mCol, mLen);
+                    ? findRegexInLine(line, *re, searchFrom, mCol, mLen)
+                    : findInLine(line, lit, searchFrom, mCol, mLen);
 
                 if (!found || mCol >= maxCol) break;
                 lastMCol = mCol;
@@ -207,7 +365,7 @@ bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
             }
 
             if (lastMCol >= 0) {
-                match = {i, lastMCol, lastMCol + lastMLen, lastMLen};
+                match = {i, lastMCol, lastMCol + lastMLen, lastMLen, i};
                 return true;
             }
         }
@@ -218,38 +376,165 @@ bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
 
 // Find all matches in the entire buffer
 // Tum buffer'daki tum eslemeleri bul
-std::vector<SearchMatch> SearchEngine::findAll(const Buffer& buf, const std::string& pattern,
+std::vector<SearchMatch> SearchEngine::findAll(const BufferSnapshot& buf, const std::string& pattern,
                                                const SearchOptions& opts) const {
+    return findAll(buf, pattern, opts, SearchScan{});
+}
+
+// Find all matches, split across the worker pool, within the limits of scan
+// Tum eslemeleri bul, calisan havuzuna bolunmus, scan sinirlari icinde
+std::vector<SearchMatch> SearchEngine::findAll(const BufferSnapshot& buf, const std::string& pattern,
+                                               const SearchOptions& opts, const SearchScan& scan) const {
     std::vector<SearchMatch> results;
-    if (pattern.empty() || buf.lineCount() == 0) return results;
+    scanAll(buf, pattern, opts, scan, &results);
+    return results;
+}
 
-    std::regex re;
-    if (opts.regex) {
-        try {
-            auto flags = std::regex_constants::ECMAScript;
-            if (!opts.caseSensitive) flags |= std::regex_constants::icase;
-            re = std::regex(pattern, flags);
-        } catch (const std::regex_error&) {
-            return results;
-        }
+// Append up to room matches in a line, advancing past each one
+// Bir satirda en fazla room esleme ekle, her birinin otesine gec
+size_t SearchEngine::findInLineAll(std::string_view line, int lineNo, const LiteralMatcher& lit,
+                                   const RegexEngine* re, std::vector<SearchMatch>& out, size_t room) const {
+    size_t added = 0;
+    int searchFrom = 0;
+    while (added < room) {
+        int mCol, mLen;
+        bool found = re
+            ? findRegexInLine(line, *re, searchFrom, mCol, mLen)
+            : findInLine(line, lit, searchFrom, mCol, mLen);
+
+        if (!found) break;
+        out.push_back({lineNo, mCol, mCol + mLen, mLen, lineNo});
+        ++added;
+        searchFrom = mCol + std::max(1, mLen); // Advance past match / Eslemeyi gec
     }
+    return added;
+}
 
-    for (int i = 0; i < buf.lineCount(); ++i) {
-        std::string line = buf.getLine(i);
-        int searchFrom = 0;
-
-        while (true) {
-            int mCol, mLen;
-            bool found = opts.regex
-                ? findRegexInLine(line, re, searchFrom, mCol, mLen)
-                : findInLine(line, pattern, searchFrom, opts.caseSensitive, opts.wholeWord, mCol, mLen);
+// The buffer is split into kParallelChunkLines-line tasks. Each thread compiles its own regex
+// (a compiled one keeps a locked match cache), each task keeps its matches apart, and
+// finished tasks are merged in order as soon as all tasks before them are done; once that
+// ordered prefix holds maxResults matches, later tasks are skipped or abandoned.
+// Buffer kParallelChunkLines satirlik gorevlere bolunur. Her thread kendi regex'ini derler
+// (derlenmis bir regex kilitli bir esleme onbellegi tutar), her gorev eslemelerini ayri tutar
+// ve biten gorevler kendilerinden oncekilerin hepsi bitince sirayla birlestirilir; bu sirali
+// onek maxResults eslemeyi tuttugunda sonraki gorevler atlanir veya birakilir.
+int SearchEngine::scanAll(const BufferSnapshot& buf, const std::string& pattern, const SearchOptions& opts,
+                          const SearchScan& scan, std::vector<SearchMatch>* results) const {
+    const int totalLines = buf.lineCount();
+    if (pattern.empty() || totalLines == 0) return 0;
+
+    const size_t limit = scan.maxResults > 0 ? static_cast<size_t>(scan.maxResults) : SIZE_MAX;
+    const uint64_t generation = cancelGeneration_;
+    auto cancelled = [&]() {
+        return (scan.cancel && scan.cancel->load()) || cancelGeneration_ != generation;
+    };
+
+    if (opts.multiline) {
+        // Matches may cross any line, so ranges cannot be split: one streaming pass
+        // Eslemeler herhangi bir satiri gecebilir, araliklar bolunemez: tek akisli gecis
+        auto re = compileMultiline(pattern, opts);
+        if (!re) return 0;
+        size_t count = 0;
+        int progressLine = 0;
+        scanMultiline(buf, *re, 0, 0, [&](const SearchMatch& m, std::string_view, int) {
+            if (results) results->push_back(m);
+            if (scan.onProgress && m.line >= progressLine + kParallelChunkLines) {
+                progressLine = m.line;
+                scan.onProgress(progressLine, totalLines);
+            }
+            return ++count < limit && !cancelled();
+        });
+        if (scan.onProgress) scan.onProgress(totalLines, totalLines);
+        return static_cast<int>(count);
+    }
 
-            if (!found) break;
-            results.push_back({i, mCol, mCol + mLen, mLen});
-            searchFrom = mCol + std::max(1, mLen); // Advance past match / Eslemeyi gec
+    // Validate once on the calling thread so a bad pattern is reported a single time; a
+    // literal is compiled here and shared, it holds no mutable state
+    // Hatali bir kalip tek sefer bildirilsin diye calisan thread'de bir kez dogrula; literal
+    // burada derlenir ve paylasilir, degisken durum tutmaz
+    if (opts.regex && !compileRegex(pattern, opts)) return 0;
+    const LiteralMatcher lit = opts.regex ? LiteralMatcher() : LiteralMatcher(pattern, opts.caseSensitive, opts.wholeWord);
+
+    ThreadPool& pool = scan.pool ? *scan.pool : ThreadPool::shared();
+    const int tasks = (totalLines + kParallelChunkLines - 1) / kParallelChunkLines;
+    std::vector<std::unique_ptr<RegexEngine>> engines(pool.size() + 1);
+    std::vector<std::vector<SearchMatch>> parts(results ? tasks : 0);
+    std::vector<size_t> counts(tasks, 0);
+    std::vector<char> complete(tasks, 0);
+
+    std::mutex mergeMutex;
+    int merged = 0;              // Tasks [0, merged) are done / [0, merged) gorevleri bitti
+    size_t mergedCount = 0;      // Matches in them / Icerdikleri eslemeler
+    int linesDone = 0;
+    std::atomic<int> needed{tasks};  // Tasks from here on are not needed / Buradan sonraki gorevler gerekmez
+
+    pool.parallelFor(tasks, [&](int task, int slot) {
+        if (task >= needed || cancelled()) return;
+        auto& re = engines[slot];
+        if (opts.regex && !re) re = compileRegex(pattern, opts);
+
+        const int first = task * kParallelChunkLines;
+        const int count = std::min(kParallelChunkLines, totalLines - first);
+        std::vector<SearchMatch> scratch;
+        std::vector<SearchMatch>& out = results ? parts[task] : scratch;
+        size_t found = 0;
+        bool finished = true;
+        buf.forEachChunk(first, count, [&](int firstLine, const std::string_view* lines, int n) {
+            for (int i = 0; i < n && found < limit; ++i) {
+                found += findInLineAll(lines[i], firstLine + i, lit, re.get(), out, limit - found);
+                if (!results) out.clear();
+            }
+            if (found >= limit) return false;
+            if (task >= needed || cancelled()) {
+                finished = false;
+                return false;
+            }
+            return true;
+        });
+
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        counts[task] = found;
+        complete[task] = finished;
+        linesDone += count;
+        while (merged < tasks && complete[merged]) {
+            mergedCount += counts[merged++];
+            if (mergedCount >= limit) needed = std::min<int>(needed, merged);
         }
+        if (scan.onProgress) scan.onProgress(linesDone, totalLines);
+    });
+
+    // Keep the ordered prefix of finished tasks, up to the limit
+    // Biten gorevlerin sirali onekini sinira kadar tut
+    size_t total = 0;
+    for (int task = 0; task < tasks && complete[task] && total < limit; ++task) {
+        size_t take = std::min(counts[task], limit - total);
+        if (results) results->insert(results->end(), parts[task].begin(), parts[task].begin() + take);
+        total += take;
     }
+    return static_cast<int>(total);
+}
 
+// Serial on purpose: the ranges are the few lines an edit touched
+// Bilerek seri: araliklar bir duzenlemenin dokundugu birkac satirdir
+std::vector<SearchMatch> SearchEngine::findInLines(const BufferSnapshot& buf, const std::string& pattern,
+                                                   const SearchOptions& opts,
+                                                   const std::vector<LineRange>& ranges) const {
+    std::vector<SearchMatch> results;
+    if (pattern.empty() || ranges.empty()) return results;
+    std::unique_ptr<RegexEngine> re;
+    if (opts.regex && !(re = compileRegex(pattern, opts))) return results;
+    const LiteralMatcher lit = opts.regex ? LiteralMatcher() : LiteralMatcher(pattern, opts.caseSensitive, opts.wholeWord);
+
+    const int totalLines = buf.lineCount();
+    for (const LineRange& r : ranges) {
+        int first = std::max(0, r.line);
+        int count = std::min(r.line + r.count, totalLines) - first;
+        if (count <= 0) continue;
+        buf.forEachChunk(first, count, [&](int firstLine, const std::string_view* lines, int n) {
+            for (int i = 0; i < n; ++i) findInLineAll(lines[i], firstLine + i, lit, re.get(), results, SIZE_MAX);
+            return true;
+        });
+    }
     return results;
 }
 
@@ -260,87 +545,236 @@ bool SearchEngine::replaceNext(Buffer& buf, const std::string& pattern,
                                int fromLine, int fromCol,
                                SearchMatch& nextMatch, const SearchOptions& opts) {
     SearchMatch current;
-    if (!findForward(buf, pattern, fromLine, fromCol, current, opts)) return false;
-
-    // Perform the replacement
-    // Degistirmeyi gerceklestir
-    std::string line = buf.getLine(current.line);
     std::string newContent;
-
-    if (opts.regex) {
-        // Regex replacement with backreference support ($1, $2, etc.)
-        // Geri referans destekli regex degistirme ($1, $2, vb.)
-        try {
-            auto flags = std::regex_constants::ECMAScript;
-            if (!opts.caseSensitive) flags |= std::regex_constants::icase;
-            std::regex re(pattern, flags);
-            std::string matchedPart = line.substr(current.col, current.length);
-            newContent = std::regex_replace(matchedPart, re, replacement);
-        } catch (const std::regex_error&) {
-            newContent = replacement;
-        }
+    const ReplaceTemplate tmpl(replacement, opts.regex);
+
+    if (opts.multiline) {
+        // The replacement is expanded while the window the match was found in is at hand
+        // Degistirme, eslemenin bulundugu pencere eldeyken genisletilir
+        auto re = compileMultiline(pattern, opts);
+        if (!re) return false;
+        auto expand = [&](const SearchMatch& m, std::string_view window, int offset) {
+            expandMatch(re.get(), tmpl, window, offset, m.length, newContent);
+            return false;
+        };
+        if (!findForwardMultiline(buf.snapshot(), *re, fromLine, fromCol, opts.wrapAround, current, expand)) return false;
     } else {
-        newContent = replacement;
+        if (!findForward(buf, pattern, fromLine, fromCol, current, opts)) return false;
+
+        // Group references ($1, $2, etc.) are expanded against the match in its line so that
+        // anchors and \b see the same context as the search
+        // Grup referanslari ($1, $2, vb.) capalar ve \b aramayla ayni baglami gorsun diye
+        // satirindaki eslemeye gore genisletilir
+        std::unique_ptr<RegexEngine> re;
+        if (opts.regex && tmpl.needsGroups()) re = compileRegex(pattern, opts);
+        expandMatch(re.get(), tmpl, buf.getLine(current.line), current.col, current.length, newContent);
     }
 
     // Delete old text and insert new
     // Eski metni sil ve yenisini ekle
-    buf.deleteRange(current.line, current.col,
-                    current.line, current.col + current.length);
+    buf.deleteRange(current.line, current.col, current.endLine, current.endCol);
     buf.insertText(current.line, current.col, newContent);
 
-    // Find the next match after the replacement
-    // Degistirmeden sonra bir sonraki eslemeyi bul
+    // Find the next match after the replacement, which may itself span lines
+    // Kendisi de satirlara yayilabilen degistirmeden sonra bir sonraki eslemeyi bul
+    int nextLine = current.line;
     int nextCol = current.col + static_cast<int>(newContent.size());
-    findForward(buf, pattern, current.line, nextCol, nextMatch, opts);
+    size_t lastBreak = newContent.rfind('\n');
+    if (lastBreak != std::string::npos) {
+        nextLine += static_cast<int>(std::count(newContent.begin(), newContent.end(), '\n'));
+        nextCol = static_cast<int>(newContent.size() - lastBreak - 1);
+    }
+    findForward(buf, pattern, nextLine, nextCol, nextMatch, opts);
 
     return true;
 }
 
-// Replace all occurrences in the buffer (processes in reverse to preserve positions)
-// Buffer'daki tum oluslari degistir (konumlari korumak icin ters sirada isler)
-int SearchEngine::replaceAll(Buffer& buf, const std::string& pattern,
-                             const std::string& replacement,
-                             const SearchOptions& opts) {
-    auto matches = findAll(buf, pattern, opts);
-    if (matches.empty()) return 0;
+// Rewrite one line from its first match to its last, appending each match's expansion and
+// the text between matches; with group references a single search per match yields both the
+// bounds and the captures
+// Bir satiri ilk eslemesinden sonuncusuna kadar yeniden yaz, her eslemenin genislemesini ve
+// eslemeler arasindaki metni ekleyerek; grup referanslari varsa esleme basina tek arama hem
+// sinirlari hem yakalamalari verir
+bool SearchEngine::rewriteLine(std::string_view line, int lineNo, const LiteralMatcher& lit, const RegexEngine* re,
+                               const ReplaceTemplate& tmpl, LineReplacement& out) const {
+    const bool groups = re && tmpl.needsGroups();
+    out.text.clear();
+    out.matches = 0;
+    int searchFrom = 0;
+    int copied = -1;             // End of the last match, -1 before the first / Son eslemenin sonu, ilkinden once -1
+    RegexMatch m;
+    while (true) {
+        int mCol, mLen;
+        bool found;
+        if (groups) {
+            found = searchFrom <= static_cast<int>(line.size()) && re->search(line, searchFrom, m);
+            mCol = m.position;
+            mLen = m.length;
+        } else {
+            found = re ? findRegexInLine(line, *re, searchFrom, mCol, mLen)
+                       : findInLine(line, lit, searchFrom, mCol, mLen);
+            m.position = mCol;
+            m.length = mLen;
+        }
+        if (!found) break;
 
-    std::regex re;
-    if (opts.regex) {
-        try {
-            auto flags = std::regex_constants::ECMAScript;
-            if (!opts.caseSensitive) flags |= std::regex_constants::icase;
-            re = std::regex(pattern, flags);
-        } catch (const std::regex_error&) {
-            return 0;
+        if (copied < 0) {
+            out.line = out.endLine = lineNo;
+            out.col = copied = mCol;
         }
+        out.text.append(line.substr(copied, mCol - copied));
+        tmpl.expand(line, m, out.text);
+        copied = mCol + mLen;
+        ++out.matches;
+        searchFrom = mCol + std::max(1, mLen); // Advance past match / Eslemeyi gec
     }
+    if (copied < 0) return false;
+    out.endCol = copied;
+    return true;
+}
 
-    // Process matches in reverse order to maintain valid positions
-    // Gecerli konumlari korumak icin eslemeleri ters sirada isle
-    int count = 0;
-    for (int i = static_cast<int>(matches.size()) - 1; i >= 0; --i) {
-        auto& m = matches[i];
-        std::string newContent;
+// Lines are rewritten in kParallelChunkLines-line tasks on ThreadPool::shared(), each thread
+// with its own regex as in scanAll, and the parts joined in order. Multi-line matches are
+// streamed in one pass; a match starting on the line where the previous one ended joins its
+// span, so no line is rewritten twice.
+// Satirlar ThreadPool::shared() uzerinde kParallelChunkLines satirlik gorevlerde yeniden
+// yazilir, scanAll'daki gibi her thread kendi regex'iyle, ve parcalar sirayla birlestirilir.
+// Cok satirli eslemeler tek geciste akitilir; oncekinin bittigi satirda baslayan bir esleme
+// onun araligina katilir, boylece hicbir satir iki kez yeniden yazilmaz.
+std::vector<LineReplacement> SearchEngine::planReplace(const BufferSnapshot& buf, const std::string& pattern,
+                                                       const std::string& replacement, const SearchOptions& opts,
+                                                       bool preview) const {
+    std::vector<LineReplacement> plan;
+    const int totalLines = buf.lineCount();
+    if (pattern.empty() || totalLines == 0) return plan;
+    const ReplaceTemplate tmpl(replacement, opts.regex);
+
+    if (opts.multiline) {
+        auto re = compileMultiline(pattern, opts);
+        if (!re) return plan;
+        scanMultiline(buf, *re, 0, 0, [&](const SearchMatch& m, std::string_view window, int offset) {
+            if (plan.empty() || m.line > plan.back().endLine) {
+                LineReplacement r;
+                r.line = r.endLine = m.line;
+                r.col = r.endCol = m.col;
+                plan.push_back(std::move(r));
+            }
+            LineReplacement& r = plan.back();
+            appendSpan(buf, r.endLine, r.endCol, m.line, m.col, r.text);
+            expandMatch(re.get(), tmpl, window, offset, m.length, r.text);
+            r.endLine = m.endLine;
+            r.endCol = m.endCol;
+            ++r.matches;
+            return true;
+        });
+    } else {
+        if (opts.regex && !compileRegex(pattern, opts)) return plan;
+        const LiteralMatcher lit = opts.regex ? LiteralMatcher() : LiteralMatcher(pattern, opts.caseSensitive, opts.wholeWord);
+
+        ThreadPool& pool = ThreadPool::shared();
+        const int tasks = (totalLines + kParallelChunkLines - 1) / kParallelChunkLines;
+        std::vector<std::unique_ptr<RegexEngine>> engines(pool.size() + 1);
+        std::vector<std::vector<LineReplacement>> parts(tasks);
+        pool.parallelFor(tasks, [&](int task, int slot) {
+            auto& re = engines[slot];
+            if (opts.regex && !re) re = compileRegex(pattern, opts);
+            const int first = task * kParallelChunkLines;
+            const int count = std::min(kParallelChunkLines, totalLines - first);
+            LineReplacement r;
+            buf.forEachChunk(first, count, [&](int firstLine, const std::string_view* lines, int n) {
+                for (int i = 0; i < n; ++i) {
+                    if (rewriteLine(lines[i], firstLine + i, lit, re.get(), tmpl, r)) parts[task].push_back(std::move(r));
+                }
+                return true;
+            });
+        });
 
-        if (opts.regex) {
-            std::string matchedPart = buf.getLine(m.line).substr(m.col, m.length);
-            newContent = std::regex_replace(matchedPart, re, replacement);
-        } else {
-            newContent = replacement;
-        }
+        size_t total = 0;
+        for (const auto& part : parts) total += part.size();
+        plan.reserve(total);
+        for (auto& part : parts) std::move(part.begin(), part.end(), std::back_inserter(plan));
+    }
 
-        buf.deleteRange(m.line, m.col, m.line, m.col + m.length);
-        buf.insertText(m.line, m.col, newContent);
-        ++count;
+    if (preview) {
+        for (auto& r : plan) {
+            appendSpan(buf, r.line, 0, r.endLine, INT32_MAX, r.before);
+            std::string_view last = *buf.lineAt(r.endLine);
+            appendSpan(buf, r.line, 0, r.line, r.col, r.after);
+            r.after += r.text;
+            r.after.append(last.substr(std::min(last.size(), static_cast<size_t>(r.endCol))));
+        }
     }
+    return plan;
+}
+
+// Replace every match: one rewrite per affected line, applied as one batch
+// Her eslemeyi degistir: etkilenen satir basina bir yeniden yazim, tek grup olarak uygulanir
+int SearchEngine::replaceAll(Buffer& buf, const std::string& pattern,
+                             const std::string& replacement,
+                             const SearchOptions& opts,
+                             std::vector<AppliedEdit>* applied) {
+    auto plan = planReplace(buf.snapshot(), pattern, replacement, opts, false);
+    if (plan.empty()) return 0;
 
+    std::vector<TextEdit> edits;
+    edits.reserve(plan.size());
+    int count = 0;
+    for (auto& r : plan) {
+        count += r.matches;
+        edits.push_back({r.line, r.col, r.endLine, r.endCol, std::move(r.text)});
+    }
+    if (!buf.applyEdits(edits, applied)) return 0;
     return count;
 }
 
+// Dry run: the same plan with the lines before and after each rewrite
+// Kuru calisma: her yeniden yazimdan onceki ve sonraki satirlarla ayni plan
+std::vector<LineReplacement> SearchEngine::previewReplaceAll(const BufferSnapshot& buf, const std::string& pattern,
+                                                             const std::string& replacement,
+                                                             const SearchOptions& opts) const {
+    return planReplace(buf, pattern, replacement, opts, true);
+}
+
 // Count total matches for a pattern
 // Bir kalip icin toplam esleme sayisini say
+int SearchEngine::countMatches(const BufferSnapshot& buf, const std::string& pattern,
+                               const SearchOptions& opts) const {
+    return countMatches(buf, pattern, opts, SearchScan{});
+}
+
+// Count matches the same way without collecting them
+// Eslemeleri toplamadan ayni sekilde say
+int SearchEngine::countMatches(const BufferSnapshot& buf, const std::string& pattern,
+                               const SearchOptions& opts, const SearchScan& scan) const {
+    return scanAll(buf, pattern, opts, scan, nullptr);
+}
+
+// Live-buffer entry points: search a snapshot so concurrent edits cannot shift lines mid-scan
+// Canli buffer giris noktalari: eszamanli duzenlemeler taramanin ortasinda satirlari kaydiramasin diye anlik goruntude ara
+bool SearchEngine::findForward(const Buffer& buf, const std::string& pattern,
+                               int fromLine, int fromCol,
+                               SearchMatch& match, const SearchOptions& opts) const {
+    return findForward(buf.snapshot(), pattern, fromLine, fromCol, match, opts);
+}
+
+// Search backward from a snapshot of the live buffer
+// Canli buffer'in anlik goruntusunden geriye dogru ara
+bool SearchEngine::findBackward(const Buffer& buf, const std::string& pattern,
+                                int fromLine, int fromCol,
+                                SearchMatch& match, const SearchOptions& opts) const {
+    return findBackward(buf.snapshot(), pattern, fromLine, fromCol, match, opts);
+}
+
+// Find all matches in a snapshot of the live buffer
+// Canli buffer'in anlik goruntusundeki tum eslemeleri bul
+std::vector<SearchMatch> SearchEngine::findAll(const Buffer& buf, const std::string& pattern,
+                                               const SearchOptions& opts) const {
+    return findAll(buf.snapshot(), pattern, opts);
+}
+
+// Count matches in a snapshot of the live buffer
+// Canli buffer'in anlik goruntusundeki eslemeleri say
 int SearchEngine::countMatches(const Buffer& buf, const std::string& pattern,
                                const SearchOptions& opts) const {
-    return static_cast<int>(findAll(buf, pattern, opts).size());
+    return countMatches(buf.snapshot(), pattern, opts);
 }
@@ -4,11 +4,21 @@
 // See LICENSE file in the project root for full license text.
 
 #pragma once
+#include "LiteralMatcher.h"
+#include "RegexEngine.h"
+#include "ReplaceTemplate.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <regex>
 
 class Buffer;
+class BufferSnapshot;
+class ThreadPool;
+struct AppliedEdit;
 struct TextSpan;
 
 // A single search match with position information
@@ -16,8 +26,9 @@ struct TextSpan;
 struct SearchMatch {
     int line;                    // Match line number / Esleme satir numarasi
     int col;                     // Match start column / Esleme baslangic sutunu
-    int endCol;                  // Match end column / Esleme bitis sutunu
-    int length;                  // Match length in characters / Esleme karakter uzunlugu
+    int endCol;                  // Match end column (on endLine) / Esleme bitis sutunu (endLine uzerinde)
+    int length;                  // Match length in bytes, '\n' included / Esleme bayt uzunlugu, '\n' dahil
+    int endLine = 0;             // Match end line (past line for multi-line matches) / Esleme bitis satiri (cok satirli eslemelerde line'dan sonra)
 };
 
 // Search configuration options
@@ -27,6 +38,38 @@ struct SearchOptions {
     bool regex         = false;  // Use regex pattern / Regex kalip kullan
     bool wholeWord     = false;  // Match whole words only / Yalnizca tam sozcukleri esle
     bool wrapAround    = true;   // Wrap around buffer boundaries / Buffer sinirlarinda sar
+    bool multiline     = false;  // Let matches span lines ("\n" in the pattern) / Eslemeler satirlara yayilabilsin (kalipta "\n")
+};
+
+// One rewrite of a replace-all: the span from the first match to the last on a line (or on a
+// run of lines joined by multi-line matches) and the text that takes its place
+// Bir tumunu degistirmenin tek yeniden yazimi: bir satirdaki (veya cok satirli eslemelerle
+// birlesen bir satir dizisindeki) ilk eslemeden sonuncuya kadarki aralik ve yerine gelen metin
+struct LineReplacement {
+    int line = 0, col = 0;       // Start of the first match / Ilk eslemenin baslangici
+    int endLine = 0, endCol = 0; // End of the last match / Son eslemenin sonu
+    int matches = 0;             // Matches replaced in the span / Aralikta degistirilen eslemeler
+    std::string text;            // New text of the span / Araligin yeni metni
+    std::string before;          // Whole lines line..endLine before (preview only) / line..endLine tum satirlari once (yalnizca onizleme)
+    std::string after;           // The same lines after / Ayni satirlar sonra
+};
+
+// A run of lines [line, line + count)
+// Bir satir dizisi [line, line + count)
+struct LineRange {
+    int line = 0;
+    int count = 0;
+};
+
+// Limits and hooks for findAll/countMatches over large buffers
+// Buyuk buffer'larda findAll/countMatches icin sinirlar ve kancalar
+struct SearchScan {
+    int maxResults = 0;                          // Stop after this many matches, 0 = all / Bu kadar eslemeden sonra dur, 0 = hepsi
+    const std::atomic<bool>* cancel = nullptr;   // Stop early once set / Ayarlandiginda erken dur
+    // Lines scanned so far; called from worker threads, one call at a time
+    // Simdiye kadar taranan satirlar; calisan thread'lerden, her seferinde bir cagri
+    std::function<void(int linesDone, int totalLines)> onProgress;
+    ThreadPool* pool = nullptr;                  // Pool to scan on, nullptr = ThreadPool::shared() / Taranacak havuz, nullptr = ThreadPool::shared()
 };
 
 // Core search engine for find, find-next, replace operations in a buffer.
@@ -39,22 +82,51 @@ class SearchEngine {
 public:
     SearchEngine();
 
+    // Read-only searches on a live buffer run against buf.snapshot()
+    // Canli bir buffer uzerindeki salt okunur aramalar buf.snapshot() uzerinde calisir
+
     // Find the first match starting from (line, col) going forward
     // (line, col) konumundan ileri giderek ilk eslemeyi bul
     bool findForward(const Buffer& buf, const std::string& pattern,
                      int fromLine, int fromCol,
                      SearchMatch& match, const SearchOptions& opts = {}) const;
+    bool findForward(const BufferSnapshot& buf, const std::string& pattern,
+                     int fromLine, int fromCol,
+                     SearchMatch& match, const SearchOptions& opts = {}) const;
 
     // Find the first match starting from (line, col) going backward
     // (line, col) konumundan geri giderek ilk eslemeyi bul
     bool findBackward(const Buffer& buf, const std::string& pattern,
                       int fromLine, int fromCol,
                       SearchMatch& match, const SearchOptions& opts = {}) const;
+    bool findBackward(const BufferSnapshot& buf, const std::string& pattern,
+                      int fromLine, int fromCol,
+                      SearchMatch& match, const SearchOptions& opts = {}) const;
 
     // Find all matches in the entire buffer
     // Tum buffer'daki tum eslemeleri bul
     std::vector<SearchMatch> findAll(const Buffer& buf, const std::string& pattern,
                                      const SearchOptions& opts = {}) const;
+    std::vector<SearchMatch> findAll(const BufferSnapshot& buf, const std::string& pattern,
+                                     const SearchOptions& opts = {}) const;
+
+    // Find matches with a limit, progress and cancellation. Line ranges are searched in
+    // parallel on ThreadPool::shared() (or scan.pool) and merged in order; a cancelled search
+    // returns the matches of the ranges it finished before the first one it did not.
+    // Sinir, ilerleme ve iptal ile eslemeleri bul. Satir araliklari ThreadPool::shared() (veya
+    // scan.pool) uzerinde paralel aranir ve sirayla birlestirilir; iptal edilen arama, bitirmedigi
+    // ilk araliktan onceki bitirdigi araliklarin eslemelerini dondurur.
+    std::vector<SearchMatch> findAll(const BufferSnapshot& buf, const std::string& pattern,
+                                     const SearchOptions& opts, const SearchScan& scan) const;
+
+    // Find the matches starting in the given line ranges (ascending, not overlapping), in
+    // order, compiling the pattern once for all of them. Single-line only: opts.multiline is
+    // ignored, so callers that need multi-line matches rescan with findAll.
+    // Verilen satir araliklarinda (artan, cakismayan) baslayan eslemeleri sirayla bul; kalip
+    // hepsi icin bir kez derlenir. Yalnizca tek satir: opts.multiline yok sayilir, cok satirli
+    // eslemeler gereken cagiranlar findAll ile yeniden tarar.
+    std::vector<SearchMatch> findInLines(const BufferSnapshot& buf, const std::string& pattern,
+                                         const SearchOptions& opts, const std::vector<LineRange>& ranges) const;
 
     // Replace the first match at (line, col) with replacement text
     // (line, col) konumundaki ilk eslemeyi degistirme metniyle degistir
@@ -65,18 +137,40 @@ public:
                      int fromLine, int fromCol,
                      SearchMatch& nextMatch, const SearchOptions& opts = {});
 
-    // Replace all occurrences in the buffer
-    // Buffer'daki tum oluslari degistir
-    // Returns the number of replacements made
-    // Yapilan degistirme sayisini dondurur
+    // Replace all occurrences in the buffer. Each affected line is rebuilt once with the
+    // replacement compiled to a template, and all lines change in one Buffer::applyEdits
+    // batch, reported through applied (record it with UndoManager::addEdits for one undo step).
+    // Returns the number of matches replaced.
+    // Buffer'daki tum oluslari degistir. Etkilenen her satir, sablona derlenmis degistirmeyle
+    // bir kez yeniden kurulur ve tum satirlar tek bir Buffer::applyEdits grubunda degisir,
+    // applied ile bildirilir (tek geri alma adimi icin UndoManager::addEdits ile kaydet).
+    // Degistirilen esleme sayisini dondurur.
     int replaceAll(Buffer& buf, const std::string& pattern,
                    const std::string& replacement,
-                   const SearchOptions& opts = {});
+                   const SearchOptions& opts = {},
+                   std::vector<AppliedEdit>* applied = nullptr);
+
+    // Dry run of replaceAll: the rewrites it would make, in order, with before/after lines
+    // replaceAll'un kuru calismasi: yapacagi yeniden yazimlar sirayla, once/sonra satirlariyla
+    std::vector<LineReplacement> previewReplaceAll(const BufferSnapshot& buf, const std::string& pattern,
+                                                   const std::string& replacement,
+                                                   const SearchOptions& opts = {}) const;
 
     // Get match count for a pattern (useful for status display)
     // Bir kalip icin esleme sayisini al (durum gosterimi icin kullanisli)
     int countMatches(const Buffer& buf, const std::string& pattern,
                      const SearchOptions& opts = {}) const;
+    int countMatches(const BufferSnapshot& buf, const std::string& pattern,
+                     const SearchOptions& opts = {}) const;
+
+    // Count like findAll with a scan, stopping at scan.maxResults
+    // Tarama ile findAll gibi say, scan.maxResults'ta dur
+    int countMatches(const BufferSnapshot& buf, const std::string& pattern,
+                     const SearchOptions& opts, const SearchScan& scan) const;
+
+    // Stop every findAll/countMatches running now (later searches are not affected)
+    // Su anda calisan her findAll/countMatches'i durdur (sonraki aramalar etkilenmez)
+    void cancel() { ++cancelGeneration_; }
 
     // Store last search state for find-next/find-prev
     // Sonrakini-bul/oncekini-bul icin son arama durumunu sakla
@@ -86,26 +180,87 @@ public:
     void setLastOptions(const SearchOptions& opts) { lastOpts_ = opts; }
     const SearchOptions& lastOptions() const { return lastOpts_; }
 
+    // Longest span, in lines, of a multi-line match (the sliding window holds twice this)
+    // Cok satirli bir eslemenin satir cinsinden en uzun yayilimi (kayan pencere bunun iki katini tutar)
+    static void setMultilineMaxLines(int lines);
+    static int multilineMaxLines();
+
+    // Lines per task when findAll/countMatches split a buffer across threads
+    // findAll/countMatches bir buffer'i thread'lere bolerken gorev basina satir
+    static constexpr int kParallelChunkLines = 16384;
+
 private:
-    // Find a literal pattern in a single line starting from column
-    // Bir satirda sutundan baslayarak literal kalip bul
-    bool findInLine(const std::string& line, const std::string& pattern,
-                    int startCol, bool caseSensitive, bool wholeWord,
-                    int& matchCol, int& matchLen) const;
+    // Append the matches in one line to out, at most room of them; returns how many
+    // Bir satirdaki eslemeleri out'a ekle, en fazla room tane; kac tane oldugunu dondurur
+    size_t findInLineAll(std::string_view line, int lineNo, const LiteralMatcher& lit,
+                         const RegexEngine* re, std::vector<SearchMatch>& out, size_t room) const;
+
+    // findAll/countMatches body; matches go to results when it is not null
+    // findAll/countMatches govdesi; results null degilse eslemeler oraya gider
+    int scanAll(const BufferSnapshot& buf, const std::string& pattern, const SearchOptions& opts,
+                const SearchScan& scan, std::vector<SearchMatch>* results) const;
+
+    // Called with each multi-line match, the window text it was found in and its offset
+    // there; return false to stop the scan
+    // Her cok satirli esleme, bulundugu pencere metni ve oradaki ofsetiyle cagrilir; taramayi
+    // durdurmak icin false dondur
+    using WindowVisitor = std::function<bool(const SearchMatch& match, std::string_view window, int offset)>;
+
+    // Stream lines from (fromLine, fromCol) on through a bounded window and report matches
+    // in order, so that "\n" in a pattern matches line breaks without copying the buffer
+    // (fromLine, fromCol)'dan itibaren satirlari sinirli bir pencereden akit ve eslemeleri
+    // sirayla bildir; boylece kaliptaki "\n" buffer kopyalanmadan satir sonlariyla eslesir
+    void scanMultiline(const BufferSnapshot& buf, const RegexEngine& re,
+                       int fromLine, int fromCol, const WindowVisitor& visit) const;
+
+    // Multi-line counterparts of findForward/findBackward
+    // findForward/findBackward'in cok satirli karsiliklari
+    bool findForwardMultiline(const BufferSnapshot& buf, const RegexEngine& re,
+                              int fromLine, int fromCol, bool wrap,
+                              SearchMatch& match, const WindowVisitor& onFound = nullptr) const;
+    bool findBackwardMultiline(const BufferSnapshot& buf, const RegexEngine& re,
+                               int fromLine, int fromCol, bool wrap, SearchMatch& match) const;
+
+    // Append the text replacing the match at [offset, offset + length) of text; captures are
+    // searched for only when the template refers to them
+    // text'in [offset, offset + length) eslemesinin yerine gecen metni ekle; yakalamalar
+    // yalnizca sablon onlara basvurdugunda aranir
+    static void expandMatch(const RegexEngine* re, const ReplaceTemplate& tmpl, std::string_view text,
+                            int offset, int length, std::string& out);
+
+    // Rewrite the matches of one line into out (span and text); false if the line has none
+    // Bir satirin eslemelerini out'a yeniden yaz (aralik ve metin); satirda yoksa false
+    bool rewriteLine(std::string_view line, int lineNo, const LiteralMatcher& lit, const RegexEngine* re,
+                     const ReplaceTemplate& tmpl, LineReplacement& out) const;
+
+    // replaceAll/previewReplaceAll body; before/after are filled when preview is set
+    // replaceAll/previewReplaceAll govdesi; preview ayarliysa before/after doldurulur
+    std::vector<LineReplacement> planReplace(const BufferSnapshot& buf, const std::string& pattern,
+                                             const std::string& replacement, const SearchOptions& opts,
+                                             bool preview) const;
+
+    // Find a compiled literal pattern in a single line starting from column
+    // Bir satirda sutundan baslayarak derlenmis literal kalip bul
+    bool findInLine(std::string_view line, const LiteralMatcher& lit,
+                    int startCol, int& matchCol, int& matchLen) const;
 
     // Find a regex pattern in a single line starting from column
     // Bir satirda sutundan baslayarak regex kalip bul
-    bool findRegexInLine(const std::string& line, const std::regex& re,
+    bool findRegexInLine(std::string_view line, const RegexEngine& re,
                          int startCol, int& matchCol, int& matchLen) const;
 
-    // Convert pattern to lowercase for case-insensitive comparison
-    // Buyuk/kucuk harf duyarsiz karsilastirma icin kalibi kucuk harfe cevir
-    static std::string toLower(const std::string& s);
+    // Compile a regex pattern for a search, nullptr (and a warning) if it is invalid
+    // Bir arama icin regex kalibini derle, gecersizse nullptr (ve bir uyari)
+    static std::unique_ptr<RegexEngine> compileRegex(const std::string& pattern, const SearchOptions& opts);
 
-    // Check if character at position is a word boundary
-    // Konumdaki karakterin sozcuk siniri olup olmadigini kontrol et
-    static bool isWordBoundary(const std::string& line, int pos);
+    // Compile a multi-line search: a regex as is, a literal escaped, \b around whole words
+    // Cok satirli bir aramayi derle: regex oldugu gibi, literal kacisli, tam sozcukler \b ile
+    static std::unique_ptr<RegexEngine> compileMultiline(const std::string& pattern, const SearchOptions& opts);
 
     std::string lastPattern_;    // Last searched pattern / Son aranan kalip
     SearchOptions lastOpts_;     // Last search options / Son arama secenekleri
+
+    std::atomic<uint64_t> cancelGeneration_{0};  // Bumped by cancel() / cancel() ile artar
+
+    static std::atomic<int> multilineMaxLines_;  // Window half size / Pencere yari boyutu
 };
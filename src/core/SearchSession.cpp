@@ -0,0 +1,248 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "SearchSession.h"
+#include "BufferSnapshot.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+// Carry the lines still to rescan (sorted, disjoint) through one change: ranges above it stay,
+// ranges below it shift, and ranges it touches merge with the lines it added
+// Yeniden taranacak satirlari (sirali, ayrik) tek bir degisiklikten gecir: ustundeki araliklar
+// kalir, altindakiler kayar, dokunduklari eklenen satirlarla birlesir
+void carryDirty(std::vector<LineRange>& dirty, const LineChange& c) {
+    const int end = c.line + c.removed;
+    const int shift = c.added - c.removed;
+    int lo = c.line, hi = c.line + c.added;
+    std::vector<LineRange> next;
+    next.reserve(dirty.size() + 1);
+    size_t i = 0;
+    for (; i < dirty.size() && dirty[i].line + dirty[i].count <= c.line; ++i) {
+        next.push_back(dirty[i]);
+    }
+    for (; i < dirty.size() && dirty[i].line < end; ++i) {
+        lo = std::min(lo, dirty[i].line);
+        hi = std::max(hi, dirty[i].line + dirty[i].count + shift);
+    }
+    if (hi > lo) next.push_back({lo, hi - lo});
+    for (; i < dirty.size(); ++i) next.push_back({dirty[i].line + shift, dirty[i].count});
+    dirty = std::move(next);
+}
+
+} // namespace
+
+// Nothing is scanned until the first refresh()
+// Ilk refresh()'e kadar hicbir sey taranmaz
+SearchSession::SearchSession(std::string pattern, const SearchOptions& opts)
+    : pattern_(std::move(pattern)), opts_(opts) {}
+
+// Replay the journal when it still reaches the last refresh, else rebuild. Lines past the ones
+// the results describe (the file was still loading) come in as appended runs first.
+// Gunluk son yenilemeye hala uzaniyorsa onu tekrar oynat, yoksa yeniden kur. Sonuclarin
+// tanimladigi satirlarin otesindeki satirlar (dosya hala yukleniyordu) once eklenmis diziler olarak gelir.
+bool SearchSession::refresh(const Buffer& buf, const SearchEngine& engine, SearchDelta* delta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (buffer_ && buffer_ != &buf) return false;
+    buffer_ = &buf;
+    BufferSnapshot snap = buf.snapshot();
+    const int total = snap.lineCount();
+    if (scanned_ && snap.version() == version_ && total == lines_) return false;
+
+    SearchDelta d;
+    std::vector<LineChange> changes;
+    bool incremental = scanned_ && !opts_.multiline && buf.changesSince(version_, snap.version(), changes);
+    if (incremental) {
+        std::vector<LineRange> dirty;
+        auto apply = [&](const LineChange& c) {
+            d.removed += applyChange(c);
+            d.lines.push_back(c);
+            lines_ += c.added - c.removed;
+            carryDirty(dirty, c);
+        };
+        for (const LineChange& c : changes) {
+            if (c.line + c.removed > lines_) apply({lines_, 0, c.line + c.removed - lines_});
+            apply(c);
+        }
+        if (lines_ < total) apply({lines_, 0, total - lines_});
+
+        int dirtyLines = 0;
+        for (const LineRange& r : dirty) dirtyLines += r.count;
+        incremental = lines_ == total && dirtyLines <= SearchEngine::kParallelChunkLines;
+        if (incremental) {
+            d.added = engine.findInLines(snap, pattern_, opts_, dirty);
+            insertMatches(d.added);
+            count_ += static_cast<int>(d.added.size());
+        }
+    }
+    if (!incremental) {
+        d = SearchDelta();
+        d.reset = true;
+        d.removed = count_;
+        rebuild(snap, engine);
+    }
+
+    version_ = snap.version();
+    scanned_ = true;
+    d.version = version_;
+    d.count = count_;
+    bool changed = d.reset || !d.lines.empty();
+    if (delta) *delta = std::move(d);
+    return changed;
+}
+
+// Cut the sorted matches into blocks; they all start at base 0
+// Sirali eslemeleri bloklara kes; hepsi 0 tabaninda baslar
+void SearchSession::rebuild(const BufferSnapshot& snap, const SearchEngine& engine) {
+    std::vector<SearchMatch> all = engine.findAll(snap, pattern_, opts_);
+    blocks_.clear();
+    maxSpan_ = 0;
+    for (size_t from = 0; from < all.size(); from += kBlockSize) {
+        Block b;
+        b.matches.assign(all.begin() + from, all.begin() + std::min(all.size(), from + kBlockSize));
+        for (const SearchMatch& m : b.matches) maxSpan_ = std::max(maxSpan_, m.endLine - m.line);
+        blocks_.push_back(std::move(b));
+    }
+    count_ = static_cast<int>(all.size());
+    lines_ = snap.lineCount();
+}
+
+// The replaced lines may cover several blocks; the first block left holding lines below them
+// shifts match by match, every block after it only moves its base
+// Degistirilen satirlar birden fazla blogu kapsayabilir; altlarinda satir tutan ilk blok esleme
+// esleme kayar, ondan sonraki her blok yalnizca tabanini tasir
+int SearchSession::applyChange(const LineChange& c) {
+    const int end = c.line + c.removed;
+    const int shift = c.added - c.removed;
+    int dropped = 0;
+
+    size_t i = blockFor(c.line);
+    while (i < blocks_.size() && blocks_[i].firstLine() < end) {
+        Block& b = blocks_[i];
+        auto lo = std::partition_point(b.matches.begin(), b.matches.end(),
+                                       [&](const SearchMatch& m) { return m.line < c.line - b.base; });
+        auto hi = std::partition_point(lo, b.matches.end(),
+                                       [&](const SearchMatch& m) { return m.line < end - b.base; });
+        dropped += static_cast<int>(hi - lo);
+        b.matches.erase(lo, hi);
+        if (b.matches.empty()) {
+            blocks_.erase(blocks_.begin() + i);
+        } else if (b.lastLine() < end) {
+            ++i;
+        } else {
+            break;
+        }
+    }
+    count_ -= dropped;
+    if (shift == 0 || i == blocks_.size()) return dropped;
+
+    Block& b = blocks_[i];
+    if (b.firstLine() >= end) {
+        b.base += shift;
+    } else {
+        auto it = std::partition_point(b.matches.begin(), b.matches.end(),
+                                       [&](const SearchMatch& m) { return m.line < end - b.base; });
+        for (; it != b.matches.end(); ++it) {
+            it->line += shift;
+            it->endLine += shift;
+        }
+    }
+    for (++i; i < blocks_.size(); ++i) blocks_[i].base += shift;
+    return dropped;
+}
+
+// Matches go in runs: each run is the stretch of found that fits between two existing matches
+// of one block, inserted with a single vector insert
+// Eslemeler diziler halinde girer: her dizi, found'un bir bloktaki iki mevcut esleme arasina
+// sigan kismidir ve tek bir vektor eklemesiyle eklenir
+void SearchSession::insertMatches(const std::vector<SearchMatch>& found) {
+    size_t k = 0;
+    while (k < found.size()) {
+        size_t i = 0;
+        if (blocks_.empty()) blocks_.emplace_back();
+        else i = std::min(blockFor(found[k].line), blocks_.size() - 1);
+        Block& b = blocks_[i];
+        auto pos = std::partition_point(b.matches.begin(), b.matches.end(),
+                                        [&](const SearchMatch& m) { return m.line < found[k].line - b.base; });
+        int limit = INT_MAX;
+        if (pos != b.matches.end()) limit = b.base + pos->line;
+        else if (i + 1 < blocks_.size()) limit = blocks_[i + 1].firstLine();
+
+        size_t m = k;
+        while (m < found.size() && found[m].line < limit) ++m;
+        std::vector<SearchMatch> run(found.begin() + k, found.begin() + m);
+        for (SearchMatch& r : run) {
+            r.line -= b.base;
+            r.endLine -= b.base;
+        }
+        b.matches.insert(pos, run.begin(), run.end());
+        splitBlock(i);
+        k = m;
+    }
+}
+
+// First block whose last match line is at or after line (blocks_.size() if none)
+// Son esleme satiri line'da veya sonrasinda olan ilk blok (yoksa blocks_.size())
+size_t SearchSession::blockFor(int line) const {
+    auto it = std::partition_point(blocks_.begin(), blocks_.end(),
+                                   [line](const Block& b) { return b.lastLine() < line; });
+    return static_cast<size_t>(it - blocks_.begin());
+}
+
+// Cut a block grown past twice kBlockSize into kBlockSize pieces with the same base
+// Iki kBlockSize'i asan bir blogu ayni tabanla kBlockSize'lik parcalara kes
+void SearchSession::splitBlock(size_t index) {
+    Block& b = blocks_[index];
+    if (b.matches.size() <= 2 * kBlockSize) return;
+    std::vector<Block> parts;
+    for (size_t from = 0; from < b.matches.size(); from += kBlockSize) {
+        Block part;
+        part.base = b.base;
+        part.matches.assign(b.matches.begin() + from,
+                            b.matches.begin() + std::min(b.matches.size(), from + kBlockSize));
+        parts.push_back(std::move(part));
+    }
+    blocks_.erase(blocks_.begin() + index);
+    blocks_.insert(blocks_.begin() + index, std::make_move_iterator(parts.begin()),
+                   std::make_move_iterator(parts.end()));
+}
+
+// Multi-line matches may start above the range and reach into it, so the search starts
+// maxSpan_ lines early and skips matches ending before firstLine
+// Cok satirli eslemeler araligin ustunde baslayip icine uzanabilir, bu yuzden arama maxSpan_
+// satir erken baslar ve firstLine'dan once biten eslemeleri atlar
+std::vector<SearchMatch> SearchSession::query(int firstLine, int lastLine) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SearchMatch> out;
+    const int from = firstLine - maxSpan_;
+    for (size_t i = blockFor(from); i < blocks_.size() && blocks_[i].firstLine() <= lastLine; ++i) {
+        const Block& b = blocks_[i];
+        auto it = std::partition_point(b.matches.begin(), b.matches.end(),
+                                       [&](const SearchMatch& m) { return m.line < from - b.base; });
+        for (; it != b.matches.end() && b.base + it->line <= lastLine; ++it) {
+            if (b.base + it->endLine < firstLine) continue;
+            SearchMatch m = *it;
+            m.line += b.base;
+            m.endLine += b.base;
+            out.push_back(m);
+        }
+    }
+    return out;
+}
+
+// Matches as of the last refresh
+// Son yenilemedeki eslemeler
+int SearchSession::count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+// Buffer version the results describe
+// Sonuclarin tanimladigi buffer surumu
+uint64_t SearchSession::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
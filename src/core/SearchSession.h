@@ -0,0 +1,114 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include "SearchEngine.h"
+#include "buffer.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// What one refresh of a search session changed, for clients keeping their own copy of the
+// results: drop the matches of each replaced line run in order, shifting the ones below it by
+// added - removed, then insert the new matches. A reset means everything was rescanned.
+// Bir arama oturumunun tek yenilemesinin degistirdikleri, sonuclarin kendi kopyasini tutan
+// istemciler icin: degistirilen her satir dizisinin eslemelerini sirayla at, altindakileri
+// added - removed kadar kaydir, sonra yeni eslemeleri ekle. reset her seyin yeniden tarandigi anlamina gelir.
+struct SearchDelta {
+    uint64_t version = 0;              // Buffer version the results now match / Sonuclarin simdi uydugu buffer surumu
+    bool reset = false;                // Results rebuilt: drop all and query again / Sonuclar yeniden kuruldu: hepsini at ve yeniden sorgula
+    std::vector<LineChange> lines;     // Line runs replaced, in order / Degistirilen satir dizileri, sirayla
+    std::vector<SearchMatch> added;    // Matches found in them, current positions / Icinde bulunan eslemeler, guncel konumlar
+    int removed = 0;                   // Matches dropped with the runs / Dizilerle atilan eslemeler
+    int count = 0;                     // Total matches after the refresh / Yenilemeden sonraki toplam esleme
+};
+
+// Search results of one buffer kept up to date as it is edited (search highlighting).
+// Bir buffer'in duzenlendikce guncel tutulan arama sonuclari (arama vurgulamasi).
+// Matches are indexed by line in blocks of consecutive matches whose lines are stored
+// relative to a per-block base, so an edit drops the matches of the lines it replaced and
+// shifts everything below by adjusting one base per block. A refresh replays the buffer's line
+// journal (Buffer::changesSince) and rescans only the replaced lines; a viewport query is a
+// binary search over blocks and then one within a block, O(log n + k).
+// Eslemeler satira gore, satirlari blok basina bir tabana gore saklanan ardisik esleme
+// bloklarinda indekslenir; boylece bir duzenleme degistirdigi satirlarin eslemelerini atar ve
+// alttaki her seyi blok basina bir taban ayarlayarak kaydirir. Yenileme buffer'in satir
+// gunlugunu (Buffer::changesSince) tekrar oynatir ve yalnizca degistirilen satirlari yeniden
+// tarar; gorunum sorgusu bloklar uzerinde, sonra bir blok icinde ikili aramadir, O(log n + k).
+// Multi-line searches rescan the whole buffer on every change. Calls are serialized.
+// Cok satirli aramalar her degisiklikte tum buffer'i yeniden tarar. Cagrilar siralanir.
+class SearchSession {
+public:
+    SearchSession(std::string pattern, const SearchOptions& opts);
+
+    const std::string& pattern() const { return pattern_; }
+    const SearchOptions& options() const { return opts_; }
+
+    // Bring the results up to date with buf; false if they already were. delta (if given)
+    // receives what changed. A session belongs to the buffer of its first refresh; a refresh
+    // with any other buffer changes nothing and returns false.
+    // Sonuclari buf ile guncelle; zaten gunceldiyse false. delta (verildiyse) degisenleri alir.
+    // Bir oturum ilk yenilemesinin buffer'ina aittir; baska bir buffer ile yenileme hicbir seyi
+    // degistirmez ve false dondurur.
+    bool refresh(const Buffer& buf, const SearchEngine& engine, SearchDelta* delta = nullptr);
+
+    // Matches overlapping lines [firstLine, lastLine], in order, as of the last refresh
+    // Son yenilemedeki haliyle [firstLine, lastLine] satirlariyla kesisen eslemeler, sirayla
+    std::vector<SearchMatch> query(int firstLine, int lastLine) const;
+
+    // Total matches as of the last refresh
+    // Son yenilemedeki toplam esleme
+    int count() const;
+
+    // Buffer version of the last refresh
+    // Son yenilemenin buffer surumu
+    uint64_t version() const;
+
+    // Matches per block; a block is split once it holds twice this
+    // Blok basina esleme; bir blok bunun iki katini tuttugunda bolunur
+    static constexpr size_t kBlockSize = 512;
+
+private:
+    // Matches of consecutive lines; line and endLine are relative to base
+    // Ardisik satirlarin eslemeleri; line ve endLine base'e goredir
+    struct Block {
+        int base = 0;
+        std::vector<SearchMatch> matches;
+        int firstLine() const { return base + matches.front().line; }
+        int lastLine() const { return base + matches.back().line; }
+    };
+
+    // Rescan the whole buffer and rebuild the blocks
+    // Tum buffer'i yeniden tara ve bloklari yeniden kur
+    void rebuild(const BufferSnapshot& snap, const SearchEngine& engine);
+
+    // Drop the matches of a replaced line run and shift those below; returns how many were dropped
+    // Degistirilen bir satir dizisinin eslemelerini at ve alttakileri kaydir; kac tane atildigini dondurur
+    int applyChange(const LineChange& change);
+
+    // Insert matches, sorted, on lines that hold none yet
+    // Henuz esleme tutmayan satirlara sirali eslemeleri ekle
+    void insertMatches(const std::vector<SearchMatch>& found);
+
+    // First block whose last match line is at or after line (blocks_.size() if none)
+    // Son esleme satiri line'da veya sonrasinda olan ilk blok (yoksa blocks_.size())
+    size_t blockFor(int line) const;
+
+    // Split an oversized block in place
+    // Asiri buyuk bir blogu yerinde bol
+    void splitBlock(size_t index);
+
+    mutable std::mutex mutex_;
+    std::string pattern_;
+    SearchOptions opts_;
+    std::vector<Block> blocks_;  // Non-empty, in line order / Bos degil, satir sirasinda
+    int count_ = 0;              // Matches in all blocks / Tum bloklardaki eslemeler
+    int lines_ = 0;              // Line count the results describe / Sonuclarin tanimladigi satir sayisi
+    int maxSpan_ = 0;            // Most lines a match spans past its first / Bir eslemenin ilkinden sonra yayildigi en fazla satir
+    uint64_t version_ = 0;       // Buffer version of the results / Sonuclarin buffer surumu
+    bool scanned_ = false;       // Results exist / Sonuclar var
+    const Buffer* buffer_ = nullptr;  // Buffer the results describe / Sonuclarin tanimladigi buffer
+};
@@ -5,6 +5,7 @@
 
 #include "SessionManager.h"
 #include "buffers.h"
+#include "UndoFile.h"
 #include "Logger.h"
 #include "nlohmann/json.hpp"
 #include <fstream>
@@ -59,6 +60,7 @@ SessionState SessionManager::buildState(const Buffers& buffers) const {
             doc.cursorCol = active.getCursor().getCol();
             doc.filePath = active.getFilePath();
         }
+        if (auto journal = buffers.getStateAt(i).getUndo().journal()) doc.undoFile = journal->journalPath();
 
         // Only add documents that have actual file paths
         // Sadece gercek dosya yollari olan belgeleri ekle
@@ -98,6 +100,7 @@ std::string SessionManager::toJson(const SessionState& state) const {
         d["cursorCol"] = doc.cursorCol;
         d["scrollTop"] = doc.scrollTop;
         d["isActive"] = doc.isActive;
+        if (!doc.undoFile.empty()) d["undoFile"] = doc.undoFile;
         docs.push_back(d);
     }
     j["documents"] = docs;
@@ -125,6 +128,7 @@ bool SessionManager::fromJson(const std::string& jsonStr, SessionState& state) c
                 doc.cursorCol = d.value("cursorCol", 0);
                 doc.scrollTop = d.value("scrollTop", 0);
                 doc.isActive = d.value("isActive", false);
+                doc.undoFile = d.value("undoFile", "");
                 state.documents.push_back(doc);
             }
         }
@@ -146,6 +150,9 @@ bool SessionManager::save(const Buffers& buffers) {
         return false;
     }
 
+    // The session must not name undo history that is still only in memory
+    // Oturum hala yalnizca bellekte olan geri alma gecmisini adlandirmamali
+    buffers.flushUndo();
     SessionState state = buildState(buffers);
     lastState_ = state;
 
@@ -19,6 +19,7 @@ struct SessionDocument {
     int cursorCol = 0;       // Cursor column position / Imlec sutun konumu
     int scrollTop = 0;       // Scroll position / Kayma konumu
     bool isActive = false;   // Whether this is the active document / Aktif belge olup olmadigi
+    std::string undoFile;    // Persisted undo history, if any / Varsa kalici geri alma gecmisi
 };
 
 // Complete session state
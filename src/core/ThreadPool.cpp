@@ -0,0 +1,111 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+std::atomic<int> ThreadPool::defaultThreads_{0};
+
+// Start the workers
+// Calisanlari baslat
+ThreadPool::ThreadPool(int threads) {
+    for (int i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i] { run(i + 1); });
+    }
+}
+
+// Wake every worker to exit and join them
+// Cikmalari icin her calisani uyandir ve onlari bekle
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+// Created on first use with defaultThreads() workers
+// Ilk kullanimda defaultThreads() calisanla olusturulur
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(defaultThreads());
+    return pool;
+}
+
+// Worker count for the shared pool; 0 picks one per core minus the caller
+// Paylasilan havuz icin calisan sayisi; 0 cagiran haric cekirdek basina bir tane secer
+void ThreadPool::setDefaultThreads(int threads) {
+    defaultThreads_ = std::max(0, threads);
+}
+
+// The configured count, else hardware threads minus one (at least one)
+// Ayarlanan sayi, yoksa donanim thread'lerinin bir eksigi (en az bir)
+int ThreadPool::defaultThreads() {
+    int n = defaultThreads_;
+    if (n > 0) return n;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+}
+
+// Claim tasks until none are left; the first exception is kept for the caller
+// Hic kalmayana kadar gorev al; ilk istisna cagiran icin saklanir
+void ThreadPool::runTasks(Job& job, int slot) {
+    for (int task = job.next++; task < job.tasks; task = job.next++) {
+        try {
+            (*job.fn)(task, slot);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!job.error) job.error = std::current_exception();
+        }
+        if (++job.finished == job.tasks) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            doneCv_.notify_all();
+        }
+    }
+}
+
+// Worker loop: help with the oldest job until the pool stops
+// Calisan dongusu: havuz durana kadar en eski ise yardim et
+void ThreadPool::run(int slot) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+        if (stop_) return;
+        std::shared_ptr<Job> job = jobs_.front();
+        lock.unlock();
+        runTasks(*job, slot);
+        lock.lock();
+        // Every task is claimed: stop offering the job to other workers
+        // Her gorev alindi: isi diger calisanlara sunmayi birak
+        auto it = std::find(jobs_.begin(), jobs_.end(), job);
+        if (it != jobs_.end()) jobs_.erase(it);
+    }
+}
+
+// The caller runs tasks too (slot 0), then waits for the ones workers claimed
+// Cagiran da gorev calistirir (slot 0), sonra calisanlarin aldiklarini bekler
+void ThreadPool::parallelFor(int tasks, const TaskFn& fn) {
+    if (tasks <= 0) return;
+    if (tasks == 1 || workers_.empty()) {
+        for (int task = 0; task < tasks; ++task) fn(task, 0);
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->fn = &fn;
+    job->tasks = tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(job);
+    }
+    cv_.notify_all();
+
+    runTasks(*job, 0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it != jobs_.end()) jobs_.erase(it);
+    doneCv_.wait(lock, [&] { return job->finished == job->tasks; });
+    if (job->error) std::rethrow_exception(job->error);
+}
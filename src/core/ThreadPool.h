@@ -0,0 +1,88 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel jobs (search over line ranges, grep over files).
+// Veri paralel isler icin sabit calisan thread kumesi (satir araliklarinda arama, dosyalarda grep).
+// A job is a number of independent tasks; workers and the calling thread claim them in
+// increasing order until none are left, so the caller never waits on an idle pool and a
+// task may start a nested job without deadlocking. Several jobs can run at once.
+// Bir is bagimsiz gorevlerden olusur; calisanlar ve cagiran thread onlari artan sirayla
+// bitene kadar alir; boylece cagiran bos bir havuzu beklemez ve bir gorev kilitlenmeden ic
+// ice bir is baslatabilir. Birden cok is ayni anda calisabilir.
+class ThreadPool {
+public:
+    // Task body: task index in [0, tasks), slot in [0, size()] unique per thread within a job
+    // (0 is the caller), for per-thread scratch state
+    // Gorev govdesi: [0, tasks) icinde gorev indeksi, bir is icinde thread basina benzersiz
+    // [0, size()] icinde yuva (0 cagirandir), thread basina gecici durum icin
+    using TaskFn = std::function<void(int task, int slot)>;
+
+    explicit ThreadPool(int threads);
+
+    // Finish running jobs, then join the workers
+    // Calisan isleri bitir, sonra calisanlari birlestir
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool, created on first use with defaultThreads() workers
+    // Ilk kullanimda defaultThreads() calisanla olusturulan surec geneli havuz
+    static ThreadPool& shared();
+
+    // Worker count for shared(): 0 = one per hardware thread minus the caller (set before first use)
+    // shared() icin calisan sayisi: 0 = cagiran haric donanim thread'i basina bir (ilk kullanimdan once ayarla)
+    static void setDefaultThreads(int threads);
+    static int defaultThreads();
+
+    // Number of workers, the calling thread not included
+    // Cagiran thread haric calisan sayisi
+    int size() const { return static_cast<int>(workers_.size()); }
+
+    // Run fn for every task and return once all have finished; the first exception a task
+    // throws is rethrown here after the rest have run
+    // Her gorev icin fn'i calistir ve hepsi bitince don; bir gorevin attigi ilk istisna geri
+    // kalanlar calistiktan sonra burada yeniden atilir
+    void parallelFor(int tasks, const TaskFn& fn);
+
+private:
+    // One parallelFor call
+    // Tek bir parallelFor cagrisi
+    struct Job {
+        const TaskFn* fn = nullptr;
+        int tasks = 0;
+        std::atomic<int> next{0};       // Next unclaimed task / Alinmamis sonraki gorev
+        std::atomic<int> finished{0};   // Tasks done / Biten gorevler
+        std::exception_ptr error;       // First failure, under mutex_ / Ilk hata, mutex_ altinda
+    };
+
+    // Claim and run tasks of job until none are left
+    // Hicbiri kalmayana kadar isin gorevlerini al ve calistir
+    void runTasks(Job& job, int slot);
+
+    // Worker loop: wait for a job with unclaimed tasks, help with it
+    // Calisan dongusu: alinmamis gorevi olan bir is bekle, ona yardim et
+    void run(int slot);
+
+    std::mutex mutex_;
+    std::condition_variable cv_;        // Wakes workers / Calisanlari uyandirir
+    std::condition_variable doneCv_;    // Wakes callers waiting on their job / Isini bekleyen cagiranlari uyandirir
+    std::deque<std::shared_ptr<Job>> jobs_;  // Jobs with unclaimed tasks / Alinmamis gorevi olan isler
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+
+    static std::atomic<int> defaultThreads_;
+};
@@ -0,0 +1,286 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Transcoder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kBad = 0xFFFFFFFFu;           // Malformed UTF-8 / Bozuk UTF-8
+constexpr std::string_view kReplacementUTF8 = "\xEF\xBF\xBD";
+
+// Append a code point as UTF-8 (caller passes a valid scalar value)
+// Bir kod noktasini UTF-8 olarak ekle (cagiran gecerli bir skaler deger verir)
+void appendUTF8(uint32_t cp, std::string& out) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Read the UTF-8 sequence at p: the bytes it spans with cp set (kBad when malformed), or 0
+// when the input ends inside a sequence that is valid so far
+// p'deki UTF-8 dizisini oku: kapladigi baytlar ve ayarlanan cp (bozuksa kBad) veya girdi
+// simdiye kadar gecerli olan bir dizinin icinde biterse 0
+size_t readUTF8(const uint8_t* p, size_t avail, uint32_t& cp) {
+    uint8_t b = p[0];
+    if (b < 0x80) {
+        cp = b;
+        return 1;
+    }
+    size_t len;
+    uint32_t min;
+    if (b >= 0xC2 && b <= 0xDF) { len = 2; cp = b & 0x1F; min = 0x80; }
+    else if ((b & 0xF0) == 0xE0) { len = 3; cp = b & 0x0F; min = 0x800; }
+    else if (b >= 0xF0 && b <= 0xF4) { len = 4; cp = b & 0x07; min = 0x10000; }
+    else {
+        cp = kBad;
+        return 1;
+    }
+    for (size_t k = 1; k < len; ++k) {
+        if (k >= avail) return 0;
+        // Resynchronize at the byte that is not a continuation
+        // Devam bayti olmayan baytta yeniden esitlen
+        if ((p[k] & 0xC0) != 0x80) {
+            cp = kBad;
+            return k;
+        }
+        cp = (cp << 6) | (p[k] & 0x3F);
+    }
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) cp = kBad;
+    return len;
+}
+
+} // namespace
+
+// Unit size and byte order follow the encoding; everything else decodes byte by byte
+// Birim boyutu ve bayt sirasi kodlamayi izler; geri kalan her sey bayt bayt cozulur
+Transcoder::Transcoder(TextEncoding encoding) : encoding_(encoding) {
+    switch (encoding) {
+        case TextEncoding::UTF16_LE: unitSize_ = 2; littleEndian_ = true;  break;
+        case TextEncoding::UTF16_BE: unitSize_ = 2; littleEndian_ = false; break;
+        case TextEncoding::UTF32_LE: unitSize_ = 4; littleEndian_ = true;  break;
+        case TextEncoding::UTF32_BE: unitSize_ = 4; littleEndian_ = false; break;
+        default:                     unitSize_ = 1; littleEndian_ = true;  break;
+    }
+}
+
+// UTF-8 (with or without BOM), ASCII and unknown encodings are kept as they are
+// UTF-8 (BOM'lu veya BOM'suz), ASCII ve bilinmeyen kodlamalar oldugu gibi tutulur
+bool Transcoder::isPassthrough(TextEncoding encoding) {
+    switch (encoding) {
+        case TextEncoding::UTF16_LE:
+        case TextEncoding::UTF16_BE:
+        case TextEncoding::UTF32_LE:
+        case TextEncoding::UTF32_BE:
+        case TextEncoding::Latin1:
+            return false;
+        default:
+            return true;
+    }
+}
+
+// The BOM bytes an encoding is written with, empty if it has none
+// Bir kodlamanin yazildigi BOM baytlari, yoksa bos
+std::string_view Transcoder::byteOrderMark(TextEncoding encoding) {
+    switch (encoding) {
+        case TextEncoding::UTF8_BOM: return std::string_view("\xEF\xBB\xBF", 3);
+        case TextEncoding::UTF16_LE: return std::string_view("\xFF\xFE", 2);
+        case TextEncoding::UTF16_BE: return std::string_view("\xFE\xFF", 2);
+        case TextEncoding::UTF32_LE: return std::string_view("\xFF\xFE\0\0", 4);
+        case TextEncoding::UTF32_BE: return std::string_view("\0\0\xFE\xFF", 4);
+        default:                     return {};
+    }
+}
+
+// Whole units are converted in place; only the bytes of a unit cut by the chunk end are held
+// Tam birimler yerinde donusturulur; yalnizca parca sonunda kesilen birimin baytlari tutulur
+void Transcoder::decode(const uint8_t* data, size_t size, std::string& out) {
+    if (isPassthrough(encoding_)) {
+        out.append(reinterpret_cast<const char*>(data), size);
+        return;
+    }
+
+    if (unitSize_ == 1) {
+        // Latin-1: every byte is the code point of the same value
+        // Latin-1: her bayt ayni degerdeki kod noktasidir
+        for (size_t i = 0; i < size; ++i) {
+            uint8_t b = data[i];
+            if (b < 0x80) {
+                out += static_cast<char>(b);
+            } else {
+                out += static_cast<char>(0xC0 | (b >> 6));
+                out += static_cast<char>(0x80 | (b & 0x3F));
+            }
+        }
+        return;
+    }
+
+    auto load = [this](const uint8_t* p) -> uint32_t {
+        if (unitSize_ == 2) {
+            return littleEndian_ ? (p[0] | (static_cast<uint32_t>(p[1]) << 8))
+                                 : ((static_cast<uint32_t>(p[0]) << 8) | p[1]);
+        }
+        return littleEndian_
+            ? (p[0] | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+               (static_cast<uint32_t>(p[3]) << 24))
+            : ((static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3]);
+    };
+
+    size_t i = 0;
+    if (heldLen_ > 0) {
+        i = std::min(unitSize_ - heldLen_, size);
+        std::memcpy(held_ + heldLen_, data, i);
+        heldLen_ += i;
+        if (heldLen_ < unitSize_) return;
+        decodeUnit(load(held_), out);
+        heldLen_ = 0;
+    }
+
+    for (; i + unitSize_ <= size; i += unitSize_) {
+        uint32_t unit = load(data + i);
+        if (unit < 0x80 && highSurrogate_ == 0) out += static_cast<char>(unit);
+        else decodeUnit(unit, out);
+    }
+
+    heldLen_ = size - i;
+    std::memcpy(held_, data + i, heldLen_);
+}
+
+// A dangling high surrogate or cut unit at the end of input becomes U+FFFD
+// Girdi sonunda sarkan yuksek vekil veya kesik birim U+FFFD olur
+void Transcoder::finishDecode(std::string& out) {
+    if (highSurrogate_ != 0) out += kReplacementUTF8;
+    if (heldLen_ > 0) out += kReplacementUTF8;
+    highSurrogate_ = 0;
+    heldLen_ = 0;
+}
+
+// A high surrogate waits for the next unit, which may arrive in the next chunk
+// Yuksek vekil, sonraki parcada gelebilecek sonraki birimi bekler
+void Transcoder::decodeUnit(uint32_t unit, std::string& out) {
+    if (unitSize_ == 2) {
+        if (unit >= 0xD800 && unit <= 0xDBFF) {
+            if (highSurrogate_ != 0) out += kReplacementUTF8;
+            highSurrogate_ = unit;
+            return;
+        }
+        if (unit >= 0xDC00 && unit <= 0xDFFF) {
+            if (highSurrogate_ == 0) {
+                out += kReplacementUTF8;
+                return;
+            }
+            uint32_t cp = 0x10000 + ((highSurrogate_ - 0xD800) << 10) + (unit - 0xDC00);
+            highSurrogate_ = 0;
+            appendUTF8(cp, out);
+            return;
+        }
+        if (highSurrogate_ != 0) {
+            out += kReplacementUTF8;
+            highSurrogate_ = 0;
+        }
+    } else if (unit > 0x10FFFF || (unit >= 0xD800 && unit <= 0xDFFF)) {
+        out += kReplacementUTF8;
+        return;
+    }
+    appendUTF8(unit, out);
+}
+
+// Malformed UTF-8 becomes U+FFFD; a sequence cut by the chunk end is held for the next call
+// Bozuk UTF-8 U+FFFD olur; parca sonunda kesilen bir dizi sonraki cagri icin tutulur
+void Transcoder::encode(std::string_view utf8, std::string& out) {
+    if (isPassthrough(encoding_)) {
+        out.append(utf8);
+        return;
+    }
+
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(utf8.data());
+    size_t size = utf8.size();
+    size_t i = 0;
+    uint32_t cp;
+
+    // Finish a sequence cut by the previous chunk one byte at a time; a byte that breaks it
+    // is read again as the start of the next sequence
+    // Onceki parcanin kestigi diziyi bayt bayt bitir; onu bozan bir bayt sonraki dizinin
+    // baslangici olarak yeniden okunur
+    while (heldLen_ > 0 && i < size) {
+        held_[heldLen_++] = p[i++];
+        size_t n = readUTF8(held_, heldLen_, cp);
+        if (n == 0) continue;
+        if (n < heldLen_) --i;
+        heldLen_ = 0;
+        encodePoint(cp == kBad ? 0xFFFD : cp, out);
+    }
+
+    while (i < size) {
+        if (p[i] < 0x80) {
+            encodePoint(p[i++], out);
+            continue;
+        }
+        size_t n = readUTF8(p + i, size - i, cp);
+        if (n == 0) {
+            heldLen_ = size - i;
+            std::memcpy(held_, p + i, heldLen_);
+            break;
+        }
+        encodePoint(cp == kBad ? 0xFFFD : cp, out);
+        i += n;
+    }
+}
+
+// A sequence still held at the end of input is encoded as U+FFFD
+// Girdi sonunda hala tutulan bir dizi U+FFFD olarak kodlanir
+void Transcoder::finishEncode(std::string& out) {
+    if (heldLen_ > 0 && !isPassthrough(encoding_)) encodePoint(0xFFFD, out);
+    heldLen_ = 0;
+}
+
+// Write one code point in the target encoding; Latin-1 writes '?' past U+00FF
+// Tek bir kod noktasini hedef kodlamada yaz; Latin-1, U+00FF otesinde '?' yazar
+void Transcoder::encodePoint(uint32_t cp, std::string& out) {
+    auto put16 = [this, &out](uint32_t u) {
+        if (littleEndian_) {
+            out += static_cast<char>(u & 0xFF);
+            out += static_cast<char>(u >> 8);
+        } else {
+            out += static_cast<char>(u >> 8);
+            out += static_cast<char>(u & 0xFF);
+        }
+    };
+
+    switch (unitSize_) {
+        case 1:
+            out += static_cast<char>(cp <= 0xFF ? cp : '?');
+            break;
+        case 2:
+            if (cp < 0x10000) {
+                put16(cp);
+            } else {
+                cp -= 0x10000;
+                put16(0xD800 + (cp >> 10));
+                put16(0xDC00 + (cp & 0x3FF));
+            }
+            break;
+        default:
+            for (int k = 0; k < 4; ++k) {
+                int shift = littleEndian_ ? 8 * k : 8 * (3 - k);
+                out += static_cast<char>((cp >> shift) & 0xFF);
+            }
+            break;
+    }
+}
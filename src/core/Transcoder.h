@@ -0,0 +1,64 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "EncodingDetector.h"
+
+// Streaming converter between one file encoding and UTF-8.
+// Bir dosya kodlamasi ile UTF-8 arasinda akisli donusturucu.
+// Input arrives in chunks of any size: a code unit, a surrogate pair or a UTF-8 sequence cut by
+// a chunk boundary is held back and completed by the next call, so a file can be converted
+// block by block without ever holding it whole. Malformed input becomes U+FFFD (or '?' in
+// Latin-1); BOMs are left to the caller. One instance converts one stream in one direction.
+// Girdi herhangi boyutta parcalar halinde gelir: parca sinirinda kesilen bir kod birimi, vekil
+// cifti veya UTF-8 dizisi geri tutulur ve sonraki cagriyla tamamlanir, boylece bir dosya hicbir
+// zaman tamami tutulmadan blok blok donusturulebilir. Bozuk girdi U+FFFD (Latin-1'de '?') olur;
+// BOM'lar cagirana birakilir. Bir ornek tek bir akisi tek bir yonde donusturur.
+class Transcoder {
+public:
+    explicit Transcoder(TextEncoding encoding);
+
+    // True when the encoding's bytes are already UTF-8 and need no conversion
+    // Kodlamanin baytlari zaten UTF-8 ise ve donusum gerekmiyorsa true
+    static bool isPassthrough(TextEncoding encoding);
+
+    // Byte order mark written at the start of a file in this encoding (empty for none)
+    // Bu kodlamadaki bir dosyanin basina yazilan bayt sirasi isareti (yoksa bos)
+    static std::string_view byteOrderMark(TextEncoding encoding);
+
+    TextEncoding encoding() const { return encoding_; }
+
+    // Decode a chunk of encoded bytes, appending UTF-8 to out
+    // Kodlanmis baytlardan bir parcayi coz, UTF-8'i out'a ekle
+    void decode(const uint8_t* data, size_t size, std::string& out);
+
+    // End of input: whatever is still held back is incomplete and becomes U+FFFD
+    // Girdinin sonu: hala geri tutulan eksiktir ve U+FFFD olur
+    void finishDecode(std::string& out);
+
+    // Encode a chunk of UTF-8, appending the encoded bytes to out
+    // Bir UTF-8 parcasini kodla, kodlanmis baytlari out'a ekle
+    void encode(std::string_view utf8, std::string& out);
+
+    // End of input: an unfinished UTF-8 sequence becomes a replacement character
+    // Girdinin sonu: bitmemis bir UTF-8 dizisi degistirme karakteri olur
+    void finishEncode(std::string& out);
+
+private:
+    // Code points in and out / Giren ve cikan kod noktalari
+    void decodeUnit(uint32_t unit, std::string& out);
+    void encodePoint(uint32_t cp, std::string& out);
+
+    TextEncoding encoding_;
+    size_t unitSize_;          // 1, 2 or 4 bytes / 1, 2 veya 4 bayt
+    bool littleEndian_;
+    uint8_t held_[4] = {};     // Bytes of a unit or sequence cut by the chunk end / Parca sonunda kesilen birim veya dizinin baytlari
+    size_t heldLen_ = 0;
+    uint32_t highSurrogate_ = 0;  // UTF-16 high surrogate waiting for its pair / Esini bekleyen UTF-16 yuksek vekili
+};
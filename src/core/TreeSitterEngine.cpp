@@ -6,6 +6,8 @@
 #ifdef BERKIDE_TREESITTER_ENABLED
 
 #include "TreeSitterEngine.h"
+#include "BufferSnapshot.h"
+#include "LineScanner.h"
 #include "Logger.h"
 #include <tree_sitter/api.h>
 
@@ -126,7 +128,9 @@ bool TreeSitterEngine::setLanguage(const std::string& name) {
         ts_tree_delete(tree_);
         tree_ = nullptr;
     }
-    lastSource_.clear();
+    lastLineStarts_.clear();
+    lastSize_ = 0;
+    lastSnapshot_.reset();
 
     return true;
 }
@@ -152,10 +156,91 @@ bool TreeSitterEngine::parse(const std::string& source) {
 
     if (tree_) ts_tree_delete(tree_);
     tree_ = newTree;
-    lastSource_ = source;
+    rememberSource(source);
     return true;
 }
 
+// Full parse of a snapshot
+// Bir anlik goruntunun tam ayristirmasi
+bool TreeSitterEngine::parse(const BufferSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!parser_) return false;
+
+    auto snap = std::make_shared<const BufferSnapshot>(snapshot);
+    TSTree* newTree = parseSnapshot(*snap);
+    if (!newTree) {
+        LOG_ERROR("[TreeSitter] Parse failed");
+        return false;
+    }
+
+    if (tree_) ts_tree_delete(tree_);
+    tree_ = newTree;
+    rememberSource(std::move(snap));
+    return true;
+}
+
+// Serve the parser one line remainder at a time, then the '\n' that ends it
+// Ayristiriciya her seferinde bir satir kalanini, ardindan onu bitiren '\n'yi ver
+static const char* readSnapshot(void* payload, uint32_t byteIndex, TSPoint, uint32_t* bytesRead) {
+    const auto* snap = static_cast<const BufferSnapshot*>(payload);
+    if (byteIndex >= snap->byteCount()) {
+        *bytesRead = 0;
+        return "";
+    }
+    TextPosition pos = snap->positionOf(byteIndex);
+    std::string_view line = snap->lineView(pos.line);
+    if (static_cast<size_t>(pos.col) < line.size()) {
+        *bytesRead = static_cast<uint32_t>(line.size() - pos.col);
+        return line.data() + pos.col;
+    }
+    *bytesRead = 1;
+    return "\n";
+}
+
+// Parse straight from the snapshot's pieces through readSnapshot, reusing the old tree
+// Eski agaci yeniden kullanarak readSnapshot araciligiyla dogrudan snapshot parcalarindan ayristir
+TSTree* TreeSitterEngine::parseSnapshot(const BufferSnapshot& snapshot) {
+    TSInput input;
+    input.payload = const_cast<BufferSnapshot*>(&snapshot);
+    input.read = readSnapshot;
+    input.encoding = TSInputEncodingUTF8;
+    return ts_parser_parse(parser_, tree_, input);
+}
+
+// Line starts of a string source, found with the vectorized newline scanner
+// Bir dize kaynaginin satir baslangiclari, vektorlestirilmis yeni satir tarayicisiyla bulunur
+void TreeSitterEngine::rememberSource(const std::string& source) {
+    lastLineStarts_.assign(1, 0);
+    size_t pos = 0;
+    while (pos < source.size()) {
+        size_t nl = pos + LineScanner::findNewline(source.data() + pos, source.size() - pos);
+        if (nl >= source.size()) break;
+        pos = nl + 1;
+        lastLineStarts_.push_back(static_cast<uint32_t>(pos));
+    }
+    lastSize_ = static_cast<uint32_t>(source.size());
+    lastSnapshot_.reset();
+}
+
+// Keep the snapshot itself; its offset index answers lastOffset without a line table
+// Snapshot'in kendisini tut; ofset indeksi lastOffset'i satir tablosu olmadan yanitlar
+void TreeSitterEngine::rememberSource(std::shared_ptr<const BufferSnapshot> snapshot) {
+    lastLineStarts_.clear();
+    lastSize_ = 0;
+    lastSnapshot_ = std::move(snapshot);
+}
+
+// Look the position up in whichever index the last source left behind
+// Konumu son kaynagin biraktigi indekste ara
+uint32_t TreeSitterEngine::lastOffset(int line, int col) const {
+    if (lastSnapshot_) return static_cast<uint32_t>(lastSnapshot_->offsetOf(line, col));
+    if (line >= 0 && static_cast<size_t>(line) < lastLineStarts_.size()) {
+        return lastLineStarts_[line] + static_cast<uint32_t>(col);
+    }
+    return lastSize_ + static_cast<uint32_t>(col);
+}
+
 // Edit and reparse incrementally
 // Duzenleme ve artimsal yeniden ayristirma
 bool TreeSitterEngine::editAndReparse(
@@ -168,26 +253,12 @@ bool TreeSitterEngine::editAndReparse(
 
     if (!parser_ || !tree_) return false;
 
-    // Calculate byte offsets from the old source
-    // Eski kaynaktan bayt ofsetlerini hesapla
-    auto calcOffset = [](const std::string& src, int line, int col) -> uint32_t {
-        uint32_t offset = 0;
-        int curLine = 0;
-        for (size_t i = 0; i < src.size(); ++i) {
-            if (curLine == line) {
-                return offset + static_cast<uint32_t>(col);
-            }
-            if (src[i] == '\n') {
-                ++curLine;
-            }
-            ++offset;
-        }
-        return offset + static_cast<uint32_t>(col);
-    };
-
-    uint32_t startByte = calcOffset(lastSource_, startLine, startCol);
-    uint32_t oldEndByte = calcOffset(lastSource_, oldEndLine, oldEndCol);
-    uint32_t newEndByte = calcOffset(newSource, newEndLine, newEndCol);
+    // Old offsets from the index of the last source, new ones from the new source's index
+    // Eski ofsetler son kaynagin indeksinden, yenileri yeni kaynagin indeksinden
+    uint32_t startByte = lastOffset(startLine, startCol);
+    uint32_t oldEndByte = lastOffset(oldEndLine, oldEndCol);
+    rememberSource(newSource);
+    uint32_t newEndByte = lastOffset(newEndLine, newEndCol);
 
     TSInputEdit edit;
     edit.start_byte = startByte;
@@ -213,7 +284,42 @@ bool TreeSitterEngine::editAndReparse(
 
     ts_tree_delete(tree_);
     tree_ = newTree;
-    lastSource_ = newSource;
+    return true;
+}
+
+// Edit and reparse from a snapshot
+// Anlik goruntuden duzenleme ve yeniden ayristirma
+bool TreeSitterEngine::editAndReparse(
+    int startLine, int startCol,
+    int oldEndLine, int oldEndCol,
+    int newEndLine, int newEndCol,
+    const BufferSnapshot& snapshot) {
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!parser_ || !tree_) return false;
+
+    auto snap = std::make_shared<const BufferSnapshot>(snapshot);
+
+    TSInputEdit edit;
+    edit.start_byte = lastOffset(startLine, startCol);
+    edit.old_end_byte = lastOffset(oldEndLine, oldEndCol);
+    edit.new_end_byte = static_cast<uint32_t>(snap->offsetOf(newEndLine, newEndCol));
+    edit.start_point = {static_cast<uint32_t>(startLine), static_cast<uint32_t>(startCol)};
+    edit.old_end_point = {static_cast<uint32_t>(oldEndLine), static_cast<uint32_t>(oldEndCol)};
+    edit.new_end_point = {static_cast<uint32_t>(newEndLine), static_cast<uint32_t>(newEndCol)};
+
+    ts_tree_edit(tree_, &edit);
+
+    TSTree* newTree = parseSnapshot(*snap);
+    if (!newTree) {
+        LOG_ERROR("[TreeSitter] Reparse failed");
+        return false;
+    }
+
+    ts_tree_delete(tree_);
+    tree_ = newTree;
+    rememberSource(std::move(snap));
     return true;
 }
 
@@ -417,7 +523,9 @@ void TreeSitterEngine::reset() {
         ts_tree_delete(tree_);
         tree_ = nullptr;
     }
-    lastSource_.clear();
+    lastLineStarts_.clear();
+    lastSize_ = 0;
+    lastSnapshot_.reset();
 }
 
 #endif // BERKIDE_TREESITTER_ENABLED
@@ -7,6 +7,7 @@
 
 #ifdef BERKIDE_TREESITTER_ENABLED
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -23,6 +24,8 @@ extern "C" {
     typedef struct TSLanguage TSLanguage;
 }
 
+class BufferSnapshot;
+
 // A single node in the syntax tree
 // Soz dizimi agacindaki tek bir dugum
 struct SyntaxNode {
@@ -94,6 +97,10 @@ public:
     // Kaynak kodu ayristir (tam ayristirma veya duzenleme sonrasi yeniden ayristirma)
     bool parse(const std::string& source);
 
+    // Parse a buffer snapshot, reading lines straight from its storage (no joined copy)
+    // Bir buffer anlik goruntusunu ayristir, satirlari dogrudan deposundan okuyarak (birlesik kopya yok)
+    bool parse(const BufferSnapshot& snapshot);
+
     // Apply an edit and reparse (incremental)
     // Bir duzenleme uygula ve yeniden ayristir (artimsal)
     bool editAndReparse(
@@ -102,6 +109,16 @@ public:
         int newEndLine, int newEndCol,
         const std::string& newSource);
 
+    // Apply an edit and reparse from a snapshot of the edited buffer; byte offsets come from
+    // the snapshots' offset indexes instead of scanning the text
+    // Bir duzenleme uygula ve duzenlenmis buffer'in anlik goruntusunden yeniden ayristir; bayt
+    // ofsetleri metni taramak yerine anlik goruntulerin ofset indekslerinden gelir
+    bool editAndReparse(
+        int startLine, int startCol,
+        int oldEndLine, int oldEndCol,
+        int newEndLine, int newEndCol,
+        const BufferSnapshot& snapshot);
+
     // Check if a tree exists (has been parsed)
     // Agacin var olup olmadigini kontrol et (ayristirilmis mi)
     bool hasTree() const;
@@ -136,7 +153,24 @@ private:
     TSParser* parser_ = nullptr;
     TSTree* tree_ = nullptr;
     std::string currentLang_;
-    std::string lastSource_;  // Keep last source for incremental edit / Artimsal duzenleme icin son kaynagi tut
+    // Last parsed source, kept to map edit positions to byte offsets
+    // Son ayristirilan kaynak, duzenleme konumlarini bayt ofsetlerine eslemek icin tutulur
+    std::vector<uint32_t> lastLineStarts_;                // Line starts of the last string source / Son dize kaynagin satir baslangiclari
+    uint32_t lastSize_ = 0;                               // Its length / Uzunlugu
+    std::shared_ptr<const BufferSnapshot> lastSnapshot_;  // Or the last snapshot parsed / Veya son ayristirilan anlik goruntu
+
+    // Byte offset of (line, col) in the last parsed source
+    // Son ayristirilan kaynakta (line, col)'un bayt ofseti
+    uint32_t lastOffset(int line, int col) const;
+
+    // Remember a string source (or a snapshot) as the last parsed one
+    // Bir dize kaynagini (veya anlik goruntuyu) son ayristirilan olarak hatirla
+    void rememberSource(const std::string& source);
+    void rememberSource(std::shared_ptr<const BufferSnapshot> snapshot);
+
+    // Parse from a snapshot through a TSInput reader
+    // Bir TSInput okuyucu uzerinden anlik goruntuden ayristir
+    TSTree* parseSnapshot(const BufferSnapshot& snapshot);
 
     // Language registry: name -> (TSLanguage*, dlhandle)
     // Dil kayit defteri: ad -> (TSLanguage*, dlhandle)
@@ -0,0 +1,1063 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "TrigramIndex.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "WorkspaceSearch.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+std::atomic<int> TrigramIndex::watchIntervalMs_{2000};
+
+// Clamped to at least 100 ms
+// En az 100 ms'ye sabitlenir
+void TrigramIndex::setWatchInterval(std::chrono::milliseconds ms) {
+    watchIntervalMs_ = static_cast<int>(std::max<int64_t>(100, ms.count()));
+}
+
+namespace {
+
+// On-disk layout: DiskHeader, DiskFile[fileCount], DiskTrigram[trigramCount] (sorted by
+// trigram), posting lists, then the root and the paths. Offsets are from the file start
+// (postings and paths: from their section), fixed-size records sit at 8-byte offsets.
+// Diskteki yerlesim: DiskHeader, DiskFile[fileCount], DiskTrigram[trigramCount] (trigrama gore
+// sirali), kayit listeleri, sonra kok ve yollar. Ofsetler dosya basindandir (kayitlar ve yollar:
+// kendi bolumlerinden), sabit boyutlu kayitlar 8 baytlik ofsetlerde durur.
+constexpr char kMagic[8] = {'B', 'K', 'T', 'R', 'I', 'G', 'R', 'M'};
+
+struct DiskHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t fileCount;
+    uint32_t trigramCount;
+    uint32_t rootBytes;
+    uint32_t complete;           // 0 while the first build is unfinished / Ilk kurulum bitmemisken 0
+    uint32_t generation;         // Random, never 0; deltas name it / Rastgele, asla 0; deltalar onu adlandirir
+    uint64_t filesOffset;
+    uint64_t tableOffset;
+    uint64_t postingsOffset;
+    uint64_t postingsBytes;
+    uint64_t stringsOffset;
+    uint64_t totalBytes;
+};
+
+struct DiskFile {
+    uint64_t pathOffset;         // From stringsOffset / stringsOffset'ten
+    uint32_t pathBytes;
+    uint32_t reserved;
+    uint64_t size;
+    int64_t mtime;
+};
+
+struct DiskTrigram {
+    uint32_t trigram;
+    uint32_t count;              // File ids in the list / Listedeki dosya kimlikleri
+    uint64_t offset;             // From postingsOffset / postingsOffset'ten
+};
+
+// Delta file beside the index: DeltaHeader, the dead base ids (uint32_t each), the overlay
+// files (DeltaFile then path bytes each), then per trigram its value, id count and
+// delta-varint ids. Only a delta whose generation and baseFiles match the base is applied.
+// Indeksin yanindaki delta dosyasi: DeltaHeader, olu taban kimlikleri (her biri uint32_t),
+// katman dosyalari (her biri DeltaFile sonra yol baytlari), sonra trigram basina degeri, kimlik
+// sayisi ve delta-varint kimlikler. Yalnizca generation ve baseFiles'i tabana uyan delta uygulanir.
+constexpr char kDeltaMagic[8] = {'B', 'K', 'T', 'R', 'I', 'D', 'L', 'T'};
+
+struct DeltaHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t generation;
+    uint32_t baseFiles;
+    uint32_t deadCount;
+    uint32_t fileCount;
+    uint32_t trigramCount;
+    uint64_t totalBytes;
+};
+
+struct DeltaFile {
+    uint32_t pathBytes;
+    uint32_t live;
+    uint64_t size;
+    int64_t mtime;
+};
+
+// Append a fixed-size record as its host bytes, like the index file itself
+// Sabit boyutlu bir kaydi, indeks dosyasinin kendisi gibi host baytlariyla ekle
+template <typename T>
+void putPod(std::string& out, const T& v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+// Write data to path through a temporary file renamed over it
+// Veriyi, uzerine yeniden adlandirilan gecici bir dosya ile path'e yaz
+bool writeReplacing(const std::string& path, const std::string& data) {
+    std::error_code ec;
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!out.flush()) {
+            LOG_ERROR("[TrigramIndex] Cannot write ", tmp);
+            out.close();
+            fs::remove(tmp, ec);
+            return false;
+        }
+    }
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        LOG_ERROR("[TrigramIndex] Cannot replace ", path, ": ", ec.message());
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+// Append v in 7-bit groups, low group first, high bit set on all but the last
+// v'yi 7 bitlik gruplarla ekle, dusuk grup once, sonuncusu haric yuksek bit ayarli
+void putVarint(std::string& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+// Decode count delta-encoded ids of one list, stopping at end; returns where the list ends
+// Bir listenin delta kodlu count kimligini coz, end'de dur; listenin bittigi yeri dondurur
+template <typename Fn>
+const uint8_t* forEachPosting(const uint8_t* p, const uint8_t* end, uint32_t count, Fn&& fn) {
+    uint32_t id = 0;
+    for (uint32_t i = 0; i < count && p < end; ++i) {
+        uint32_t delta = 0;
+        for (int shift = 0; p < end && shift < 35; shift += 7) {
+            const uint8_t b = *p++;
+            delta |= static_cast<uint32_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+        }
+        id += delta;
+        fn(id);
+    }
+    return p;
+}
+
+// Trigrams are ASCII-lowercased, so case-blind queries share their postings
+// Trigramlar ASCII kucuk harflidir, boylece harf duyarsiz sorgular ayni kayitlari paylasir
+inline uint8_t foldByte(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c | 0x20) : c;
+}
+
+// Modification time as file_time_type ticks, 0 if it cannot be read
+// file_time_type tikleri olarak degistirme zamani, okunamazsa 0
+int64_t mtimeOf(const std::string& path) {
+    std::error_code ec;
+    auto t = fs::last_write_time(path, ec);
+    return ec ? 0 : static_cast<int64_t>(t.time_since_epoch().count());
+}
+
+// Index of the ']' closing a class that opens at i, or npos
+// i'de acilan bir sinifi kapatan ']' indeksi veya npos
+size_t classEnd(const std::string& s, size_t i) {
+    size_t j = i + 1;
+    if (j < s.size() && s[j] == '^') ++j;
+    if (j < s.size() && s[j] == ']') ++j;
+    for (; j < s.size(); ++j) {
+        if (s[j] == '\\') ++j;
+        else if (s[j] == ']') return j;
+    }
+    return std::string::npos;
+}
+
+// Index of the ')' closing a group that opens at i, or npos
+// i'de acilan bir grubu kapatan ')' indeksi veya npos
+size_t groupEnd(const std::string& s, size_t i) {
+    int depth = 0;
+    for (size_t j = i; j < s.size(); ++j) {
+        if (s[j] == '\\') {
+            ++j;
+        } else if (s[j] == '[') {
+            j = classEnd(s, j);
+            if (j == std::string::npos) return j;
+        } else if (s[j] == '(') {
+            ++depth;
+        } else if (s[j] == ')' && --depth == 0) {
+            return j;
+        }
+    }
+    return std::string::npos;
+}
+
+// Split a regex at its top-level '|'
+// Bir regex'i ust duzey '|' isaretlerinden bol
+std::vector<std::string> topLevelBranches(const std::string& s) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    for (size_t j = 0; j < s.size(); ++j) {
+        if (s[j] == '\\') {
+            ++j;
+        } else if (s[j] == '[' || s[j] == '(') {
+            size_t e = s[j] == '[' ? classEnd(s, j) : groupEnd(s, j);
+            if (e == std::string::npos) break;
+            j = e;
+        } else if (s[j] == '|') {
+            out.push_back(s.substr(start, j - start));
+            start = j + 1;
+        }
+    }
+    out.push_back(s.substr(start));
+    return out;
+}
+
+// Literal runs every match of one regex branch contains. Anything that is not a plain
+// character ends the current run; groups and classes are skipped whole; a '*', '?' or '{'
+// quantifier takes back the character before it; an escape that is not punctuation (\d, \x41,
+// \1...) ends the scan, keeping the runs found so far.
+// Bir regex dalinin her eslemesinin icerdigi literal diziler. Duz karakter olmayan her sey
+// mevcut diziyi bitirir; gruplar ve siniflar tumden atlanir; '*', '?' veya '{' niceleyicisi
+// kendinden onceki karakteri geri alir; noktalama olmayan bir kacis (\d, \x41, \1...) taramayi
+// bitirir, o ana kadar bulunan diziler kalir.
+std::vector<std::string> requiredRuns(const std::string& b, bool foldsUnicode) {
+    std::vector<std::string> runs;
+    std::string cur;
+    auto flush = [&]() {
+        if (cur.size() >= 3) runs.push_back(cur);
+        cur.clear();
+    };
+    size_t i = 0;
+    while (i < b.size()) {
+        const char c = b[i];
+        if (c == '\\') {
+            if (i + 1 >= b.size() || std::isalnum(static_cast<unsigned char>(b[i + 1]))) break;
+            cur += b[i + 1];
+            i += 2;
+        } else if (c == '(' || c == '[') {
+            flush();
+            size_t e = c == '(' ? groupEnd(b, i) : classEnd(b, i);
+            if (e == std::string::npos) break;
+            i = e + 1;
+            continue;
+        } else if (c == '*' || c == '?' || c == '{') {
+            // The whole UTF-8 character before it / Ondan onceki UTF-8 karakterin tamami
+            while (!cur.empty() && (static_cast<unsigned char>(cur.back()) & 0xC0) == 0x80) cur.pop_back();
+            if (!cur.empty()) cur.pop_back();
+            flush();
+            if (c == '{') {
+                size_t e = b.find('}', i);
+                if (e == std::string::npos) break;
+                i = e + 1;
+            } else {
+                ++i;
+            }
+            continue;
+        } else if (c == '+') {
+            flush();
+            ++i;
+            continue;
+        } else if (c == '.' || c == '^' || c == '$' || c == '\n' || c == '\r' ||
+                   (foldsUnicode && static_cast<unsigned char>(c) >= 0x80)) {
+            flush();
+            ++i;
+            continue;
+        } else {
+            cur += c;
+            ++i;
+        }
+    }
+    flush();
+    return runs;
+}
+
+// Append the folded trigrams of one run (none if it is shorter than three bytes)
+// Bir dizinin katlanmis trigramlarini ekle (uc bayttan kisaysa hic)
+void addTrigrams(std::string_view run, std::vector<uint32_t>& out) {
+    for (size_t i = 0; i + 3 <= run.size(); ++i) {
+        out.push_back((static_cast<uint32_t>(foldByte(run[i])) << 16) |
+                      (static_cast<uint32_t>(foldByte(run[i + 1])) << 8) |
+                      foldByte(run[i + 2]));
+    }
+}
+
+// Ids in both ascending lists
+// Her iki artan listedeki kimlikler
+std::vector<uint32_t> intersect(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    std::vector<uint32_t> out;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    return out;
+}
+
+} // namespace
+
+// Stop the worker and watcher, saving what is pending
+// Calisani ve izleyiciyi durdur, bekleyenleri kaydet
+TrigramIndex::~TrigramIndex() {
+    stop();
+}
+
+// The saved index is loaded on the calling thread so it serves queries as soon as start()
+// returns; reconciling and then watching run on worker_, the watcher starting from the
+// reconcile walk instead of walking the tree again
+// Kayitli indeks cagiran thread'de yuklenir, boylece start() doner donmez sorgulara hizmet
+// eder; uzlastirma ve ardindan izleme worker_ uzerinde calisir, izleyici agaci yeniden gezmek
+// yerine uzlastirma gezintisinden baslar
+void TrigramIndex::start(const std::string& root, const std::string& indexDir) {
+    stop();
+    std::error_code ec;
+    fs::path canonical = fs::weakly_canonical(fs::path(root), ec);
+    if (ec || !fs::is_directory(canonical, ec)) {
+        LOG_WARN("[TrigramIndex] Not a directory: ", root);
+        return;
+    }
+    root_ = canonical.string();
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(root_) << ".tri";
+    indexPath_ = (fs::path(indexDir) / name.str()).string();
+    stopping_ = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (load()) {
+            loadDelta();
+            LOG_INFO("[TrigramIndex] Loaded ", ids_.size(), " files for ", root_);
+        }
+    }
+
+    worker_ = std::thread([this]() {
+        FileWatcher::Snapshot baseline = reconcile();
+        if (stopping_) return;
+        watcher_ = std::make_unique<FileWatcher>();
+        watcher_->setInterval(std::chrono::milliseconds(watchIntervalMs_.load()));
+        watcher_->setIgnoreDirs(WorkspaceSearch::defaultIgnoreDirs());
+        watcher_->onEvent([this](const FileEventData& e) {
+            if (e.type == FileEvent::Deleted) removePath(e.path);
+            else if (!e.isDirectory) updateFile(e.path);
+        });
+        watcher_->watch(root_, std::move(baseline));
+    });
+}
+
+// The watcher is stopped before the final save so no event lands after it
+// Izleyici son kayittan once durdurulur, boylece ondan sonra olay gelmez
+void TrigramIndex::stop() {
+    stopping_ = true;
+    if (worker_.joinable()) worker_.join();
+    if (watcher_) {
+        watcher_->stop();
+        watcher_.reset();
+    }
+    flush(true);
+    ready_ = false;
+}
+
+// Full rewrite on request, waiting for any save in progress
+// Istek uzerine tam yeniden yazim, suren kaydi bekler
+bool TrigramIndex::save() {
+    std::lock_guard<std::mutex> saving(saveMutex_);
+    return mergeBase();
+}
+
+// A merge is due when the overlay holds too many postings or, once the tree is indexed, too
+// many files next to the base; an unfinished build or a missing base can only be merged.
+// Otherwise a delta is due every kCompactFiles overlay files (or on force).
+// Katman cok fazla kayit veya agac indekslendikten sonra tabanin yaninda cok fazla dosya
+// tuttugunda birlestirme gerekir; bitmemis bir kurulum veya eksik bir taban yalnizca
+// birlestirilebilir. Aksi halde her kCompactFiles katman dosyasinda (veya force ile) delta gerekir.
+void TrigramIndex::flush(bool force) {
+    std::unique_lock<std::mutex> saving(saveMutex_, std::defer_lock);
+    if (force) saving.lock();
+    else if (!saving.try_lock()) return;
+
+    bool merge = false, delta = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (indexPath_.empty()) return;
+        const int overlay = overlayFiles();
+        merge = extraPostings_ >= kCompactPostings ||
+                (ready_ && overlay >= std::max<int>(kCompactFiles, static_cast<int>(baseFiles_) / kMergeRatio)) ||
+                (force && dirty_ && (!base_ || !baseComplete_ || !ready_));
+        delta = !merge && dirty_ && ready_ && (force || overlay >= savedOverlay_ + kCompactFiles);
+    }
+    if (merge) mergeBase();
+    else if (delta) writeDelta();
+}
+
+// Files next to the index itself are never indexed
+// Indeksin kendisinin yanindaki dosyalar asla indekslenmez
+std::string TrigramIndex::relative(const std::string& path) const {
+    const fs::path p(path);
+    if (p.parent_path() == fs::path(indexPath_).parent_path()) return {};
+    fs::path rel = p.lexically_relative(root_);
+    if (rel.empty() || *rel.begin() == "..") return {};
+    return rel.generic_string();
+}
+
+// Every field is bounds-checked against the mapping, so a truncated or foreign file is
+// rejected instead of read past its end
+// Her alan eslemeye karsi sinir denetiminden gecer, boylece kesik veya yabanci bir dosya
+// sonunun otesinde okunmak yerine reddedilir
+bool TrigramIndex::load() {
+    base_.reset();
+    files_.clear();
+    ids_.clear();
+    extra_.clear();
+    table_ = postings_ = nullptr;
+    tableCount_ = baseFiles_ = 0;
+    postingsBytes_ = 0;
+    dead_ = 0;
+    extraPostings_ = 0;
+    dirty_ = false;
+    savedOverlay_ = 0;
+    generation_ = 0;
+    baseComplete_ = false;
+
+    std::error_code ec;
+    if (!fs::is_regular_file(indexPath_, ec)) return false;
+    base_ = std::make_shared<MappedFile>();
+    if (!base_->open(indexPath_, false)) {
+        base_.reset();
+        return false;
+    }
+    std::string_view data = base_->contents();
+    auto reject = [&](const char* why) {
+        LOG_WARN("[TrigramIndex] Ignoring ", indexPath_, ": ", why);
+        files_.clear();
+        ids_.clear();
+        base_.reset();
+        return false;
+    };
+    DiskHeader h;
+    if (data.size() < sizeof(h)) return reject("truncated");
+    std::memcpy(&h, data.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kFormatVersion) return reject("format");
+    if (h.totalBytes != data.size() ||
+        h.filesOffset + uint64_t(h.fileCount) * sizeof(DiskFile) > h.tableOffset ||
+        h.tableOffset + uint64_t(h.trigramCount) * sizeof(DiskTrigram) > h.postingsOffset ||
+        h.postingsOffset + h.postingsBytes > h.stringsOffset ||
+        h.stringsOffset + h.rootBytes > data.size()) {
+        return reject("truncated");
+    }
+    const char* strings = data.data() + h.stringsOffset;
+    const uint64_t stringsBytes = data.size() - h.stringsOffset;
+    if (std::string_view(strings, h.rootBytes) != root_) return reject("other root");
+
+    files_.resize(h.fileCount);
+    for (uint32_t id = 0; id < h.fileCount; ++id) {
+        DiskFile f;
+        std::memcpy(&f, data.data() + h.filesOffset + uint64_t(id) * sizeof(DiskFile), sizeof(f));
+        if (f.pathOffset + f.pathBytes > stringsBytes) return reject("truncated");
+        files_[id] = {std::string(strings + f.pathOffset, f.pathBytes), f.size, f.mtime, true};
+        ids_[files_[id].path] = id;
+    }
+    table_ = reinterpret_cast<const uint8_t*>(data.data() + h.tableOffset);
+    tableCount_ = h.trigramCount;
+    postings_ = reinterpret_cast<const uint8_t*>(data.data() + h.postingsOffset);
+    postingsBytes_ = static_cast<size_t>(h.postingsBytes);
+    baseFiles_ = h.fileCount;
+    generation_ = h.generation;
+    baseComplete_ = h.complete != 0;
+    // An unfinished build is resumed by reconcile() and saved again once it completes
+    // Bitmemis bir kurulum reconcile() ile surdurulur ve tamamlaninca yeniden kaydedilir
+    ready_ = h.complete != 0;
+    dirty_ = h.complete == 0;
+    return true;
+}
+
+// The file is parsed whole before anything is applied, so a bad delta leaves the base as it
+// was; what it missed is picked up by reconcile()
+// Hicbir sey uygulanmadan once dosya tumden ayristirilir, boylece bozuk bir delta tabani
+// oldugu gibi birakir; kacirdiklari reconcile() ile toplanir
+bool TrigramIndex::loadDelta() {
+    const std::string path = indexPath_ + ".delta";
+    std::error_code ec;
+    if (!base_ || !baseComplete_ || !fs::is_regular_file(path, ec)) return false;
+    std::ifstream in(path, std::ios::binary);
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t pos = 0;
+    auto take = [&](void* out, size_t n) {
+        if (data.size() - pos < n) return false;
+        std::memcpy(out, data.data() + pos, n);
+        pos += n;
+        return true;
+    };
+    auto reject = [&](const char* why) {
+        LOG_WARN("[TrigramIndex] Ignoring ", path, ": ", why);
+        return false;
+    };
+
+    DeltaHeader h;
+    if (!take(&h, sizeof(h))) return reject("truncated");
+    if (std::memcmp(h.magic, kDeltaMagic, sizeof(kDeltaMagic)) != 0 || h.version != kFormatVersion) return reject("format");
+    if (h.generation != generation_ || h.baseFiles != baseFiles_) return reject("other base");
+    if (h.totalBytes != data.size()) return reject("truncated");
+
+    std::vector<uint32_t> dead(h.deadCount);
+    for (uint32_t& id : dead) {
+        if (!take(&id, sizeof(id)) || id >= baseFiles_) return reject("truncated");
+    }
+    std::vector<FileRecord> added(h.fileCount);
+    for (FileRecord& f : added) {
+        DeltaFile d;
+        if (!take(&d, sizeof(d)) || data.size() - pos < d.pathBytes) return reject("truncated");
+        f = {data.substr(pos, d.pathBytes), d.size, d.mtime, d.live != 0};
+        pos += d.pathBytes;
+    }
+    const uint64_t idEnd = uint64_t(baseFiles_) + h.fileCount;
+    Overlay overlay;
+    size_t entries = 0;
+    for (uint32_t i = 0; i < h.trigramCount; ++i) {
+        uint32_t t = 0, count = 0;
+        if (!take(&t, sizeof(t)) || !take(&count, sizeof(count))) return reject("truncated");
+        std::vector<uint32_t>& ids = overlay[t];
+        const uint8_t* begin = reinterpret_cast<const uint8_t*>(data.data());
+        pos = forEachPosting(begin + pos, begin + data.size(), count,
+                             [&](uint32_t id) { ids.push_back(id); }) - begin;
+        if (ids.size() != count) return reject("truncated");
+        for (uint32_t id : ids) {
+            if (id < baseFiles_ || id >= idEnd) return reject("truncated");
+        }
+        entries += count;
+    }
+
+    for (uint32_t id : dead) {
+        if (!files_[id].live) continue;
+        files_[id].live = false;
+        ids_.erase(files_[id].path);
+        ++dead_;
+    }
+    for (FileRecord& f : added) {
+        const uint32_t id = static_cast<uint32_t>(files_.size());
+        if (f.live) ids_[f.path] = id;
+        else ++dead_;
+        files_.push_back(std::move(f));
+    }
+    extra_ = std::move(overlay);
+    extraPostings_ = entries;
+    savedOverlay_ = overlayFiles();
+    return true;
+}
+
+// Files whose size and mtime match the index are not read; files the walk does not reach are
+// dropped. Trigrams are collected on the walk's worker threads, each with its own buffer and
+// seen-bitmap (2^24 bits, one per possible trigram). Every file seen and its directories up
+// to the root go into the returned baseline with the size and mtime the index recorded.
+// Boyutu ve mtime'i indeksle uyan dosyalar okunmaz; gezintinin ulasmadigi dosyalar birakilir.
+// Trigramlar gezintinin calisan thread'lerinde, her biri kendi tamponu ve gorulen bit
+// haritasiyla (2^24 bit, olasi her trigram icin bir) toplanir. Gorulen her dosya ve koke kadar
+// dizinleri, indeksin kaydettigi boyut ve mtime ile dondurulen temele girer.
+FileWatcher::Snapshot TrigramIndex::reconcile() {
+    const auto started = std::chrono::steady_clock::now();
+    const int slots = ThreadPool::shared().size() + 1;
+    std::vector<std::string> buffers(slots);
+    std::vector<std::vector<uint64_t>> seen(slots);
+    std::mutex visitedMutex;
+    std::unordered_set<std::string> visited;
+    FileWatcher::Snapshot baseline;
+    std::atomic<int> read{0};
+
+    WorkspaceSearch::walk(root_, WorkspaceSearch::defaultIgnoreDirs(), [&](const WorkspaceFile& file, int slot) {
+        const std::string rel = relative(file.path);
+        const int64_t mtime = mtimeOf(file.path);
+        {
+            std::lock_guard<std::mutex> lock(visitedMutex);
+            baseline[file.path] = {fs::file_time_type(fs::file_time_type::duration(mtime)), file.size, false};
+            for (fs::path dir = fs::path(file.path).parent_path();; dir = dir.parent_path()) {
+                std::string d = dir.string();
+                if (d.size() <= root_.size() || !baseline.emplace(std::move(d), FileWatcher::Entry{{}, 0, true}).second) break;
+            }
+            if (rel.empty()) return;
+            visited.insert(rel);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = ids_.find(rel);
+            if (it != ids_.end() && files_[it->second].size == file.size && files_[it->second].mtime == mtime) return;
+        }
+        if (seen[slot].empty()) seen[slot].assign(size_t(1) << 18, 0);
+        std::vector<uint32_t> trigrams;
+        fileTrigrams(file.path, file.size, buffers[slot], seen[slot], trigrams);
+        ++read;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            setFile(rel, file.size, mtime, &trigrams);
+        }
+        flush(false);
+    }, [this]() { return stopping_.load(); });
+    if (stopping_) return baseline;
+
+    size_t files = 0, dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> gone;
+        for (const auto& [rel, id] : ids_) {
+            if (!visited.count(rel)) gone.push_back(rel);
+        }
+        for (const auto& rel : gone) setFile(rel, 0, 0, nullptr);
+        ready_ = true;
+        files = ids_.size();
+        dropped = gone.size();
+    }
+    flush(true);
+    LOG_INFO("[TrigramIndex] ", files, " files indexed (", read.load(), " read, ", dropped,
+             " dropped) in ", std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - started).count(), " ms");
+    return baseline;
+}
+
+// The old id, if any, dies in place; a new id is appended so overlay lists stay ascending
+// Varsa eski kimlik yerinde olur; katman listeleri artan kalsin diye yeni kimlik sona eklenir
+void TrigramIndex::setFile(const std::string& rel, uint64_t size, int64_t mtime, const std::vector<uint32_t>* trigrams) {
+    auto it = ids_.find(rel);
+    if (it != ids_.end()) {
+        files_[it->second].live = false;
+        ++dead_;
+        ids_.erase(it);
+    }
+    dirty_ = true;
+    ++changes_;
+    if (!trigrams) return;
+    const uint32_t id = static_cast<uint32_t>(files_.size());
+    files_.push_back({rel, size, mtime, true});
+    ids_[rel] = id;
+    for (uint32_t t : *trigrams) extra_[t].push_back(id);
+    extraPostings_ += trigrams->size();
+}
+
+// Files whose size and mtime match the index are not read again
+// Boyutu ve mtime'i indeksle uyan dosyalar yeniden okunmaz
+void TrigramIndex::updateFile(const std::string& path) {
+    const std::string rel = relative(path);
+    std::error_code ec;
+    if (rel.empty() || !fs::is_regular_file(path, ec)) return;
+    const uint64_t size = fs::file_size(path, ec);
+    if (ec) return;
+    const int64_t mtime = mtimeOf(path);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(rel);
+        if (it != ids_.end() && files_[it->second].size == size && files_[it->second].mtime == mtime) return;
+    }
+    std::vector<uint32_t> trigrams;
+    {
+        std::lock_guard<std::mutex> scratch(scratchMutex_);
+        if (scratchSeen_.empty()) scratchSeen_.assign(size_t(1) << 18, 0);
+        fileTrigrams(path, size, scratchBuffer_, scratchSeen_, trigrams);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        setFile(rel, size, mtime, &trigrams);
+    }
+    flush(false);
+}
+
+// A path that is not an indexed file is taken as a directory and drops everything under it
+// Indekslenmis bir dosya olmayan bir yol dizin olarak alinir ve altindaki her seyi birakir
+void TrigramIndex::removePath(const std::string& path) {
+    const std::string rel = relative(path);
+    if (rel.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ids_.count(rel)) {
+            setFile(rel, 0, 0, nullptr);
+        } else {
+            const std::string prefix = rel + "/";
+            std::vector<std::string> gone;
+            for (const auto& [p, id] : ids_) {
+                if (p.compare(0, prefix.size(), prefix) == 0) gone.push_back(p);
+            }
+            for (const auto& p : gone) setFile(p, 0, 0, nullptr);
+        }
+    }
+    flush(false);
+}
+
+// Trigrams never cross a line break. The bitmap is cleared through out afterwards, so it is
+// all zero again for the next file.
+// Trigramlar hicbir zaman satir sonunu gecmez. Bit haritasi sonra out uzerinden temizlenir,
+// boylece bir sonraki dosya icin yine tamamen sifirdir.
+bool TrigramIndex::fileTrigrams(const std::string& path, uint64_t size, std::string& buffer,
+                                std::vector<uint64_t>& seen, std::vector<uint32_t>& out) {
+    out.clear();
+    const uint64_t maxSize = WorkspaceSearch::defaultMaxFileSize();
+    if (maxSize > 0 && size > maxSize) return false;
+    std::string_view text;
+    if (!WorkspaceSearch::readText(path, size, buffer, text) || WorkspaceSearch::isBinary(text)) return false;
+
+    uint32_t t = 0;
+    int run = 0;
+    for (unsigned char c : text) {
+        if (c == '\n' || c == '\r') {
+            run = 0;
+            continue;
+        }
+        t = ((t << 8) | foldByte(c)) & 0xFFFFFF;
+        if (++run < 3) continue;
+        uint64_t& word = seen[t >> 6];
+        const uint64_t bit = uint64_t(1) << (t & 63);
+        if (word & bit) continue;
+        word |= bit;
+        out.push_back(t);
+    }
+    for (uint32_t x : out) seen[x >> 6] = 0;
+    return true;
+}
+
+// A literal needs all of its trigrams. A regex is split at top-level '|' and each branch needs
+// the trigrams of its required runs; case folding beyond ASCII may match other bytes, so
+// non-ASCII characters end runs when the search ignores case.
+// Bir literal tum trigramlarina ihtiyac duyar. Bir regex ust duzey '|' isaretlerinden bolunur
+// ve her dal gerekli dizilerinin trigramlarina ihtiyac duyar; ASCII otesi buyuk/kucuk harf
+// katlamasi baska baytlarla eslesebilir, bu yuzden arama harf farkini yok saydiginda ASCII
+// olmayan karakterler dizileri bitirir.
+bool TrigramIndex::queryTrigrams(const std::string& pattern, const SearchOptions& opts,
+                                 std::vector<std::vector<uint32_t>>& groups) {
+    groups.clear();
+    if (!opts.regex) {
+        std::vector<uint32_t> g;
+        size_t start = 0;
+        while (start <= pattern.size()) {
+            size_t end = pattern.find_first_of("\r\n", start);
+            if (end == std::string::npos) end = pattern.size();
+            addTrigrams(std::string_view(pattern).substr(start, end - start), g);
+            start = end + 1;
+        }
+        if (g.empty()) return false;
+        groups.push_back(std::move(g));
+    } else {
+        const bool folds = !opts.caseSensitive || pattern.find("(?i") != std::string::npos;
+        for (const std::string& branch : topLevelBranches(pattern)) {
+            std::vector<uint32_t> g;
+            for (const std::string& run : requiredRuns(branch, folds)) addTrigrams(run, g);
+            if (g.empty()) {
+                groups.clear();
+                return false;
+            }
+            groups.push_back(std::move(g));
+        }
+    }
+    for (auto& g : groups) {
+        std::sort(g.begin(), g.end());
+        g.erase(std::unique(g.begin(), g.end()), g.end());
+    }
+    return true;
+}
+
+// Binary search the base table, decode the list and skip dead ids
+// Taban tablosunda ikili ara, listeyi coz ve olu kimlikleri atla
+std::vector<uint32_t> TrigramIndex::postings(uint32_t trigram) const {
+    std::vector<uint32_t> out;
+    size_t lo = 0, hi = tableCount_;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        DiskTrigram e;
+        std::memcpy(&e, table_ + mid * sizeof(DiskTrigram), sizeof(e));
+        if (e.trigram < trigram) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < tableCount_) {
+        DiskTrigram e;
+        std::memcpy(&e, table_ + lo * sizeof(DiskTrigram), sizeof(e));
+        if (e.trigram == trigram && e.offset <= postingsBytes_) {
+            out.reserve(e.count);
+            forEachPosting(postings_ + e.offset, postings_ + postingsBytes_, e.count, [&](uint32_t id) {
+                if (id < files_.size() && files_[id].live) out.push_back(id);
+            });
+        }
+    }
+    // Ids grow from the base through the merging postings to the overlay
+    // Kimlikler tabandan birlestirilen kayitlar uzerinden katmana buyur
+    for (const Overlay* overlay : {merging_.get(), &extra_}) {
+        if (!overlay) continue;
+        auto it = overlay->find(trigram);
+        if (it == overlay->end()) continue;
+        for (uint32_t id : it->second) {
+            if (files_[id].live) out.push_back(id);
+        }
+    }
+    return out;
+}
+
+// Within a group the rarest trigrams are intersected first, so the lists shrink fast
+// Bir grup icinde en nadir trigramlar once kesistirilir, boylece listeler hizla kuculur
+bool TrigramIndex::candidates(const std::string& pattern, const SearchOptions& opts,
+                              std::vector<std::string>& out) const {
+    out.clear();
+    std::vector<std::vector<uint32_t>> groups;
+    if (!ready_ || !queryTrigrams(pattern, opts, groups)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ready_) return false;
+    std::vector<uint32_t> all;
+    for (const auto& group : groups) {
+        std::vector<std::vector<uint32_t>> lists;
+        lists.reserve(group.size());
+        for (uint32_t t : group) lists.push_back(postings(t));
+        std::sort(lists.begin(), lists.end(),
+                  [](const auto& a, const auto& b) { return a.size() < b.size(); });
+        std::vector<uint32_t> ids = std::move(lists.front());
+        for (size_t i = 1; i < lists.size() && !ids.empty(); ++i) ids = intersect(ids, lists[i]);
+        all.insert(all.end(), ids.begin(), ids.end());
+    }
+    std::sort(all.begin(), all.end());
+    all.erase(std::unique(all.begin(), all.end()), all.end());
+    out.reserve(all.size());
+    for (uint32_t id : all) out.push_back(root_ + "/" + files_[id].path);
+    return true;
+}
+
+// Trigrams of base and overlay are walked in order and each list is merged, dead ids dropped
+// and the rest renumbered densely, so the new file holds only live files. The file table and
+// overlay are frozen under mutex_, the merge and write run without it (the old base stays
+// mapped and the frozen postings stay searchable through merging_), and once the new file is
+// renamed into place the changes made meanwhile are carried onto its numbering.
+// Taban ve katmanin trigramlari sirayla gezilir ve her liste birlestirilir, olu kimlikler
+// atilir ve kalanlar sikica yeniden numaralanir, boylece yeni dosya yalnizca canli dosyalari
+// tutar. Dosya tablosu ve katman mutex_ altinda dondurulur, birlestirme ve yazma onsuz calisir
+// (eski taban eslenmis kalir ve dondurulmus kayitlar merging_ uzerinden aranabilir kalir) ve
+// yeni dosya yerine yeniden adlandirilinca bu arada yapilan degisiklikler onun numaralamasina
+// tasinir.
+bool TrigramIndex::mergeBase() {
+    std::shared_ptr<MappedFile> base;
+    const uint8_t* table = nullptr;
+    const uint8_t* postings = nullptr;
+    uint32_t tableCount = 0;
+    size_t postingsBytes = 0;
+    std::shared_ptr<const Overlay> overlay;
+    std::vector<uint32_t> remap;
+    std::vector<DiskFile> disk;
+    std::string strings;
+    DiskHeader h{};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (indexPath_.empty()) return false;
+        remap.assign(files_.size(), UINT32_MAX);
+        strings = root_;
+        for (size_t id = 0; id < files_.size(); ++id) {
+            const FileRecord& f = files_[id];
+            if (!f.live) continue;
+            remap[id] = static_cast<uint32_t>(disk.size());
+            disk.push_back({strings.size(), static_cast<uint32_t>(f.path.size()), 0, f.size, f.mtime});
+            strings += f.path;
+        }
+        base = base_;
+        table = table_;
+        postings = postings_;
+        tableCount = tableCount_;
+        postingsBytes = postingsBytes_;
+        merging_ = std::make_shared<const Overlay>(std::move(extra_));
+        overlay = merging_;
+        extra_.clear();
+        extraPostings_ = 0;
+        h.complete = ready_ ? 1 : 0;
+    }
+
+    std::vector<uint32_t> overlayKeys;
+    overlayKeys.reserve(overlay->size());
+    for (const auto& [t, ids] : *overlay) overlayKeys.push_back(t);
+    std::sort(overlayKeys.begin(), overlayKeys.end());
+
+    std::vector<DiskTrigram> diskTable;
+    std::string postingBytes;
+    std::vector<uint32_t> ids;
+    size_t b = 0, x = 0;
+    while (b < tableCount || x < overlayKeys.size()) {
+        DiskTrigram e{};
+        if (b < tableCount) std::memcpy(&e, table + b * sizeof(DiskTrigram), sizeof(e));
+        const uint32_t t = (b < tableCount && (x >= overlayKeys.size() || e.trigram <= overlayKeys[x]))
+            ? e.trigram : overlayKeys[x];
+        ids.clear();
+        if (b < tableCount && e.trigram == t) {
+            forEachPosting(postings + e.offset, postings + postingsBytes, e.count, [&](uint32_t id) {
+                if (id < remap.size() && remap[id] != UINT32_MAX) ids.push_back(remap[id]);
+            });
+            ++b;
+        }
+        if (x < overlayKeys.size() && overlayKeys[x] == t) {
+            for (uint32_t id : overlay->at(t)) {
+                if (remap[id] != UINT32_MAX) ids.push_back(remap[id]);
+            }
+            ++x;
+        }
+        if (ids.empty()) continue;
+        diskTable.push_back({t, static_cast<uint32_t>(ids.size()), postingBytes.size()});
+        uint32_t prev = 0;
+        for (uint32_t id : ids) {
+            putVarint(postingBytes, id - prev);
+            prev = id;
+        }
+    }
+
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kFormatVersion;
+    h.fileCount = static_cast<uint32_t>(disk.size());
+    h.trigramCount = static_cast<uint32_t>(diskTable.size());
+    h.rootBytes = static_cast<uint32_t>(root_.size());
+    h.generation = std::random_device{}() | 1;
+    h.filesOffset = sizeof(DiskHeader);
+    h.tableOffset = h.filesOffset + disk.size() * sizeof(DiskFile);
+    h.postingsOffset = h.tableOffset + diskTable.size() * sizeof(DiskTrigram);
+    h.postingsBytes = postingBytes.size();
+    h.stringsOffset = h.postingsOffset + h.postingsBytes;
+    h.totalBytes = h.stringsOffset + strings.size();
+
+    std::error_code ec;
+    fs::create_directories(fs::path(indexPath_).parent_path(), ec);
+    const std::string tmp = indexPath_ + ".tmp";
+    bool written = false;
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(disk.data()), static_cast<std::streamsize>(disk.size() * sizeof(DiskFile)));
+        out.write(reinterpret_cast<const char*>(diskTable.data()), static_cast<std::streamsize>(diskTable.size() * sizeof(DiskTrigram)));
+        out.write(postingBytes.data(), static_cast<std::streamsize>(postingBytes.size()));
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        written = static_cast<bool>(out.flush());
+    }
+    base.reset();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!written) {
+        // The frozen postings go back in front of the newer ones, keeping lists ascending
+        // Dondurulmus kayitlar yenilerin onune geri doner, listeler artan kalir
+        LOG_ERROR("[TrigramIndex] Cannot write ", tmp);
+        fs::remove(tmp, ec);
+        for (const auto& [t, frozen] : *overlay) {
+            std::vector<uint32_t>& dst = extra_[t];
+            dst.insert(dst.begin(), frozen.begin(), frozen.end());
+            extraPostings_ += frozen.size();
+        }
+        merging_.reset();
+        return false;
+    }
+
+    // The mapping is released first: a mapped file cannot be replaced on Windows. If the new
+    // file cannot be put in place the postings are gone, so searches walk from then on.
+    // Once esleme birakilir: Windows'ta eslenmis bir dosya degistirilemez. Yeni dosya yerine
+    // konamazsa kayitlar kaybolmustur, bu yuzden aramalar o andan itibaren gezer.
+    std::vector<FileRecord> old = std::move(files_);
+    Overlay later = std::move(extra_);
+    const bool wasReady = ready_;
+    base_.reset();
+    table_ = postings_ = nullptr;
+    tableCount_ = 0;
+    merging_.reset();
+    fs::rename(tmp, indexPath_, ec);
+    if (ec || !load()) {
+        LOG_ERROR("[TrigramIndex] Cannot replace ", indexPath_, ": ", ec.message());
+        fs::remove(tmp, ec);
+        files_.clear();
+        ids_.clear();
+        extra_.clear();
+        baseFiles_ = 0;
+        dead_ = 0;
+        extraPostings_ = 0;
+        ready_ = false;
+        return false;
+    }
+    fs::remove(indexPath_ + ".delta", ec);
+
+    // Files that died during the write are killed in the new numbering, files added during it
+    // are appended after the new base with their postings renumbered
+    // Yazma sirasinda olen dosyalar yeni numaralamada oldurulur, sirasinda eklenen dosyalar yeni
+    // tabanin ardina kayitlari yeniden numaralanarak eklenir
+    const size_t frozen = remap.size();
+    for (size_t id = 0; id < frozen; ++id) {
+        if (remap[id] == UINT32_MAX || old[id].live) continue;
+        FileRecord& f = files_[remap[id]];
+        f.live = false;
+        ids_.erase(f.path);
+        ++dead_;
+        dirty_ = true;
+    }
+    std::vector<uint32_t> renumber(old.size() - frozen);
+    for (size_t id = frozen; id < old.size(); ++id) {
+        renumber[id - frozen] = static_cast<uint32_t>(files_.size());
+        if (old[id].live) ids_[old[id].path] = static_cast<uint32_t>(files_.size());
+        else ++dead_;
+        files_.push_back(std::move(old[id]));
+        dirty_ = true;
+    }
+    for (auto& [t, added] : later) {
+        for (uint32_t& id : added) id = renumber[id - frozen];
+        extraPostings_ += added.size();
+    }
+    extra_ = std::move(later);
+    // A build that finished during the write is still saved as incomplete, so dirty_ (set by
+    // load()) brings it back to disk
+    // Yazma sirasinda biten bir kurulum hala tamamlanmamis kaydedilir, bu yuzden dirty_ (load()
+    // tarafindan ayarlanir) onu diske geri getirir
+    ready_ = wasReady;
+    return true;
+}
+
+// The overlay is serialized under mutex_ (it is small next to the base) and written without it
+// Katman mutex_ altinda seri hale getirilir (tabanin yaninda kucuktur) ve onsuz yazilir
+bool TrigramIndex::writeDelta() {
+    std::string out;
+    uint64_t changes = 0;
+    int overlay = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (indexPath_.empty() || !base_ || !baseComplete_) return false;
+        changes = changes_;
+        overlay = overlayFiles();
+        DeltaHeader h{};
+        std::memcpy(h.magic, kDeltaMagic, sizeof(kDeltaMagic));
+        h.version = kFormatVersion;
+        h.generation = generation_;
+        h.baseFiles = baseFiles_;
+        h.fileCount = static_cast<uint32_t>(files_.size() - baseFiles_);
+        h.trigramCount = static_cast<uint32_t>(extra_.size());
+        out.resize(sizeof(h));
+        for (uint32_t id = 0; id < baseFiles_; ++id) {
+            if (files_[id].live) continue;
+            putPod(out, id);
+            ++h.deadCount;
+        }
+        for (size_t id = baseFiles_; id < files_.size(); ++id) {
+            const FileRecord& f = files_[id];
+            putPod(out, DeltaFile{static_cast<uint32_t>(f.path.size()), f.live ? 1u : 0u, f.size, f.mtime});
+            out += f.path;
+        }
+        for (const auto& [t, ids] : extra_) {
+            putPod(out, t);
+            putPod(out, static_cast<uint32_t>(ids.size()));
+            uint32_t prev = 0;
+            for (uint32_t id : ids) {
+                putVarint(out, id - prev);
+                prev = id;
+            }
+        }
+        h.totalBytes = out.size();
+        std::memcpy(out.data(), &h, sizeof(h));
+    }
+
+    if (!writeReplacing(indexPath_ + ".delta", out)) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    savedOverlay_ = overlay;
+    if (changes_ == changes) dirty_ = false;
+    return true;
+}
+
+// Counts for search.index.status
+// search.index.status icin sayimlar
+TrigramIndex::Stats TrigramIndex::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s;
+    s.files = static_cast<int>(ids_.size());
+    s.trigrams = static_cast<int>(tableCount_);
+    s.pending = overlayFiles();
+    s.bytes = base_ ? base_->size() : 0;
+    return s;
+}
@@ -0,0 +1,243 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include "FileWatcher.h"
+#include "MappedFile.h"
+#include "SearchEngine.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Trigram index of the files under a workspace root, narrowing workspace searches to the files
+// that can match before WorkspaceSearch verifies them.
+// Bir calisma alani kokunun altindaki dosyalarin trigram indeksi; calisma alani aramalarini
+// WorkspaceSearch dogrulamadan once eslesebilecek dosyalara daraltir.
+// Every file is reduced to the set of its ASCII-lowercased three-byte sequences (line breaks
+// excluded, searches are single-line); a query needs every trigram of the literal runs it
+// cannot match without, so its candidates are the intersection of their posting lists (the
+// union over top-level regex alternatives). Queries with no such run (short literals, ".*")
+// are not narrowed and fall back to a full walk.
+// Her dosya ASCII kucuk harfli uc baytlik dizilerinin kumesine indirgenir (satir sonlari
+// haric, aramalar tek satirlidir); bir sorgu, onsuz eslesemeyecegi literal dizilerinin her
+// trigramina ihtiyac duyar, boylece adaylari onlarin kayit listelerinin kesisimidir (ust duzey
+// regex alternatifleri uzerinde birlesim). Boyle bir dizisi olmayan sorgular (kisa literaller,
+// ".*") daraltilmaz ve tam gezintiye duser.
+// The index lives in one file that is memory-mapped as is: a header, a file table, a sorted
+// trigram table and delta-varint posting lists. Changes reported by a FileWatcher on the root
+// go into an in-memory overlay (new postings plus dead file ids), saved every kCompactFiles
+// files as a small delta file beside the index; once the overlay outgrows a fraction of the
+// base, the index is rewritten, merging base and overlay in one sorted pass. Both are written
+// outside mutex_, so queries and watcher events never wait on the disk.
+// Indeks oldugu gibi bellege eslenen tek bir dosyada yasar: bir baslik, bir dosya tablosu,
+// sirali bir trigram tablosu ve delta-varint kayit listeleri. Kok uzerindeki bir FileWatcher'in
+// bildirdigi degisiklikler bellekteki bir katmana (yeni kayitlar ve olu dosya kimlikleri) gider,
+// her kCompactFiles dosyada indeksin yanina kucuk bir delta dosyasi olarak kaydedilir; katman
+// tabanin bir kesrini astiginda indeks yeniden yazilir, taban ve katman tek sirali geciste
+// birlestirilir. Ikisi de mutex_ disinda yazilir, boylece sorgular ve izleyici olaylari asla
+// diski beklemez.
+// start() serves the saved index at once (warm start) while a background pass reconciles it
+// with the tree by size and mtime, then watches from what that pass saw; without a usable
+// saved index, queries walk until the first build is done. Files changed in the last watcher
+// interval may be missed until it reports them.
+// start() kayitli indeksi hemen sunar (sicak baslangic), arka plandaki bir gecis onu boyut ve
+// mtime ile agacla uzlastirir, sonra o gecisin gorduklerinden izler; kullanilabilir kayitli
+// indeks yoksa ilk kurulum bitene kadar sorgular gezer. Son izleyici araliginda degisen
+// dosyalar, o bildirene kadar kacirilabilir.
+class TrigramIndex {
+public:
+    TrigramIndex() = default;
+    ~TrigramIndex();
+
+    TrigramIndex(const TrigramIndex&) = delete;
+    TrigramIndex& operator=(const TrigramIndex&) = delete;
+
+    // Index the tree under root in a file of indexDir named after the root: load it, then
+    // reconcile and watch in the background
+    // root altindaki agaci indexDir'de koke gore adlandirilan bir dosyada indeksle: yukle, sonra
+    // arka planda uzlastir ve izle
+    void start(const std::string& root, const std::string& indexDir);
+
+    // Stop watching and save pending changes
+    // Izlemeyi durdur ve bekleyen degisiklikleri kaydet
+    void stop();
+
+    // True once the index describes the tree (loaded or built)
+    // Indeks agaci tanimladiginda true (yuklenmis veya kurulmus)
+    bool ready() const { return ready_.load(); }
+
+    // Root being indexed (canonical) / Indekslenen kok (kanonik)
+    const std::string& root() const { return root_; }
+
+    // Files under the root that may match (absolute paths); false if the query cannot be
+    // narrowed or the index is not ready, in which case every file must be searched
+    // Kok altinda eslesebilecek dosyalar (mutlak yollar); sorgu daraltilamiyorsa veya indeks
+    // hazir degilse false, bu durumda her dosya aranmalidir
+    bool candidates(const std::string& pattern, const SearchOptions& opts, std::vector<std::string>& out) const;
+
+    // Re-read one file (created or modified) / drop a file or a whole directory
+    // Tek bir dosyayi yeniden oku (olusturulmus veya degistirilmis) / bir dosyayi veya tum dizini birak
+    void updateFile(const std::string& path);
+    void removePath(const std::string& path);
+
+    // Write the index (base merged with the overlay) and map the result; false on failure
+    // Indeksi yaz (katmanla birlestirilmis taban) ve sonucu esle; basarisizlikta false
+    bool save();
+
+    // Live files, distinct trigrams in the base, files waiting in the overlay
+    // Canli dosyalar, tabandaki farkli trigramlar, katmanda bekleyen dosyalar
+    struct Stats {
+        int files = 0;
+        int trigrams = 0;
+        int pending = 0;
+        uint64_t bytes = 0;      // Size of the index file / Indeks dosyasinin boyutu
+    };
+    Stats stats() const;
+
+    // Trigrams every match of a query contains, one group per top-level alternative; false if
+    // some alternative has none (the query cannot be narrowed)
+    // Bir sorgunun her eslemesinin icerdigi trigramlar, ust duzey alternatif basina bir grup;
+    // bir alternatifin hic yoksa false (sorgu daraltilamaz)
+    static bool queryTrigrams(const std::string& pattern, const SearchOptions& opts,
+                              std::vector<std::vector<uint32_t>>& groups);
+
+    // FileWatcher polling interval for the root (set before start)
+    // Kok icin FileWatcher yoklama araligi (start'tan once ayarla)
+    static void setWatchInterval(std::chrono::milliseconds ms);
+
+    // Overlay files changed since the last save that trigger writing the delta
+    // Delta yazimini tetikleyen, son kayittan beri degisen katman dosyalari
+    static constexpr int kCompactFiles = 1024;
+
+    // The base is rewritten once the overlay holds 1/kMergeRatio as many files as it
+    // Katman tabanin 1/kMergeRatio'su kadar dosya tuttugunda taban yeniden yazilir
+    static constexpr int kMergeRatio = 4;
+
+    // Overlay postings that trigger a rewrite, bounding memory on large trees
+    // Yeniden yazimi tetikleyen katman kayitlari, buyuk agaclarda bellegi sinirlar
+    static constexpr size_t kCompactPostings = size_t(1) << 25;
+
+    // Index file format version / Indeks dosyasi bicim surumu
+    static constexpr uint32_t kFormatVersion = 1;
+
+private:
+    // One indexed file; path is relative to the root with '/' separators
+    // Indekslenmis tek bir dosya; yol koke gore, '/' ayiricili
+    struct FileRecord {
+        std::string path;
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        bool live = true;
+    };
+
+    using Overlay = std::unordered_map<uint32_t, std::vector<uint32_t>>;
+
+    // Load indexPath_ if it describes root_, dropping the overlay; caller holds mutex_
+    // indexPath_ root_'u tanimliyorsa yukle, katmani birak; cagiran mutex_'i tutar
+    bool load();
+
+    // Apply the delta beside a loaded base if it was written against it; caller holds mutex_
+    // Yuklu bir tabanin yanindaki deltayi ona karsi yazildiysa uygula; cagiran mutex_'i tutar
+    bool loadDelta();
+
+    // Bring the index in line with the tree (background thread); returns what the walk saw,
+    // spelled as the watcher's baseline
+    // Indeksi agacla uyumlu hale getir (arka plan thread'i); gezintinin gorduklerini izleyicinin
+    // temeli olarak yazilmis dondurur
+    FileWatcher::Snapshot reconcile();
+
+    // Replace a file's postings with trigrams (null = drop the file; empty keeps it known, so
+    // binary and oversized files are not read again); caller holds mutex_
+    // Bir dosyanin kayitlarini trigramlarla degistir (null = dosyayi birak; bos onu bilinen tutar,
+    // boylece ikili ve cok buyuk dosyalar yeniden okunmaz); cagiran mutex_'i tutar
+    void setFile(const std::string& rel, uint64_t size, int64_t mtime, const std::vector<uint32_t>* trigrams);
+
+    // Read a file and collect its trigrams; false if it is not indexed (binary, too large, unreadable)
+    // Bir dosyayi oku ve trigramlarini topla; indekslenmiyorsa false (ikili, cok buyuk, okunamaz)
+    static bool fileTrigrams(const std::string& path, uint64_t size, std::string& buffer,
+                             std::vector<uint64_t>& seen, std::vector<uint32_t>& out);
+
+    // Live file ids holding a trigram, ascending; caller holds mutex_
+    // Bir trigrami tutan canli dosya kimlikleri, artan; cagiran mutex_'i tutar
+    std::vector<uint32_t> postings(uint32_t trigram) const;
+
+    // Save what the overlay calls for: nothing, a delta or a new base; force saves anything
+    // unsaved. Returns at once if another save is running, unless forced.
+    // Katmanin gerektirdigini kaydet: hicbir sey, bir delta veya yeni bir taban; force
+    // kaydedilmemis her seyi kaydeder. Zorlanmadikca baska bir kayit suruyorsa hemen doner.
+    void flush(bool force);
+
+    // Merge base and overlay into a new index file and map it; caller holds saveMutex_
+    // Taban ve katmani yeni bir indeks dosyasinda birlestir ve esle; cagiran saveMutex_'i tutar
+    bool mergeBase();
+
+    // Write the overlay as the delta of the mapped base; caller holds saveMutex_
+    // Katmani eslenmis tabanin deltasi olarak yaz; cagiran saveMutex_'i tutar
+    bool writeDelta();
+
+    // Files added or dropped since the base; caller holds mutex_
+    // Tabandan beri eklenen veya birakilan dosyalar; cagiran mutex_'i tutar
+    int overlayFiles() const { return static_cast<int>(files_.size() - baseFiles_) + dead_; }
+
+    // Path relative to root_ with '/' separators, empty if outside it
+    // root_'a gore '/' ayiricili yol, disindaysa bos
+    std::string relative(const std::string& path) const;
+
+    mutable std::mutex mutex_;
+    std::string root_;
+    std::string indexPath_;
+    std::vector<FileRecord> files_;                              // By file id / Dosya kimligine gore
+    std::unordered_map<std::string, uint32_t> ids_;              // Live path -> id / Canli yol -> kimlik
+
+    // Mapped base: trigram table and posting lists of ids [0, baseFiles_). Shared with a
+    // merge that reads it outside mutex_.
+    // Eslenmis taban: [0, baseFiles_) kimliklerinin trigram tablosu ve kayit listeleri. mutex_
+    // disinda onu okuyan bir birlestirmeyle paylasilir.
+    std::shared_ptr<MappedFile> base_;
+    const uint8_t* table_ = nullptr;
+    uint32_t tableCount_ = 0;
+    const uint8_t* postings_ = nullptr;
+    size_t postingsBytes_ = 0;
+    uint32_t baseFiles_ = 0;
+    uint32_t generation_ = 0;    // Of the base, named by its delta / Tabanin, deltasi onu adlandirir
+    bool baseComplete_ = false;  // The base holds a finished build / Taban bitmis bir kurulum tutar
+
+    // Overlay: postings of ids from baseFiles_ on, and how many ids died since the base
+    // Katman: baseFiles_'tan itibaren kimliklerin kayitlari ve tabandan beri olen kimlik sayisi
+    Overlay extra_;
+    int dead_ = 0;
+    size_t extraPostings_ = 0;   // Entries in extra_ / extra_'taki girdiler
+    bool dirty_ = false;         // Changed since the last save / Son kayittan beri degisti
+    uint64_t changes_ = 0;       // setFile calls / setFile cagrilari
+    int savedOverlay_ = 0;       // overlayFiles() at the last delta / Son deltadaki overlayFiles()
+
+    // Overlay postings a running merge is writing into the new base, still searched
+    // Calisan bir birlestirmenin yeni tabana yazdigi, hala aranan katman kayitlari
+    std::shared_ptr<const Overlay> merging_;
+
+    // Serializes saves; taken before mutex_, never while holding it
+    // Kayitlari siralar; mutex_'ten once alinir, onu tutarken asla
+    std::mutex saveMutex_;
+
+    // Buffer and seen-bitmap reused by watcher events
+    // Izleyici olaylarinin yeniden kullandigi tampon ve gorulen bit haritasi
+    std::mutex scratchMutex_;
+    std::string scratchBuffer_;
+    std::vector<uint64_t> scratchSeen_;
+
+    std::atomic<bool> ready_{false};
+    std::atomic<bool> stopping_{false};
+    std::thread worker_;
+    std::unique_ptr<FileWatcher> watcher_;
+
+    static std::atomic<int> watchIntervalMs_;
+};
@@ -0,0 +1,460 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "UndoFile.h"
+#include "BufferSnapshot.h"
+#include "MappedFile.h"
+#include "PieceTable.h"
+#include "Logger.h"
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char kMagic[8] = {'B', 'K', 'U', 'N', 'D', 'O', '1', '\n'};
+constexpr size_t kFlushBytes = 64 * 1024;
+
+// Append one byte
+// Tek bir bayt ekle
+void putU8(std::string& out, uint8_t v) {
+    out += static_cast<char>(v);
+}
+
+// Append a 32-bit value, little-endian on every platform
+// Her platformda little-endian olarak 32 bitlik bir deger ekle
+void putU32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out += static_cast<char>((v >> (8 * i)) & 0xFF);
+}
+
+// Append a signed 32-bit value as its two's-complement bits
+// Isaretli 32 bitlik bir degeri ikiye tumleyen bitleriyle ekle
+void putI32(std::string& out, int32_t v) {
+    putU32(out, static_cast<uint32_t>(v));
+}
+
+// Append a 64-bit value, little-endian on every platform
+// Her platformda little-endian olarak 64 bitlik bir deger ekle
+void putU64(std::string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out += static_cast<char>((v >> (8 * i)) & 0xFF);
+}
+
+// FNV-1a, for naming the undofile after the source path
+// FNV-1a, geri alma dosyasini kaynak yoluna gore adlandirmak icin
+uint64_t fnv1a(std::string_view s) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Header: magic plus the source path, so a name collision is detected rather than replayed
+// Baslik: sihirli deger arti kaynak yolu, boylece bir ad cakismasi tekrar oynatilmak yerine fark edilir
+std::string header(const std::string& sourcePath) {
+    std::string out(kMagic, sizeof(kMagic));
+    putU32(out, static_cast<uint32_t>(sourcePath.size()));
+    out += sourcePath;
+    return out;
+}
+
+} // namespace
+
+std::mutex UndoFile::dirMutex_;
+std::string UndoFile::directory_;
+std::atomic<uint64_t> UndoFile::maxText_{UndoFile::kMaxText};
+
+// Read one byte; past the end, clear ok and return 0
+// Tek bir bayt oku; sonun otesinde ok'u temizle ve 0 dondur
+uint8_t UndoFile::Reader::u8() {
+    if (pos + 1 > data.size()) { ok = false; return 0; }
+    return static_cast<uint8_t>(data[pos++]);
+}
+
+// Read a little-endian 32-bit value, clearing ok if it is cut
+// Little-endian 32 bitlik bir deger oku, kesikse ok'u temizle
+uint32_t UndoFile::Reader::u32() {
+    if (pos + 4 > data.size()) { ok = false; return 0; }
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+    pos += 4;
+    return v;
+}
+
+// Read a little-endian 64-bit value, clearing ok if it is cut
+// Little-endian 64 bitlik bir deger oku, kesikse ok'u temizle
+uint64_t UndoFile::Reader::u64() {
+    if (pos + 8 > data.size()) { ok = false; return 0; }
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+    pos += 8;
+    return v;
+}
+
+// View the next n bytes in place, clearing ok if fewer are left
+// Sonraki n bayti yerinde goster, daha azi kaldiysa ok'u temizle
+std::string_view UndoFile::Reader::bytes(size_t n) {
+    if (n > data.size() - pos) { ok = false; return {}; }
+    std::string_view v = data.substr(pos, n);
+    pos += n;
+    return v;
+}
+
+// Nothing is touched on disk until the first flush
+// Ilk bosaltmaya kadar diskte hicbir seye dokunulmaz
+UndoFile::UndoFile(std::string sourcePath, std::string journalPath)
+    : sourcePath_(std::move(sourcePath)), journalPath_(std::move(journalPath)) {}
+
+// Write whatever is still pending
+// Hala bekleyenleri yaz
+UndoFile::~UndoFile() {
+    flush();
+}
+
+// The key is the absolute path, so the same file opened by two spellings shares one history
+// Anahtar mutlak yoldur, boylece iki farkli yazimla acilan ayni dosya tek bir gecmisi paylasir
+std::shared_ptr<UndoFile> UndoFile::forPath(const std::string& path) {
+    std::string dir = directory();
+    if (dir.empty() || path.empty()) return nullptr;
+
+    std::error_code ec;
+    std::string key = fs::absolute(path, ec).lexically_normal().string();
+    if (ec) key = path;
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.undo", static_cast<unsigned long long>(fnv1a(key)));
+    return std::make_shared<UndoFile>(key, (fs::path(dir) / name).string());
+}
+
+// Directory undofiles live in; empty turns persistent undo off
+// Geri alma dosyalarinin yasadigi dizin; bos, kalici geri almayi kapatir
+void UndoFile::setDirectory(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(dirMutex_);
+    directory_ = dir;
+}
+
+// Current undofile directory, empty when persistence is off
+// Gecerli geri alma dosyasi dizini, kalicilik kapaliyken bos
+std::string UndoFile::directory() {
+    std::lock_guard<std::mutex> lock(dirMutex_);
+    return directory_;
+}
+
+// Eight bytes at a time with a multiply-rotate mix; every line is followed by its newline so
+// moving text across a line break changes the hash
+// Carp-dondur karisimiyla sekizer bayt; her satiri yeni satiri izler, boylece metni bir satir
+// sonunun otesine tasimak ozeti degistirir
+uint64_t UndoFile::hashContent(const BufferSnapshot& snap, const std::atomic<bool>* cancel) {
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    auto mix = [&h](uint64_t w) {
+        h ^= w * 0xFF51AFD7ED558CCDull;
+        h = (h << 27 | h >> 37) * 0xC4CEB9FE1A85EC53ull;
+    };
+    snap.forEachChunk(0, snap.lineCount(), [&mix, cancel](int, const std::string_view* lines, int count) {
+        for (int l = 0; l < count; ++l) {
+            std::string_view text = lines[l];
+            size_t i = 0;
+            for (; i + 8 <= text.size(); i += 8) {
+                uint64_t w;
+                std::memcpy(&w, text.data() + i, 8);
+                mix(w);
+            }
+            uint64_t tail = 0;
+            for (size_t k = 0; i + k < text.size(); ++k) {
+                tail |= static_cast<uint64_t>(static_cast<uint8_t>(text[i + k])) << (8 * k);
+            }
+            mix(tail ^ (static_cast<uint64_t>(text.size()) << 56));
+            mix('\n');
+        }
+        return !cancel || !cancel->load(std::memory_order_relaxed);
+    });
+    return h;
+}
+
+// The journal is mapped, not read, so replaying a large history does not copy it first
+// Gunluk okunmaz eslenir, boylece buyuk bir gecmisi tekrar oynatmak once onu kopyalamaz
+bool UndoFile::read(const std::function<void(uint8_t kind, Reader& body)>& fn, size_t& records, bool& torn) const {
+    records = 0;
+    torn = false;
+    std::error_code ec;
+    if (!fs::exists(journalPath_, ec)) return false;
+
+    MappedFile map;
+    if (!map.open(journalPath_, false)) return false;
+
+    Reader file{map.contents()};
+    std::string_view magic = file.bytes(sizeof(kMagic));
+    if (!file.ok || magic != std::string_view(kMagic, sizeof(kMagic))) {
+        LOG_WARN("[Undo] Not an undofile: ", journalPath_);
+        return false;
+    }
+    uint32_t pathLen = file.u32();
+    std::string_view path = file.bytes(pathLen);
+    if (!file.ok || path != sourcePath_) {
+        LOG_WARN("[Undo] Undofile belongs to another path: ", journalPath_);
+        return false;
+    }
+
+    while (file.pos < file.data.size()) {
+        uint8_t kind = file.u8();
+        uint32_t len = file.u32();
+        std::string_view body = file.bytes(len);
+        if (!file.ok) {
+            torn = true;  // Crash mid-append / Ekleme ortasinda cokme
+            break;
+        }
+        Reader r{body};
+        fn(kind, r);
+        ++records;
+    }
+    return true;
+}
+
+// Drop unwritten records; the next flush truncates the file and starts over
+// Yazilmamis kayitlari birak; sonraki bosaltma dosyayi kisaltir ve bastan baslar
+void UndoFile::restart() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+    deferred_.clear();
+    truncate_ = true;
+    refused_ = false;
+}
+
+// Drop unwritten records and delete the file
+// Yazilmamis kayitlari birak ve dosyayi sil
+void UndoFile::remove() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+    deferred_.clear();
+    truncate_ = false;
+    refused_ = false;
+    std::error_code ec;
+    fs::remove(journalPath_, ec);
+}
+
+// Record a node with its text copied into the record
+// Metni kayda kopyalanmis bir dugum kaydet
+void UndoFile::node(const UndoNode& n, uint32_t parentId, std::string_view text) {
+    if (text.size() > maxText()) {
+        refuse(text.size());
+        return;
+    }
+    std::string body;
+    body.reserve(50 + text.size());
+    putU32(body, n.seq);
+    putU32(body, parentId);
+    putU8(body, static_cast<uint8_t>(n.type));
+    putU8(body, n.backward ? 1 : 0);
+    putI32(body, n.line);
+    putI32(body, n.col);
+    putI32(body, n.lineEnd);
+    putI32(body, n.colEnd);
+    putI32(body, n.groupSize);
+    putU32(body, static_cast<uint32_t>(text.size()));
+    body.append(text);
+    putU64(body, static_cast<uint64_t>(n.time));
+    append(Node, body);
+}
+
+// Short texts are copied like any other record; long ones leave a gap that writePending fills
+// from the table, so the command thread never materializes a large cut
+// Kisa metinler diger kayitlar gibi kopyalanir; uzunlar writePending'in tablodan doldurdugu bir
+// bosluk birakir, boylece komut thread'i buyuk bir kesimi asla somutlastirmaz
+void UndoFile::node(const UndoNode& n, uint32_t parentId, std::shared_ptr<const PieceTable> table) {
+    uint64_t length = table->offsetOf(n.lineEnd, n.colEnd) - table->offsetOf(n.line, n.col);
+    if (length > maxText()) {
+        refuse(length);
+        return;
+    }
+    if (length < kFlushBytes) {
+        std::string text;
+        for (int l = n.line; l <= n.lineEnd; ++l) {
+            std::string_view v = table->lineView(l);
+            size_t from = l == n.line ? std::min<size_t>(n.col, v.size()) : 0;
+            size_t to = l == n.lineEnd ? std::min<size_t>(n.colEnd, v.size()) : v.size();
+            if (to > from) text.append(v.substr(from, to - from));
+            if (l < n.lineEnd) text += '\n';
+        }
+        node(n, parentId, text);
+        return;
+    }
+
+    std::string head;
+    putU32(head, n.seq);
+    putU32(head, parentId);
+    putU8(head, static_cast<uint8_t>(n.type));
+    putU8(head, n.backward ? 1 : 0);
+    putI32(head, n.line);
+    putI32(head, n.col);
+    putI32(head, n.lineEnd);
+    putI32(head, n.colEnd);
+    putI32(head, n.groupSize);
+    putU32(head, static_cast<uint32_t>(length));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (refused_) return;
+    putU8(pending_, Node);
+    putU32(pending_, static_cast<uint32_t>(head.size() + length + 8));
+    pending_ += head;
+    deferred_.push_back({pending_.size(), std::move(table), n.line, n.col, n.lineEnd, n.colEnd});
+    putU64(pending_, static_cast<uint64_t>(n.time));
+}
+
+// The journal cannot hold this node, and without it nothing recorded after it would replay:
+// empty the history on disk and ignore records until the tree is written over again
+// Gunluk bu dugumu tutamaz ve o olmadan ondan sonra kaydedilen hicbir sey tekrar oynatilamaz:
+// diskteki gecmisi bosalt ve agac yeniden yazilana kadar kayitlari yok say
+void UndoFile::refuse(uint64_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (refused_) return;
+    LOG_WARN("[Undo] Edit of ", length, " bytes is too large to journal, history restarts: ", journalPath_);
+    pending_.clear();
+    deferred_.clear();
+    truncate_ = true;
+    refused_ = true;
+}
+
+// Record a typing run on an existing node growing by one character
+// Var olan bir dugumdeki yazma dizisinin bir karakter buyudugunu kaydet
+void UndoFile::extend(uint32_t id, int col, bool backward, char c, int64_t time) {
+    std::string body;
+    putU32(body, id);
+    putI32(body, col);
+    putU8(body, backward ? 1 : 0);
+    body += c;
+    putU64(body, static_cast<uint64_t>(time));
+    append(Extend, body);
+}
+
+// Record a group of size edits closing on a node
+// Bir dugumde size duzenlemelik bir grubun kapandigini kaydet
+void UndoFile::group(uint32_t id, int size) {
+    std::string body;
+    putU32(body, id);
+    putI32(body, size);
+    append(Group, body);
+}
+
+// Record which child a node redoes into
+// Bir dugumun hangi cocuga yinelendigini kaydet
+void UndoFile::active(uint32_t parentId, uint32_t childId) {
+    std::string body;
+    putU32(body, parentId);
+    putU32(body, childId);
+    append(Active, body);
+}
+
+// Record that a branch was evicted with its subtree
+// Bir dalin alt agaciyla birlikte cikarildigini kaydet
+void UndoFile::drop(uint32_t id) {
+    std::string body;
+    putU32(body, id);
+    append(Drop, body);
+}
+
+// Record that the root's child became the root
+// Kokun cocugunun kok oldugunu kaydet
+void UndoFile::root(uint32_t id) {
+    std::string body;
+    putU32(body, id);
+    append(Root, body);
+}
+
+// Record a save: the node the file on disk matches and its content hash
+// Bir kaydi kaydet: diskteki dosyanin uydugu dugum ve icerik ozeti
+void UndoFile::save(uint32_t id, uint64_t hash) {
+    std::string body;
+    putU32(body, id);
+    putU64(body, hash);
+    append(Save, body);
+}
+
+// Write pending records to disk now
+// Bekleyen kayitlari simdi diske yaz
+void UndoFile::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flushLocked();
+}
+
+// Queue one record; flush once 64 KB are pending, unless a deferred text still waits
+// Tek bir kayit kuyruga al; ertelenmis bir metin beklemiyorsa 64 KB birikince bosalt
+void UndoFile::append(uint8_t kind, const std::string& body) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (refused_) return;
+    putU8(pending_, kind);
+    putU32(pending_, static_cast<uint32_t>(body.size()));
+    pending_ += body;
+    if (pending_.size() >= kFlushBytes && deferred_.empty()) flushLocked();
+}
+
+// Pending bytes with each deferred text streamed in at its gap, line by line from its table
+// Bekleyen baytlar, her ertelenmis metin kendi boslugunda tablosundan satir satir akitilarak
+bool UndoFile::writePending(std::ostream& out) const {
+    size_t pos = 0;
+    for (const Deferred& d : deferred_) {
+        out.write(pending_.data() + pos, static_cast<std::streamsize>(d.at - pos));
+        pos = d.at;
+        for (int l = d.line; l <= d.lineEnd; ++l) {
+            std::string_view v = d.table->lineView(l);
+            size_t from = l == d.line ? std::min<size_t>(d.col, v.size()) : 0;
+            size_t to = l == d.lineEnd ? std::min<size_t>(d.colEnd, v.size()) : v.size();
+            if (to > from) out.write(v.data() + from, static_cast<std::streamsize>(to - from));
+            if (l < d.lineEnd) out.put('\n');
+        }
+    }
+    out.write(pending_.data() + pos, static_cast<std::streamsize>(pending_.size() - pos));
+    return static_cast<bool>(out);
+}
+
+// Appends go straight to the end of the file; a rewrite goes through a temp file and a rename
+// so a crash leaves either the old journal or the new one
+// Eklemeler dogrudan dosyanin sonuna gider; yeniden yazma gecici dosya ve yeniden adlandirma
+// uzerinden gecer, boylece bir cokme ya eski ya da yeni gunlugu birakir
+void UndoFile::flushLocked() {
+    if (pending_.empty() && !truncate_) return;
+
+    std::error_code ec;
+    fs::create_directories(fs::path(journalPath_).parent_path(), ec);
+
+    if (truncate_) {
+        std::string tmp = journalPath_ + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                LOG_ERROR("[Undo] Cannot write: ", tmp);
+                return;
+            }
+            std::string head = header(sourcePath_);
+            out.write(head.data(), static_cast<std::streamsize>(head.size()));
+            if (!writePending(out)) {
+                LOG_ERROR("[Undo] Write failed: ", tmp);
+                return;
+            }
+        }
+        fs::rename(tmp, journalPath_, ec);
+        if (ec) {
+            LOG_ERROR("[Undo] Cannot replace: ", journalPath_, " (", ec.message(), ")");
+            return;
+        }
+        truncate_ = false;
+    } else {
+        std::ofstream out(journalPath_, std::ios::binary | std::ios::app);
+        if (!out.is_open()) {
+            LOG_ERROR("[Undo] Cannot append: ", journalPath_);
+            return;
+        }
+        if (!writePending(out)) {
+            LOG_ERROR("[Undo] Append failed: ", journalPath_);
+            return;
+        }
+    }
+    pending_.clear();
+    deferred_.clear();
+}
@@ -0,0 +1,169 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "undo.h"
+
+class BufferSnapshot;
+class PieceTable;
+
+// Append-only binary journal of one file's undo tree (~/.berkide/undo/<path hash>.undo).
+// Bir dosyanin geri alma agacinin yalnizca eklenen ikili gunlugu (~/.berkide/undo/<yol ozeti>.undo).
+// Every tree mutation is one length-prefixed record naming nodes by their sequence id; the
+// tree is rebuilt by replaying them, and a torn record at the tail (crash mid-write) simply
+// ends the replay. SAVE records tie a node to the content hash of the file written at that
+// point, so history is only restored onto the exact text it was recorded against.
+// Her agac degisikligi, dugumleri sira kimlikleriyle adlandiran uzunluk onekli tek bir
+// kayittir; agac bunlar tekrar oynatilarak yeniden kurulur ve sondaki yarim bir kayit (yazma
+// ortasinda cokme) tekrar oynatmayi yalnizca bitirir. SAVE kayitlari bir dugumu o noktada
+// yazilan dosyanin icerik ozetine baglar, boylece gecmis yalnizca kaydedildigi metnin
+// tam aynisina geri yuklenir.
+class UndoFile {
+public:
+    // Record kinds / Kayit turleri
+    enum Kind : uint8_t {
+        Node = 1,     // id, parent, fields, text, time: a new node / yeni bir dugum
+        Extend = 2,   // id, col, backward, char, time: a run grew / bir dizi buyudu
+        Group = 3,    // id, size: a group closed on the node / dugumde bir grup kapandi
+        Active = 4,   // parent, child: redo branch switched / yineleme dali degisti
+        Drop = 5,     // id: a branch was evicted / bir dal cikarildi
+        Root = 6,     // id: the root's child became the root / kokun cocugu kok oldu
+        Save = 7      // id, hash: the file was written at this node / dosya bu dugumde yazildi
+    };
+
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;  // No parent (the root) / Ebeveyn yok (kok)
+
+    // Longest node text a record can frame: its length and the record's are 32-bit
+    // Bir kaydin cerceveleyebilecegi en uzun dugum metni: onun ve kaydin uzunlugu 32 bittir
+    static constexpr uint64_t kMaxText = 0xFFFFFFFFu - 64;
+
+    // Bounds-checked little-endian reader over one record body. Fields added to a record kind
+    // later sit at the end of its body and are read only when present.
+    // Tek bir kayit govdesi uzerinde sinir denetimli little-endian okuyucu. Bir kayit turune
+    // sonradan eklenen alanlar govdenin sonunda durur ve yalnizca varsa okunur.
+    struct Reader {
+        std::string_view data;
+        size_t pos = 0;
+        bool ok = true;
+
+        uint8_t u8();
+        uint32_t u32();
+        int32_t i32() { return static_cast<int32_t>(u32()); }
+        uint64_t u64();
+        std::string_view bytes(size_t n);
+    };
+
+    // Journal for the file at sourcePath stored at journalPath
+    // journalPath'te saklanan, sourcePath'teki dosyanin gunlugu
+    UndoFile(std::string sourcePath, std::string journalPath);
+
+    // Flushes what is still pending, so closing a document keeps its history
+    // Hala bekleyeni bosaltir, boylece bir belgeyi kapatmak gecmisini korur
+    ~UndoFile();
+
+    UndoFile(const UndoFile&) = delete;
+    UndoFile& operator=(const UndoFile&) = delete;
+
+    // Journal for a file in the configured directory, or nullptr when persistence is off
+    // Yapilandirilmis dizindeki bir dosyanin gunlugu veya kalicilik kapaliyken nullptr
+    static std::shared_ptr<UndoFile> forPath(const std::string& path);
+
+    // Directory holding undofiles (empty disables persistence)
+    // Geri alma dosyalarini tutan dizin (bos kaliciligi kapatir)
+    static void setDirectory(const std::string& dir);
+    static std::string directory();
+
+    // Longest node text journaled (kMaxText; tests lower it to reach the limit cheaply). A
+    // longer node empties the history on disk, which stays empty until the tree is rewritten.
+    // Gunluge yazilan en uzun dugum metni (kMaxText; testler sinira ucuzca ulasmak icin dusurur).
+    // Daha uzun bir dugum diskteki gecmisi bosaltir; agac yeniden yazilana kadar bos kalir.
+    static void setMaxText(uint64_t bytes) { maxText_.store(std::min(bytes, kMaxText)); }
+    static uint64_t maxText() { return maxText_.load(); }
+
+    // Hash of a snapshot's text, the key SAVE records are matched against. Stops early (with a
+    // meaningless result) once cancel is set.
+    // Bir anlik goruntunun metninin ozeti, SAVE kayitlarinin eslestirildigi anahtar. cancel
+    // ayarlaninca erken durur (anlamsiz bir sonucla).
+    static uint64_t hashContent(const BufferSnapshot& snap, const std::atomic<bool>* cancel = nullptr);
+
+    const std::string& sourcePath() const { return sourcePath_; }
+    const std::string& journalPath() const { return journalPath_; }
+
+    // Map the journal and hand every complete record to fn; false if it is missing or belongs
+    // to another file. `records` counts what was replayed and `torn` reports a partial record
+    // at the tail, after which nothing may be appended until the journal is rewritten.
+    // Gunlugu esle ve her tam kaydi fn'e ver; yoksa veya baska bir dosyaya aitse false.
+    // `records` tekrar oynatilanlari sayar ve `torn` sondaki yarim bir kaydi bildirir; gunluk
+    // yeniden yazilana kadar ondan sonra hicbir sey eklenemez.
+    bool read(const std::function<void(uint8_t kind, Reader& body)>& fn, size_t& records, bool& torn) const;
+
+    // Start the journal over: the next flush truncates the file and writes a fresh header
+    // Gunlugu bastan baslat: sonraki bosaltma dosyayi keser ve yeni bir baslik yazar
+    void restart();
+
+    // Delete the journal from disk and drop anything pending
+    // Gunlugu diskten sil ve bekleyen her seyi birak
+    void remove();
+
+    // Record writers (buffered; flushed at 64 KB, on save, on close and at shutdown)
+    // Kayit yazicilari (tamponlu; 64 KB'ta, kaydetmede, kapatmada ve kapanista bosaltilir)
+    void node(const UndoNode& n, uint32_t parentId, std::string_view text);
+
+    // A by-reference deletion: the text stays in the sealed table and is streamed into the
+    // record when it is flushed. Above 64 KB the record holds back automatic flushing, so it
+    // reaches disk on the next save (saver thread), close or shutdown, not on the edit.
+    // Referansli bir silme: metin muhurlu tabloda kalir ve kayit bosaltilirken ona akitilir.
+    // 64 KB'in ustunde kayit otomatik bosaltmayi bekletir, boylece diske duzenlemede degil
+    // sonraki kaydetmede (kaydedici thread), kapatmada veya kapanista ulasir.
+    void node(const UndoNode& n, uint32_t parentId, std::shared_ptr<const PieceTable> table);
+    void extend(uint32_t id, int col, bool backward, char c, int64_t time);
+    void group(uint32_t id, int size);
+    void active(uint32_t parentId, uint32_t childId);
+    void drop(uint32_t id);
+    void root(uint32_t id);
+    void save(uint32_t id, uint64_t hash);
+
+    // Write pending records to disk
+    // Bekleyen kayitlari diske yaz
+    void flush();
+
+private:
+    // Frame a record into the pending buffer and flush when it grows large
+    // Bir kaydi bekleyen tampona cercevele ve buyudugunde bosalt
+    void append(uint8_t kind, const std::string& body);
+    void refuse(uint64_t length);
+    void flushLocked();
+    bool writePending(std::ostream& out) const;
+
+    // Text of a by-reference node, spliced into pending_ at `at` when written
+    // Referansli bir dugumun metni, yazilirken pending_ icine `at` konumunda eklenir
+    struct Deferred {
+        size_t at = 0;
+        std::shared_ptr<const PieceTable> table;
+        int line = 0, col = 0, lineEnd = 0, colEnd = 0;
+    };
+
+    std::string sourcePath_;   // Edited file / Duzenlenen dosya
+    std::string journalPath_;  // Undofile / Geri alma dosyasi
+    std::mutex mutex_;         // Saver thread records SAVE / Kaydedici thread SAVE kaydeder
+    std::string pending_;      // Records not yet on disk / Henuz diskte olmayan kayitlar
+    std::vector<Deferred> deferred_;  // Texts still in their tables / Hala tablolarindaki metinler
+    bool truncate_ = false;    // Next flush rewrites the file / Sonraki bosaltma dosyayi yeniden yazar
+    bool refused_ = false;     // A node was too large; records are ignored / Bir dugum cok buyuktu; kayitlar yok sayilir
+
+    static std::mutex dirMutex_;
+    static std::string directory_;
+    static std::atomic<uint64_t> maxText_;
+};
@@ -0,0 +1,448 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Utf8Scanner.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define BERKIDE_UTF8_SSE2 1
+        // SSSE3 and AVX2 are compiled per function and picked at runtime on GCC/Clang; MSVC
+        // needs them enabled for the whole build (/arch:AVX, /arch:AVX2)
+        // SSSE3 ve AVX2 GCC/Clang'da fonksiyon bazinda derlenir ve calisma zamaninda secilir;
+        // MSVC tum derleme icin acilmalarini ister (/arch:AVX, /arch:AVX2)
+        #if defined(__GNUC__) || defined(__clang__)
+            #define BERKIDE_UTF8_SSSE3 1
+            #define BERKIDE_TARGET_SSSE3 __attribute__((target("ssse3")))
+            #define BERKIDE_UTF8_AVX2 1
+            #define BERKIDE_TARGET_AVX2 __attribute__((target("avx2")))
+        #else
+            #if defined(__AVX__)
+                #define BERKIDE_UTF8_SSSE3 1
+                #define BERKIDE_TARGET_SSSE3
+            #endif
+            #if defined(__AVX2__)
+                #define BERKIDE_UTF8_AVX2 1
+                #define BERKIDE_TARGET_AVX2
+            #endif
+        #endif
+    #endif
+#endif
+
+namespace {
+
+// Error bits of the lookup-table validator: each table maps a nibble of the previous byte
+// (high, low) or of the current byte (high) to the errors it allows; an error survives the
+// AND of all three only if every nibble agrees
+// Arama tablolu dogrulayicinin hata bitleri: her tablo onceki baytin (yuksek, dusuk) veya
+// gecerli baytin (yuksek) bir yarim baytini izin verdigi hatalara esler; bir hata ancak her
+// yarim bayt hemfikirse ucunun AND'inden sag cikar
+[[maybe_unused]] constexpr uint8_t kTooShort   = 1 << 0;  // Lead not followed by a continuation / Devam baytiyla izlenmeyen baslangic
+[[maybe_unused]] constexpr uint8_t kTooLong    = 1 << 1;  // Continuation after ASCII / ASCII'den sonra devam bayti
+[[maybe_unused]] constexpr uint8_t kOverlong3  = 1 << 2;  // E0 80..9F
+[[maybe_unused]] constexpr uint8_t kTooLarge   = 1 << 3;  // F4 90.. and F5..FF
+[[maybe_unused]] constexpr uint8_t kSurrogate  = 1 << 4;  // ED A0..BF
+[[maybe_unused]] constexpr uint8_t kOverlong2  = 1 << 5;  // C0, C1
+[[maybe_unused]] constexpr uint8_t kTooLarge1000 = 1 << 6;  // F5..FF 80..8F
+[[maybe_unused]] constexpr uint8_t kOverlong4  = 1 << 6;  // F0 80..8F
+[[maybe_unused]] constexpr uint8_t kTwoConts   = 1 << 7;  // Two continuations in a row / Art arda iki devam bayti
+[[maybe_unused]] constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+// High nibble of the previous byte / Onceki baytin yuksek yarim bayti
+[[maybe_unused]] alignas(16) constexpr uint8_t kByte1High[16] = {
+    kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    kTooShort | kOverlong2,
+    kTooShort,
+    kTooShort | kOverlong3 | kSurrogate,
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+};
+
+// Low nibble of the previous byte / Onceki baytin dusuk yarim bayti
+[[maybe_unused]] alignas(16) constexpr uint8_t kByte1Low[16] = {
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000
+};
+
+// High nibble of the current byte / Gecerli baytin yuksek yarim bayti
+[[maybe_unused]] alignas(16) constexpr uint8_t kByte2High[16] = {
+    kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooShort, kTooShort, kTooShort, kTooShort
+};
+
+// A block ending in these bytes leaves a sequence open: lead of 2 in the last byte, of 3 in
+// the last two, of 4 in the last three
+// Bu baytlarla biten bir blok bir diziyi acik birakir: son baytta 2'lik, son ikide 3'luk, son
+// ucte 4'luk baslangic
+[[maybe_unused]] alignas(32) constexpr uint8_t kIncompleteMax[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+#if defined(BERKIDE_UTF8_SSE2)
+// OR 64 bytes together and test the sign bits once
+// 64 bayti birlikte OR'la ve isaret bitlerini bir kez sina
+bool isASCIISse2(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(data + i);
+        __m128i acc = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+                                   _mm_or_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+        if (_mm_movemask_epi8(acc)) return false;
+    }
+    for (; i + 16 <= size; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)))) return false;
+    }
+    return Utf8Scanner::isASCIIScalar(data + i, size - i);
+}
+
+// Count NULs per byte lane (a compare yields -1, subtracted into the lane), then sum the even
+// and odd lanes with SAD; lanes are flushed every 255 blocks before they can wrap
+// NUL'lari bayt seridi basina say (karsilastirma -1 verir, serit icinden cikarilir), sonra cift ve
+// tek seritleri SAD ile topla; seritler tasmadan once her 255 blokta bosaltilir
+void countNulsSse2(const uint8_t* data, size_t size, size_t& even, size_t& odd) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    size_t i = 0;
+    even = odd = 0;
+    while (i + 16 <= size) {
+        size_t end = i + std::min<size_t>((size - i) / 16, 255) * 16;
+        __m128i counts = zero;
+        for (; i < end; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(block, zero));
+        }
+        __m128i evenSum = _mm_sad_epu8(_mm_and_si128(counts, lowBytes), zero);
+        __m128i oddSum = _mm_sad_epu8(_mm_srli_epi16(counts, 8), zero);
+        even += static_cast<size_t>(_mm_cvtsi128_si32(evenSum) + _mm_cvtsi128_si32(_mm_srli_si128(evenSum, 8)));
+        odd += static_cast<size_t>(_mm_cvtsi128_si32(oddSum) + _mm_cvtsi128_si32(_mm_srli_si128(oddSum, 8)));
+    }
+    size_t tailEven = 0, tailOdd = 0;
+    Utf8Scanner::countNulsScalar(data + i, size - i, tailEven, tailOdd);
+    even += tailEven;
+    odd += tailOdd;
+}
+#endif
+
+#if defined(BERKIDE_UTF8_SSSE3)
+// One 16-byte step: ASCII blocks only check that the previous block did not end mid-sequence
+// Tek 16 baytlik adim: ASCII bloklar yalnizca onceki blogun bir dizinin ortasinda bitmedigini denetler
+BERKIDE_TARGET_SSSE3 inline void validateStepSsse3(__m128i in, __m128i& prev, __m128i& incomplete,
+                                                   __m128i& error) {
+    if (_mm_movemask_epi8(in) == 0) {
+        error = _mm_or_si128(error, incomplete);
+        prev = in;
+        return;
+    }
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i byte1High = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High));
+    const __m128i byte1Low = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low));
+    const __m128i byte2High = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High));
+
+    __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+    __m128i special = _mm_and_si128(
+        _mm_and_si128(_mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                      _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble))),
+        _mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+
+    // Bytes two and three after a 3- or 4-byte lead must be continuations
+    // 3 veya 4 baytlik bir baslangictan sonraki ikinci ve ucuncu baytlar devam bayti olmali
+    __m128i prev2 = _mm_alignr_epi8(in, prev, 14);
+    __m128i prev3 = _mm_alignr_epi8(in, prev, 13);
+    __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+    error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+
+    incomplete = _mm_subs_epu8(in, _mm_loadu_si128(reinterpret_cast<const __m128i*>(kIncompleteMax + 16)));
+    prev = in;
+}
+
+// Validate 16 bytes per step, checking the sequences still open at the end
+// Adim basina 16 bayt dogrula, sonda hala acik kalan dizileri denetle
+BERKIDE_TARGET_SSSE3 bool isValidUTF8Ssse3(const uint8_t* data, size_t size) {
+    __m128i prev = _mm_setzero_si128();
+    __m128i incomplete = _mm_setzero_si128();
+    __m128i error = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        validateStepSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), prev, incomplete, error);
+    }
+    // The tail is padded with NULs, which end any open sequence as an error
+    // Kuyruk NUL'larla doldurulur; acik kalan her dizi bunlarla hata olarak biter
+    if (i < size) {
+        alignas(16) uint8_t tail[16] = {};
+        std::memcpy(tail, data + i, size - i);
+        validateStepSsse3(_mm_load_si128(reinterpret_cast<const __m128i*>(tail)), prev, incomplete, error);
+    }
+    error = _mm_or_si128(error, incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+#endif
+
+#if defined(BERKIDE_UTF8_AVX2)
+// OR two 32-byte loads per step and test the high bits once
+// Adim basina iki 32 baytlik yuklemeyi OR'la ve yuksek bitleri bir kez sina
+BERKIDE_TARGET_AVX2 bool isASCIIAvx2(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const __m256i* p = reinterpret_cast<const __m256i*>(data + i);
+        __m256i acc = _mm256_or_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1));
+        if (_mm256_movemask_epi8(acc)) return false;
+    }
+    for (; i + 32 <= size; i += 32) {
+        if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)))) return false;
+    }
+    return Utf8Scanner::isASCIIScalar(data + i, size - i);
+}
+
+// The 16-byte step on two lanes; the bytes before each lane come from a cross-lane permute
+// Iki seritte 16 baytlik adim; her seritten onceki baytlar seritler arasi bir permute'tan gelir
+BERKIDE_TARGET_AVX2 inline void validateStepAvx2(__m256i in, __m256i& prev, __m256i& incomplete,
+                                                 __m256i& error) {
+    if (_mm256_movemask_epi8(in) == 0) {
+        error = _mm256_or_si256(error, incomplete);
+        prev = in;
+        return;
+    }
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i byte1High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High)));
+    const __m256i byte1Low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low)));
+    const __m256i byte2High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High)));
+
+    __m256i carried = _mm256_permute2x128_si256(prev, in, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(in, carried, 15);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(_mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                         _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+
+    __m256i prev2 = _mm256_alignr_epi8(in, carried, 14);
+    __m256i prev3 = _mm256_alignr_epi8(in, carried, 13);
+    __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+
+    incomplete = _mm256_subs_epu8(in, _mm256_load_si256(reinterpret_cast<const __m256i*>(kIncompleteMax)));
+    prev = in;
+}
+
+// Validate 32 bytes per step; the tail is padded with NULs as in the SSSE3 kernel
+// Adim basina 32 bayt dogrula; kuyruk SSSE3 cekirdegindeki gibi NUL'larla doldurulur
+BERKIDE_TARGET_AVX2 bool isValidUTF8Avx2(const uint8_t* data, size_t size) {
+    __m256i prev = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    __m256i error = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        validateStepAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), prev, incomplete, error);
+    }
+    if (i < size) {
+        alignas(32) uint8_t tail[32] = {};
+        std::memcpy(tail, data + i, size - i);
+        validateStepAvx2(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), prev, incomplete, error);
+    }
+    error = _mm256_or_si256(error, incomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+#endif
+
+using AsciiFn = bool (*)(const uint8_t*, size_t);
+using ValidFn = bool (*)(const uint8_t*, size_t);
+using NulFn = void (*)(const uint8_t*, size_t, size_t&, size_t&);
+
+// One implementation of each scan, with its name for kernelName()
+// kernelName() icin adiyla birlikte her taramanin bir uygulamasi
+struct Kernel {
+    AsciiFn ascii;
+    ValidFn valid;
+    NulFn nuls;
+    const char* name;
+};
+
+// Every kernel compiled into this build, widest first; the scalar one runs anywhere
+// Bu derlemeye giren her cekirdek, en genisi once; skaler olan her yerde calisir
+const Kernel kKernels[] = {
+#if defined(BERKIDE_UTF8_AVX2)
+    {isASCIIAvx2, isValidUTF8Avx2, countNulsSse2, "avx2"},
+#endif
+#if defined(BERKIDE_UTF8_SSSE3)
+    {isASCIISse2, isValidUTF8Ssse3, countNulsSse2, "ssse3"},
+#endif
+#if defined(BERKIDE_UTF8_SSE2)
+    {isASCIISse2, Utf8Scanner::isValidUTF8Scalar, countNulsSse2, "sse2"},
+#endif
+    {Utf8Scanner::isASCIIScalar, Utf8Scanner::isValidUTF8Scalar, Utf8Scanner::countNulsScalar, "scalar"},
+};
+
+// True if this CPU can run the kernel (MSVC only compiles the ones /arch allows)
+// Bu CPU cekirdegi calistirabiliyorsa true (MSVC yalnizca /arch'in izin verdiklerini derler)
+bool supported(const Kernel& k) {
+#if defined(__GNUC__) || defined(__clang__)
+    #if defined(BERKIDE_UTF8_AVX2)
+    if (std::strcmp(k.name, "avx2") == 0) return __builtin_cpu_supports("avx2");
+    #endif
+    #if defined(BERKIDE_UTF8_SSSE3)
+    if (std::strcmp(k.name, "ssse3") == 0) return __builtin_cpu_supports("ssse3");
+    #endif
+#endif
+    (void)k;
+    return true;
+}
+
+// Pick the widest kernels the CPU supports
+// CPU'nun destekledigi en genis cekirdekleri sec
+const Kernel* selectKernel() {
+    for (const Kernel& k : kKernels)
+        if (supported(k)) return &k;
+    return &kKernels[std::size(kKernels) - 1];
+}
+
+// Kernels chosen once per process, on first use; useKernel swaps them for tests and benchmarks
+// Surec basina bir kez, ilk kullanimda secilen cekirdekler; useKernel testler ve olcumler icin degistirir
+std::atomic<const Kernel*>& active() {
+    static std::atomic<const Kernel*> k{selectKernel()};
+    return k;
+}
+
+// Kernels the dispatchers call now
+// Yonlendiricilerin su an cagirdigi cekirdekler
+const Kernel& kernel() {
+    return *active().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+// Dispatch to the selected ASCII kernel
+// Secilen ASCII cekirdegine yonlendir
+bool Utf8Scanner::isASCII(const uint8_t* data, size_t size) {
+    return kernel().ascii(data, size);
+}
+
+// Dispatch to the selected validation kernel
+// Secilen dogrulama cekirdegine yonlendir
+bool Utf8Scanner::isValidUTF8(const uint8_t* data, size_t size) {
+    return kernel().valid(data, size);
+}
+
+// Dispatch to the selected NUL counting kernel
+// Secilen NUL sayma cekirdegine yonlendir
+void Utf8Scanner::countNuls(const uint8_t* data, size_t size, size_t& even, size_t& odd) {
+    kernel().nuls(data, size, even, odd);
+}
+
+// Byte by byte reference the SIMD kernels are checked against
+// SIMD cekirdeklerinin karsilastirildigi bayt bayt referans
+bool Utf8Scanner::isASCIIScalar(const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] >= 0x80) return false;
+    }
+    return true;
+}
+
+// Decode sequence by sequence, rejecting overlongs, surrogates and values past U+10FFFF
+// Dizi dizi coz; asiri uzunlari, vekilleri ve U+10FFFF otesi degerleri reddet
+bool Utf8Scanner::isValidUTF8Scalar(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        if (data[i] < 0x80) {
+            // ASCII byte
+            i++;
+        } else if ((data[i] & 0xE0) == 0xC0) {
+            // 2-byte sequence: 110xxxxx 10xxxxxx
+            if (i + 1 >= size) return false;
+            if ((data[i + 1] & 0xC0) != 0x80) return false;
+            // Overlong check: must be >= 0x80
+            uint32_t cp = ((data[i] & 0x1F) << 6) | (data[i + 1] & 0x3F);
+            if (cp < 0x80) return false;
+            i += 2;
+        } else if ((data[i] & 0xF0) == 0xE0) {
+            // 3-byte sequence: 1110xxxx 10xxxxxx 10xxxxxx
+            if (i + 2 >= size) return false;
+            if ((data[i + 1] & 0xC0) != 0x80) return false;
+            if ((data[i + 2] & 0xC0) != 0x80) return false;
+            uint32_t cp = ((data[i] & 0x0F) << 12) | ((data[i + 1] & 0x3F) << 6) | (data[i + 2] & 0x3F);
+            if (cp < 0x800) return false;
+            // Reject surrogates
+            if (cp >= 0xD800 && cp <= 0xDFFF) return false;
+            i += 3;
+        } else if ((data[i] & 0xF8) == 0xF0) {
+            // 4-byte sequence: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+            if (i + 3 >= size) return false;
+            if ((data[i + 1] & 0xC0) != 0x80) return false;
+            if ((data[i + 2] & 0xC0) != 0x80) return false;
+            if ((data[i + 3] & 0xC0) != 0x80) return false;
+            uint32_t cp = ((data[i] & 0x07) << 18) | ((data[i + 1] & 0x3F) << 12) |
+                          ((data[i + 2] & 0x3F) << 6) | (data[i + 3] & 0x3F);
+            if (cp < 0x10000 || cp > 0x10FFFF) return false;
+            i += 4;
+        } else {
+            // Invalid UTF-8 start byte
+            // Gecersiz UTF-8 baslangic bayti
+            return false;
+        }
+    }
+    return true;
+}
+
+// Count NUL bytes at even and odd offsets, byte by byte
+// Cift ve tek ofsetlerdeki NUL baytlarini bayt bayt say
+void Utf8Scanner::countNulsScalar(const uint8_t* data, size_t size, size_t& even, size_t& odd) {
+    even = odd = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] != 0) continue;
+        if (i % 2 == 0) even++;
+        else odd++;
+    }
+}
+
+// Report which kernel this process uses
+// Bu surecin kullandigi cekirdegi bildir
+const char* Utf8Scanner::kernelName() {
+    return kernel().name;
+}
+
+// List the kernels this CPU can run
+// Bu CPU'nun calistirabildigi cekirdekleri listele
+std::vector<const char*> Utf8Scanner::availableKernels() {
+    std::vector<const char*> names;
+    for (const Kernel& k : kKernels)
+        if (supported(k)) names.push_back(k.name);
+    return names;
+}
+
+// Switch every dispatcher to the named kernel if this CPU can run it
+// Bu CPU calistirabiliyorsa her yonlendiriciyi adi verilen cekirdege gecir
+bool Utf8Scanner::useKernel(const char* name) {
+    for (const Kernel& k : kKernels) {
+        if (std::strcmp(k.name, name) != 0 || !supported(k)) continue;
+        active().store(&k, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
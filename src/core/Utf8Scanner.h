@@ -0,0 +1,54 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Vectorized byte classification for encoding detection: ASCII check, UTF-8 validation and
+// NUL byte counting.
+// Kodlama algilama icin vektorlestirilmis bayt siniflandirma: ASCII denetimi, UTF-8 dogrulama
+// ve NUL bayt sayimi.
+// UTF-8 is validated with three nibble lookup tables over 16 or 32 bytes per step (no branch
+// per character); ASCII blocks skip the tables. AVX2 or SSSE3 is picked at runtime, SSE2 keeps
+// the ASCII path, and the scalar code is the fallback elsewhere.
+// UTF-8, adim basina 16 veya 32 bayt uzerinde uc yarim bayt arama tablosuyla dogrulanir
+// (karakter basina dal yok); ASCII bloklar tablolari atlar. AVX2 veya SSSE3 calisma zamaninda
+// secilir, SSE2 ASCII yolunu korur ve diger durumlarda skaler kod yedektir.
+class Utf8Scanner {
+public:
+    // True if every byte is below 0x80
+    // Her bayt 0x80'in altindaysa true
+    static bool isASCII(const uint8_t* data, size_t size);
+
+    // True if the bytes are well-formed UTF-8 (no overlongs, surrogates or values past U+10FFFF)
+    // Baytlar iyi bicimli UTF-8 ise true (asiri uzun, vekil veya U+10FFFF otesi deger yok)
+    static bool isValidUTF8(const uint8_t* data, size_t size);
+
+    // Count NUL bytes at even and at odd offsets (the UTF-16 byte order heuristic)
+    // Cift ve tek ofsetlerdeki NUL baytlari say (UTF-16 bayt sirasi bulussali)
+    static void countNuls(const uint8_t* data, size_t size, size_t& even, size_t& odd);
+
+    // Byte-at-a-time reference versions, used where no vector unit exists
+    // Bayt bayt referans surumler, vektor birimi olmayan yerlerde kullanilir
+    static bool isASCIIScalar(const uint8_t* data, size_t size);
+    static bool isValidUTF8Scalar(const uint8_t* data, size_t size);
+    static void countNulsScalar(const uint8_t* data, size_t size, size_t& even, size_t& odd);
+
+    // Name of the active kernel ("avx2", "ssse3", "sse2" or "scalar")
+    // Aktif cekirdegin adi ("avx2", "ssse3", "sse2" veya "scalar")
+    static const char* kernelName();
+
+    // Kernels this CPU can run, widest first ("scalar" is always last)
+    // Bu CPU'nun calistirabildigi cekirdekler, en genisi once ("scalar" her zaman sonda)
+    static std::vector<const char*> availableKernels();
+
+    // Use the named kernel from now on, for cross-checks and benchmarks; false if this CPU
+    // cannot run it
+    // Bundan sonra adi verilen cekirdegi kullan, capraz denetimler ve olcumler icin; bu CPU
+    // calistiramiyorsa false
+    static bool useKernel(const char* name);
+};
@@ -0,0 +1,409 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "WorkspaceSearch.h"
+#include "FileWatcher.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+std::mutex WorkspaceSearch::defaultsMutex_;
+std::vector<std::string> WorkspaceSearch::defaultIgnoreDirs_ = {".git"};
+std::atomic<uint64_t> WorkspaceSearch::defaultMaxFileSize_{8ull * 1024 * 1024};
+
+// Directory names walks skip unless a query names its own
+// Bir sorgu kendininkini belirtmedikce gezintilerin atladigi dizin adlari
+void WorkspaceSearch::setDefaultIgnoreDirs(const std::vector<std::string>& dirs) {
+    std::lock_guard<std::mutex> lock(defaultsMutex_);
+    defaultIgnoreDirs_ = dirs;
+}
+
+// Copy of the current ignore list, safe to read from any thread
+// Gecerli yok sayma listesinin kopyasi, her thread'den okunabilir
+std::vector<std::string> WorkspaceSearch::defaultIgnoreDirs() {
+    std::lock_guard<std::mutex> lock(defaultsMutex_);
+    return defaultIgnoreDirs_;
+}
+
+// Size past which files are skipped unless a query sets its own (0 = no limit)
+// Bir sorgu kendininkini ayarlamadikca dosyalarin atlandigi boyut (0 = sinir yok)
+void WorkspaceSearch::setDefaultMaxFileSize(uint64_t bytes) {
+    defaultMaxFileSize_ = bytes;
+}
+
+// Current default size limit in bytes
+// Bayt cinsinden gecerli varsayilan boyut siniri
+uint64_t WorkspaceSearch::defaultMaxFileSize() {
+    return defaultMaxFileSize_;
+}
+
+namespace {
+
+// What listing one directory produced
+// Bir dizini listelemenin urettikleri
+struct Listing {
+    std::vector<std::string> dirs;
+    std::vector<WorkspaceFile> files;
+    int skipped = 0;
+};
+
+// Same rule as SearchEngine: only the default (linear-time) engine, whole words by \b
+// SearchEngine ile ayni kural: yalnizca varsayilan (dogrusal zamanli) motor, tam sozcukler \b ile
+std::unique_ptr<RegexEngine> compileRegex(const std::string& pattern, const SearchOptions& opts) {
+    auto re = RegexEngine::create();
+    const std::string source = opts.wholeWord ? "\\b(?:" + pattern + ")\\b" : pattern;
+    if (!re->compile(source, opts.caseSensitive)) {
+        LOG_WARN("[WorkspaceSearch] Invalid regex: ", re->lastError());
+        return nullptr;
+    }
+    return re;
+}
+
+// Line text shown with a match, cut at kPreviewBytes
+// Bir eslemeyle gosterilen satir metni, kPreviewBytes'ta kesilir
+std::string preview(std::string_view line) {
+    return std::string(line.substr(0, WorkspaceSearch::kPreviewBytes));
+}
+
+// Append up to room matches in one line (no '\n', trailing '\r' already dropped)
+// Bir satirdaki en fazla room eslemeyi ekle ('\n' yok, sondaki '\r' zaten atildi)
+size_t searchLine(std::string_view line, int lineNo, const std::string& path, const LiteralMatcher& lit,
+                  const RegexEngine* re, std::vector<WorkspaceMatch>& out, size_t room) {
+    size_t added = 0;
+    size_t from = 0;
+    while (added < room && from <= line.size()) {
+        int col, len;
+        if (re) {
+            if (!re->find(line, static_cast<int>(from), col, len)) break;
+        } else {
+            size_t pos = lit.find(line, from);
+            if (pos == LiteralMatcher::npos) break;
+            col = static_cast<int>(pos);
+            len = static_cast<int>(lit.size());
+        }
+        if (added == 0) out.push_back({path, lineNo, col, lineNo, col + len, len, preview(line)});
+        else out.push_back({path, lineNo, col, lineNo, col + len, len, out.back().text});
+        ++added;
+        from = static_cast<size_t>(col) + std::max(1, len);
+    }
+    return added;
+}
+
+// A literal runs over the whole text; lines are counted with memchr only up to each hit, so
+// lines without a match cost nothing but the matcher's own scan
+// Literal tum metin uzerinde calisir; satirlar memchr ile yalnizca her isabete kadar sayilir,
+// boylece eslemesi olmayan satirlar eslestiricinin kendi taramasindan baska bir sey tutmaz
+size_t searchTextLiteral(std::string_view text, const std::string& path, const LiteralMatcher& lit,
+                         std::vector<WorkspaceMatch>& out, size_t room) {
+    size_t added = 0;
+    size_t from = 0;
+    size_t lineStart = 0;
+    int lineNo = 0;
+    int lastLine = -1;
+    while (added < room) {
+        size_t pos = lit.find(text, from);
+        if (pos == LiteralMatcher::npos) break;
+        for (const char* nl; (nl = static_cast<const char*>(
+                 std::memchr(text.data() + lineStart, '\n', pos - lineStart))) != nullptr;) {
+            lineStart = static_cast<size_t>(nl - text.data()) + 1;
+            ++lineNo;
+        }
+        const int col = static_cast<int>(pos - lineStart);
+        const int len = static_cast<int>(lit.size());
+        if (lineNo != lastLine) {
+            const char* nl = static_cast<const char*>(
+                std::memchr(text.data() + lineStart, '\n', text.size() - lineStart));
+            size_t lineEnd = nl ? static_cast<size_t>(nl - text.data()) : text.size();
+            if (lineEnd > lineStart && text[lineEnd - 1] == '\r') --lineEnd;
+            out.push_back({path, lineNo, col, lineNo, col + len, len, preview(text.substr(lineStart, lineEnd - lineStart))});
+            lastLine = lineNo;
+        } else {
+            out.push_back({path, lineNo, col, lineNo, col + len, len, out.back().text});
+        }
+        ++added;
+        from = pos + std::max<size_t>(1, lit.size());
+    }
+    return added;
+}
+
+// A regex runs line by line, the way the editor's own search does
+// Regex, editorun kendi aramasi gibi satir satir calisir
+size_t searchTextLines(std::string_view text, const std::string& path, const RegexEngine& re,
+                       std::vector<WorkspaceMatch>& out, size_t room, const std::function<bool()>& stopped) {
+    const LiteralMatcher none;
+    size_t added = 0;
+    size_t lineStart = 0;
+    for (int lineNo = 0; lineStart <= text.size() && added < room; ++lineNo) {
+        if ((lineNo & 1023) == 1023 && stopped()) break;
+        const char* nl = lineStart < text.size() ? static_cast<const char*>(
+            std::memchr(text.data() + lineStart, '\n', text.size() - lineStart)) : nullptr;
+        size_t lineEnd = nl ? static_cast<size_t>(nl - text.data()) : text.size();
+        const size_t next = lineEnd + 1;
+        if (lineEnd > lineStart && text[lineEnd - 1] == '\r') --lineEnd;
+        added += searchLine(text.substr(lineStart, lineEnd - lineStart), lineNo, path, none, &re, out, room - added);
+        if (!nl || next == text.size()) break;  // A final newline ends the last line / Son yeni satir son satiri bitirir
+        lineStart = next;
+    }
+    return added;
+}
+
+} // namespace
+
+// A NUL in the first kBinaryProbeBytes marks a file as binary
+// Ilk kBinaryProbeBytes icindeki bir NUL dosyayi ikili olarak isaretler
+bool WorkspaceSearch::isBinary(std::string_view text) {
+    return !text.empty() && std::memchr(text.data(), '\0', std::min(text.size(), kBinaryProbeBytes));
+}
+
+// A file shrunk since it was listed yields what is left; one that grew is read up to its
+// listed size, so a file being written cannot push the buffer past the size limit
+// Listelendikten sonra kuculen bir dosya kalani verir; buyuyen biri listelenen boyutuna kadar
+// okunur, boylece yazilmakta olan bir dosya tamponu boyut sinirinin otesine itemez
+bool WorkspaceSearch::readText(const std::string& path, uint64_t size, std::string& buffer,
+                               std::string_view& text) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    buffer.resize(static_cast<size_t>(size));
+    size_t got = 0;
+    while (got < buffer.size()) {
+        size_t n = std::fread(buffer.data() + got, 1, buffer.size() - got, f);
+        if (n == 0) break;
+        got += n;
+    }
+    const bool failed = std::ferror(f) != 0;
+    std::fclose(f);
+    buffer.resize(got);
+    text = buffer;
+    return !failed;
+}
+
+// Each level is one parallelFor whose first tasks list the level's directories and whose
+// remaining tasks hand over the files the previous level listed
+// Her seviye, ilk gorevleri seviyenin dizinlerini listeleyen ve kalan gorevleri onceki seviyenin
+// listeledigi dosyalari teslim eden tek bir parallelFor'dur
+int WorkspaceSearch::walk(const std::string& root, const std::vector<std::string>& ignoreDirs,
+                          const std::function<void(const WorkspaceFile& file, int slot)>& onFile,
+                          const std::function<bool()>& stopped) {
+    auto list = [&](const std::string& dir, Listing& out) {
+        std::error_code err;
+        fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, err);
+        for (; !err && it != fs::directory_iterator(); it.increment(err)) {
+            const fs::directory_entry& entry = *it;
+            if (FileWatcher::isIgnoredName(entry.path().filename().string(), ignoreDirs)) continue;
+            std::error_code e;
+            const fs::file_status link = entry.symlink_status(e);
+            if (e) continue;
+            if (fs::is_directory(link)) {
+                out.dirs.push_back(entry.path().string());
+            } else if (entry.is_regular_file(e)) {
+                // Symbolic links to files are searched, links to directories are not followed
+                // Dosyalara giden sembolik baglantilar aranir, dizinlere gidenler izlenmez
+                const uint64_t size = entry.file_size(e);
+                if (e) ++out.skipped;
+                else out.files.push_back({entry.path().string(), size});
+            }
+        }
+    };
+
+    ThreadPool& pool = ThreadPool::shared();
+    int skipped = 0;
+    std::vector<std::string> dirs = {root};
+    std::vector<WorkspaceFile> files;
+    while ((!dirs.empty() || !files.empty()) && !(stopped && stopped())) {
+        std::vector<Listing> listings(dirs.size());
+        const int dirTasks = static_cast<int>(dirs.size());
+        pool.parallelFor(dirTasks + static_cast<int>(files.size()), [&](int task, int slot) {
+            if (stopped && stopped()) return;
+            if (task < dirTasks) list(dirs[task], listings[task]);
+            else onFile(files[task - dirTasks], slot);
+        });
+        dirs.clear();
+        files.clear();
+        for (Listing& l : listings) {
+            dirs.insert(dirs.end(), std::make_move_iterator(l.dirs.begin()), std::make_move_iterator(l.dirs.end()));
+            files.insert(files.end(), std::make_move_iterator(l.files.begin()), std::make_move_iterator(l.files.end()));
+            skipped += l.skipped;
+        }
+    }
+    return skipped;
+}
+
+// Files are searched as walk() hands them over (or, for query.files, in one parallelFor).
+// Matches of a file are collected apart and handed over under one mutex, which trims them to
+// maxResults, batches them and calls onBatch, so delivery is serialized and the limit is exact.
+// Dosyalar walk() teslim ettikce (veya query.files icin tek bir parallelFor'da) aranir. Bir
+// dosyanin eslemeleri ayri toplanir ve tek bir mutex altinda teslim edilir; bu mutex onlari
+// maxResults'a kirpar, gruplar ve onBatch'i cagirir, boylece teslim siralanir ve sinir tamdir.
+WorkspaceStats WorkspaceSearch::run(const WorkspaceQuery& query, std::vector<WorkspaceMatch>* results) const {
+    WorkspaceStats stats;
+    std::error_code ec;
+    const fs::path root = fs::weakly_canonical(fs::path(query.root.empty() ? "." : query.root), ec);
+    if (query.pattern.empty() || ec || !fs::is_directory(root, ec)) return stats;
+
+    std::unique_ptr<RegexEngine> probe;
+    if (query.opts.regex && !(probe = compileRegex(query.pattern, query.opts))) return stats;
+    const LiteralMatcher lit = query.opts.regex
+        ? LiteralMatcher()
+        : LiteralMatcher(query.pattern, query.opts.caseSensitive, query.opts.wholeWord);
+    // Searches are single-line: a literal holding a line break can match nothing
+    // Aramalar tek satirlidir: satir sonu tutan bir literal hicbir seyle eslesemez
+    if (!query.opts.regex && query.pattern.find_first_of("\r\n") != std::string::npos) return stats;
+
+    const std::vector<std::string> ignore = query.ignoreDirs.empty() ? defaultIgnoreDirs() : query.ignoreDirs;
+    const uint64_t maxSize = query.maxFileSize > 0 ? query.maxFileSize : defaultMaxFileSize();
+    const size_t limit = query.maxResults > 0 ? static_cast<size_t>(query.maxResults) : SIZE_MAX;
+
+    std::unordered_map<std::string, const BufferSnapshot*> overrides;
+    for (const auto& [path, snap] : query.overrides) {
+        fs::path p = fs::weakly_canonical(fs::path(path), ec);
+        if (!ec) overrides.emplace(p.string(), &snap);
+    }
+    std::mutex overridesMutex;
+    std::unordered_set<std::string> overridesDone;
+
+    const uint64_t generation = cancelGeneration_;
+    std::atomic<bool> full{false};
+    auto cancelled = [&]() {
+        return (query.cancel && query.cancel->load()) || cancelGeneration_ != generation;
+    };
+    const std::function<bool()> stopped = [&]() { return full.load() || cancelled(); };
+
+    std::mutex emitMutex;
+    std::vector<WorkspaceMatch> pending;
+    size_t delivered = 0;
+    auto lastFlush = std::chrono::steady_clock::now();
+    auto flush = [&]() {
+        if (pending.empty()) return;
+        if (results) results->insert(results->end(), pending.begin(), pending.end());
+        if (query.onBatch) query.onBatch(std::move(pending));
+        pending.clear();
+        lastFlush = std::chrono::steady_clock::now();
+    };
+    auto deliver = [&](std::vector<WorkspaceMatch>& found, bool skipped) {
+        std::lock_guard<std::mutex> lock(emitMutex);
+        if (skipped) {
+            ++stats.skipped;
+            return;
+        }
+        ++stats.files;
+        if (found.empty() || full) return;
+        const size_t take = std::min(found.size(), limit - delivered);
+        ++stats.filesMatched;
+        delivered += take;
+        pending.insert(pending.end(), std::make_move_iterator(found.begin()),
+                       std::make_move_iterator(found.begin() + take));
+        if (delivered >= limit) {
+            full = true;
+            stats.truncated = true;
+        }
+        if (pending.size() >= kBatchMatches ||
+            std::chrono::steady_clock::now() - lastFlush >= std::chrono::milliseconds(kBatchMillis)) {
+            flush();
+        }
+    };
+    auto room = [&]() {
+        std::lock_guard<std::mutex> lock(emitMutex);
+        return limit - delivered;
+    };
+
+    const int slots = ThreadPool::shared().size() + 1;
+    std::vector<std::unique_ptr<RegexEngine>> engines(slots);
+    std::vector<std::string> readBuffers(slots);
+    auto engineFor = [&](int slot) -> const RegexEngine* {
+        if (!query.opts.regex) return nullptr;
+        auto& re = engines[slot];
+        if (!re) re = compileRegex(query.pattern, query.opts);
+        return re.get();
+    };
+
+    auto searchSnapshot = [&](const std::string& path, const BufferSnapshot& snap, int slot) {
+        const RegexEngine* re = engineFor(slot);
+        const size_t cap = room();
+        std::vector<WorkspaceMatch> found;
+        snap.forEachChunk(0, snap.lineCount(), [&](int firstLine, const std::string_view* lines, int n) {
+            for (int i = 0; i < n && found.size() < cap; ++i) {
+                searchLine(lines[i], firstLine + i, path, lit, re, found, cap - found.size());
+            }
+            return found.size() < cap && !stopped();
+        });
+        deliver(found, false);
+    };
+
+    auto searchFile = [&](const WorkspaceFile& file, int slot) {
+        if (!overrides.empty()) {
+            auto it = overrides.find(file.path);
+            if (it != overrides.end()) {
+                {
+                    std::lock_guard<std::mutex> lock(overridesMutex);
+                    overridesDone.insert(file.path);
+                }
+                searchSnapshot(file.path, *it->second, slot);
+                return;
+            }
+        }
+        std::vector<WorkspaceMatch> found;
+        if (file.size > maxSize) {
+            deliver(found, true);
+            return;
+        }
+        std::string_view text;
+        if (!readText(file.path, file.size, readBuffers[slot], text) || isBinary(text)) {
+            deliver(found, true);
+            return;
+        }
+        if (text.size() >= 3 && std::memcmp(text.data(), "\xEF\xBB\xBF", 3) == 0) text.remove_prefix(3);
+        const size_t cap = room();
+        if (cap > 0) {
+            if (const RegexEngine* re = engineFor(slot)) searchTextLines(text, file.path, *re, found, cap, stopped);
+            else searchTextLiteral(text, file.path, lit, found, cap);
+        }
+        deliver(found, false);
+    };
+
+    if (query.files) {
+        const std::vector<std::string>& files = *query.files;
+        ThreadPool::shared().parallelFor(static_cast<int>(files.size()), [&](int task, int slot) {
+            if (stopped()) return;
+            std::error_code err;
+            const uint64_t size = fs::file_size(files[task], err);
+            std::vector<WorkspaceMatch> none;
+            if (err) deliver(none, true);
+            else searchFile({files[task], size}, slot);
+        });
+    } else {
+        const int skipped = walk(root.string(), ignore, searchFile, stopped);
+        std::lock_guard<std::mutex> lock(emitMutex);
+        stats.skipped += skipped;
+    }
+
+    // Unsaved buffers under the root whose file the walk did not reach (not on disk yet)
+    // Gezintinin dosyasina ulasmadigi (henuz diskte olmayan) kok altindaki kaydedilmemis buffer'lar
+    for (const auto& [path, snap] : overrides) {
+        if (stopped()) break;
+        if (overridesDone.count(path)) continue;
+        const fs::path rel = fs::path(path).lexically_relative(root);
+        if (rel.empty() || *rel.begin() == "..") continue;
+        bool ignored = false;
+        for (const auto& segment : rel) ignored = ignored || FileWatcher::isIgnoredName(segment.string(), ignore);
+        if (ignored || fs::is_directory(path, ec)) continue;
+        if (fs::exists(path, ec) && !fs::is_regular_file(path, ec)) continue;
+        searchSnapshot(path, *snap, 0);
+    }
+
+    std::lock_guard<std::mutex> lock(emitMutex);
+    flush();
+    stats.matches = static_cast<int>(delivered);
+    stats.cancelled = cancelled() && !stats.truncated;
+    return stats;
+}
@@ -0,0 +1,153 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include "BufferSnapshot.h"
+#include "SearchEngine.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+// One match of a workspace search
+// Bir calisma alani aramasinin tek eslemesi
+struct WorkspaceMatch {
+    std::string path;            // File the match is in / Eslemenin oldugu dosya
+    int line = 0, col = 0;       // Start (0-based, columns in bytes) / Baslangic (0 tabanli, sutunlar bayt)
+    int endLine = 0, endCol = 0; // End / Bitis
+    int length = 0;              // Length in bytes / Bayt cinsinden uzunluk
+    std::string text;            // The line the match starts on, cut at kPreviewBytes / Eslemenin basladigi satir, kPreviewBytes'ta kesilir
+};
+
+// A file found by WorkspaceSearch::walk
+// WorkspaceSearch::walk'un buldugu bir dosya
+struct WorkspaceFile {
+    std::string path;
+    uint64_t size = 0;
+};
+
+// What a workspace search went through
+// Bir calisma alani aramasinin uzerinden gectikleri
+struct WorkspaceStats {
+    int files = 0;               // Files searched / Aranan dosyalar
+    int filesMatched = 0;        // Files with at least one match / En az bir eslemesi olan dosyalar
+    int skipped = 0;             // Too large, binary or unreadable / Cok buyuk, ikili veya okunamaz
+    int matches = 0;             // Matches delivered / Iletilen eslemeler
+    bool truncated = false;      // Stopped at maxResults / maxResults'ta durdu
+    bool cancelled = false;      // Stopped by cancel / Iptal ile durdu
+};
+
+// A search over the files of a directory tree
+// Bir dizin agacinin dosyalari uzerinde arama
+struct WorkspaceQuery {
+    std::string root;                            // Directory to search / Aranacak dizin
+    std::string pattern;
+    SearchOptions opts;                          // multiline is not supported here / multiline burada desteklenmez
+    int maxResults = 0;                          // Stop after this many matches, 0 = all / Bu kadar eslemeden sonra dur, 0 = hepsi
+    uint64_t maxFileSize = 0;                    // Skip larger files, 0 = defaultMaxFileSize() / Daha buyuk dosyalari atla, 0 = defaultMaxFileSize()
+    std::vector<std::string> ignoreDirs;         // Names skipped anywhere, empty = defaultIgnoreDirs() / Her yerde atlanan isimler, bos = defaultIgnoreDirs()
+    // Unsaved buffers, searched instead of the file at their path
+    // Kaydedilmemis buffer'lar, yollarindaki dosya yerine aranir
+    std::vector<std::pair<std::string, BufferSnapshot>> overrides;
+    const std::atomic<bool>* cancel = nullptr;   // Stop early once set / Ayarlandiginda erken dur
+    // Search only these files (absolute paths, e.g. TrigramIndex candidates) instead of walking
+    // root; unsaved buffers under root are still searched
+    // root'u gezmek yerine yalnizca bu dosyalari ara (mutlak yollar, orn. TrigramIndex adaylari);
+    // root altindaki kaydedilmemis buffer'lar yine aranir
+    const std::vector<std::string>* files = nullptr;
+    // Matches as they are found, in batches; called from worker threads, one call at a time
+    // Bulundukca eslemeler, gruplar halinde; calisan thread'lerden, her seferinde bir cagri
+    std::function<void(std::vector<WorkspaceMatch>&& batch)> onBatch;
+};
+
+// Project-wide search (grep) over the files under a directory.
+// Bir dizin altindaki dosyalar uzerinde proje geneli arama (grep).
+// The tree is walked one directory level at a time: the directories of a level are listed in
+// parallel on ThreadPool::shared(), then the files they hold are searched in parallel, so
+// results start flowing before the walk is over. Directory names in ignoreDirs are skipped
+// with the same rule as FileWatcher::setIgnoreDirs, symbolic links to directories are not
+// followed and files with a NUL byte in their first 8 KB are taken as binary and skipped.
+// Agac her seferinde bir dizin seviyesi gezilir: bir seviyenin dizinleri
+// ThreadPool::shared() uzerinde paralel listelenir, sonra tuttuklari dosyalar paralel aranir;
+// boylece sonuclar gezinti bitmeden akmaya baslar. ignoreDirs'teki dizin isimleri
+// FileWatcher::setIgnoreDirs ile ayni kuralla atlanir, dizinlere giden sembolik baglantilar
+// izlenmez ve ilk 8 KB'inda NUL bayti olan dosyalar ikili sayilip atlanir.
+// Files are read into a per-thread buffer rather than mapped, so one truncated by another
+// process mid-search reads short instead of faulting. A literal runs over the whole text with LiteralMatcher and lines are counted only up to each
+// hit, a regex runs line by line. Matches within a file are in order, files come in no
+// particular order.
+// Dosyalar eslenmek yerine thread basina bir tampona okunur, boylece arama sirasinda baska bir
+// surec tarafindan kesilen bir dosya hata vermek yerine kisa okunur. Literal
+// LiteralMatcher ile tum metin uzerinde calisir ve satirlar yalnizca her isabete kadar sayilir,
+// regex satir satir calisir. Bir dosyadaki eslemeler siralidir, dosyalar belirli bir sirayla gelmez.
+class WorkspaceSearch {
+public:
+    // Run a search and return once it is over; matches go to query.onBatch, and also to
+    // results when it is not null
+    // Bir arama calistir ve bitince don; eslemeler query.onBatch'e, results null degilse oraya da gider
+    WorkspaceStats run(const WorkspaceQuery& query, std::vector<WorkspaceMatch>* results = nullptr) const;
+
+    // Stop every search running now (later searches are not affected)
+    // Su anda calisan her aramayi durdur (sonraki aramalar etkilenmez)
+    void cancel() { ++cancelGeneration_; }
+
+    // Walk root level by level on ThreadPool::shared(), handing every regular file to onFile
+    // from the worker threads (slot as in ThreadPool::parallelFor); names in ignoreDirs and
+    // symbolic links to directories are skipped. Returns the files whose size could not be read.
+    // root'u ThreadPool::shared() uzerinde seviye seviye gez, her normal dosyayi calisan
+    // thread'lerden onFile'a ver (slot ThreadPool::parallelFor'daki gibi); ignoreDirs'teki isimler
+    // ve dizinlere giden sembolik baglantilar atlanir. Boyutu okunamayan dosyalari dondurur.
+    static int walk(const std::string& root, const std::vector<std::string>& ignoreDirs,
+                    const std::function<void(const WorkspaceFile& file, int slot)>& onFile,
+                    const std::function<bool()>& stopped = {});
+
+    // Contents of a file of the given size, read into buffer (which can be reused across
+    // files); false if it cannot be read
+    // Verilen boyuttaki bir dosyanin buffer'a okunmus icerigi (dosyalar arasinda yeniden
+    // kullanilabilir); okunamazsa false
+    static bool readText(const std::string& path, uint64_t size, std::string& buffer,
+                         std::string_view& text);
+
+    // True if text has a NUL byte in its first kBinaryProbeBytes
+    // text'in ilk kBinaryProbeBytes baytinda NUL varsa true
+    static bool isBinary(std::string_view text);
+
+    // Directory names skipped when a query names none
+    // Sorgu hic isim vermediginde atlanan dizin isimleri
+    static void setDefaultIgnoreDirs(const std::vector<std::string>& dirs);
+    static std::vector<std::string> defaultIgnoreDirs();
+
+    // Largest file searched when a query sets no limit (0 = no limit)
+    // Sorgu sinir koymadiginda aranan en buyuk dosya (0 = sinirsiz)
+    static void setDefaultMaxFileSize(uint64_t bytes);
+    static uint64_t defaultMaxFileSize();
+
+    // Matches handed to onBatch at once (a batch also goes out once a file finishes after
+    // kBatchMillis without one)
+    // onBatch'e tek seferde verilen eslemeler (kBatchMillis boyunca grup gitmediyse bir dosya
+    // bittiginde de bir grup gider)
+    static constexpr size_t kBatchMatches = 256;
+    static constexpr int kBatchMillis = 100;
+
+    // Longest line preview kept in WorkspaceMatch::text
+    // WorkspaceMatch::text'te tutulan en uzun satir onizlemesi
+    static constexpr size_t kPreviewBytes = 256;
+
+    // Bytes looked at for a NUL when telling binary files apart
+    // Ikili dosyalari ayirt ederken NUL icin bakilan baytlar
+    static constexpr size_t kBinaryProbeBytes = 8192;
+
+private:
+    std::atomic<uint64_t> cancelGeneration_{0};  // Bumped by cancel() / cancel() ile artar
+
+    static std::mutex defaultsMutex_;
+    static std::vector<std::string> defaultIgnoreDirs_;
+    static std::atomic<uint64_t> defaultMaxFileSize_;
+};
@@ -4,6 +4,9 @@
 // See LICENSE file in the project root for full license text.
 
 #include "buffer.h"
+#include "BufferSnapshot.h"
+#include <algorithm>
+#include <numeric>
 
 // Default constructor: PieceTable initializes with one empty line
 // Varsayilan kurucu: PieceTable tek bir bos satirla baslatilir
@@ -15,31 +18,46 @@ Buffer::Buffer() {
 // Insert a character at the given line and column position
 // Verilen satir ve sutun konumuna bir karakter ekle
 void Buffer::insertChar(int line, int col, char c) {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (!pt_.isValidPos(line, col)) return;
+    ++version_;
+    columns_.invalidateLine(line);
+    noteLines(line, 1, 1);
     pt_.getLineRef(line).insert(col, 1, c);
 }
 
 // Delete a single character at the given line and column
 // Verilen satir ve sutundaki tek bir karakteri sil
 void Buffer::deleteChar(int line, int col) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Validate on a view: getLineRef detaches a line shared with snapshots (copy-on-write)
+    // Bir gorunum uzerinde dogrula: getLineRef anlik goruntulerle paylasilan satiri ayirir (yazimda kopyala)
     if (line < 0 || line >= pt_.lineCount()) return;
-    auto& l = pt_.getLineRef(line);
-    if (col < 0 || col >= static_cast<int>(l.size())) return;
-    l.erase(col, 1);
+    if (col < 0 || col >= static_cast<int>(pt_.lineView(line).size())) return;
+    ++version_;
+    columns_.invalidateLine(line);
+    noteLines(line, 1, 1);
+    pt_.getLineRef(line).erase(col, 1);
 }
 
 // Insert a text string at the given line and column position (handles newlines)
 // Verilen satir ve sutun konumuna bir metin dizesi ekle (yeni satirlari isler)
 void Buffer::insertText(int line, int col, const std::string& text) {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (!pt_.isValidPos(line, col)) return;
+    ++version_;
 
     // Simple case: no newlines, just insert inline
     // Basit durum: yeni satir yok, sadece satir icine ekle
     size_t nlPos = text.find('\n');
     if (nlPos == std::string::npos) {
+        columns_.invalidateLine(line);
+        noteLines(line, 1, 1);
         pt_.getLineRef(line).insert(col, text);
         return;
     }
+    columns_.invalidateFrom(line);
+    noteLines(line, 1, 1 + static_cast<int>(std::count(text.begin(), text.end(), '\n')));
 
     // Multi-line insert: split text at newlines
     // Cok satirli ekleme: metni yeni satirlarda bol
@@ -78,28 +96,220 @@ void Buffer::insertText(int line, int col, const std::string& text) {
 // Delete text in a range from (lineStart, colStart) to (lineEnd, colEnd)
 // (lineStart, colStart) ile (lineEnd, colEnd) arasindaki metni sil
 void Buffer::deleteRange(int lineStart, int colStart, int lineEnd, int colEnd) {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (lineStart < 0 || lineEnd >= pt_.lineCount() || lineStart > lineEnd) return;
+    ++version_;
+    eraseRange(lineStart, colStart, lineEnd, colEnd);
+}
 
+// Join the head of the first line with the tail of the last and drop the lines between in one step
+// Ilk satirin basini son satirin kuyruguyla birlestir ve aradaki satirlari tek adimda at
+void Buffer::eraseRange(int lineStart, int colStart, int lineEnd, int colEnd) {
+    noteLines(lineStart, lineEnd - lineStart + 1, 1);
     if (lineStart == lineEnd) {
+        columns_.invalidateLine(lineStart);
         auto& l = pt_.getLineRef(lineStart);
         l.erase(colStart, colEnd - colStart);
     } else {
+        columns_.invalidateFrom(lineStart);
         std::string head = pt_.getLine(lineStart).substr(0, colStart);
         std::string tail = pt_.getLine(lineEnd).substr(colEnd);
         pt_.setLine(lineStart, head + tail);
+        pt_.eraseLines(lineStart + 1, lineEnd - lineStart);
+    }
+}
+
+// Seal first, then cut: the snapshot is O(1) and shares all storage with the table
+// Once muhurle, sonra kes: anlik goruntu O(1)'dir ve tum depolamayi tabloyla paylasir
+std::shared_ptr<const PieceTable> Buffer::cutRange(int lineStart, int colStart, int lineEnd, int colEnd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!pt_.isValidPos(lineStart, colStart) || !pt_.isValidPos(lineEnd, colEnd)) return nullptr;
+    if (lineStart > lineEnd || (lineStart == lineEnd && colStart > colEnd)) return nullptr;
+    ++version_;
+    auto before = pt_.snapshot();
+    eraseRange(lineStart, colStart, lineEnd, colEnd);
+    return before;
+}
+
+// The current line holds prefix + suffix where the cut happened; rebuild the edges around it
+// and splice the middle lines
+// Kesimin oldugu yerde mevcut satir onek + sonek tutar; kenarlari onun etrafinda yeniden kur
+// ve ortadaki satirlari ekle
+void Buffer::restoreRange(const PieceTable& from, int lineStart, int colStart, int lineEnd, int colEnd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!pt_.isValidPos(lineStart, colStart)) return;
+    ++version_;
+
+    std::string_view first = from.lineView(lineStart);
+    std::string_view last = from.lineView(lineEnd);
+    size_t headFrom = std::min<size_t>(colStart, first.size());
+    noteLines(lineStart, 1, lineEnd - lineStart + 1);
+    if (lineStart == lineEnd) {
+        columns_.invalidateLine(lineStart);
+        size_t end = std::max(headFrom, std::min<size_t>(colEnd, first.size()));
+        pt_.getLineRef(lineStart).insert(colStart, first.substr(headFrom, end - headFrom));
+        return;
+    }
+
+    std::string cur = pt_.getLine(lineStart);
+    std::string suffix = cur.substr(colStart);
+    cur.resize(colStart);
+    cur.append(first.substr(headFrom));
+    std::string tail(last.substr(0, std::min<size_t>(colEnd, last.size())));
+    tail += suffix;
+
+    columns_.invalidateFrom(lineStart);
+    pt_.setLine(lineStart, cur);
+    pt_.insertLinesFrom(lineStart + 1, from, lineStart + 1, lineEnd - lineStart - 1);
+    pt_.insertLineAt(lineEnd, tail);
+}
+
+// Validate and order the whole batch first, then splice bottom to top so earlier ranges stay put
+// Once tum grubu dogrula ve sirala, sonra alttan uste ekle ki onceki araliklar yerinde kalsin
+bool Buffer::applyEdits(const std::vector<TextEdit>& input, std::vector<AppliedEdit>* applied, ColumnUnit unit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int lines = pt_.lineCount();
 
-        // Delete lines from lineEnd down to lineStart+1 (reverse to keep indices stable)
-        // lineEnd'den lineStart+1'e satirlari sil (indekslerin kararli kalmasi icin tersten)
-        for (int i = lineEnd; i > lineStart; --i) {
-            pt_.deleteLine(i);
+    // Clamp and convert other units to bytes first; negative positions are left for validation
+    // Once diger birimleri sinirla ve bayta donustur; negatif konumlar dogrulamaya birakilir
+    std::vector<TextEdit> converted;
+    if (unit != ColumnUnit::Byte) {
+        auto toBytes = [&](int& line, int& col) {
+            if (line < 0 || col < 0) return;
+            if (line >= lines) {
+                line = lines - 1;
+                col = pt_.columnCount(line);
+                return;
+            }
+            const ColumnIndex::Line* cols = columns_.find(line, columns_.tabWidth());
+            if (!cols) cols = &columns_.build(line, pt_.lineView(line), columns_.tabWidth());
+            col = cols->convert(col, unit, ColumnUnit::Byte);
+        };
+        converted = input;
+        for (auto& e : converted) {
+            toBytes(e.startLine, e.startCol);
+            toBytes(e.endLine, e.endCol);
         }
     }
+    const std::vector<TextEdit>& edits = unit == ColumnUnit::Byte ? input : converted;
+
+    // Validate every range against the current text
+    // Her araligi mevcut metne gore dogrula
+    for (const auto& e : edits) {
+        if (e.startLine < 0 || e.endLine >= lines || e.startCol < 0 || e.endCol < 0) return false;
+        if (e.startLine > e.endLine || (e.startLine == e.endLine && e.startCol > e.endCol)) return false;
+        if (e.startCol > pt_.columnCount(e.startLine) || e.endCol > pt_.columnCount(e.endLine)) return false;
+    }
+
+    // Bottom to top; at equal positions the later edit goes first so batch order is kept in the text
+    // Alttan uste; esit konumlarda sonraki duzenleme once gider, boylece metinde grup sirasi korunur
+    auto before = [](int l1, int c1, int l2, int c2) { return l1 < l2 || (l1 == l2 && c1 < c2); };
+    std::vector<size_t> order(edits.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const auto& x = edits[a];
+        const auto& y = edits[b];
+        if (x.startLine != y.startLine || x.startCol != y.startCol)
+            return before(y.startLine, y.startCol, x.startLine, x.startCol);
+        if (x.endLine != y.endLine || x.endCol != y.endCol)
+            return before(y.endLine, y.endCol, x.endLine, x.endCol);
+        return a > b;
+    });
+    for (size_t i = 1; i < order.size(); ++i) {
+        const auto& lower = edits[order[i - 1]];
+        const auto& upper = edits[order[i]];
+        if (before(lower.startLine, lower.startCol, upper.endLine, upper.endCol)) return false;
+    }
+
+    if (applied) {
+        applied->clear();
+        applied->reserve(edits.size());
+    }
+    if (edits.empty()) return true;
+    ++version_;
+    columns_.invalidateFrom(edits[order.back()].startLine);
+    if (edits.size() > kMaxLineChanges) resetJournal();
+
+    // Large removals are kept as a view into the table before the batch. Edits run bottom to
+    // top, so each range reads the same there as when it is applied.
+    // Buyuk silmeler gruptan onceki tabloya bir gorunum olarak tutulur. Duzenlemeler alttan uste
+    // calisir, bu yuzden her aralik orada uygulandigi andaki gibi okunur.
+    std::shared_ptr<const PieceTable> sealed;
+    std::vector<char> large(edits.size(), 0);
+    if (applied) {
+        for (size_t i = 0; i < edits.size(); ++i) {
+            const TextEdit& e = edits[i];
+            large[i] = pt_.offsetOf(e.endLine, e.endCol) - pt_.offsetOf(e.startLine, e.startCol) >= kRemovedByReference;
+            if (large[i] && !sealed) sealed = pt_.snapshot();
+        }
+    }
+
+    for (size_t idx : order) {
+        const TextEdit& e = edits[idx];
+        std::string first = pt_.getLine(e.startLine);
+        std::string last = e.endLine == e.startLine ? first : pt_.getLine(e.endLine);
+
+        // Keep what the range held (undo needs it) unless it stays readable in sealed
+        // sealed'da okunabilir kalmiyorsa araligin tuttugunu sakla (geri alma icin gerekli)
+        std::string removed;
+        bool byReference = large[idx];
+        if (!byReference && e.startLine == e.endLine) {
+            removed = first.substr(e.startCol, e.endCol - e.startCol);
+        } else if (!byReference) {
+            removed = first.substr(e.startCol);
+            for (int l = e.startLine + 1; l < e.endLine; ++l) {
+                removed += '\n';
+                removed.append(pt_.lineView(l));
+            }
+            removed += '\n';
+            removed.append(last, 0, e.endCol);
+        }
+
+        // New lines: head + text + tail, split at '\n'
+        // Yeni satirlar: bas + metin + kuyruk, '\n'de bolunmus
+        std::vector<std::string> parts;
+        std::string cur = first.substr(0, e.startCol);
+        for (char c : e.text) {
+            if (c == '\n') {
+                parts.push_back(std::move(cur));
+                cur.clear();
+            } else {
+                cur += c;
+            }
+        }
+        int newEndLine = e.startLine + static_cast<int>(parts.size());
+        int newEndCol = static_cast<int>(parts.empty() ? e.startCol + e.text.size() : cur.size());
+        cur.append(last, e.endCol, std::string::npos);
+        parts.push_back(std::move(cur));
+
+        // Reuse the old lines in place, then insert or delete the difference
+        // Eski satirlari yerinde yeniden kullan, sonra farki ekle veya sil
+        int oldCount = e.endLine - e.startLine + 1;
+        int newCount = static_cast<int>(parts.size());
+        int common = std::min(oldCount, newCount);
+        for (int i = 0; i < common; ++i) {
+            pt_.setLine(e.startLine + i, parts[i]);
+        }
+        for (int i = common; i < newCount; ++i) {
+            pt_.insertLineAt(e.startLine + i, parts[i]);
+        }
+        if (oldCount > common) pt_.eraseLines(e.startLine + common, oldCount - common);
+        if (edits.size() <= kMaxLineChanges) noteLines(e.startLine, oldCount, newCount);
+
+        if (applied) {
+            applied->push_back({e, std::move(removed), newEndLine, newEndCol,
+                                byReference ? sealed : nullptr});
+        }
+    }
+    return true;
 }
 
 // Split a line into two at the given column (used for Enter key)
 // Verilen sutunda satiri ikiye bol (Enter tusu icin kullanilir)
 void Buffer::splitLine(int line, int col) {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (line < 0 || line >= pt_.lineCount()) return;
+    ++version_;
     if (col < 0) col = 0;
 
     std::string content = pt_.getLine(line);
@@ -108,6 +318,8 @@ void Buffer::splitLine(int line, int col) {
     std::string left = content.substr(0, col);
     std::string right = content.substr(col);
 
+    columns_.invalidateFrom(line);
+    noteLines(line, 1, 2);
     pt_.setLine(line, left);
     pt_.insertLineAt(line + 1, right);
 }
@@ -115,8 +327,13 @@ void Buffer::splitLine(int line, int col) {
 // Join two consecutive lines into one
 // Ardisik iki satiri tek satirda birlestir
 void Buffer::joinLines(int first, int second) {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (first < 0 || second <= first || second >= pt_.lineCount()) return;
+    ++version_;
 
+    columns_.invalidateFrom(first);
+    noteLines(first, 1, 1);
+    noteLines(second, 1, 0);
     std::string merged = pt_.getLine(first) + pt_.getLine(second);
     pt_.setLine(first, merged);
     pt_.deleteLine(second);
@@ -125,73 +342,246 @@ void Buffer::joinLines(int first, int second) {
 // Return a copy of the line content at the given index
 // Verilen indeksteki satir iceriginin kopyasini dondur
 std::string Buffer::getLine(int line) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return pt_.getLine(line);
 }
 
 // Return a mutable reference (COW for original lines)
 // Degistirilebilir referans dondur (orijinal satirlar icin COW)
 std::string& Buffer::getLineRef(int line) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    columns_.invalidateLine(line);
+    if (line >= 0 && line < pt_.lineCount()) noteLines(line, 1, 1);
     return pt_.getLineRef(line);
 }
 
 // Return the total number of lines in the buffer
 // Tampondaki toplam satir sayisini dondur
 int Buffer::lineCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return pt_.lineCount();
 }
 
 // Return the number of characters (columns) in a given line
 // Verilen satirdaki karakter (sutun) sayisini dondur
 int Buffer::columnCount(int line) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return pt_.columnCount(line);
 }
 
+// Visit a line range straight from the piece storage while holding the lock
+// Kilidi tutarken bir satir araligini dogrudan parca deposundan ziyaret et
+void Buffer::forEachChunk(int firstLine, int count, const PieceTable::ChunkFn& fn) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pt_.forEachChunk(firstLine, count, fn);
+}
+
+// Offset index lookups
+// Ofset indeksi aramalari
+uint64_t Buffer::offsetOf(int line, int col) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pt_.offsetOf(line, col);
+}
+
+// Line and column of a byte offset, clamped to the text
+// Bir bayt ofsetinin metne sinirlanmis satiri ve sutunu
+TextPosition Buffer::positionOf(uint64_t offset) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pt_.positionOf(offset);
+}
+
+// Length of the text in bytes, lines joined by '\n'
+// Satirlar '\n' ile birlestirilmis metnin bayt uzunlugu
+uint64_t Buffer::byteCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pt_.byteCount();
+}
+
 // Append a new line at the end of the buffer
 // Tamponun sonuna yeni bir satir ekle
 void Buffer::insertLine(const std::string& line) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    noteLines(pt_.lineCount(), 0, 1);
     pt_.appendLine(line);
 }
 
 // Insert a new line at the specified index position
 // Belirtilen indeks konumuna yeni bir satir ekle
 void Buffer::insertLineAt(int index, const std::string& line) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    columns_.invalidateFrom(index);
+    noteLines(std::clamp(index, 0, pt_.lineCount()), 0, 1);
     pt_.insertLineAt(index, line);
 }
 
 // Delete the line at the given index; PieceTable keeps at least one empty line
 // Verilen indeksteki satiri sil; PieceTable en az bir bos satir tutar
 void Buffer::deleteLine(int index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index < 0 || index >= pt_.lineCount()) return;
+    ++version_;
+    columns_.invalidateFrom(index);
+    // The last line left is emptied rather than removed
+    // Kalan son satir kaldirilmak yerine bosaltilir
+    noteLines(index, 1, pt_.lineCount() == 1 ? 1 : 0);
     pt_.deleteLine(index);
 }
 
 // Clear all lines and reset buffer to a single empty line
 // Tum satirlari temizle ve tamponu tek bir bos satira sifirla
 void Buffer::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    columns_.clear();
+    resetJournal();
     pt_.clear();
 }
 
 // Check whether a (line, col) position is valid within the buffer
 // (satir, sutun) konumunun tampon icinde gecerli olup olmadigini kontrol et
 bool Buffer::isValidPos(int line, int col) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return pt_.isValidPos(line, col);
 }
 
 // Strip trailing carriage return characters from all lines (CRLF -> LF)
 // Tum satirlardan sondaki satir basi karakterlerini kaldir (CRLF -> LF)
 void Buffer::normalizeNewlines() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    columns_.clear();
+    resetJournal();
     for (int i = 0; i < pt_.lineCount(); ++i) {
-        auto& l = pt_.getLineRef(i);
-        if (!l.empty() && l.back() == '\r')
-            l.pop_back();
+        std::string_view v = pt_.lineView(i);
+        if (!v.empty() && v.back() == '\r')
+            pt_.getLineRef(i).pop_back();
     }
 }
 
 // Load lines in bulk from a vector (efficient for file loading)
 // Vektordan toplu satir yukleme (dosya yukleme icin verimli)
 void Buffer::loadLines(std::vector<std::string>&& lines) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    columns_.clear();
+    resetJournal();
     pt_.loadLines(std::move(lines));
 }
 
+// Load a memory-mapped file as the original content
+// Bellek eslemeli bir dosyayi orijinal icerik olarak yukle
+void Buffer::loadMapped(std::shared_ptr<MappedFile> file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    columns_.clear();
+    resetJournal();
+    pt_.loadMapped(std::move(file));
+}
+
+// Check if the mapped source is still being indexed
+// Eslenmis kaynagin hala indekslenip indekslenmedigini kontrol et
+bool Buffer::isLoading() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pt_.isLoading();
+}
+
+// Stop background indexing of the mapped source
+// Eslenmis kaynagin arka plan indekslemesini durdur
+void Buffer::cancelLoading() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pt_.cancelLoading();
+}
+
+// Check the mapped source against the file on disk
+// Eslenmis kaynagi diskteki dosyaya karsi denetle
+bool Buffer::originalLost() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pt_.originalLost();
+}
+
+// Replace the content of a line
+// Bir satirin icerigini degistir
+void Buffer::setLine(int line, const std::string& content) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (line < 0 || line >= pt_.lineCount()) return;
+    ++version_;
+    columns_.invalidateLine(line);
+    noteLines(line, 1, 1);
+    pt_.setLine(line, content);
+}
+
+// Capture the current content; the lock is held only for the O(1) copy
+// Mevcut icerigi yakala; kilit yalnizca O(1) kopya icin tutulur
+BufferSnapshot Buffer::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return BufferSnapshot(pt_.snapshot(), version_);
+}
+
+// Current edit counter
+// Mevcut duzenleme sayaci
+uint64_t Buffer::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+// Entries are in version order, so the ones after `since` are a suffix
+// Girdiler surum sirasindadir, bu yuzden `since`'dan sonrakiler bir sonektir
+bool Buffer::changesSince(uint64_t since, uint64_t upTo, std::vector<LineChange>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.clear();
+    if (since < journalFloor_) return false;
+    auto it = std::partition_point(journal_.begin(), journal_.end(),
+                                   [since](const JournalEntry& e) { return e.version <= since; });
+    for (; it != journal_.end() && it->version <= upTo; ++it) out.push_back(it->change);
+    return true;
+}
+
+// Trim the journal a whole version at a time and raise the floor to the dropped version
+// Gunlugu her seferinde bir surumun tamamini atarak kirp ve tabani atilan surume yukselt
+void Buffer::noteLines(int line, int removed, int added) {
+    journal_.push_back({version_, {line, removed, added}});
+    if (journal_.size() <= kMaxLineChanges) return;
+    journalFloor_ = journal_.front().version;
+    while (!journal_.empty() && journal_.front().version == journalFloor_) journal_.pop_front();
+}
+
+// Empty the journal and move the floor up to the current version
+// Gunlugu bosalt ve tabani mevcut surume tasi
+void Buffer::resetJournal() {
+    journal_.clear();
+    journalFloor_ = version_;
+}
+
+// Tables of lines not cached yet are built from the text under the same lock, so a batch of
+// positions on one line decodes it once
+// Henuz onbellekte olmayan satirlarin tablolari ayni kilit altinda metinden kurulur, boylece
+// tek satirdaki bir konum grubu onu bir kez cozer
+void Buffer::convertColumns(std::vector<TextPosition>& positions, ColumnUnit from, ColumnUnit to,
+                            int tabWidth) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (from == to) return;
+    int lines = pt_.lineCount();
+    for (auto& pos : positions) {
+        if (pos.line < 0 || pos.line >= lines) continue;
+        const ColumnIndex::Line* cols = columns_.find(pos.line, tabWidth);
+        if (!cols) cols = &columns_.build(pos.line, pt_.lineView(pos.line), tabWidth);
+        pos.col = cols->convert(pos.col, from, to);
+    }
+}
+
+FileEncoding Buffer::fileEncoding() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return encoding_;
+}
+
+void Buffer::setFileEncoding(FileEncoding encoding) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    encoding_ = encoding;
+}
+
 // Get read-only access to the underlying piece table
 // Alttaki piece table'a salt okunur erisim al
 const PieceTable& Buffer::pieceTable() const {
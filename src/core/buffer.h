@@ -4,10 +4,18 @@
 // See LICENSE file in the project root for full license text.
 
 #pragma once
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
+#include "ColumnIndex.h"
+#include "EncodingDetector.h"
 #include "PieceTable.h"
 
+class BufferSnapshot;
+
 // Represents a range of text in the buffer (start/end positions)
 // Buffer icindeki bir metin araligini temsil eder (baslangic/bitis konumlari)
 struct TextSpan {
@@ -15,12 +23,46 @@ struct TextSpan {
     int lineEnd, colEnd;
 };
 
+// Replace [start, end) with text; positions refer to the document before the batch (LSP TextEdit)
+// [start, end) araligini metinle degistir; konumlar toplu islemden onceki belgeye gore (LSP TextEdit)
+struct TextEdit {
+    int startLine = 0, startCol = 0;
+    int endLine = 0, endCol = 0;
+    std::string text;            // Replacement, may contain '\n' / Yerine gelen metin, '\n' icerebilir
+};
+
+// One edit as applyEdits carried it out
+// applyEdits'in uyguladigi haliyle bir duzenleme
+struct AppliedEdit {
+    TextEdit edit;               // Range replaced and text inserted / Degistirilen aralik ve eklenen metin
+    std::string removed;         // Text the range held before / Araligin onceden tuttugu metin
+    int newEndLine = 0;          // End of the inserted text / Eklenen metnin sonu
+    int newEndCol  = 0;
+    // Large ranges leave removed empty and set this instead: the table before the batch, where
+    // the range reads the same (see Buffer::restoreRange)
+    // Buyuk araliklar removed'i bos birakir ve bunun yerine bunu ayarlar: araligin ayni okundugu,
+    // gruptan onceki tablo (bkz. Buffer::restoreRange)
+    std::shared_ptr<const PieceTable> removedFrom;
+};
+
+// A run of lines one edit replaced: [line, line + removed) became [line, line + added)
+// Bir duzenlemenin degistirdigi satir dizisi: [line, line + removed), [line, line + added) oldu
+struct LineChange {
+    int line = 0;
+    int removed = 0;
+    int added = 0;
+};
+
 // Core text buffer backed by a line-based piece table.
 // Satir tabanli piece table ile desteklenen temel metin buffer'i.
 // All text editing operations (insert, delete, split, join) go through this class.
 // Tum metin duzenleme islemleri (ekleme, silme, bolme, birlestirme) bu sinif uzerinden yapilir.
 // Original file content is stored immutably; edits go to an append-only buffer (COW).
 // Orijinal dosya icerigi degistirilemez saklanir; duzenlemeler yalnizca ekleme arabellegine gider (COW).
+// Each call is atomic with respect to others; readers on other threads should work on a
+// snapshot() so that a multi-line read sees one consistent version.
+// Her cagri digerlerine gore atomiktir; diger thread'lerdeki okuyucular cok satirli bir okumanin
+// tek ve tutarli bir surumu gormesi icin snapshot() uzerinde calismalidir.
 class Buffer {
 public:
     Buffer();
@@ -41,6 +83,37 @@ public:
     // Iki konum arasindaki metni silme
     void deleteRange(int lineStart, int colStart, int lineEnd, int colEnd);
 
+    // Apply a batch of non-overlapping edits atomically, bottom to top, in one locked pass.
+    // Cakismayan bir duzenleme grubunu atomik olarak, alttan uste, tek kilitli geciste uygula.
+    // Returns false and leaves the buffer untouched if a range is invalid or two ranges overlap.
+    // Bir aralik gecersizse veya iki aralik cakisiyorsa false dondurur ve buffer'a dokunmaz.
+    // Edits at the same position keep their order in the batch. On success, applied (if given)
+    // lists the edits in the order they were carried out, each in the coordinates it saw.
+    // Ayni konumdaki duzenlemeler gruptaki sirasini korur. Basarida applied (verildiyse)
+    // duzenlemeleri uygulandiklari sirayla, her biri gordugu koordinatlarda listeler.
+    // Columns in another unit are read the way LSP reads them: a column past a line's end is
+    // its end and a line past the last is the end of the text; they become byte columns under
+    // the same lock, and applied reports those.
+    // Baska bir birimdeki sutunlar LSP'nin okudugu gibi okunur: satir sonunun otesindeki bir
+    // sutun satirin sonudur ve sonuncunun otesindeki bir satir metnin sonudur; ayni kilit
+    // altinda bayt sutunlarina donusurler ve applied onlari bildirir.
+    bool applyEdits(const std::vector<TextEdit>& edits, std::vector<AppliedEdit>* applied = nullptr,
+                    ColumnUnit unit = ColumnUnit::Byte);
+
+    // Delete a range like deleteRange and return the table as it was before, sealed: the
+    // removed text stays readable there without being copied (null if the range is invalid)
+    // deleteRange gibi bir araligi sil ve tablonun onceki halini muhurlu olarak dondur: silinen
+    // metin orada kopyalanmadan okunabilir kalir (aralik gecersizse null)
+    std::shared_ptr<const PieceTable> cutRange(int lineStart, int colStart, int lineEnd, int colEnd);
+
+    // Put back the text (lineStart, colStart)-(lineEnd, colEnd) of `from`, a table sealed before
+    // it was cut here. The two partial edge lines are copied; whole lines in between are spliced
+    // in as pieces, so restoring half a million lines costs O(pieces), not O(text).
+    // `from`'un (lineStart, colStart)-(lineEnd, colEnd) metnini geri koy; `from` metin burada
+    // kesilmeden once muhurlenmis bir tablodur. Iki kismi kenar satiri kopyalanir; aradaki tam
+    // satirlar parca olarak eklenir, boylece yarim milyon satiri geri koymak O(metin) degil O(parca) tutar.
+    void restoreRange(const PieceTable& from, int lineStart, int colStart, int lineEnd, int colEnd);
+
     // Split a line into two at the given column (Enter key behavior)
     // Verilen sutunda bir satiri ikiye bolme (Enter tusu davranisi)
     void splitLine(int line, int col);
@@ -53,10 +126,36 @@ public:
     // Bir satirin iceriginin kopyasini alma
     std::string getLine(int line) const;
 
-    // Get a mutable reference to a line (COW: original lines copied to add buffer)
-    // Bir satira degistirilebilir referans alma (COW: orijinal satirlar ekleme arabellegine kopyalanir)
+    // Get a mutable reference to a line (COW: original lines copied to add buffer).
+    // Bir satira degistirilebilir referans alma (COW: orijinal satirlar ekleme arabellegine kopyalanir).
+    // The write through the reference happens outside the buffer lock; prefer setLine.
+    // Referans uzerinden yazma buffer kilidinin disinda olur; setLine tercih edilmeli.
     std::string& getLineRef(int line);
 
+    // Replace the content of a line
+    // Bir satirin icerigini degistir
+    void setLine(int line, const std::string& content);
+
+    // Visit lines [firstLine, firstLine + count) as runs of views without copying them.
+    // [firstLine, firstLine + count) satirlarini kopyalamadan gorunum dizileri olarak ziyaret et.
+    // The buffer stays locked during the visit: fn must not call back into this buffer, and
+    // long scans (or work on another thread) should use snapshot() instead.
+    // Ziyaret boyunca buffer kilitli kalir: fn bu buffer'a geri cagri yapmamali; uzun taramalar
+    // (veya baska thread'deki isler) bunun yerine snapshot() kullanmali.
+    void forEachChunk(int firstLine, int count, const PieceTable::ChunkFn& fn) const;
+
+    // Byte offset of (line, col), lines joined by '\n' (O(log n), kept current by every edit)
+    // (line, col)'un bayt ofseti, satirlar '\n' ile birlestirilmis (O(log n), her duzenlemeyle guncel)
+    uint64_t offsetOf(int line, int col) const;
+
+    // (line, col) of a byte offset
+    // Bir bayt ofsetinin (line, col) konumu
+    TextPosition positionOf(uint64_t offset) const;
+
+    // Length of the text in bytes
+    // Metnin bayt cinsinden uzunlugu
+    uint64_t byteCount() const;
+
     // Total number of lines in the buffer
     // Buffer'daki toplam satir sayisi
     int lineCount() const;
@@ -93,10 +192,89 @@ public:
     // Bir vektordan toplu satir yukleme (verimli dosya yukleme icin)
     void loadLines(std::vector<std::string>&& lines);
 
+    // Load a memory-mapped file as the original content (large files, lazy lines)
+    // Bellek eslemeli bir dosyayi orijinal icerik olarak yukle (buyuk dosyalar, tembel satirlar)
+    void loadMapped(std::shared_ptr<MappedFile> file);
+
+    // Check if the file behind this buffer is still being indexed (lineCount is a lower bound)
+    // Bu buffer'in arkasindaki dosyanin hala indekslenip indekslenmedigini kontrol et (lineCount alt sinirdir)
+    bool isLoading() const;
+
+    // Stop background loading, keeping the lines indexed so far
+    // Arka plan yuklemeyi durdur, simdiye kadar indekslenen satirlari koru
+    void cancelLoading();
+
+    // True if the mapped file was truncated on disk and took text of this buffer with it
+    // Eslenen dosya diskte kesildiyse ve bu buffer'in metnini de goturduyse true
+    bool originalLost() const;
+
+    // Immutable, versioned view of the current content (O(1), shares storage with the buffer)
+    // Mevcut icerigin degismez, surumlu gorunumu (O(1), depolamayi buffer ile paylasir)
+    BufferSnapshot snapshot() const;
+
+    // Edit counter, incremented by every modifying call
+    // Her degistiren cagriyla artan duzenleme sayaci
+    uint64_t version() const;
+
+    // Line runs replaced by the edits after version `since` up to `upTo`, in the order they were
+    // made, each in the coordinates it saw. False if the journal no longer reaches back that far
+    // (too many edits since, or a bulk load or clear): the caller has to rescan everything.
+    // `since` surumunden sonra `upTo`'ya kadar yapilan duzenlemelerin degistirdigi satir dizileri,
+    // yapildiklari sirayla, her biri gordugu koordinatlarda. Gunluk o kadar geriye uzanmiyorsa
+    // (o zamandan beri cok fazla duzenleme veya toplu yukleme ya da temizleme) false: cagiran her seyi yeniden taramalidir.
+    bool changesSince(uint64_t since, uint64_t upTo, std::vector<LineChange>& out) const;
+
+    // Convert the columns of positions in place between byte, codepoint, UTF-16 and display
+    // units (tabs expand to tabWidth stops). Per-line tables are cached until an edit touches
+    // the line; positions on lines that do not exist are left as they are.
+    // Konumlarin sutunlarini bayt, kod noktasi, UTF-16 ve gorunum birimleri arasinda yerinde
+    // donustur (sekmeler tabWidth duraklarina genisler). Satir basina tablolar bir duzenleme
+    // satira dokunana kadar onbellekte kalir; olmayan satirlardaki konumlar oldugu gibi birakilir.
+    void convertColumns(std::vector<TextPosition>& positions, ColumnUnit from, ColumnUnit to,
+                        int tabWidth = 4) const;
+
+    // Encoding the file is written back in (set by the loader, UTF-8 for new buffers)
+    // Dosyanin geri yazildigi kodlama (yukleyici ayarlar, yeni buffer'lar icin UTF-8)
+    FileEncoding fileEncoding() const;
+    void setFileEncoding(FileEncoding encoding);
+
     // Get the underlying piece table (read-only, for diagnostics)
     // Alttaki piece table'a erisin (salt okunur, tanilar icin)
     const PieceTable& pieceTable() const;
 
 private:
+    // Removals at least this large are kept by reference in AppliedEdit::removedFrom
+    // En az bu buyuklukteki silmeler AppliedEdit::removedFrom'da referansla tutulur
+    static constexpr uint64_t kRemovedByReference = 16 * 1024;
+
+    // Line changes kept for changesSince; older ones are dropped a whole version at a time
+    // changesSince icin tutulan satir degisiklikleri; eskiler her seferinde butun bir surum olarak atilir
+    static constexpr size_t kMaxLineChanges = 4096;
+
+    // Journal a line change of the current version; the caller holds mutex_ and has bumped version_
+    // Mevcut surumun bir satir degisikligini gunluge yaz; cagiran mutex_'i tutar ve version_'i artirmistir
+    void noteLines(int line, int removed, int added);
+
+    // Forget the journal: every version before the current one now needs a full rescan
+    // Gunlugu unut: mevcut surumden onceki her surum artik tam yeniden tarama gerektirir
+    void resetJournal();
+
+    // deleteRange body; the caller holds mutex_ and has validated the lines
+    // deleteRange govdesi; cagiran mutex_'i tutar ve satirlari dogrulamistir
+    void eraseRange(int lineStart, int colStart, int lineEnd, int colEnd);
+
     PieceTable pt_;  // Piece table storage (replaces vector<string>) / Piece table depolama (vector<string> yerine)
+    mutable std::mutex mutex_;  // Guards pt_ for the duration of one call / Bir cagri suresince pt_'yi korur
+    uint64_t version_ = 0;      // Edit counter / Duzenleme sayaci
+    FileEncoding encoding_;     // On-disk encoding / Diskteki kodlama
+    mutable ColumnIndex columns_;  // Column tables of recently converted lines / Son donusturulen satirlarin sutun tablolari
+
+    // One journaled change and the version it produced
+    // Gunluge yazilmis bir degisiklik ve urettigi surum
+    struct JournalEntry {
+        uint64_t version;
+        LineChange change;
+    };
+    std::deque<JournalEntry> journal_;  // Recent line changes, oldest first / Son satir degisiklikleri, en eskisi once
+    uint64_t journalFloor_ = 0;         // Changes after versions below this are gone / Bunun altindaki surumlerden sonraki degisiklikler yok
 };
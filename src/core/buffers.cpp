@@ -4,7 +4,11 @@
 // See LICENSE file in the project root for full license text.
 
 #include "buffers.h"
+#include "EventBus.h"
+#include "UndoFile.h"
+#include "Logger.h"
 #include <filesystem>
+#include "nlohmann/json.hpp"
 
 // Constructor: initialize with one empty untitled document
 // Kurucu: bir bos isimsiz belgeyle baslat
@@ -37,47 +41,145 @@ bool Buffers::openFile(const std::string& path) {
         }
     }
 
+    // Progress is reported from the indexer thread; the bus delivers it asynchronously
+    // Ilerleme indeksleyici thread'inden bildirilir; veriyolu onu asenkron iletir
+    EventBus* eb = eventBus_;
+    auto onProgress = [eb, path](int lines, size_t bytes, size_t total, bool done) {
+        if (!eb) return;
+        int percent = total > 0 ? static_cast<int>(bytes * 100 / total) : 100;
+        nlohmann::json payload = {
+            {"path", path}, {"lines", lines}, {"bytes", bytes}, {"total", total},
+            {"percent", done ? 100 : percent}, {"done", done}
+        };
+        eb->emit("fileLoadProgress", payload.dump());
+        if (done) eb->emit("fileLoaded", payload.dump());
+    };
+
     auto st = std::make_unique<EditorState>();
-    auto res = FileSystem::loadToBuffer(st->getBuffer(), path);
+    auto res = FileSystem::loadToBufferAsync(st->getBuffer(), path, onProgress);
     if (!res.success) return false;
 
     st->setFilePath(path);
     st->markModified(false);
+    st->getUndo().persistTo(UndoFile::forPath(path), st->getBuffer().snapshot());
     docs_.push_back(std::move(st));
     active_ = docs_.size() - 1;
     return true;
 }
 
-// Save the currently active document to its file path
-// Su an aktif olan belgeyi dosya yoluna kaydet
+// Stop background indexing in every open document
+// Tum acik belgelerde arka plan indekslemeyi durdur
+void Buffers::cancelLoading() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& st : docs_) st->getBuffer().cancelLoading();
+}
+
+// Queue the currently active document for saving
+// Su an aktif olan belgeyi kaydetme sirasina al
 bool Buffers::saveActive() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (docs_.empty()) return false;
     auto& st = *docs_[active_];
     const auto& p = st.getFilePath();
     if (p.empty() || p == "untitled") return false;
-    auto res = FileSystem::saveFromBuffer(st.getBuffer(), p);
-    if (res.success) st.markModified(false);
-    return res.success;
+    queueSave(st);
+    return true;
 }
 
-// Save all open documents that have a valid file path
-// Gecerli dosya yolu olan tum acik belgeleri kaydet
+// Queue all open documents that have a valid file path
+// Gecerli dosya yolu olan tum acik belgeleri kaydetme sirasina al
 int Buffers::saveAll() {
     std::lock_guard<std::mutex> lock(mutex_);
-    int ok = 0;
+    int queued = 0;
     for (auto& stPtr : docs_) {
         auto& st = *stPtr;
         const auto& p = st.getFilePath();
         if (!p.empty() && p != "untitled") {
-            auto res = FileSystem::saveFromBuffer(st.getBuffer(), p);
-            if (res.success) {
-                st.markModified(false);
-                ++ok;
-            }
+            queueSave(st);
+            ++queued;
         }
     }
-    return ok;
+    return queued;
+}
+
+// Check each document; mapped ones fstat their file, the rest return at once
+// Her belgeyi denetle; eslenmis olanlar dosyalarini fstat eder, digerleri hemen doner
+int Buffers::checkTruncated() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int lost = 0;
+    for (const auto& st : docs_)
+        if (reportIfTruncated(*st)) ++lost;
+    return lost;
+}
+
+// The event goes out on the first detection only; the save path refuses the content anyway
+// Olay yalnizca ilk tespitte gider; kaydetme yolu icerigi zaten reddeder
+bool Buffers::reportIfTruncated(const EditorState& st) {
+    if (!st.getBuffer().originalLost()) return false;
+    if (truncated_.insert(&st).second) {
+        LOG_ERROR("[Buffers] ", st.getFilePath(), " was truncated on disk; save is disabled for it");
+        if (eventBus_) eventBus_->emit("fileTruncated", nlohmann::json({{"path", st.getFilePath()}}).dump());
+    }
+    return true;
+}
+
+// Block until the saver is idle
+// Kaydedici bosta kalana kadar bekle
+void Buffers::flushSaves() {
+    saver_.flush();
+}
+
+// Push every document's pending undo records to disk
+// Her belgenin bekleyen geri alma kayitlarini diske yaz
+void Buffers::flushUndo() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& st : docs_) {
+        const EditorState& doc = *st;
+        if (auto journal = doc.getUndo().journal()) journal->flush();
+    }
+}
+
+// The snapshot is O(1); the completion runs on the saver thread and looks the document up
+// again because it may have been closed meanwhile. The undofile gets a SAVE record for the
+// node the written text belongs to, unless a newer save overtook this one.
+// Anlik goruntu O(1)'dir; tamamlama kaydedici thread'inde calisir ve belgeyi yeniden arar
+// cunku bu sirada kapatilmis olabilir. Geri alma dosyasi, daha yeni bir kaydetme bunu
+// gecmediyse, yazilan metnin ait oldugu dugum icin bir SAVE kaydi alir.
+void Buffers::queueSave(EditorState& st) {
+    reportIfTruncated(st);
+    EditorState* doc = &st;
+    std::string path = st.getFilePath();
+    BufferSnapshot snapshot = st.getBuffer().snapshot();
+    auto& undo = st.getUndo();
+    undo.persistTo(UndoFile::forPath(path), snapshot);
+    uint32_t savedNode = undo.savePoint();
+    std::shared_ptr<UndoFile> journal = undo.journal();
+    uint64_t version = snapshot.version();
+    saver_.save(std::move(snapshot), path, st.getBuffer().fileEncoding(),
+        [this, doc, path, journal, savedNode, version](const FileResult& res, const BufferSnapshot& snap) {
+            if (res.success && journal && savedNode != UndoFile::kNone && snap.version() == version) {
+                journal->save(savedNode, UndoFile::hashContent(snap));
+                journal->flush();
+            }
+            if (res.success) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& d : docs_) {
+                    if (d.get() != doc || d->getFilePath() != path) continue;
+                    if (d->getBuffer().version() == snap.version()) d->markModified(false);
+                    break;
+                }
+            }
+            if (!eventBus_) return;
+            if (res.success) {
+                nlohmann::json payload = {
+                    {"path", path}, {"lines", res.lineCount}, {"version", snap.version()}
+                };
+                eventBus_->emit("fileSaved", payload.dump());
+            } else {
+                nlohmann::json payload = {{"path", path}, {"error", res.message}};
+                eventBus_->emit("fileSaveFailed", payload.dump());
+            }
+        });
 }
 
 // Close the currently active document; create a new one if none remain
@@ -87,6 +189,7 @@ bool Buffers::closeActive() {
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (docs_.empty()) return false;
+        truncated_.erase(docs_[active_].get());
         docs_.erase(docs_.begin() + active_);
         if (docs_.empty()) {
             needNew = true;
@@ -105,6 +208,7 @@ bool Buffers::closeAt(size_t index) {
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (index >= docs_.size()) return false;
+        truncated_.erase(docs_[index].get());
         docs_.erase(docs_.begin() + index);
         if (docs_.empty()) {
             needNew = true;
@@ -191,6 +295,18 @@ std::optional<size_t> Buffers::findByPath(const std::string& path) const {
     return std::nullopt;
 }
 
+// First document with the path, as findByPath picks it
+// findByPath'in sectigi gibi yola sahip ilk belge
+bool Buffers::withDocument(const std::string& path, const std::function<void(EditorState&)>& fn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& doc : docs_) {
+        if (doc->getFilePath() != path) continue;
+        fn(*doc);
+        return true;
+    }
+    return false;
+}
+
 // Return the display title (filename) for the document at the given index
 // Verilen indeksteki belgenin gorunen basligini (dosya adi) dondur
 std::string Buffers::titleOf(size_t index) const {
@@ -203,6 +319,19 @@ std::string Buffers::titleOf(size_t index) const {
     return name.empty() ? p : name;
 }
 
+// O(1) snapshots of unsaved documents with a path, so callers read them after the lock is released
+// Yolu olan kaydedilmemis belgelerin O(1) anlik goruntuleri; cagiranlar onlari kilit birakildiktan sonra okur
+std::vector<std::pair<std::string, BufferSnapshot>> Buffers::modifiedSnapshots() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<std::string, BufferSnapshot>> out;
+    for (const auto& doc : docs_) {
+        if (doc->isModified() && !doc->getFilePath().empty()) {
+            out.emplace_back(doc->getFilePath(), doc->getBuffer().snapshot());
+        }
+    }
+    return out;
+}
+
 // Extract the filename from a full file path (static utility)
 // Tam dosya yolundan dosya adini cikar (statik yardimci fonksiyon)
 std::string Buffers::basename(const std::string& path) {
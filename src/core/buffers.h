@@ -7,10 +7,17 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <functional>
 #include <optional>
+#include <unordered_set>
 #include <mutex>
+#include <utility>
 #include "state.h"
+#include "BufferSnapshot.h"
 #include "file.h"
+#include "FileSaver.h"
+
+class EventBus;
 
 // Multi-document manager that holds multiple EditorState instances (tabs).
 // Birden fazla EditorState ornegini (sekmeler) tutan coklu belge yoneticisi.
@@ -20,22 +27,55 @@ class Buffers {
 public:
     Buffers();
 
+    // Set the event bus used for file load progress events
+    // Dosya yukleme ilerleme olaylari icin kullanilan olay veriyolunu ayarla
+    void setEventBus(EventBus* eb) { eventBus_ = eb; }
+
     // Create a new empty document and return its index
     // Yeni bos bir belge olustur ve indeksini dondur
     size_t newDocument(const std::string& untitledName = "untitled");
 
-    // Open a file into a new buffer (or switch to it if already open)
-    // Bir dosyayi yeni buffer'a ac (zaten aciksa ona gec)
+    // Open a file into a new buffer (or switch to it if already open).
+    // Bir dosyayi yeni buffer'a ac (zaten aciksa ona gec).
+    // Large files return as soon as their first lines are readable; the rest loads in the
+    // background with "fileLoadProgress" events and a final "fileLoaded" event.
+    // Buyuk dosyalar ilk satirlari okunabilir olur olmaz doner; geri kalani "fileLoadProgress"
+    // olaylari ve son bir "fileLoaded" olayiyla arka planda yuklenir.
     bool openFile(const std::string& path);
 
-    // Save the active buffer to its file path
-    // Aktif buffer'i dosya yoluna kaydet
+    // Stop every background load (call before the event bus goes away)
+    // Tum arka plan yuklemelerini durdur (olay veriyolu yok olmadan once cagir)
+    void cancelLoading();
+
+    // Queue the active buffer for saving to its file path: true means queued, not written
+    // (false if it has no path).
+    // Aktif buffer'i dosya yoluna kaydedilmek uzere siraya al: true yazildi degil siraya
+    // alindi demektir (yolu yoksa false).
+    // The content is captured now and written in the background; the outcome arrives as a
+    // "fileSaved" or "fileSaveFailed" event and the modified flag clears only if no edit
+    // happened meanwhile.
+    // Icerik simdi yakalanir ve arka planda yazilir; sonuc "fileSaved" veya "fileSaveFailed"
+    // olayi olarak gelir ve degistirildi bayragi yalnizca bu sirada duzenleme olmadiysa temizlenir.
     bool saveActive();
 
-    // Save all open buffers and return the count of successfully saved
-    // Tum acik buffer'lari kaydet ve basariyla kaydedilenlerin sayisini dondur
+    // Queue every open buffer with a file path and return how many were queued
+    // Dosya yolu olan tum acik buffer'lari siraya al ve kac tanesinin alindigini dondur
     int saveAll();
 
+    // Check every memory-mapped document against its file on disk and emit "fileTruncated"
+    // once for each one whose file shrank under it; returns how many have lost text
+    // Bellek eslemeli her belgeyi diskteki dosyasina karsi denetle ve dosyasi altinda kuculen
+    // her biri icin bir kez "fileTruncated" yayinla; metin kaybedenlerin sayisini dondurur
+    int checkTruncated();
+
+    // Wait until every queued save has reached the disk
+    // Siradaki tum kaydetmeler diske ulasana kadar bekle
+    void flushSaves();
+
+    // Write every document's pending undo history to its undofile (before exit or restart)
+    // Her belgenin bekleyen geri alma gecmisini geri alma dosyasina yaz (cikis veya yeniden baslatmadan once)
+    void flushUndo() const;
+
     // Close the active buffer (creates new empty doc if last one closed)
     // Aktif buffer'i kapat (sonuncusu kapatilirsa yeni bos belge olusturur)
     bool closeActive();
@@ -80,16 +120,42 @@ public:
     // Dosya yoluna gore buffer bul, bulunursa indeksini dondur
     std::optional<size_t> findByPath(const std::string& path) const;
 
+    // Run fn on the document open at path while the document list is locked, so it cannot be
+    // closed underneath; false if no document has that path
+    // fn'i path'te acik belge uzerinde belge listesi kilitliyken calistir, boylece altinda
+    // kapatilamaz; o yola sahip belge yoksa false
+    bool withDocument(const std::string& path, const std::function<void(EditorState&)>& fn);
+
     // Get the display title of a buffer at a given index
     // Verilen indeksteki buffer'in goruntuleme basligini al
     std::string titleOf(size_t index) const;
 
+    // Snapshots of the modified documents that have a file path, paired with that path
+    // (searched instead of the file on disk by workspace search)
+    // Dosya yolu olan degistirilmis belgelerin anlik goruntuleri, o yolla eslenmis
+    // (calisma alani aramasinda diskteki dosya yerine aranir)
+    std::vector<std::pair<std::string, BufferSnapshot>> modifiedSnapshots() const;
+
 private:
     mutable std::mutex mutex_;                              // Thread safety lock / Thread guvenligi kilidi
     std::vector<std::unique_ptr<EditorState>> docs_;        // Open documents / Acik belgeler
     size_t active_ = 0;                                     // Active document index / Aktif belge indeksi
+    EventBus* eventBus_ = nullptr;                          // Load progress events / Yukleme ilerleme olaylari
+    std::unordered_set<const EditorState*> truncated_;      // Documents reported truncated / Kesildigi bildirilen belgeler
+
+    // True if a document's mapped file was truncated; reports it once (caller holds mutex_)
+    // Bir belgenin eslenmis dosyasi kesildiyse true; bunu bir kez bildirir (cagiran mutex_'i tutar)
+    bool reportIfTruncated(const EditorState& st);
+
+    // Snapshot a document and hand it to the saver (caller holds mutex_)
+    // Bir belgenin anlik goruntusunu al ve kaydediciye teslim et (cagiran mutex_'i tutar)
+    void queueSave(EditorState& st);
 
     // Extract filename from a full path
     // Tam yoldan dosya adini cikar
     static std::string basename(const std::string& path);
+
+    // Declared last so it is destroyed first: pending saves drain while documents still exist
+    // Son bildirilir ki ilk yok edilsin: bekleyen kaydetmeler belgeler hala varken bosalir
+    FileSaver saver_;
 };
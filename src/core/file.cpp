@@ -5,15 +5,118 @@
 
 #include "file.h"
 #include "buffer.h"
+#include "BufferSnapshot.h"
+#include "MappedFile.h"
+#include "LineScanner.h"
 #include "Logger.h"
+#include "Transcoder.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
-// Load a file from disk into a Buffer, handling BOM and CRLF line endings
-// Diskten bir dosyayi BOM ve CRLF satir sonlarini isleyerek Buffer'a yukle
+// Default mmap threshold: 64 MB (overridden from config "file.mmap_threshold_mb")
+// Varsayilan mmap esigi: 64 MB (config "file.mmap_threshold_mb" ile degistirilir)
+std::atomic<uintmax_t> FileSystem::mmapThreshold_{64ull * 1024 * 1024};
+
+// Default progressive open: files of 16 MB and more, 2000 lines ready up front
+// Varsayilan asamali acilis: 16 MB ve ustu dosyalar, onceden hazir 2000 satir
+std::atomic<uintmax_t> FileSystem::asyncOpenThreshold_{16ull * 1024 * 1024};
+std::atomic<int> FileSystem::asyncPrefixLines_{2000};
+
+// Default durability: fsync the file before the rename (config "file.fsync")
+// Varsayilan kalicilik: yeniden adlandirmadan once dosyayi fsync et (config "file.fsync")
+std::atomic<FsyncPolicy> FileSystem::fsyncPolicy_{FsyncPolicy::File};
+
+// Encoding of a file from its first 64 KB; plain ASCII and undecidable files are kept as UTF-8
+// Bir dosyanin ilk 64 KB'indan kodlamasi; duz ASCII ve karar verilemeyen dosyalar UTF-8 tutulur
+static FileEncoding sniffEncoding(const std::string& path) {
+    EncodingResult detected = EncodingDetector::detectFile(path);
+    FileEncoding enc;
+    enc.bom = detected.hasBOM;
+    if (detected.encoding != TextEncoding::ASCII && detected.encoding != TextEncoding::Unknown)
+        enc.encoding = detected.encoding;
+    return enc;
+}
+
+// Stream a file that is not stored as UTF-8: each raw block is decoded and split into lines
+// right away, so only one raw block and one decoded block exist next to the lines at any time
+// UTF-8 olarak saklanmayan bir dosyayi akit: her ham blok hemen cozulur ve satirlara bolunur,
+// boylece satirlarin yaninda herhangi bir anda yalnizca bir ham ve bir cozulmus blok bulunur
+static FileResult loadTranscoded(Buffer& buffer, const std::string& path, FileEncoding encoding) {
+    FileResult result{false, "", 0};
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        result.message = "Dosya açılamadı: " + path;
+        return result;
+    }
+
+    constexpr size_t kBlockSize = 4 * 1024 * 1024;
+    std::vector<std::string> lines;
+
+    try {
+        std::string raw;
+        raw.resize(kBlockSize);
+        std::string text;     // Decoded UTF-8; an unfinished line stays at the front / Cozulmus UTF-8; bitmemis satir basta kalir
+        Transcoder decoder(encoding.encoding);
+        size_t skip = encoding.bom ? Transcoder::byteOrderMark(encoding.encoding).size() : 0;
+
+        while (file) {
+            file.read(raw.data(), static_cast<std::streamsize>(raw.size()));
+            size_t got = static_cast<size_t>(file.gcount());
+            if (got == 0) break;
+
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(raw.data());
+            size_t cut = std::min(skip, got);
+            skip -= cut;
+
+            decoder.decode(data + cut, got - cut, text);
+            size_t consumed = LineScanner::splitLines(text.data(), text.size(), lines);
+            text.erase(0, consumed);
+        }
+
+        if (file.bad()) throw std::runtime_error("read failed");
+
+        decoder.finishDecode(text);
+        if (!text.empty()) {
+            if (text.back() == '\r') text.pop_back();
+            lines.push_back(std::move(text));
+        }
+
+        result.lineCount = lines.size();
+        buffer.loadLines(std::move(lines));
+        buffer.setFileEncoding(encoding);
+
+        result.success = true;
+        result.message = "Dosya başarıyla yüklendi.";
+        LOG_INFO("[FileSystem] Decoded ", path, " from ",
+                 EncodingDetector::encodingName(encoding.encoding), " (", result.lineCount, " lines)");
+    }
+    catch (const std::exception& ex) {
+        result.success = false;
+        result.message = std::string("Dosya okuma hatası: ") + ex.what();
+    }
+
+    return result;
+}
+
+// Load a file from disk into a Buffer, handling BOM, CRLF line endings and non-UTF-8 encodings
+// Diskten bir dosyayi BOM, CRLF satir sonlari ve UTF-8 olmayan kodlamalari isleyerek Buffer'a yukle
 FileResult FileSystem::loadToBuffer(Buffer& buffer, const std::string& path) {
     FileResult result{false, "", 0};
 
@@ -27,37 +130,84 @@ FileResult FileSystem::loadToBuffer(Buffer& buffer, const std::string& path) {
         return result;
     }
 
+    FileEncoding encoding = sniffEncoding(path);
+    if (!Transcoder::isPassthrough(encoding.encoding)) return loadTranscoded(buffer, path, encoding);
+
+    // Large files: map them and index newlines instead of reading every line
+    // Buyuk dosyalar: her satiri okumak yerine esle ve yeni satirlari indeksle
+    std::error_code ec;
+    uintmax_t fileSize = fs::file_size(path, ec);
+    uintmax_t threshold = mmapThreshold();
+    if (!ec && threshold > 0 && fileSize >= threshold) {
+        auto mapped = std::make_shared<MappedFile>();
+        if (mapped->open(path)) {
+            buffer.loadMapped(mapped);
+            buffer.setFileEncoding(encoding);
+            result.success = true;
+            result.lineCount = static_cast<size_t>(mapped->lineCount());
+            result.message = "Dosya başarıyla yüklendi.";
+            LOG_INFO("[FileSystem] Mapped ", path, " (", fileSize, " bytes, ",
+                     mapped->lineCount(), " lines)");
+            return result;
+        }
+        LOG_WARN("[FileSystem] mmap failed, falling back to stream read: ", path);
+    }
+
     std::ifstream file(path, std::ios::in | std::ios::binary);
     if (!file.is_open()) {
         result.message = "Dosya açılamadı: " + path;
         return result;
     }
 
-    buffer.clear();
-    std::string line;
-    size_t lineCount = 0;
-
-    // UTF-8 BOM kontrolü
-    char bom[3];
-    file.read(bom, 3);
-    if (!(bom[0] == char(0xEF) && bom[1] == char(0xBB) && bom[2] == char(0xBF))) {
-        file.seekg(0);
-    }
+    // Read in large blocks and split with the vectorized scanner; a line cut by a block
+    // boundary is carried over. The lines become one Original piece (no add buffer copies).
+    // Buyuk bloklar halinde oku ve vektorlestirilmis tarayiciyla bol; blok sinirinda kesilen
+    // satir tasinir. Satirlar tek bir Original parcasi olur (ekleme arabellegine kopya yok).
+    constexpr size_t kBlockSize = 4 * 1024 * 1024;
+    std::vector<std::string> lines;
 
     try {
-        while (std::getline(file, line)) {
-            // Windows CRLF düzeltmesi
-            if (!line.empty() && line.back() == '\r')
-                line.pop_back();
-            buffer.insertLine(line);
-            ++lineCount;
+        std::string block;
+        block.resize(kBlockSize);
+        size_t carry = 0;     // Bytes of an unfinished line at the front of block / Blok basindaki bitmemis satirin baytlari
+        bool first = true;
+
+        while (file) {
+            if (carry == block.size()) block.resize(block.size() * 2);
+            file.read(block.data() + carry, static_cast<std::streamsize>(block.size() - carry));
+            size_t got = static_cast<size_t>(file.gcount());
+            if (got == 0) break;
+            size_t len = carry + got;
+
+            // Skip the UTF-8 BOM at the start of the file
+            // Dosya basindaki UTF-8 BOM'u atla
+            size_t begin = 0;
+            if (first) {
+                first = false;
+                if (len >= 3 && block[0] == char(0xEF) && block[1] == char(0xBB) && block[2] == char(0xBF))
+                    begin = 3;
+            }
+
+            size_t consumed = begin + LineScanner::splitLines(block.data() + begin, len - begin, lines);
+            carry = len - consumed;
+            if (carry > 0 && consumed > 0) std::memmove(block.data(), block.data() + consumed, carry);
         }
 
-        if (lineCount == 0)
-            buffer.insertLine("");
+        if (file.bad()) throw std::runtime_error("read failed");
+
+        // Last line without a trailing newline
+        // Sonunda yeni satir olmayan son satir
+        if (carry > 0) {
+            size_t end = carry;
+            if (block[end - 1] == '\r') --end;
+            lines.emplace_back(block.data(), end);
+        }
+
+        result.lineCount = lines.size();
+        buffer.loadLines(std::move(lines));
+        buffer.setFileEncoding(encoding);
 
         result.success = true;
-        result.lineCount = lineCount;
         result.message = "Dosya başarıyla yüklendi.";
     }
     catch (const std::exception& ex) {
@@ -68,34 +218,408 @@ FileResult FileSystem::loadToBuffer(Buffer& buffer, const std::string& path) {
     return result;
 }
 
+// Map a large file, index its first lines now and the rest in the background
+// Buyuk bir dosyayi esle, ilk satirlarini simdi, geri kalanini arka planda indeksle
+FileResult FileSystem::loadToBufferAsync(Buffer& buffer, const std::string& path, LoadProgressFn onProgress) {
+    std::error_code ec;
+    uintmax_t fileSize = fs::file_size(path, ec);
+    uintmax_t threshold = asyncOpenThreshold();
+
+    auto blocking = [&]() {
+        FileResult result = loadToBuffer(buffer, path);
+        if (result.success && onProgress) {
+            onProgress(static_cast<int>(result.lineCount), static_cast<size_t>(fileSize),
+                       static_cast<size_t>(fileSize), true);
+        }
+        return result;
+    };
+
+    if (ec || threshold == 0 || fileSize < threshold || !isReadable(path)) return blocking();
+
+    // A file that has to be decoded cannot be mapped; it is streamed instead
+    // Cozulmesi gereken bir dosya eslenemez; bunun yerine akitilir
+    FileEncoding encoding = sniffEncoding(path);
+    if (!Transcoder::isPassthrough(encoding.encoding)) return blocking();
+
+    auto mapped = std::make_shared<MappedFile>();
+    if (!mapped->open(path, false)) {
+        LOG_WARN("[FileSystem] mmap failed, falling back to blocking load: ", path);
+        return blocking();
+    }
+
+    // The viewport prefix is readable before the buffer is handed out
+    // Gorunum oneki buffer teslim edilmeden once okunabilir
+    mapped->indexLines(asyncPrefixLines());
+    buffer.loadMapped(mapped);
+    buffer.setFileEncoding(encoding);
+    mapped->startIndexing(std::move(onProgress));
+
+    LOG_INFO("[FileSystem] Opening ", path, " progressively (", fileSize, " bytes, ",
+             mapped->lineCount(), " lines ready)");
+
+    FileResult result{true, "Dosya yükleniyor.", static_cast<size_t>(mapped->lineCount())};
+    return result;
+}
+
 // Save a Buffer's contents to a file on disk
 // Buffer icerigini diskteki bir dosyaya kaydet
 FileResult FileSystem::saveFromBuffer(const Buffer& buffer, const std::string& path) {
+    // Write from a snapshot: edits made meanwhile neither block nor tear the output.
+    // A file still loading in the background is completed first.
+    // Anlik goruntuden yaz: bu sirada yapilan duzenlemeler ciktiyi ne engeller ne de bozar.
+    // Arka planda hala yuklenen bir dosya once tamamlanir.
+    return saveSnapshot(buffer.snapshot().completed(), path, buffer.fileEncoding());
+}
+
+// Encode lines into ~1 MB blocks for a file not stored as UTF-8; long lines go through in
+// slices, the transcoder carries a character cut between two of them
+// UTF-8 olarak saklanmayan bir dosya icin satirlari ~1 MB'lik bloklara kodla; uzun satirlar
+// dilimler halinde gecer, ikisi arasinda kesilen bir karakteri donusturucu tasir
+static bool encodeSnapshot(const BufferSnapshot& snap, const FileEncoding& enc,
+                           const std::function<bool(const std::string&)>& write) {
+    constexpr size_t kBlock = 1 << 20;
+    Transcoder encoder(enc.encoding);
+    std::string block;
+    block.reserve(kBlock * 2);
+    if (enc.bom) block.append(Transcoder::byteOrderMark(enc.encoding));
+
+    bool ok = true;
+    auto put = [&](std::string_view text) {
+        for (size_t off = 0; off < text.size() && ok; off += kBlock) {
+            encoder.encode(text.substr(off, kBlock), block);
+            if (block.size() >= kBlock) {
+                ok = write(block);
+                block.clear();
+            }
+        }
+    };
+    snap.forEachChunk(0, snap.lineCount(), [&](int, const std::string_view* lines, int count) {
+        for (int i = 0; i < count && ok; ++i) {
+            put(lines[i]);
+            put("\n");
+        }
+        return ok;
+    });
+    encoder.finishEncode(block);
+    return ok && (block.empty() || write(block));
+}
+
+#ifdef _WIN32
+// Write a whole block, resuming after short writes
+// Bir blogun tamamini yaz, kisa yazimlardan sonra devam et
+static bool writeAll(HANDLE file, const char* data, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        DWORD wrote = 0;
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(size - done, 1u << 30));
+        if (!WriteFile(file, data + done, chunk, &wrote, nullptr) || wrote == 0) return false;
+        done += wrote;
+    }
+    return true;
+}
+
+// Gather lines into large blocks for WriteFile; other encodings are converted in blocks first
+// Satirlari WriteFile icin buyuk bloklarda topla; diger kodlamalar once bloklar halinde donusturulur
+static bool writeSnapshotTo(HANDLE file, const BufferSnapshot& snap, const FileEncoding& enc) {
+    if (!Transcoder::isPassthrough(enc.encoding)) {
+        return encodeSnapshot(snap, enc, [file](const std::string& block) {
+            return writeAll(file, block.data(), block.size());
+        });
+    }
+    constexpr size_t kBlock = 1 << 20;
+    std::string block;
+    block.reserve(kBlock);
+    auto flush = [&]() {
+        bool ok = writeAll(file, block.data(), block.size());
+        block.clear();
+        return ok;
+    };
+    if (enc.bom) block.append(Transcoder::byteOrderMark(TextEncoding::UTF8_BOM));
+    bool ok = true;
+    snap.forEachChunk(0, snap.lineCount(), [&](int, const std::string_view* lines, int count) {
+        for (int i = 0; i < count && ok; ++i) {
+            if (block.size() + lines[i].size() + 1 > kBlock) ok = flush();
+            if (lines[i].size() + 1 > kBlock) {
+                ok = ok && writeAll(file, lines[i].data(), lines[i].size());
+                block += '\n';
+            } else {
+                block.append(lines[i]);
+                block += '\n';
+            }
+        }
+        return ok;
+    });
+    return ok && flush();
+}
+#else
+// Write a whole block, resuming after short writes
+// Bir blogun tamamini yaz, kisa yazimlardan sonra devam et
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Hand lines to writev in batches of (line, "\n") pairs, resuming after short writes; other
+// encodings are converted in blocks first
+// Satirlari (satir, "\n") ciftleri halinde gruplarla writev'e ver, kisa yazimlardan sonra
+// devam et; diger kodlamalar once bloklar halinde donusturulur
+static bool writeSnapshotTo(int fd, const BufferSnapshot& snap, const FileEncoding& enc) {
+    if (!Transcoder::isPassthrough(enc.encoding)) {
+        return encodeSnapshot(snap, enc, [fd](const std::string& block) {
+            return writeAll(fd, block.data(), block.size());
+        });
+    }
+
+    constexpr int kMaxIov = 1024;
+    static const char newline = '\n';
+    iovec iov[kMaxIov];
+    int used = 0;
+
+    auto flush = [&]() {
+        iovec* cur = iov;
+        int left = used;
+        while (left > 0) {
+            ssize_t n = ::writev(fd, cur, left);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            size_t wrote = static_cast<size_t>(n);
+            while (left > 0 && wrote >= cur->iov_len) {
+                wrote -= cur->iov_len;
+                ++cur;
+                --left;
+            }
+            if (left > 0) {
+                cur->iov_base = static_cast<char*>(cur->iov_base) + wrote;
+                cur->iov_len -= wrote;
+            }
+        }
+        used = 0;
+        return true;
+    };
+
+    std::string_view bom = Transcoder::byteOrderMark(TextEncoding::UTF8_BOM);
+    if (enc.bom) iov[used++] = {const_cast<char*>(bom.data()), bom.size()};
+
+    bool ok = true;
+    snap.forEachChunk(0, snap.lineCount(), [&](int, const std::string_view* lines, int count) {
+        for (int i = 0; i < count && ok; ++i) {
+            if (used + 2 > kMaxIov) ok = flush();
+            iov[used++] = {const_cast<char*>(lines[i].data()), lines[i].size()};
+            iov[used++] = {const_cast<char*>(&newline), 1};
+        }
+        return ok;
+    });
+    return ok && flush();
+}
+#endif
+
+// Temp file in the target's directory (same filesystem, so the rename is atomic)
+// Hedefin dizininde gecici dosya (ayni dosya sistemi, boylece yeniden adlandirma atomiktir)
+static std::string tempPathFor(const std::string& target) {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(::getpid());
+#endif
+    return target + ".berkide-save-" + std::to_string(pid) + "-" + std::to_string(counter++);
+}
+
+#ifdef _WIN32
+// Rewrite the target itself, for when no temp file can be created next to it or it has other
+// hard links. Not crash-safe: a failure midway leaves the file partly written.
+// Hedefin kendisini yeniden yaz; yaninda gecici dosya olusturulamadiginda veya baska sert
+// baglantilari oldugunda. Cokmeye dayanikli degildir: yarida kalan bir hata dosyayi kismen yazili birakir.
+static bool saveInPlace(const BufferSnapshot& snap, const std::string& target, const FileEncoding& encoding,
+                        FsyncPolicy policy) {
+    HANDLE file = CreateFileA(target.c_str(), GENERIC_WRITE, 0, nullptr, TRUNCATE_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    bool ok = writeSnapshotTo(file, snap, encoding);
+    if (ok && policy != FsyncPolicy::None) ok = FlushFileBuffers(file);
+    CloseHandle(file);
+    return ok;
+}
+#else
+// Rewrite the target itself, for when no temp file can be created next to it or it has other
+// hard links. Not crash-safe: a failure midway leaves the file partly written. errno is kept.
+// Hedefin kendisini yeniden yaz; yaninda gecici dosya olusturulamadiginda veya baska sert
+// baglantilari oldugunda. Cokmeye dayanikli degildir: yarida kalan bir hata dosyayi kismen
+// yazili birakir. errno korunur.
+static bool saveInPlace(const BufferSnapshot& snap, const std::string& target, const FileEncoding& encoding,
+                        FsyncPolicy policy) {
+    int fd = ::open(target.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+    if (fd < 0) return false;
+    bool ok = writeSnapshotTo(fd, snap, encoding) && (policy == FsyncPolicy::None || ::fsync(fd) == 0);
+    int err = errno;
+    if (::close(fd) != 0 && ok) {
+        ok = false;
+        err = errno;
+    }
+    errno = err;
+    return ok;
+}
+#endif
+
+// Write a snapshot next to the target and swap it in
+// Bir anlik goruntuyu hedefin yanina yaz ve yerine gecir
+FileResult FileSystem::saveSnapshot(const BufferSnapshot& snap, const std::string& path,
+                                    const FileEncoding& encoding) {
     FileResult result{false, "", 0};
+    FsyncPolicy policy = fsyncPolicy_;
 
-    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
-    if (!file.is_open()) {
-        result.message = "Dosya yazılamadı: " + path;
+    // Text of a truncated mapped file now reads as NULs; writing it would corrupt the file
+    // Kesilmis eslenmis bir dosyanin metni artik NUL okunur; onu yazmak dosyayi bozar
+    const std::string lostMessage = "Dosya diskte kesildi, metnin bir kısmı kayboldu; kaydetme reddedildi: " + path;
+    if (snap.originalLost()) {
+        result.message = lostMessage;
         return result;
     }
 
-    try {
-        for (int i = 0; i < buffer.lineCount(); ++i) {
-            const std::string& line = buffer.getLine(i);
-            file.write(line.c_str(), static_cast<std::streamsize>(line.size()));
-            file.put('\n');
+    // Save through a symlink (or a chain of them) to the file at its end instead of replacing
+    // a link; weakly_canonical also resolves a final link whose target does not exist yet
+    // Bir sembolik baglanti (veya bir zinciri) uzerinden, bir baglantiyi degistirmek yerine sonundaki
+    // dosyaya kaydet; weakly_canonical hedefi henuz olmayan son bir baglantiyi da cozer
+    std::string target = path;
+    std::error_code ec;
+    if (fs::is_symlink(path, ec)) {
+        fs::path resolved = fs::weakly_canonical(path, ec);
+        if (!ec) target = resolved.string();
+    }
+    std::string temp = tempPathFor(target);
+
+    // A file with other hard links is rewritten in place so every link sees the new text, and
+    // so is one whose directory refuses the temp file; both give up crash safety
+    // Baska sert baglantilari olan bir dosya, her baglanti yeni metni gorsun diye yerinde
+    // yeniden yazilir; dizini gecici dosyayi reddeden de oyle; ikisi de cokme guvenliginden vazgecer
+    auto inPlace = [&](const char* why) {
+        LOG_WARN("[FileSystem] Saving ", target, " in place (", why, ")");
+        // Truncating the file the text is mapped from would turn every later read into NULs
+        // Metnin eslendigi dosyayi kesmek sonraki her okumayi NUL'a cevirirdi
+        if (!snap.detachFromFile(target)) {
+            result.message = "Eşlenmiş dosya belleğe alınamadı; yerinde kaydetme reddedildi: " + path;
+            return result;
+        }
+        if (saveInPlace(snap, target, encoding, policy)) {
+            // The file itself already holds whatever was read, so a cut during the write can
+            // only be reported
+            // Dosyanin kendisi okunani zaten tutar, bu yuzden yazma sirasindaki bir kesilme
+            // yalnizca bildirilebilir
+            if (snap.originalLost()) {
+                result.message = lostMessage;
+                return result;
+            }
+            result.success = true;
+            result.lineCount = static_cast<size_t>(snap.lineCount());
+            result.message = "Dosya başarıyla kaydedildi.";
+        } else {
+#ifdef _WIN32
+            result.message = "Dosya yazma hatası: " + path;
+#else
+            result.message = std::string("Dosya yazma hatası: ") + std::strerror(errno);
+#endif
         }
+        return result;
+    };
 
-        file.flush();
-        result.success = true;
-        result.lineCount = buffer.lineCount();
-        result.message = "Dosya başarıyla kaydedildi.";
+#ifdef _WIN32
+    HANDLE existing = CreateFileA(target.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    bool exists = existing != INVALID_HANDLE_VALUE;
+    if (exists) {
+        BY_HANDLE_FILE_INFORMATION info;
+        bool linked = GetFileInformationByHandle(existing, &info) && info.nNumberOfLinks > 1;
+        CloseHandle(existing);
+        if (linked) return inPlace("hard-linked");
     }
-    catch (const std::exception& ex) {
-        result.success = false;
-        result.message = std::string("Dosya yazma hatası: ") + ex.what();
+    HANDLE file = CreateFileA(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        if (exists) return inPlace("cannot create a temp file next to it");
+        result.message = "Dosya yazılamadı: " + path;
+        return result;
+    }
+    bool ok = writeSnapshotTo(file, snap, encoding);
+    if (ok && policy != FsyncPolicy::None) ok = FlushFileBuffers(file);
+    CloseHandle(file);
+    DWORD flags = MOVEFILE_REPLACE_EXISTING;
+    if (policy == FsyncPolicy::Full) flags |= MOVEFILE_WRITE_THROUGH;
+    const bool lost = ok && snap.originalLost();
+    if (ok && !lost) ok = MoveFileExA(temp.c_str(), target.c_str(), flags);
+    if (!ok || lost) {
+        DeleteFileA(temp.c_str());
+        result.message = lost ? lostMessage : "Dosya yazma hatası: " + path;
+        return result;
+    }
+#else
+    struct stat st;
+    const bool exists = ::stat(target.c_str(), &st) == 0;
+    if (exists && st.st_nlink > 1) return inPlace("hard-linked");
+
+    // O_EXCL on a fresh name; 0666 lets the umask decide permissions of a new file
+    // Yeni bir adda O_EXCL; 0666 yeni bir dosyanin izinlerini umask'in belirlemesine birakir
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        if (exists) return inPlace(std::strerror(errno));
+        result.message = "Dosya yazılamadı: " + path + " (" + std::strerror(errno) + ")";
+        return result;
+    }
+
+    // An existing file keeps its mode and, where permitted, its owner
+    // Mevcut bir dosya modunu ve izin verildiginde sahibini korur
+    if (exists) {
+        ::fchmod(fd, st.st_mode & 07777);
+        if (::fchown(fd, st.st_uid, st.st_gid) != 0) { /* not owner: keep ours / sahibi degil: bizimkini tut */ }
+    }
+
+    bool ok = writeSnapshotTo(fd, snap, encoding);
+    int err = ok ? 0 : errno;
+    if (ok && policy != FsyncPolicy::None && ::fsync(fd) != 0) {
+        ok = false;
+        err = errno;
+    }
+    if (::close(fd) != 0 && ok) {
+        ok = false;
+        err = errno;
+    }
+    // A mapping cut while it was being written left NULs in the temp file; never rename it in
+    // Yazilirken kesilen bir esleme gecici dosyada NUL birakti; onu asla yerine gecirme
+    const bool lost = ok && snap.originalLost();
+    if (ok && !lost && ::rename(temp.c_str(), target.c_str()) != 0) {
+        ok = false;
+        err = errno;
+    }
+    if (!ok || lost) {
+        ::unlink(temp.c_str());
+        result.message = lost ? lostMessage : std::string("Dosya yazma hatası: ") + std::strerror(err);
+        return result;
     }
 
+    // The rename lives in the directory entry; sync it too under the full policy
+    // Yeniden adlandirma dizin girdisinde yasar; tam politikada onu da esitle
+    if (policy == FsyncPolicy::Full) {
+        std::string dir = fs::path(target).parent_path().string();
+        int dfd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dfd >= 0) {
+            ::fsync(dfd);
+            ::close(dfd);
+        }
+    }
+#endif
+
+    result.success = true;
+    result.lineCount = static_cast<size_t>(snap.lineCount());
+    result.message = "Dosya başarıyla kaydedildi.";
     return result;
 }
 
@@ -221,4 +745,60 @@ bool FileSystem::hasUTF8BOM(const std::string& path) {
     unsigned char bom[3];
     file.read(reinterpret_cast<char*>(bom), 3);
     return bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF;
-}
\ No newline at end of file
+}
+
+// Set the size at which loadToBuffer switches to a memory-mapped source
+// loadToBuffer'in bellek eslemeli kaynaga gectigi boyutu ayarla
+void FileSystem::setMmapThreshold(uintmax_t bytes) {
+    mmapThreshold_ = bytes;
+}
+
+// Get the current mmap threshold in bytes
+// Mevcut mmap esigini bayt olarak al
+uintmax_t FileSystem::mmapThreshold() {
+    return mmapThreshold_;
+}
+
+// Set the size at which loadToBufferAsync opens files progressively
+// loadToBufferAsync'in dosyalari asamali actigi boyutu ayarla
+void FileSystem::setAsyncOpenThreshold(uintmax_t bytes) {
+    asyncOpenThreshold_ = bytes;
+}
+
+// Get the current progressive open threshold in bytes
+// Mevcut asamali acilis esigini bayt olarak al
+uintmax_t FileSystem::asyncOpenThreshold() {
+    return asyncOpenThreshold_;
+}
+
+// Set how many lines a progressive open indexes before returning
+// Asamali acilisin donmeden once kac satir indeksleyecegini ayarla
+void FileSystem::setAsyncPrefixLines(int lines) {
+    asyncPrefixLines_ = lines > 0 ? lines : 1;
+}
+
+// Get the synchronous prefix size of a progressive open
+// Asamali acilisin senkron onek boyutunu al
+int FileSystem::asyncPrefixLines() {
+    return asyncPrefixLines_;
+}
+
+// Set how saves flush to disk
+// Kaydetmelerin diske nasil bosaltilacagini ayarla
+void FileSystem::setFsyncPolicy(FsyncPolicy policy) {
+    fsyncPolicy_ = policy;
+}
+
+// Get the current save durability
+// Mevcut kaydetme kaliciligini al
+FsyncPolicy FileSystem::fsyncPolicy() {
+    return fsyncPolicy_;
+}
+
+// Map a config name to a policy (unknown names keep the default)
+// Bir config adini politikaya esle (bilinmeyen adlar varsayilani korur)
+FsyncPolicy FileSystem::parseFsyncPolicy(const std::string& name) {
+    if (name == "none") return FsyncPolicy::None;
+    if (name == "full") return FsyncPolicy::Full;
+    return FsyncPolicy::File;
+}
@@ -7,8 +7,13 @@
 #include <string>
 #include <optional>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "EncodingDetector.h"
 
 class Buffer;
+class BufferSnapshot;
 
 // Result of a file I/O operation (success/failure, message, line count)
 // Bir dosya giris/cikis isleminin sonucu (basari/basarisizlik, mesaj, satir sayisi)
@@ -26,20 +31,53 @@ struct FileInfo {
     std::string modified;      // Last modification time / Son degistirilme zamani
 };
 
+// When a save forces its data to disk
+// Bir kaydetmenin verisini diske ne zaman zorladigi
+enum class FsyncPolicy {
+    None,   // Leave flushing to the OS / Bosaltmayi isletim sistemine birak
+    File,   // fsync the new file before it replaces the old one / Yeni dosyayi eskisinin yerine gecmeden once fsync et
+    Full    // Also fsync the directory so the rename itself survives a power loss / Yeniden adlandirmanin da guc kesintisinden sag cikmasi icin dizini de fsync et
+};
+
 // Static file system operations for loading, saving, and managing files.
 // Dosya yukleme, kaydetme ve yonetme icin statik dosya sistemi islemleri.
 // Platform-independent file I/O through C++ std::filesystem.
 // C++ std::filesystem araciligiyla platform bagimsiz dosya giris/cikis.
 class FileSystem {
 public:
-    // Load a file into a buffer (handles UTF-8 BOM, CRLF normalization)
-    // Bir dosyayi buffer'a yukle (UTF-8 BOM, CRLF normalizasyonunu yonetir)
+    // Load progress callback: (lines readable, bytes indexed, total bytes, finished)
+    // Yukleme ilerleme geri cagirimi: (okunabilir satirlar, indekslenen baytlar, toplam bayt, bitti)
+    using LoadProgressFn = std::function<void(int lines, size_t bytes, size_t total, bool done)>;
+
+    // Load a file into a buffer (handles BOMs, CRLF normalization). UTF-16, UTF-32 and Latin-1
+    // files are decoded to UTF-8 block by block and the buffer remembers their encoding.
+    // Bir dosyayi buffer'a yukle (BOM'lari, CRLF normalizasyonunu yonetir). UTF-16, UTF-32 ve
+    // Latin-1 dosyalar blok blok UTF-8'e cozulur ve buffer kodlamalarini hatirlar.
     static FileResult loadToBuffer(Buffer& buffer, const std::string& path);
 
-    // Save buffer content to a file
-    // Buffer icerigini bir dosyaya kaydet
+    // Load a file progressively: large files return once the first lines are readable and the
+    // rest is indexed on a background thread, reporting through onProgress (always ends with done)
+    // Bir dosyayi asamali yukle: buyuk dosyalar ilk satirlar okunabilir olunca doner, geri kalani
+    // arka plan thread'inde indekslenir ve onProgress ile bildirilir (her zaman done ile biter)
+    static FileResult loadToBufferAsync(Buffer& buffer, const std::string& path, LoadProgressFn onProgress);
+
+    // Save buffer content to a file in the buffer's encoding
+    // Buffer icerigini buffer'in kodlamasiyla bir dosyaya kaydet
     static FileResult saveFromBuffer(const Buffer& buffer, const std::string& path);
 
+    // Write a snapshot crash-safely: vectored writes into a temp file next to the target,
+    // fsync per policy, then an atomic rename over it. The old file stays intact on any failure.
+    // Bir anlik goruntuyu cokmeye dayanikli yaz: hedefin yanindaki gecici dosyaya vektorel
+    // yazimlar, politikaya gore fsync, sonra ustune atomik yeniden adlandirma. Herhangi bir
+    // hatada eski dosya bozulmadan kalir. Text is encoded in blocks unless encoding is UTF-8.
+    // Metin, kodlama UTF-8 degilse bloklar halinde kodlanir.
+    // Symlink chains are followed to the final file. A hard-linked target, or one whose directory
+    // refuses the temp file, is rewritten in place instead, without the crash-safety guarantee.
+    // Sembolik baglanti zincirleri son dosyaya kadar izlenir. Sert baglantili bir hedef veya dizini
+    // gecici dosyayi reddeden bir hedef, cokme guvencesi olmadan yerinde yeniden yazilir.
+    static FileResult saveSnapshot(const BufferSnapshot& snapshot, const std::string& path,
+                                   const FileEncoding& encoding = {});
+
     // Load entire file as a raw text string
     // Tum dosyayi ham metin dizesi olarak yukle
     static std::optional<std::string> loadTextFile(const std::string& path);
@@ -79,4 +117,31 @@ public:
     // Check if a file starts with UTF-8 BOM bytes
     // Bir dosyanin UTF-8 BOM byte'lariyla baslayip baslamadigini kontrol et
     static bool hasUTF8BOM(const std::string& path);
+
+    // Files at or above this size are memory-mapped instead of read into memory (0 = never)
+    // Bu boyuttaki veya daha buyuk dosyalar bellege okunmak yerine eslenir (0 = asla)
+    static void setMmapThreshold(uintmax_t bytes);
+    static uintmax_t mmapThreshold();
+
+    // Files at or above this size are opened progressively by loadToBufferAsync (0 = never)
+    // Bu boyuttaki veya daha buyuk dosyalar loadToBufferAsync ile asamali acilir (0 = asla)
+    static void setAsyncOpenThreshold(uintmax_t bytes);
+    static uintmax_t asyncOpenThreshold();
+
+    // Lines indexed synchronously before a progressive open returns
+    // Asamali acilis donmeden once senkron indekslenen satirlar
+    static void setAsyncPrefixLines(int lines);
+    static int asyncPrefixLines();
+
+    // Durability of saves ("none", "file" or "full" in config)
+    // Kaydetmelerin kaliciligi (config'te "none", "file" veya "full")
+    static void setFsyncPolicy(FsyncPolicy policy);
+    static FsyncPolicy fsyncPolicy();
+    static FsyncPolicy parseFsyncPolicy(const std::string& name);
+
+private:
+    static std::atomic<uintmax_t> mmapThreshold_;  // Size limit for mmap loading / mmap yukleme boyut siniri
+    static std::atomic<uintmax_t> asyncOpenThreshold_;  // Size limit for progressive open / Asamali acilis boyut siniri
+    static std::atomic<int> asyncPrefixLines_;     // Lines ready when open returns / Acilis dondugunde hazir satirlar
+    static std::atomic<FsyncPolicy> fsyncPolicy_;  // Save durability / Kaydetme kaliciligi
 };
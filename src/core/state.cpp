@@ -54,9 +54,16 @@ const Selection& EditorState::getSelection() const {
     return selection_;
 }
 
-// Return a reference to the undo manager
-// Geri alma yoneticisine referans dondur
+// Return a reference to the undo manager, replaying its undofile on first access
+// Geri alma yoneticisine referans dondur, ilk erisimde geri alma dosyasini tekrar oynat
 UndoManager& EditorState::getUndo() {
+    undo_.ensureLoaded();
+    return undo_;
+}
+
+// Read-only access does not trigger the replay
+// Salt okunur erisim tekrar oynatmayi tetiklemez
+const UndoManager& EditorState::getUndo() const {
     return undo_;
 }
 
@@ -84,6 +91,21 @@ const std::string& EditorState::getFilePath() const {
     return status_.filePath;
 }
 
+// The event thread copies the pointer while commands replace it, so both sides lock; the copy
+// keeps a session alive for a refresh that overlaps its replacement
+// Olay thread'i isaretciyi kopyalarken komutlar onu degistirir, bu yuzden iki taraf da kilitler;
+// kopya, degistirilmesiyle cakisan bir yenileme icin oturumu canli tutar
+std::shared_ptr<SearchSession> EditorState::getSearchSession() const {
+    std::lock_guard<std::mutex> lock(searchMutex_);
+    return searchSession_;
+}
+
+// Swapped in, so the old session is released after the lock (at the end of the call)
+// Degis tokus edilir, boylece eski oturum kilitten sonra (cagrinin sonunda) birakilir
+void EditorState::setSearchSession(std::shared_ptr<SearchSession> session) {
+    std::lock_guard<std::mutex> lock(searchMutex_);
+    searchSession_.swap(session);
+}
 
 // Reset the entire editor state: clear buffer, cursor, undo, and file info
 // Tum editor durumunu sifirla: tampon, imlec, geri alma ve dosya bilgisi
@@ -94,6 +116,7 @@ void EditorState::reset() {
     undo_ = UndoManager();      // Undo geçmişini sıfırla
     status_ = {};               // Dosya durumunu sıfırla
     mode_ = EditMode::Normal;   // Modu tekrar normal yap
+    setSearchSession(nullptr);  // Arama oturumunu birak
 }
 
 // Sync cursor position to stay within buffer boundaries
@@ -5,12 +5,15 @@
 
 #pragma once
 #include <memory>
+#include <mutex>
 #include <string>
 #include "buffer.h"
 #include "cursor.h"
 #include "undo.h"
 #include "Selection.h"
 
+class SearchSession;
+
 // Editor working modes: Normal (navigation), Insert (typing), Visual (selection)
 // Editor calisma modlari: Normal (gezinme), Insert (yazma), Visual (secim)
 enum class EditMode { Normal, Insert, Visual };
@@ -63,10 +66,14 @@ public:
     // Secime eris (salt okunur)
     const Selection& getSelection() const;
 
-    // Access the undo manager
-    // Geri alma yoneticisine eris
+    // Access the undo manager (replays a persisted history on first access)
+    // Geri alma yoneticisine eris (kalici bir gecmisi ilk erisimde tekrar oynatir)
     UndoManager& getUndo();
 
+    // Access the undo manager (read-only)
+    // Geri alma yoneticisine eris (salt okunur)
+    const UndoManager& getUndo() const;
+
     // Mark the document as modified or unmodified
     // Belgeyi degistirilmis veya degistirilmemis olarak isaretle
     void markModified(bool state = true);
@@ -83,6 +90,14 @@ public:
     // Bu belgeyle iliskili dosya yolunu al
     const std::string& getFilePath() const;
 
+    // Search results kept current as this document is edited (null while no session runs)
+    // Bu belge duzenlendikce guncel tutulan arama sonuclari (oturum yokken null)
+    std::shared_ptr<SearchSession> getSearchSession() const;
+
+    // Start or drop (nullptr) the search session of this document
+    // Bu belgenin arama oturumunu baslat veya birak (nullptr)
+    void setSearchSession(std::shared_ptr<SearchSession> session);
+
     // Reset entire state to a clean new document
     // Tum durumu temiz yeni bir belgeye sifirla
     void reset();
@@ -98,4 +113,6 @@ private:
     UndoManager undo_;         // Undo/redo system / Geri al/yinele sistemi
     EditMode mode_;            // Current editing mode / Mevcut duzenleme modu
     EditorStatus status_;      // File status info / Dosya durum bilgileri
+    std::shared_ptr<SearchSession> searchSession_;  // Highlighted search, if any / Varsa vurgulanan arama
+    mutable std::mutex searchMutex_;                // Guards searchSession_ / searchSession_'i korur
 };
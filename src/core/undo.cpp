@@ -4,29 +4,124 @@
 // See LICENSE file in the project root for full license text.
 
 #include "undo.h"
+#include "UndoFile.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// Wall clock, since "as of T" is asked in wall-clock terms and survives restarts via the undofile
+// Duvar saati, cunku "T anindaki" duvar saatiyle sorulur ve geri alma dosyasiyla yeniden baslatmalari atlatir
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+const char* actionTypeName(ActionType type) {
+    switch (type) {
+        case ActionType::Insert: return "insert";
+        case ActionType::Delete: return "delete";
+        case ActionType::InsertLine: return "insertLine";
+        case ActionType::DeleteLine: return "deleteLine";
+        case ActionType::InsertText: return "insertText";
+        case ActionType::DeleteRange: return "deleteRange";
+    }
+    return "unknown";
+}
+
+// Default history budget per buffer (config "undo.memory_limit_mb")
+// Buffer basina varsayilan gecmis butcesi (config "undo.memory_limit_mb")
+std::atomic<size_t> UndoManager::memoryLimit_{64ull * 1024 * 1024};
 
 // Constructor: create the root node of the undo tree
 // Kurucu: geri alma agacinin kok dugumunu olustur
 UndoManager::UndoManager() {
-    root = std::make_shared<UndoNode>();
-    current = root;
+    nodes_.emplace_back();
+    nodes_[0].seq = seq_++;
+    root_ = current_ = 0;
 }
 
 // Record a new action as a child branch of the current undo node
 // Yeni bir eylemi mevcut geri alma dugumunun alt dali olarak kaydet
 void UndoManager::addAction(const Action& action) {
-    auto node = std::make_shared<UndoNode>();
-    node->action = action;
-    node->parent = current;
-    current->branches.push_back(node);
-    current->activeBranch = (int)current->branches.size() - 1;
-    current = node;
+    ensureLoaded();
+    if (journal_ && !journalStarted_ && !loadPending_) writeTree(rootHash_, current_);
+    if (coalesce(action)) return;
+
+    int idx = allocNode();
+    UndoNode& node = nodes_[idx];
+    node.type = action.type;
+    node.line = action.line;
+    node.col = action.col;
+    node.lineEnd = action.lineEnd;
+    node.colEnd = action.colEnd;
+    node.textOff = text_.size();
+    if (action.type == ActionType::Insert || action.type == ActionType::Delete) {
+        text_ += action.character;
+        node.textLen = 1;
+    } else {
+        text_ += action.lineContent;
+        node.textLen = static_cast<uint32_t>(action.lineContent.size());
+    }
+    if (action.type == ActionType::DeleteRange && action.removedFrom) {
+        node.ref = holdRef(action.removedFrom,
+                           action.removedFrom->addBytes(action.line, action.lineEnd - action.line + 1));
+    }
+    node.seq = seq_++;
+    node.time = nowMs();
+    linkChild(current_, idx);
+    if (UndoFile* j = log()) journalNode(*j, nodes_[idx], nodes_[current_].seq);
+    current_ = idx;
+
+    runOpen_ = (action.type == ActionType::Insert || action.type == ActionType::Delete) &&
+               action.character != '\n';
 
     // Track group action count if inside a group
     // Grup icindeyse grup eylem sayacini takip et
     if (groupDepth_ > 0) {
         groupActionCount_++;
     }
+
+    enforceLimit();
+}
+
+// A keystroke joins the open run when it continues it on the same line: typing forward,
+// Delete at a fixed column, or Backspace walking left. A space after a word starts a new run.
+// Bir tus ayni satirda acik diziyi surdururse ona katilir: ileri yazma, sabit sutunda Delete
+// veya sola yuruyen Backspace. Bir kelimeden sonraki bosluk yeni bir dizi baslatir.
+bool UndoManager::coalesce(const Action& a) {
+    if (!runOpen_ || current_ == root_) return false;
+    if (a.type != ActionType::Insert && a.type != ActionType::Delete) return false;
+    if (a.character == '\n' || a.character == '\0') return false;
+
+    UndoNode& n = nodes_[current_];
+    if (n.type != a.type || n.line != a.line || n.firstChild >= 0) return false;
+    if (n.textOff + n.textLen != text_.size()) return false;
+
+    char last = text_.back();
+    bool space = a.character == ' ' || a.character == '\t';
+    if (space && last != ' ' && last != '\t') return false;
+
+    if (a.type == ActionType::Insert) {
+        if (a.col != n.col + static_cast<int>(n.textLen)) return false;
+    } else if (a.col == n.col && (!n.backward || n.textLen == 1)) {
+        n.backward = false;
+    } else if (a.col == n.col - 1 && (n.backward || n.textLen == 1)) {
+        n.backward = true;
+        n.col = a.col;
+    } else {
+        return false;
+    }
+
+    text_ += a.character;
+    n.textLen++;
+    n.time = nowMs();
+    if (UndoFile* j = log()) j->extend(n.seq, n.col, n.backward, a.character, n.time);
+    return true;
 }
 
 // Begin a group of actions that undo/redo as a single step
@@ -34,10 +129,43 @@ void UndoManager::addAction(const Action& action) {
 void UndoManager::beginGroup() {
     if (groupDepth_ == 0) {
         groupActionCount_ = 0;
+        runOpen_ = false;
     }
     groupDepth_++;
 }
 
+// Each edit is a deletion of the old range (kept by reference when applyEdits did) followed
+// by an insertion, so one undo reverses the batch exactly
+// Her duzenleme eski araligin silinmesi (applyEdits oyle yaptiysa referansla tutulur) ve
+// ardindan bir eklemedir, boylece tek bir geri alma grubu tam olarak tersine cevirir
+void UndoManager::addEdits(const std::vector<AppliedEdit>& applied) {
+    if (applied.empty()) return;
+    beginGroup();
+    for (const auto& a : applied) {
+        const TextEdit& e = a.edit;
+        if (!a.removed.empty() || a.removedFrom) {
+            Action del;
+            del.type = ActionType::DeleteRange;
+            del.line = e.startLine;
+            del.col = e.startCol;
+            del.lineContent = a.removed;
+            del.removedFrom = a.removedFrom;
+            del.lineEnd = e.endLine;
+            del.colEnd = e.endCol;
+            addAction(del);
+        }
+        if (!e.text.empty()) {
+            Action ins;
+            ins.type = ActionType::InsertText;
+            ins.line = e.startLine;
+            ins.col = e.startCol;
+            ins.lineContent = e.text;
+            addAction(ins);
+        }
+    }
+    endGroup();
+}
+
 // End the current action group, marking the last node with group size
 // Mevcut eylem grubunu bitir, son dugumu grup boyutuyla isaretle
 void UndoManager::endGroup() {
@@ -46,9 +174,11 @@ void UndoManager::endGroup() {
 
     // When outermost group ends, mark current node with the count
     // En distaki grup bittiginde, mevcut dugumu sayacla isaretle
-    if (groupDepth_ == 0 && groupActionCount_ > 0 && current) {
-        current->groupSize = groupActionCount_;
+    if (groupDepth_ == 0 && groupActionCount_ > 0) {
+        nodes_[current_].groupSize = groupActionCount_;
+        if (UndoFile* j = log()) j->group(nodes_[current_].seq, groupActionCount_);
         groupActionCount_ = 0;
+        runOpen_ = false;
     }
 }
 
@@ -61,15 +191,17 @@ bool UndoManager::inGroup() const {
 // Undo the last action (or entire group) by reversing it on the buffer
 // Son eylemi (veya tum grubu) tampon uzerinde tersine cevirerek geri al
 bool UndoManager::undo(Buffer& buf) {
-    if (!current || !current->parent) return false;
+    ensureLoaded();
+    if (current_ == root_) return false;
+    runOpen_ = false;
 
     // If current node ends a group, undo all actions in the group
     // Mevcut dugum bir grubu bitiriyorsa, gruptaki tum eylemleri geri al
-    int count = (current->groupSize > 0) ? current->groupSize : 1;
+    int count = (nodes_[current_].groupSize > 0) ? nodes_[current_].groupSize : 1;
     for (int i = 0; i < count; ++i) {
-        if (!current || !current->parent) break;
-        applyUndo(current->action, buf);
-        current = current->parent;
+        if (current_ == root_) break;
+        applyUndo(nodes_[current_], buf);
+        current_ = nodes_[current_].parent;
     }
     return true;
 }
@@ -77,46 +209,35 @@ bool UndoManager::undo(Buffer& buf) {
 // Redo the next action (or entire group) along the active branch
 // Aktif dal boyunca bir sonraki eylemi (veya tum grubu) yeniden uygula
 bool UndoManager::redo(Buffer& buf) {
-    if (!current || current->branches.empty()) return false;
-    int idx = current->activeBranch;
-    if (idx < 0 || idx >= (int)current->branches.size()) return false;
-
-    // Walk forward to find the group end node, then replay all
-    // Grup sonu dugumunu bulmak icin ileri yuru, sonra hepsini tekrar oynat
-    current = current->branches[idx];
-    applyRedo(current->action, buf);
-
-    // If this starts a group, continue redo until group end
-    // Eger bu bir grup baslangiciysa, grup sonuna kadar redo'ya devam et
-    if (current->groupSize == 0) {
-        // Check if the last node of a group chain is ahead
-        // Bir grup zincirinin son dugumunun ileride olup olmadigini kontrol et
-        // Single action, nothing more to do
-        // Tek eylem, yapilacak baska sey yok
-    } else {
-        // This is a group end node from undo perspective; on redo we already replayed one
-        // Bu geri alma perspektifinden bir grup sonu dugumu; yeniden yapmada birini zaten tekrar oynadik
-        // We need to redo (groupSize - 1) more actions forward... but they are individual nodes
-        // (groupSize - 1) daha fazla eylemi ileri dogru yeniden yapmamiz gerekiyor... ama bunlar bireysel dugumler
-    }
-
-    // Walk forward for grouped actions (they are chained as single-child branches)
-    // Gruplu eylemler icin ileri yuru (tek cocuk dallar olarak zincirlenmisler)
-    while (!current->branches.empty()) {
-        auto& next = current->branches;
-        if (next.size() != 1) break;  // Fork means user edited after undo / Fork, kullanicinin undo'dan sonra duzenleme yaptigini gosterir
-        auto& nextNode = next[0];
-        if (nextNode->groupSize > 0) {
-            // This is the end of a group chain - redo remaining
-            // Bu bir grup zincirinin sonu - kalanlari yeniden yap
-            int remaining = nextNode->groupSize - 1;
-            for (int i = 0; i < remaining && !current->branches.empty(); ++i) {
-                current = current->branches[current->activeBranch];
-                applyRedo(current->action, buf);
+    ensureLoaded();
+    int next = nodes_[current_].activeChild;
+    if (next < 0) return false;
+    runOpen_ = false;
+
+    // Replay the next node along the active branch
+    // Aktif dal boyunca sonraki dugumu tekrar oynat
+    current_ = next;
+    applyRedo(nodes_[current_], buf);
+
+    // Groups are marked only on their last node: if the first marked node ahead closes a
+    // group that starts here, replay the rest of it
+    // Gruplar yalnizca son dugumlerinde isaretlidir: ilerideki ilk isaretli dugum burada
+    // baslayan bir grubu kapatiyorsa kalanini tekrar oynat
+    if (nodes_[current_].groupSize == 0) {
+        int dist = 1;
+        int probe = current_;
+        while (nodes_[probe].activeChild >= 0) {
+            probe = nodes_[probe].activeChild;
+            ++dist;
+            if (nodes_[probe].groupSize == 0) continue;
+            if (nodes_[probe].groupSize == dist) {
+                for (int i = 1; i < dist; ++i) {
+                    current_ = nodes_[current_].activeChild;
+                    applyRedo(nodes_[current_], buf);
+                }
             }
             break;
         }
-        break; // Only redo to the next fork / Yalnizca bir sonraki catala kadar yeniden yap
     }
 
     return true;
@@ -125,38 +246,714 @@ bool UndoManager::redo(Buffer& buf) {
 // Switch to a different undo branch at the current node
 // Mevcut dugumde farkli bir geri alma dalina gec
 void UndoManager::branch(int index) {
-    if (!current) return;
-    if (index < 0 || index >= (int)current->branches.size()) return;
-    current->activeBranch = index;
+    ensureLoaded();
+    if (index < 0) return;
+    int child = nodes_[current_].firstChild;
+    for (int i = 0; child >= 0 && i < index; ++i) child = nodes_[child].nextSibling;
+    if (child < 0) return;
+    nodes_[current_].activeChild = child;
+    runOpen_ = false;
+    if (UndoFile* j = log()) j->active(nodes_[current_].seq, nodes_[child].seq);
+}
+
+// Ids are node seq numbers; 0 marks a freed slot, so it never names a node
+// Kimlikler dugum seq numaralaridir; 0 bosaltilmis bir yuvayi isaret eder, bu yuzden hicbir dugumu adlandirmaz
+bool UndoManager::gotoNode(uint32_t id, Buffer& buf) {
+    ensureLoaded();
+    if (id == 0) return false;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].seq == id) return travel(groupEnd(static_cast<int>(i)), buf);
+    }
+    return false;
+}
+
+// Ties on the clock go to the later node
+// Saatte esitlik daha sonraki dugume gider
+bool UndoManager::gotoTime(int64_t unixMs, Buffer& buf) {
+    ensureLoaded();
+    int best = root_;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        const UndoNode& n = nodes_[i];
+        if (n.seq == 0 || static_cast<int>(i) == root_ || n.time > unixMs) continue;
+        if (best == root_ || n.time > nodes_[best].time ||
+            (n.time == nodes_[best].time && n.seq > nodes_[best].seq)) {
+            best = static_cast<int>(i);
+        }
+    }
+    return travel(groupEnd(best), buf);
+}
+
+// Same probe as redo, from anywhere inside the group: members are recorded as a chain of
+// first children, so the group holds node if the first marked node down that chain is
+// within its size. Landing short of it would leave the group half applied.
+// redo ile ayni yoklama, grubun icinde herhangi bir yerden: uyeler ilk cocuklar zinciri olarak
+// kaydedilir, bu yuzden o zincirdeki ilk isaretli dugum boyutu icindeyse grup dugumu tutar.
+// Ondan once durmak grubu yarim uygulanmis birakirdi.
+int UndoManager::groupEnd(int node) const {
+    if (node == root_ || nodes_[node].groupSize > 0) return node;
+    int dist = 1;
+    for (int probe = nodes_[node].firstChild; probe >= 0; probe = nodes_[probe].firstChild) {
+        ++dist;
+        if (nodes_[probe].groupSize == 0) continue;
+        return nodes_[probe].groupSize >= dist ? probe : node;
+    }
+    return node;
+}
+
+// Depths first, so finding the common ancestor only walks the two paths involved
+// Once derinlikler, boylece ortak atayi bulmak yalnizca ilgili iki yolu yurur
+bool UndoManager::travel(int target, Buffer& buf) {
+    if (target == current_) return false;
+    runOpen_ = false;
+
+    auto depth = [this](int n) {
+        int d = 0;
+        for (; nodes_[n].parent >= 0; n = nodes_[n].parent) ++d;
+        return d;
+    };
+    int up = current_, down = target;
+    int du = depth(up), dd = depth(down);
+    std::vector<int> descent;
+    while (dd > du) { descent.push_back(down); down = nodes_[down].parent; --dd; }
+    while (du > dd) { up = nodes_[up].parent; --du; }
+    while (up != down) {
+        descent.push_back(down);
+        down = nodes_[down].parent;
+        up = nodes_[up].parent;
+    }
+
+    for (; current_ != up; current_ = nodes_[current_].parent) applyUndo(nodes_[current_], buf);
+    for (auto it = descent.rbegin(); it != descent.rend(); ++it) {
+        UndoNode& parent = nodes_[current_];
+        if (parent.activeChild != *it) {
+            parent.activeChild = *it;
+            if (UndoFile* j = log()) j->active(parent.seq, nodes_[*it].seq);
+        }
+        current_ = *it;
+        applyRedo(nodes_[current_], buf);
+    }
+    return true;
+}
+
+// Id of the node the buffer currently matches
+// Buffer'in su an eslestigi dugumun kimligi
+uint32_t UndoManager::currentId() const {
+    return nodes_[current_].seq;
+}
+
+// Id of the oldest node still kept (trimming moves the root forward)
+// Hala tutulan en eski dugumun kimligi (budama koku ileri tasir)
+uint32_t UndoManager::rootId() const {
+    return nodes_[root_].seq;
+}
+
+// Same order writeTree journals in
+// writeTree'nin gunluge yazdigi siranin aynisi
+std::vector<UndoNodeInfo> UndoManager::tree() const {
+    std::vector<UndoNodeInfo> out;
+    out.reserve(nodeCount());
+    std::vector<int> stack{root_};
+    std::vector<int> kids;
+    while (!stack.empty()) {
+        int idx = stack.back();
+        stack.pop_back();
+        const UndoNode& n = nodes_[idx];
+        UndoNodeInfo info;
+        info.id = n.seq;
+        info.parent = n.parent >= 0 ? nodes_[n.parent].seq : 0;
+        info.activeChild = n.activeChild >= 0 ? nodes_[n.activeChild].seq : 0;
+        info.type = n.type;
+        info.line = n.line;
+        info.col = n.col;
+        info.textLen = n.textLen;
+        info.groupSize = n.groupSize;
+        info.time = n.time;
+        out.push_back(info);
+        kids.clear();
+        for (int c = n.firstChild; c >= 0; c = nodes_[c].nextSibling) kids.push_back(c);
+        stack.insert(stack.end(), kids.rbegin(), kids.rend());
+    }
+    return out;
 }
 
 // Return the number of branches at the current undo node
 // Mevcut geri alma dugumundeki dal sayisini dondur
 int UndoManager::branchCount() const {
-    return current ? (int)current->branches.size() : 0;
+    int count = 0;
+    for (int c = nodes_[current_].firstChild; c >= 0; c = nodes_[c].nextSibling) ++count;
+    return count;
 }
 
 // Return the index of the currently active branch
 // Su an aktif olan dalin indeksini dondur
 int UndoManager::currentBranch() const {
-    return current ? current->activeBranch : -1;
+    int i = 0;
+    for (int c = nodes_[current_].firstChild; c >= 0; c = nodes_[c].nextSibling, ++i) {
+        if (c == nodes_[current_].activeChild) return i;
+    }
+    return -1;
+}
+
+// Close the open run
+// Acik diziyi kapat
+void UndoManager::breakRun() {
+    runOpen_ = false;
+}
+
+// Live nodes: the pool minus the free list
+// Canli dugumler: havuz eksi serbest liste
+size_t UndoManager::nodeCount() const {
+    return nodes_.size() - free_.size();
+}
+
+// Live nodes plus live text; freed slots and dead text are reused or compacted away. A
+// by-reference deletion counts the add-buffer lines its table keeps alive: once the buffer
+// collects them, the record is what holds them. Original lines are mapped or shared with the
+// document and are not charged.
+// Canli dugumler arti canli metin; serbest yuvalar ve olu metin yeniden kullanilir veya
+// sikistirilir. Referansli bir silme, tablosunun canli tuttugu ekleme arabellegi satirlarini
+// sayar: buffer onlari topladiginda onlari tutan kayittir. Original satirlar eslenmis veya
+// belgeyle paylasilmistir ve sayilmaz.
+size_t UndoManager::memoryUsage() const {
+    return nodeCount() * sizeof(UndoNode) + (text_.size() - deadText_) +
+           (refs_.size() - freeRefs_.size()) * sizeof(refs_[0]) + pinnedBytes_;
+}
+
+// Take a free ref slot (or a new one) for a deletion's table
+// Bir silmenin tablosu icin bos bir ref yuvasi (veya yenisini) al
+int UndoManager::holdRef(std::shared_ptr<const PieceTable> table, uint64_t bytes) {
+    int ref;
+    if (freeRefs_.empty()) {
+        ref = static_cast<int>(refs_.size());
+        refs_.push_back(std::move(table));
+        refBytes_.push_back(bytes);
+    } else {
+        ref = freeRefs_.back();
+        freeRefs_.pop_back();
+        refs_[ref] = std::move(table);
+        refBytes_[ref] = bytes;
+    }
+    pinnedBytes_ += static_cast<size_t>(bytes);
+    return ref;
+}
+
+// Drop a ref's table and its charge; -1 is ignored
+// Bir ref'in tablosunu ve yukunu birak; -1 yok sayilir
+void UndoManager::releaseRef(int ref) {
+    if (ref < 0) return;
+    refs_[ref].reset();
+    pinnedBytes_ -= static_cast<size_t>(refBytes_[ref]);
+    refBytes_[ref] = 0;
+    freeRefs_.push_back(ref);
+}
+
+// Shared by every buffer (0 = unlimited); each tree applies it at its next edit
+// Tum buffer'larca paylasilir (0 = sinirsiz); her agac onu bir sonraki duzenlemesinde uygular
+void UndoManager::setMemoryLimit(size_t bytes) {
+    memoryLimit_ = bytes;
+}
+
+// Current history budget per buffer in bytes
+// Buffer basina mevcut gecmis butcesi, bayt olarak
+size_t UndoManager::memoryLimit() {
+    return memoryLimit_;
+}
+
+// A fresh tree defers the journal until first use; one with history is written out whole. A
+// file still loading is hashed by a worker owned by baseHash_, which waits for the background
+// indexer there (never indexing in its place) and gives up if loading is cancelled.
+// Yeni bir agac gunlugu ilk kullanima erteler; gecmisi olan biri tumuyle yazilir. Hala
+// yuklenen bir dosya baseHash_'in sahip oldugu bir calisan tarafindan ozetlenir; calisan arka
+// plan indeksleyiciyi orada bekler (asla onun yerine indekslemez) ve yukleme iptal edilirse vazgecer.
+void UndoManager::persistTo(std::shared_ptr<UndoFile> journal, const BufferSnapshot& base) {
+    if (!journal) return;
+    if (journal_ && journal_->journalPath() == journal->journalPath()) return;
+    if (!journal_ && nodeCount() == 1) {
+        journal_ = std::move(journal);
+        baseHash_ = std::make_shared<BaseHash>();
+        loadPending_ = true;
+        if (!base.isLoading()) {
+            baseHash_->value = UndoFile::hashContent(base);
+            baseHash_->ready.store(true, std::memory_order_release);
+            return;
+        }
+        BaseHash* hash = baseHash_.get();
+        hash->worker = std::thread([hash, base] {
+            hash->valid = base.awaitLoaded(hash->cancel);
+            if (hash->valid) hash->value = UndoFile::hashContent(base.completed(), &hash->cancel);
+            hash->ready.store(true, std::memory_order_release);
+        });
+        return;
+    }
+    ensureLoaded();
+    loadPending_ = false;  // Rebinding before the hash landed gives up the old history / Ozet gelmeden yeniden baglamak eski gecmisten vazgecer
+    baseHash_.reset();
+    if (journal_) journal_->flush();
+    journal_ = std::move(journal);
+    writeTree(std::nullopt, current_);
+}
+
+// Replaying happens here, on first use, so opening a file with a long history costs nothing
+// until undo is actually touched. Edits made while the hash was pending hang off the root,
+// which holds the opened text, so they move below the saved node replay resumes at. A root
+// the memory limit promoted meanwhile (seq no longer 1) no longer holds that text.
+// Tekrar oynatma burada, ilk kullanimda olur; boylece uzun gecmisli bir dosyayi acmak geri
+// alma gercekten kullanilana kadar hicbir sey tutmaz. Ozet beklenirken yapilan duzenlemeler
+// acilan metni tutan kokten sarkar, bu yuzden tekrar oynatmanin devam ettigi kaydedilmis
+// dugumun altina tasinirlar. Bu arada bellek sinirinin terfi ettirdigi bir kok (seq artik 1
+// degil) o metni tutmaz.
+void UndoManager::ensureLoaded() {
+    if (!loadPending_ || !baseHash_->ready.load(std::memory_order_acquire)) return;
+    uint64_t hash = baseHash_->value;
+    bool hashed = baseHash_->valid;
+    UndoManager live = std::move(*this);
+    live.loadPending_ = false;
+    live.baseHash_.reset();
+    bool rootKept = hashed && live.nodes_[live.root_].seq == 1;
+
+    *this = UndoManager();
+    journal_ = live.journal_;
+    size_t records = 0;
+    bool torn = false;
+    if (rootKept && replay(hash, records, torn)) {
+        journalStarted_ = true;
+        // Rewrite once dead records dominate, and always after a torn tail
+        // Olu kayitlar baskin oldugunda ve her zaman yarim bir kuyruktan sonra yeniden yaz
+        if (torn || records > 2 * nodeCount() + 1024) writeTree(hash, current_);
+        graft(live);
+        enforceLimit();
+        return;
+    }
+
+    // Nothing usable on disk: the journal starts over with the opened text at the root
+    // Diskte kullanilabilir bir sey yok: gunluk kokte acilan metinle bastan baslar
+    *this = std::move(live);
+    if (rootKept) rootHash_ = hash;
+    if (nodeCount() > 1) writeTree(rootHash_, root_);
+}
+
+// Preorder, so every parent is mapped and journaled before its children
+// On sira, boylece her ebeveyn cocuklarindan once eslenir ve gunluge yazilir
+void UndoManager::graft(const UndoManager& live) {
+    std::vector<int> map(live.nodes_.size(), -1);
+    map[live.root_] = current_;
+    std::vector<int> order;
+    std::vector<int> stack;
+    for (int c = live.nodes_[live.root_].firstChild; c >= 0; c = live.nodes_[c].nextSibling) stack.push_back(c);
+    std::reverse(stack.begin(), stack.end());
+    while (!stack.empty()) {
+        int from = stack.back();
+        stack.pop_back();
+        const UndoNode& src = live.nodes_[from];
+        int idx = allocNode();
+        UndoNode& n = nodes_[idx];
+        n.type = src.type;
+        n.backward = src.backward;
+        n.line = src.line;
+        n.col = src.col;
+        n.lineEnd = src.lineEnd;
+        n.colEnd = src.colEnd;
+        n.groupSize = src.groupSize;
+        n.time = src.time;
+        if (src.ref >= 0) {
+            n.ref = holdRef(live.refs_[src.ref], live.refBytes_[src.ref]);
+        } else {
+            n.textOff = text_.size();
+            n.textLen = src.textLen;
+            text_.append(live.text_, src.textOff, src.textLen);
+        }
+        n.seq = seq_++;
+        linkChild(map[src.parent], idx);
+        map[from] = idx;
+        order.push_back(from);
+        if (UndoFile* j = log()) journalNode(*j, nodes_[idx], nodes_[map[src.parent]].seq);
+
+        size_t mark = stack.size();
+        for (int c = src.firstChild; c >= 0; c = live.nodes_[c].nextSibling) stack.push_back(c);
+        std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(mark), stack.end());
+    }
+
+    // linkChild left each parent on its last branch; restore live's redo targets
+    // linkChild her ebeveyni son dalinda birakti; live'in yineleme hedeflerini geri yukle
+    order.push_back(live.root_);
+    for (int from : order) {
+        int active = live.nodes_[from].activeChild;
+        if (active < 0 || nodes_[map[from]].activeChild == map[active]) continue;
+        nodes_[map[from]].activeChild = map[active];
+        if (UndoFile* j = log()) j->active(nodes_[map[from]].seq, nodes_[map[active]].seq);
+    }
+
+    current_ = map[live.current_];
+    runOpen_ = live.runOpen_;
+    groupDepth_ = live.groupDepth_;
+    groupActionCount_ = live.groupActionCount_;
+}
+
+// Journal this history is written to, or null
+// Bu gecmisin yazildigi gunluk veya null
+std::shared_ptr<UndoFile> UndoManager::journal() const {
+    return journal_;
+}
+
+// kNone when there is no journal to tie the save to
+// Kaydetmenin baglanacagi bir gunluk yoksa kNone
+uint32_t UndoManager::savePoint() {
+    ensureLoaded();
+    if (loadPending_) {
+        // Saved before the opened text was hashed: the journal restarts from this tree, since
+        // the saver needs a node id that a later graft would renumber
+        // Acilan metin ozetlenmeden kaydedildi: kaydedici sonraki bir eklemenin yeniden
+        // numaralandiracagi bir dugum kimligine ihtiyac duydugundan gunluk bu agactan bastan baslar
+        loadPending_ = false;
+        baseHash_.reset();
+        writeTree(std::nullopt, current_);
+    }
+    runOpen_ = false;
+    return journalStarted_ ? nodes_[current_].seq : UndoFile::kNone;
+}
+
+// Start a fresh tree but keep the journal object, whose file is deleted
+// Yeni bir agac baslat ama dosyasi silinen gunluk nesnesini tut
+void UndoManager::clear() {
+    auto journal = std::move(journal_);
+    *this = UndoManager();
+    journal_ = std::move(journal);
+    if (journal_) journal_->remove();
+}
+
+// Records name nodes by id; a record whose node was dropped earlier is skipped, and freed
+// slots have id 0, so a stale map entry never matches
+// Kayitlar dugumleri kimlikle adlandirir; dugumu daha once atilmis bir kayit atlanir ve serbest
+// yuvalarin kimligi 0'dir, boylece eski bir esleme girdisi asla eslesmez
+bool UndoManager::replay(uint64_t hash, size_t& records, bool& torn) {
+    std::unordered_map<uint32_t, int> ids;
+    auto find = [&](uint32_t id) {
+        auto it = ids.find(id);
+        return (it == ids.end() || nodes_[it->second].seq != id) ? -1 : it->second;
+    };
+    uint32_t maxId = seq_;
+    uint32_t savedId = 0;
+
+    bool ok = journal_->read([&](uint8_t kind, UndoFile::Reader& r) {
+        switch (kind) {
+            case UndoFile::Node: {
+                uint32_t id = r.u32();
+                uint32_t parentId = r.u32();
+                uint8_t type = r.u8();
+                bool backward = r.u8() != 0;
+                int line = r.i32(), col = r.i32(), lineEnd = r.i32(), colEnd = r.i32();
+                int groupSize = r.i32();
+                std::string_view text = r.bytes(r.u32());
+                int64_t time = r.pos < r.data.size() ? static_cast<int64_t>(r.u64()) : 0;
+                if (!r.ok || id == 0 || type > static_cast<uint8_t>(ActionType::DeleteRange)) return;
+
+                int idx;
+                if (parentId == UndoFile::kNone) {
+                    if (!ids.empty()) return;  // Only the first record may name the root / Koku yalnizca ilk kayit adlandirabilir
+                    idx = root_;
+                } else {
+                    int parent = find(parentId);
+                    if (parent < 0) return;
+                    idx = allocNode();
+                    linkChild(parent, idx);
+                }
+                UndoNode& n = nodes_[idx];
+                n.type = static_cast<ActionType>(type);
+                n.backward = backward;
+                n.line = line;
+                n.col = col;
+                n.lineEnd = lineEnd;
+                n.colEnd = colEnd;
+                n.groupSize = groupSize;
+                n.time = time;
+                n.textOff = text_.size();
+                n.textLen = static_cast<uint32_t>(text.size());
+                text_.append(text);
+                n.seq = id;
+                ids[id] = idx;
+                maxId = std::max(maxId, id);
+                break;
+            }
+            case UndoFile::Extend: {
+                uint32_t id = r.u32();
+                int col = r.i32();
+                bool backward = r.u8() != 0;
+                std::string_view c = r.bytes(1);
+                int64_t time = r.pos < r.data.size() ? static_cast<int64_t>(r.u64()) : 0;
+                int idx = find(id);
+                if (!r.ok || idx < 0) return;
+                UndoNode& n = nodes_[idx];
+                if (n.textOff + n.textLen != text_.size()) {
+                    // Runs only grow at the pool's end; move this one there
+                    // Diziler yalnizca havuzun sonunda buyur; bunu oraya tasi
+                    std::string moved = text_.substr(n.textOff, n.textLen);
+                    deadText_ += n.textLen;
+                    n.textOff = text_.size();
+                    text_ += moved;
+                }
+                text_ += c[0];
+                n.textLen++;
+                n.col = col;
+                n.backward = backward;
+                n.time = time;
+                break;
+            }
+            case UndoFile::Group: {
+                uint32_t id = r.u32();
+                int size = r.i32();
+                int idx = find(id);
+                if (r.ok && idx >= 0) nodes_[idx].groupSize = size;
+                break;
+            }
+            case UndoFile::Active: {
+                int parent = find(r.u32());
+                int child = find(r.u32());
+                if (r.ok && parent >= 0 && child >= 0 && nodes_[child].parent == parent) {
+                    nodes_[parent].activeChild = child;
+                }
+                break;
+            }
+            case UndoFile::Drop: {
+                int idx = find(r.u32());
+                if (!r.ok || idx < 0 || idx == root_) return;
+                unlinkChild(nodes_[idx].parent, idx);
+                freeSubtree(idx);
+                break;
+            }
+            case UndoFile::Root: {
+                int idx = find(r.u32());
+                if (!r.ok || idx < 0 || nodes_[idx].parent != root_) return;
+                promoteRoot(idx);
+                break;
+            }
+            case UndoFile::Save: {
+                uint32_t id = r.u32();
+                uint64_t h = r.u64();
+                if (r.ok && h == hash) savedId = id;
+                break;
+            }
+            default:
+                break;  // Newer record kinds are skipped / Daha yeni kayit turleri atlanir
+        }
+    }, records, torn);
+
+    int saved = savedId ? find(savedId) : -1;
+    if (!ok || saved < 0) return false;
+
+    // Resume at the saved node; redo retraces the path that led to it
+    // Kaydedilen dugumde devam et; yineleme ona giden yolu yeniden izler
+    current_ = saved;
+    for (int n = saved; nodes_[n].parent >= 0; n = nodes_[n].parent) nodes_[nodes_[n].parent].activeChild = n;
+    seq_ = maxId + 1;
+    runOpen_ = false;
+    return true;
+}
+
+// Preorder with siblings in branch order, so replay rebuilds identical branch indices; the
+// redo targets that differ from replay's default (the last child) follow as ACTIVE records
+// Dallar sirasinda on sira, boylece tekrar oynatma ayni dal indekslerini kurar; tekrar
+// oynatmanin varsayilanindan (son cocuk) farkli yineleme hedefleri ACTIVE kayitlari olarak izler
+void UndoManager::writeTree(std::optional<uint64_t> savedHash, int savedAt) {
+    journal_->restart();
+    journalStarted_ = true;
+
+    std::vector<int> stack{root_};
+    std::vector<int> kids;
+    std::vector<int> redirected;
+    while (!stack.empty()) {
+        int idx = stack.back();
+        stack.pop_back();
+        const UndoNode& n = nodes_[idx];
+        journalNode(*journal_, n, n.parent >= 0 ? nodes_[n.parent].seq : UndoFile::kNone);
+        kids.clear();
+        for (int c = n.firstChild; c >= 0; c = nodes_[c].nextSibling) kids.push_back(c);
+        if (!kids.empty() && n.activeChild != kids.back()) redirected.push_back(idx);
+        stack.insert(stack.end(), kids.rbegin(), kids.rend());
+    }
+    for (int idx : redirected) {
+        if (nodes_[idx].activeChild >= 0) journal_->active(nodes_[idx].seq, nodes_[nodes_[idx].activeChild].seq);
+    }
+    if (savedHash) journal_->save(nodes_[savedAt].seq, *savedHash);
+}
+
+// A by-reference deletion is read back out of its sealed table by the journal when it flushes,
+// the same range restoreRange splices
+// Referansli bir silme, gunluk bosalirken restoreRange'in geri ekledigi aralikla ayni sekilde
+// muhurlu tablosundan okunur
+void UndoManager::journalNode(UndoFile& journal, const UndoNode& node, uint32_t parentId) const {
+    if (node.ref >= 0) {
+        journal.node(node, parentId, refs_[node.ref]);
+    } else {
+        journal.node(node, parentId, std::string_view(text_).substr(node.textOff, node.textLen));
+    }
+}
+
+// Reuse a freed slot when there is one
+// Varsa serbest bir yuvayi yeniden kullan
+int UndoManager::allocNode() {
+    if (!free_.empty()) {
+        int idx = free_.back();
+        free_.pop_back();
+        nodes_[idx] = UndoNode{};
+        return idx;
+    }
+    nodes_.emplace_back();
+    return static_cast<int>(nodes_.size()) - 1;
+}
+
+// Explicit stack instead of recursion, so a chain of millions of nodes cannot overflow
+// Ozyineleme yerine acik yigin, boylece milyonlarca dugumluk bir zincir tasamaz
+void UndoManager::freeSubtree(int index) {
+    std::vector<int> stack{index};
+    while (!stack.empty()) {
+        int idx = stack.back();
+        stack.pop_back();
+        for (int c = nodes_[idx].firstChild; c >= 0; c = nodes_[c].nextSibling) stack.push_back(c);
+        deadText_ += nodes_[idx].textLen;
+        releaseRef(nodes_[idx].ref);
+        nodes_[idx] = UndoNode{};
+        free_.push_back(idx);
+    }
+}
+
+// Append so existing branch indices stay put
+// Mevcut dal indeksleri yerinde kalsin diye sona ekle
+void UndoManager::linkChild(int parent, int child) {
+    nodes_[child].parent = parent;
+    UndoNode& p = nodes_[parent];
+    if (p.firstChild < 0) {
+        p.firstChild = child;
+    } else {
+        int tail = p.firstChild;
+        while (nodes_[tail].nextSibling >= 0) tail = nodes_[tail].nextSibling;
+        nodes_[tail].nextSibling = child;
+    }
+    p.activeChild = child;
+}
+
+// Remove a child from the sibling list; the parent's redo target falls back to its last branch
+// Bir cocugu kardes listesinden cikar; ebeveynin yineleme hedefi son dalina geri duser
+void UndoManager::unlinkChild(int parent, int child) {
+    UndoNode& p = nodes_[parent];
+    if (p.firstChild == child) {
+        p.firstChild = nodes_[child].nextSibling;
+    } else {
+        int c = p.firstChild;
+        while (c >= 0 && nodes_[c].nextSibling != child) c = nodes_[c].nextSibling;
+        if (c >= 0) nodes_[c].nextSibling = nodes_[child].nextSibling;
+    }
+    if (p.activeChild == child) {
+        p.activeChild = -1;
+        for (int c = p.firstChild; c >= 0; c = nodes_[c].nextSibling) p.activeChild = c;
+    }
+}
+
+// Over the limit, shed history down to three quarters of it so the scan is amortized over
+// many edits: inactive branches oldest first, then the oldest steps of the current path
+// Sinir asildiginda tarama bircok duzenlemeye yayilsin diye gecmisi sinirin dortte ucune
+// indir: once en eskiden baslayarak etkin olmayan dallar, sonra mevcut yolun en eski adimlari
+void UndoManager::enforceLimit() {
+    size_t limit = memoryLimit_;
+    if (limit == 0 || memoryUsage() <= limit) return;
+    size_t target = limit / 4 * 3;
+
+    // The path that undo and redo can reach: ancestors of current plus its redo chain
+    // Geri alma ve yinelemenin ulasabildigi yol: mevcudun atalari arti yineleme zinciri
+    std::vector<char> onPath(nodes_.size(), 0);
+    std::vector<int> path;
+    for (int n = current_; n >= 0; n = nodes_[n].parent) path.push_back(n);
+    for (int n = nodes_[current_].activeChild; n >= 0; n = nodes_[n].activeChild) path.push_back(n);
+    for (int n : path) onPath[n] = 1;
+
+    std::vector<int> inactive;
+    for (int n : path) {
+        for (int c = nodes_[n].firstChild; c >= 0; c = nodes_[c].nextSibling) {
+            if (!onPath[c]) inactive.push_back(c);
+        }
+    }
+    std::sort(inactive.begin(), inactive.end(),
+              [this](int a, int b) { return nodes_[a].seq < nodes_[b].seq; });
+    for (int c : inactive) {
+        if (memoryUsage() <= target) break;
+        if (UndoFile* j = log()) j->drop(nodes_[c].seq);
+        unlinkChild(nodes_[c].parent, c);
+        freeSubtree(c);
+    }
+
+    // Still over: the first step after the root becomes the new root and can no longer be undone
+    // Hala fazla: kokten sonraki ilk adim yeni kok olur ve artik geri alinamaz
+    while (memoryUsage() > target && root_ != current_) {
+        int next = nodes_[root_].activeChild;
+        if (next < 0) break;
+        if (UndoFile* j = log()) j->root(nodes_[next].seq);
+        promoteRoot(next);
+    }
+
+    if (deadText_ > text_.size() / 2) compactText();
+}
+
+// The new root keeps its id but no longer carries an action
+// Yeni kok kimligini korur ama artik bir eylem tasimaz
+void UndoManager::promoteRoot(int next) {
+    unlinkChild(root_, next);
+    freeSubtree(root_);
+    UndoNode& r = nodes_[next];
+    r.parent = -1;
+    deadText_ += r.textLen;
+    r.textLen = 0;
+    releaseRef(r.ref);
+    r.ref = -1;
+    r.groupSize = 0;
+    root_ = next;
+}
+
+// Copy live text into a fresh pool and repoint every live node
+// Canli metni yeni bir havuza kopyala ve her canli dugumu yeniden isaretle
+void UndoManager::compactText() {
+    std::string packed;
+    packed.reserve(text_.size() - deadText_);
+    std::vector<int> stack{root_};
+    while (!stack.empty()) {
+        int idx = stack.back();
+        stack.pop_back();
+        UndoNode& n = nodes_[idx];
+        size_t off = packed.size();
+        packed.append(text_, n.textOff, n.textLen);
+        n.textOff = off;
+        for (int c = n.firstChild; c >= 0; c = nodes_[c].nextSibling) stack.push_back(c);
+    }
+    text_ = std::move(packed);
+    deadText_ = 0;
+    runOpen_ = false;
+}
+
+// Text of a node in document order (Backspace runs are recorded right to left)
+// Bir dugumun belge sirasindaki metni (Backspace dizileri sagdan sola kaydedilir)
+std::string UndoManager::textOf(const UndoNode& node) const {
+    std::string text = text_.substr(node.textOff, node.textLen);
+    if (node.backward) std::reverse(text.begin(), text.end());
+    return text;
 }
 
 // Apply the reverse of an action to the buffer (undo logic)
 // Bir eylemin tersini tampona uygula (geri alma mantigi)
-void UndoManager::applyUndo(const Action& a, Buffer& buf) {
+void UndoManager::applyUndo(const UndoNode& a, Buffer& buf) const {
     switch (a.type) {
         case ActionType::Insert:
-            buf.deleteChar(a.line, a.col);
+            // A run of typed characters is removed in one range delete
+            // Yazilan karakter dizisi tek bir aralik silmeyle kaldirilir
+            if (a.textLen <= 1) buf.deleteChar(a.line, a.col);
+            else buf.deleteRange(a.line, a.col, a.line, a.col + static_cast<int>(a.textLen));
             break;
         case ActionType::Delete:
-            buf.insertChar(a.line, a.col, a.character);
+            if (a.textLen <= 1) buf.insertChar(a.line, a.col, text_[a.textOff]);
+            else buf.insertText(a.line, a.col, textOf(a));
             break;
         case ActionType::InsertLine:
             buf.deleteLine(a.line);
             break;
         case ActionType::DeleteLine:
-            buf.insertLineAt(a.line, a.lineContent);
+            buf.insertLineAt(a.line, textOf(a));
             break;
         case ActionType::InsertText:
             // Reverse of inserting text: delete the range it created
@@ -166,8 +963,8 @@ void UndoManager::applyUndo(const Action& a, Buffer& buf) {
                 // Eklenen metnin bitis konumunu hesapla
                 int endLine = a.line;
                 int endCol = a.col;
-                for (char c : a.lineContent) {
-                    if (c == '\n') {
+                for (size_t i = a.textOff; i < a.textOff + a.textLen; ++i) {
+                    if (text_[i] == '\n') {
                         endLine++;
                         endCol = 0;
                     } else {
@@ -178,25 +975,28 @@ void UndoManager::applyUndo(const Action& a, Buffer& buf) {
             }
             break;
         case ActionType::DeleteRange:
-            // Reverse of deleting a range: re-insert the saved text
-            // Aralik silmenin tersi: kaydedilen metni yeniden ekle
-            buf.insertText(a.line, a.col, a.lineContent);
+            // Reverse of deleting a range: splice it back from the sealed table, or re-insert the saved text
+            // Aralik silmenin tersi: muhurlu tablodan geri ekle veya kaydedilen metni yeniden ekle
+            if (a.ref >= 0) buf.restoreRange(*refs_[a.ref], a.line, a.col, a.lineEnd, a.colEnd);
+            else buf.insertText(a.line, a.col, textOf(a));
             break;
     }
 }
 
 // Re-apply an action to the buffer (redo logic)
 // Bir eylemi tampona yeniden uygula (yineleme mantigi)
-void UndoManager::applyRedo(const Action& a, Buffer& buf) {
+void UndoManager::applyRedo(const UndoNode& a, Buffer& buf) const {
     switch (a.type) {
         case ActionType::Insert:
-            buf.insertChar(a.line, a.col, a.character);
+            if (a.textLen <= 1) buf.insertChar(a.line, a.col, text_[a.textOff]);
+            else buf.insertText(a.line, a.col, textOf(a));
             break;
         case ActionType::Delete:
-            buf.deleteChar(a.line, a.col);
+            if (a.textLen <= 1) buf.deleteChar(a.line, a.col);
+            else buf.deleteRange(a.line, a.col, a.line, a.col + static_cast<int>(a.textLen));
             break;
         case ActionType::InsertLine:
-            buf.insertLineAt(a.line, a.lineContent);
+            buf.insertLineAt(a.line, textOf(a));
             break;
         case ActionType::DeleteLine:
             buf.deleteLine(a.line);
@@ -204,7 +1004,7 @@ void UndoManager::applyRedo(const Action& a, Buffer& buf) {
         case ActionType::InsertText:
             // Re-insert the text at the original position
             // Metni orijinal konuma yeniden ekle
-            buf.insertText(a.line, a.col, a.lineContent);
+            buf.insertText(a.line, a.col, textOf(a));
             break;
         case ActionType::DeleteRange:
             // Re-delete the range
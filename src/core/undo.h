@@ -4,10 +4,17 @@
 // See LICENSE file in the project root for full license text.
 
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 #include "buffer.h"
+#include "BufferSnapshot.h"
+
+class UndoFile;
 
 // Types of actions that can be undone/redone
 // Geri alinabilir/yinelenebilir eylem turleri
@@ -30,30 +37,81 @@ struct Action {
     std::string lineContent;      // For line insert/delete or multi-char text / Satir veya cok karakterli metin icin
     int lineEnd = -1;             // End line for DeleteRange / DeleteRange icin bitis satiri
     int colEnd = -1;              // End column for DeleteRange / DeleteRange icin bitis sutunu
+    // DeleteRange only: table sealed before the deletion (Buffer::cutRange); when set, undo
+    // splices the removed lines back from it and lineContent may stay empty
+    // Yalnizca DeleteRange: silmeden once muhurlenen tablo (Buffer::cutRange); ayarliysa geri alma
+    // silinen satirlari ondan geri ekler ve lineContent bos kalabilir
+    std::shared_ptr<const PieceTable> removedFrom;
 };
 
-// A node in the undo tree (supports branching undo history)
-// Geri alma agacindaki bir dugum (dallanan geri alma gecmisini destekler)
+// A node in the undo tree (supports branching undo history).
+// Geri alma agacindaki bir dugum (dallanan geri alma gecmisini destekler).
+// Nodes live in one pool and point at each other by index; text lives in a shared
+// append-only pool, so a typed character costs no allocation of its own.
+// Dugumler tek bir havuzda yasar ve birbirini indeksle gosterir; metin paylasilan yalnizca
+// eklenen bir havuzda yasar, boylece yazilan bir karakter kendi basina bellek ayirmaz.
 struct UndoNode {
-    Action action;
-    std::shared_ptr<UndoNode> parent;                    // Parent node / Ana dugum
-    std::vector<std::shared_ptr<UndoNode>> branches;     // Child branches / Alt dallar
-    int activeBranch = -1;                                // Currently active branch / Su an aktif dal
-    int groupSize = 0;                                    // Number of actions in this group (0 = not a group end) / Bu gruptaki eylem sayisi (0 = grup sonu degil)
+    ActionType type = ActionType::Insert;
+    bool backward = false;        // Delete run grown by Backspace (text stored reversed) / Backspace ile buyuyen silme dizisi (metin ters saklanir)
+    int line = 0, col = 0;        // Start of the action / Eylemin baslangici
+    int lineEnd = -1, colEnd = -1;// End for DeleteRange / DeleteRange icin bitis
+    size_t textOff = 0;           // Text in the pool / Havuzdaki metin
+    uint32_t textLen = 0;
+    int parent = -1;              // Parent node index / Ana dugum indeksi
+    int firstChild = -1;          // First branch / Ilk dal
+    int nextSibling = -1;         // Next branch of the parent / Ebeveynin sonraki dali
+    int activeChild = -1;         // Branch redo follows / Yinelemenin izledigi dal
+    int groupSize = 0;            // Number of actions in this group (0 = not a group end) / Bu gruptaki eylem sayisi (0 = grup sonu degil)
+    uint32_t seq = 0;             // Creation order and undofile id (0 = free slot) / Olusturma sirasi ve geri alma dosyasi kimligi (0 = bos yuva)
+    int ref = -1;                 // Sealed table holding removed text, or -1 / Silinen metni tutan muhurlu tablo veya -1
+    int64_t time = 0;             // Last change, Unix ms (a run's last keystroke) / Son degisiklik, Unix ms (bir dizinin son tusu)
+};
+
+// Read-only view of a node for tree visualizers; ids are the ones gotoNode takes
+// Agac gorsellestiricileri icin bir dugumun salt okunur gorunumu; kimlikler gotoNode'un aldiklaridir
+struct UndoNodeInfo {
+    uint32_t id = 0;
+    uint32_t parent = 0;          // 0 for the root / Kok icin 0
+    uint32_t activeChild = 0;     // Redo target, 0 if none / Yineleme hedefi, yoksa 0
+    ActionType type = ActionType::Insert;
+    int line = 0, col = 0;
+    uint32_t textLen = 0;
+    int groupSize = 0;
+    int64_t time = 0;             // Unix ms / Unix ms
 };
 
+// Stable lowercase name of an action type ("insert", "deleteRange", ...)
+// Bir eylem turunun sabit kucuk harfli adi ("insert", "deleteRange", ...)
+const char* actionTypeName(ActionType type);
+
 // Manages undo/redo operations with tree-based branching history.
 // Agac tabanli dallanan gecmisle geri alma/yineleme islemlerini yonetir.
-// Unlike linear undo, this preserves all edit branches.
-// Dogrusal geri almanin aksine, tum duzenleme dallarini korur.
+// Unlike linear undo, this preserves all edit branches. Consecutive single-character inserts
+// or deletes at adjacent positions coalesce into one run (broken at line and word boundaries,
+// groups, and undo/redo), and history beyond the memory limit is dropped oldest first:
+// inactive branches before the oldest steps of the current path.
+// Dogrusal geri almanin aksine, tum duzenleme dallarini korur. Bitisik konumlardaki ardisik
+// tek karakterli eklemeler veya silmeler tek bir diziye birlesir (satir ve kelime sinirlarinda,
+// gruplarda ve geri alma/yinelemede kirilir); bellek sinirini asan gecmis en eskiden
+// baslayarak atilir: mevcut yolun en eski adimlarindan once etkin olmayan dallar.
+// With an undofile attached every change to the tree is journaled, and the saved history is
+// replayed the first time the tree is used once the opened text is hashed, not when the file
+// opens; edits made before that are grafted onto the replayed history.
+// Bir geri alma dosyasi bagliyken agactaki her degisiklik gunluge yazilir ve kaydedilmis
+// gecmis dosya acildiginda degil, acilan metin ozetlendikten sonra agac ilk kullanildiginda
+// tekrar oynatilir; ondan once yapilan duzenlemeler tekrar oynatilan gecmise eklenir.
 class UndoManager {
 public:
     UndoManager();
 
-    // Record a new action (creates a new node in the undo tree)
-    // Yeni bir eylem kaydet (geri alma agacinda yeni bir dugum olusturur)
+    // Record a new action (creates a new node in the undo tree or extends the open run)
+    // Yeni bir eylem kaydet (geri alma agacinda yeni bir dugum olusturur veya acik diziyi uzatir)
     void addAction(const Action& action);
 
+    // Record a batch carried out by Buffer::applyEdits, in application order, as one group
+    // Buffer::applyEdits'in uyguladigi bir grubu uygulama sirasiyla tek grup olarak kaydet
+    void addEdits(const std::vector<AppliedEdit>& applied);
+
     // Begin a group of actions that undo/redo as a single step
     // Tek adim olarak geri alinacak/yinelenecek bir eylem grubu baslat
     void beginGroup();
@@ -86,17 +144,194 @@ public:
     // Mevcut dugumdeki aktif dal indeksini al
     int currentBranch() const;
 
+    // Move to any node in one batch: undo up to the common ancestor, then redo down to the
+    // target, pointing each redo branch along the way at it. A node inside a group moves on
+    // to the node closing that group. False if unknown or already there.
+    // Herhangi bir dugume tek seferde git: ortak ataya kadar geri al, sonra hedefe kadar yinele
+    // ve yol boyunca her yineleme dalini ona yonelt. Bir grubun icindeki dugum o grubu kapatan
+    // dugume ilerler. Bilinmiyorsa veya zaten oradaysa false.
+    bool gotoNode(uint32_t id, Buffer& buf);
+
+    // Go to the newest change made at or before a Unix ms time (the root if none was); a group
+    // that started by then is applied whole
+    // Bir Unix ms zamaninda veya oncesinde yapilan en yeni degisiklige git (hic yoksa koke); o
+    // zamana kadar baslamis bir grup tumuyle uygulanir
+    bool gotoTime(int64_t unixMs, Buffer& buf);
+
+    // Id of the current node and of the root
+    // Mevcut dugumun ve kokun kimligi
+    uint32_t currentId() const;
+    uint32_t rootId() const;
+
+    // Every live node, parents before children and branches in order
+    // Tum canli dugumler, ebeveynler cocuklardan once ve dallar sirayla
+    std::vector<UndoNodeInfo> tree() const;
+
+    // Close the open run so the next keystroke starts a new undo step (e.g. after cursor jumps)
+    // Acik diziyi kapat, boylece sonraki tus yeni bir geri alma adimi baslatir (orn. imlec atlamalarindan sonra)
+    void breakRun();
+
+    // Number of live nodes, the root included
+    // Kok dahil canli dugum sayisi
+    size_t nodeCount() const;
+
+    // Approximate bytes held by the history
+    // Gecmisin tuttugu yaklasik bayt
+    size_t memoryUsage() const;
+
+    // Set the per-buffer history budget in bytes (0 = unlimited)
+    // Buffer basina gecmis butcesini bayt olarak ayarla (0 = sinirsiz)
+    static void setMemoryLimit(size_t bytes);
+    static size_t memoryLimit();
+
+    // Persist history in an undofile. `base` is the text the file was opened with: the
+    // journal is replayed lazily and kept only if a SAVE record matches that text. Rebinding
+    // a tree that already has history (save as) writes it whole into the new journal.
+    // Gecmisi bir geri alma dosyasinda sakla. `base` dosyanin acildigi metindir: gunluk tembel
+    // olarak tekrar oynatilir ve yalnizca bir SAVE kaydi bu metinle eslesirse tutulur. Zaten
+    // gecmisi olan bir agaci yeniden baglamak (farkli kaydet) onu tumuyle yeni gunluge yazar.
+    void persistTo(std::shared_ptr<UndoFile> journal, const BufferSnapshot& base);
+
+    // Replay the undofile if it has not been yet and the opened text's hash is ready; never
+    // waits, so edits during a progressive load are kept live and grafted on later
+    // Geri alma dosyasi henuz tekrar oynatilmadiysa ve acilan metnin ozeti hazirsa oynat; asla
+    // beklemez, boylece asamali yukleme sirasindaki duzenlemeler canli tutulur ve sonra eklenir
+    void ensureLoaded();
+
+    // Attached undofile, or nullptr
+    // Bagli geri alma dosyasi veya nullptr
+    std::shared_ptr<UndoFile> journal() const;
+
+    // Id of the current node, for the SAVE record of a save started now (closes the open run,
+    // so the saved node cannot grow afterwards)
+    // Su an baslatilan bir kaydetmenin SAVE kaydi icin mevcut dugumun kimligi (acik diziyi
+    // kapatir, boylece kaydedilen dugum sonradan buyuyemez)
+    uint32_t savePoint();
+
+    // Drop the whole history, in memory and on disk
+    // Tum gecmisi bellekte ve diskte at
+    void clear();
+
 private:
     // Apply an undo operation to the buffer
     // Buffer'a bir geri alma islemi uygula
-    void applyUndo(const Action& action, Buffer& buf);
+    void applyUndo(const UndoNode& node, Buffer& buf) const;
 
     // Apply a redo operation to the buffer
     // Buffer'a bir yineleme islemi uygula
-    void applyRedo(const Action& action, Buffer& buf);
+    void applyRedo(const UndoNode& node, Buffer& buf) const;
+
+    // Text of a node in document order
+    // Bir dugumun belge sirasindaki metni
+    std::string textOf(const UndoNode& node) const;
+
+    // Try to extend the current node's run instead of adding a node
+    // Dugum eklemek yerine mevcut dugumun dizisini uzatmayi dene
+    bool coalesce(const Action& action);
+
+    // Undo/redo along the tree path from current to target
+    // Mevcuttan hedefe agac yolu boyunca geri al/yinele
+    bool travel(int target, Buffer& buf);
+
+    // Node closing the group a node belongs to (the node itself when it is not inside one)
+    // Bir dugumun ait oldugu grubu kapatan dugum (bir grubun icinde degilse dugumun kendisi)
+    int groupEnd(int node) const;
+
+    // Take a node from the free list or grow the pool
+    // Serbest listeden bir dugum al veya havuzu buyut
+    int allocNode();
+
+    // Free a whole subtree iteratively (no recursion, however deep)
+    // Tum bir alt agaci yinelemeli olarak serbest birak (ne kadar derin olursa olsun ozyineleme yok)
+    void freeSubtree(int index);
+
+    // Append a child to its parent's branch list and make it the redo target
+    // Bir cocugu ebeveyninin dal listesine ekle ve yineleme hedefi yap
+    void linkChild(int parent, int child);
+
+    // Unlink a child from its parent's branch list
+    // Bir cocugu ebeveyninin dal listesinden ayir
+    void unlinkChild(int parent, int child);
+
+    // Drop history until usage fits the limit
+    // Kullanim sinira sigana kadar gecmisi at
+    void enforceLimit();
+
+    // Rewrite the text pool without dead bytes
+    // Metin havuzunu olu baytlar olmadan yeniden yaz
+    void compactText();
+
+    // Make the root's active child the new root, freeing the old one
+    // Kokun aktif cocugunu yeni kok yap, eskisini serbest birak
+    void promoteRoot(int next);
+
+    // Rebuild the tree from the undofile; false if no SAVE record matches `hash`
+    // Agaci geri alma dosyasindan yeniden kur; hicbir SAVE kaydi `hash` ile eslesmezse false
+    bool replay(uint64_t hash, size_t& records, bool& torn);
+
+    // Write the live tree into a restarted journal (parents before children, branches in order),
+    // tying savedHash to the node at savedAt
+    // Canli agaci yeniden baslatilmis bir gunluge yaz (ebeveynler cocuklardan once, dallar sirayla),
+    // savedHash'i savedAt'teki dugume bagla
+    void writeTree(std::optional<uint64_t> savedHash, int savedAt);
+
+    // Move the history `live` recorded against the opened text below the current node (the one
+    // replay resumed at) and journal it
+    // `live`'in acilan metne karsi kaydettigi gecmisi mevcut dugumun (tekrar oynatmanin devam
+    // ettigi dugum) altina tasi ve gunluge yaz
+    void graft(const UndoManager& live);
+
+    // Keep a by-reference deletion's table, charging the add-buffer bytes it pins / drop it
+    // Referansli bir silmenin tablosunu tut, tuttugu ekleme arabellegi baytlarini say / birak
+    int holdRef(std::shared_ptr<const PieceTable> table, uint64_t bytes);
+    void releaseRef(int ref);
+
+    // Write a node record; a by-reference deletion hands over its sealed table, not its text
+    // Bir dugum kaydi yaz; referansli bir silme metnini degil muhurlu tablosunu teslim eder
+    void journalNode(UndoFile& journal, const UndoNode& node, uint32_t parentId) const;
+
+    // Journal to record into, or nullptr while none is attached or started
+    // Kayit yazilacak gunluk; bagli veya baslatilmis degilse nullptr
+    UndoFile* log() const { return journalStarted_ ? journal_.get() : nullptr; }
+
+    // Hash of the opened text, filled in by a worker thread it owns while the file indexes.
+    // Dropping the last reference cancels the worker and joins it, so it never outlives the
+    // manager. valid is false when loading was cancelled before the text was complete.
+    // Acilan metnin ozeti, dosya indekslenirken sahip oldugu bir calisan thread tarafindan
+    // doldurulur. Son referansi birakmak calisani iptal eder ve bekler, boylece yoneticiden
+    // uzun yasamaz. Metin tamamlanmadan yukleme iptal edildiyse valid false'tur.
+    struct BaseHash {
+        std::atomic<bool> ready{false};
+        std::atomic<bool> cancel{false};
+        bool valid = true;
+        uint64_t value = 0;
+        std::thread worker;
+
+        ~BaseHash() {
+            cancel.store(true, std::memory_order_relaxed);
+            if (worker.joinable()) worker.join();
+        }
+    };
+
+    std::vector<UndoNode> nodes_;   // Node pool / Dugum havuzu
+    std::vector<int> free_;         // Reusable node slots / Yeniden kullanilabilir dugum yuvalari
+    std::string text_;              // Text pool / Metin havuzu
+    std::vector<std::shared_ptr<const PieceTable>> refs_;  // Tables behind by-reference deletions / Referansli silmelerin arkasindaki tablolar
+    std::vector<int> freeRefs_;     // Reusable ref slots / Yeniden kullanilabilir ref yuvalari
+    std::vector<uint64_t> refBytes_;// Add-buffer bytes each ref pins / Her ref'in tuttugu ekleme arabellegi baytlari
+    size_t pinnedBytes_ = 0;        // Sum of refBytes_ over live refs / Canli ref'lerin refBytes_ toplami
+    size_t deadText_ = 0;           // Pool bytes owned by freed nodes / Serbest dugumlere ait havuz baytlari
+    int root_ = 0;                  // Root of the undo tree / Geri alma agacinin koku
+    int current_ = 0;               // Current position in the tree / Agactaki mevcut konum
+    uint32_t seq_ = 1;              // Next node sequence number / Sonraki dugum sira numarasi
+    bool runOpen_ = false;          // Current node may absorb the next keystroke / Mevcut dugum sonraki tusu emebilir
+    int groupDepth_ = 0;            // Nesting depth for beginGroup/endGroup / beginGroup/endGroup icin icleme derinligi
+    int groupActionCount_ = 0;      // Actions recorded in current group / Mevcut grupta kaydedilen eylem sayisi
+    std::shared_ptr<UndoFile> journal_;       // Undofile, or nullptr / Geri alma dosyasi veya nullptr
+    std::shared_ptr<BaseHash> baseHash_;      // Opened text's hash until the journal is replayed / Gunluk oynatilana kadar acilan metnin ozeti
+    bool loadPending_ = false;                // Journal not replayed yet / Gunluk henuz oynatilmadi
+    bool journalStarted_ = false;             // Journal holds this tree / Gunluk bu agaci tutuyor
+    std::optional<uint64_t> rootHash_;        // Text at the root, for a fresh journal's first SAVE / Kokteki metin, yeni bir gunlugun ilk SAVE kaydi icin
 
-    std::shared_ptr<UndoNode> root;       // Root of the undo tree / Geri alma agacinin koku
-    std::shared_ptr<UndoNode> current;    // Current position in the tree / Agactaki mevcut konum
-    int groupDepth_ = 0;                  // Nesting depth for beginGroup/endGroup / beginGroup/endGroup icin icleme derinligi
-    int groupActionCount_ = 0;            // Actions recorded in current group / Mevcut grupta kaydedilen eylem sayisi
+    static std::atomic<size_t> memoryLimit_;  // Shared budget per buffer / Buffer basina paylasilan butce
 };
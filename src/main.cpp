@@ -4,12 +4,15 @@
 // See LICENSE file in the project root for full license text.
 
 #include "buffer.h"
+#include "PieceTable.h"
 #include "cursor.h"
 #include "undo.h"
+#include "UndoFile.h"
 #include "input.h"
 #include "EventBus.h"
 #include "buffers.h"
 #include "file.h"
+#include "MappedFile.h"
 #include "BerkidePaths.h"
 #include "v8_init.h"
 #include "V8Engine.h"
@@ -23,6 +26,9 @@
 #include "ProcessManager.h"
 #include "RegisterManager.h"
 #include "SearchEngine.h"
+#include "WorkspaceSearch.h"
+#include "TrigramIndex.h"
+#include "ThreadPool.h"
 #include "MarkManager.h"
 #include "AutoSave.h"
 #include "Extmark.h"
@@ -180,6 +186,8 @@ int main(int argc, char *argv[])
     ProcessManager procMgr;
     RegisterManager regMgr;
     SearchEngine searchEng;
+    WorkspaceSearch workspaceSearch;
+    TrigramIndex trigramIndex;
     MarkManager markMgr;
     AutoSave autoSave;
     ExtmarkManager extmarkMgr;
@@ -236,6 +244,8 @@ int main(int argc, char *argv[])
     edCtx.processManager = &procMgr;
     edCtx.registers      = &regMgr;
     edCtx.searchEngine   = &searchEng;
+    edCtx.workspaceSearch = &workspaceSearch;
+    edCtx.trigramIndex   = &trigramIndex;
     edCtx.markManager    = &markMgr;
     edCtx.autoSave       = &autoSave;
     edCtx.extmarkManager = &extmarkMgr;
@@ -267,6 +277,26 @@ int main(int argc, char *argv[])
     autoSave.setDirectory(paths.userBerkide + "/autosave");
     autoSave.setInterval(config.getInt("autosave.interval", 30));
     sessionMgr.setSessionPath(paths.userBerkide + "/session.json");
+    FileSystem::setMmapThreshold(
+        static_cast<uintmax_t>(config.getInt("file.mmap_threshold_mb", 64)) * 1024 * 1024);
+    if (config.getBool("file.mmap_sigbus_guard", true)) MappedFile::installSigbusGuard();
+    FileSystem::setAsyncOpenThreshold(
+        static_cast<uintmax_t>(config.getInt("file.async_open_threshold_mb", 16)) * 1024 * 1024);
+    FileSystem::setAsyncPrefixLines(config.getInt("file.async_prefix_lines", 2000));
+    FileSystem::setFsyncPolicy(FileSystem::parseFsyncPolicy(config.getString("file.fsync", "file")));
+    PieceTable::setGcPolicy(config.getInt("buffer.gc_dead_percent", 50),
+                            config.getInt("buffer.gc_min_dead_lines", 1024),
+                            config.getInt("buffer.gc_idle_seconds", 30));
+    UndoManager::setMemoryLimit(
+        static_cast<size_t>(config.getInt("undo.memory_limit_mb", 64)) * 1024 * 1024);
+    UndoFile::setDirectory(config.getBool("undo.persist", true) ? paths.userBerkide + "/undo" : "");
+    SearchEngine::setMultilineMaxLines(config.getInt("search.multiline_max_lines", 64));
+    ThreadPool::setDefaultThreads(config.getInt("search.threads", 0));
+    WorkspaceSearch::setDefaultIgnoreDirs(config.getStringList("search.ignore_dirs", {".git"}));
+    WorkspaceSearch::setDefaultMaxFileSize(
+        static_cast<uint64_t>(config.getInt("search.max_file_size_mb", 8)) * 1024 * 1024);
+    TrigramIndex::setWatchInterval(std::chrono::milliseconds(config.getInt("search.index_watch_ms", 2000)));
+    bufs.setEventBus(&event);
     httpServer.setEditorContext(&edCtx);
     wsServer.setEditorContext(&edCtx);
 
@@ -291,6 +321,12 @@ int main(int argc, char *argv[])
         LoadBerkideEnvironment(eng);
         StartWatchers();
 
+        // Index the working directory for search.workspace when enabled (saved index is served at once)
+        // Etkinse search.workspace icin calisma dizinini indeksle (kayitli indeks hemen sunulur)
+        if (config.getBool("search.index", false)) {
+            trigramIndex.start(std::filesystem::current_path().string(), paths.userBerkide + "/index");
+        }
+
         // Start HTTP + WS servers
         // HTTP + WS sunucularini baslat
         LOG_INFO("[Startup] Starting servers...");
@@ -328,10 +364,14 @@ int main(int argc, char *argv[])
         // Duzgun kapatma: oturumu kaydet, once alt surecleri durdur, sonra sunuculari kapat
         LOG_INFO("[Shutdown] Shutting down...");
         workerMgr.terminateAll();
+        bufs.cancelLoading();
+        bufs.flushSaves();
+        bufs.flushUndo();
         sessionMgr.save(bufs);
         autoSave.stop();
         procMgr.shutdownAll();
         StopWatchers();
+        trigramIndex.stop();
         httpServer.stop();
         wsServer.stop();
 
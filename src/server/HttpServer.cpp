@@ -242,6 +242,25 @@ void HttpServer::setupRoutes() {
               {"line", "integer — target line number"},
               {"col", "integer — target column number"}}));
 
+    registry_.post(srv, "/api/buffer/columns", "Convert columns of many positions between byte, codepoint, UTF-16 and display units", true,
+        [this](const httplib::Request& req, httplib::Response& res) {
+            I18n* i18n = edCtx_ ? edCtx_->i18n : nullptr;
+            auto body = json::parse(req.body, nullptr, false);
+            if (!body.is_object() || !body.contains("positions")) {
+                res.status = 400;
+                res.set_content(ApiResponse::error("BAD_REQUEST", "http.parse_error", {}, i18n).dump(),
+                    "application/json");
+                return;
+            }
+            json result = V8Engine::instance().dispatchCommand("buffer.convertColumns", body);
+            if (!result.value("ok", false)) res.status = 400;
+            res.set_content(result.dump(), "application/json");
+        },
+        json({{"positions", "array — [{line, col}, ...]"},
+              {"from", "string — byte|codepoint|utf16|display (default byte)"},
+              {"to", "string — byte|codepoint|utf16|display (default byte)"},
+              {"tabWidth", "integer — tab stop width for display columns (default indent tabWidth)"}}));
+
     registry_.post(srv, "/api/buffer/open", "Open a file into a new buffer", true,
         [this](const httplib::Request& req, httplib::Response& res) {
             I18n* i18n = edCtx_ ? edCtx_->i18n : nullptr;
@@ -5,18 +5,31 @@
 
 #include "StateSnapshot.h"
 #include "buffers.h"
+#include "BufferSnapshot.h"
+
+// Serialize every line of a snapshot, reading views straight from the piece storage
+// Bir anlik goruntunun tum satirlarini dogrudan parca deposundan gorunum okuyarak serile et
+static json linesOf(const BufferSnapshot& snap) {
+    json lines = json::array();
+    auto& arr = lines.get_ref<json::array_t&>();
+    arr.reserve(static_cast<size_t>(snap.lineCount()));
+    snap.forEachChunk(0, snap.lineCount(), [&arr](int, const std::string_view* views, int count) {
+        for (int i = 0; i < count; ++i) arr.emplace_back(views[i]);
+        return true;
+    });
+    return lines;
+}
 
 // Capture the full editor state: cursor, buffer content, mode, and open buffer list
 // Tam editor durumunu yakala: imlec, tampon icerigi, mod ve acik tampon listesi
 json StateSnapshot::fullState(Buffers& buffers) {
     auto& st = buffers.active();
-    auto& buf = st.getBuffer();
     auto& cur = st.getCursor();
 
-    json lines = json::array();
-    for (int i = 0; i < buf.lineCount(); ++i) {
-        lines.push_back(buf.getLine(i));
-    }
+    // Serialize from a snapshot so concurrent edits cannot tear the line list
+    // Eszamanli duzenlemeler satir listesini bozamasin diye anlik goruntuden serile et
+    BufferSnapshot snap = st.getBuffer().snapshot();
+    json lines = linesOf(snap);
 
     EditMode mode = st.getMode();
     std::string modeStr = "normal";
@@ -36,9 +49,11 @@ json StateSnapshot::fullState(Buffers& buffers) {
         {"cursor", {{"line", cur.getLine()}, {"col", cur.getCol()}}},
         {"buffer", {
             {"lines", lines},
-            {"lineCount", buf.lineCount()},
+            {"lineCount", lines.size()},
             {"filePath", st.getFilePath()},
-            {"modified", st.isModified()}
+            {"modified", st.isModified()},
+            {"loading", snap.isLoading()},
+            {"version", snap.version()}
         }},
         {"mode", modeStr},
         {"activeIndex", (int)buffers.activeIndex()},
@@ -49,27 +64,26 @@ json StateSnapshot::fullState(Buffers& buffers) {
 // Return the active buffer's content, line count, file path, and modified status
 // Aktif tamponun icerigini, satir sayisini, dosya yolunu ve degisiklik durumunu dondur
 json StateSnapshot::activeBuffer(Buffers& buffers) {
-    auto& buf = buffers.active().getBuffer();
-    json lines = json::array();
-    for (int i = 0; i < buf.lineCount(); ++i) {
-        lines.push_back(buf.getLine(i));
-    }
+    BufferSnapshot snap = buffers.active().getBuffer().snapshot();
+    json lines = linesOf(snap);
     return {
         {"lines", lines},
-        {"lineCount", buf.lineCount()},
+        {"lineCount", lines.size()},
         {"filePath", buffers.active().getFilePath()},
-        {"modified", buffers.active().isModified()}
+        {"modified", buffers.active().isModified()},
+        {"loading", snap.isLoading()},
+        {"version", snap.version()}
     };
 }
 
 // Return a single line's content from the active buffer by line number
 // Aktif tampondan satir numarasina gore tek bir satirin icerigini dondur
 json StateSnapshot::bufferLine(Buffers& buffers, int lineNum) {
-    auto& buf = buffers.active().getBuffer();
-    if (lineNum < 0 || lineNum >= buf.lineCount()) {
+    BufferSnapshot snap = buffers.active().getBuffer().snapshot();
+    if (lineNum < 0 || lineNum >= snap.lineCount()) {
         return {{"error", "line out of range"}, {"line", lineNum}};
     }
-    return {{"line", lineNum}, {"content", buf.getLine(lineNum)}};
+    return {{"line", lineNum}, {"content", snap.lineView(lineNum)}};
 }
 
 // Return the current cursor position (line and column) in the active buffer
@@ -8,7 +8,9 @@
 #include "buffers.h"
 #include "EventBus.h"
 #include "V8Engine.h"
+#include "WorkspaceSearch.h"
 #include "Logger.h"
+#include <algorithm>
 
 // Default constructor for WebSocket server
 // WebSocket sunucusu icin varsayilan kurucu
@@ -73,6 +75,19 @@ void WebSocketServer::setupEventBusListeners() {
             {"activeIndex", (int)edCtx_->buffers->activeIndex()}
         });
     });
+
+    // Forward progressive file load, background save, truncation, batched edit ranges, search
+    // progress and search result delta events (payload is already JSON)
+    // Asamali dosya yukleme, arka plan kaydetme, kesilme, toplu duzenleme araliklari, arama
+    // ilerleme ve arama sonucu farki olaylarini ilet (yuk zaten JSON)
+    for (const char* name : {"fileLoadProgress", "fileLoaded", "fileSaved", "fileSaveFailed", "fileTruncated",
+                             "bufferEditsApplied", "searchProgress", "searchResultsChanged"}) {
+        eb->on(name, [this, name](const EventBus::Event& e) {
+            json data = json::parse(e.payload, nullptr, false);
+            if (data.is_discarded()) return;
+            broadcastEvent(name, data);
+        });
+    }
 }
 
 // Start WebSocket server on given port with default configuration
@@ -151,6 +166,10 @@ void WebSocketServer::start(const ServerConfig& config)
                         json state = StateSnapshot::fullState(*edCtx_->buffers);
                         json resp = {{"event", "fullSync"}, {"data", state}};
                         ws.send(resp.dump());
+                    } else if (action == "grep") {
+                        startGrep(ws, body);
+                    } else if (action == "grepCancel") {
+                        cancelGreps(&ws, body.value("id", ""));
                     }
                 }
                 else
@@ -160,8 +179,11 @@ void WebSocketServer::start(const ServerConfig& config)
             }
             else if (msg->type == ix::WebSocketMessageType::Close)
             {
-                std::lock_guard<std::mutex> lock(clientsMutex_);
-                clients_.erase(&ws);
+                {
+                    std::lock_guard<std::mutex> lock(clientsMutex_);
+                    clients_.erase(&ws);
+                }
+                cancelGreps(&ws, "");
                 LOG_INFO("[WS] Client disconnected");
             }
         });
@@ -188,6 +210,10 @@ void WebSocketServer::stop()
     if (!running_) return;
     running_ = false;
 
+    // Greps still sending must be gone before the clients they send to
+    // Hala gonderen grep'ler, gonderdikleri istemcilerden once bitmeli
+    reapGreps(true);
+
     if (server_)
     {
         server_->stop();
@@ -211,3 +237,102 @@ void WebSocketServer::broadcast(const std::string& msg)
             ws->send(msg);
     }
 }
+
+// Send a message string to one client, skipped if it has disconnected meanwhile
+// Tek bir istemciye mesaj dizesi gonder, bu arada baglantisi koptuysa atlanir
+void WebSocketServer::sendTo(ix::WebSocket* ws, const std::string& msg)
+{
+    if (!running_ || !server_) return;
+
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    if (clients_.count(ws))
+        ws->send(msg);
+}
+
+// Run the search on its own thread so the client's socket keeps serving; dirty buffers are
+// snapshotted here and searched in place of their files. A new grep with the id of a running
+// one replaces it.
+// Istemcinin soketi hizmet vermeye devam etsin diye arama kendi thread'inde calisir; kirli
+// buffer'larin anlik goruntusu burada alinir ve dosyalarinin yerine aranir. Calisan bir grep'in
+// id'siyle gelen yeni grep onun yerini alir.
+void WebSocketServer::startGrep(ix::WebSocket& ws, const json& body)
+{
+    if (!edCtx_ || !edCtx_->workspaceSearch) return;
+    reapGreps(false);
+
+    auto job = std::make_unique<GrepJob>();
+    job->client = &ws;
+    job->id = body.value("id", "");
+    if (!job->id.empty()) cancelGreps(&ws, job->id);
+
+    WorkspaceQuery query;
+    query.root = body.value("root", "");
+    query.pattern = body.value("pattern", "");
+    query.opts.caseSensitive = body.value("caseSensitive", true);
+    query.opts.regex = body.value("regex", false);
+    query.opts.wholeWord = body.value("wholeWord", false);
+    query.maxResults = std::max(0, body.value("maxResults", 0));
+    query.maxFileSize = static_cast<uint64_t>(std::max(0, body.value("maxFileSizeMb", 0))) * 1024 * 1024;
+    if (body.contains("ignoreDirs") && body["ignoreDirs"].is_array()) {
+        for (const auto& d : body["ignoreDirs"]) {
+            if (d.is_string()) query.ignoreDirs.push_back(d.get<std::string>());
+        }
+    }
+    if (edCtx_->buffers) query.overrides = edCtx_->buffers->modifiedSnapshots();
+
+    GrepJob* raw = job.get();
+    query.cancel = &raw->cancel;
+    query.onBatch = [this, raw](std::vector<WorkspaceMatch>&& batch) {
+        json matches = json::array();
+        for (const auto& m : batch) {
+            matches.push_back({{"path", m.path}, {"line", m.line}, {"col", m.col}, {"length", m.length},
+                               {"endLine", m.endLine}, {"endCol", m.endCol}, {"text", m.text}});
+        }
+        json msg = {{"event", "grepResults"}, {"data", {{"id", raw->id}, {"matches", std::move(matches)}}}};
+        sendTo(raw->client, msg.dump());
+    };
+
+    WorkspaceSearch* search = edCtx_->workspaceSearch;
+    raw->thread = std::thread([this, raw, search, query = std::move(query)]() {
+        WorkspaceStats stats = search->run(query);
+        json data = {{"id", raw->id},
+                     {"stats", {{"files", stats.files}, {"filesMatched", stats.filesMatched},
+                                {"skipped", stats.skipped}, {"matches", stats.matches},
+                                {"truncated", stats.truncated}, {"cancelled", stats.cancelled}}}};
+        json msg = {{"event", "grepDone"}, {"data", std::move(data)}};
+        sendTo(raw->client, msg.dump());
+        raw->done = true;
+    });
+
+    std::lock_guard<std::mutex> lock(grepMutex_);
+    grepJobs_.push_back(std::move(job));
+}
+
+// Flag the matching greps; their threads notice at the next file and are joined by reapGreps
+// Eslesen grep'leri isaretle; thread'leri bir sonraki dosyada fark eder ve reapGreps ile beklenir
+void WebSocketServer::cancelGreps(ix::WebSocket* ws, const std::string& id)
+{
+    std::lock_guard<std::mutex> lock(grepMutex_);
+    for (auto& job : grepJobs_) {
+        if (job->client == ws && (id.empty() || job->id == id)) job->cancel = true;
+    }
+}
+
+// Threads are joined outside grepMutex_: a grep still running may be sending
+// Thread'ler grepMutex_ disinda beklenir: hala calisan bir grep gonderiyor olabilir
+void WebSocketServer::reapGreps(bool all)
+{
+    std::list<std::unique_ptr<GrepJob>> finished;
+    {
+        std::lock_guard<std::mutex> lock(grepMutex_);
+        for (auto it = grepJobs_.begin(); it != grepJobs_.end();) {
+            auto next = std::next(it);
+            if (all) (*it)->cancel = true;
+            if (all || (*it)->done) finished.splice(finished.end(), grepJobs_, it);
+            it = next;
+        }
+    }
+    for (auto& job : finished) {
+        if (job->thread.joinable()) job->thread.join();
+    }
+}
@@ -7,6 +7,8 @@
 #include <ixwebsocket/IXWebSocketServer.h>
 #include <ixwebsocket/IXWebSocketMessageType.h>
 #include <atomic>
+#include <list>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <set>
@@ -63,10 +65,40 @@ private:
     // Gercek zamanli senkronizasyon yayini icin EventBus dinleyicilerini kaydet
     void setupEventBusListeners();
 
+    // A workspace search ("grep" action) streaming its matches to the client that asked
+    // Eslemelerini isteyen istemciye akitan bir calisma alani aramasi ("grep" eylemi)
+    struct GrepJob {
+        ix::WebSocket* client = nullptr;
+        std::string id;
+        std::atomic<bool> cancel{false};
+        std::atomic<bool> done{false};
+        std::thread thread;
+    };
+
+    // Start a grep for ws: {"action":"grep","id","pattern","root",options...}. Matches go out as
+    // "grepResults" {id, matches} batches, then one "grepDone" {id, stats}.
+    // ws icin bir grep baslat: {"action":"grep","id","pattern","root",secenekler...}. Eslemeler
+    // "grepResults" {id, matches} gruplari olarak, sonra tek bir "grepDone" {id, stats} olarak gider.
+    void startGrep(ix::WebSocket& ws, const json& body);
+
+    // Cancel the greps of a client; an empty id cancels all of them
+    // Bir istemcinin grep'lerini iptal et; bos id hepsini iptal eder
+    void cancelGreps(ix::WebSocket* ws, const std::string& id);
+
+    // Join finished greps (all of them, cancelling first, when all is true)
+    // Biten grep'leri bekle (all true ise once iptal ederek hepsini)
+    void reapGreps(bool all);
+
+    // Send to one client if it is still connected
+    // Hala bagliysa tek bir istemciye gonder
+    void sendTo(ix::WebSocket* ws, const std::string& msg);
+
     std::atomic<bool> running_{false};                   // Server running state / Sunucu calisma durumu
     std::unique_ptr<ix::WebSocketServer> server_;         // IXWebSocket server instance / IXWebSocket sunucu ornegi
     std::set<ix::WebSocket*> clients_;                    // Connected clients / Bagli istemciler
     std::mutex clientsMutex_;                              // Protects clients_ set / clients_ setini korur
     ServerConfig config_;                                  // Server configuration / Sunucu yapilandirmasi
     EditorContext* edCtx_ = nullptr;                       // Editor context / Editor baglami
+    std::list<std::unique_ptr<GrepJob>> grepJobs_;         // Running and finished greps / Calisan ve biten grep'ler
+    std::mutex grepMutex_;                                 // Protects grepJobs_ / grepJobs_'u korur
 };
@@ -106,6 +106,9 @@ void StartWatchers() {
         }
 
         auto watcher = std::make_unique<FileWatcher>();
+        // The search index is rewritten while running and must not trigger a restart
+        // Arama indeksi calisirken yeniden yazilir ve yeniden baslatmayi tetiklememelidir
+        watcher->setIgnoreDirs({"logs", "index"});
 
         watcher->onEvent([](const FileEventData& event) {
             const char* action = event.type == FileEvent::Created  ? "Created"  :
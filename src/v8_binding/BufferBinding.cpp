@@ -9,6 +9,7 @@
 #include "V8ResponseBuilder.h"
 #include "buffers.h"
 #include "file.h"
+#include "CommandRouter.h"
 #include <v8.h>
 
 // Context struct to pass both buffers pointer and i18n to lambda callbacks
@@ -16,6 +17,7 @@
 struct BufferCtx {
     Buffers* bufs;
     I18n* i18n;
+    CommandRouter* router;  // Runs buffer.applyEdits so JS and commands share one path / JS ve komutlar tek yolu paylassin diye buffer.applyEdits'i calistirir
 };
 
 // Register buffer API on editor.buffer JS object (load, save, getLine, insertChar, deleteChar, etc.)
@@ -24,7 +26,7 @@ void RegisterBufferBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
     auto v8ctx = isolate->GetCurrentContext();
     v8::Local<v8::Object> jsBuffer = v8::Object::New(isolate);
 
-    auto* bctx = new BufferCtx{ctx.buffers, ctx.i18n};
+    auto* bctx = new BufferCtx{ctx.buffers, ctx.i18n, ctx.commandRouter};
 
     // buffer.load(path) -> {ok, data: {success, message}, ...}
     jsBuffer->Set(v8ctx,
@@ -170,7 +172,7 @@ void RegisterBufferBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
         }, v8::External::New(isolate, bctx)).ToLocalChecked()
     ).Check();
 
-    // buffer.lineCount() -> {ok, data: number, meta: {total: number}, ...}
+    // buffer.lineCount() -> {ok, data: number, meta: {total: number, loading: bool}, ...}
     jsBuffer->Set(v8ctx,
         v8::String::NewFromUtf8Literal(isolate, "lineCount"),
         v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -179,8 +181,11 @@ void RegisterBufferBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
                 V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, bc ? bc->i18n : nullptr);
                 return;
             }
-            int count = bc->bufs->active().getBuffer().lineCount();
-            json meta = {{"total", count}};
+            auto& buf = bc->bufs->active().getBuffer();
+            int count = buf.lineCount();
+            // While a large file is still loading the count is a lower bound
+            // Buyuk bir dosya hala yuklenirken sayi bir alt sinirdir
+            json meta = {{"total", count}, {"loading", buf.isLoading()}};
             V8Response::ok(args, count, meta, "buffer.linecount.success",
                 {{"count", std::to_string(count)}}, bc->i18n);
         }, v8::External::New(isolate, bctx)).ToLocalChecked()
@@ -343,6 +348,123 @@ void RegisterBufferBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
         }, v8::External::New(isolate, bctx)).ToLocalChecked()
     ).Check();
 
+    // buffer.offsetOf(line, col) -> {ok, data: number, ...}
+    jsBuffer->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "offsetOf"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* bc = static_cast<BufferCtx*>(args.Data().As<v8::External>()->Value());
+            if (!bc || !bc->bufs) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, bc ? bc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 2) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "line, col"}}, bc->i18n);
+                return;
+            }
+            int line = args[0]->Int32Value(args.GetIsolate()->GetCurrentContext()).FromMaybe(0);
+            int col  = args[1]->Int32Value(args.GetIsolate()->GetCurrentContext()).FromMaybe(0);
+            uint64_t offset = bc->bufs->active().getBuffer().offsetOf(line, col);
+            V8Response::ok(args, offset);
+        }, v8::External::New(isolate, bctx)).ToLocalChecked()
+    ).Check();
+
+    // buffer.positionOf(offset) -> {ok, data: {line, col}, ...}
+    jsBuffer->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "positionOf"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* bc = static_cast<BufferCtx*>(args.Data().As<v8::External>()->Value());
+            if (!bc || !bc->bufs) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, bc ? bc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 1) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "offset"}}, bc->i18n);
+                return;
+            }
+            double raw = args[0]->NumberValue(args.GetIsolate()->GetCurrentContext()).FromMaybe(0);
+            uint64_t offset = raw > 0 ? static_cast<uint64_t>(raw) : 0;
+            TextPosition pos = bc->bufs->active().getBuffer().positionOf(offset);
+            V8Response::ok(args, json{{"line", pos.line}, {"col", pos.col}});
+        }, v8::External::New(isolate, bctx)).ToLocalChecked()
+    ).Check();
+
+    // buffer.applyEdits(edits) -> {ok, data: {applied, changes}, ...}
+    // Edits are {startLine, startCol, endLine, endCol, text} in bytes or LSP TextEdits in UTF-16, applied as one undo step
+    // Duzenlemeler bayt cinsinden {startLine, startCol, endLine, endCol, text} veya UTF-16 cinsinden LSP TextEdit'leri, tek geri alma adimi olarak uygulanir
+    jsBuffer->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "applyEdits"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* bc = static_cast<BufferCtx*>(args.Data().As<v8::External>()->Value());
+            if (!bc || !bc->bufs || !bc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, bc ? bc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 1) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "edits"}}, bc->i18n);
+                return;
+            }
+            auto* iso = args.GetIsolate();
+            auto ctx = iso->GetCurrentContext();
+            v8::Local<v8::String> str;
+            if (!args[0]->IsArray() || !v8::JSON::Stringify(ctx, args[0]).ToLocal(&str)) {
+                V8Response::error(args, "INVALID_ARG", "args.invalid_type",
+                    {{"name", "edits"}, {"expected", "array"}}, bc->i18n);
+                return;
+            }
+            v8::String::Utf8Value raw(iso, str);
+            json edits = json::parse(*raw, nullptr, false);
+
+            json res = bc->router->executeWithResult("buffer.applyEdits", {{"edits", edits}});
+            if (!res.value("ok", false)) {
+                V8Response::error(args, "INVALID_EDITS", "buffer.applyedits.invalid", {}, bc->i18n);
+                return;
+            }
+            json data = res["data"];
+            V8Response::ok(args, data, nullptr, "buffer.applyedits.success",
+                {{"count", std::to_string(data.value("applied", 0))}}, bc->i18n);
+        }, v8::External::New(isolate, bctx)).ToLocalChecked()
+    ).Check();
+
+    // buffer.convertColumns(positions, from, to, tabWidth?) -> {ok, data: [{line, col}], ...}
+    // Units are "byte", "codepoint", "utf16" or "display"; all positions are converted in one call
+    // Birimler "byte", "codepoint", "utf16" veya "display"; tum konumlar tek cagrida donusturulur
+    jsBuffer->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "convertColumns"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* bc = static_cast<BufferCtx*>(args.Data().As<v8::External>()->Value());
+            if (!bc || !bc->bufs || !bc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, bc ? bc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 3) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "positions, from, to"}}, bc->i18n);
+                return;
+            }
+            auto* iso = args.GetIsolate();
+            auto ctx = iso->GetCurrentContext();
+            v8::Local<v8::String> str;
+            if (!args[0]->IsArray() || !v8::JSON::Stringify(ctx, args[0]).ToLocal(&str)) {
+                V8Response::error(args, "INVALID_ARG", "args.invalid_type",
+                    {{"name", "positions"}, {"expected", "array"}}, bc->i18n);
+                return;
+            }
+            v8::String::Utf8Value raw(iso, str);
+            v8::String::Utf8Value from(iso, args[1]);
+            v8::String::Utf8Value to(iso, args[2]);
+            json query = {{"positions", json::parse(*raw, nullptr, false)}, {"from", *from}, {"to", *to}};
+            if (args.Length() > 3 && args[3]->IsNumber()) {
+                query["tabWidth"] = args[3]->Int32Value(ctx).FromJust();
+            }
+
+            json res = bc->router->executeWithResult("buffer.convertColumns", query);
+            if (!res.value("ok", false)) {
+                V8Response::error(args, "INVALID_UNIT", "buffer.convertcolumns.invalid", {}, bc->i18n);
+                return;
+            }
+            V8Response::ok(args, res["data"]);
+        }, v8::External::New(isolate, bctx)).ToLocalChecked()
+    ).Check();
+
     // buffer.insertLine(text) -> {ok, data: true, ...}
     jsBuffer->Set(v8ctx,
         v8::String::NewFromUtf8Literal(isolate, "insertLine"),
@@ -67,7 +67,10 @@ void RegisterBuffersBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorOb
         }, v8::External::New(isolate, bctx)).ToLocalChecked()
     ).Check();
 
-    // buffers.saveActive() -> {ok, data: bool, ...}
+    // buffers.saveActive() -> {ok, data: queued, ...}; true means the save was queued, not written:
+    // the outcome arrives later as a "fileSaved" or "fileSaveFailed" event
+    // true kaydetmenin yazildigini degil siraya alindigini soyler: sonuc daha sonra
+    // "fileSaved" veya "fileSaveFailed" olayi olarak gelir
     jsBuffers->Set(v8ctx,
         v8::String::NewFromUtf8Literal(isolate, "saveActive"),
         v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args){
@@ -77,12 +80,13 @@ void RegisterBuffersBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorOb
                     {{"name", "buffers"}}, bc ? bc->i18n : nullptr);
                 return;
             }
-            bool result = bc->bufs->saveActive();
-            V8Response::ok(args, result);
+            bool queued = bc->bufs->saveActive();
+            V8Response::ok(args, queued);
         }, v8::External::New(isolate, bctx)).ToLocalChecked()
     ).Check();
 
-    // buffers.saveAll() -> {ok, data: savedCount, ...}
+    // buffers.saveAll() -> {ok, data: queuedCount, ...}; results arrive as events like saveActive's
+    // Sonuclar saveActive'inkiler gibi olay olarak gelir
     jsBuffers->Set(v8ctx,
         v8::String::NewFromUtf8Literal(isolate, "saveAll"),
         v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args){
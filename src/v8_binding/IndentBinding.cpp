@@ -197,7 +197,7 @@ void RegisterIndentBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
             }
 
             std::string newLine = ic->edCtx->indentEngine->increaseIndent(buf.getLine(line));
-            buf.getLineRef(line) = newLine;
+            buf.setLine(line, newLine);
             V8Response::ok(args, true);
         }, v8::External::New(isolate, ictx)).ToLocalChecked()
     ).Check();
@@ -229,7 +229,7 @@ void RegisterIndentBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
             }
 
             std::string newLine = ic->edCtx->indentEngine->decreaseIndent(buf.getLine(line));
-            buf.getLineRef(line) = newLine;
+            buf.setLine(line, newLine);
             V8Response::ok(args, true);
         }, v8::External::New(isolate, ictx)).ToLocalChecked()
     ).Check();
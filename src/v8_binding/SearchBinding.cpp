@@ -10,7 +10,9 @@
 #include "buffers.h"
 #include "state.h"
 #include "SearchEngine.h"
+#include "CommandRouter.h"
 #include <v8.h>
+#include <algorithm>
 
 // Helper: extract string from V8 value
 // Yardimci: V8 degerinden string cikar
@@ -30,6 +32,7 @@ static SearchOptions extractOpts(v8::Isolate* iso, v8::Local<v8::Context> ctx,
         auto reKey = v8::String::NewFromUtf8Literal(iso, "regex");
         auto wwKey = v8::String::NewFromUtf8Literal(iso, "wholeWord");
         auto waKey = v8::String::NewFromUtf8Literal(iso, "wrapAround");
+        auto mlKey = v8::String::NewFromUtf8Literal(iso, "multiline");
 
         if (obj->Has(ctx, csKey).FromMaybe(false))
             opts.caseSensitive = obj->Get(ctx, csKey).ToLocalChecked()->BooleanValue(iso);
@@ -39,16 +42,33 @@ static SearchOptions extractOpts(v8::Isolate* iso, v8::Local<v8::Context> ctx,
             opts.wholeWord = obj->Get(ctx, wwKey).ToLocalChecked()->BooleanValue(iso);
         if (obj->Has(ctx, waKey).FromMaybe(false))
             opts.wrapAround = obj->Get(ctx, waKey).ToLocalChecked()->BooleanValue(iso);
+        if (obj->Has(ctx, mlKey).FromMaybe(false))
+            opts.multiline = obj->Get(ctx, mlKey).ToLocalChecked()->BooleanValue(iso);
     }
     return opts;
 }
 
+// Helper: read the maxResults limit from a JS options object
+// Yardimci: JS secenekler nesnesinden maxResults sinirini oku
+static SearchScan extractScan(v8::Isolate* iso, v8::Local<v8::Context> ctx,
+                              const v8::FunctionCallbackInfo<v8::Value>& args, int optIdx) {
+    SearchScan scan;
+    if (args.Length() > optIdx && args[optIdx]->IsObject()) {
+        auto obj = args[optIdx].As<v8::Object>();
+        auto mrKey = v8::String::NewFromUtf8Literal(iso, "maxResults");
+        if (obj->Has(ctx, mrKey).FromMaybe(false))
+            scan.maxResults = std::max(0, obj->Get(ctx, mrKey).ToLocalChecked()->Int32Value(ctx).FromMaybe(0));
+    }
+    return scan;
+}
+
 // Helper: convert SearchMatch to nlohmann::json
 // Yardimci: SearchMatch'i nlohmann::json'a cevir
 static json matchToJson(const SearchMatch& m) {
     return json({
         {"line", m.line},
         {"col", m.col},
+        {"endLine", m.endLine},
         {"endCol", m.endCol},
         {"length", m.length}
     });
@@ -60,6 +80,7 @@ struct SearchCtx {
     Buffers* bufs;
     SearchEngine* engine;
     I18n* i18n;
+    CommandRouter* router;  // Runs search.replaceAll so JS and commands share one path / JS ve komutlar tek yolu paylassin diye search.replaceAll'u calistirir
 };
 
 // Register editor.search JS object with standard response format
@@ -68,7 +89,7 @@ void RegisterSearchBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
     auto v8ctx = isolate->GetCurrentContext();
     v8::Local<v8::Object> jsSearch = v8::Object::New(isolate);
 
-    auto* sctx = new SearchCtx{edCtx.buffers, edCtx.searchEngine, edCtx.i18n};
+    auto* sctx = new SearchCtx{edCtx.buffers, edCtx.searchEngine, edCtx.i18n, edCtx.commandRouter};
 
     // search.find(pattern, opts?) -> {ok, data: match|null, ...}
     // Mevcut imlec konumundan ileri ara
@@ -207,7 +228,9 @@ void RegisterSearchBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
             std::string pattern = v8Str(iso, args[0]);
             SearchOptions opts = extractOpts(iso, ctx, args, 1);
 
-            auto matches = sc->engine->findAll(sc->bufs->active().getBuffer(), pattern, opts);
+            SearchScan scan = extractScan(iso, ctx, args, 1);
+
+            auto matches = sc->engine->findAll(sc->bufs->active().getBuffer().snapshot(), pattern, opts, scan);
             json arr = json::array();
             for (const auto& m : matches) {
                 arr.push_back(matchToJson(m));
@@ -259,13 +282,14 @@ void RegisterSearchBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
         }, v8::External::New(isolate, sctx)).ToLocalChecked()
     ).Check();
 
-    // search.replaceAll(pattern, replacement, opts?) -> {ok, data: count, meta: {total: N}, ...}
-    // Tum oluslari degistir
+    // search.replaceAll(pattern, replacement, opts?) -> {ok, data: count, meta: {total: N, changes}, ...}
+    // One undo step and one bufferChanged event; with opts.dryRun data is the list of line rewrites instead
+    // Tum oluslari degistir: tek geri alma adimi ve tek bufferChanged olayi; opts.dryRun ile data bunun yerine satir yeniden yazimlari listesidir
     jsSearch->Set(v8ctx,
         v8::String::NewFromUtf8Literal(isolate, "replaceAll"),
         v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
             auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
-            if (!sc || !sc->bufs || !sc->engine) {
+            if (!sc || !sc->bufs || !sc->engine || !sc->router) {
                 V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
                 return;
             }
@@ -277,15 +301,32 @@ void RegisterSearchBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
             auto* iso = args.GetIsolate();
             auto ctx = iso->GetCurrentContext();
 
-            std::string pattern = v8Str(iso, args[0]);
-            std::string replacement = v8Str(iso, args[1]);
             SearchOptions opts = extractOpts(iso, ctx, args, 2);
+            bool dryRun = false;
+            if (args.Length() > 2 && args[2]->IsObject()) {
+                auto obj = args[2].As<v8::Object>();
+                auto drKey = v8::String::NewFromUtf8Literal(iso, "dryRun");
+                if (obj->Has(ctx, drKey).FromMaybe(false))
+                    dryRun = obj->Get(ctx, drKey).ToLocalChecked()->BooleanValue(iso);
+            }
 
-            auto& st = sc->bufs->active();
-            int count = sc->engine->replaceAll(st.getBuffer(), pattern, replacement, opts);
-            if (count > 0) st.markModified(true);
-
-            json meta = {{"total", count}};
+            json query = {
+                {"pattern", v8Str(iso, args[0])}, {"replacement", v8Str(iso, args[1])},
+                {"caseSensitive", opts.caseSensitive}, {"regex", opts.regex},
+                {"wholeWord", opts.wholeWord}, {"multiline", opts.multiline}, {"dryRun", dryRun}
+            };
+            json res = sc->router->executeWithResult("search.replaceAll", query);
+            json data = res.value("data", json::object());
+            int count = data.value("count", 0);
+
+            if (dryRun) {
+                json lines = data.value("lines", json::array());
+                json meta = {{"total", count}, {"dryRun", true}};
+                V8Response::ok(args, lines, meta, "search.replaceall.preview",
+                    {{"count", std::to_string(count)}, {"lines", std::to_string(lines.size())}}, sc->i18n);
+                return;
+            }
+            json meta = {{"total", count}, {"changes", data.value("changes", json::array())}};
             V8Response::ok(args, count, meta, "search.replaceall.success",
                 {{"count", std::to_string(count)}}, sc->i18n);
         }, v8::External::New(isolate, sctx)).ToLocalChecked()
@@ -310,7 +351,8 @@ void RegisterSearchBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
 
             std::string pattern = v8Str(iso, args[0]);
             SearchOptions opts = extractOpts(iso, ctx, args, 1);
-            int count = sc->engine->countMatches(sc->bufs->active().getBuffer(), pattern, opts);
+            SearchScan scan = extractScan(iso, ctx, args, 1);
+            int count = sc->engine->countMatches(sc->bufs->active().getBuffer().snapshot(), pattern, opts, scan);
 
             json meta = {{"total", count}};
             V8Response::ok(args, count, meta, "search.count.success",
@@ -318,6 +360,201 @@ void RegisterSearchBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj
         }, v8::External::New(isolate, sctx)).ToLocalChecked()
     ).Check();
 
+    // search.startSession(pattern, opts?) -> {ok, data: {count, version}, ...}
+    // Aramayi buffer duzenlendikce guncel tut; degisiklikler "searchResultsChanged" ile gelir
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "startSession"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 1) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "pattern"}}, sc->i18n);
+                return;
+            }
+            auto* iso = args.GetIsolate();
+            auto ctx = iso->GetCurrentContext();
+
+            std::string pattern = v8Str(iso, args[0]);
+            SearchOptions opts = extractOpts(iso, ctx, args, 1);
+            json query = {
+                {"pattern", pattern}, {"caseSensitive", opts.caseSensitive}, {"regex", opts.regex},
+                {"wholeWord", opts.wholeWord}, {"multiline", opts.multiline}
+            };
+            json data = sc->router->executeWithResult("search.session.start", query).value("data", json());
+            if (!data.is_object()) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "pattern"}}, sc->i18n);
+                return;
+            }
+            V8Response::ok(args, data, {{"total", data.value("count", 0)}}, "search.session.started",
+                {{"count", std::to_string(data.value("count", 0))}, {"pattern", pattern}}, sc->i18n);
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
+    // search.sessionMatches(firstLine?, lastLine?) -> {ok, data: [match, ...], meta: {total, version}, ...}
+    // Oturumun bir satir araligindaki (gorunum) eslemeleri; meta.total toplam esleme sayisidir
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "sessionMatches"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            auto* iso = args.GetIsolate();
+            auto ctx = iso->GetCurrentContext();
+
+            json query = json::object();
+            if (args.Length() > 0 && args[0]->IsNumber()) query["firstLine"] = args[0]->Int32Value(ctx).FromMaybe(0);
+            if (args.Length() > 1 && args[1]->IsNumber()) query["lastLine"] = args[1]->Int32Value(ctx).FromMaybe(0);
+            json data = sc->router->executeWithResult("search.session.query", query).value("data", json());
+            if (!data.is_object()) {
+                V8Response::ok(args, nullptr);
+                return;
+            }
+            json meta = {{"total", data.value("count", 0)}, {"version", data.value("version", 0)}};
+            V8Response::ok(args, data.value("matches", json::array()), meta);
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
+    // search.stopSession() -> {ok, data: true, ...}
+    // Arama oturumunu birak
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "stopSession"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            sc->router->execute("search.session.stop", json::object());
+            V8Response::ok(args, true);
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
+    // search.grep(pattern, opts?) -> {ok, data: [{path, line, col, length, endLine, endCol, text}, ...], meta: stats, ...}
+    // Bir dizin altindaki dosyalarda ara; opts: root, caseSensitive, regex, wholeWord, maxResults, maxFileSizeMb, ignoreDirs
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "grep"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 1) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "pattern"}}, sc->i18n);
+                return;
+            }
+            auto* iso = args.GetIsolate();
+            auto ctx = iso->GetCurrentContext();
+
+            json query = json::object();
+            v8::Local<v8::String> str;
+            if (args.Length() > 1 && args[1]->IsObject() && v8::JSON::Stringify(ctx, args[1]).ToLocal(&str)) {
+                query = json::parse(v8Str(iso, str), nullptr, false);
+                if (!query.is_object()) query = json::object();
+            }
+            std::string pattern = v8Str(iso, args[0]);
+            query["pattern"] = pattern;
+            json data = sc->router->executeWithResult("search.grep", query).value("data", json());
+            if (!data.is_object()) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "pattern"}}, sc->i18n);
+                return;
+            }
+            json stats = data.value("stats", json::object());
+            V8Response::ok(args, data.value("matches", json::array()), stats, "search.grep.success",
+                {{"count", std::to_string(stats.value("matches", 0))},
+                 {"files", std::to_string(stats.value("filesMatched", 0))}, {"pattern", pattern}}, sc->i18n);
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
+    // search.workspace(pattern, opts?) -> {ok, data: [{path, line, col, ...}, ...], meta: stats + {indexed, candidates}, ...}
+    // Calisma alaninda trigram indeksiyle ara; opts grep ile ayni, root varsayilan olarak calisma dizini
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "workspace"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 1) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "pattern"}}, sc->i18n);
+                return;
+            }
+            auto* iso = args.GetIsolate();
+            auto ctx = iso->GetCurrentContext();
+
+            json query = json::object();
+            v8::Local<v8::String> str;
+            if (args.Length() > 1 && args[1]->IsObject() && v8::JSON::Stringify(ctx, args[1]).ToLocal(&str)) {
+                query = json::parse(v8Str(iso, str), nullptr, false);
+                if (!query.is_object()) query = json::object();
+            }
+            std::string pattern = v8Str(iso, args[0]);
+            query["pattern"] = pattern;
+            json data = sc->router->executeWithResult("search.workspace", query).value("data", json());
+            if (!data.is_object()) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "pattern"}}, sc->i18n);
+                return;
+            }
+            json meta = data.value("stats", json::object());
+            meta["indexed"] = data.value("indexed", false);
+            meta["candidates"] = data.value("candidates", 0);
+            V8Response::ok(args, data.value("matches", json::array()), meta, "search.workspace.success",
+                {{"count", std::to_string(meta.value("matches", 0))},
+                 {"files", std::to_string(meta.value("filesMatched", 0))},
+                 {"candidates", std::to_string(meta.value("candidates", 0))}, {"pattern", pattern}}, sc->i18n);
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
+    // search.indexStatus() -> {ok, data: {ready, root, files, trigrams, pending, bytes} | null, ...}
+    // Calisma alani arama indeksinin durumu; indeksleme kapaliysa null
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "indexStatus"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            V8Response::ok(args, sc->router->executeWithResult("search.index.status", json::object()).value("data", json()));
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
+    // search.cancelGrep() -> {ok, data: true, ...}
+    // Calisan grep aramalarini durdur
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "cancelGrep"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->router) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            sc->router->execute("search.grep.cancel", json::object());
+            V8Response::ok(args, true);
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
+    // search.cancel() -> {ok, data: true, ...}
+    // Calisan findAll/count taramalarini durdur
+    jsSearch->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "cancel"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
+            auto* sc = static_cast<SearchCtx*>(args.Data().As<v8::External>()->Value());
+            if (!sc || !sc->engine) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, sc ? sc->i18n : nullptr);
+                return;
+            }
+            sc->engine->cancel();
+            V8Response::ok(args, true);
+        }, v8::External::New(isolate, sctx)).ToLocalChecked()
+    ).Check();
+
     editorObj->Set(v8ctx,
         v8::String::NewFromUtf8Literal(isolate, "search"),
         jsSearch).Check();
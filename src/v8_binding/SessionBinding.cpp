@@ -24,6 +24,9 @@ static json sessionDocToJson(const SessionDocument& doc, bool includeScrollTop =
     if (includeIsActive) {
         obj["isActive"] = doc.isActive;
     }
+    if (!doc.undoFile.empty()) {
+        obj["undoFile"] = doc.undoFile;
+    }
     return obj;
 }
 
@@ -10,6 +10,7 @@
 #include "EditorContext.h"
 #include "V8ResponseBuilder.h"
 #include "TreeSitterEngine.h"
+#include "BufferSnapshot.h"
 #include "buffers.h"
 #include "state.h"
 #include <v8.h>
@@ -183,18 +184,14 @@ void RegisterTreeSitterBinding(v8::Isolate* isolate, v8::Local<v8::Object> edito
             }
             auto* iso = args.GetIsolate();
 
-            std::string source;
+            bool result = false;
             if (args.Length() > 0) {
-                source = v8Str(iso, args[0]);
+                result = tc->engine->parse(v8Str(iso, args[0]));
             } else if (tc->bufs) {
-                auto& buf = tc->bufs->active().getBuffer();
-                for (int i = 0; i < buf.lineCount(); ++i) {
-                    if (i > 0) source += '\n';
-                    source += buf.getLine(i);
-                }
+                // Read the active buffer through a snapshot, no joined copy
+                // Aktif buffer'i birlesik kopya olmadan anlik goruntu uzerinden oku
+                result = tc->engine->parse(tc->bufs->active().getBuffer().snapshot());
             }
-
-            bool result = tc->engine->parse(source);
             V8Response::ok(args, result);
         }, v8::External::New(isolate, tctx)).ToLocalChecked()
     ).Check();
@@ -290,11 +287,17 @@ void RegisterTreeSitterBinding(v8::Isolate* isolate, v8::Local<v8::Object> edito
             if (args.Length() > 1) {
                 source = v8Str(iso, args[1]);
             } else if (tc->bufs) {
-                auto& buf = tc->bufs->active().getBuffer();
-                for (int i = 0; i < buf.lineCount(); ++i) {
-                    if (i > 0) source += '\n';
-                    source += buf.getLine(i);
-                }
+                // Join once into a buffer sized from the offset index
+                // Ofset indeksinden boyutlanan bir tampona tek seferde birlestir
+                BufferSnapshot snap = tc->bufs->active().getBuffer().snapshot();
+                source.reserve(snap.byteCount());
+                snap.forEachChunk(0, snap.lineCount(), [&source](int first, const std::string_view* views, int count) {
+                    for (int i = 0; i < count; ++i) {
+                        if (first + i > 0) source += '\n';
+                        source.append(views[i]);
+                    }
+                    return true;
+                });
             }
 
             int startLine = (args.Length() > 2) ? args[2]->Int32Value(ctx).FromJust() : 0;
@@ -377,8 +380,8 @@ void RegisterTreeSitterBinding(v8::Isolate* isolate, v8::Local<v8::Object> edito
         }, v8::External::New(isolate, tctx)).ToLocalChecked()
     ).Check();
 
-    // treesitter.editAndReparse(startLine, startCol, oldEndLine, oldEndCol, newEndLine, newEndCol, newSource) -> {ok, data: bool}
-    // Duzenleme uygula ve artimsal olarak yeniden ayristir
+    // treesitter.editAndReparse(startLine, startCol, oldEndLine, oldEndCol, newEndLine, newEndCol, newSource?) -> {ok, data: bool}
+    // Duzenleme uygula ve artimsal olarak yeniden ayristir (varsayilan olarak aktif buffer)
     jsTS->Set(v8ctx,
         v8::String::NewFromUtf8Literal(isolate, "editAndReparse"),
         v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -388,7 +391,7 @@ void RegisterTreeSitterBinding(v8::Isolate* isolate, v8::Local<v8::Object> edito
                     {{"name", "treeSitterEngine"}}, tc ? tc->i18n : nullptr);
                 return;
             }
-            if (args.Length() < 7) {
+            if (args.Length() < 6 || (args.Length() < 7 && !tc->bufs)) {
                 V8Response::error(args, "MISSING_ARG", "args.missing",
                     {{"name", "startLine, startCol, oldEndLine, oldEndCol, newEndLine, newEndCol, newSource"}}, tc->i18n);
                 return;
@@ -402,11 +405,17 @@ void RegisterTreeSitterBinding(v8::Isolate* isolate, v8::Local<v8::Object> edito
             int oldEndCol   = args[3]->Int32Value(ctx).FromJust();
             int newEndLine  = args[4]->Int32Value(ctx).FromJust();
             int newEndCol   = args[5]->Int32Value(ctx).FromJust();
-            std::string newSource = v8Str(iso, args[6]);
 
-            bool result = tc->engine->editAndReparse(
-                startLine, startCol, oldEndLine, oldEndCol,
-                newEndLine, newEndCol, newSource);
+            bool result;
+            if (args.Length() < 7) {
+                result = tc->engine->editAndReparse(
+                    startLine, startCol, oldEndLine, oldEndCol,
+                    newEndLine, newEndCol, tc->bufs->active().getBuffer().snapshot());
+            } else {
+                result = tc->engine->editAndReparse(
+                    startLine, startCol, oldEndLine, oldEndCol,
+                    newEndLine, newEndCol, v8Str(iso, args[6]));
+            }
             V8Response::ok(args, result);
         }, v8::External::New(isolate, tctx)).ToLocalChecked()
     ).Check();
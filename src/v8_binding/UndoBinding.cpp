@@ -8,6 +8,7 @@
 #include "EditorContext.h"
 #include "V8ResponseBuilder.h"
 #include "buffers.h"
+#include "EventBus.h"
 #include "undo.h"
 #include <v8.h>
 
@@ -16,6 +17,7 @@
 struct UndoCtx {
     Buffers* bufs;
     I18n* i18n;
+    EventBus* eventBus;
 };
 
 // Register undo/redo API on editor.undo JS object (addAction, undo, redo)
@@ -24,7 +26,7 @@ void RegisterUndoBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj,
     auto v8ctx = isolate->GetCurrentContext();
     v8::Local<v8::Object> jsUndo = v8::Object::New(isolate);
 
-    auto* uctx = new UndoCtx{ctx.buffers, ctx.i18n};
+    auto* uctx = new UndoCtx{ctx.buffers, ctx.i18n, ctx.eventBus};
 
     // undo.addAction(type, line, col, char, lineContent) -> {ok, data: true, ...}
     // Geri alma yiginina yeni bir eylem ekle
@@ -193,6 +195,77 @@ void RegisterUndoBinding(v8::Isolate* isolate, v8::Local<v8::Object> editorObj,
         }, v8::External::New(isolate, uctx)).ToLocalChecked()
     ).Check();
 
+    // undo.gotoNode(id) -> {ok, data: bool, ...}: jump to any node, one bufferChanged event
+    // undo.gotoNode(id) -> {ok, data: bool, ...}: herhangi bir dugume atla, tek bufferChanged olayi
+    jsUndo->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "gotoNode"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args){
+            auto* uc = static_cast<UndoCtx*>(args.Data().As<v8::External>()->Value());
+            if (!uc || !uc->bufs) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, uc ? uc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 1) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "id"}}, uc->i18n);
+                return;
+            }
+            uint32_t id = args[0]->Uint32Value(args.GetIsolate()->GetCurrentContext()).FromMaybe(0);
+            auto& st = uc->bufs->active();
+            bool moved = st.getUndo().gotoNode(id, st.getBuffer());
+            if (moved) {
+                st.syncCursor();
+                if (uc->eventBus) uc->eventBus->emit("bufferChanged", st.getFilePath());
+            }
+            V8Response::ok(args, moved);
+        }, v8::External::New(isolate, uctx)).ToLocalChecked()
+    ).Check();
+
+    // undo.gotoTime(unixMs) -> {ok, data: bool, ...}: state as of a moment (Date.now() - 30000)
+    // undo.gotoTime(unixMs) -> {ok, data: bool, ...}: bir andaki durum (Date.now() - 30000)
+    jsUndo->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "gotoTime"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args){
+            auto* uc = static_cast<UndoCtx*>(args.Data().As<v8::External>()->Value());
+            if (!uc || !uc->bufs) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, uc ? uc->i18n : nullptr);
+                return;
+            }
+            if (args.Length() < 1) {
+                V8Response::error(args, "MISSING_ARG", "args.missing", {{"name", "time"}}, uc->i18n);
+                return;
+            }
+            double when = args[0]->NumberValue(args.GetIsolate()->GetCurrentContext()).FromMaybe(0);
+            auto& st = uc->bufs->active();
+            bool moved = st.getUndo().gotoTime(static_cast<int64_t>(when), st.getBuffer());
+            if (moved) {
+                st.syncCursor();
+                if (uc->eventBus) uc->eventBus->emit("bufferChanged", st.getFilePath());
+            }
+            V8Response::ok(args, moved);
+        }, v8::External::New(isolate, uctx)).ToLocalChecked()
+    ).Check();
+
+    // undo.tree() -> {ok, data: {root, current, nodes: [{id, parent, activeChild, type, line, col, length, groupSize, time}]}}
+    // undo.tree(): agac gorsellestiricileri icin tum dugumler, ebeveynler cocuklardan once
+    jsUndo->Set(v8ctx,
+        v8::String::NewFromUtf8Literal(isolate, "tree"),
+        v8::Function::New(v8ctx, [](const v8::FunctionCallbackInfo<v8::Value>& args){
+            auto* uc = static_cast<UndoCtx*>(args.Data().As<v8::External>()->Value());
+            if (!uc || !uc->bufs) {
+                V8Response::error(args, "NULL_CONTEXT", "internal.null_context", {}, uc ? uc->i18n : nullptr);
+                return;
+            }
+            auto& undo = uc->bufs->active().getUndo();
+            json nodes = json::array();
+            for (const auto& n : undo.tree()) {
+                nodes.push_back({{"id", n.id}, {"parent", n.parent}, {"activeChild", n.activeChild},
+                                 {"type", actionTypeName(n.type)}, {"line", n.line}, {"col", n.col},
+                                 {"length", n.textLen}, {"groupSize", n.groupSize}, {"time", n.time}});
+            }
+            V8Response::ok(args, json{{"root", undo.rootId()}, {"current", undo.currentId()}, {"nodes", nodes}});
+        }, v8::External::New(isolate, uctx)).ToLocalChecked()
+    ).Check();
+
     editorObj->Set(v8ctx, v8::String::NewFromUtf8Literal(isolate, "undo"), jsUndo).Check();
 }
 
@@ -0,0 +1,174 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "PositionMap.h"
+#include "buffer.h"
+#include "undo.h"
+
+#include <string>
+#include <vector>
+
+// Edit builder / Duzenleme olusturucu
+static TextEdit edit(int startLine, int startCol, int endLine, int endCol, const std::string& text) {
+    TextEdit e;
+    e.startLine = startLine;
+    e.startCol = startCol;
+    e.endLine = endLine;
+    e.endCol = endCol;
+    e.text = text;
+    return e;
+}
+
+// A batch mixing a multi-line replacement, a line join and two inserts at one position lands
+// as one version, is reported bottom to top, and undoes and redoes as a single step
+// Cok satirli bir degistirme, bir satir birlestirme ve ayni konumda iki ekleme iceren bir grup
+// tek surum olarak uygulanir, alttan uste raporlanir ve tek adimda geri alinip yinelenir
+static void testBatchIsOneStep() {
+    Buffer buffer;
+    buffer.loadLines({"alpha beta", "gamma", "delta", "epsilon"});
+    UndoManager undo;
+    const std::string original = dump(buffer);
+    const uint64_t before = buffer.version();
+
+    std::vector<TextEdit> edits = {
+        edit(0, 6, 0, 10, "B\nBB"),
+        edit(1, 5, 2, 0, " "),
+        edit(3, 0, 3, 0, "1"),
+        edit(3, 0, 3, 0, "2"),
+    };
+    std::vector<AppliedEdit> applied;
+    CHECK(buffer.applyEdits(edits, &applied));
+    const std::string edited = "alpha B\nBB\ngamma delta\n12epsilon\n";
+    CHECK(dump(buffer) == edited);
+    CHECK(buffer.version() == before + 1);
+
+    CHECK(applied.size() == 4);
+    CHECK(applied.front().edit.startLine == 3 && applied.front().edit.text == "2");
+    CHECK(applied.back().edit.startLine == 0 && applied.back().removed == "beta");
+    CHECK(applied.back().newEndLine == 1 && applied.back().newEndCol == 2);
+
+    // Every line change of the batch belongs to its one version
+    // Grubun her satir degisikligi onun tek surumune aittir
+    std::vector<LineChange> changes;
+    CHECK(buffer.changesSince(before, before + 1, changes) && changes.size() == 4);
+
+    // Positions below the batch move by the lines it added and removed
+    // Grubun altindaki konumlar ekledigi ve sildigi satirlar kadar kayar
+    PositionMap map(applied);
+    int line = 3, col = 3;
+    map.map(line, col);
+    CHECK(line == 3 && col == 5);
+
+    undo.addEdits(applied);
+    CHECK(undo.undo(buffer));
+    CHECK(dump(buffer) == original);
+    CHECK(!undo.undo(buffer));
+    CHECK(undo.redo(buffer));
+    CHECK(dump(buffer) == edited);
+}
+
+// Overlapping or out-of-range batches are refused whole: no edit lands, the version stays and
+// applied is left alone
+// Cakisan veya aralik disi gruplar butunuyle reddedilir: hicbir duzenleme uygulanmaz, surum
+// kalir ve applied'a dokunulmaz
+static void testRejectedBatch() {
+    Buffer buffer;
+    buffer.loadLines({"one", "two", "three"});
+    const std::string original = dump(buffer);
+    const uint64_t before = buffer.version();
+
+    const std::vector<std::vector<TextEdit>> bad = {
+        {edit(0, 0, 0, 1, "x"), edit(0, 2, 1, 1, "y"), edit(0, 0, 0, 3, "z")},
+        {edit(2, 0, 2, 1, "x"), edit(3, 0, 3, 0, "y")},
+        {edit(1, 0, 1, 4, "x")},
+        {edit(1, 2, 1, 1, "x")},
+        {edit(0, 0, 0, 0, "x"), edit(-1, 0, 0, 0, "y")},
+    };
+    for (const auto& edits : bad) {
+        std::vector<AppliedEdit> applied(1);
+        CHECK(!buffer.applyEdits(edits, &applied));
+        CHECK(applied.size() == 1);
+        CHECK(dump(buffer) == original);
+        CHECK(buffer.version() == before);
+    }
+}
+
+// A range past the by-reference threshold is restored on undo from the table sealed before the
+// batch, whatever ran after it
+// Referans esigini asan bir aralik, geri almada ondan sonra ne calismis olursa olsun gruptan
+// once muhurlenen tablodan geri yuklenir
+static void testLargeRemoval() {
+    Buffer buffer;
+    std::vector<std::string> lines;
+    for (int i = 0; i < 20000; ++i) lines.push_back("line " + std::to_string(i));
+    buffer.loadLines(std::move(lines));
+    UndoManager undo;
+    const std::string original = dump(buffer);
+
+    std::vector<AppliedEdit> applied;
+    CHECK(buffer.applyEdits({edit(10, 2, 19990, 4, "cut"), edit(19995, 0, 19995, 0, ">")}, &applied));
+    CHECK(buffer.lineCount() == 20000 - 19980);
+    CHECK(buffer.getLine(10) == "licut 19990");
+    bool byReference = false;
+    for (const auto& a : applied) byReference |= a.removedFrom != nullptr && a.removed.empty();
+    CHECK(byReference);
+
+    undo.addEdits(applied);
+    buffer.insertText(0, 0, "later ");
+    undo.breakRun();
+    Action typed;
+    typed.type = ActionType::InsertText;
+    typed.line = 0;
+    typed.col = 0;
+    typed.lineContent = "later ";
+    undo.addAction(typed);
+    CHECK(undo.undo(buffer) && undo.undo(buffer));
+    CHECK(dump(buffer) == original);
+}
+
+// LSP ranges count UTF-16 code units: an edit after multi-byte characters lands on their byte
+// columns, a column past the line's end is its end, and a formatter's whole-document edit
+// ending on the line after the last replaces everything as one undo step
+// LSP araliklari UTF-16 kod birimi sayar: cok baytli karakterlerden sonraki bir duzenleme
+// onlarin bayt sutunlarina denk gelir, satir sonunun otesindeki bir sutun satirin sonudur ve
+// bir bicimlendiricinin sondan sonraki satirda biten tum belge duzenlemesi her seyi tek geri
+// alma adiminda degistirir
+static void testUtf16Ranges() {
+    Buffer buffer;
+    buffer.loadLines({"\xC3\xA7" "ay \xE2\x98\x95 \xF0\x9F\x98\x80 end", "ascii", "last"});
+    UndoManager undo;
+    const std::string original = dump(buffer);
+
+    std::vector<AppliedEdit> applied;
+    CHECK(buffer.applyEdits({edit(0, 9, 0, 99, "END"), edit(1, 50, 1, 50, "!")}, &applied, ColumnUnit::UTF16));
+    CHECK(buffer.getLine(0) == "\xC3\xA7" "ay \xE2\x98\x95 \xF0\x9F\x98\x80 END");
+    CHECK(buffer.getLine(1) == "ascii!");
+    CHECK(applied.size() == 2);
+    CHECK(applied.back().edit.startCol == 14 && applied.back().edit.endCol == 17);
+    CHECK(applied.back().removed == "end");
+    undo.addEdits(applied);
+    const std::string edited = dump(buffer);
+
+    // Still rejected in bytes, where the same columns would split a character or overrun
+    // Baytlarda hala reddedilir; ayni sutunlar orada bir karakteri boler veya tasar
+    CHECK(!buffer.applyEdits({edit(0, 9, 0, 99, "END")}));
+
+    CHECK(buffer.applyEdits({edit(0, 0, 3, 0, "formatted\ntext")}, &applied, ColumnUnit::UTF16));
+    CHECK(dump(buffer) == "formatted\ntext\n");
+    undo.addEdits(applied);
+    CHECK(undo.undo(buffer));
+    CHECK(dump(buffer) == edited);
+    CHECK(undo.undo(buffer));
+    CHECK(dump(buffer) == original);
+}
+
+int main() {
+    testBatchIsOneStep();
+    testRejectedBatch();
+    testLargeRemoval();
+    testUtf16Ranges();
+    return checkResult("ApplyEditsTest");
+}
@@ -0,0 +1,152 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#pragma once
+#include "BufferSnapshot.h"
+#include "RegexEngine.h"
+#include "SearchEngine.h"
+#include "buffer.h"
+#include "undo.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Minimal checks for the engine tests: a failed CHECK prints where it failed and the test
+// keeps going; main returns checkResult() so ctest sees a non-zero exit code.
+// Motor testleri icin asgari denetimler: basarisiz bir CHECK nerede basarisiz oldugunu yazar ve
+// test devam eder; main checkResult() dondurur, boylece ctest sifir olmayan bir cikis kodu gorur.
+// Fixtures used by more than one test (scratch directories, file and buffer text, undo actions,
+// match comparisons) live here too instead of being copied into each test.
+// Birden fazla testin kullandigi fiksturler (karalama dizinleri, dosya ve buffer metni, geri alma
+// eylemleri, esleme karsilastirmalari) her teste kopyalanmak yerine burada da yasar.
+
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++checkFailures();                                                        \
+        }                                                                             \
+    } while (0)
+
+// Print a summary line and turn the failure count into an exit code
+// Bir ozet satiri yaz ve basarisizlik sayisini bir cikis koduna cevir
+inline int checkResult(const char* name) {
+    std::printf("%s: %s (%d failed)\n", name, checkFailures() ? "FAIL" : "ok", checkFailures());
+    return checkFailures() ? 1 : 0;
+}
+
+// Fresh scratch directory under the system temp directory, removed when it goes out of scope
+// Sistem gecici dizini altinda taze bir karalama dizini, kapsam disina cikinca silinir
+struct TempDir {
+    std::filesystem::path path;
+
+    explicit TempDir(const std::string& name)
+        : path(std::filesystem::temp_directory_path() / ("berkide-test-" + name)) {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+        std::filesystem::create_directories(path, ec);
+    }
+
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    std::string file(const std::string& name) const { return (path / name).string(); }
+};
+
+// Whole file as bytes / Tum dosya bayt olarak
+inline std::string slurp(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+// Whole buffer as text, after any progressive load finishes
+// Herhangi bir asamali yukleme bittikten sonra tum buffer metin olarak
+inline std::string dump(const Buffer& buffer) {
+    const BufferSnapshot snapshot = buffer.snapshot().completed();
+    std::string text;
+    for (int i = 0; i < snapshot.lineCount(); ++i) text += snapshot.getLine(i) + '\n';
+    return text;
+}
+
+// Single-character action / Tek karakterlik eylem
+inline Action charAction(ActionType type, int line, int col, char c) {
+    Action action;
+    action.type = type;
+    action.line = line;
+    action.col = col;
+    action.character = c;
+    return action;
+}
+
+// Whole-line insert action / Tum satir ekleme eylemi
+inline Action lineAction(int line, const std::string& text) {
+    Action action;
+    action.type = ActionType::InsertLine;
+    action.line = line;
+    action.col = 0;
+    action.lineContent = text;
+    return action;
+}
+
+// Text insert action / Metin ekleme eylemi
+inline Action textAction(int line, int col, const std::string& inserted) {
+    Action action;
+    action.type = ActionType::InsertText;
+    action.line = line;
+    action.col = col;
+    action.lineContent = inserted;
+    return action;
+}
+
+// Range deletion kept by reference: the buffer cuts and hands back the table sealed before it
+// Referansla tutulan aralik silme: buffer keser ve oncesinde muhurlenen tabloyu geri verir
+inline Action cutAction(Buffer& buffer, int line, int col, int lineEnd, int colEnd) {
+    Action action;
+    action.type = ActionType::DeleteRange;
+    action.line = line;
+    action.col = col;
+    action.lineEnd = lineEnd;
+    action.colEnd = colEnd;
+    action.removedFrom = buffer.cutRange(line, col, lineEnd, colEnd);
+    return action;
+}
+
+// Same search matches in the same order; with a count, only the first count of each
+// Ayni sirada ayni arama eslemeleri; bir sayiyla, her birinin yalnizca ilk count tanesi
+inline bool sameMatches(const std::vector<SearchMatch>& a, const std::vector<SearchMatch>& b,
+                        size_t count = SIZE_MAX) {
+    if (count == SIZE_MAX) {
+        if (a.size() != b.size()) return false;
+        count = a.size();
+    }
+    if (a.size() < count || b.size() < count) return false;
+    for (size_t i = 0; i < count; ++i) {
+        if (a[i].line != b[i].line || a[i].col != b[i].col || a[i].endLine != b[i].endLine ||
+            a[i].endCol != b[i].endCol || a[i].length != b[i].length) return false;
+    }
+    return true;
+}
+
+// Same regex matches (positions, lengths and groups) / Ayni regex eslemeleri (konumlar, uzunluklar ve gruplar)
+inline bool sameMatches(const std::vector<RegexMatch>& a, const std::vector<RegexMatch>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].position != b[i].position || a[i].length != b[i].length || a[i].groups != b[i].groups) return false;
+    return true;
+}
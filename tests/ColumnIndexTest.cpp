@@ -0,0 +1,107 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "ColumnIndex.h"
+#include "buffer.h"
+
+#include <string>
+#include <vector>
+
+static constexpr ColumnUnit kUnits[] = {ColumnUnit::Byte, ColumnUnit::Codepoint, ColumnUnit::UTF16,
+                                        ColumnUnit::Display};
+
+// "a", tab, "é" (2 bytes), "中" (3 bytes, 2 cells), "😀" (4 bytes, 2 UTF-16 units, 2 cells), "x":
+// every unit's column at each codepoint boundary, worked out by hand for tab width 4
+// "a", sekme, "é" (2 bayt), "中" (3 bayt, 2 hucre), "😀" (4 bayt, 2 UTF-16 birimi, 2 hucre), "x":
+// her birimin her kod noktasi sinirindaki sutunu, sekme genisligi 4 icin elle hesaplanmis
+static void testMixedLine() {
+    const std::string text = "a\t\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80x";
+    const std::vector<std::vector<int>> at = {
+        {0, 1, 2, 4, 7, 11, 12},   // Byte
+        {0, 1, 2, 3, 4, 5, 6},     // Codepoint
+        {0, 1, 2, 3, 4, 6, 7},     // UTF16
+        {0, 1, 4, 5, 7, 9, 10},    // Display
+    };
+    ColumnIndex index;
+    const ColumnIndex::Line& line = index.build(0, text, 4);
+    CHECK(!line.simple);
+    for (int u = 0; u < 4; ++u) CHECK(line.length(kUnits[u]) == at[u].back());
+
+    for (size_t k = 0; k < at[0].size(); ++k)
+        for (int from = 0; from < 4; ++from)
+            for (int to = 0; to < 4; ++to)
+                CHECK(line.convert(at[from][k], kUnits[from], kUnits[to]) == at[to][k]);
+
+    // Inside a character snaps to its start; negative and past-the-end columns clamp
+    // Bir karakterin ici basina oturur; negatif ve sondan sonraki sutunlar sinirlanir
+    CHECK(line.convert(5, ColumnUnit::Byte, ColumnUnit::Codepoint) == 3);
+    CHECK(line.convert(8, ColumnUnit::Display, ColumnUnit::Byte) == 7);
+    CHECK(line.convert(2, ColumnUnit::Display, ColumnUnit::UTF16) == 1);
+    CHECK(line.convert(5, ColumnUnit::UTF16, ColumnUnit::Byte) == 7);
+    CHECK(line.convert(-3, ColumnUnit::Display, ColumnUnit::Byte) == 0);
+    CHECK(line.convert(99, ColumnUnit::Byte, ColumnUnit::Display) == 10);
+
+    CHECK(index.find(0, 4) == &line);
+    CHECK(index.find(0, 8) == nullptr);
+    CHECK(index.build(0, text, 8).convert(2, ColumnUnit::Byte, ColumnUnit::Display) == 8);
+}
+
+// ASCII without tabs keeps no tables; combining marks take no cell; a malformed byte is a
+// column of its own; the names parse
+// Sekmesiz ASCII tablo tutmaz; birlesen isaretler hucre kaplamaz; bozuk bir bayt kendi basina
+// bir sutundur; adlar ayristirilir
+static void testSpecialCases() {
+    ColumnIndex index;
+    const ColumnIndex::Line& ascii = index.build(0, "plain ascii", 4);
+    CHECK(ascii.simple && ascii.byte.empty());
+    CHECK(ascii.convert(5, ColumnUnit::Display, ColumnUnit::UTF16) == 5);
+    CHECK(ascii.convert(40, ColumnUnit::Byte, ColumnUnit::Display) == 11);
+
+    const ColumnIndex::Line& combining = index.build(1, "e\xCC\x81x", 4);
+    CHECK(combining.length(ColumnUnit::Display) == 2);
+    CHECK(combining.convert(1, ColumnUnit::Display, ColumnUnit::Byte) == 3);
+    CHECK(combining.convert(3, ColumnUnit::Byte, ColumnUnit::Display) == 1);
+
+    const ColumnIndex::Line& broken = index.build(2, "a\xFF\xE4\xB8", 4);
+    CHECK(broken.length(ColumnUnit::Codepoint) == 4);
+    CHECK(broken.convert(3, ColumnUnit::Codepoint, ColumnUnit::Byte) == 3);
+
+    CHECK(ColumnIndex::displayWidth('a') == 1 && ColumnIndex::displayWidth(0x301) == 0);
+    CHECK(ColumnIndex::displayWidth(0x4E2D) == 2 && ColumnIndex::displayWidth(0x1F600) == 2);
+
+    ColumnUnit unit = ColumnUnit::Byte;
+    CHECK(ColumnIndex::parseUnit("utf16", unit) && unit == ColumnUnit::UTF16);
+    CHECK(!ColumnIndex::parseUnit("chars", unit) && unit == ColumnUnit::UTF16);
+}
+
+// Buffer conversions follow edits: changing a line, or inserting lines above one, never leaves
+// a stale table behind
+// Buffer donusumleri duzenlemeleri izler: bir satiri degistirmek veya birinin ustune satir
+// eklemek asla bayat bir tablo birakmaz
+static void testBufferFollowsEdits() {
+    Buffer buffer;
+    buffer.loadLines({"\xE4\xB8\xAD\xE4\xB8\xAD", "ab"});
+    std::vector<TextPosition> positions = {{0, 6}, {1, 2}};
+    buffer.convertColumns(positions, ColumnUnit::Byte, ColumnUnit::Display, 4);
+    CHECK(positions[0].col == 4 && positions[1].col == 2);
+
+    buffer.insertText(0, 0, "\t");
+    positions = {{0, 7}};
+    buffer.convertColumns(positions, ColumnUnit::Byte, ColumnUnit::Display, 4);
+    CHECK(positions[0].col == 8);
+
+    buffer.insertText(0, 0, "x\n");
+    positions = {{1, 7}, {2, 2}, {0, 1}};
+    buffer.convertColumns(positions, ColumnUnit::Byte, ColumnUnit::UTF16, 4);
+    CHECK(positions[0].col == 3 && positions[1].col == 2 && positions[2].col == 1);
+}
+
+int main() {
+    testMixedLine();
+    testSpecialCases();
+    testBufferFollowsEdits();
+    return checkResult("ColumnIndexTest");
+}
@@ -0,0 +1,245 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "FileSaver.h"
+#include "MappedFile.h"
+#include "buffer.h"
+#include "file.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Write bytes to a file / Baytlari bir dosyaya yaz
+static void spit(const std::string& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+// Loading strips the BOM and CR, keeps an empty file as one empty line and drops the
+// line after a final newline, on the read path with a line longer than any chunk
+// Yukleme BOM'u ve CR'yi atar, bos dosyayi tek bos satir tutar ve son yeni satirdan sonraki
+// satiri atar; okuma yolunda herhangi bir parcadan uzun bir satirla
+static void testLoad(const TempDir& dir) {
+    Buffer buffer;
+    spit(dir.file("a.txt"), "\xEF\xBB\xBFone\r\ntwo\nthree");
+    CHECK(FileSystem::loadToBuffer(buffer, dir.file("a.txt")).success);
+    CHECK(buffer.lineCount() == 3 && buffer.getLine(0) == "one" && buffer.getLine(2) == "three");
+
+    spit(dir.file("b.txt"), "");
+    FileSystem::loadToBuffer(buffer, dir.file("b.txt"));
+    CHECK(buffer.lineCount() == 1 && buffer.getLine(0).empty());
+
+    spit(dir.file("c.txt"), "x\n");
+    FileSystem::loadToBuffer(buffer, dir.file("c.txt"));
+    CHECK(buffer.lineCount() == 1 && buffer.getLine(0) == "x");
+
+    const uintmax_t saved = FileSystem::mmapThreshold();
+    FileSystem::setMmapThreshold(0);
+    const std::string longLine(10 * 1024 * 1024, 'z');
+    spit(dir.file("d.txt"), "a\n" + longLine + "\r\nb");
+    FileSystem::loadToBuffer(buffer, dir.file("d.txt"));
+    CHECK(buffer.lineCount() == 3 && buffer.getLine(1) == longLine && buffer.getLine(2) == "b");
+    FileSystem::setMmapThreshold(saved);
+}
+
+// Saving under every fsync policy writes the text, keeps the target's permissions and writes
+// through a symlink instead of replacing it; a missing directory fails cleanly
+// Her fsync politikasiyla kaydetme metni yazar, hedefin izinlerini korur ve bir sembolik
+// baglantinin yerine gecmek yerine onun uzerinden yazar; eksik bir dizin temizce basarisiz olur
+static void testSaveSnapshot(const TempDir& dir, Buffer& buffer, const std::string& expected) {
+    const std::string target = dir.file("out.txt");
+    spit(target, "old");
+#ifndef _WIN32
+    chmod(target.c_str(), 0640);
+    const std::string link = dir.file("link.txt");
+    CHECK(symlink("out.txt", link.c_str()) == 0);
+#else
+    const std::string link = target;
+#endif
+
+    for (FsyncPolicy policy : {FsyncPolicy::None, FsyncPolicy::File, FsyncPolicy::Full}) {
+        FileSystem::setFsyncPolicy(policy);
+        CHECK(FileSystem::saveSnapshot(buffer.snapshot(), link).success);
+        CHECK(slurp(target) == expected);
+#ifndef _WIN32
+        struct stat st {};
+        lstat(link.c_str(), &st);
+        CHECK(S_ISLNK(st.st_mode));
+        stat(target.c_str(), &st);
+        CHECK((st.st_mode & 0777) == 0640);
+#endif
+    }
+    FileSystem::setFsyncPolicy(FsyncPolicy::File);
+    CHECK(!FileSystem::saveSnapshot(buffer.snapshot(), dir.file("missing/x.txt")).success);
+}
+
+#ifndef _WIN32
+// A chain of symlinks is followed to its end, a hard-linked file is rewritten in place so both
+// names see the text, and a read-only directory still lets a writable file be saved in place
+// Bir sembolik baglanti zinciri sonuna kadar izlenir, sert baglantili bir dosya iki ad da metni
+// gorsun diye yerinde yeniden yazilir, salt okunur bir dizin yazilabilir bir dosyanin yerinde kaydina izin verir
+static void testSaveLinks(const TempDir& dir, Buffer& buffer, const std::string& expected) {
+    const std::string target = dir.file("chain-target.txt");
+    spit(target, "old");
+    std::filesystem::create_directories(dir.path / "sub");
+    CHECK(symlink("../chain-target.txt", dir.file("sub/first.txt").c_str()) == 0);
+    CHECK(symlink("sub/first.txt", dir.file("second.txt").c_str()) == 0);
+    CHECK(FileSystem::saveSnapshot(buffer.snapshot(), dir.file("second.txt")).success);
+    CHECK(slurp(target) == expected);
+    CHECK(std::filesystem::is_symlink(dir.file("second.txt")));
+    CHECK(std::filesystem::is_symlink(dir.file("sub/first.txt")));
+
+    const std::string original = dir.file("hard-a.txt"), other = dir.file("hard-b.txt");
+    spit(original, "old");
+    CHECK(link(original.c_str(), other.c_str()) == 0);
+    CHECK(FileSystem::saveSnapshot(buffer.snapshot(), original).success);
+    CHECK(slurp(other) == expected);
+    struct stat st {};
+    stat(original.c_str(), &st);
+    CHECK(st.st_nlink == 2);
+
+    // A hard-linked file the buffer is mapped from is copied into memory before the rewrite,
+    // so the text written (and the buffer read afterwards) is the edited one, not NULs
+    // Buffer'in eslendigi sert baglantili bir dosya yeniden yazimdan once bellege kopyalanir,
+    // boylece yazilan metin (ve sonra okunan buffer) NUL degil duzenlenmis metindir
+    const std::string mappedPath = dir.file("hard-mapped.txt"), mappedLink = dir.file("hard-mapped-b.txt");
+    std::string text;
+    for (int i = 0; i < 20000; ++i) text += "mapped line " + std::to_string(i) + "\n";
+    spit(mappedPath, text);
+    CHECK(link(mappedPath.c_str(), mappedLink.c_str()) == 0);
+    const uintmax_t saved = FileSystem::mmapThreshold();
+    FileSystem::setMmapThreshold(1);
+    Buffer mapped;
+    CHECK(FileSystem::loadToBuffer(mapped, mappedPath).success);
+    FileSystem::setMmapThreshold(saved);
+    mapped.insertText(0, 0, "edited ");
+    CHECK(FileSystem::saveFromBuffer(mapped, mappedPath).success);
+    CHECK(slurp(mappedLink) == "edited " + text);
+    CHECK(!mapped.originalLost());
+    CHECK(mapped.getLine(19999) == "mapped line 19999");
+    mapped.insertText(19999, 0, "x");
+    CHECK(FileSystem::saveFromBuffer(mapped, mappedLink).success);
+    CHECK(slurp(mappedPath) == "edited " + text.substr(0, text.size() - 18) + "xmapped line 19999\n");
+
+    // Permission bits do not bind root, so only check the read-only directory otherwise
+    // Izin bitleri root'u baglamaz, bu yuzden salt okunur dizini yalnizca aksi halde dene
+    if (geteuid() != 0) {
+        const std::filesystem::path locked = dir.path / "locked";
+        std::filesystem::create_directories(locked);
+        const std::string inside = (locked / "file.txt").string();
+        spit(inside, "old");
+        chmod(locked.c_str(), 0555);
+        CHECK(FileSystem::saveSnapshot(buffer.snapshot(), inside).success);
+        CHECK(slurp(inside) == expected);
+        chmod(locked.c_str(), 0755);
+    }
+}
+#endif
+
+// Background saves finish in order, report each result and leave no temp files behind
+// Arka plan kaydetmeleri sirayla biter, her sonucu bildirir ve geride gecici dosya birakmaz
+static void testFileSaver(const TempDir& dir, Buffer& buffer) {
+    const std::string target = dir.file("saver.txt");
+    int calls = 0, failures = 0;
+    {
+        FileSaver saver;
+        for (int i = 0; i < 20; ++i) {
+            buffer.insertText(0, 0, "x");
+            saver.save(buffer.snapshot(), target, {}, [&](const FileResult& result, const BufferSnapshot&) {
+                ++calls;
+                if (!result.success) ++failures;
+            });
+        }
+        saver.flush();
+        CHECK(saver.pending() == 0);
+        saver.save(buffer.snapshot(), dir.file("second.txt"), {});
+    }
+    CHECK(calls == 20);
+    CHECK(failures == 0);
+    CHECK(slurp(target).substr(0, 24) == std::string(20, 'x') + "line");
+    CHECK(!slurp(dir.file("second.txt")).empty());
+
+    int leftovers = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir.path))
+        if (entry.path().filename().string().find("berkide-save") != std::string::npos) ++leftovers;
+    CHECK(leftovers == 0);
+}
+
+#ifndef _WIN32
+// A mapped file truncated on disk is detected, its lost lines read as NULs instead of
+// crashing, and neither the buffer nor an older snapshot of it can be saved any more
+// Diskte kesilen eslenmis bir dosya tespit edilir, kaybolan satirlari cokme yerine NUL okunur
+// ve ne buffer ne de onun eski bir anlik goruntusu artik kaydedilebilir
+static void testTruncatedMapping(const TempDir& dir) {
+    const std::string path = dir.file("mapped.txt");
+    std::string text;
+    for (int i = 0; i < 20000; ++i) text += "mapped line " + std::to_string(i) + "\n";
+    spit(path, text);
+
+    const uintmax_t saved = FileSystem::mmapThreshold();
+    FileSystem::setMmapThreshold(1);
+    Buffer buffer;
+    CHECK(FileSystem::loadToBuffer(buffer, path).success);
+    FileSystem::setMmapThreshold(saved);
+    const BufferSnapshot before = buffer.snapshot();
+    CHECK(!buffer.originalLost());
+    CHECK(FileSystem::saveSnapshot(before, dir.file("copy.txt")).success);
+
+    CHECK(truncate(path.c_str(), 4096) == 0);
+    CHECK(buffer.originalLost());
+    CHECK(before.originalLost());
+    CHECK(buffer.getLine(19999).find_first_not_of('\0') == std::string::npos);
+    CHECK(buffer.getLine(0) == "mapped line 0");
+
+    CHECK(!FileSystem::saveFromBuffer(buffer, path).success);
+    CHECK(!FileSystem::saveSnapshot(before, dir.file("copy.txt")).success);
+    CHECK(std::filesystem::file_size(path) == 4096);
+    CHECK(slurp(dir.file("copy.txt")) == text);
+
+    // A read that races the truncation is caught by the SIGBUS guard the host opted in to,
+    // which marks it lost too
+    // Kesilmeyle yarisan bir okumayi ana uygulamanin katildigi SIGBUS korumasi yakalar ve onu
+    // da kayip isaretler
+    MappedFile::installSigbusGuard();
+    spit(path, text);
+    MappedFile mapped;
+    CHECK(mapped.open(path));
+    CHECK(truncate(path.c_str(), 0) == 0);
+    CHECK(!mapped.isLost());
+    CHECK(mapped.line(19999).find_first_not_of('\0') == std::string::npos);
+    CHECK(mapped.isLost());
+}
+#endif
+
+int main() {
+    TempDir dir("filesave");
+    testLoad(dir);
+#ifndef _WIN32
+    testTruncatedMapping(dir);
+#endif
+
+    std::vector<std::string> lines;
+    std::string expected;
+    for (int i = 0; i < 5000; ++i) {
+        lines.push_back("line " + std::to_string(i));
+        expected += lines.back() + "\n";
+    }
+    Buffer buffer;
+    buffer.loadLines(std::move(lines));
+    testSaveSnapshot(dir, buffer, expected);
+#ifndef _WIN32
+    testSaveLinks(dir, buffer, expected);
+#endif
+    testFileSaver(dir, buffer);
+    return checkResult("FileSaveTest");
+}
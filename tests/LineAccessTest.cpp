@@ -0,0 +1,71 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "buffer.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+// Views, both iterator directions and chunk runs all read the same lines as getLine,
+// on a buffer split into many pieces by random edits.
+// Gorunumler, iki yineleyici yonu ve parca dizileri, rastgele duzenlemelerle bircok parcaya
+// bolunmus bir buffer uzerinde getLine ile ayni satirlari okur.
+static void testViewsMatchCopies() {
+    std::vector<std::string> initial;
+    for (int i = 0; i < 3000; ++i) initial.push_back("line " + std::to_string(i));
+    Buffer buffer;
+    buffer.loadLines(std::move(initial));
+
+    std::mt19937 rng(7);
+    for (int k = 0; k < 2000; ++k) {
+        int line = static_cast<int>(rng() % buffer.lineCount());
+        switch (rng() % 3) {
+            case 0: buffer.insertLineAt(line, "new " + std::to_string(k)); break;
+            case 1: if (buffer.lineCount() > 1) buffer.deleteLine(line); break;
+            case 2: buffer.insertText(line, 0, "e"); break;
+        }
+    }
+
+    const BufferSnapshot snapshot = buffer.snapshot();
+    std::vector<std::string> expected;
+    for (int i = 0; i < buffer.lineCount(); ++i) expected.push_back(buffer.getLine(i));
+
+    bool views = true;
+    for (int i = 0; i < snapshot.lineCount(); ++i) views = views && snapshot.lineView(i) == expected[i];
+    CHECK(views);
+
+    std::vector<std::string> forward;
+    for (std::string_view line : snapshot) forward.emplace_back(line);
+    CHECK(forward == expected);
+
+    std::vector<std::string> backward;
+    for (auto it = snapshot.end(); it != snapshot.begin();) backward.emplace_back(*--it);
+    CHECK(std::vector<std::string>(backward.rbegin(), backward.rend()) == expected);
+
+    // A middle range in runs, then an early stop after the first run
+    // Ortadaki bir aralik diziler halinde, sonra ilk diziden sonra erken durma
+    const int first = 100, count = static_cast<int>(expected.size()) - 200;
+    std::vector<std::string> chunked;
+    int nextLine = first;
+    snapshot.forEachChunk(first, count, [&](int firstLine, const std::string_view* lines, int n) {
+        CHECK(firstLine == nextLine);
+        for (int i = 0; i < n; ++i) chunked.emplace_back(lines[i]);
+        nextLine += n;
+        return true;
+    });
+    CHECK(chunked == std::vector<std::string>(expected.begin() + first, expected.begin() + first + count));
+
+    int runs = 0;
+    snapshot.forEachChunk(0, snapshot.lineCount(), [&](int, const std::string_view*, int) { return ++runs < 1; });
+    CHECK(runs == 1);
+}
+
+int main() {
+    testViewsMatchCopies();
+    return checkResult("LineAccessTest");
+}
@@ -0,0 +1,71 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "LineScanner.h"
+#include "buffer.h"
+#include "file.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Newline search at every length and position, so each SIMD block tail is crossed
+// Her uzunluk ve konumda yeni satir arama, boylece her SIMD blok kuyrugu asilir
+static void testFindNewline() {
+    for (int len = 0; len < 200; ++len) {
+        for (int pos = -1; pos < len; ++pos) {
+            std::string s(len, 'a');
+            if (pos >= 0) s[pos] = '\n';
+            size_t found = LineScanner::findNewline(s.data(), s.size());
+            CHECK(found == (pos < 0 ? static_cast<size_t>(len) : static_cast<size_t>(pos)));
+        }
+    }
+}
+
+// Split strips CR before LF and returns where the unterminated tail begins
+// Bolme LF oncesindeki CR'yi atar ve sonlandirilmamis kuyrugun nerede basladigini dondurur
+static void testSplitLines() {
+    std::vector<std::string> out;
+    std::string text = "a\r\nbb\n\nccc";
+    size_t tail = LineScanner::splitLines(text.data(), text.size(), out);
+    CHECK(out.size() == 3);
+    CHECK(out.size() == 3 && out[0] == "a" && out[1] == "bb" && out[2].empty());
+    CHECK(tail == 7);
+}
+
+// Both loader paths (read and mapped) produce the same lines as the scanner
+// Her iki yukleyici yolu (okuma ve eslenmis) tarayiciyla ayni satirlari uretir
+static void testLoadMatchesScanner() {
+    TempDir dir("linescanner");
+    std::string text;
+    for (int i = 0; i < 5000; ++i) text += "line " + std::to_string(i) + (i % 7 ? "\n" : "\r\n");
+    text += "tail";
+    std::string path = dir.file("lines.txt");
+    std::ofstream(path, std::ios::binary) << text;
+
+    std::vector<std::string> expected;
+    size_t tail = LineScanner::splitLines(text.data(), text.size(), expected);
+    expected.push_back(text.substr(tail));
+
+    const uintmax_t saved = FileSystem::mmapThreshold();
+    for (uintmax_t threshold : {uintmax_t{0}, uintmax_t{1}}) {
+        FileSystem::setMmapThreshold(threshold);
+        Buffer buffer;
+        CHECK(FileSystem::loadToBuffer(buffer, path).success);
+        CHECK(buffer.lineCount() == static_cast<int>(expected.size()));
+        bool same = buffer.lineCount() == static_cast<int>(expected.size());
+        for (int i = 0; same && i < buffer.lineCount(); ++i) same = buffer.getLine(i) == expected[i];
+        CHECK(same);
+    }
+    FileSystem::setMmapThreshold(saved);
+}
+
+int main() {
+    testFindNewline();
+    testSplitLines();
+    testLoadMatchesScanner();
+    return checkResult("LineScannerTest");
+}
@@ -0,0 +1,97 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "LiteralMatcher.h"
+
+#include <random>
+#include <string>
+
+// Reference: byte-by-byte comparison with ASCII folding and the word rule of the old search
+// path (a match edge is a boundary when word-ness differs on its two sides)
+// Referans: ASCII katlamali bayt bayt karsilastirma ve eski arama yolunun sozcuk kurali (esleme
+// kenari, iki yanindaki sozcukluk farkliysa bir sinirdir)
+static bool isWordByte(char c) {
+    const unsigned char u = static_cast<unsigned char>(c);
+    return (u >= '0' && u <= '9') || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || u == '_';
+}
+
+static char fold(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; }
+
+static size_t naiveFind(const std::string& text, const std::string& needle, size_t from, bool caseSensitive, bool wholeWord) {
+    if (needle.empty() || needle.size() > text.size()) return LiteralMatcher::npos;
+    auto boundary = [&](size_t pos) {
+        return pos == 0 || pos == text.size() || isWordByte(text[pos - 1]) != isWordByte(text[pos]);
+    };
+    for (size_t pos = from; pos + needle.size() <= text.size(); ++pos) {
+        bool same = true;
+        for (size_t i = 0; i < needle.size() && same; ++i)
+            same = caseSensitive ? text[pos + i] == needle[i] : fold(text[pos + i]) == fold(needle[i]);
+        if (same && (!wholeWord || (boundary(pos) && boundary(pos + needle.size())))) return pos;
+    }
+    return LiteralMatcher::npos;
+}
+
+// Random short texts and needles over a small alphabet (letters of both cases, '@' and '`'
+// which differ from letters only in bit 0x20, a UTF-8 pair and word separators) agree with
+// the reference for every option and start offset
+// Kucuk bir alfabeden rastgele kisa metinler ve igneler (iki harf buyuklugunde harfler, harflerden
+// yalnizca 0x20 bitinde ayrilan '@' ve '`', bir UTF-8 cifti ve sozcuk ayiricilari) her secenek ve
+// baslangic ofseti icin referansla uyusur
+static void testRandomAgainstReference() {
+    static const char alphabet[] = "aAbBzZ_ .9@`\xc3\xa9";
+    std::mt19937 rng(3);
+    int fails = 0;
+    for (int round = 0; round < 200000; ++round) {
+        std::string text, needle;
+        const int length = static_cast<int>(rng() % 80), needleLength = 1 + static_cast<int>(rng() % 4);
+        for (int i = 0; i < length; ++i) text += alphabet[rng() % (sizeof(alphabet) - 1)];
+        for (int i = 0; i < needleLength; ++i) needle += alphabet[rng() % (sizeof(alphabet) - 1)];
+        const bool caseSensitive = rng() % 2, wholeWord = rng() % 2;
+        const size_t from = rng() % (text.size() + 1);
+        LiteralMatcher matcher(needle, caseSensitive, wholeWord);
+        if (matcher.find(text, from) != naiveFind(text, needle, from, caseSensitive, wholeWord)) ++fails;
+    }
+    CHECK(fails == 0);
+}
+
+// A needle at every offset of a long line (so it sits at each position inside a 16/32 byte
+// block and straddles block edges) is found exactly there, including at the very end
+// Uzun bir satirin her ofsetindeki bir igne (boylece 16/32 baytlik bir blok icindeki her konumda
+// durur ve blok kenarlarini asar) tam orada bulunur, en sondakiler dahil
+static void testEveryOffset() {
+    const LiteralMatcher exact("Needle", true, false), caseless("nEEDLE", false, false), word("needle", false, true);
+    for (size_t at = 0; at + 6 <= 200; ++at) {
+        std::string text(200, 'x');
+        text.replace(at, 6, "Needle");
+        CHECK(exact.find(text) == at);
+        CHECK(caseless.find(text) == at);
+        CHECK(exact.find(text, at + 1) == LiteralMatcher::npos);
+        CHECK(word.find(text) == LiteralMatcher::npos);
+        if (at > 0) text[at - 1] = ' ';
+        if (at + 6 < text.size()) text[at + 6] = ' ';
+        CHECK(word.find(text) == at);
+    }
+}
+
+// Edge cases: empty needle or text, needle longer than text, a start offset past the end
+// Sinir durumlari: bos igne veya metin, metinden uzun igne, sonu gecen bir baslangic ofseti
+static void testEdges() {
+    CHECK(LiteralMatcher("", true, false).find("abc") == LiteralMatcher::npos);
+    CHECK(LiteralMatcher("a", true, false).find("") == LiteralMatcher::npos);
+    CHECK(LiteralMatcher("abcd", true, false).find("abc") == LiteralMatcher::npos);
+    CHECK(LiteralMatcher("c", true, false).find("abc", 3) == LiteralMatcher::npos);
+    CHECK(LiteralMatcher("c", true, false).find("abc", 10) == LiteralMatcher::npos);
+    CHECK(LiteralMatcher("@", false, false).find("`@") == 1);
+    CHECK(LiteralMatcher("é", false, false).find("É é") == 3);
+}
+
+int main() {
+    std::printf("kernel: %s\n", LiteralMatcher::kernelName());
+    testRandomAgainstReference();
+    testEveryOffset();
+    testEdges();
+    return checkResult("LiteralMatcherTest");
+}
@@ -0,0 +1,139 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "LinearRegexEngine.h"
+#include "SearchEngine.h"
+#include "buffer.h"
+#include "undo.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// Reference: every match of pattern in the whole joined text, located by line starts, and the
+// match starting last (which may overlap the one before it)
+// Referans: kalibin birlestirilmis tum metindeki her eslemesi, satir baslangiclariyla konumlanir,
+// ve en son baslayan esleme (oncekiyle cakisabilir)
+static std::vector<SearchMatch> reference(const std::vector<std::string>& lines, const std::string& pattern,
+                                          SearchMatch& lastStart) {
+    std::string text;
+    std::vector<int> starts;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        starts.push_back(static_cast<int>(text.size()));
+        text += lines[i];
+        if (i + 1 < lines.size()) text += '\n';
+    }
+    auto locate = [&](int offset, int& line, int& col) {
+        line = static_cast<int>(std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin()) - 1;
+        col = offset - starts[line];
+    };
+
+    LinearRegexEngine re;
+    re.compile(pattern, true);
+    std::vector<SearchMatch> out;
+    int offset = 0, pos, len;
+    while (offset <= static_cast<int>(text.size()) && re.find(text, offset, pos, len)) {
+        SearchMatch m;
+        m.length = len;
+        locate(pos, m.line, m.col);
+        locate(pos + len, m.endLine, m.endCol);
+        out.push_back(m);
+        offset = pos + std::max(1, len);
+    }
+    for (offset = static_cast<int>(text.size()); offset >= 0; --offset) {
+        if (!re.find(text, offset, pos, len)) continue;
+        lastStart.length = len;
+        locate(pos, lastStart.line, lastStart.col);
+        locate(pos + len, lastStart.endLine, lastStart.endCol);
+        break;
+    }
+    return out;
+}
+
+// With a window of a few lines, matches of up to that many lines are all found in order,
+// including those straddling window edges, and findForward/findBackward agree with them
+// Birkac satirlik bir pencereyle, o kadar satira kadar uzanan eslemelerin hepsi sirayla bulunur,
+// pencere kenarlarini asanlar dahil, ve findForward/findBackward onlarla uyusur
+static void testAgainstWholeText() {
+    SearchEngine::setMultilineMaxLines(3);
+    std::mt19937 rng(5);
+    std::vector<std::string> lines;
+    for (int i = 0; i < 500; ++i) {
+        std::string line;
+        int len = static_cast<int>(rng() % 7);
+        for (int k = 0; k < len; ++k) line += "abc "[rng() % 4];
+        lines.push_back(line);
+    }
+    Buffer buffer;
+    buffer.loadLines(std::vector<std::string>(lines));
+    const BufferSnapshot snapshot = buffer.snapshot();
+
+    SearchEngine engine;
+    SearchOptions opts;
+    opts.regex = true;
+    opts.multiline = true;
+    for (const std::string pattern : {"a\nb", "b\n[^\n]*a", "c ?\n\n", " \n\n", "a\n[abc]*\nc"}) {
+        SearchMatch lastStart{};
+        const std::vector<SearchMatch> expected = reference(lines, pattern, lastStart);
+        CHECK(!expected.empty());
+        CHECK(sameMatches(engine.findAll(snapshot, pattern, opts), expected));
+        CHECK(engine.countMatches(snapshot, pattern, opts) == static_cast<int>(expected.size()));
+
+        for (int k = 0; k < 20; ++k) {
+            const SearchMatch& target = expected[rng() % expected.size()];
+            SearchMatch found{};
+            CHECK(engine.findForward(snapshot, pattern, target.line, target.col, found, opts));
+            CHECK(sameMatches({found}, {target}));
+        }
+        SearchMatch last{};
+        const int end = static_cast<int>(lines.size()) - 1;
+        CHECK(engine.findBackward(snapshot, pattern, end, static_cast<int>(lines[end].size()), last, opts));
+        CHECK(sameMatches({last}, {lastStart}));
+
+        SearchMatch wrapped{};
+        CHECK(engine.findForward(snapshot, pattern, expected.back().endLine, expected.back().endCol, wrapped, opts));
+        CHECK(sameMatches({wrapped}, {expected.front()}));
+    }
+    SearchEngine::setMultilineMaxLines(64);
+}
+
+// A match that spans lines is found in multi-line mode only and replaceAll joins the lines it
+// covers, in one undoable batch
+// Satirlara yayilan bir esleme yalnizca cok satirli modda bulunur ve replaceAll kapsadigi
+// satirlari tek bir geri alinabilir grupta birlestirir
+static void testReplaceAcrossLines() {
+    Buffer buffer;
+    buffer.loadLines({"call(", "    first,", "    second)", "other(", "    third)"});
+    SearchEngine engine;
+    SearchOptions opts;
+    opts.regex = true;
+    CHECK(engine.findAll(buffer, ",\n\\s*", opts).empty());
+
+    opts.multiline = true;
+    const std::vector<SearchMatch> matches = engine.findAll(buffer, "\\(\n\\s*", opts);
+    CHECK(matches.size() == 2);
+    CHECK(matches[0].line == 0 && matches[0].col == 4 && matches[0].endLine == 1 && matches[0].endCol == 4);
+    CHECK(matches[0].length == 6);
+
+    CHECK(engine.previewReplaceAll(buffer.snapshot(), "\\(\n\\s*|,\n\\s*", "$&", opts).size() == 2);
+    UndoManager undo;
+    std::vector<AppliedEdit> applied;
+    CHECK(engine.replaceAll(buffer, "(\\(|,)\n\\s*", "$1", opts, &applied) == 3);
+    CHECK(buffer.lineCount() == 2);
+    CHECK(buffer.getLine(0) == "call(first,second)" && buffer.getLine(1) == "other(third)");
+
+    undo.addEdits(applied);
+    CHECK(undo.undo(buffer));
+    CHECK(buffer.lineCount() == 5 && buffer.getLine(1) == "    first,");
+}
+
+int main() {
+    testAgainstWholeText();
+    testReplaceAcrossLines();
+    return checkResult("MultilineSearchTest");
+}
@@ -0,0 +1,131 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "MappedFile.h"
+#include "PieceTable.h"
+#include "buffer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compare offsetOf/positionOf on the buffer and a snapshot with line starts computed from
+// the joined text, at random positions and offsets
+// Tampon ve bir snapshot uzerindeki offsetOf/positionOf'u, birlestirilmis metinden hesaplanan
+// satir baslangiclariyla rastgele konum ve ofsetlerde karsilastir
+static void checkOffsets(const Buffer& buffer, std::mt19937& rng) {
+    const BufferSnapshot snapshot = buffer.snapshot();
+    std::string text;
+    for (int i = 0; i < snapshot.lineCount(); ++i) {
+        if (i) text += '\n';
+        text += snapshot.lineView(i);
+    }
+    CHECK(snapshot.byteCount() == text.size());
+    CHECK(buffer.byteCount() == text.size());
+
+    std::vector<uint64_t> starts{0};
+    for (size_t i = 0; i < text.size(); ++i)
+        if (text[i] == '\n') starts.push_back(i + 1);
+    CHECK(static_cast<int>(starts.size()) == snapshot.lineCount());
+    if (static_cast<int>(starts.size()) != snapshot.lineCount()) return;
+
+    for (int q = 0; q < 50; ++q) {
+        int line = static_cast<int>(rng() % snapshot.lineCount());
+        int len = static_cast<int>(snapshot.lineView(line).size());
+        int col = len ? static_cast<int>(rng() % (len + 1)) : 0;
+        CHECK(snapshot.offsetOf(line, col) == starts[line] + col);
+        CHECK(buffer.offsetOf(line, col) == starts[line] + col);
+
+        uint64_t offset = rng() % (text.size() + 1);
+        TextPosition pos = snapshot.positionOf(offset);
+        auto start = std::upper_bound(starts.begin(), starts.end(), offset) - 1;
+        CHECK(pos.line == start - starts.begin());
+        CHECK(static_cast<uint64_t>(pos.col) == offset - *start);
+    }
+}
+
+// The index follows every kind of edit, including compaction and edits under a live snapshot
+// Indeks, sikistirma ve canli bir snapshot altindaki duzenlemeler dahil her tur duzenlemeyi izler
+static void testEdits() {
+    std::mt19937 rng(7);
+    PieceTable::setGcPolicy(20, 16, 0);
+    std::vector<std::string> initial;
+    for (int i = 0; i < 500; ++i) initial.push_back(std::string(rng() % 40, static_cast<char>('a' + i % 26)));
+    Buffer buffer;
+    buffer.loadLines(std::move(initial));
+    checkOffsets(buffer, rng);
+
+    for (int k = 0; k < 20000; ++k) {
+        int count = buffer.lineCount();
+        int line = static_cast<int>(rng() % count);
+        int len = buffer.columnCount(line);
+        switch (rng() % 8) {
+            case 0: buffer.insertLineAt(line, std::string(rng() % 30, 'x')); break;
+            case 1: if (count > 1) buffer.deleteLine(line); break;
+            case 2: buffer.setLine(line, std::string(rng() % 50, 's')); break;
+            case 3: buffer.insertChar(line, len ? static_cast<int>(rng() % len) : 0, 'c'); break;
+            case 4: if (len) buffer.deleteChar(line, static_cast<int>(rng() % len)); break;
+            case 5: buffer.splitLine(line, len ? static_cast<int>(rng() % len) : 0); break;
+            case 6: if (line + 1 < count) buffer.joinLines(line, line + 1); break;
+            case 7: buffer.insertText(line, 0, "ab\ncd\nef"); break;
+        }
+        if (k % 500 == 0) {
+            checkOffsets(buffer, rng);
+            if (k % 1500 == 0) {
+                BufferSnapshot keep = buffer.snapshot();
+                buffer.insertChar(0, 0, 'z');
+                checkOffsets(buffer, rng);
+            }
+        }
+    }
+    checkOffsets(buffer, rng);
+}
+
+// Mapped files with a BOM and mixed line endings, fully and progressively indexed
+// BOM ve karisik satir sonlari olan eslenmis dosyalar, tamamen ve asamali indekslenmis
+static void testMapped() {
+    TempDir dir("offsets");
+    const std::string path = dir.file("crlf.txt");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "\xEF\xBB\xBF";
+        for (int i = 0; i < 200000; ++i) out << "line" << i << ((i % 3) ? "\r\n" : "\n");
+        out << "last\r";
+    }
+    std::mt19937 rng(11);
+
+    auto mapped = std::make_shared<MappedFile>();
+    CHECK(mapped->open(path));
+    Buffer buffer;
+    buffer.loadMapped(mapped);
+    checkOffsets(buffer, rng);
+    for (int k = 0; k < 2000; ++k) {
+        buffer.insertChar(static_cast<int>(rng() % buffer.lineCount()), 0, 'q');
+        if (k % 3 == 0) buffer.deleteLine(static_cast<int>(rng() % buffer.lineCount()));
+    }
+    checkOffsets(buffer, rng);
+
+    auto progressive = std::make_shared<MappedFile>();
+    CHECK(progressive->open(path, false));
+    progressive->indexLines(1000);
+    Buffer partial;
+    partial.loadMapped(progressive);
+    checkOffsets(partial, rng);
+    progressive->indexLines(50000);
+    checkOffsets(partial, rng);
+    progressive->waitIndexed();
+    checkOffsets(partial, rng);
+}
+
+int main() {
+    testEdits();
+    testMapped();
+    return checkResult("OffsetIndexTest");
+}
@@ -0,0 +1,93 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "SearchEngine.h"
+#include "ThreadPool.h"
+#include "buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// A log-like buffer large enough to split into many line-range tasks
+// Bircok satir araligi gorevine bolunecek kadar buyuk, log benzeri bir buffer
+static void fillLog(Buffer& buffer, int lines) {
+    std::string text;
+    for (int i = 0; i < lines; ++i)
+        text += "2024-01-01 12:00:" + std::to_string(i % 60) + " INFO request id=" + std::to_string(i) +
+                (i % 97 == 0 ? " ERROR timeout foo\n" : " ok\n");
+    buffer.insertText(0, 0, text);
+}
+
+// Results on a caller-only pool, a multi-worker pool and the shared pool agree and are in
+// order; counts match, and a limit returns the leading matches
+// Yalnizca cagiranli bir havuzda, cok calisanli bir havuzda ve paylasilan havuzdaki sonuclar
+// uyusur ve siralidir; sayimlar eslesir ve bir sinir bastaki eslemeleri dondurur
+static void testPoolsAgree(const BufferSnapshot& snapshot) {
+    SearchEngine engine;
+    ThreadPool single(0), several(3);
+    SearchOptions literal, regex, caseless;
+    regex.regex = true;
+    caseless.caseSensitive = false;
+    const std::pair<const char*, SearchOptions> searches[] = {
+        {"ERROR", literal}, {"id=\\d+7\\b", regex}, {"error", caseless}};
+
+    for (const auto& [pattern, opts] : searches) {
+        SearchScan onSingle, onSeveral;
+        onSingle.pool = &single;
+        onSeveral.pool = &several;
+        const auto reference = engine.findAll(snapshot, pattern, opts, onSingle);
+        const auto parallel = engine.findAll(snapshot, pattern, opts, onSeveral);
+        const auto shared = engine.findAll(snapshot, pattern, opts);
+        CHECK(!reference.empty());
+        CHECK(parallel.size() == reference.size() && sameMatches(parallel, reference, reference.size()));
+        CHECK(shared.size() == reference.size() && sameMatches(shared, reference, reference.size()));
+        CHECK(std::is_sorted(parallel.begin(), parallel.end(), [](const SearchMatch& a, const SearchMatch& b) {
+            return a.line < b.line || (a.line == b.line && a.col < b.col);
+        }));
+        CHECK(engine.countMatches(snapshot, pattern, opts, onSeveral) == static_cast<int>(reference.size()));
+
+        SearchScan limited = onSeveral;
+        limited.maxResults = 1000;
+        const auto first = engine.findAll(snapshot, pattern, opts, limited);
+        const size_t expected = std::min<size_t>(1000, reference.size());
+        CHECK(first.size() == expected && sameMatches(first, reference, expected));
+    }
+}
+
+// Cancelling from the progress callback returns an in-order prefix of the full result
+// Ilerleme geri cagrisindan iptal, tam sonucun sirali bir onekini dondurur
+static void testCancel(const BufferSnapshot& snapshot) {
+    SearchEngine engine;
+    ThreadPool pool(3);
+    SearchScan full;
+    full.pool = &pool;
+    const auto all = engine.findAll(snapshot, "id", {}, full);
+
+    std::atomic<bool> cancel{false};
+    std::atomic<int> calls{0};
+    SearchScan scan;
+    scan.pool = &pool;
+    scan.cancel = &cancel;
+    scan.onProgress = [&](int, int) {
+        if (++calls == 3) cancel = true;
+    };
+    const auto part = engine.findAll(snapshot, "id", {}, scan);
+    CHECK(calls >= 3);
+    CHECK(part.size() < all.size());
+    CHECK(sameMatches(part, all, part.size()));
+}
+
+int main() {
+    Buffer buffer;
+    fillLog(buffer, 300000);
+    const BufferSnapshot snapshot = buffer.snapshot();
+    testPoolsAgree(snapshot);
+    testCancel(snapshot);
+    return checkResult("ParallelSearchTest");
+}
@@ -0,0 +1,161 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "LinearRegexEngine.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+
+// Compare one pattern on one text with std::regex; search and find must also agree at every
+// offset. Returns the number of disagreements.
+// Bir kalibi bir metinde std::regex ile karsilastir; search ve find her ofsette de uyusmali.
+// Uyusmazlik sayisini dondurur.
+static int compareWithStd(const std::string& pattern, const std::string& text, bool caseSensitive) {
+    LinearRegexEngine linear;
+    StdRegexEngine reference;
+    const bool linearOk = linear.compile(pattern, caseSensitive);
+    const bool referenceOk = reference.compile(pattern, caseSensitive);
+    // Named groups are accepted here but not by std::regex
+    // Adli gruplar burada kabul edilir ama std::regex tarafindan edilmez
+    if (!linearOk || !referenceOk) return referenceOk && !linearOk ? 1 : 0;
+
+    int fails = 0;
+    for (int offset = 0; offset <= static_cast<int>(text.size()); ++offset) {
+        RegexMatch match;
+        int position = -1, length = -1;
+        bool searched = linear.search(text, offset, match);
+        bool found = linear.find(text, offset, position, length);
+        if (searched != found || (searched && (match.position != position || match.length != length))) ++fails;
+    }
+    // std::regex treats '\n' as an ordinary character for ^ and $
+    // std::regex ^ ve $ icin '\n'i siradan bir karakter sayar
+    if (text.find('\n') == std::string::npos && !sameMatches(linear.searchAll(text), reference.searchAll(text))) {
+        std::fprintf(stderr, "differs from std::regex: /%s/ on '%s' (case %s)\n", pattern.c_str(), text.c_str(),
+                     caseSensitive ? "sensitive" : "insensitive");
+        ++fails;
+    }
+    return fails;
+}
+
+// A fixed table of patterns and texts, then random patterns built from atoms over "ab"
+// Sabit bir kalip ve metin tablosu, sonra "ab" uzerinde atomlardan kurulan rastgele kaliplar
+static void testAgainstStdRegex() {
+    const char* patterns[] = {"a", "abc", "a|b", "(a|ab)(c|bcd)(d*)", "a*", "a+?", "(a+)(b+)?", "x*", "\\bfoo\\b",
+                              "^foo", "foo$", "[a-c]+", "[^a-c]+", "\\d{2,3}", "(\\w+)@(\\w+)\\.com", "a{2}", "a{2,}",
+                              "a{0,2}?b", "(?:ab)+", "(a|a)*b", "[\\d\\s]+", "\\Bo", "colou?r", "(?:x|)y", "a.c",
+                              "[-a]", "[a-]", "\\x41", "\\u0042+", "(a)|b", "((a)|b)+", "^$", "(?<n>ab)c", "\\.",
+                              "[\\]]", "a{,2}", "a{2"};
+    const char* texts[] = {"", "a", "abc", "abcd", "aaab", "foo foobar foo", "xaxbx", "12 345 6789",
+                           "bob@mail.com x@y.com", "colour color", "abababc", "aaaaaaaaaaaaaaaaaaaaaaaaab",
+                           "a-c a.c", "A B AB", "]]", "a{,2} a{2", "ab ab abc"};
+    int fails = 0;
+    for (const char* pattern : patterns)
+        for (const char* text : texts) fails += compareWithStd(pattern, text, true) + compareWithStd(pattern, text, false);
+
+    std::mt19937 rng(1);
+    const char* atoms[] = {"a", "b", "(a|b)", "(ab|a)", "a*", "b+?", "(a*)", "[ab]", "\\b", "^", "$", ".",
+                           "(?:a|ba)*", "a?", "(b)"};
+    for (int iter = 0; iter < 20000; ++iter) {
+        std::string pattern, text;
+        for (int k = 1 + static_cast<int>(rng() % 4); k > 0; --k) pattern += atoms[rng() % 15];
+        for (int k = static_cast<int>(rng() % 10); k > 0; --k)
+            text += rng() % 5 == 0 ? (rng() % 2 ? ' ' : '\n') : "ab"[rng() % 2];
+        fails += compareWithStd(pattern, text, rng() % 2);
+    }
+    CHECK(fails == 0);
+}
+
+// An empty last iteration does not reset a group (ECMAScript); libstdc++ clears it, so this
+// case is checked on its own
+// Bos son yineleme bir grubu sifirlamaz (ECMAScript); libstdc++ onu temizler, bu yuzden bu
+// durum ayrica denetlenir
+static void testEmptyIterationKeepsGroup() {
+    LinearRegexEngine re;
+    CHECK(re.compile("(a*)*b"));
+    RegexMatch match;
+    CHECK(re.search("aaab", 0, match));
+    CHECK(match.length == 4 && match.groups.size() == 2 && match.groups[1] == "aaa");
+}
+
+// Patterns that make backtracking engines exponential finish in linear time
+// Geri izleyen motorlari ustel yapan kaliplar dogrusal zamanda biter
+static void testPathological() {
+    LinearRegexEngine re;
+    RegexMatch match;
+    auto start = std::chrono::steady_clock::now();
+    CHECK(re.compile("(a|a)*b"));
+    CHECK(!re.search(std::string(100000, 'a'), 0, match));
+    CHECK(re.compile("(x+x+)+y"));
+    CHECK(!re.search(std::string(50000, 'x'), 0, match));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    CHECK(seconds < 2.0);
+}
+
+// '.' takes whole UTF-8 characters; case folding covers Latin, Greek (final sigma) and Cyrillic
+// '.' tum UTF-8 karakterlerini alir; harf katlama Latin, Yunan (son sigma) ve Kiril'i kapsar
+static void testUtf8() {
+    LinearRegexEngine re;
+    RegexMatch match;
+    int position = 0, length = 0;
+    CHECK(re.compile("."));
+    std::vector<RegexMatch> dots = re.searchAll("a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80");
+    CHECK(dots.size() == 4);
+    CHECK(dots.size() == 4 && dots[1].position == 1 && dots[2].length == 3 && dots[3].position == 6 && dots[3].length == 4);
+
+    CHECK(re.compile("\xC3\x89", false));
+    CHECK(re.search("x\xC3\xA9", 0, match) && match.position == 1);
+    CHECK(re.compile("[\xD0\xB0-\xD1\x8F]+", false));
+    CHECK(re.search("\xD0\x9F\xD0\xA0\xD0\x98\xD0\x92\xD0\x95\xD0\xA2", 0, match) && match.length == 12);
+
+    CHECK(re.compile("\xCF\x83", false));                                          // σ
+    CHECK(re.find("O\xCF\x82", 0, position, length) && position == 1);            // Oς
+    CHECK(re.find("\xCE\xA3", 0, position, length));                               // Σ
+    CHECK(re.compile("\xCE\xA3+", false));                                         // Σ+
+    CHECK(re.find("\xCF\x82\xCF\x83\xCE\xA3", 0, position, length) && length == 6);
+}
+
+// POSIX classes inside brackets, quantifier forms std::regex takes literally, and errors,
+// among them letter escapes of other dialects such as \p{L}
+// Koseli parantez icinde POSIX siniflari, std::regex'in literal aldigi niceleyici bicimleri ve
+// hatalar; aralarinda \p{L} gibi diger lehcelerin harf kacislari
+static void testSyntax() {
+    LinearRegexEngine re;
+    int position = 0, length = 0;
+    for (const char* good : {"a{2}", "a{,}", "{", "a{x}", "a+?", "[[:alpha:]]+", "[^[:digit:]]", "[a-[:digit:]]",
+                             "\\.\\t\\x41\\u0042\\cA", "[\\b\\-\\]]"})
+        CHECK(re.compile(good));
+    for (const char* bad : {"a{1000}{1000}", "a**", "a{2}*", "a*{2}", "a+?{3}", "{2}", "x|{3}", "[[:bogus:]]",
+                            "[[:alpha:]", "(a{1000}){1000}", "a\\1", "(?=a)", "(ab", "[ab", "a{3,2}", "*a",
+                            "\\p{L}", "\\P{Lu}", "\\A", "\\z", "\\h", "\\R", "[\\p]", "\\b\\q"}) {
+        CHECK(!re.compile(bad));
+        CHECK(!re.lastError().empty());
+    }
+    CHECK(!re.compile("\\p{L}") && re.lastError().find("unsupported escape \\p") != std::string::npos);
+    CHECK(re.compile("[[:alpha:]]+") && re.find("12abC3", 0, position, length) && position == 2 && length == 3);
+    CHECK(re.compile("[[:xdigit:][:space:]]+") && re.find("zz1f a9q", 0, position, length) && position == 2 && length == 5);
+    CHECK(re.compile("[a-[:digit:]]+") && re.find("xx-a5-", 0, position, length) && position == 2 && length == 4);
+}
+
+// Replacement templates and the default engine
+// Degistirme sablonlari ve varsayilan motor
+static void testReplaceAndDefault() {
+    LinearRegexEngine re;
+    CHECK(re.compile("(\\w+) (\\w+)"));
+    CHECK(re.replaceAll("john smith", "$2, $1 [$&] $$") == "smith, john [john smith] $");
+    CHECK(dynamic_cast<LinearRegexEngine*>(RegexEngine::create().get()) != nullptr);
+}
+
+int main() {
+    testAgainstStdRegex();
+    testEmptyIterationKeepsGroup();
+    testPathological();
+    testUtf8();
+    testSyntax();
+    testReplaceAndDefault();
+    return checkResult("RegexTest");
+}
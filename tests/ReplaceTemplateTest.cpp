@@ -0,0 +1,120 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "LinearRegexEngine.h"
+#include "ReplaceTemplate.h"
+#include "SearchEngine.h"
+#include "buffer.h"
+#include "undo.h"
+
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Expand a template once for the first match of pattern in text
+// Bir sablonu kalibin metindeki ilk eslemesi icin bir kez genislet
+static std::string expandFirst(const std::string& pattern, const std::string& text, const std::string& replacement) {
+    LinearRegexEngine re;
+    RegexMatch match;
+    if (!re.compile(pattern) || !re.search(text, 0, match)) return "<no match>";
+    std::string out;
+    ReplaceTemplate(replacement).expand(text, match, out);
+    return out;
+}
+
+// Random templates of $&, existing $n, $$ and literals agree with std::regex_replace on every
+// match of random texts, for patterns with optional and unmatched groups
+// $&, var olan $n, $$ ve literallerden rastgele sablonlar, istege bagli ve eslesmemis gruplari
+// olan kaliplar icin rastgele metinlerin her eslemesinde std::regex_replace ile uyusur
+static void testAgainstStdRegex() {
+    std::mt19937 rng(3);
+    const char* pieces[] = {"$&", "$1", "$$", "-", "x", "$", "$2"};
+    for (const std::string pattern : {"(a)(b)?", "(a|b)+", "a(x)?b", "(b*)(a)"}) {
+        const unsigned kinds = pattern == "(a)(b)?" || pattern == "(b*)(a)" ? 7 : 6;
+        LinearRegexEngine re;
+        CHECK(re.compile(pattern));
+        const std::regex std(pattern);
+        for (int iter = 0; iter < 200; ++iter) {
+            std::string text, replacement;
+            for (int k = static_cast<int>(rng() % 12); k > 0; --k) text += "abx"[rng() % 3];
+            for (int k = 1 + static_cast<int>(rng() % 4); k > 0; --k) replacement += pieces[rng() % kinds];
+            std::string expected = std::regex_replace(text, std, replacement);
+            CHECK(re.replaceAll(text, replacement) == expected);
+        }
+    }
+}
+
+// The references std::regex formats differently or not at all: $` and $' see the whole text,
+// two digits fall back to one group and a literal, missing groups stay as typed, and the case
+// modifiers apply to ASCII letters only
+// std::regex'in farkli bicimlendirdigi veya hic bicimlendirmedigi referanslar: $` ve $' tum
+// metni gorur, iki basamak bir gruba ve bir literale geri duser, olmayan gruplar yazildigi
+// gibi kalir ve harf degistiricileri yalnizca ASCII harflere uygulanir
+static void testTokens() {
+    CHECK(expandFirst("b+", "aabbcc", "[$`|$'|$&]") == "[aa|cc|bb]");
+    CHECK(expandFirst("(a)(b)", "ab", "$12 $3 $02 $") == "a2 $3 b $");
+    CHECK(expandFirst("(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)(l)", "abcdefghijkl", "$12$10$1") == "lja");
+    CHECK(expandFirst("(\\w+) (\\w+)", "hello world", "\\U$1\\E $2") == "HELLO world");
+    CHECK(expandFirst("(\\w+) (\\w+)", "HELLO WORLD", "\\L$1 \\u$2") == "hello World");
+    CHECK(expandFirst("(\\w+)", "abc", "\\u\\L$1$1") == "Abcabc");
+    CHECK(expandFirst("(\\S+)", "\xC3\xA9t\xC3\xA9", "\\U$1") == "\xC3\xA9T\xC3\xA9");
+    CHECK(expandFirst("x", "x", "a\\nb\\") == "a\\nb\\");
+
+    ReplaceTemplate constant("plain $$ text");
+    CHECK(constant.isConstant() && !constant.needsGroups());
+    ReplaceTemplate bounds("<$&>");
+    CHECK(!bounds.isConstant() && !bounds.needsGroups());
+    CHECK(ReplaceTemplate("$1").needsGroups());
+    std::string verbatim;
+    ReplaceTemplate("\\U$1$&", false).expand("abc", RegexMatch{0, 1, {"a"}}, verbatim);
+    CHECK(verbatim == "\\U$1$&");
+}
+
+// A line with a thousand matches becomes one rewrite; replaceAll matches the preview, changes
+// the buffer in one undo step, and literal replacements keep "$" as typed
+// Bin eslemeli bir satir tek bir yeniden yazim olur; replaceAll onizlemeyle uyusur, buffer'i
+// tek geri alma adiminda degistirir ve literal degistirmeler "$"i yazildigi gibi tutar
+static void testReplaceAll() {
+    std::string dense;
+    for (int i = 0; i < 1000; ++i) dense += "k" + std::to_string(i % 10) + " ";
+    Buffer buffer;
+    buffer.loadLines({dense, "no hits here", "k5 and k7"});
+    const std::string before = buffer.getLine(0);
+    SearchEngine engine;
+    SearchOptions opts;
+    opts.regex = true;
+
+    const std::vector<LineReplacement> preview = engine.previewReplaceAll(buffer.snapshot(), "k(\\d)", "K$1$1", opts);
+    CHECK(preview.size() == 2);
+    CHECK(preview[0].line == 0 && preview[0].matches == 1000 && preview[0].before == before);
+    CHECK(preview[1].line == 2 && preview[1].after == "K55 and K77");
+    CHECK(buffer.getLine(0) == before);
+
+    UndoManager undo;
+    std::vector<AppliedEdit> applied;
+    CHECK(engine.replaceAll(buffer, "k(\\d)", "K$1$1", opts, &applied) == 1002);
+    CHECK(applied.size() == 2);
+    CHECK(buffer.getLine(0) == preview[0].after && buffer.getLine(2) == "K55 and K77");
+    undo.addEdits(applied);
+    CHECK(undo.undo(buffer) && buffer.getLine(0) == before && buffer.getLine(2) == "k5 and k7");
+    CHECK(!undo.undo(buffer));
+
+    SearchOptions literal;
+    literal.caseSensitive = false;
+    literal.wholeWord = true;
+    CHECK(engine.replaceAll(buffer, "AND", "$1&", literal) == 1);
+    CHECK(buffer.getLine(2) == "k5 $1& k7");
+    CHECK(engine.replaceAll(buffer, "absent", "x", literal) == 0);
+}
+
+int main() {
+    testAgainstStdRegex();
+    testTokens();
+    testReplaceAll();
+    return checkResult("ReplaceTemplateTest");
+}
@@ -0,0 +1,151 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "SearchEngine.h"
+#include "SearchSession.h"
+#include "buffer.h"
+
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <string>
+#include <vector>
+
+// Apply a delta to a client's copy of the results, as SearchDelta describes
+// Bir deltayi, SearchDelta'nin tarif ettigi gibi bir istemcinin sonuc kopyasina uygula
+static void applyDelta(std::vector<SearchMatch>& copy, const SearchDelta& delta, const SearchSession& session) {
+    if (delta.reset) {
+        copy = session.query(0, INT_MAX);
+        return;
+    }
+    for (const LineChange& c : delta.lines) {
+        const int end = c.line + c.removed;
+        std::vector<SearchMatch> kept;
+        for (SearchMatch m : copy) {
+            if (m.line >= c.line && m.line < end) continue;
+            if (m.line >= end) {
+                m.line += c.added - c.removed;
+                m.endLine += c.added - c.removed;
+            }
+            kept.push_back(m);
+        }
+        copy.swap(kept);
+    }
+    copy.insert(copy.end(), delta.added.begin(), delta.added.end());
+    std::sort(copy.begin(), copy.end(), [](const SearchMatch& a, const SearchMatch& b) {
+        return a.line != b.line ? a.line < b.line : a.col < b.col;
+    });
+}
+
+// One random edit: typing, deleting within or across lines, splitting, joining or pasting lines
+// Tek bir rastgele duzenleme: yazma, satir ici veya satirlar arasi silme, bolme, birlestirme
+// veya satir yapistirma
+static void randomEdit(Buffer& buffer, std::mt19937& rng) {
+    const int line = static_cast<int>(rng() % buffer.lineCount());
+    const int len = static_cast<int>(buffer.getLine(line).size());
+    const int col = len ? static_cast<int>(rng() % (len + 1)) : 0;
+    switch (rng() % 6) {
+    case 0: buffer.insertText(line, col, rng() % 2 ? "ab" : "x"); break;
+    case 1: if (col < len) buffer.deleteRange(line, col, line, std::min(len, col + 2)); break;
+    case 2: buffer.splitLine(line, col); break;
+    case 3: if (line + 1 < buffer.lineCount()) buffer.joinLines(line, line + 1); break;
+    case 4: buffer.insertText(line, col, "ab\nx ab ab\n\nb"); break;
+    default: {
+        const int last = std::min(buffer.lineCount() - 1, line + static_cast<int>(rng() % 40));
+        buffer.deleteRange(line, col, last, 0);
+        break;
+    }
+    }
+}
+
+// Through random edits refreshed in small groups, the session, its viewport queries, its count
+// and a client copy kept by deltas all equal a fresh findAll; a gap the journal no longer
+// covers rebuilds
+// Kucuk gruplar halinde yenilenen rastgele duzenlemeler boyunca oturum, gorunum sorgulari,
+// sayisi ve deltalarla tutulan bir istemci kopyasi hep taze bir findAll'a esittir; gunlugun
+// artik kapsamadigi bir bosluk yeniden kurar
+static void testAgainstFindAll() {
+    std::vector<std::string> lines;
+    for (int i = 0; i < 3000; ++i) lines.push_back(i % 7 ? "ab x ab" : "none");
+    Buffer buffer;
+    buffer.loadLines(std::move(lines));
+    SearchEngine engine;
+    SearchOptions opts;
+    SearchSession session("ab", opts);
+
+    SearchDelta delta;
+    CHECK(session.refresh(buffer, engine, &delta) && delta.reset);
+    CHECK(session.count() > static_cast<int>(2 * SearchSession::kBlockSize));
+    std::vector<SearchMatch> copy;
+    applyDelta(copy, delta, session);
+    CHECK(!session.refresh(buffer, engine));
+
+    std::mt19937 rng(11);
+    int incremental = 0;
+    for (int round = 0; round < 400; ++round) {
+        const uint64_t before = buffer.version();
+        for (int k = 1 + static_cast<int>(rng() % 6); k > 0; --k) randomEdit(buffer, rng);
+        if (buffer.version() == before) {
+            CHECK(!session.refresh(buffer, engine, &delta));
+            continue;
+        }
+        CHECK(session.refresh(buffer, engine, &delta));
+        CHECK(delta.version == buffer.version() && session.version() == buffer.version());
+        incremental += !delta.reset;
+        applyDelta(copy, delta, session);
+
+        const std::vector<SearchMatch> expected = engine.findAll(buffer, "ab", opts);
+        CHECK(session.count() == static_cast<int>(expected.size()) && delta.count == session.count());
+        CHECK(sameMatches(copy, expected));
+        const int first = static_cast<int>(rng() % buffer.lineCount());
+        const int last = first + static_cast<int>(rng() % 80);
+        std::vector<SearchMatch> visible;
+        for (const SearchMatch& m : expected)
+            if (m.endLine >= first && m.line <= last) visible.push_back(m);
+        CHECK(sameMatches(session.query(first, last), visible));
+    }
+    CHECK(incremental > 300);
+
+    // More edits than the journal keeps between two refreshes: the session rebuilds
+    // Iki yenileme arasinda gunlugun tuttugundan fazla duzenleme: oturum yeniden kurulur
+    for (int i = 0; i < 5000; ++i) buffer.insertChar(0, 0, 'b');
+    buffer.insertText(0, 0, "a");
+    CHECK(session.refresh(buffer, engine, &delta) && delta.reset);
+    applyDelta(copy, delta, session);
+    CHECK(sameMatches(copy, engine.findAll(buffer, "ab", opts)));
+}
+
+// A session belongs to its first buffer; multi-line sessions rescan on every change
+// Bir oturum ilk buffer'ina aittir; cok satirli oturumlar her degisiklikte yeniden tarar
+static void testOwnerAndMultiline() {
+    Buffer first, other;
+    first.loadLines({"one ab", "two"});
+    other.loadLines({"ab ab"});
+    SearchEngine engine;
+    SearchOptions opts;
+    SearchSession session("ab", opts);
+    CHECK(session.refresh(first, engine) && session.count() == 1);
+    other.insertText(0, 0, "ab");
+    CHECK(!session.refresh(other, engine));
+    CHECK(session.count() == 1 && session.version() == first.version());
+
+    opts.regex = true;
+    opts.multiline = true;
+    SearchSession spanning("b\nt", opts);
+    SearchDelta delta;
+    CHECK(spanning.refresh(first, engine, &delta) && delta.reset && spanning.count() == 1);
+    first.insertText(1, 0, "t");
+    first.insertText(0, 0, "b\n");
+    CHECK(spanning.refresh(first, engine, &delta) && delta.reset);
+    CHECK(sameMatches(spanning.query(0, INT_MAX), engine.findAll(first, "b\nt", opts)));
+    CHECK(spanning.count() == 1 && spanning.query(1, 1).size() == 1);
+}
+
+int main() {
+    testAgainstFindAll();
+    testOwnerAndMultiline();
+    return checkResult("SearchSessionTest");
+}
@@ -0,0 +1,93 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "PieceTable.h"
+#include "buffer.h"
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Lines of a live buffer, read one at a time
+// Canli bir buffer'in satirlari, teker teker okunur
+static std::vector<std::string> linesOf(const Buffer& buffer) {
+    std::vector<std::string> all;
+    for (int i = 0; i < buffer.lineCount(); ++i) all.push_back(buffer.getLine(i));
+    return all;
+}
+
+// A snapshot keeps its text while another thread reads it and the buffer is edited and
+// compacted underneath; fresh snapshots always match the live buffer.
+// Bir snapshot, baska bir thread onu okurken ve buffer altinda duzenlenip sikistirilirken
+// metnini korur; taze snapshot'lar her zaman canli buffer ile eslesir.
+static void testSnapshotIsolation() {
+    PieceTable::setGcPolicy(10, 1, 0);
+    Buffer buffer;
+    for (int i = 0; i < 2000; ++i) buffer.insertLine("L" + std::to_string(i));
+    BufferSnapshot snapshot = buffer.snapshot();
+    const std::vector<std::string> reference = snapshot.allLines();
+
+    std::atomic<int> readerMismatches{0};
+    std::thread reader([&] {
+        for (int k = 0; k < 50; ++k)
+            if (snapshot.allLines() != reference) ++readerMismatches;
+    });
+
+    std::mt19937 rng(1);
+    for (int k = 0; k < 20000; ++k) {
+        int count = buffer.lineCount();
+        int line = static_cast<int>(rng() % count);
+        switch (rng() % 4) {
+            case 0: buffer.insertLine("x" + std::to_string(k)); break;
+            case 1: if (count > 1) buffer.deleteLine(line); break;
+            case 2: buffer.setLine(line, "s" + std::to_string(k)); break;
+            case 3: buffer.insertText(line, 0, "ab"); break;
+        }
+        if (k % 5000 == 0) CHECK(buffer.snapshot().allLines() == linesOf(buffer));
+    }
+    reader.join();
+
+    CHECK(readerMismatches == 0);
+    CHECK(snapshot.allLines() == reference);
+    CHECK(buffer.version() > snapshot.version());
+}
+
+// Edits rejected by validation leave the version and the change journal alone, so a snapshot
+// taken before them still counts as current
+// Dogrulamanin reddettigi duzenlemeler surumu ve degisiklik gunlugunu oldugu gibi birakir,
+// boylece onlardan once alinan bir snapshot hala guncel sayilir
+static void testRejectedEditsKeepVersion() {
+    Buffer buffer;
+    buffer.insertText(0, 0, "ab\ncd");
+    const uint64_t before = buffer.version();
+    buffer.insertChar(5, 0, 'x');
+    buffer.deleteChar(0, 9);
+    buffer.insertText(0, 9, "y");
+    buffer.deleteRange(1, 0, 0, 0);
+    buffer.splitLine(-1, 0);
+    buffer.joinLines(1, 1);
+    buffer.setLine(7, "z");
+    buffer.deleteLine(7);
+    PieceTable other;
+    buffer.restoreRange(other, 4, 0, 4, 0);
+    CHECK(buffer.version() == before);
+    std::vector<LineChange> changes;
+    CHECK(buffer.changesSince(before, buffer.version(), changes) && changes.empty());
+    CHECK(linesOf(buffer) == (std::vector<std::string>{"ab", "cd"}));
+
+    buffer.insertChar(0, 1, 'x');
+    CHECK(buffer.version() == before + 1);
+    CHECK(buffer.changesSince(before, buffer.version(), changes) && changes.size() == 1);
+}
+
+int main() {
+    testSnapshotIsolation();
+    testRejectedEditsKeepVersion();
+    return checkResult("SnapshotTest");
+}
@@ -0,0 +1,141 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "Transcoder.h"
+#include "buffer.h"
+#include "file.h"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Random text over every plane (ASCII, two/three-byte, astral, U+10FFFF) with CR/LF, encoded
+// and decoded in chunks of 0-8 bytes, so every surrogate pair and multi-byte sequence is split
+// at every position
+// Her duzlem uzerinde (ASCII, iki/uc baytlik, astral, U+10FFFF) CR/LF iceren rastgele metin,
+// 0-8 baytlik parcalar halinde kodlanir ve cozulur; boylece her vekil cift ve cok baytli dizi
+// her konumda bolunur
+static void testSplitChunks() {
+    std::mt19937 rng(1);
+    const uint32_t points[] = {'a', '\n', 0xE7, 0x20AC, 0x1F600, 0x10FFFF, '\r', '\n', 0x4E2D};
+    std::string utf8;
+    for (int i = 0; i < 200000; ++i) {
+        uint32_t cp = points[rng() % (sizeof(points) / sizeof(*points))];
+        const uint8_t unit[4] = {static_cast<uint8_t>(cp), static_cast<uint8_t>(cp >> 8),
+                                 static_cast<uint8_t>(cp >> 16), static_cast<uint8_t>(cp >> 24)};
+        Transcoder(TextEncoding::UTF32_LE).decode(unit, 4, utf8);
+    }
+
+    for (TextEncoding enc : {TextEncoding::UTF16_LE, TextEncoding::UTF16_BE, TextEncoding::UTF32_LE,
+                             TextEncoding::UTF32_BE}) {
+        Transcoder encoder(enc);
+        std::string bytes;
+        for (size_t i = 0; i < utf8.size();) {
+            size_t n = std::min<size_t>(rng() % 7, utf8.size() - i);
+            encoder.encode(std::string_view(utf8).substr(i, n), bytes);
+            i += n;
+        }
+        encoder.finishEncode(bytes);
+
+        Transcoder decoder(enc);
+        std::string back;
+        for (size_t i = 0; i < bytes.size();) {
+            size_t n = std::min<size_t>(rng() % 9, bytes.size() - i);
+            decoder.decode(reinterpret_cast<const uint8_t*>(bytes.data()) + i, n, back);
+            i += n;
+        }
+        decoder.finishDecode(back);
+        CHECK(back == utf8);
+    }
+}
+
+// Lone surrogates decode to U+FFFD; unencodable or cut-off input encodes as '?' (Latin-1)
+// or U+FFFD (UTF-16), including sequences split across encode calls
+// Tek vekiller U+FFFD olarak cozulur; kodlanamayan veya kesik girdi '?' (Latin-1) veya U+FFFD
+// (UTF-16) olarak kodlanir, encode cagrilari arasinda bolunen diziler dahil
+static void testMalformed() {
+    {
+        Transcoder decoder(TextEncoding::UTF16_LE);
+        std::string out;
+        const uint8_t bytes[] = {0x00, 0xD8, 0x41, 0x00, 0x00, 0xDC};
+        decoder.decode(bytes, sizeof(bytes), out);
+        decoder.finishDecode(out);
+        CHECK(out == "\xEF\xBF\xBD" "A" "\xEF\xBF\xBD");
+    }
+    {
+        Transcoder encoder(TextEncoding::Latin1);
+        std::string out;
+        encoder.encode("a\xC3", out);
+        encoder.encode("\xA7\xE2\x82", out);
+        encoder.encode("\xACz\xFF", out);
+        encoder.finishEncode(out);
+        CHECK(out == "a\xE7?z?");
+    }
+    {
+        Transcoder encoder(TextEncoding::UTF16_LE);
+        std::string out;
+        encoder.encode("\xE2\x82", out);
+        encoder.encode("A", out);
+        encoder.finishEncode(out);
+        CHECK(out == std::string("\xFD\xFF" "A\0", 4));
+    }
+}
+
+// Load and save round trips: UTF-16LE with a BOM larger than a read block, every Latin-1 byte,
+// and a UTF-8 BOM, each saved back byte for byte in its own encoding
+// Yukleme ve kaydetme gidis donusleri: bir okuma blogundan buyuk BOM'lu UTF-16LE, her Latin-1
+// bayti ve bir UTF-8 BOM; her biri kendi kodlamasinda bayt bayt geri kaydedilir
+static void testFileRoundTrip(const TempDir& dir) {
+    {
+        std::string text;
+        for (int i = 0; i < 400000; ++i) text += "line " + std::to_string(i) + " \xF0\x9F\x98\x80 \xC3\xA7\n";
+        std::string bytes = "\xFF\xFE";
+        Transcoder encoder(TextEncoding::UTF16_LE);
+        encoder.encode(text, bytes);
+        encoder.finishEncode(bytes);
+        std::ofstream(dir.file("u16.txt"), std::ios::binary) << bytes;
+
+        Buffer buffer;
+        CHECK(FileSystem::loadToBuffer(buffer, dir.file("u16.txt")).success);
+        CHECK(buffer.fileEncoding().encoding == TextEncoding::UTF16_LE && buffer.fileEncoding().bom);
+        CHECK(buffer.lineCount() == 400000);
+        CHECK(buffer.getLine(123) == "line 123 \xF0\x9F\x98\x80 \xC3\xA7");
+        CHECK(FileSystem::saveFromBuffer(buffer, dir.file("u16b.txt")).success);
+        CHECK(slurp(dir.file("u16b.txt")) == bytes);
+    }
+    {
+        std::string raw;
+        for (int i = 0; i < 3; ++i) {
+            for (int c = 1; c < 256; ++c)
+                if (c != '\n' && c != '\r') raw += static_cast<char>(c);
+            raw += '\n';
+        }
+        std::ofstream(dir.file("l1.txt"), std::ios::binary) << raw;
+        Buffer buffer;
+        CHECK(FileSystem::loadToBuffer(buffer, dir.file("l1.txt")).success);
+        CHECK(FileSystem::saveFromBuffer(buffer, dir.file("l1b.txt")).success);
+        CHECK(slurp(dir.file("l1b.txt")) == raw);
+    }
+    {
+        const std::string raw = "\xEF\xBB\xBFhello\nw\xC3\xB6rld\n";
+        std::ofstream(dir.file("b8.txt"), std::ios::binary) << raw;
+        Buffer buffer;
+        CHECK(FileSystem::loadToBuffer(buffer, dir.file("b8.txt")).success);
+        CHECK(buffer.getLine(0) == "hello");
+        CHECK(FileSystem::saveFromBuffer(buffer, dir.file("b8b.txt")).success);
+        CHECK(slurp(dir.file("b8b.txt")) == raw);
+    }
+}
+
+int main() {
+    TempDir dir("transcoder");
+    testSplitChunks();
+    testMalformed();
+    testFileRoundTrip(dir);
+    return checkResult("TranscoderTest");
+}
@@ -0,0 +1,167 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "LinearRegexEngine.h"
+#include "TrigramIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char* kWords[] = {"alpha", "beta", "gamma", "delta", "omega", "sigma"};
+
+// Write a file, creating its directories / Dizinlerini olusturarak bir dosya yaz
+static void put(const fs::path& path, const std::string& text) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+// Wait until the index is ready (at most ten seconds)
+// Indeks hazir olana kadar bekle (en fazla on saniye)
+static bool waitReady(const TrigramIndex& index) {
+    for (int i = 0; i < 1000 && !index.ready(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return index.ready();
+}
+
+// Files under root with a line matching pattern, by reading them all
+// Hepsini okuyarak, kok altinda kalipla eslesen bir satiri olan dosyalar
+static std::vector<std::string> scan(const fs::path& root, const std::string& pattern, const SearchOptions& opts) {
+    LinearRegexEngine re;
+    re.compile(pattern, opts.caseSensitive);
+    std::vector<std::string> out;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        std::ifstream in(entry.path(), std::ios::binary);
+        std::string line;
+        int pos, len;
+        while (std::getline(in, line)) {
+            if (!re.find(line, 0, pos, len)) continue;
+            out.push_back(entry.path().string());
+            break;
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// Candidates of a query, sorted; "<none>" if it was not narrowed
+// Bir sorgunun siralanmis adaylari; daraltilmadiysa "<none>"
+static std::vector<std::string> candidates(const TrigramIndex& index, const std::string& pattern,
+                                           const SearchOptions& opts) {
+    std::vector<std::string> out;
+    if (!index.candidates(pattern, opts, out)) return {"<none>"};
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// Every file that matches is a candidate, and a token held by one file narrows to that file
+// Eslesen her dosya bir adaydir ve tek bir dosyanin tuttugu bir belirtec o dosyaya daralir
+static void checkQueries(const TrigramIndex& index, const fs::path& root) {
+    SearchOptions regex;
+    regex.regex = true;
+    SearchOptions folded = regex;
+    folded.caseSensitive = false;
+    for (const std::string pattern : {"gamma", "alpha beta", "uniq00[1-3]|omega", "(?:delta|sigma) alpha",
+                                      "uniq0\\d5", "new[a-z]+"}) {
+        for (const SearchOptions& opts : {regex, folded}) {
+            const std::vector<std::string> got = candidates(index, pattern, opts);
+            const std::vector<std::string> truth = scan(root, pattern, opts);
+            CHECK(got != std::vector<std::string>({"<none>"}));
+            CHECK(std::includes(got.begin(), got.end(), truth.begin(), truth.end()));
+        }
+    }
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (entry.path().extension() != ".txt") continue;
+        const std::string token = entry.path().stem().string();
+        CHECK(candidates(index, token, SearchOptions()) == std::vector<std::string>({entry.path().string()}));
+    }
+    CHECK(candidates(index, "ab", SearchOptions()) == std::vector<std::string>({"<none>"}));
+    CHECK(candidates(index, ".*|gamma", regex) == std::vector<std::string>({"<none>"}));
+}
+
+// Built from scratch, then changed through the overlay (rewrites, new files, removed files and
+// directories), saved as a delta and as a new base, and loaded again: candidates always cover
+// every matching file
+// Sifirdan kurulur, sonra katman uzerinden degistirilir (yeniden yazimlar, yeni dosyalar,
+// silinen dosyalar ve dizinler), delta ve yeni taban olarak kaydedilir ve yeniden yuklenir:
+// adaylar her zaman eslesen her dosyayi kapsar
+static void testOverlay() {
+    TempDir tree("trigram-tree");
+    TempDir store("trigram-store");
+    const fs::path root = fs::canonical(tree.path);
+    std::mt19937 rng(17);
+    auto content = [&](const std::string& token) {
+        std::ostringstream text;
+        text << token << "\n";
+        for (int line = 0; line < 20; ++line) {
+            for (int w = 0; w < 6; ++w) text << kWords[rng() % 6] << (w < 5 ? " " : "\n");
+        }
+        return text.str();
+    };
+    for (int i = 0; i < 60; ++i) {
+        char token[16];
+        std::snprintf(token, sizeof token, "uniq%03d", i);
+        put(root / ("d" + std::to_string(i % 5)) / (std::string(token) + ".txt"), content(token));
+    }
+
+    TrigramIndex::setWatchInterval(std::chrono::milliseconds(50));
+    TrigramIndex index;
+    index.start(tree.path.string(), store.path.string());
+    CHECK(waitReady(index));
+    CHECK(index.stats().files == 60);
+    checkQueries(index, root);
+
+    // Overlay: a rewritten file drops its old trigrams, new files join, removals leave
+    // Katman: yeniden yazilan bir dosya eski trigramlarini birakir, yeni dosyalar katilir,
+    // silinenler ayrilir
+    const fs::path rewritten = root / "d1" / "uniq011.txt";
+    put(rewritten, "uniq011\nnewzebra only\n");
+    index.updateFile(rewritten.string());
+    CHECK(candidates(index, "newzebra", SearchOptions()) == std::vector<std::string>({rewritten.string()}));
+    const std::vector<std::string> gammas = candidates(index, "gamma", SearchOptions());
+    CHECK(!std::binary_search(gammas.begin(), gammas.end(), rewritten.string()));
+
+    const fs::path added = root / "d9" / "uniq100.txt";
+    put(added, content("uniq100") + "newyak\n");
+    index.updateFile(added.string());
+    fs::remove(root / "d2" / "uniq007.txt");
+    index.removePath((root / "d2" / "uniq007.txt").string());
+    fs::remove_all(root / "d3");
+    index.removePath((root / "d3").string());
+    CHECK(index.stats().files == 60 + 1 - 1 - 12);
+    CHECK(index.stats().pending > 0);
+    checkQueries(index, root);
+
+    // A stop writes the overlay as a delta beside the base, and a restart reads both
+    // Durdurma katmani tabanin yanina delta olarak yazar ve yeniden baslatma ikisini de okur
+    index.stop();
+    TrigramIndex reloaded;
+    reloaded.start(tree.path.string(), store.path.string());
+    CHECK(reloaded.ready() && reloaded.stats().files == 48);
+    CHECK(candidates(reloaded, "newzebra", SearchOptions()) == std::vector<std::string>({rewritten.string()}));
+    CHECK(waitReady(reloaded));
+    checkQueries(reloaded, root);
+
+    // save() folds the overlay into a new base with the same answers
+    // save() katmani ayni cevaplari veren yeni bir tabana katlar
+    CHECK(reloaded.save());
+    CHECK(reloaded.stats().pending == 0 && reloaded.stats().files == 48 && reloaded.stats().bytes > 0);
+    checkQueries(reloaded, root);
+    reloaded.stop();
+}
+
+int main() {
+    testOverlay();
+    return checkResult("TrigramIndexTest");
+}
@@ -0,0 +1,303 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "BufferSnapshot.h"
+#include "UndoFile.h"
+#include "buffer.h"
+#include "file.h"
+#include "undo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A history with a branch, range cuts and an unsaved tail survives a reopen of the saved
+// text: undo walks back to the first text, redo reaches the unsaved tail, every restored node
+// can be visited by id, and other text starts a fresh history
+// Bir dal, aralik kesmeleri ve kaydedilmemis bir kuyruk iceren gecmis, kaydedilen metnin yeniden
+// acilisindan sag cikar: geri alma ilk metne doner, yineleme kaydedilmemis kuyruga ulasir, geri
+// yuklenen her dugum kimlikle ziyaret edilebilir ve baska bir metin taze bir gecmis baslatir
+static void testReopen(const TempDir& dir) {
+    const std::string path = dir.file("doc.txt");
+    std::string first, saved;
+    std::map<uint32_t, std::string> textAt;
+    {
+        Buffer buffer;
+        buffer.insertText(0, 0, "hello\nworld");
+        UndoManager undo;
+        undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+        first = dump(buffer);
+        textAt[undo.currentId()] = first;
+
+        std::mt19937 rng(1);
+        for (int i = 0; i < 300; ++i) {
+            int kind = static_cast<int>(rng() % 5);
+            int line = static_cast<int>(rng() % buffer.lineCount());
+            int cols = buffer.columnCount(line);
+            if (kind < 3) {
+                int col = static_cast<int>(rng() % (cols + 1));
+                char c = "ab \nx"[rng() % 5];
+                if (c == '\n') {
+                    buffer.insertText(line, col, "\n");
+                    undo.addAction(textAction(line, col, "\n"));
+                } else {
+                    buffer.insertChar(line, col, c);
+                    undo.addAction(charAction(ActionType::Insert, line, col, c));
+                }
+            } else if (kind == 3 && cols > 0) {
+                int col = static_cast<int>(rng() % cols);
+                char c = buffer.getLine(line)[col];
+                buffer.deleteChar(line, col);
+                undo.addAction(charAction(ActionType::Delete, line, col, c));
+            } else if (kind == 4 && buffer.lineCount() > 2) {
+                undo.addAction(cutAction(buffer, line, 0, std::min(buffer.lineCount() - 1, line + 1), 0));
+            }
+            if (i == 150) {
+                for (int k = 0; k < 5; ++k) undo.undo(buffer);
+                buffer.insertChar(0, 0, 'Z');
+                undo.addAction(charAction(ActionType::Insert, 0, 0, 'Z'));
+            }
+            undo.breakRun();
+            textAt[undo.currentId()] = dump(buffer);
+        }
+        undo.journal()->save(undo.savePoint(), UndoFile::hashContent(buffer.snapshot()));
+        saved = dump(buffer);
+
+        buffer.insertChar(0, 0, 'Q');
+        undo.addAction(charAction(ActionType::Insert, 0, 0, 'Q'));
+    }
+
+    Buffer reopened;
+    reopened.insertText(0, 0, saved.substr(0, saved.size() - 1));
+    CHECK(dump(reopened) == saved);
+    UndoManager undo;
+    undo.persistTo(UndoFile::forPath(path), reopened.snapshot());
+    int undos = 0;
+    while (undo.undo(reopened)) ++undos;
+    CHECK(undos > 0);
+    CHECK(dump(reopened) == first);
+    while (undo.redo(reopened)) {}
+    CHECK(dump(reopened) == "Q" + saved);
+
+    int visited = 0;
+    for (const UndoNodeInfo& node : undo.tree()) {
+        auto known = textAt.find(node.id);
+        if (known == textAt.end()) continue;
+        CHECK(undo.gotoNode(node.id, reopened));
+        CHECK(dump(reopened) == known->second);
+        ++visited;
+    }
+    CHECK(visited > 100);
+
+    Buffer other;
+    other.insertText(0, 0, "other");
+    UndoManager fresh;
+    fresh.persistTo(UndoFile::forPath(path), other.snapshot());
+    CHECK(!fresh.undo(other));
+    CHECK(fresh.nodeCount() == 1);
+}
+
+// A cut too large to copy is journaled from its sealed table, and after a reopen of the saved
+// text undo splices back every removed line and redo cuts them again
+// Kopyalanamayacak kadar buyuk bir kesme muhurlu tablosundan gunluge yazilir ve kaydedilen metnin
+// yeniden acilisindan sonra geri alma silinen her satiri geri ekler, yineleme onlari yeniden keser
+static void testReopenLargeCut(const TempDir& dir) {
+    const std::string path = dir.file("large.txt");
+    std::string original, saved;
+    {
+        std::vector<std::string> lines;
+        for (int i = 0; i < 50000; ++i) lines.push_back("row " + std::to_string(i));
+        Buffer buffer;
+        buffer.loadLines(std::move(lines));
+        original = dump(buffer);
+        UndoManager undo;
+        undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+        undo.addAction(cutAction(buffer, 3, 2, 49000, 3));
+        undo.breakRun();
+        undo.journal()->save(undo.savePoint(), UndoFile::hashContent(buffer.snapshot()));
+        undo.journal()->flush();
+        saved = dump(buffer);
+    }
+    CHECK(saved.size() < original.size() / 10);
+
+    Buffer reopened;
+    reopened.insertText(0, 0, saved.substr(0, saved.size() - 1));
+    UndoManager undo;
+    undo.persistTo(UndoFile::forPath(path), reopened.snapshot());
+    CHECK(undo.undo(reopened));
+    CHECK(dump(reopened) == original);
+    CHECK(!undo.undo(reopened));
+    CHECK(undo.redo(reopened));
+    CHECK(dump(reopened) == saved);
+}
+
+// A cut of a progressively loaded file is journaled, and edits made while the next open is
+// still loading are grafted onto the restored history once its hash is ready
+// Asamali yuklenen bir dosyanin kesmesi gunluge yazilir ve sonraki acilis hala yuklenirken
+// yapilan duzenlemeler, ozeti hazir oldugunda geri yuklenen gecmise eklenir
+static void testGraftWhileLoading(const TempDir& dir) {
+    const std::string path = dir.file("graft.txt");
+    {
+        std::ofstream out(path);
+        for (int i = 0; i < 400000; ++i) out << "line number " << i << " with some padding text here\n";
+    }
+    const uintmax_t savedThreshold = FileSystem::asyncOpenThreshold();
+    FileSystem::setAsyncOpenThreshold(1);
+
+    std::string opened;
+    {
+        Buffer buffer;
+        CHECK(FileSystem::loadToBufferAsync(buffer, path, nullptr).success);
+        UndoManager undo;
+        undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+        opened = dump(buffer);
+        buffer.insertChar(0, 0, 'A');
+        undo.addAction(charAction(ActionType::Insert, 0, 0, 'A'));
+        undo.addAction(cutAction(buffer, 10, 3, 20000, 5));
+        buffer.insertChar(1, 0, 'B');
+        undo.addAction(charAction(ActionType::Insert, 1, 0, 'B'));
+
+        // Replace the file rather than rewrite it: the buffer still maps the old one
+        // Dosyayi yeniden yazmak yerine degistir: buffer hala eskisini esliyor
+        const uint32_t savePoint = undo.savePoint();
+        std::string content = dump(buffer);
+        content.pop_back();
+        std::ofstream(path + ".tmp", std::ios::trunc) << content;
+        std::filesystem::rename(path + ".tmp", path);
+        undo.journal()->save(savePoint, UndoFile::hashContent(buffer.snapshot().completed()));
+        undo.journal()->flush();
+    }
+
+    std::string saved;
+    {
+        std::ifstream in(path);
+        saved.assign(std::istreambuf_iterator<char>(in), {});
+        saved += '\n';
+    }
+    Buffer buffer;
+    CHECK(FileSystem::loadToBufferAsync(buffer, path, nullptr).success);
+    UndoManager undo;
+    undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+    buffer.insertChar(0, 0, 'C');
+    undo.addAction(charAction(ActionType::Insert, 0, 0, 'C'));
+    for (int k = 0; k < 200 && undo.nodeCount() < 5; ++k) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        undo.ensureLoaded();
+    }
+    CHECK(undo.undo(buffer));
+    CHECK(dump(buffer) == saved);
+    while (undo.undo(buffer)) {}
+    CHECK(dump(buffer) == opened);
+    while (undo.redo(buffer)) {}
+    CHECK(dump(buffer) == "C" + saved);
+    FileSystem::setAsyncOpenThreshold(savedThreshold);
+}
+
+// Cancelling a progressive load stops the hash worker from indexing the rest of the file,
+// history still works without the journal, and the manager goes away without waiting for
+// the file to be read
+// Asamali bir yuklemeyi iptal etmek ozet calisaninin dosyanin geri kalanini indekslemesini
+// durdurur, gecmis gunluk olmadan da calisir ve yonetici dosyanin okunmasini beklemeden gider
+static void testCancelWhileHashing(const TempDir& dir) {
+    const std::string path = dir.file("cancel.txt");
+    {
+        std::ofstream out(path);
+        for (int i = 0; i < 2000000; ++i) out << "line number " << i << " with some padding text here\n";
+    }
+    const uintmax_t savedThreshold = FileSystem::asyncOpenThreshold();
+    FileSystem::setAsyncOpenThreshold(1);
+
+    Buffer buffer;
+    CHECK(FileSystem::loadToBufferAsync(buffer, path, nullptr).success);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        UndoManager undo;
+        undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+        buffer.cancelLoading();
+        const int lines = buffer.lineCount();
+        buffer.insertChar(0, 0, 'X');
+        undo.addAction(charAction(ActionType::Insert, 0, 0, 'X'));
+        for (int k = 0; k < 20; ++k) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            undo.ensureLoaded();
+        }
+        CHECK(buffer.lineCount() == lines);
+        CHECK(undo.undo(buffer));
+        CHECK(buffer.getLine(0) == "line number 0 with some padding text here");
+    }
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+    FileSystem::setAsyncOpenThreshold(savedThreshold);
+}
+
+// A cut exactly as long as the journal can hold survives a reopen; one byte longer empties
+// the history on disk instead of writing a record whose length wraps, so a reopen starts fresh
+// and nothing after it is misread
+// Gunlugun tutabilecegi uzunluktaki bir kesme yeniden acilistan sag cikar; bir bayt uzunu,
+// uzunlugu tasan bir kayit yazmak yerine diskteki gecmisi bosaltir, boylece yeniden acilis
+// tazeden baslar ve ondan sonraki hicbir sey yanlis okunmaz
+static void testCutAtTextLimit(const TempDir& dir) {
+    UndoFile::setMaxText(100000);
+    for (int over = 0; over <= 1; ++over) {
+        const std::string path = dir.file("limit" + std::to_string(over) + ".txt");
+        std::string original, saved;
+        {
+            // 11 bytes a line, so 9090 lines and 10 columns make exactly 100000
+            // Satir basina 11 bayt, boylece 9090 satir ve 10 sutun tam 100000 eder
+            std::vector<std::string> lines;
+            for (int i = 10000; i < 30000; ++i) lines.push_back("line " + std::to_string(i));
+            Buffer buffer;
+            buffer.loadLines(std::move(lines));
+            original = dump(buffer);
+            UndoManager undo;
+            undo.persistTo(UndoFile::forPath(path), buffer.snapshot());
+            buffer.insertChar(0, 0, 'X');
+            undo.addAction(charAction(ActionType::Insert, 0, 0, 'X'));
+            undo.breakRun();
+            undo.addAction(over ? cutAction(buffer, 0, 0, 9091, 0) : cutAction(buffer, 0, 0, 9090, 10));
+            undo.breakRun();
+            buffer.insertChar(0, 0, 'Y');
+            undo.addAction(charAction(ActionType::Insert, 0, 0, 'Y'));
+            undo.breakRun();
+            undo.journal()->save(undo.savePoint(), UndoFile::hashContent(buffer.snapshot()));
+            undo.journal()->flush();
+            saved = dump(buffer);
+        }
+
+        Buffer reopened;
+        reopened.insertText(0, 0, saved.substr(0, saved.size() - 1));
+        UndoManager undo;
+        undo.persistTo(UndoFile::forPath(path), reopened.snapshot());
+        if (over) {
+            CHECK(!undo.undo(reopened));
+            CHECK(undo.nodeCount() == 1);
+            CHECK(dump(reopened) == saved);
+        } else {
+            while (undo.undo(reopened)) {}
+            CHECK(dump(reopened) == original);
+            while (undo.redo(reopened)) {}
+            CHECK(dump(reopened) == saved);
+        }
+    }
+    UndoFile::setMaxText(UndoFile::kMaxText);
+}
+
+int main() {
+    TempDir dir("undofile");
+    UndoFile::setDirectory(dir.file("undo"));
+    testReopen(dir);
+    testReopenLargeCut(dir);
+    testGraftWhileLoading(dir);
+    testCancelWhileHashing(dir);
+    testCutAtTextLimit(dir);
+    return checkResult("UndoFileTest");
+}
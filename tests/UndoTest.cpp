@@ -0,0 +1,284 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "PieceTable.h"
+#include "buffer.h"
+#include "undo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Random typing, backspace and delete runs mixed with undo/redo and run breaks: undoing
+// everything restores the original text and redoing everything restores the final text
+// Rastgele yazma, geri silme ve silme dizileri, geri al/yinele ve dizi kesmeleriyle karisik:
+// her seyi geri almak ozgun metni, her seyi yinelemek son metni geri getirir
+static void testCoalescedRoundTrip() {
+    std::mt19937 rng(7);
+    for (int iter = 0; iter < 300; ++iter) {
+        Buffer buffer;
+        buffer.loadLines({"hello world", "second line", "third"});
+        UndoManager undo;
+        const std::string original = dump(buffer);
+
+        for (int k = 0; k < 200; ++k) {
+            int kind = static_cast<int>(rng() % 10);
+            int line = static_cast<int>(rng() % buffer.lineCount());
+            int len = buffer.columnCount(line);
+            if (kind < 4) {
+                int col = static_cast<int>(rng() % (len + 1));
+                int run = 1 + static_cast<int>(rng() % 6);
+                for (int j = 0; j < run; ++j) {
+                    char c = "ab c\t"[rng() % 5];
+                    buffer.insertChar(line, col + j, c);
+                    undo.addAction(charAction(ActionType::Insert, line, col + j, c));
+                }
+            } else if (kind < 6 && len > 0) {
+                int col = 1 + static_cast<int>(rng() % len);
+                int run = 1 + static_cast<int>(rng() % std::min(col, 4));
+                for (int j = 0; j < run; ++j) {
+                    int at = col - 1 - j;
+                    char c = buffer.getLine(line)[at];
+                    buffer.deleteChar(line, at);
+                    undo.addAction(charAction(ActionType::Delete, line, at, c));
+                }
+            } else if (kind < 8 && len > 0) {
+                int col = static_cast<int>(rng() % len);
+                int run = 1 + static_cast<int>(rng() % std::min(len - col, 4));
+                for (int j = 0; j < run; ++j) {
+                    char c = buffer.getLine(line)[col];
+                    buffer.deleteChar(line, col);
+                    undo.addAction(charAction(ActionType::Delete, line, col, c));
+                }
+            } else if (kind == 8) {
+                for (int j = static_cast<int>(rng() % 3); j > 0; --j) undo.undo(buffer);
+                if (rng() % 2)
+                    for (int j = static_cast<int>(rng() % 3); j > 0; --j) undo.redo(buffer);
+            } else {
+                undo.breakRun();
+            }
+        }
+
+        while (undo.redo(buffer)) {}
+        const std::string final = dump(buffer);
+        while (undo.undo(buffer)) {}
+        CHECK(dump(buffer) == original);
+        while (undo.redo(buffer)) {}
+        CHECK(dump(buffer) == final);
+    }
+}
+
+// The memory cap evicts old history but what remains still undoes and redoes cleanly
+// Bellek siniri eski gecmisi cikarir ama kalan gecmis hala temizce geri alinir ve yinelenir
+static void testMemoryLimit() {
+    const size_t limit = 64 * 1024;
+    UndoManager::setMemoryLimit(limit);
+    Buffer buffer;
+    buffer.loadLines({""});
+    UndoManager undo;
+    for (int i = 0; i < 100000; ++i) {
+        if (i % 7 == 0) {
+            buffer.insertLineAt(buffer.lineCount(), "x");
+            undo.addAction(lineAction(buffer.lineCount() - 1, "x"));
+        } else {
+            int line = buffer.lineCount() - 1;
+            buffer.insertChar(line, 0, 'a');
+            undo.addAction(charAction(ActionType::Insert, line, 0, 'a'));
+        }
+        if (i % 1000 == 0) {
+            undo.undo(buffer);
+            undo.undo(buffer);
+        }
+    }
+    CHECK(undo.memoryUsage() <= limit);
+
+    const std::string final = dump(buffer);
+    int undone = 0;
+    while (undo.undo(buffer)) ++undone;
+    CHECK(undone > 0);
+    while (undo.redo(buffer)) {}
+    CHECK(dump(buffer) == final);
+    UndoManager::setMemoryLimit(0);
+}
+
+// A deep chain of uncoalesced edits is torn down without recursing per node
+// Birlestirilmemis duzenlemelerden olusan derin bir zincir dugum basina ozyineleme olmadan yikilir
+static void testDeepChainTeardown() {
+    Buffer buffer;
+    buffer.loadLines({""});
+    {
+        UndoManager undo;
+        for (int i = 0; i < 200000; ++i) {
+            buffer.insertChar(0, i, 'x');
+            undo.addAction(charAction(ActionType::Insert, 0, i, 'x'));
+            undo.breakRun();
+        }
+        CHECK(undo.nodeCount() >= 200000);
+    }
+    CHECK(buffer.columnCount(0) == 200000);
+}
+
+// Cutting most of a large file costs the history a few bytes when the lines are original and
+// their add-buffer bytes when typed; both undo and redo exactly, also after a collection
+// renumbered the add buffer under the sealed table
+// Buyuk bir dosyanin cogunu kesmek, satirlar orijinalse gecmise birkac bayta, yazilmissa ekleme
+// arabellegi baytlarina mal olur; ikisi de, bir toplama muhurlu tablonun altindaki ekleme
+// arabellegini yeniden numaralasa bile, tam olarak geri alinir ve yinelenir
+static void testReferencedCut() {
+    std::vector<std::string> lines;
+    for (int i = 0; i < 200000; ++i) lines.push_back("original line " + std::to_string(i));
+    Buffer mapped;
+    mapped.loadLines(std::move(lines));
+    const std::string original = dump(mapped);
+    UndoManager undo;
+    undo.addAction(cutAction(mapped, 10, 3, 190000, 5));
+    const std::string cut = dump(mapped);
+    CHECK(mapped.lineCount() == 200000 - 189990);
+    CHECK(undo.memoryUsage() < 1024);
+    CHECK(undo.undo(mapped));
+    CHECK(dump(mapped) == original);
+    CHECK(undo.redo(mapped));
+    CHECK(dump(mapped) == cut);
+
+    PieceTable::setGcPolicy(1, 1, 0);
+    Buffer typed;
+    typed.loadLines({""});
+    for (int i = 0; i < 20000; ++i) typed.insertLine("typed line " + std::to_string(i));
+    const std::string before = dump(typed);
+    UndoManager history;
+    history.addAction(cutAction(typed, 1, 0, 19990, 0));
+    CHECK(history.memoryUsage() >= 19989 * 11);
+    for (int i = 0; i < 50; ++i) typed.setLine(0, "churn " + std::to_string(i));
+    typed.setLine(0, "");
+    CHECK(typed.pieceTable().addBufferSize() < 100);
+    CHECK(history.undo(typed));
+    CHECK(dump(typed) == before);
+    PieceTable::setGcPolicy(50, 1024, 30);
+}
+
+// Two branches of line inserts: gotoNode reaches every node from anywhere, leaves redo pointing
+// down the path it took, and refuses unknown ids and the current node; gotoTime lands on the
+// newest node at or before a time, whichever branch it is on, and on the root before the first
+// Iki dal satir eklemesi: gotoNode her dugume her yerden ulasir, yinelemeyi izledigi yol boyunca
+// yonlendirir, bilinmeyen kimlikleri ve mevcut dugumu reddeder; gotoTime bir zamanda veya
+// oncesindeki en yeni dugume, hangi dalda olursa olsun, ve ilkinden once koke iner
+static void testGotoNodeAndTime() {
+    Buffer buffer;
+    buffer.loadLines({"base"});
+    UndoManager undo;
+    std::map<uint32_t, std::string> textAt;
+    textAt[undo.rootId()] = dump(buffer);
+
+    auto add = [&](const std::string& line) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        int at = buffer.lineCount();
+        buffer.insertLineAt(at, line);
+        undo.addAction(lineAction(at, line));
+        undo.breakRun();
+        textAt[undo.currentId()] = dump(buffer);
+    };
+    for (int i = 0; i < 4; ++i) add("a" + std::to_string(i));
+    const uint32_t tipA = undo.currentId();
+    CHECK(undo.undo(buffer) && undo.undo(buffer));
+    for (int i = 0; i < 3; ++i) add("b" + std::to_string(i));
+    const uint32_t tipB = undo.currentId();
+    CHECK(undo.tree().size() == textAt.size());
+
+    for (const auto& [id, expected] : textAt) {
+        if (id == undo.currentId()) continue;
+        CHECK(undo.gotoNode(id, buffer));
+        CHECK(dump(buffer) == expected && undo.currentId() == id);
+    }
+    CHECK(!undo.gotoNode(undo.currentId(), buffer));
+    CHECK(!undo.gotoNode(0, buffer));
+    CHECK(!undo.gotoNode(tipB + 1000, buffer));
+
+    CHECK(undo.gotoNode(tipA, buffer));
+    CHECK(undo.gotoNode(undo.rootId(), buffer));
+    while (undo.redo(buffer)) {}
+    CHECK(undo.currentId() == tipA && dump(buffer) == textAt[tipA]);
+
+    for (const UndoNodeInfo& node : undo.tree()) {
+        if (node.id == undo.rootId()) continue;
+        undo.gotoTime(node.time, buffer);
+        CHECK(undo.currentId() == node.id && dump(buffer) == textAt[node.id]);
+    }
+    int64_t first = 0;
+    for (const UndoNodeInfo& node : undo.tree())
+        if (node.id != undo.rootId() && (first == 0 || node.time < first)) first = node.time;
+    CHECK(undo.gotoTime(first - 1, buffer));
+    CHECK(undo.currentId() == undo.rootId() && dump(buffer) == "base\n");
+    CHECK(undo.gotoTime(INT64_MAX, buffer));
+    CHECK(undo.currentId() == tipB);
+}
+
+// A group recorded across clock ticks and an applyEdits replacement (a cut then an insert):
+// gotoNode and gotoTime on a node inside either group land on the node closing it, so the
+// group is never left half applied and one undo takes it back whole
+// Saat tiklari boyunca kaydedilen bir grup ve bir applyEdits degistirmesi (bir kesme, sonra bir
+// ekleme): herhangi bir grubun icindeki bir dugumde gotoNode ve gotoTime onu kapatan dugume iner,
+// boylece grup asla yarim uygulanmis kalmaz ve tek geri alma onu tumuyle geri getirir
+static void testGotoInsideGroup() {
+    Buffer buffer;
+    buffer.loadLines({"base"});
+    UndoManager undo;
+    const uint32_t root = undo.rootId();
+
+    undo.beginGroup();
+    for (int i = 0; i < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        int at = buffer.lineCount();
+        buffer.insertLineAt(at, "g" + std::to_string(i));
+        undo.addAction(lineAction(at, "g" + std::to_string(i)));
+    }
+    undo.endGroup();
+    const uint32_t groupTip = undo.currentId();
+    const std::string grouped = dump(buffer);
+
+    TextEdit replace;
+    replace.endCol = 4;
+    replace.text = "BASE";
+    std::vector<AppliedEdit> applied;
+    CHECK(buffer.applyEdits({replace}, &applied));
+    undo.addEdits(applied);
+    const uint32_t editTip = undo.currentId();
+    const std::string edited = dump(buffer);
+    CHECK(editTip == groupTip + 2);
+
+    int64_t firstTime = INT64_MAX;
+    for (const UndoNodeInfo& node : undo.tree()) {
+        if (node.id == root) continue;
+        if (node.id < groupTip) firstTime = std::min(firstTime, node.time);
+        undo.gotoNode(root, buffer);
+        CHECK(undo.gotoNode(node.id, buffer));
+        const bool inEdit = node.id > groupTip;
+        CHECK(undo.currentId() == (inEdit ? editTip : groupTip));
+        CHECK(dump(buffer) == (inEdit ? edited : grouped));
+    }
+
+    undo.gotoNode(root, buffer);
+    CHECK(undo.gotoTime(firstTime, buffer));
+    CHECK(undo.currentId() == groupTip && dump(buffer) == grouped);
+    CHECK(undo.undo(buffer));
+    CHECK(undo.currentId() == root && dump(buffer) == "base\n");
+    CHECK(undo.redo(buffer));
+    CHECK(undo.currentId() == groupTip && dump(buffer) == grouped);
+}
+
+int main() {
+    testCoalescedRoundTrip();
+    testMemoryLimit();
+    testDeepChainTeardown();
+    testReferencedCut();
+    testGotoNodeAndTime();
+    testGotoInsideGroup();
+    return checkResult("UndoTest");
+}
@@ -0,0 +1,107 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "Utf8Scanner.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Every kernel this CPU can run must agree with the scalar reference on every input
+// Bu CPU'nun calistirabildigi her cekirdek her girdide skaler referansla ayni sonucu vermeli
+
+// Compare the active kernel with the scalar reference on one input; true if they agree
+// Aktif cekirdegi tek bir girdide skaler referansla karsilastir; uyusurlarsa true
+static bool agrees(const uint8_t* data, size_t size) {
+    size_t even = 0, odd = 0, refEven = 0, refOdd = 0;
+    Utf8Scanner::countNuls(data, size, even, odd);
+    Utf8Scanner::countNulsScalar(data, size, refEven, refOdd);
+    return Utf8Scanner::isValidUTF8(data, size) == Utf8Scanner::isValidUTF8Scalar(data, size) &&
+           Utf8Scanner::isASCII(data, size) == Utf8Scanner::isASCIIScalar(data, size) &&
+           even == refEven && odd == refOdd;
+}
+
+// Random runs of valid sequences (including the edges U+D7FF, U+E000 and U+10FFFF) with a few
+// bytes replaced, inserted or removed, at lengths across several vector blocks
+// Birkac baytin degistirildigi, eklendigi veya silindigi gecerli dizi kosulari (U+D7FF, U+E000
+// ve U+10FFFF sinirlari dahil), birkac vektor bloguna yayilan uzunluklarda
+static void testRandomMutations() {
+    const std::vector<std::vector<uint8_t>> pieces = {
+        {'a'}, {'\n'}, {0xC3, 0xA7}, {0xE2, 0x82, 0xAC}, {0xF0, 0x9F, 0x98, 0x80},
+        {0xF4, 0x8F, 0xBF, 0xBF}, {0xED, 0x9F, 0xBF}, {0xEE, 0x80, 0x80}};
+    const uint8_t bad[] = {0x80, 0xBF, 0xC0, 0xC1, 0xC2, 0xE0, 0xED, 0xF0, 0xF4, 0xF5, 0xFF, 0xA0, 0x90, 0x8F, 0x00};
+    std::mt19937 rng(7);
+    int mismatches = 0, valid = 0;
+    for (int iter = 0; iter < 100000; ++iter) {
+        std::vector<uint8_t> bytes;
+        for (int k = static_cast<int>(rng() % 80); k > 0; --k) {
+            const auto& piece = pieces[rng() % pieces.size()];
+            bytes.insert(bytes.end(), piece.begin(), piece.end());
+        }
+        for (int m = static_cast<int>(rng() % 3); m > 0 && !bytes.empty(); --m) {
+            size_t pos = rng() % bytes.size();
+            switch (rng() % 3) {
+                case 0: bytes[pos] = bad[rng() % sizeof(bad)]; break;
+                case 1: bytes.insert(bytes.begin() + pos, bad[rng() % sizeof(bad)]); break;
+                case 2: bytes.erase(bytes.begin() + pos); break;
+            }
+        }
+        valid += Utf8Scanner::isValidUTF8Scalar(bytes.data(), bytes.size());
+        if (!agrees(bytes.data(), bytes.size())) ++mismatches;
+    }
+    CHECK(mismatches == 0);
+    CHECK(valid > 1000);  // Both outcomes are exercised / Iki sonuc da denenir
+}
+
+// Every two-byte prefix with a set of third bytes, placed to straddle the end of a 16-byte
+// block and at the very end of the input
+// Bir dizi ucuncu baytla her iki baytlik onek, 16 baytlik bir blogun sonunu asacak sekilde ve
+// girdinin tam sonunda
+static void testBlockEdges() {
+    int mismatches = 0;
+    for (int a = 0; a < 256; ++a) {
+        for (int b = 0; b < 256; ++b) {
+            for (int c : {0x41, 0x80, 0xBF, 0x9F, 0xA0, 0x8F, 0x90}) {
+                uint8_t bytes[40];
+                std::memset(bytes, 'x', sizeof(bytes));
+                bytes[13] = static_cast<uint8_t>(a);
+                bytes[14] = static_cast<uint8_t>(b);
+                bytes[15] = static_cast<uint8_t>(c);
+                for (size_t len : {16, 20, 40})
+                    if (!agrees(bytes, len)) ++mismatches;
+                bytes[29] = bytes[13], bytes[30] = bytes[14], bytes[31] = bytes[15];
+                if (!agrees(bytes + 16, 16)) ++mismatches;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Long all-NUL and mixed-NUL runs, so per-lane NUL counters must be flushed before they wrap
+// Uzun tamami NUL ve karisik NUL kosulari, boylece serit basina NUL sayaclari tasmadan bosaltilmali
+static void testLongNulRuns() {
+    std::mt19937 rng(3);
+    std::vector<uint8_t> zeros(100003, 0), sparse(100003);
+    for (auto& b : sparse) b = rng() % 3 ? 'a' : 0;
+    CHECK(agrees(zeros.data(), zeros.size()));
+    CHECK(agrees(sparse.data(), sparse.size()));
+    CHECK(agrees(sparse.data() + 1, sparse.size() - 1));
+}
+
+int main() {
+    const std::vector<const char*> kernels = Utf8Scanner::availableKernels();
+    CHECK(!kernels.empty() && std::strcmp(kernels.back(), "scalar") == 0);
+    CHECK(!Utf8Scanner::useKernel("no-such-kernel"));
+    for (const char* name : kernels) {
+        CHECK(Utf8Scanner::useKernel(name));
+        CHECK(std::strcmp(Utf8Scanner::kernelName(), name) == 0);
+        std::printf("kernel %s\n", name);
+        testRandomMutations();
+        testBlockEdges();
+        testLongNulRuns();
+    }
+    return checkResult("Utf8ScannerTest");
+}
@@ -0,0 +1,166 @@
+// BerkIDE — No impositions.
+// Copyright (c) 2025 Berk Coşar <lookmainpoint@gmail.com>
+// Licensed under the GNU Affero General Public License v3.0.
+// See LICENSE file in the project root for full license text.
+
+#include "Check.h"
+#include "WorkspaceSearch.h"
+#include "buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Write a file, creating its directories / Dizinlerini olusturarak bir dosya yaz
+static void put(const TempDir& dir, const std::string& name, const std::string& text) {
+    fs::create_directories((dir.path / name).parent_path());
+    std::ofstream(dir.file(name), std::ios::binary) << text;
+}
+
+// Matches keyed by path relative to root, as "line:col" in order
+// Koke gore yola anahtarlanmis eslemeler, sirayla "satir:sutun" olarak
+static std::map<std::string, std::vector<std::string>> byFile(const std::vector<WorkspaceMatch>& matches,
+                                                              const fs::path& root) {
+    std::map<std::string, std::vector<std::string>> out;
+    for (const WorkspaceMatch& m : matches) {
+        out[fs::path(m.path).lexically_relative(root).generic_string()].push_back(
+            std::to_string(m.line) + ":" + std::to_string(m.col));
+    }
+    return out;
+}
+
+// A tree with ignored directories, an oversized file, a binary file, a BOM and a link to a
+// directory: only the plain text files are searched, in line order within each file
+// Yok sayilan dizinler, cok buyuk bir dosya, ikili bir dosya, bir BOM ve bir dizine baglanti
+// iceren bir agac: yalnizca duz metin dosyalari aranir, her dosyada satir sirasiyla
+static void testWalkAndSkips() {
+    TempDir dir("workspace-walk");
+    const fs::path root = fs::canonical(dir.path);
+    put(dir, "src/a.txt", "foo bar\nnone\nfoo foo\n");
+    put(dir, "src/deep/b.txt", "FOO\n");
+    put(dir, "node_modules/x.txt", "foo\n");
+    put(dir, "out/.git/y.txt", "foo\n");
+    put(dir, "big.txt", std::string(2000, 'x') + "foo\n");
+    put(dir, "bin.dat", std::string("foo\0", 4));
+    put(dir, "bom.txt", "\xEF\xBB\xBF" "foo");
+    std::error_code ec;
+    fs::create_directory_symlink(root / "src", root / "link", ec);
+
+    WorkspaceSearch search;
+    WorkspaceQuery query;
+    query.root = dir.path.string();
+    query.pattern = "foo";
+    query.maxFileSize = 1000;
+    query.ignoreDirs = {"node_modules", ".git"};
+    std::vector<WorkspaceMatch> results;
+    const WorkspaceStats stats = search.run(query, &results);
+
+    const auto files = byFile(results, root);
+    CHECK(files.size() == 2);
+    CHECK(files.at("src/a.txt") == std::vector<std::string>({"0:0", "2:0", "2:4"}));
+    CHECK(files.at("bom.txt") == std::vector<std::string>({"0:0"}));
+    CHECK(stats.files == 3 && stats.filesMatched == 2 && stats.skipped == 2);
+    CHECK(stats.matches == 4 && !stats.truncated && !stats.cancelled);
+    for (const WorkspaceMatch& m : results) {
+        if (m.line == 2) CHECK(m.text == "foo foo" && m.length == 3 && m.endCol == m.col + 3);
+    }
+
+    query.opts.caseSensitive = false;
+    query.opts.regex = true;
+    query.pattern = "fo+$";
+    results.clear();
+    CHECK(search.run(query, &results).matches == 3);
+    CHECK(byFile(results, root).count("src/deep/b.txt") == 1);
+
+    // A file list replaces the walk / Bir dosya listesi gezintinin yerini alir
+    const std::vector<std::string> only = {(root / "src/deep/b.txt").string()};
+    query.files = &only;
+    results.clear();
+    CHECK(search.run(query, &results).files == 1 && results.size() == 1);
+}
+
+// maxResults stops the search and reports truncation, batches reach onBatch as well as the
+// results, and cancelling through the flag or cancel() stops it early
+// maxResults aramayi durdurur ve kesilmeyi bildirir, gruplar sonuclarla birlikte onBatch'e de
+// ulasir, bayrakla veya cancel() ile iptal erken durdurur
+static void testLimitsAndCancel() {
+    TempDir dir("workspace-limits");
+    for (int i = 0; i < 2000; ++i) put(dir, "f" + std::to_string(i % 40) + "/" + std::to_string(i) + ".txt",
+                                       std::string(10, '\n') + "hit hit hit hit hit\n");
+    WorkspaceSearch search;
+    WorkspaceQuery query;
+    query.root = dir.path.string();
+    query.pattern = "hit";
+
+    query.maxResults = 7;
+    std::vector<WorkspaceMatch> results;
+    WorkspaceStats stats = search.run(query, &results);
+    CHECK(stats.truncated && !stats.cancelled && stats.matches == 7 && results.size() == 7);
+
+    query.maxResults = 0;
+    size_t batched = 0;
+    query.onBatch = [&](std::vector<WorkspaceMatch>&& batch) { batched += batch.size(); };
+    results.clear();
+    stats = search.run(query, &results);
+    CHECK(stats.matches == 10000 && results.size() == 10000 && batched == 10000);
+
+    std::atomic<bool> stop{true};
+    query.cancel = &stop;
+    stats = search.run(query);
+    CHECK(stats.cancelled && stats.matches == 0);
+
+    stop = false;
+    query.onBatch = [&](std::vector<WorkspaceMatch>&&) { search.cancel(); };
+    stats = search.run(query);
+    CHECK(stats.cancelled && stats.matches < 10000);
+    query.onBatch = nullptr;
+    CHECK(search.run(query).matches == 10000);
+}
+
+// Unsaved buffers are searched instead of their file, including ones not on disk yet, but not
+// under ignored directories or outside the root
+// Kaydedilmemis buffer'lar dosyalarinin yerine aranir, henuz diskte olmayanlar dahil, ama yok
+// sayilan dizinlerin altinda veya kokun disinda olanlar degil
+static void testOverrides() {
+    TempDir dir("workspace-overrides");
+    TempDir outside("workspace-outside");
+    const fs::path root = fs::canonical(dir.path);
+    put(dir, "a.txt", "foo\n");
+    put(dir, "b.txt", "foo\n");
+
+    Buffer edited, fresh, ignored, elsewhere;
+    edited.loadLines({"nothing", "x foo"});
+    fresh.loadLines({"foo foo"});
+    ignored.loadLines({"foo"});
+    elsewhere.loadLines({"foo"});
+
+    WorkspaceSearch search;
+    WorkspaceQuery query;
+    query.root = dir.path.string();
+    query.pattern = "foo";
+    query.ignoreDirs = {"build"};
+    query.overrides = {{dir.file("a.txt"), edited.snapshot()},
+                       {dir.file("new/c.txt"), fresh.snapshot()},
+                       {dir.file("build/d.txt"), ignored.snapshot()},
+                       {outside.file("e.txt"), elsewhere.snapshot()}};
+    std::vector<WorkspaceMatch> results;
+    search.run(query, &results);
+    const auto files = byFile(results, root);
+    CHECK(files.size() == 3);
+    CHECK(files.at("a.txt") == std::vector<std::string>({"1:2"}));
+    CHECK(files.at("b.txt") == std::vector<std::string>({"0:0"}));
+    CHECK(files.at("new/c.txt") == std::vector<std::string>({"0:0", "0:4"}));
+}
+
+int main() {
+    testWalkAndSkips();
+    testLimitsAndCancel();
+    testOverrides();
+    return checkResult("WorkspaceSearchTest");
+}